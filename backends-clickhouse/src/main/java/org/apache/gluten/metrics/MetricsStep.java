@@ -53,6 +53,12 @@ public class MetricsStep {
   @JsonProperty("miss_cache_millisecond")
   protected long missCacheMillisecond;
 
+  @JsonProperty("total_stripes")
+  protected long totalStripes;
+
+  @JsonProperty("pruned_stripes")
+  protected long prunedStripes;
+
   public String getName() {
     return name;
   }
@@ -148,4 +154,20 @@ public class MetricsStep {
   public void setMissCacheMillisecond(long missCacheMillisecond) {
     this.missCacheMillisecond = missCacheMillisecond;
   }
+
+  public long getTotalStripes() {
+    return totalStripes;
+  }
+
+  public void setTotalStripes(long totalStripes) {
+    this.totalStripes = totalStripes;
+  }
+
+  public long getPrunedStripes() {
+    return prunedStripes;
+  }
+
+  public void setPrunedStripes(long prunedStripes) {
+    this.prunedStripes = prunedStripes;
+  }
 }
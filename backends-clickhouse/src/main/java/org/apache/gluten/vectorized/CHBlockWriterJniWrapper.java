@@ -25,7 +25,7 @@ public class CHBlockWriterJniWrapper {
 
   private native void nativeWrite(long instance, long block);
 
-  private native int nativeResultSize(long instance);
+  private native long nativeResultSize(long instance);
 
   private native void nativeCollect(long instance, byte[] data);
 
@@ -42,7 +42,11 @@ public class CHBlockWriterJniWrapper {
     if (instance == 0L) {
       return new byte[0];
     }
-    byte[] result = new byte[nativeResultSize(instance)];
+    long size = nativeResultSize(instance);
+    if (size > Integer.MAX_VALUE - 8) {
+      throw new IllegalStateException("Cannot collect " + size + " bytes into a byte array");
+    }
+    byte[] result = new byte[(int) size];
     nativeCollect(instance, result);
     nativeClose(instance);
     instance = 0;
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package org.apache.gluten.vectorized;
+
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+/**
+ * An output stream that keeps the written bytes as a list of byte arrays of at most chunkSize
+ * bytes, so the result is not limited by the 2GB size of a single Java array.
+ */
+public class ChunkedByteArrayOutputStream extends OutputStream {
+  private static final int INITIAL_SIZE = 4 << 10;
+
+  private final int chunkSize;
+  private final List<byte[]> chunks = new ArrayList<>();
+  private byte[] current;
+  private int position = 0;
+
+  public ChunkedByteArrayOutputStream(int chunkSize) {
+    if (chunkSize <= 0) {
+      throw new IllegalArgumentException("chunkSize must be positive: " + chunkSize);
+    }
+    this.chunkSize = chunkSize;
+  }
+
+  @Override
+  public void write(int b) {
+    ensureCapacity();
+    current[position++] = (byte) b;
+  }
+
+  @Override
+  public void write(byte[] b, int off, int len) {
+    while (len > 0) {
+      ensureCapacity();
+      int n = Math.min(len, current.length - position);
+      System.arraycopy(b, off, current, position, n);
+      position += n;
+      off += n;
+      len -= n;
+    }
+  }
+
+  /** Return the written bytes. The last chunk is trimmed to its written size. */
+  public byte[][] toChunks() {
+    List<byte[]> result = new ArrayList<>(chunks);
+    if (position > 0) {
+      result.add(position == current.length ? current : Arrays.copyOf(current, position));
+    }
+    return result.toArray(new byte[0][]);
+  }
+
+  // The first chunk grows from a small buffer, so small outputs do not allocate a whole chunk.
+  private void ensureCapacity() {
+    if (current == null) {
+      current = new byte[Math.min(chunkSize, INITIAL_SIZE)];
+    } else if (position == current.length) {
+      if (current.length < chunkSize) {
+        current = Arrays.copyOf(current, (int) Math.min(current.length * 2L, chunkSize));
+      } else {
+        chunks.add(current);
+        current = new byte[chunkSize];
+        position = 0;
+      }
+    }
+  }
+}
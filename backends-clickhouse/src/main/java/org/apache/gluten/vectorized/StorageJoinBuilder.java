@@ -37,7 +37,7 @@ public class StorageJoinBuilder {
 
   private static native long nativeBuild(
       String buildHashTableId,
-      byte[] in,
+      byte[][] in,
       long rowCount,
       String joinKeys,
       int joinType,
@@ -49,52 +49,66 @@ public class StorageJoinBuilder {
 
   private StorageJoinBuilder() {}
 
-  /** build storage join object */
+  /**
+   * build storage join object from the serialized relation, held as chunks so that it is not
+   * limited by the 2GB size of a single byte array.
+   */
   public static long build(
-      byte[] batches,
+      byte[][] batches,
       long rowCount,
       BroadCastHashJoinContext broadCastContext,
       List<Expression> newBuildKeys,
       List<Attribute> newOutput,
       boolean hasNullKeyValues) {
+    List<Attribute> output = buildOutput(broadCastContext, newBuildKeys, newOutput);
+    return nativeBuild(
+        broadCastContext.buildHashTableId(),
+        batches,
+        rowCount,
+        joinKey(broadCastContext, newBuildKeys),
+        joinType(broadCastContext),
+        broadCastContext.hasMixedFiltCondition(),
+        broadCastContext.isExistenceJoin(),
+        SubstraitUtil.toNameStruct(output).toByteArray(),
+        broadCastContext.isNullAwareAntiJoin(),
+        hasNullKeyValues);
+  }
+
+  private static List<Attribute> buildOutput(
+      BroadCastHashJoinContext broadCastContext,
+      List<Expression> newBuildKeys,
+      List<Attribute> newOutput) {
+    if (newBuildKeys.isEmpty()) {
+      return JavaConverters.<Attribute>seqAsJavaList(broadCastContext.buildSideStructure());
+    }
+    return newOutput;
+  }
+
+  private static String joinKey(
+      BroadCastHashJoinContext broadCastContext, List<Expression> newBuildKeys) {
     ConverterUtils$ converter = ConverterUtils$.MODULE$;
     List<Expression> keys;
-    List<Attribute> output;
     if (newBuildKeys.isEmpty()) {
       keys = JavaConverters.<Expression>seqAsJavaList(broadCastContext.buildSideJoinKeys());
-      output = JavaConverters.<Attribute>seqAsJavaList(broadCastContext.buildSideStructure());
     } else {
       keys = newBuildKeys;
-      output = newOutput;
     }
-    String joinKey =
-        keys.stream()
-            .map(
-                (Expression key) -> {
-                  Attribute attr = converter.getAttrFromExpr(key);
-                  return converter.genColumnNameWithExprId(attr);
-                })
-            .collect(Collectors.joining(","));
+    return keys.stream()
+        .map(
+            (Expression key) -> {
+              Attribute attr = converter.getAttrFromExpr(key);
+              return converter.genColumnNameWithExprId(attr);
+            })
+        .collect(Collectors.joining(","));
+  }
 
-    int joinType;
+  private static int joinType(BroadCastHashJoinContext broadCastContext) {
     if (broadCastContext.buildHashTableId().startsWith("BuiltBNLJBroadcastTable-")) {
-      joinType = SubstraitUtil.toCrossRelSubstrait(broadCastContext.joinType()).ordinal();
+      return SubstraitUtil.toCrossRelSubstrait(broadCastContext.joinType()).ordinal();
     } else {
       boolean buildRight = broadCastContext.buildRight();
-      joinType =
-          JoinTypeTransform.toSubstraitJoinType(broadCastContext.joinType(), buildRight).ordinal();
+      return JoinTypeTransform.toSubstraitJoinType(broadCastContext.joinType(), buildRight)
+          .ordinal();
     }
-
-    return nativeBuild(
-        broadCastContext.buildHashTableId(),
-        batches,
-        rowCount,
-        joinKey,
-        joinType,
-        broadCastContext.hasMixedFiltCondition(),
-        broadCastContext.isExistenceJoin(),
-        SubstraitUtil.toNameStruct(output).toByteArray(),
-        broadCastContext.isNullAwareAntiJoin(),
-        hasNullKeyValues);
   }
 }
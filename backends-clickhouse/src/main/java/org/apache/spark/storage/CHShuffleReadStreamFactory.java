@@ -34,6 +34,9 @@ import org.xerial.snappy.SnappyInputStream;
 
 import java.io.*;
 import java.lang.reflect.Field;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
 import java.util.zip.CheckedInputStream;
 
 public final class CHShuffleReadStreamFactory {
@@ -83,6 +86,15 @@ public final class CHShuffleReadStreamFactory {
     return new OnHeapCopyShuffleInputStream(new ByteArrayInputStream(allBatches), compressed);
   }
 
+  public static ShuffleInputStream create(byte[][] chunks, boolean compressed) {
+    List<InputStream> streams = new ArrayList<>(chunks.length);
+    for (byte[] chunk : chunks) {
+      streams.add(new ByteArrayInputStream(chunk));
+    }
+    return new OnHeapCopyShuffleInputStream(
+        new SequenceInputStream(Collections.enumeration(streams)), compressed);
+  }
+
   public static ShuffleInputStream create(
       InputStream in, boolean forceCompress, boolean isCustomizedShuffleCodec) {
     final InputStream unwrapped = unwrapInputStream(in, forceCompress, isCustomizedShuffleCodec);
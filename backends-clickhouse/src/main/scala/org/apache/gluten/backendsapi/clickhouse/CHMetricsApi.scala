@@ -166,7 +166,13 @@ class CHMetricsApi extends MetricsApi with Logging with LogLevelUtil {
         "Time reading from filesystem cache"),
       "missCacheMillisecond" -> SQLMetrics.createTimingMetric(
         sparkContext,
-        "Time reading from filesystem cache source (from remote filesystem, etc)")
+        "Time reading from filesystem cache source (from remote filesystem, etc)"),
+      "totalStripes" -> SQLMetrics.createMetric(
+        sparkContext,
+        "number of ORC stripes in the splits"),
+      "prunedStripes" -> SQLMetrics.createMetric(
+        sparkContext,
+        "number of ORC stripes pruned by statistics")
     )
 
   override def genFileSourceScanTransformerMetricsUpdater(
@@ -412,7 +412,8 @@ class CHSparkPlanExecApi extends SparkPlanExecApi with Logging {
       serializer: Serializer,
       writeMetrics: Map[String, SQLMetric],
       metrics: Map[String, SQLMetric],
-      isSort: Boolean
+      isSort: Boolean,
+      sortOrder: Seq[SortOrder]
   ): ShuffleDependency[Int, ColumnarBatch, ColumnarBatch] = {
     CHExecUtil.genShuffleDependency(
       rdd,
@@ -551,8 +552,8 @@ class CHSparkPlanExecApi extends SparkPlanExecApi with Logging {
     val countsAndBytes =
       CHExecUtil.buildSideRDD(dataSize, newChild, isNullAware, keyColumnIndex).collect
 
-    val batches = countsAndBytes.map(_._2)
-    val totalBatchesSize = batches.map(_.length).sum
+    val batches = countsAndBytes.flatMap(_._2)
+    val totalBatchesSize = batches.map(_.length.toLong).sum
     val rawSize = dataSize.value
     if (rawSize >= BroadcastExchangeExec.MAX_BROADCAST_TABLE_BYTES) {
       throw new GlutenException(
@@ -569,7 +570,7 @@ class CHSparkPlanExecApi extends SparkPlanExecApi with Logging {
     ClickHouseBuildSideRelation(
       mode,
       newOutput,
-      batches.flatten,
+      batches,
       rowCount,
       newBuildKeys,
       hasNullKeyValues)
@@ -580,7 +581,8 @@ class CHSparkPlanExecApi extends SparkPlanExecApi with Logging {
     List(
       Sig[CollectList](ExpressionNames.COLLECT_LIST),
       Sig[CollectSet](ExpressionNames.COLLECT_SET),
-      Sig[MonotonicallyIncreasingID](MONOTONICALLY_INCREASING_ID)
+      Sig[MonotonicallyIncreasingID](MONOTONICALLY_INCREASING_ID),
+      Sig[HiveHash](ExpressionNames.HIVE_HASH)
     ) ++
       ExpressionExtensionTrait.expressionExtensionTransformer.expressionSigList ++
       SparkShimLoader.getSparkShims.bloomFilterExpressionMappings()
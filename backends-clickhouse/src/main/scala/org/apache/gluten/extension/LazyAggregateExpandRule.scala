@@ -69,6 +69,7 @@ case class LazyAggregateExpandRule(session: SparkSession) extends Rule[SparkPlan
               ExpandExecTransformer(projections, output, child)),
             _,
             _,
+            _,
             _
           ) =>
         logDebug(s"xxx match plan:$shuffle")
@@ -116,6 +117,7 @@ case class LazyAggregateExpandRule(session: SparkSession) extends Rule[SparkPlan
               FilterExecTransformer(_, ExpandExecTransformer(projections, output, child))),
             _,
             _,
+            _,
             _
           ) =>
         val partialAggregate = shuffle.child.asInstanceOf[CHHashAggregateExecTransformer]
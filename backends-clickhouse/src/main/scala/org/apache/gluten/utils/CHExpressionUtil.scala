@@ -166,6 +166,21 @@ case class FormatStringValidator() extends FunctionValidator {
   }
 }
 
+case class HiveHashValidator() extends FunctionValidator {
+  // The types that sparkHiveHash supports, see SparkBucketHasher::isSupported.
+  private def isSupported(dataType: DataType): Boolean = dataType match {
+    case NullType | BooleanType | ByteType | ShortType | IntegerType | LongType | FloatType |
+        DoubleType | DateType | TimestampType | StringType | BinaryType =>
+      true
+    case _: DecimalType => true
+    case _ => false
+  }
+
+  override def doValidate(expr: Expression): Boolean = {
+    expr.children.forall(child => isSupported(child.dataType))
+  }
+}
+
 object CHExpressionUtil {
   final val CH_AGGREGATE_FUNC_BLACKLIST: Map[String, FunctionValidator] = Map(
     MAX_BY -> DefaultValidator(),
@@ -204,6 +219,7 @@ object CHExpressionUtil {
     FROM_UTC_TIMESTAMP -> UtcTimestampValidator(),
     STACK -> DefaultValidator(),
     RAISE_ERROR -> DefaultValidator(),
-    WIDTH_BUCKET -> DefaultValidator()
+    WIDTH_BUCKET -> DefaultValidator(),
+    HIVE_HASH -> HiveHashValidator()
   )
 }
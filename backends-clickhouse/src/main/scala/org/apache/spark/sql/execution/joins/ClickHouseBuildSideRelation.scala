@@ -33,7 +33,7 @@ import scala.collection.JavaConverters._
 case class ClickHouseBuildSideRelation(
     mode: BroadcastMode,
     output: Seq[Attribute],
-    batches: Array[Byte],
+    batches: Array[Array[Byte]],
     numOfRows: Long,
     newBuildKeys: Seq[Expression] = Seq.empty,
     hasNullKeyValues: Boolean = false)
@@ -52,7 +52,7 @@ case class ClickHouseBuildSideRelation(
       if (hashTableData == 0) {
         logDebug(
           s"BHJ value size: " +
-            s"${broadCastContext.buildHashTableId} = ${batches.length}")
+            s"${broadCastContext.buildHashTableId} = ${batches.map(_.length.toLong).sum}")
         // Build the hash table
         hashTableData = StorageJoinBuilder.build(
           batches,
@@ -43,8 +43,6 @@ import org.apache.spark.util.MutablePair
 
 import io.substrait.proto.Type
 
-import java.io.ByteArrayOutputStream
-
 import scala.collection.JavaConverters._
 
 object CHExecUtil extends Logging {
@@ -62,10 +60,11 @@ object CHExecUtil extends Logging {
       keyColumnIndex: Int = 0,
       compressionCodec: Option[String] = Some("lz4"),
       compressionLevel: Option[Int] = None,
-      bufferSize: Int = 4 << 10): Iterator[(Long, Array[Byte], Boolean)] = {
+      bufferSize: Int = 4 << 10,
+      chunkSize: Int = Int.MaxValue - 8): Iterator[(Long, Array[Array[Byte]], Boolean)] = {
     var count = 0L
     var hasNullKeyValues = false
-    val bos = new ByteArrayOutputStream()
+    val bos = new ChunkedByteArrayOutputStream(chunkSize)
     val buffer = new Array[Byte](bufferSize) // 4K
     val level = compressionLevel.getOrElse(Int.MinValue)
     val blockOutputStream =
@@ -89,7 +88,7 @@ object CHExecUtil extends Logging {
     }
     blockOutputStream.flush()
     blockOutputStream.close()
-    Iterator((count, bos.toByteArray, hasNullKeyValues))
+    Iterator((count, bos.toChunks, hasNullKeyValues))
   }
 
   def buildSideRDD(
@@ -97,10 +96,12 @@ object CHExecUtil extends Logging {
       newChild: SparkPlan,
       isNullAware: Boolean,
       keyColumnIndex: Int
-  ): RDD[(Long, Array[Byte], Boolean)] = {
+  ): RDD[(Long, Array[Array[Byte]], Boolean)] = {
+    val chunkSize = GlutenConfig.getConf.columnarBroadcastChunkSize
     newChild
       .executeColumnar()
-      .mapPartitionsInternal(iter => toBytes(dataSize, iter, isNullAware, keyColumnIndex))
+      .mapPartitionsInternal(
+        iter => toBytes(dataSize, iter, isNullAware, keyColumnIndex, chunkSize = chunkSize))
   }
 
   private def buildRangePartitionSampleRDD(
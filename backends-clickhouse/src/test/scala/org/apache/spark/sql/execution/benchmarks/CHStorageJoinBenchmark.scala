@@ -109,7 +109,7 @@ object CHStorageJoinBenchmark extends SqlBasedBenchmark with CHSqlBasedBenchmark
     ClickHouseBuildSideRelation(
       NoopBroadcastMode,
       child.output,
-      allBytes,
+      Array(allBytes),
       count0,
       Seq(BoundReference(0, child.output.head.dataType, child.output.head.nullable)))
   }
@@ -133,7 +133,7 @@ object CHStorageJoinBenchmark extends SqlBasedBenchmark with CHSqlBasedBenchmark
     ClickHouseBuildSideRelation(
       NoopBroadcastMode,
       child.output,
-      allBytes,
+      Array(allBytes),
       count0,
       Seq(BoundReference(0, child.output.head.dataType, child.output.head.nullable)))
   }
@@ -149,13 +149,13 @@ object CHStorageJoinBenchmark extends SqlBasedBenchmark with CHSqlBasedBenchmark
     val count0 = countsAndBytes.map(_._1).sum
     val batches = countsAndBytes.map(_._2)
     val rawSize = dataSize.value
-    val allBytes = batches.flatten
-    val count1 = iterateBatch(allBytes, compressed = true)
+    val allChunks = batches.flatten
+    val count1 = iterateBatch(allChunks.flatten, compressed = true)
     require(count0 == count1, s"count0: $count0, count1: $count1")
     ClickHouseBuildSideRelation(
       NoopBroadcastMode,
       child.output,
-      allBytes,
+      allChunks,
       count0,
       Seq(BoundReference(0, child.output.head.dataType, child.output.head.nullable)))
   }
@@ -171,13 +171,13 @@ object CHStorageJoinBenchmark extends SqlBasedBenchmark with CHSqlBasedBenchmark
     val count0 = countsAndBytes.map(_._1).sum
     val batches = countsAndBytes.map(_._2)
     val rawSize = dataSize.value
-    val allBytes = batches.flatten
-    val count1 = iterateBatch(allBytes, compressed = true)
+    val allChunks = batches.flatten
+    val count1 = iterateBatch(allChunks.flatten, compressed = true)
     require(count0 == count1, s"count0: $count0, count1: $count1")
     ClickHouseBuildSideRelation(
       NoopBroadcastMode,
       child.output,
-      allBytes,
+      allChunks,
       count0,
       Seq(BoundReference(0, child.output.head.dataType, child.output.head.nullable)))
   }
@@ -209,7 +209,7 @@ object CHStorageJoinBenchmark extends SqlBasedBenchmark with CHSqlBasedBenchmark
     ClickHouseBuildSideRelation(
       NoopBroadcastMode,
       child.output,
-      allBytes,
+      Array(allBytes),
       count0,
       Seq(BoundReference(0, child.output.head.dataType, child.output.head.nullable)))
   }
@@ -122,6 +122,7 @@ class VeloxCelebornColumnarShuffleWriter[K, V](
     nativeShuffleWriter = jniWrapper.makeForRSS(
       dep.nativePartitioning.getShortName,
       dep.nativePartitioning.getNumPartitions,
+      GlutenShuffleUtils.getHashPartitionKeys(dep.nativePartitioning),
       nativeBufferSize,
       customizedCompressionCodec,
       compressionLevel,
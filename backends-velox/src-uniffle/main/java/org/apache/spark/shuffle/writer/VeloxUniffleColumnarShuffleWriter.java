@@ -152,6 +152,7 @@ public class VeloxUniffleColumnarShuffleWriter<K, V> extends RssShuffleWriter<K,
               jniWrapper.makeForRSS(
                   columnarDep.nativePartitioning().getShortName(),
                   columnarDep.nativePartitioning().getNumPartitions(),
+                  GlutenShuffleUtils.getHashPartitionKeys(columnarDep.nativePartitioning()),
                   nativeBufferSize,
                   // use field do this
                   compressionCodec,
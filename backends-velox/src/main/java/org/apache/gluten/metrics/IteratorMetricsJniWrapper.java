@@ -22,6 +22,8 @@ import org.apache.gluten.runtime.RuntimeAware;
 import org.apache.gluten.runtime.Runtimes;
 import org.apache.gluten.vectorized.ColumnarBatchOutIterator;
 
+import java.nio.ByteBuffer;
+
 public class IteratorMetricsJniWrapper implements RuntimeAware {
   private final Runtime runtime;
 
@@ -39,8 +41,22 @@ public class IteratorMetricsJniWrapper implements RuntimeAware {
     return nativeFetchMetrics(out.itrHandle());
   }
 
+  /**
+   * Returns the live metrics of the iterator, or null if the native iterator hasn't published any
+   * yet. See spark.gluten.sql.columnar.backend.velox.metricsPublishIntervalMs.
+   */
+  public MetricsSnapshot snapshot(ColumnarBatchOutIterator out) {
+    ByteBuffer buffer = nativeMetricsSnapshot(out.itrHandle());
+    if (buffer == null) {
+      return null;
+    }
+    return new MetricsSnapshot(buffer);
+  }
+
   private native Metrics nativeFetchMetrics(long itrHandle);
 
+  private native ByteBuffer nativeMetricsSnapshot(long itrHandle);
+
   @Override
   public long rtHandle() {
     return runtime.getHandle();
@@ -72,6 +72,7 @@ public class Metrics implements IMetrics {
       long[] cpuCount,
       long[] wallNanos,
       long veloxToArrow,
+      long spilledMemoryTierBytes,
       long[] peakMemoryBytes,
       long[] numMemoryAllocations,
       long[] spilledInputBytes,
@@ -110,6 +111,7 @@ public class Metrics implements IMetrics {
     this.wallNanos = wallNanos;
     this.scanTime = scanTime;
     this.singleMetric.veloxToArrow = veloxToArrow;
+    this.singleMetric.spilledMemoryTierBytes = spilledMemoryTierBytes;
     this.peakMemoryBytes = peakMemoryBytes;
     this.numMemoryAllocations = numMemoryAllocations;
     this.spilledInputBytes = spilledInputBytes;
@@ -187,5 +189,7 @@ public class Metrics implements IMetrics {
 
   public static class SingleMetric {
     public long veloxToArrow;
+    // Spilled bytes of the task kept by the memory tier of the tiered spill file system.
+    public long spilledMemoryTierBytes;
   }
 }
@@ -0,0 +1,199 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package org.apache.gluten.metrics;
+
+import org.apache.gluten.exception.GlutenException;
+
+import sun.misc.Unsafe;
+
+import java.lang.reflect.Field;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.LongBuffer;
+
+/**
+ * Reads the live metrics that a native iterator keeps publishing into a shared buffer while it
+ * runs, see cpp/core/utils/MetricsSnapshot.h for the layout, and turns them into deltas that can
+ * be added to the SQL metrics as the task progresses.
+ *
+ * <p>The sum of all deltas returned by {@link #delta()} and {@link #finalDelta(Metrics)} equals the
+ * final metrics, so the SQL metrics end up the same as if they were only updated at the end of the
+ * task.
+ */
+public class MetricsSnapshot {
+  // The number of arrays taken by the constructor of Metrics, which must be the same as
+  // Metrics::kNum in cpp/core/utils/Metrics.h. The native side exports the latter in the header.
+  private static final int NUM_TYPES = 36;
+  private static final int SEQUENCE_SLOT = 0;
+  private static final int NUM_METRICS_SLOT = 1;
+  private static final int NUM_TYPES_SLOT = 2;
+  private static final int PEAK_MEMORY_BYTES_TYPE_SLOT = 3;
+  private static final int HEADER_SLOTS = 4;
+
+  private static final Unsafe UNSAFE;
+
+  static {
+    try {
+      Field field = Unsafe.class.getDeclaredField("theUnsafe");
+      field.setAccessible(true);
+      UNSAFE = (Unsafe) field.get(null);
+    } catch (Exception e) {
+      throw new GlutenException(e);
+    }
+  }
+
+  private final LongBuffer buffer;
+  private final int numMetrics;
+  // Peak memory is not additive across the operators merged into one transformer, so it's only
+  // applied with the final metrics.
+  private final int peakMemoryBytesType;
+  private final long[] values;
+  private final long[] applied;
+  private long lastSequence = 0;
+
+  public MetricsSnapshot(ByteBuffer buffer) {
+    this.buffer = buffer.order(ByteOrder.nativeOrder()).asLongBuffer();
+    long numTypes = this.buffer.get(NUM_TYPES_SLOT);
+    if (numTypes != NUM_TYPES) {
+      throw new GlutenException(
+          "Native metrics have " + numTypes + " types, but " + NUM_TYPES + " are expected");
+    }
+    this.numMetrics = (int) this.buffer.get(NUM_METRICS_SLOT);
+    this.peakMemoryBytesType = (int) this.buffer.get(PEAK_MEMORY_BYTES_TYPE_SLOT);
+    if (this.buffer.capacity() != HEADER_SLOTS + NUM_TYPES * numMetrics) {
+      throw new GlutenException("Invalid metrics snapshot of size " + this.buffer.capacity());
+    }
+    this.values = new long[NUM_TYPES * numMetrics];
+    this.applied = new long[NUM_TYPES * numMetrics];
+  }
+
+  /**
+   * Returns the change of the metrics since the last returned delta, or null if nothing has been
+   * published since then.
+   */
+  public Metrics delta() {
+    long sequence = read();
+    if (sequence == lastSequence) {
+      return null;
+    }
+    lastSequence = sequence;
+    long[] delta = new long[values.length];
+    for (int i = 0; i < values.length; i++) {
+      if (i / numMetrics != peakMemoryBytesType) {
+        delta[i] = values[i] - applied[i];
+        applied[i] = values[i];
+      }
+    }
+    return toMetrics(delta, numMetrics, new Metrics.SingleMetric());
+  }
+
+  /**
+   * Returns the remaining change from the last returned delta to the final metrics. If the number
+   * of final metrics differs from the published one, only the slots that were published are
+   * reduced by what has been applied already, and the other final values are returned as is.
+   */
+  public Metrics finalDelta(Metrics metrics) {
+    int numFinalMetrics = metrics.inputRows.length;
+    int numPublished = Math.min(numFinalMetrics, numMetrics);
+    long[][] arrays = toArrays(metrics);
+    long[] delta = new long[NUM_TYPES * numFinalMetrics];
+    for (int type = 0; type < NUM_TYPES; type++) {
+      for (int j = 0; j < numFinalMetrics; j++) {
+        delta[type * numFinalMetrics + j] = arrays[type][j];
+      }
+      for (int j = 0; j < numPublished; j++) {
+        int i = type * numMetrics + j;
+        delta[type * numFinalMetrics + j] -= applied[i];
+        applied[i] = arrays[type][j];
+      }
+    }
+    return toMetrics(delta, numFinalMetrics, metrics.singleMetric);
+  }
+
+  /** Copies a consistent snapshot of the published values. Returns the number of publications. */
+  private long read() {
+    while (true) {
+      long before = buffer.get(SEQUENCE_SLOT);
+      UNSAFE.loadFence();
+      if ((before & 1) != 0) {
+        Thread.yield();
+        continue;
+      }
+      for (int i = 0; i < values.length; i++) {
+        values[i] = buffer.get(HEADER_SLOTS + i);
+      }
+      UNSAFE.loadFence();
+      if (buffer.get(SEQUENCE_SLOT) == before) {
+        return before / 2;
+      }
+    }
+  }
+
+  private static Metrics toMetrics(long[] flat, int n, Metrics.SingleMetric single) {
+    long[][] a = new long[NUM_TYPES][];
+    for (int type = 0; type < NUM_TYPES; type++) {
+      a[type] = new long[n];
+      System.arraycopy(flat, type * n, a[type], 0, n);
+    }
+    return new Metrics(
+        a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], single.veloxToArrow,
+        single.spilledMemoryTierBytes, a[10], a[11], a[12], a[13], a[14], a[15], a[16], a[17], a[18],
+        a[19], a[20], a[21], a[22], a[23], a[24], a[25], a[26], a[27], a[28], a[29], a[30], a[31],
+        a[32], a[33], a[34], a[35]);
+  }
+
+  private static long[][] toArrays(Metrics m) {
+    return new long[][] {
+      m.inputRows,
+      m.inputVectors,
+      m.inputBytes,
+      m.rawInputRows,
+      m.rawInputBytes,
+      m.outputRows,
+      m.outputVectors,
+      m.outputBytes,
+      m.cpuCount,
+      m.wallNanos,
+      m.peakMemoryBytes,
+      m.numMemoryAllocations,
+      m.spilledInputBytes,
+      m.spilledBytes,
+      m.spilledRows,
+      m.spilledPartitions,
+      m.spilledFiles,
+      m.numDynamicFiltersProduced,
+      m.numDynamicFiltersAccepted,
+      m.numReplacedWithDynamicFilterRows,
+      m.flushRowCount,
+      m.loadedToValueHook,
+      m.scanTime,
+      m.skippedSplits,
+      m.processedSplits,
+      m.skippedStrides,
+      m.processedStrides,
+      m.remainingFilterTime,
+      m.ioWaitTime,
+      m.storageReadBytes,
+      m.localReadBytes,
+      m.ramReadBytes,
+      m.preloadSplits,
+      m.physicalWrittenBytes,
+      m.writeIOTime,
+      m.numWrittenFiles
+    };
+  }
+}
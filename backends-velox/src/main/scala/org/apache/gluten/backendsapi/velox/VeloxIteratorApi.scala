@@ -16,11 +16,11 @@
  */
 package org.apache.gluten.backendsapi.velox
 
-import org.apache.gluten.GlutenNumaBindingInfo
+import org.apache.gluten.{GlutenConfig, GlutenNumaBindingInfo}
 import org.apache.gluten.backendsapi.{BackendsApiManager, IteratorApi}
 import org.apache.gluten.execution._
 import org.apache.gluten.iterator.Iterators
-import org.apache.gluten.metrics.{IMetrics, IteratorMetricsJniWrapper}
+import org.apache.gluten.metrics.{IMetrics, IteratorMetricsJniWrapper, MetricsSnapshot}
 import org.apache.gluten.sql.shims.SparkShimLoader
 import org.apache.gluten.substrait.plan.PlanNode
 import org.apache.gluten.substrait.rel.{LocalFilesBuilder, LocalFilesNode, SplitInfo}
@@ -47,6 +47,7 @@ import java.time.ZoneOffset
 import java.util.{ArrayList => JArrayList, HashMap => JHashMap, Map => JMap, UUID}
 
 import scala.collection.JavaConverters._
+import scala.util.control.NonFatal
 
 class VeloxIteratorApi extends IteratorApi with Logging {
 
@@ -181,9 +182,13 @@ class VeloxIteratorApi extends IteratorApi with Logging {
       inputPartition.isInstanceOf[GlutenPartition],
       "Velox backend only accept GlutenPartition.")
 
+    val liveMetrics = new LiveMetrics(updateNativeMetrics)
     val columnarNativeIterators =
       new JArrayList[ColumnarBatchInIterator](inputIterators.map {
-        iter => new ColumnarBatchInIterator(BackendsApiManager.getBackendName, iter.asJava)
+        iter =>
+          new ColumnarBatchInIterator(
+            BackendsApiManager.getBackendName,
+            liveMetrics.polling(iter).asJava)
       }.asJava)
     val transKernel = NativePlanEvaluator.create(BackendsApiManager.getBackendName)
 
@@ -203,13 +208,13 @@ class VeloxIteratorApi extends IteratorApi with Logging {
         partitionIndex,
         BackendsApiManager.getSparkPlanExecApiInstance.rewriteSpillPath(spillDirPath)
       )
-    val itrMetrics = IteratorMetricsJniWrapper.create()
+    liveMetrics.attach(resIter)
 
     Iterators
-      .wrap(resIter.asScala)
+      .wrap(liveMetrics.polling(resIter.asScala))
       .protectInvocationFlow()
       .recycleIterator {
-        updateNativeMetrics(itrMetrics.fetch(resIter))
+        liveMetrics.finish()
         updateInputMetrics(TaskContext.get().taskMetrics().inputMetrics)
         resIter.close()
       }
@@ -236,9 +241,13 @@ class VeloxIteratorApi extends IteratorApi with Logging {
     ExecutorManager.tryTaskSet(numaBindingInfo)
 
     val transKernel = NativePlanEvaluator.create(BackendsApiManager.getBackendName)
+    val liveMetrics = new LiveMetrics(updateNativeMetrics)
     val columnarNativeIterator =
       new JArrayList[ColumnarBatchInIterator](inputIterators.map {
-        iter => new ColumnarBatchInIterator(BackendsApiManager.getBackendName, iter.asJava)
+        iter =>
+          new ColumnarBatchInIterator(
+            BackendsApiManager.getBackendName,
+            liveMetrics.polling(iter).asJava)
       }.asJava)
     val spillDirPath = SparkDirectoryUtil
       .get()
@@ -254,13 +263,13 @@ class VeloxIteratorApi extends IteratorApi with Logging {
         partitionIndex,
         BackendsApiManager.getSparkPlanExecApiInstance.rewriteSpillPath(spillDirPath)
       )
-    val itrMetrics = IteratorMetricsJniWrapper.create()
+    liveMetrics.attach(nativeResultIterator)
 
     Iterators
-      .wrap(nativeResultIterator.asScala)
+      .wrap(liveMetrics.polling(nativeResultIterator.asScala))
       .protectInvocationFlow()
       .recycleIterator {
-        updateNativeMetrics(itrMetrics.fetch(nativeResultIterator))
+        liveMetrics.finish()
         nativeResultIterator.close()
       }
       .recyclePayload(batch => batch.close())
@@ -269,3 +278,80 @@ class VeloxIteratorApi extends IteratorApi with Logging {
   }
   // scalastyle:on argcount
 }
+
+/**
+ * Applies the native metrics of a result iterator to the SQL metrics. If
+ * spark.gluten.sql.columnar.backend.velox.metricsPublishIntervalMs is set, the native side keeps
+ * publishing the metrics of the running task, and whenever the task thread advances the output or
+ * an input iterator at least that long after the last poll, a newly published snapshot is applied
+ * as a delta. So the metrics progress even while the task doesn't output any batch, e.g. while an
+ * aggregation consumes its input. Otherwise the final metrics are applied once the iterator
+ * finishes.
+ *
+ * SQL metrics and task metrics are not thread-safe, so they are only updated on the task thread.
+ */
+private class LiveMetrics(updateNativeMetrics: IMetrics => Unit) extends Logging {
+  private val itrMetrics = IteratorMetricsJniWrapper.create()
+  private val intervalMs = GlutenConfig.getConf.veloxMetricsPublishIntervalMs
+  private var out: ColumnarBatchOutIterator = _
+  private var snapshot: MetricsSnapshot = _
+  private var lastPollMs = 0L
+  private var finished = false
+
+  def attach(out: ColumnarBatchOutIterator): Unit = {
+    this.out = out
+    lastPollMs = System.currentTimeMillis()
+  }
+
+  /** Wraps an iterator advanced by the task thread, so advancing it polls the live metrics. */
+  def polling[T](iter: Iterator[T]): Iterator[T] = {
+    if (intervalMs <= 0) {
+      return iter
+    }
+    new Iterator[T] {
+      override def hasNext: Boolean = {
+        poll()
+        iter.hasNext
+      }
+
+      override def next(): T = iter.next()
+    }
+  }
+
+  def finish(): Unit = {
+    // The snapshot buffer is owned by the native iterator, so it must not be read once this returns.
+    finished = true
+    val metrics = itrMetrics.fetch(out)
+    if (snapshot == null) {
+      updateNativeMetrics(metrics)
+    } else {
+      updateNativeMetrics(snapshot.finalDelta(metrics))
+    }
+  }
+
+  private def poll(): Unit = {
+    if (out == null || finished) {
+      return
+    }
+    val nowMs = System.currentTimeMillis()
+    if (nowMs - lastPollMs < intervalMs) {
+      return
+    }
+    lastPollMs = nowMs
+    try {
+      if (snapshot == null) {
+        snapshot = itrMetrics.snapshot(out)
+      }
+      if (snapshot != null) {
+        // Null if no new snapshot has been published since the last delta.
+        val delta = snapshot.delta()
+        if (delta != null) {
+          updateNativeMetrics(delta)
+        }
+      }
+    } catch {
+      case NonFatal(e) =>
+        logWarning("Failed to update live metrics", e)
+    }
+  }
+}
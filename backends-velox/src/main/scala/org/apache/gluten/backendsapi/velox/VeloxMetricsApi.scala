@@ -38,6 +38,26 @@ class VeloxMetricsApi extends MetricsApi with Logging {
     MetricsUtil.genMetricsUpdatingFunction(child, relMap, joinParamsMap, aggParamsMap)
   }
 
+  override def metricsUpdatingFunction(
+      child: SparkPlan,
+      relMap: JMap[JLong, JList[JLong]],
+      joinParamsMap: JMap[JLong, JoinParams],
+      aggParamsMap: JMap[JLong, AggregationParams],
+      wholeStageMetrics: Map[String, SQLMetric]): IMetrics => Unit = {
+    val updateOperators = metricsUpdatingFunction(child, relMap, joinParamsMap, aggParamsMap)
+    val spilledMemoryTierBytes = wholeStageMetrics("spilledMemoryTierBytes")
+    imetrics => {
+      updateOperators(imetrics)
+      MetricsUtil.updateTieredSpillMetrics(imetrics, spilledMemoryTierBytes)
+    }
+  }
+
+  override def genWholeStageTransformerMetrics(sparkContext: SparkContext): Map[String, SQLMetric] =
+    super.genWholeStageTransformerMetrics(sparkContext) ++ Map(
+      "spilledMemoryTierBytes" -> SQLMetrics.createSizeMetric(
+        sparkContext,
+        "bytes of spill kept in memory tier"))
+
   override def genInputIteratorTransformerMetrics(
       child: SparkPlan,
       sparkContext: SparkContext,
@@ -321,7 +341,10 @@ class VeloxMetricsApi extends MetricsApi with Logging {
       )
     } else {
       baseMetrics ++ Map(
-        "splitTime" -> SQLMetrics.createNanoTimingMetric(sparkContext, "time to split")
+        "splitTime" -> SQLMetrics.createNanoTimingMetric(sparkContext, "time to split"),
+        "adaptiveSortWriters" -> SQLMetrics.createMetric(
+          sparkContext,
+          "number of adaptive writers choosing sort")
       )
     }
   }
@@ -24,7 +24,7 @@ import org.apache.gluten.expression._
 import org.apache.gluten.expression.aggregate.{HLLAdapter, VeloxBloomFilterAggregate, VeloxCollectList, VeloxCollectSet}
 import org.apache.gluten.extension.columnar.FallbackTags
 import org.apache.gluten.sql.shims.SparkShimLoader
-import org.apache.gluten.vectorized.{ColumnarBatchSerializer, ColumnarBatchSerializeResult}
+import org.apache.gluten.vectorized.{ColumnarBatchSerializedChunks, ColumnarBatchSerializer}
 
 import org.apache.spark.{ShuffleDependency, SparkException}
 import org.apache.spark.api.python.{ColumnarArrowEvalPythonExec, PullOutArrowEvalPythonPreProjectHelper}
@@ -357,6 +357,10 @@ class VeloxSparkPlanExecApi extends SparkPlanExecApi {
     val child = shuffle.child
 
     val newShuffle = shuffle.outputPartitioning match {
+      case HashPartitioning(exprs, _)
+          if ExecUtil.fusedHashPartitionKeys(exprs, child.output).isDefined =>
+        // The native shuffle writer hashes the keys itself.
+        ColumnarShuffleExchangeExec(shuffle, child, child.output)
       case HashPartitioning(exprs, _) =>
         val hashExpr = new Murmur3Hash(exprs)
         val projectList = Seq(Alias(hashExpr, "hash_partition_key")()) ++ child.output
@@ -526,8 +530,19 @@ class VeloxSparkPlanExecApi extends SparkPlanExecApi {
       serializer: Serializer,
       writeMetrics: Map[String, SQLMetric],
       metrics: Map[String, SQLMetric],
-      isSort: Boolean): ShuffleDependency[Int, ColumnarBatch, ColumnarBatch] = {
+      isSort: Boolean,
+      sortOrder: Seq[SortOrder]): ShuffleDependency[Int, ColumnarBatch, ColumnarBatch] = {
     // scalastyle:on argcount
+    // The written columns exclude the partition key hash column, if any.
+    val writtenAttributes =
+      if (projectOutputAttributes != null) projectOutputAttributes else childOutputAttributes
+    val sortKeys = if (sortOrder.isEmpty) {
+      ""
+    } else {
+      ExecUtil
+        .shuffleSortKeys(sortOrder, writtenAttributes)
+        .getOrElse(throw new IllegalStateException(s"Unsupported shuffle sort order: $sortOrder"))
+    }
     ExecUtil.genShuffleDependency(
       rdd,
       childOutputAttributes,
@@ -535,7 +550,8 @@ class VeloxSparkPlanExecApi extends SparkPlanExecApi {
       serializer,
       writeMetrics,
       metrics,
-      isSort)
+      isSort,
+      sortKeys)
   }
   // scalastyle:on argcount
 
@@ -621,19 +637,19 @@ class VeloxSparkPlanExecApi extends SparkPlanExecApi {
       child: SparkPlan,
       numOutputRows: SQLMetric,
       dataSize: SQLMetric): BuildSideRelation = {
-    val serialized: Array[ColumnarBatchSerializeResult] = child
+    val serialized: Array[ColumnarBatchSerializedChunks] = child
       .executeColumnar()
-      .mapPartitions(itr => Iterator(BroadcastUtils.serializeStream(itr)))
+      .mapPartitions(itr => Iterator(BroadcastUtils.serializeStreamInTask(itr)))
       .filter(_.getNumRows != 0)
       .collect
-    val rawSize = serialized.map(_.getSerialized.length).sum
+    val rawSize = serialized.map(_.getSerializedSize).sum
     if (rawSize >= BroadcastExchangeExec.MAX_BROADCAST_TABLE_BYTES) {
       throw new SparkException(
         s"Cannot broadcast the table that is larger than 8GB: ${rawSize >> 30} GB")
     }
     numOutputRows += serialized.map(_.getNumRows).sum
     dataSize += rawSize
-    ColumnarBuildSideRelation(child.output, serialized.map(_.getSerialized), mode)
+    ColumnarBuildSideRelation(child.output, serialized, mode)
   }
 
   override def doCanonicalizeForBroadcastMode(mode: BroadcastMode): BroadcastMode = {
@@ -780,6 +796,12 @@ class VeloxSparkPlanExecApi extends SparkPlanExecApi {
           .scheme("jol")
           .toString
         rewritten
+      case "memory-over-local" =>
+        val rewritten = UriBuilder
+          .fromPath(path)
+          .scheme("tiered")
+          .toString
+        rewritten
       case other =>
         throw new IllegalStateException(s"Unsupported fs: $other")
     }
@@ -0,0 +1,127 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package org.apache.gluten.execution
+
+import org.apache.gluten.GlutenConfig
+import org.apache.gluten.backendsapi.BackendsApiManager
+import org.apache.gluten.extension.columnar.transition.Convention
+import org.apache.gluten.iterator.Iterators
+import org.apache.gluten.utils.VeloxSortedRunMerger
+
+import org.apache.spark.rdd.RDD
+import org.apache.spark.sql.catalyst.InternalRow
+import org.apache.spark.sql.catalyst.expressions.{Attribute, SortOrder}
+import org.apache.spark.sql.catalyst.plans.physical.Partitioning
+import org.apache.spark.sql.execution.{SparkPlan, UnaryExecNode}
+import org.apache.spark.sql.execution.metric.{SQLMetric, SQLMetrics}
+import org.apache.spark.sql.execution.utils.ExecUtil
+import org.apache.spark.sql.vectorized.ColumnarBatch
+import org.apache.spark.util.SparkDirectoryUtil
+
+import java.util.UUID
+import java.util.concurrent.atomic.AtomicLong
+
+import scala.collection.JavaConverters._
+
+/**
+ * Replaces the local sort of a shuffle read whose map tasks already ordered each partition by
+ * `sortOrder`. The rows of a partition then consist of one sorted run per map output, which this
+ * operator merges instead of sorting them again. The result is sorted by `sortOrder` for any input,
+ * the merge is only cheaper than a sort when the input has few runs.
+ */
+case class VeloxMergeSortedRunsExec(sortOrder: Seq[SortOrder], override val child: SparkPlan)
+  extends GlutenPlan
+  with UnaryExecNode {
+
+  private val sortKeys = ExecUtil
+    .shuffleSortKeys(sortOrder, child.output)
+    .getOrElse(throw new IllegalArgumentException(s"Unsupported sort order: $sortOrder"))
+
+  override lazy val metrics: Map[String, SQLMetric] = Map(
+    "numInputRows" -> SQLMetrics.createMetric(sparkContext, "number of input rows"),
+    "numInputBatches" -> SQLMetrics.createMetric(sparkContext, "number of input batches"),
+    "numOutputRows" -> SQLMetrics.createMetric(sparkContext, "number of output rows"),
+    "numOutputBatches" -> SQLMetrics.createMetric(sparkContext, "number of output batches"),
+    "selfTime" -> SQLMetrics.createTimingMetric(sparkContext, "time to merge sorted runs")
+  )
+
+  override def batchType(): Convention.BatchType = BackendsApiManager.getSettings.primaryBatchType
+
+  override def rowType0(): Convention.RowType = Convention.RowType.None
+
+  override protected def doExecute(): RDD[InternalRow] = throw new UnsupportedOperationException()
+
+  override protected def doExecuteColumnar(): RDD[ColumnarBatch] = {
+    val numInputRows = longMetric("numInputRows")
+    val numInputBatches = longMetric("numInputBatches")
+    val numOutputRows = longMetric("numOutputRows")
+    val numOutputBatches = longMetric("numOutputBatches")
+    val selfTime = longMetric("selfTime")
+    val batchSize = GlutenConfig.getConf.maxBatchSize
+    val mergeMemory = GlutenConfig.getConf.columnarShuffleSortedRunsMergeMemory
+
+    child.executeColumnar().mapPartitions {
+      in =>
+        // Merge millis = Out millis - In millis.
+        val mergeMillis = new AtomicLong(0L)
+        val spillDir = SparkDirectoryUtil
+          .get()
+          .namespace("gluten-spill")
+          .mkChildDirRoundRobin(UUID.randomUUID.toString)
+          .getAbsolutePath
+        val merger = VeloxSortedRunMerger.create(
+          sortKeys,
+          batchSize,
+          mergeMemory,
+          spillDir,
+          Iterators
+            .wrap(in)
+            .collectReadMillis(inMillis => mergeMillis.getAndAdd(-inMillis))
+            .create()
+            .map {
+              inBatch =>
+                numInputRows += inBatch.numRows()
+                numInputBatches += 1
+                inBatch
+            }
+            .asJava
+        )
+
+        Iterators
+          .wrap(merger.asScala)
+          .collectReadMillis(outMillis => mergeMillis.getAndAdd(outMillis))
+          .recyclePayload(_.close())
+          .recycleIterator {
+            merger.close()
+            selfTime += mergeMillis.get()
+          }
+          .create()
+          .map {
+            outBatch =>
+              numOutputRows += outBatch.numRows()
+              numOutputBatches += 1
+              outBatch
+          }
+    }
+  }
+
+  override def output: Seq[Attribute] = child.output
+  override def outputPartitioning: Partitioning = child.outputPartitioning
+  override def outputOrdering: Seq[SortOrder] = sortOrder
+  override protected def withNewChildInternal(newChild: SparkPlan): SparkPlan =
+    copy(child = newChild)
+}
@@ -69,6 +69,19 @@ case class VeloxGetStructFieldTransformer(
         val nodeType =
           node.getTypeNode.asInstanceOf[StructNode].getFieldTypes.get(ordinal)
         ExpressionBuilder.makeNullLiteral(nodeType)
+      case _ if original.child.isInstanceOf[NamedLambdaVariable] =>
+        // A field of a lambda argument, e.g. x.price in transform(items, x -> x.price).
+        val functionMap = args.asInstanceOf[JHashMap[String, JLong]]
+        val functionId = ExpressionBuilder.newScalarFunction(
+          functionMap,
+          ConverterUtils.makeFuncName(substraitExprName, Seq(original.child.dataType, IntegerType)))
+        val childNodes = new JArrayList[ExpressionNode]()
+        childNodes.add(childNode)
+        childNodes.add(ExpressionBuilder.makeIntLiteral(ordinal))
+        ExpressionBuilder.makeScalarFunction(
+          functionId,
+          childNodes,
+          ConverterUtils.getTypeNode(original.dataType, original.nullable))
       case _ =>
         throw new GlutenNotSupportException(
           s"Unsupported child expression of GetStructField: $original.")
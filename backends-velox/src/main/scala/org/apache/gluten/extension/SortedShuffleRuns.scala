@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package org.apache.gluten.extension
+
+import org.apache.gluten.GlutenConfig
+import org.apache.gluten.execution.{SortExecTransformer, VeloxMergeSortedRunsExec}
+
+import org.apache.spark.sql.catalyst.expressions.SortOrder
+import org.apache.spark.sql.catalyst.plans.physical.HashPartitioning
+import org.apache.spark.sql.catalyst.rules.Rule
+import org.apache.spark.sql.execution.{ColumnarShuffleExchangeExec, SortExec, SparkPlan}
+import org.apache.spark.sql.execution.adaptive.{AQEShuffleReadExec, ShuffleQueryStageExec}
+import org.apache.spark.sql.execution.exchange.ShuffleExchangeExec
+import org.apache.spark.sql.execution.utils.ExecUtil
+
+/**
+ * Lets the map side of a hash shuffle order each partition by the local sort that follows the
+ * shuffle read, e.g. the sort of a sort merge join, so that the reducer merges the sorted runs of
+ * the map outputs instead of sorting the whole partition.
+ *
+ * Two rules are involved:
+ *   - Before offload, tag the shuffle exchange below a local sort with the sort order. With AQE,
+ *     this is also a query stage preparation rule, since each shuffle is offloaded in its own stage
+ *   - After offload, replace the offloaded local sort above a sorted shuffle read with
+ *     VeloxMergeSortedRunsExec
+ */
+object SortedShuffleRuns {
+  private def enabled: Boolean = {
+    val conf = GlutenConfig.getConf
+    // The remote shuffle writers don't order the rows of a partition.
+    conf.columnarShuffleSortByKeys && !conf.isUseCelebornShuffleManager &&
+    !conf.isUseUniffleShuffleManager
+  }
+
+  object PreOffload extends Rule[SparkPlan] {
+    override def apply(plan: SparkPlan): SparkPlan = {
+      if (!enabled) {
+        return plan
+      }
+      plan.foreach {
+        case SortExec(sortOrder, false, shuffle: ShuffleExchangeExec, _)
+            if isEligible(shuffle, sortOrder) =>
+          shuffle.setTagValue(ColumnarShuffleExchangeExec.SORT_ORDER_TAG, sortOrder)
+        case _ =>
+      }
+      plan
+    }
+
+    private def isEligible(shuffle: ShuffleExchangeExec, sortOrder: Seq[SortOrder]): Boolean = {
+      shuffle.outputPartitioning match {
+        case p: HashPartitioning if p.numPartitions > 1 =>
+          ExecUtil.shuffleSortKeys(sortOrder, shuffle.child.output).isDefined
+        case _ => false
+      }
+    }
+  }
+
+  object PostOffload extends Rule[SparkPlan] {
+    override def apply(plan: SparkPlan): SparkPlan = {
+      if (!enabled) {
+        return plan
+      }
+      plan.transformUp {
+        case sort: SortExecTransformer if !sort.global && isSortedShuffleRead(sort) =>
+          VeloxMergeSortedRunsExec(sort.sortOrder, sort.child)
+      }
+    }
+
+    private def isSortedShuffleRead(sort: SortExecTransformer): Boolean = {
+      sortedShuffle(sort.child).exists {
+        shuffle =>
+          SortOrder.orderingSatisfies(shuffle.sortOrder, sort.sortOrder) &&
+          ExecUtil.shuffleSortKeys(sort.sortOrder, sort.child.output).isDefined
+      }
+    }
+
+    // A reused exchange is left out, its output attributes differ from the ones of the sort order.
+    private def sortedShuffle(plan: SparkPlan): Option[ColumnarShuffleExchangeExec] = plan match {
+      case shuffle: ColumnarShuffleExchangeExec if shuffle.sortOrder.nonEmpty => Some(shuffle)
+      case stage: ShuffleQueryStageExec => sortedShuffle(stage.plan)
+      case read: AQEShuffleReadExec => sortedShuffle(read.child)
+      case _ => None
+    }
+  }
+}
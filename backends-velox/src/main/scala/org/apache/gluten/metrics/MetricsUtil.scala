@@ -21,6 +21,7 @@ import org.apache.gluten.substrait.{AggregationParams, JoinParams}
 
 import org.apache.spark.internal.Logging
 import org.apache.spark.sql.execution.SparkPlan
+import org.apache.spark.sql.execution.metric.SQLMetric
 
 import java.lang.{Long => JLong}
 import java.util.{ArrayList => JArrayList, List => JList, Map => JMap}
@@ -339,4 +340,16 @@ object MetricsUtil extends Logging {
           ()
       }
   }
+
+  /**
+   * Adds the spilled bytes that the memory tier of the tiered spill file system kept to the
+   * stage-level metric. The operators' spilled bytes and the task's spill metrics are left as
+   * reported.
+   */
+  def updateTieredSpillMetrics(imetrics: IMetrics, spilledMemoryTierBytes: SQLMetric): Unit = {
+    val bytes = imetrics.asInstanceOf[Metrics].getSingleMetrics.spilledMemoryTierBytes
+    if (bytes != 0) {
+      spilledMemoryTierBytes += bytes
+    }
+  }
 }
@@ -55,7 +55,13 @@ class ColumnarBatchSerializer(
   with Serializable {
 
   private val shuffleWriterType =
-    if (isSort) GlutenConfig.GLUTEN_SORT_SHUFFLE_WRITER else GlutenConfig.GLUTEN_HASH_SHUFFLE_WRITER
+    if (isSort) {
+      GlutenConfig.GLUTEN_SORT_SHUFFLE_WRITER
+    } else if (GlutenConfig.getConf.columnarShuffleAdaptiveWriterEnabled) {
+      GlutenConfig.GLUTEN_ADAPTIVE_SHUFFLE_WRITER
+    } else {
+      GlutenConfig.GLUTEN_HASH_SHUFFLE_WRITER
+    }
 
   /** Creates a new [[SerializerInstance]]. */
   override def newInstance(): SerializerInstance = {
@@ -113,7 +113,13 @@ class ColumnarShuffleWriter[K, V](
   private val taskContext: TaskContext = TaskContext.get()
 
   private val shuffleWriterType: String =
-    if (isSort) GlutenConfig.GLUTEN_SORT_SHUFFLE_WRITER else GlutenConfig.GLUTEN_HASH_SHUFFLE_WRITER
+    if (isSort) {
+      GlutenConfig.GLUTEN_SORT_SHUFFLE_WRITER
+    } else if (GlutenConfig.getConf.columnarShuffleAdaptiveWriterEnabled) {
+      GlutenConfig.GLUTEN_ADAPTIVE_SHUFFLE_WRITER
+    } else {
+      GlutenConfig.GLUTEN_HASH_SHUFFLE_WRITER
+    }
 
   private def availableOffHeapPerTask(): Long = {
     val perTask =
@@ -141,6 +147,8 @@ class ColumnarShuffleWriter[K, V](
           nativeShuffleWriter = jniWrapper.make(
             dep.nativePartitioning.getShortName,
             dep.nativePartitioning.getNumPartitions,
+            GlutenShuffleUtils.getHashPartitionKeys(dep.nativePartitioning),
+            dep.sortKeys,
             nativeBufferSize,
             nativeMergeBufferSize,
             nativeMergeThreshold,
@@ -209,6 +217,18 @@ class ColumnarShuffleWriter[K, V](
       dep.metrics("sortTime").add(splitResult.getSortTime)
       dep.metrics("c2rTime").add(splitResult.getC2RTime)
     }
+    if (splitResult.getAdaptiveWriterType != null) {
+      logInfo(
+        s"Adaptive shuffle writer chose ${splitResult.getAdaptiveWriterType} from " +
+          s"${splitResult.getAdaptiveSampledRows} sampled rows of " +
+          s"${splitResult.getAdaptiveAvgRowBytes} bytes over " +
+          s"${splitResult.getAdaptiveActivePartitions} partitions with skew " +
+          s"${splitResult.getAdaptivePartitionSkew} and hash buffers of " +
+          s"${splitResult.getAdaptiveHashBufferRows} rows")
+      if (splitResult.getAdaptiveWriterType == GlutenConfig.GLUTEN_SORT_SHUFFLE_WRITER) {
+        dep.metrics("adaptiveSortWriters").add(1)
+      }
+    }
     dep.metrics("spillTime").add(splitResult.getTotalSpillTime)
     dep.metrics("bytesSpilled").add(splitResult.getTotalBytesSpilled)
     dep.metrics("dataSize").add(splitResult.getRawPartitionLengths.sum)
@@ -16,11 +16,13 @@
  */
 package org.apache.spark.sql.execution
 
+import org.apache.gluten.GlutenConfig
 import org.apache.gluten.backendsapi.BackendsApiManager
 import org.apache.gluten.columnarbatch.ColumnarBatches
+import org.apache.gluten.memory.memtarget.{MemoryTargets, Spillers}
 import org.apache.gluten.runtime.Runtimes
 import org.apache.gluten.sql.shims.SparkShimLoader
-import org.apache.gluten.vectorized.{ColumnarBatchSerializeResult, ColumnarBatchSerializerJniWrapper}
+import org.apache.gluten.vectorized.{ColumnarBatchSerializedChunks, ColumnarBatchSerializerJniWrapper}
 
 import org.apache.spark.SparkContext
 import org.apache.spark.broadcast.Broadcast
@@ -32,6 +34,8 @@ import org.apache.spark.sql.types.StructType
 import org.apache.spark.sql.vectorized.ColumnarBatch
 import org.apache.spark.task.TaskResources
 
+import java.util.Collections
+
 import scala.collection.mutable.ArrayBuffer;
 
 // Utility methods to convert Vanilla broadcast relations from/to Velox broadcast relations.
@@ -98,11 +102,11 @@ object BroadcastUtils {
         val fromRelation = fromBroadcast.value.asReadOnlyCopy()
         val toRelation = TaskResources.runUnsafe {
           val batchItr: Iterator[ColumnarBatch] = fn(reconstructRows(fromRelation))
-          val serialized: Array[Array[Byte]] = serializeStream(batchItr) match {
-            case ColumnarBatchSerializeResult.EMPTY =>
+          val serialized: Array[ColumnarBatchSerializedChunks] = serializeStream(batchItr) match {
+            case ColumnarBatchSerializedChunks.EMPTY =>
               Array()
-            case result: ColumnarBatchSerializeResult =>
-              Array(result.getSerialized)
+            case result: ColumnarBatchSerializedChunks =>
+              Array(result)
           }
           ColumnarBuildSideRelation(
             SparkShimLoader.getSparkShims.attributesFromStruct(schema),
@@ -117,11 +121,11 @@ object BroadcastUtils {
         val fromRelation = fromBroadcast.value
         val toRelation = TaskResources.runUnsafe {
           val batchItr: Iterator[ColumnarBatch] = fn(fromRelation.iterator)
-          val serialized: Array[Array[Byte]] = serializeStream(batchItr) match {
-            case ColumnarBatchSerializeResult.EMPTY =>
+          val serialized: Array[ColumnarBatchSerializedChunks] = serializeStream(batchItr) match {
+            case ColumnarBatchSerializedChunks.EMPTY =>
               Array()
-            case result: ColumnarBatchSerializeResult =>
-              Array(result.getSerialized)
+            case result: ColumnarBatchSerializedChunks =>
+              Array(result)
           }
           ColumnarBuildSideRelation(
             SparkShimLoader.getSparkShims.attributesFromStruct(schema),
@@ -143,7 +147,7 @@ object BroadcastUtils {
     }
   }
 
-  def serializeStream(batches: Iterator[ColumnarBatch]): ColumnarBatchSerializeResult = {
+  def serializeStream(batches: Iterator[ColumnarBatch]): ColumnarBatchSerializedChunks = {
     val filtered = batches
       .filter(_.numRows() != 0)
       .map(
@@ -153,7 +157,7 @@ object BroadcastUtils {
         })
       .toArray
     if (filtered.isEmpty) {
-      return ColumnarBatchSerializeResult.EMPTY
+      return ColumnarBatchSerializedChunks.EMPTY
     }
     val handleArray =
       filtered.map(b => ColumnarBatches.getNativeHandle(BackendsApiManager.getBackendName, b))
@@ -163,13 +167,36 @@ object BroadcastUtils {
           .create(
             Runtimes
               .contextInstance(BackendsApiManager.getBackendName, "BroadcastUtils#serializeStream"))
-          .serialize(handleArray)
+          .serializeToChunks(handleArray, GlutenConfig.getConf.columnarBroadcastChunkSize)
       } finally {
         filtered.foreach(ColumnarBatches.release)
       }
     serializeResult
   }
 
+  /**
+   * Serializes the batches of a task that collects them as its result. The chunks stay alive until
+   * the task result is sent, so they are charged to the task memory manager until the task
+   * completes rather than left as untracked direct memory.
+   */
+  def serializeStreamInTask(batches: Iterator[ColumnarBatch]): ColumnarBatchSerializedChunks = {
+    val serialized = serializeStream(batches)
+    val size = serialized.getSerializedSize
+    if (size != 0L) {
+      val target = MemoryTargets.throwOnOom(
+        MemoryTargets.newConsumer(
+          TaskResources.getLocalTaskContext().taskMemoryManager(),
+          "BroadcastChunks",
+          Spillers.NOOP,
+          Collections.emptyMap()))
+      target.borrow(size)
+      TaskResources.addRecycler("BroadcastUtils#BroadcastChunks", 100) {
+        target.repay(size)
+      }
+    }
+    serialized
+  }
+
   private def reconstructRows(relation: HashedRelation): Iterator[InternalRow] = {
     // It seems that LongHashedRelation and UnsafeHashedRelation don't follow the same
     //  criteria while getting values from them.
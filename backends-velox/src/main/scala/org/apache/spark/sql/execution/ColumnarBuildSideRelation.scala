@@ -20,10 +20,10 @@ import org.apache.gluten.backendsapi.BackendsApiManager
 import org.apache.gluten.columnarbatch.ColumnarBatches
 import org.apache.gluten.iterator.Iterators
 import org.apache.gluten.memory.arrow.alloc.ArrowBufferAllocators
-import org.apache.gluten.runtime.Runtimes
+import org.apache.gluten.runtime.{Runtime, Runtimes}
 import org.apache.gluten.sql.shims.SparkShimLoader
 import org.apache.gluten.utils.ArrowAbiUtil
-import org.apache.gluten.vectorized.{ColumnarBatchSerializerJniWrapper, NativeColumnarToRowJniWrapper}
+import org.apache.gluten.vectorized.{ColumnarBatchOutIterator, ColumnarBatchSerializedChunks, ColumnarBatchSerializerJniWrapper, NativeColumnarToRowJniWrapper}
 
 import org.apache.spark.sql.catalyst.InternalRow
 import org.apache.spark.sql.catalyst.expressions.{Attribute, Expression, UnsafeProjection, UnsafeRow}
@@ -35,6 +35,7 @@ import org.apache.spark.sql.internal.SQLConf
 import org.apache.spark.sql.utils.SparkArrowUtil
 import org.apache.spark.sql.vectorized.ColumnarBatch
 import org.apache.spark.task.TaskResources
+import org.apache.spark.util.KnownSizeEstimation
 
 import org.apache.arrow.c.ArrowSchema
 
@@ -42,9 +43,10 @@ import scala.collection.JavaConverters.asScalaIteratorConverter
 
 case class ColumnarBuildSideRelation(
     output: Seq[Attribute],
-    batches: Array[Array[Byte]],
+    batches: Array[ColumnarBatchSerializedChunks],
     mode: BroadcastMode)
-  extends BuildSideRelation {
+  extends BuildSideRelation
+  with KnownSizeEstimation {
 
   private def transformProjection: UnsafeProjection = {
     mode match {
@@ -53,6 +55,38 @@ case class ColumnarBuildSideRelation(
     }
   }
 
+  /**
+   * Deserializes the batches lazily, one Presto page at a time, straight from the off-heap chunks
+   * of every serialized partition.
+   */
+  private def deserializeBatches(
+      runtime: Runtime,
+      jniWrapper: ColumnarBatchSerializerJniWrapper,
+      serializeHandle: Long): Iterator[ColumnarBatch] = {
+    batches.iterator.flatMap {
+      serialized =>
+        val outIterator = new ColumnarBatchOutIterator(
+          runtime,
+          jniWrapper.deserializeChunks(serializeHandle, serialized.getChunks))
+        new Iterator[ColumnarBatch] {
+          private var exhausted = false
+
+          override def hasNext: Boolean = {
+            if (!exhausted && !outIterator.hasNext) {
+              outIterator.close()
+              exhausted = true
+            }
+            !exhausted
+          }
+
+          override def next(): ColumnarBatch = {
+            if (!hasNext) throw new NoSuchElementException
+            outIterator.next()
+          }
+        }
+    }
+  }
+
   override def deserialized: Iterator[ColumnarBatch] = {
     val runtime =
       Runtimes.contextInstance(BackendsApiManager.getBackendName, "BuildSideRelation#deserialized")
@@ -71,21 +105,7 @@ case class ColumnarBuildSideRelation(
     }
 
     Iterators
-      .wrap(new Iterator[ColumnarBatch] {
-        var batchId = 0
-
-        override def hasNext: Boolean = {
-          batchId < batches.length
-        }
-
-        override def next: ColumnarBatch = {
-          val handle =
-            jniWrapper
-              .deserialize(serializeHandle, batches(batchId))
-          batchId += 1
-          ColumnarBatches.create(handle)
-        }
-      })
+      .wrap(deserializeBatches(runtime, jniWrapper, serializeHandle))
       .protectInvocationFlow()
       .recycleIterator {
         jniWrapper.close(serializeHandle)
@@ -94,6 +114,12 @@ case class ColumnarBuildSideRelation(
       .create()
   }
 
+  /**
+   * The chunks are off-heap, so the block manager can't see them when it sizes the cached broadcast
+   * value. Report them so the relation is charged to storage memory like a vanilla HashedRelation.
+   */
+  override def estimatedSize: Long = batches.map(_.getSerializedSize).sum
+
   override def asReadOnlyCopy(): ColumnarBuildSideRelation = this
 
   /**
@@ -127,11 +153,11 @@ case class ColumnarBuildSideRelation(
     // Convert columnar to Row.
     val jniWrapper = NativeColumnarToRowJniWrapper.create(runtime)
     val c2rId = jniWrapper.nativeColumnarToRowInit()
-    var batchId = 0
     val iterator = if (batches.length > 0) {
+      val deserializedBatches = deserializeBatches(runtime, serializerJniWrapper, serializeHandle)
       val res: Iterator[Iterator[InternalRow]] = new Iterator[Iterator[InternalRow]] {
         override def hasNext: Boolean = {
-          val itHasNext = batchId < batches.length
+          val itHasNext = deserializedBatches.hasNext
           if (!itHasNext && !closed) {
             jniWrapper.nativeClose(c2rId)
             serializerJniWrapper.close(serializeHandle)
@@ -141,11 +167,8 @@ case class ColumnarBuildSideRelation(
         }
 
         override def next(): Iterator[InternalRow] = {
-          val batchBytes = batches(batchId)
-          batchId += 1
-          val batchHandle =
-            serializerJniWrapper.deserialize(serializeHandle, batchBytes)
-          val batch = ColumnarBatches.create(batchHandle)
+          val batch = deserializedBatches.next()
+          val batchHandle = ColumnarBatches.getNativeHandle(BackendsApiManager.getBackendName, batch)
           if (batch.numRows == 0) {
             batch.close()
             Iterator.empty
@@ -16,6 +16,7 @@
  */
 package org.apache.spark.sql.execution.utils
 
+import org.apache.gluten.GlutenConfig
 import org.apache.gluten.backendsapi.BackendsApiManager
 import org.apache.gluten.columnarbatch.{ColumnarBatches, VeloxColumnarBatches}
 import org.apache.gluten.iterator.Iterators
@@ -28,19 +29,66 @@ import org.apache.spark.rdd.RDD
 import org.apache.spark.serializer.Serializer
 import org.apache.spark.shuffle.{ColumnarShuffleDependency, GlutenShuffleUtils}
 import org.apache.spark.sql.catalyst.InternalRow
-import org.apache.spark.sql.catalyst.expressions.{Attribute, BoundReference, UnsafeProjection, UnsafeRow}
+import org.apache.spark.sql.catalyst.expressions.{Attribute, BoundReference, Expression, NullsFirst, SortOrder, UnsafeProjection, UnsafeRow}
 import org.apache.spark.sql.catalyst.expressions.codegen.LazilyGeneratedOrdering
 import org.apache.spark.sql.catalyst.plans.physical._
 import org.apache.spark.sql.execution.SQLExecution
 import org.apache.spark.sql.execution.exchange.ShuffleExchangeExec
 import org.apache.spark.sql.execution.metric.{SQLMetric, SQLMetrics}
 import org.apache.spark.sql.internal.SQLConf
-import org.apache.spark.sql.types.{IntegerType, StructType}
+import org.apache.spark.sql.types._
 import org.apache.spark.sql.vectorized.{ColumnarBatch, ColumnVector}
 import org.apache.spark.util.MutablePair
 
 object ExecUtil {
 
+  /**
+   * Returns the ordinals of the hash partitioning keys in the shuffle input if the native shuffle
+   * writer can compute the Spark murmur3 hash of the keys itself, so no projected hash column is
+   * needed. The planner and the shuffle dependency must both use this to agree on the input
+   * layout.
+   */
+  def fusedHashPartitionKeys(exprs: Seq[Expression], output: Seq[Attribute]): Option[Seq[Int]] = {
+    def supportedType(dataType: DataType): Boolean = dataType match {
+      case BooleanType | ByteType | ShortType | IntegerType | LongType | FloatType | DoubleType |
+          StringType | BinaryType | DateType | TimestampType =>
+        true
+      case d: DecimalType => d.precision <= Decimal.MAX_LONG_DIGITS
+      case _ => false
+    }
+    if (!GlutenConfig.getConf.columnarShuffleFuseHashPartitioning || exprs.isEmpty) {
+      return None
+    }
+    val ordinals = exprs.map {
+      case a: Attribute if supportedType(a.dataType) => output.indexWhere(_.exprId == a.exprId)
+      case _ => -1
+    }
+    if (ordinals.contains(-1)) None else Some(ordinals)
+  }
+
+  /**
+   * Returns the keys the native sort shuffle writer and the sorted run merger order rows by, in the
+   * format of `ShuffleWriterJniWrapper#make`, or None if some key is not a column of `output` with
+   * a type they can order by.
+   */
+  def shuffleSortKeys(sortOrder: Seq[SortOrder], output: Seq[Attribute]): Option[String] = {
+    def supportedType(dataType: DataType): Boolean = dataType match {
+      case BooleanType | ByteType | ShortType | IntegerType | LongType | FloatType | DoubleType |
+          StringType | BinaryType | DateType | TimestampType | _: DecimalType =>
+        true
+      case _ => false
+    }
+    val keys = sortOrder.map {
+      case order @ SortOrder(a: Attribute, _, _, _) if supportedType(a.dataType) =>
+        val ordinal = output.indexWhere(_.exprId == a.exprId)
+        val direction = if (order.isAscending) "asc" else "desc"
+        val nulls = if (order.nullOrdering == NullsFirst) "nulls_first" else "nulls_last"
+        if (ordinal < 0) None else Some(s"$ordinal:$direction:$nulls")
+      case _ => None
+    }
+    if (keys.isEmpty || keys.contains(None)) None else Some(keys.flatten.mkString(","))
+  }
+
   def convertColumnarToRow(batch: ColumnarBatch): Iterator[InternalRow] = {
     val runtime =
       Runtimes.contextInstance(BackendsApiManager.getBackendName, "ExecUtil#ColumnarToRow")
@@ -88,7 +136,8 @@ object ExecUtil {
       serializer: Serializer,
       writeMetrics: Map[String, SQLMetric],
       metrics: Map[String, SQLMetric],
-      isSort: Boolean): ShuffleDependency[Int, ColumnarBatch, ColumnarBatch] = {
+      isSort: Boolean,
+      sortKeys: String = ""): ShuffleDependency[Int, ColumnarBatch, ColumnarBatch] = {
     metrics("numPartitions").set(newPartitioning.numPartitions)
     val executionId = rdd.sparkContext.getLocalProperty(SQLExecution.EXECUTION_ID_KEY)
     SQLMetrics.postDriverMetricUpdates(
@@ -166,7 +215,15 @@ object ExecUtil {
       case RoundRobinPartitioning(n) =>
         new NativePartitioning(GlutenShuffleUtils.RoundRobinPartitioningShortName, n)
       case HashPartitioning(exprs, n) =>
-        new NativePartitioning(GlutenShuffleUtils.HashPartitioningShortName, n)
+        fusedHashPartitionKeys(exprs, outputAttributes) match {
+          case Some(ordinals) =>
+            new NativePartitioning(
+              GlutenShuffleUtils.HashPartitioningShortName,
+              n,
+              ordinals.mkString(",").getBytes)
+          case None =>
+            new NativePartitioning(GlutenShuffleUtils.HashPartitioningShortName, n)
+        }
       // range partitioning fall back to row-based partition id computation
       case RangePartitioning(orders, n) =>
         new NativePartitioning(GlutenShuffleUtils.RangePartitioningShortName, n)
@@ -209,7 +266,8 @@ object ExecUtil {
         shuffleWriterProcessor = ShuffleExchangeExec.createShuffleWriteProcessor(writeMetrics),
         nativePartitioning = nativePartitioning,
         metrics = metrics,
-        isSort = isSort
+        isSort = isSort,
+        sortKeys = sortKeys
       )
 
     dependency
@@ -1264,6 +1264,20 @@ class MiscOperatorSuite extends VeloxWholeStageTransformerSuite with AdaptiveSpa
     }
   }
 
+  test("Test randomSplit is disjoint and complete") {
+    withSQLConf("spark.gluten.sql.columnarSampleEnabled" -> "true") {
+      withTable("t") {
+        sql("create table t using parquet as select id from range(1000)")
+        val splits = spark.table("t").randomSplit(Array(0.2, 0.3, 0.5), seed = 7)
+        splits.foreach(split => checkGlutenOperatorMatch[SampleExecTransformer](split))
+        val ids = splits.map(_.collect().map(_.getLong(0)))
+        assert(ids.forall(_.nonEmpty))
+        assert(ids.map(_.length).sum == 1000)
+        assert(ids.flatten.toSet == (0L until 1000L).toSet)
+      }
+    }
+  }
+
   test("test cross join") {
     withTable("t1", "t2") {
       sql("""
@@ -1403,6 +1417,40 @@ class MiscOperatorSuite extends VeloxWholeStageTransformerSuite with AdaptiveSpa
     }
   }
 
+  test("sort merge join merges the sorted runs of the shuffle") {
+    withTable("t1", "t2") {
+      sql("""
+            |create table t1 using parquet as
+            |select cast(id % 37 as int) as c1, cast(id as string) c2 from range(1000)
+            |""".stripMargin)
+      sql("""
+            |create table t2 using parquet as
+            |select cast(id as int) as c1, cast(id as string) c2 from range(100) order by c1 desc;
+            |""".stripMargin)
+      Seq("128MB", "0").foreach {
+        mergeMemory =>
+          withSQLConf(
+            "spark.gluten.sql.columnar.forceShuffledHashJoin" -> "false",
+            SQLConf.SHUFFLE_PARTITIONS.key -> "3",
+            GlutenConfig.COLUMNAR_SHUFFLE_SORT_BY_KEYS.key -> "true",
+            GlutenConfig.COLUMNAR_SHUFFLE_SORTED_RUNS_MERGE_MEMORY.key -> mergeMemory
+          ) {
+            runQueryAndCompare(
+              """
+                |select * from t1 left join t2 on t1.c1 = t2.c1 and t1.c1 > 10;
+                |""".stripMargin
+            ) {
+              df =>
+                checkGlutenOperatorMatch[SortMergeJoinExecTransformer](df)
+                val plan = getExecutedPlan(df)
+                assert(plan.count(_.isInstanceOf[VeloxMergeSortedRunsExec]) == 2)
+                assert(plan.count(_.isInstanceOf[SortExecTransformer]) == 0)
+            }
+          }
+      }
+    }
+  }
+
   test("Fix incorrect path by decode") {
     val c = "?.+<_>|/"
     val path = rootPath + "/test +?.+<_>|"
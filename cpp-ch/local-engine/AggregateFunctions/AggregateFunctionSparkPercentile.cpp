@@ -0,0 +1,409 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AggregateFunctionSparkPercentile.h"
+
+#include <filesystem>
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <AggregateFunctions/FactoryHelpers.h>
+#include <Compression/CompressedReadBuffer.h>
+#include <Compression/CompressedWriteBuffer.h>
+#include <Core/Settings.h>
+#include <Disks/IVolume.h>
+#include <IO/ReadBufferFromFile.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteBufferFromFile.h>
+#include <IO/WriteHelpers.h>
+#include <Interpreters/Context.h>
+#include <Common/FieldVisitorConvertToNumber.h>
+#include <Common/GlutenSettings.h>
+#include <Common/QueryContext.h>
+
+namespace DB
+{
+struct Settings;
+
+namespace ErrorCodes
+{
+extern const int BAD_ARGUMENTS;
+extern const int ILLEGAL_TYPE_OF_ARGUMENT;
+extern const int NUMBER_OF_ARGUMENTS_DOESNT_MATCH;
+}
+}
+
+namespace local_engine
+{
+using namespace DB;
+
+namespace
+{
+/// Runtime setting bounding the distinct values a single group keeps in memory.
+constexpr auto PERCENTILE_MAX_ENTRIES_IN_MEMORY = "percentile_max_entries_in_memory";
+
+void writeEntry(const SparkPercentileData::Entry & entry, WriteBuffer & out)
+{
+    writeBinary(entry.first, out);
+    writeVarUInt(entry.second, out);
+}
+
+void readEntry(SparkPercentileData::Entry & entry, ReadBuffer & in)
+{
+    readBinary(entry.first, in);
+    readVarUInt(entry.second, in);
+}
+
+class RunWriter
+{
+public:
+    explicit RunWriter(const String & path) : file_out(path), out(file_out) { }
+
+    void write(const SparkPercentileData::Entry & entry)
+    {
+        writeEntry(entry, out);
+        ++entries;
+    }
+
+    size_t finalize()
+    {
+        out.finalize();
+        file_out.finalize();
+        return entries;
+    }
+
+private:
+    WriteBufferFromFile file_out;
+    CompressedWriteBuffer out;
+    size_t entries = 0;
+};
+
+class RunReader
+{
+public:
+    RunReader(const String & path, size_t size) : file_in(path), in(file_in), remaining(size) { }
+
+    bool next()
+    {
+        if (remaining == 0)
+            return false;
+        readEntry(entry, in);
+        --remaining;
+        return true;
+    }
+
+    const SparkPercentileData::Entry & current() const { return entry; }
+
+private:
+    ReadBufferFromFile file_in;
+    CompressedReadBuffer in;
+    size_t remaining;
+    SparkPercentileData::Entry entry;
+};
+}
+
+void SparkPercentileData::add(Float64 value, UInt64 weight, const PercentileSpillSettings & settings)
+{
+    if (weight == 0)
+        return;
+
+    total += weight;
+    if (std::isnan(value))
+    {
+        nan_count += weight;
+        return;
+    }
+
+    map[value] += weight;
+    if (map.size() >= settings.max_entries_in_memory)
+        spill(settings);
+}
+
+void SparkPercentileData::merge(const SparkPercentileData & rhs, const PercentileSpillSettings & settings)
+{
+    for (const auto & cell : rhs.map)
+        add(cell.getKey(), cell.getMapped(), settings);
+
+    for (const auto & run : rhs.runs)
+    {
+        RunReader reader(run.file->path(), run.size);
+        while (reader.next())
+            add(reader.current().first, reader.current().second, settings);
+    }
+
+    if (rhs.nan_count)
+        add(std::numeric_limits<Float64>::quiet_NaN(), rhs.nan_count, settings);
+}
+
+void SparkPercentileData::serialize(WriteBuffer & buf, const PercentileSpillSettings & settings) const
+{
+    writeVarUInt(nan_count, buf);
+
+    /// The map and the runs are merged on the fly into ascending distinct values, which are written in chunks
+    /// prefixed by their size. An empty chunk ends them.
+    std::vector<Entry> chunk;
+    const auto write_chunk = [&]
+    {
+        writeVarUInt(chunk.size(), buf);
+        for (const auto & entry : chunk)
+            writeEntry(entry, buf);
+        chunk.clear();
+    };
+    forEachDistinct(
+        [&](const Entry & entry)
+        {
+            chunk.push_back(entry);
+            if (chunk.size() >= settings.max_entries_in_memory)
+                write_chunk();
+        });
+    if (!chunk.empty())
+        write_chunk();
+    writeVarUInt(0, buf);
+}
+
+void SparkPercentileData::deserialize(ReadBuffer & buf, const PercentileSpillSettings & settings)
+{
+    UInt64 nans;
+    readVarUInt(nans, buf);
+    if (nans)
+        add(std::numeric_limits<Float64>::quiet_NaN(), nans, settings);
+
+    Entry entry;
+    while (true)
+    {
+        size_t chunk_size;
+        readVarUInt(chunk_size, buf);
+        if (chunk_size == 0)
+            break;
+
+        if (map.size() + chunk_size < settings.max_entries_in_memory)
+        {
+            for (size_t i = 0; i < chunk_size; ++i)
+            {
+                readEntry(entry, buf);
+                add(entry.first, entry.second, settings);
+            }
+            continue;
+        }
+
+        /// A chunk is sorted and distinct already, so it is copied to a run without going through the map.
+        auto file = createTemporaryFile(settings.tmp_path);
+        RunWriter writer(file->path());
+        for (size_t i = 0; i < chunk_size; ++i)
+        {
+            readEntry(entry, buf);
+            total += entry.second;
+            writer.write(entry);
+        }
+        runs.push_back({std::move(file), writer.finalize()});
+        if (runs.size() >= settings.max_runs)
+            compactRuns(settings);
+    }
+}
+
+void SparkPercentileData::getPercentiles(const std::vector<Float64> & levels, Float64 * result) const
+{
+    constexpr auto nan = std::numeric_limits<Float64>::quiet_NaN();
+    if (total == 0)
+    {
+        std::fill_n(result, levels.size(), nan);
+        return;
+    }
+
+    /// Same as Spark's Percentile.getPercentile: the value at position (total - 1) * level, interpolated
+    /// between the values at the neighbouring integral positions. Only those positions are looked up.
+    const auto max_position = static_cast<Float64>(total - 1);
+    std::vector<UInt64> ranks;
+    for (const Float64 level : levels)
+    {
+        const Float64 position = max_position * level;
+        ranks.push_back(static_cast<UInt64>(std::floor(position)));
+        ranks.push_back(static_cast<UInt64>(std::ceil(position)));
+    }
+    std::ranges::sort(ranks);
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+    /// Ranks past the ordered values belong to NaNs, which sort last.
+    std::vector<Float64> rank_values(ranks.size(), nan);
+    size_t next_rank = 0;
+    UInt64 accumulated = 0;
+    forEachSorted(
+        [&](const Entry & entry)
+        {
+            accumulated += entry.second;
+            while (next_rank < ranks.size() && ranks[next_rank] < accumulated)
+                rank_values[next_rank++] = entry.first;
+        });
+
+    const auto value_at = [&](UInt64 rank) { return rank_values[std::ranges::lower_bound(ranks, rank) - ranks.begin()]; };
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+        const Float64 position = max_position * levels[i];
+        const auto lower = static_cast<UInt64>(std::floor(position));
+        const auto higher = static_cast<UInt64>(std::ceil(position));
+        const Float64 lower_value = value_at(lower);
+        const Float64 higher_value = value_at(higher);
+        if (lower == higher || lower_value == higher_value || std::isnan(lower_value))
+            result[i] = lower_value;
+        else
+            result[i] = (static_cast<Float64>(higher) - position) * lower_value + (position - static_cast<Float64>(lower)) * higher_value;
+    }
+}
+
+std::vector<SparkPercentileData::Entry> SparkPercentileData::sortedEntries() const
+{
+    std::vector<Entry> entries;
+    entries.reserve(map.size());
+    for (const auto & cell : map)
+        entries.emplace_back(cell.getKey(), cell.getMapped());
+    std::ranges::sort(entries, {}, &Entry::first);
+    return entries;
+}
+
+void SparkPercentileData::forEachSorted(const std::function<void(const Entry &)> & callback) const
+{
+    const auto in_memory = sortedEntries();
+    if (runs.empty())
+    {
+        std::ranges::for_each(in_memory, callback);
+        return;
+    }
+
+    std::vector<std::unique_ptr<RunReader>> readers;
+    readers.reserve(runs.size());
+    for (const auto & run : runs)
+        readers.emplace_back(std::make_unique<RunReader>(run.file->path(), run.size));
+
+    /// K-way merge over the runs and the in-memory entries, which are the last source.
+    const size_t memory_source = readers.size();
+    size_t memory_pos = 0;
+    const auto current = [&](size_t source) -> const Entry &
+    { return source == memory_source ? in_memory[memory_pos] : readers[source]->current(); };
+    const auto greater = [&](size_t lhs, size_t rhs) { return current(lhs).first > current(rhs).first; };
+
+    std::vector<size_t> heap;
+    for (size_t source = 0; source < readers.size(); ++source)
+        if (readers[source]->next())
+            heap.push_back(source);
+    if (!in_memory.empty())
+        heap.push_back(memory_source);
+    std::ranges::make_heap(heap, greater);
+
+    while (!heap.empty())
+    {
+        std::ranges::pop_heap(heap, greater);
+        const size_t source = heap.back();
+        callback(current(source));
+
+        const bool has_next = source == memory_source ? ++memory_pos < in_memory.size() : readers[source]->next();
+        if (has_next)
+            std::ranges::push_heap(heap, greater);
+        else
+            heap.pop_back();
+    }
+}
+
+void SparkPercentileData::forEachDistinct(const std::function<void(const Entry &)> & callback) const
+{
+    std::optional<Entry> pending;
+    forEachSorted(
+        [&](const Entry & entry)
+        {
+            if (pending && pending->first == entry.first)
+            {
+                pending->second += entry.second;
+                return;
+            }
+            if (pending)
+                callback(*pending);
+            pending = entry;
+        });
+    if (pending)
+        callback(*pending);
+}
+
+void SparkPercentileData::spill(const PercentileSpillSettings & settings)
+{
+    auto file = createTemporaryFile(settings.tmp_path);
+    RunWriter writer(file->path());
+    for (const auto & entry : sortedEntries())
+        writer.write(entry);
+    runs.push_back({std::move(file), writer.finalize()});
+    map.clearAndShrink();
+
+    if (runs.size() >= settings.max_runs)
+        compactRuns(settings);
+}
+
+void SparkPercentileData::compactRuns(const PercentileSpillSettings & settings)
+{
+    auto file = createTemporaryFile(settings.tmp_path);
+    RunWriter writer(file->path());
+    forEachDistinct([&](const Entry & entry) { writer.write(entry); });
+
+    const size_t size = writer.finalize();
+    runs.clear();
+    runs.push_back({std::move(file), size});
+}
+
+template <bool returns_many>
+AggregateFunctionPtr createAggregateFunctionSparkPercentile(
+    const std::string & name, const DataTypes & argument_types, const Array & parameters, const Settings * settings)
+{
+    assertBinary(name, argument_types);
+    if (!isNumber(argument_types[0]))
+        throw Exception(
+            ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+            "Illegal type {} of argument for aggregate function {}",
+            argument_types[0]->getName(),
+            name);
+    if (!WhichDataType(argument_types[1]).isUInt64())
+        throw Exception(
+            ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+            "Weight of aggregate function {} must be UInt64, but is {}",
+            name,
+            argument_types[1]->getName());
+
+    if (parameters.empty() || (!returns_many && parameters.size() != 1))
+        throw Exception(
+            ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH, "Aggregate function {} got {} levels", name, parameters.size());
+
+    std::vector<Float64> levels;
+    for (const auto & parameter : parameters)
+    {
+        const auto level = applyVisitor(FieldVisitorConvertToNumber<Float64>(), parameter);
+        if (level < 0 || level > 1)
+            throw Exception(ErrorCodes::BAD_ARGUMENTS, "Level {} of aggregate function {} must be in [0, 1]", level, name);
+        levels.push_back(level);
+    }
+
+    PercentileSpillSettings spill_settings;
+    if (String value; settings && tryGetString(*settings, PERCENTILE_MAX_ENTRIES_IN_MEMORY, value))
+        spill_settings.max_entries_in_memory = std::max<size_t>(1, parse<UInt64>(value));
+    if (const auto volume = QueryContext::globalContext()->getGlobalTemporaryVolume())
+        spill_settings.tmp_path = volume->getDisk()->getPath();
+    else
+        spill_settings.tmp_path = std::filesystem::temp_directory_path();
+
+    return std::make_shared<AggregateFunctionSparkPercentile<returns_many>>(
+        argument_types, parameters, std::move(levels), std::move(spill_settings));
+}
+
+void registerAggregateFunctionSparkPercentile(AggregateFunctionFactory & factory)
+{
+    factory.registerFunction("sparkPercentile", createAggregateFunctionSparkPercentile<false>);
+    factory.registerFunction("sparkPercentiles", createAggregateFunctionSparkPercentile<true>);
+}
+
+}
@@ -0,0 +1,161 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AggregateFunctions/IAggregateFunction.h>
+#include <Columns/ColumnArray.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeArray.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Common/HashTable/HashMap.h>
+#include <Common/assert_cast.h>
+#include <Common/filesystemHelpers.h>
+
+namespace local_engine
+{
+
+struct PercentileSpillSettings
+{
+    /// Distinct values a single group keeps in memory before they are written out as a sorted run.
+    size_t max_entries_in_memory = 1 << 20;
+    /// Runs are merged into one once a group has that many, which bounds the files open in finalize.
+    size_t max_runs = 16;
+    String tmp_path;
+};
+
+/// State of Spark's exact `percentile`: a value -> frequency map as in quantileExactWeighted, except that
+/// a group holding too many distinct values sorts its map into a run on disk and starts over. Values are
+/// kept as Float64, Spark interpolates on doubles as well, and NaNs are counted apart since Spark orders
+/// them after every other value.
+class SparkPercentileData
+{
+public:
+    using Entry = std::pair<Float64, UInt64>;
+
+    void add(Float64 value, UInt64 weight, const PercentileSpillSettings & settings);
+    void merge(const SparkPercentileData & rhs, const PercentileSpillSettings & settings);
+    /// Writes the distinct values in ascending order, streaming the spilled runs, in chunks of at most
+    /// max_entries_in_memory values. The reader keeps a chunk which does not fit in its map as a run of its own,
+    /// so neither side holds more than a chunk, and the runs are merged when the final stage computes the result.
+    void serialize(DB::WriteBuffer & buf, const PercentileSpillSettings & settings) const;
+    void deserialize(DB::ReadBuffer & buf, const PercentileSpillSettings & settings);
+
+    /// Spark's interpolated percentiles, NaN when the state is empty.
+    void getPercentiles(const std::vector<Float64> & levels, Float64 * result) const;
+
+    size_t entriesInMemory() const { return map.size(); }
+    size_t spilledRuns() const { return runs.size(); }
+
+private:
+    struct Run
+    {
+        std::unique_ptr<DB::TemporaryFile> file;
+        size_t size;
+    };
+
+    void spill(const PercentileSpillSettings & settings);
+    void compactRuns(const PercentileSpillSettings & settings);
+    std::vector<Entry> sortedEntries() const;
+
+    /// Feeds every (value, weight) of the map and the runs to `callback` in ascending value order.
+    void forEachSorted(const std::function<void(const Entry &)> & callback) const;
+    /// Same as forEachSorted, but sums the weights of a value found in several sources.
+    void forEachDistinct(const std::function<void(const Entry &)> & callback) const;
+
+    DB::HashMap<Float64, UInt64, DB::HashCRC32<Float64>> map;
+    std::vector<Run> runs;
+    UInt64 nan_count = 0;
+    UInt64 total = 0;
+};
+
+/// sparkPercentile(level)(value, weight) and sparkPercentiles(level1, level2, ...)(value, weight).
+template <bool returns_many>
+class AggregateFunctionSparkPercentile final
+    : public DB::IAggregateFunctionDataHelper<SparkPercentileData, AggregateFunctionSparkPercentile<returns_many>>
+{
+public:
+    using Base = DB::IAggregateFunctionDataHelper<SparkPercentileData, AggregateFunctionSparkPercentile<returns_many>>;
+
+    AggregateFunctionSparkPercentile(
+        const DB::DataTypes & argument_types_,
+        const DB::Array & params,
+        std::vector<Float64> levels_,
+        PercentileSpillSettings spill_settings_)
+        : Base(argument_types_, params, createResultType())
+        , levels(std::move(levels_))
+        , spill_settings(std::move(spill_settings_))
+    {
+    }
+
+    static DB::DataTypePtr createResultType()
+    {
+        if constexpr (returns_many)
+            return std::make_shared<DB::DataTypeArray>(std::make_shared<DB::DataTypeFloat64>());
+        else
+            return std::make_shared<DB::DataTypeFloat64>();
+    }
+
+    String getName() const override { return returns_many ? "sparkPercentiles" : "sparkPercentile"; }
+
+    bool allocatesMemoryInArena() const override { return false; }
+
+    void add(DB::AggregateDataPtr __restrict place, const DB::IColumn ** columns, size_t row_num, DB::Arena *) const override
+    {
+        const UInt64 weight = assert_cast<const DB::ColumnUInt64 &>(*columns[1]).getData()[row_num];
+        this->data(place).add(columns[0]->getFloat64(row_num), weight, spill_settings);
+    }
+
+    void merge(DB::AggregateDataPtr __restrict place, DB::ConstAggregateDataPtr rhs, DB::Arena *) const override
+    {
+        this->data(place).merge(this->data(rhs), spill_settings);
+    }
+
+    void serialize(DB::ConstAggregateDataPtr __restrict place, DB::WriteBuffer & buf, std::optional<size_t>) const override
+    {
+        this->data(place).serialize(buf, spill_settings);
+    }
+
+    void deserialize(DB::AggregateDataPtr __restrict place, DB::ReadBuffer & buf, std::optional<size_t>, DB::Arena *) const override
+    {
+        this->data(place).deserialize(buf, spill_settings);
+    }
+
+    void insertResultInto(DB::AggregateDataPtr __restrict place, DB::IColumn & to, DB::Arena *) const override
+    {
+        if constexpr (returns_many)
+        {
+            auto & array_to = assert_cast<DB::ColumnArray &>(to);
+            auto & data_to = assert_cast<DB::ColumnFloat64 &>(array_to.getData()).getData();
+            const size_t old_size = data_to.size();
+            data_to.resize(old_size + levels.size());
+            this->data(place).getPercentiles(levels, &data_to[old_size]);
+            array_to.getOffsets().push_back(data_to.size());
+        }
+        else
+        {
+            Float64 result;
+            this->data(place).getPercentiles(levels, &result);
+            assert_cast<DB::ColumnFloat64 &>(to).getData().push_back(result);
+        }
+    }
+
+private:
+    const std::vector<Float64> levels;
+    const PercentileSpillSettings spill_settings;
+};
+
+}
@@ -57,6 +57,7 @@
 #include <Storages/Cache/CacheManager.h>
 #include <Storages/MergeTree/StorageMergeTreeFactory.h>
 #include <Storages/Output/WriteBufferBuilder.h>
+#include <Storages/SubstraitSource/FileFooterCache.h>
 #include <Storages/SubstraitSource/ReadBufferBuilder.h>
 #include <boost/algorithm/string/case_conv.hpp>
 #include <sys/resource.h>
@@ -705,6 +706,8 @@ void BackendInitializerUtil::initSettings(const SparkConfigs::ConfigMap & spark_
     settings.set("input_format_orc_case_insensitive_column_matching", true);
     settings.set("input_format_orc_import_nested", true);
     settings.set("input_format_orc_skip_columns_with_unsupported_types_in_schema_inference", true);
+    /// Let the ORC reader skip the row groups of a stripe by its row index and bloom filters.
+    settings.set("input_format_orc_filter_push_down", true);
     settings.set("input_format_parquet_allow_missing_columns", true);
     settings.set("input_format_parquet_case_insensitive_column_matching", true);
     settings.set("input_format_parquet_import_nested", true);
@@ -827,6 +830,7 @@ void BackendInitializerUtil::applyGlobalConfigAndSettings(const DB::Context::Con
 extern void registerAggregateFunctionCombinatorPartialMerge(AggregateFunctionCombinatorFactory &);
 extern void registerAggregateFunctionsBloomFilter(AggregateFunctionFactory &);
 extern void registerAggregateFunctionSparkAvg(AggregateFunctionFactory &);
+extern void registerAggregateFunctionSparkPercentile(AggregateFunctionFactory &);
 extern void registerAggregateFunctionRowNumGroup(AggregateFunctionFactory &);
 extern void registerFunctions(FunctionFactory &);
 
@@ -838,6 +842,7 @@ void registerAllFunctions()
     auto & agg_factory = AggregateFunctionFactory::instance();
     registerAggregateFunctionsBloomFilter(agg_factory);
     registerAggregateFunctionSparkAvg(agg_factory);
+    registerAggregateFunctionSparkPercentile(agg_factory);
     registerAggregateFunctionRowNumGroup(agg_factory);
     {
         /// register aggregate function combinators from local_engine
@@ -909,6 +914,9 @@ void BackendInitializerUtil::initBackend(const SparkConfigs::ConfigMap & spark_c
     // Init the table metadata cache map
     StorageMergeTreeFactory::init_cache_map();
 
+    // Init the Parquet/ORC footer cache
+    FileFooterCache::initialize(QueryContext::globalContext());
+
     JobScheduler::initialize(QueryContext::globalContext());
     CacheManager::initialize(QueryContext::globalMutableContext());
 
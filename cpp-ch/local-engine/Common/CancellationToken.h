@@ -0,0 +1,52 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+
+namespace local_engine
+{
+/// Cancelled when the Spark task is cancelled. Native IO of the task checks it at chunk boundaries, so that the reads
+/// and background work of a killed task stop promptly instead of running to completion.
+class CancellationToken
+{
+public:
+    void cancel();
+    bool isCancelled() const { return cancelled.load(std::memory_order_acquire); }
+
+    /// Throws QUERY_WAS_CANCELLED if the token is cancelled.
+    void throwIfCancelled() const;
+
+    /// Waits for the future, waking up every CHECK_INTERVAL to throw if the token is cancelled meanwhile.
+    template <typename T>
+    decltype(auto) get(const std::shared_future<T> & future) const
+    {
+        while (future.wait_for(CHECK_INTERVAL) != std::future_status::ready)
+            throwIfCancelled();
+        return future.get();
+    }
+
+    static constexpr std::chrono::milliseconds CHECK_INTERVAL{10};
+
+private:
+    std::atomic<bool> cancelled{false};
+};
+using CancellationTokenPtr = std::shared_ptr<CancellationToken>;
+}
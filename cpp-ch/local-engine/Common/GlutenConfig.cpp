@@ -128,6 +128,7 @@ MergeTreeConfig MergeTreeConfig::loadFromContext(const DB::ContextPtr & context)
     MergeTreeConfig config;
     config.table_part_metadata_cache_max_count = context->getConfigRef().getUInt64(TABLE_PART_METADATA_CACHE_MAX_COUNT, 5000);
     config.table_metadata_cache_max_count = context->getConfigRef().getUInt64(TABLE_METADATA_CACHE_MAX_COUNT, 500);
+    config.auto_minmax_index = context->getConfigRef().getBool(AUTO_MINMAX_INDEX, true);
     return config;
 }
 GlutenJobSchedulerConfig GlutenJobSchedulerConfig::loadFromContext(const DB::ContextPtr & context)
@@ -136,6 +137,13 @@ GlutenJobSchedulerConfig GlutenJobSchedulerConfig::loadFromContext(const DB::Con
     config.job_scheduler_max_threads = context->getConfigRef().getUInt64(JOB_SCHEDULER_MAX_THREADS, 10);
     return config;
 }
+FileFooterCacheConfig FileFooterCacheConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    FileFooterCacheConfig config;
+    config.file_footer_cache_max_bytes
+        = context->getConfigRef().getUInt64(FILE_FOOTER_CACHE_MAX_BYTES, config.file_footer_cache_max_bytes);
+    return config;
+}
 MergeTreeCacheConfig MergeTreeCacheConfig::loadFromContext(const DB::ContextPtr & context)
 {
     MergeTreeCacheConfig config;
@@ -143,6 +151,26 @@ MergeTreeCacheConfig MergeTreeCacheConfig::loadFromContext(const DB::ContextPtr
     return config;
 }
 
+ScanConfig ScanConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    ScanConfig config;
+    config.enable_block_sample = context->getConfigRef().getBool(ENABLE_BLOCK_SAMPLE, config.enable_block_sample);
+    return config;
+}
+
+HedgedReadConfig HedgedReadConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    HedgedReadConfig config;
+    const auto & conf = context->getConfigRef();
+    config.enabled = conf.getBool(HEDGED_READ_ENABLED, config.enabled);
+    config.percentile = conf.getDouble(HEDGED_READ_PERCENTILE, config.percentile);
+    config.min_delay_ms = conf.getUInt64(HEDGED_READ_MIN_DELAY_MS, config.min_delay_ms);
+    config.min_samples = conf.getUInt64(HEDGED_READ_MIN_SAMPLES, config.min_samples);
+    config.budget_ratio = conf.getDouble(HEDGED_READ_BUDGET_RATIO, config.budget_ratio);
+    config.threads = conf.getUInt64(HEDGED_READ_THREADS, config.threads);
+    return config;
+}
+
 WindowConfig WindowConfig::loadFromContext(const DB::ContextPtr & context)
 {
     WindowConfig config;
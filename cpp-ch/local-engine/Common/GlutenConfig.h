@@ -135,9 +135,13 @@ struct MergeTreeConfig
 {
     inline static const String TABLE_PART_METADATA_CACHE_MAX_COUNT = "table_part_metadata_cache_max_count";
     inline static const String TABLE_METADATA_CACHE_MAX_COUNT = "table_metadata_cache_max_count";
+    inline static const String AUTO_MINMAX_INDEX = "mergetree.auto_minmax_index";
 
     size_t table_part_metadata_cache_max_count = 5000;
     size_t table_metadata_cache_max_count = 500;
+    /// Add a minmax skip index on every column with orderable scalar values, strings by their prefix, so parts
+    /// written with a trivial ORDER BY can still be pruned by granule.
+    bool auto_minmax_index = true;
 
     static MergeTreeConfig loadFromContext(const DB::ContextPtr & context);
 };
@@ -151,6 +155,16 @@ struct GlutenJobSchedulerConfig
     static GlutenJobSchedulerConfig loadFromContext(const DB::ContextPtr & context);
 };
 
+struct FileFooterCacheConfig
+{
+    inline static const String FILE_FOOTER_CACHE_MAX_BYTES = "file_footer_cache_max_bytes";
+
+    /// 0 disables the cache.
+    size_t file_footer_cache_max_bytes = 256_MiB;
+
+    static FileFooterCacheConfig loadFromContext(const DB::ContextPtr & context);
+};
+
 struct MergeTreeCacheConfig
 {
     inline static const String ENABLE_DATA_PREFETCH = "enable_data_prefetch";
@@ -160,6 +174,42 @@ struct MergeTreeCacheConfig
     static MergeTreeCacheConfig loadFromContext(const DB::ContextPtr & context);
 };
 
+struct ScanConfig
+{
+    inline static const String ENABLE_BLOCK_SAMPLE = "scan.enable_block_sample";
+
+    /// Whether the sample of a SampleExec right above a parquet scan chooses whole row groups instead of rows, so that
+    /// the row groups which are not chosen are never read.
+    bool enable_block_sample = false;
+
+    static ScanConfig loadFromContext(const DB::ContextPtr & context);
+};
+
+struct HedgedReadConfig
+{
+    inline static const String HEDGED_READ_ENABLED = "hedged_read.enabled";
+    inline static const String HEDGED_READ_PERCENTILE = "hedged_read.percentile";
+    inline static const String HEDGED_READ_MIN_DELAY_MS = "hedged_read.min_delay_ms";
+    inline static const String HEDGED_READ_MIN_SAMPLES = "hedged_read.min_samples";
+    inline static const String HEDGED_READ_BUDGET_RATIO = "hedged_read.budget_ratio";
+    inline static const String HEDGED_READ_THREADS = "hedged_read.threads";
+
+    /// Whether a range read of HDFS or S3 slower than the rolling latency percentile of its storage issues a duplicate
+    /// request, taking whichever response comes first.
+    bool enabled = false;
+    double percentile = 0.95;
+    /// Lower bound of the hedging delay, so that fast storages are not hedged on noise.
+    size_t min_delay_ms = 5;
+    /// Reads of a storage observed before its percentile is trusted.
+    size_t min_samples = 100;
+    /// At most this fraction of the reads of the process is hedged.
+    double budget_ratio = 0.05;
+    /// Threads of the pool the hedges wait and run in. A hedge issued while all of them are busy starts late.
+    size_t threads = 64;
+
+    static HedgedReadConfig loadFromContext(const DB::ContextPtr & context);
+};
+
 struct WindowConfig
 {
 public:
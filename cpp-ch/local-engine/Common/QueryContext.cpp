@@ -46,6 +46,7 @@ struct QueryContext::Data
     std::shared_ptr<ThreadGroup> thread_group;
     ContextMutablePtr query_context;
     String task_id;
+    CancellationTokenPtr cancellation_token = std::make_shared<CancellationToken>();
 
     static DB::ContextMutablePtr global_context;
     static SharedContextHolder shared_context;
@@ -137,6 +138,16 @@ String QueryContext::currentTaskIdOrEmpty()
     return "";
 }
 
+CancellationTokenPtr QueryContext::currentCancellationTokenOrNull()
+{
+    if (auto thread_group = CurrentThread::getGroup())
+    {
+        if (auto query = query_map_.get(reinterpret_cast<int64_t>(thread_group.get())))
+            return query->cancellation_token;
+    }
+    return nullptr;
+}
+
 void QueryContext::logCurrentPerformanceCounters(ProfileEvents::Counters & counters, const String & task_id) const
 {
     if (!CurrentThread::getGroup())
@@ -16,6 +16,7 @@
  */
 #pragma once
 #include <Interpreters/Context_fwd.h>
+#include <Common/CancellationToken.h>
 #include <Common/ConcurrentMap.h>
 #include <Common/ThreadStatus.h>
 
@@ -43,6 +44,8 @@ public:
     int64_t initializeQuery(const String & task_id);
     DB::ContextMutablePtr currentQueryContext();
     String currentTaskIdOrEmpty();
+    /// The cancellation token of the task the current thread works for, or null outside of a task.
+    CancellationTokenPtr currentCancellationTokenOrNull();
     static std::shared_ptr<DB::ThreadGroup> currentThreadGroup();
     void logCurrentPerformanceCounters(ProfileEvents::Counters & counters, const String & task_id) const;
     size_t currentPeakMemory(int64_t id);
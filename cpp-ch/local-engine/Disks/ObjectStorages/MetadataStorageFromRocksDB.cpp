@@ -59,6 +59,7 @@ MetadataStorageFromRocksDB::MetadataStorageFromRocksDB(
     rocksdb::Options options;
     options.create_if_missing = true;
     throwRockDBErrorNotOk(rocksdb::DB::Open(options, rocksdb_dir, &rocksdb));
+    migrateToHierarchicalKeys(*rocksdb);
     metadata_clean_task = QueryContext::globalContext()->getSchedulePool().createTask(
         "MetadataStorageFromRocksDB", [this] { cleanOutdatedMetadataThreadFunc(); });
     metadata_clean_task->scheduleAfter(metadata_clean_task_interval_seconds * 1000);
@@ -192,46 +193,41 @@ void MetadataStorageFromRocksDB::shutdown()
 void MetadataStorageFromRocksDB::cleanOutdatedMetadataThreadFunc()
 {
     LOG_INFO(logger, "start to clean disk metadata in rocksdb.");
-    std::queue<String> part_queue;
+    std::vector<String> outdated_parts;
     size_t total_count_remove = 0;
     auto removeParts = [&]
     {
-        while (!part_queue.empty())
-        {
-            auto meta_name = part_queue.front();
-            part_queue.pop();
-            std::filesystem::path meta_path(meta_name);
-            auto part_path = meta_path.parent_path();
-            auto files = listDirectory(part_path);
-            total_count_remove += (files.size() + 1);
-            getRocksDB().DeleteRange({}, part_path.generic_string(), files.back());
-            getRocksDB().Delete({}, files.back());
-        }
+        rocksdb::WriteBatchWithIndex batch(rocksdb::BytewiseComparator(), 0, true);
+        for (const auto & part_path : outdated_parts)
+            total_count_remove += removeRecursive(getRocksDB(), batch, part_path);
+        throwRockDBErrorNotOk(getRocksDB().Write({}, batch.GetWriteBatch()));
+        outdated_parts.clear();
     };
-    auto * it = getRocksDB().NewIterator({});
-    String prev_key;
-    String prev_data;
+    std::unique_ptr<rocksdb::Iterator> it(getRocksDB().NewIterator({}));
     for (it->SeekToFirst(); it->Valid(); it->Next())
     {
-        auto file_name = it->key().ToString();
+        if (!isMetadataKey(it->key()))
+            continue;
+        auto file_name = decodeMetadataKey(it->key());
         // mark outdated part
         if (isMergeTreePartMetaDataFile(file_name))
         {
-            auto objects = getStorageObjects(it->key().ToString());
+            auto objects = getStorageObjects(file_name);
             if (!object_storage->exists(objects.front()))
-                part_queue.push(file_name);
+                outdated_parts.push_back(std::filesystem::path(file_name).parent_path());
         }
         // clean empty directory
-        if (!prev_key.empty() && !file_name.starts_with(prev_key) && prev_data == RocksDBCreateDirectoryOperation::DIR_DATA)
+        else if (it->value() == RocksDBCreateDirectoryOperation::DIR_DATA && !hasChildren(getRocksDB(), file_name))
         {
-            getRocksDB().Delete({}, prev_key);
+            throwRockDBErrorNotOk(getRocksDB().Delete({}, it->key()));
             total_count_remove ++;
         }
-        if (part_queue.size() > 10000)
+        if (outdated_parts.size() > 10000)
         {
             removeParts();
         }
     }
+    throwRockDBErrorNotOk(it->status());
     removeParts();
     rocksdb::Slice begin(nullptr, 0);
     rocksdb::Slice end(nullptr, 0);
@@ -254,6 +250,7 @@ rocksdb::DB & MetadataStorageFromRocksDB::getRocksDB() const
 
 void MetadataStorageFromRocksDBTransaction::commit()
 {
+    addOperation(std::make_unique<RocksDBCommitBatchOperation>(metadata_storage.getRocksDB(), batch));
     commitImpl(metadata_storage.getMetadataMutex());
 }
 
@@ -280,37 +277,37 @@ void MetadataStorageFromRocksDBTransaction::createMetadataFile(const std::string
 
     auto data = metadata->serializeToString();
     if (!data.empty())
-        addOperation(std::make_unique<RocksDBWriteFileOperation>(path, metadata_storage.getRocksDB(), data));
+        addOperation(std::make_unique<RocksDBWriteFileOperation>(path, metadata_storage.getRocksDB(), batch, data));
 }
 
 void MetadataStorageFromRocksDBTransaction::writeStringToFile(const std::string & path, const std::string & data)
 {
-    addOperation(std::make_unique<RocksDBWriteFileOperation>(path, metadata_storage.getRocksDB(), data));
+    addOperation(std::make_unique<RocksDBWriteFileOperation>(path, metadata_storage.getRocksDB(), batch, data));
 }
 
 void MetadataStorageFromRocksDBTransaction::createDirectory(const std::string & path)
 {
-    addOperation(std::make_unique<RocksDBCreateDirectoryOperation>(path, metadata_storage.getRocksDB()));
+    addOperation(std::make_unique<RocksDBCreateDirectoryOperation>(path, metadata_storage.getRocksDB(), batch));
 }
 
 void MetadataStorageFromRocksDBTransaction::createDirectoryRecursive(const std::string & path)
 {
-    addOperation(std::make_unique<RocksDBCreateDirectoryRecursiveOperation>(path, metadata_storage.getRocksDB()));
+    addOperation(std::make_unique<RocksDBCreateDirectoryRecursiveOperation>(path, metadata_storage.getRocksDB(), batch));
 }
 
 void MetadataStorageFromRocksDBTransaction::removeDirectory(const std::string & path)
 {
-    addOperation(std::make_unique<RocksDBRemoveDirectoryOperation>(path, metadata_storage.getRocksDB()));
+    addOperation(std::make_unique<RocksDBRemoveDirectoryOperation>(path, metadata_storage.getRocksDB(), batch));
 }
 
 void MetadataStorageFromRocksDBTransaction::removeRecursive(const std::string & path)
 {
-    addOperation(std::make_unique<RocksDBRemoveRecursiveOperation>(path, metadata_storage.getRocksDB()));
+    addOperation(std::make_unique<RocksDBRemoveRecursiveOperation>(path, metadata_storage.getRocksDB(), batch));
 }
 
 void MetadataStorageFromRocksDBTransaction::unlinkFile(const std::string & path)
 {
-    addOperation(std::make_unique<RocksDBUnlinkFileOperation>(path, metadata_storage.getRocksDB()));
+    addOperation(std::make_unique<RocksDBUnlinkFileOperation>(path, metadata_storage.getRocksDB(), batch));
 }
 }
 #endif
\ No newline at end of file
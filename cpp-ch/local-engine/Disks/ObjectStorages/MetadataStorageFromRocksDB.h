@@ -22,6 +22,7 @@
 #include <Disks/ObjectStorages/IMetadataStorage.h>
 #include <Disks/ObjectStorages/MetadataOperationsHolder.h>
 #include <rocksdb/db.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
 #include <shared_mutex>
 
 namespace local_engine
@@ -73,10 +74,14 @@ private:
     LoggerPtr logger;
 };
 
+/// Stages the writes of all of its operations in one rocksdb::WriteBatch, which is written at once on commit.
 class MetadataStorageFromRocksDBTransaction final : public DB::IMetadataTransaction, private DB::MetadataOperationsHolder
 {
 public:
-    MetadataStorageFromRocksDBTransaction(const MetadataStorageFromRocksDB & metadata_storage_) : metadata_storage(metadata_storage_) { }
+    MetadataStorageFromRocksDBTransaction(const MetadataStorageFromRocksDB & metadata_storage_)
+        : metadata_storage(metadata_storage_), batch(rocksdb::BytewiseComparator(), 0, true)
+    {
+    }
 
     void commit() override;
     const DB::IMetadataStorage & getStorageForNonTransactionalReads() const override;
@@ -93,6 +98,8 @@ public:
 
 private:
     const MetadataStorageFromRocksDB & metadata_storage;
+    /// Indexed, so that later operations see the writes of earlier ones.
+    rocksdb::WriteBatchWithIndex batch;
 };
 }
 #endif
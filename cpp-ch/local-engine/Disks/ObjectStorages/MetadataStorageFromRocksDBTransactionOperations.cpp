@@ -18,19 +18,96 @@
 #if USE_ROCKSDB
 #include "MetadataStorageFromRocksDBTransactionOperations.h"
 
+#include <filesystem>
+#include <limits>
 #include <ranges>
+#include <Common/logger_useful.h>
 
 namespace DB
 {
 namespace ErrorCodes
 {
 extern const int INVALID_STATE;
+extern const int BAD_ARGUMENTS;
 }
 }
 
 namespace local_engine
 {
 
+namespace
+{
+const String FORMAT_VERSION_KEY{"\0\0format_version", 16};
+const String HIERARCHICAL_KEYS_VERSION = "1";
+/// The number of keys rewritten in one batch of the migration.
+constexpr size_t MIGRATION_BATCH_KEYS = 10000;
+
+std::string_view normalizePath(std::string_view path)
+{
+    while (path.ends_with('/'))
+        path.remove_suffix(1);
+    return path;
+}
+
+size_t depthOf(std::string_view normalized_path)
+{
+    return normalized_path.empty() ? 0 : static_cast<size_t>(std::ranges::count(normalized_path, '/')) + 1;
+}
+
+String makeKey(size_t depth, std::string_view normalized_path)
+{
+    if (depth > std::numeric_limits<UInt8>::max())
+        throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "Path {} is too deep to be stored in rocksdb", normalized_path);
+    String key;
+    key.reserve(normalized_path.size() + 2);
+    key.push_back('\0');
+    key.push_back(static_cast<char>(depth));
+    key.append(normalized_path);
+    return key;
+}
+
+/// The prefix of the keys of the direct children of path.
+String childrenKeyPrefix(const std::string & path)
+{
+    const auto normalized_path = normalizePath(path);
+    String prefix = makeKey(depthOf(normalized_path) + 1, normalized_path);
+    if (!normalized_path.empty())
+        prefix.push_back('/');
+    return prefix;
+}
+
+template <typename Callback>
+void forEachChild(rocksdb::Iterator & it, const std::string & path, Callback && callback)
+{
+    const auto prefix = childrenKeyPrefix(path);
+    for (it.Seek(prefix); it.Valid() && it.key().starts_with(prefix); it.Next())
+        if (!callback(it.key()))
+            break;
+    throwRockDBErrorNotOk(it.status());
+}
+
+std::unique_ptr<rocksdb::Iterator> newIterator(rocksdb::DB & db, rocksdb::WriteBatchWithIndex & batch)
+{
+    return std::unique_ptr<rocksdb::Iterator>(batch.NewIteratorWithBase(db.NewIterator({})));
+}
+}
+
+String encodeMetadataKey(const std::string & path)
+{
+    const auto normalized_path = normalizePath(path);
+    return makeKey(depthOf(normalized_path), normalized_path);
+}
+
+String decodeMetadataKey(const rocksdb::Slice & key)
+{
+    return key.ToString().substr(2);
+}
+
+bool isMetadataKey(const rocksdb::Slice & key)
+{
+    return key.size() > 2 && key[0] == '\0' && key[1] != '\0';
+}
+
 void throwRockDBErrorNotOk(const rocksdb::Status & status)
 {
     if (!status.ok())
@@ -45,7 +122,7 @@ bool exist(rocksdb::DB & db, const std::string & path)
 
 bool tryGetData(rocksdb::DB & db, const std::string & path, std::string * value)
 {
-    auto status = db.Get({}, path, value);
+    auto status = db.Get({}, encodeMetadataKey(path), value);
     if (status.IsNotFound())
         return false;
     throwRockDBErrorNotOk(status);
@@ -55,129 +132,174 @@ bool tryGetData(rocksdb::DB & db, const std::string & path, std::string * value)
 String getData(rocksdb::DB & db, const std::string & path)
 {
     std::string data;
-    throwRockDBErrorNotOk(db.Get({}, path, &data));
+    throwRockDBErrorNotOk(db.Get({}, encodeMetadataKey(path), &data));
     return data;
 }
 
 std::vector<String> listKeys(rocksdb::DB & db, const std::string & path)
 {
     std::vector<String> result;
-    auto *it = db.NewIterator({});
-    for (it->Seek(path); it->Valid() && it->key().starts_with(path); it->Next())
-    {
-        if (it->key() == path)
-            continue;
-        result.push_back(it->key().ToString());
-    }
+    std::unique_ptr<rocksdb::Iterator> it(db.NewIterator({}));
+    forEachChild(
+        *it,
+        path,
+        [&](const rocksdb::Slice & key)
+        {
+            result.push_back(decodeMetadataKey(key));
+            return true;
+        });
     return result;
 }
 
-void RocksDBWriteFileOperation::execute(std::unique_lock<DB::SharedMutex> &)
+bool hasChildren(rocksdb::DB & db, const std::string & path)
+{
+    bool has_children = false;
+    std::unique_ptr<rocksdb::Iterator> it(db.NewIterator({}));
+    forEachChild(
+        *it,
+        path,
+        [&](const rocksdb::Slice &)
+        {
+            has_children = true;
+            return false;
+        });
+    return has_children;
+}
+
+bool tryGetData(rocksdb::DB & db, rocksdb::WriteBatchWithIndex & batch, const std::string & path, std::string * value)
 {
-    auto status = db.Get({}, path, &prev_data);
+    auto status = batch.GetFromBatchAndDB(&db, {}, encodeMetadataKey(path), value);
     if (status.IsNotFound())
-        existed = false;
-    else
-        throwRockDBErrorNotOk(status);
-    db.Put({}, path, data);
+        return false;
+    throwRockDBErrorNotOk(status);
+    return status.ok();
 }
 
-void RocksDBWriteFileOperation::undo(std::unique_lock<DB::SharedMutex> &)
+std::vector<String> listKeys(rocksdb::DB & db, rocksdb::WriteBatchWithIndex & batch, const std::string & path)
 {
-    if (existed)
-        throwRockDBErrorNotOk(db.Put({}, path, prev_data));
-    else
-        throwRockDBErrorNotOk(db.Delete({}, path));
+    std::vector<String> result;
+    auto it = newIterator(db, batch);
+    forEachChild(
+        *it,
+        path,
+        [&](const rocksdb::Slice & key)
+        {
+            result.push_back(decodeMetadataKey(key));
+            return true;
+        });
+    return result;
 }
 
-void RocksDBCreateDirectoryOperation::execute(std::unique_lock<DB::SharedMutex> &)
+size_t removeRecursive(rocksdb::DB & db, rocksdb::WriteBatchWithIndex & batch, const std::string & path)
 {
-    existed = exist(db, path);
-    if (existed)
+    size_t removed = 0;
+    for (const auto & child : listKeys(db, batch, path))
+        removed += removeRecursive(db, batch, child);
+    std::string data;
+    if (tryGetData(db, batch, path, &data))
+    {
+        throwRockDBErrorNotOk(batch.Delete(encodeMetadataKey(path)));
+        ++removed;
+    }
+    return removed;
+}
+
+void migrateToHierarchicalKeys(rocksdb::DB & db)
+{
+    std::string version;
+    auto status = db.Get({}, FORMAT_VERSION_KEY, &version);
+    if (status.ok() && version == HIERARCHICAL_KEYS_VERSION)
         return;
-    throwRockDBErrorNotOk(db.Put({}, path, DIR_DATA));
+    if (!status.IsNotFound())
+        throwRockDBErrorNotOk(status);
+
+    /// Keys written before are plain paths, which never start with '\0' and so sort after all hierarchical keys.
+    size_t migrated = 0;
+    rocksdb::WriteBatch batch;
+    std::unique_ptr<rocksdb::Iterator> it(db.NewIterator({}));
+    for (it->Seek(rocksdb::Slice("\1", 1)); it->Valid(); it->Next())
+    {
+        if (auto key = encodeMetadataKey(it->key().ToString()); isMetadataKey(key))
+            throwRockDBErrorNotOk(batch.Put(key, it->value()));
+        throwRockDBErrorNotOk(batch.Delete(it->key()));
+        if (++migrated % MIGRATION_BATCH_KEYS == 0)
+        {
+            throwRockDBErrorNotOk(db.Write({}, &batch));
+            batch.Clear();
+        }
+    }
+    throwRockDBErrorNotOk(it->status());
+    throwRockDBErrorNotOk(batch.Put(FORMAT_VERSION_KEY, HIERARCHICAL_KEYS_VERSION));
+    throwRockDBErrorNotOk(db.Write({}, &batch));
+    if (migrated)
+        LOG_INFO(getLogger("MetadataStorageFromRocksDB"), "Migrated {} keys to hierarchical keys", migrated);
 }
 
-void RocksDBCreateDirectoryOperation::undo(std::unique_lock<DB::SharedMutex> &)
+void RocksDBWriteFileOperation::execute(std::unique_lock<DB::SharedMutex> &)
 {
-    if (existed) return;
-    throwRockDBErrorNotOk(db.Delete({}, path));
+    throwRockDBErrorNotOk(batch.Put(encodeMetadataKey(path), data));
 }
 
-void RocksDBCreateDirectoryRecursiveOperation::execute(std::unique_lock<DB::SharedMutex> & )
+void RocksDBCreateDirectoryOperation::execute(std::unique_lock<DB::SharedMutex> &)
+{
+    std::string data;
+    if (tryGetData(db, batch, path, &data))
+        return;
+    throwRockDBErrorNotOk(batch.Put(encodeMetadataKey(path), DIR_DATA));
+}
+
+void RocksDBCreateDirectoryRecursiveOperation::execute(std::unique_lock<DB::SharedMutex> &)
 {
     namespace fs = std::filesystem;
-    fs::path p(path);
-    while (!exist(db, p.string()))
+    std::vector<std::string> paths_to_create;
+    std::string data;
+    fs::path p(normalizePath(path));
+    while (!p.empty() && !tryGetData(db, batch, p.string(), &data))
     {
-        paths_created.push_back(p);
+        paths_to_create.push_back(p);
         if (!p.has_parent_path())
             break;
         p = p.parent_path();
     }
-    for (const auto & path_to_create : paths_created | std::views::reverse)
-        throwRockDBErrorNotOk(db.Put({}, path_to_create, RocksDBCreateDirectoryOperation::DIR_DATA));
-}
-
-void RocksDBCreateDirectoryRecursiveOperation::undo(std::unique_lock<DB::SharedMutex> & )
-{
-    for (const auto & path_created : paths_created)
-        throwRockDBErrorNotOk(db.Delete({}, path_created));
+    for (const auto & path_to_create : paths_to_create | std::views::reverse)
+        throwRockDBErrorNotOk(batch.Put(encodeMetadataKey(path_to_create), RocksDBCreateDirectoryOperation::DIR_DATA));
 }
 
 void RocksDBRemoveDirectoryOperation::execute(std::unique_lock<DB::SharedMutex> &)
 {
-    auto *it = db.NewIterator({});
     bool empty_dir = true;
-    for (it->Seek(path); it->Valid() && it->key().starts_with(path); it->Next())
-    {
-        if (it->key() != path && it->key().starts_with(path))
+    auto it = newIterator(db, batch);
+    forEachChild(
+        *it,
+        path,
+        [&](const rocksdb::Slice &)
         {
             empty_dir = false;
-            break;
-        }
-        if (it->key() == path)
-            existed = true;
-    }
+            return false;
+        });
     if (!empty_dir)
-    {
         throw DB::Exception(DB::ErrorCodes::INVALID_STATE, "Directory {} is not empty", path);
-    }
-    if (existed)
-        throwRockDBErrorNotOk(db.Delete({}, path));
-}
-
-void RocksDBRemoveDirectoryOperation::undo(std::unique_lock<DB::SharedMutex> &)
-{
-    if (existed)
-        throwRockDBErrorNotOk(db.Put({}, path, RocksDBCreateDirectoryOperation::DIR_DATA));
+    std::string data;
+    if (tryGetData(db, batch, path, &data))
+        throwRockDBErrorNotOk(batch.Delete(encodeMetadataKey(path)));
 }
 
 void RocksDBRemoveRecursiveOperation::execute(std::unique_lock<DB::SharedMutex> &)
 {
-    auto *it = db.NewIterator({});
-    for (it->Seek(path); it->Valid() && it->key().starts_with(path); it->Next())
-    {
-        files.emplace(it->key().ToString(), it->value().ToString());
-        throwRockDBErrorNotOk(db.Delete({}, it->key()));
-    }
-}
-
-void RocksDBRemoveRecursiveOperation::undo(std::unique_lock<DB::SharedMutex> &)
-{
-    for (const auto & [key, value] : files)
-        throwRockDBErrorNotOk(db.Put({}, key, value));
+    removeRecursive(db, batch, path);
 }
 
 void RocksDBUnlinkFileOperation::execute(std::unique_lock<DB::SharedMutex> &)
 {
-    prev_data = getData(db, path);
-    throwRockDBErrorNotOk(db.Delete({}, path));
+    std::string data;
+    if (!tryGetData(db, batch, path, &data))
+        throwRockDBErrorNotOk(rocksdb::Status::NotFound(path));
+    throwRockDBErrorNotOk(batch.Delete(encodeMetadataKey(path)));
 }
 
-void RocksDBUnlinkFileOperation::undo(std::unique_lock<DB::SharedMutex> &)
+void RocksDBCommitBatchOperation::execute(std::unique_lock<DB::SharedMutex> &)
 {
-    throwRockDBErrorNotOk(db.Put({}, path, prev_data));
+    throwRockDBErrorNotOk(db.Write({}, batch.GetWriteBatch()));
 }
 }
-#endif
\ No newline at end of file
+#endif
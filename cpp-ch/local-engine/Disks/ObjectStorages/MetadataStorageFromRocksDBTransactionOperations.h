@@ -20,117 +20,117 @@
 #include <Disks/ObjectStorages/IMetadataOperation.h>
 #include <Disks/ObjectStorages/IMetadataStorage.h>
 #include <rocksdb/db.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
 
 namespace local_engine
 {
+/// Paths are stored under hierarchical keys: '\0', the depth of the path and the path without trailing slashes. The
+/// direct children of a directory are then one contiguous key range, so a directory is listed by a scan bounded by its
+/// children rather than by all of its descendants. Keys of depth 0 are reserved for the metadata of the store itself.
+String encodeMetadataKey(const std::string & path);
+String decodeMetadataKey(const rocksdb::Slice & key);
+/// Whether key is the key of a path rather than of the metadata of the store.
+bool isMetadataKey(const rocksdb::Slice & key);
+
 void throwRockDBErrorNotOk(const rocksdb::Status & status);
 bool exist(rocksdb::DB & db, const std::string & path);
 bool tryGetData(rocksdb::DB & db, const std::string & path, std::string* value);
 String getData(rocksdb::DB & db, const std::string & path);
+/// Returns the paths of the direct children of path.
 std::vector<String> listKeys(rocksdb::DB & db, const std::string & path);
-
-struct RocksDBWriteFileOperation final : public DB::IMetadataOperation
+bool hasChildren(rocksdb::DB & db, const std::string & path);
+
+/// The same as above, but also seeing the uncommitted writes of batch.
+bool tryGetData(rocksdb::DB & db, rocksdb::WriteBatchWithIndex & batch, const std::string & path, std::string * value);
+std::vector<String> listKeys(rocksdb::DB & db, rocksdb::WriteBatchWithIndex & batch, const std::string & path);
+/// Removes path and all of its descendants in batch, and returns the number of removed keys.
+size_t removeRecursive(rocksdb::DB & db, rocksdb::WriteBatchWithIndex & batch, const std::string & path);
+
+/// Rewrites the keys of a store written before hierarchical keys, and does nothing if the store is already migrated.
+/// Every rewritten batch is atomic, so an interrupted migration is resumed the next time the store is opened.
+void migrateToHierarchicalKeys(rocksdb::DB & db);
+
+/// The operations of a transaction only stage their writes in the batch of the transaction, which
+/// RocksDBCommitBatchOperation writes at once as the last operation. So a transaction is atomic, and there is nothing
+/// to undo if one of its operations fails.
+struct RocksDBBatchOperation : public DB::IMetadataOperation
 {
-    RocksDBWriteFileOperation(const std::string& path_, rocksdb::DB& db_, const std::string& data_) : path(path_),
-        db(db_), data(data_)
+    RocksDBBatchOperation(const std::string & path_, rocksdb::DB & db_, rocksdb::WriteBatchWithIndex & batch_)
+        : path(path_), db(db_), batch(batch_)
     {
     }
 
-    void execute(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
+    void undo(std::unique_lock<DB::SharedMutex> &) override { }
 
-    void undo(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
-
-private:
+protected:
     std::string path;
     rocksdb::DB & db;
-    std::string data;
-    bool existed = false;
-    std::string prev_data;
+    rocksdb::WriteBatchWithIndex & batch;
 };
 
-struct RocksDBCreateDirectoryOperation final : public DB::IMetadataOperation
+struct RocksDBWriteFileOperation final : public RocksDBBatchOperation
 {
-    RocksDBCreateDirectoryOperation(const std::string & path_, rocksdb::DB & db_) : path(path_), db(db_)
+    RocksDBWriteFileOperation(
+        const std::string & path_, rocksdb::DB & db_, rocksdb::WriteBatchWithIndex & batch_, const std::string & data_)
+        : RocksDBBatchOperation(path_, db_, batch_), data(data_)
     {
     }
 
     void execute(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
 
-    void undo(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
-
-    const static inline String DIR_DATA = "__DIR__";
 private:
-    std::string path;
-    bool existed = false;
-    rocksdb::DB & db;
-
+    std::string data;
 };
 
-struct RocksDBCreateDirectoryRecursiveOperation final : public DB::IMetadataOperation
+struct RocksDBCreateDirectoryOperation final : public RocksDBBatchOperation
 {
-    RocksDBCreateDirectoryRecursiveOperation(const std::string & path_, rocksdb::DB & db_) : path(path_), db(db_)
-    {
-    };
+    using RocksDBBatchOperation::RocksDBBatchOperation;
 
     void execute(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
 
-    void undo(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
-
-private:
-    std::string path;
-    std::vector<std::string> paths_created;
-    rocksdb::DB & db;
+    const static inline String DIR_DATA = "__DIR__";
 };
 
-struct RocksDBRemoveDirectoryOperation final : public DB::IMetadataOperation
+struct RocksDBCreateDirectoryRecursiveOperation final : public RocksDBBatchOperation
 {
-    RocksDBRemoveDirectoryOperation(const std::string & path_, rocksdb::DB & db_): path(path_), db(db_)
-    {
-    }
+    using RocksDBBatchOperation::RocksDBBatchOperation;
 
     void execute(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
+};
 
-    void undo(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
+struct RocksDBRemoveDirectoryOperation final : public RocksDBBatchOperation
+{
+    using RocksDBBatchOperation::RocksDBBatchOperation;
 
-private:
-    std::string path;
-    bool existed = false;
-    rocksdb::DB & db;
+    void execute(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
 };
 
-struct RocksDBRemoveRecursiveOperation final : public DB::IMetadataOperation
+struct RocksDBRemoveRecursiveOperation final : public RocksDBBatchOperation
 {
-    RocksDBRemoveRecursiveOperation(const std::string & path_, rocksdb::DB & db_) : path(path_), db(db_)
-    {
-    }
+    using RocksDBBatchOperation::RocksDBBatchOperation;
 
     void execute(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
+};
 
-    void undo(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
+struct RocksDBUnlinkFileOperation final : public RocksDBBatchOperation
+{
+    using RocksDBBatchOperation::RocksDBBatchOperation;
 
-private:
-    std::string path;
-    rocksdb::DB & db;
-    std::unordered_map<String, String> files;
+    void execute(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
 };
 
-struct RocksDBUnlinkFileOperation final : public DB::IMetadataOperation
+struct RocksDBCommitBatchOperation final : public DB::IMetadataOperation
 {
-    RocksDBUnlinkFileOperation(const std::string & path_, rocksdb::DB & db_) : path(path_), db(db_)
-    {
-    }
+    RocksDBCommitBatchOperation(rocksdb::DB & db_, rocksdb::WriteBatchWithIndex & batch_) : db(db_), batch(batch_) { }
 
     void execute(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
 
-    void undo(std::unique_lock<DB::SharedMutex> & metadata_lock) override;
+    void undo(std::unique_lock<DB::SharedMutex> &) override { }
 
 private:
-    std::string path;
     rocksdb::DB & db;
-    std::string prev_data;
+    rocksdb::WriteBatchWithIndex & batch;
 };
 
-
 }
 #endif
-
@@ -0,0 +1,324 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "SparkFunctionBucketId.h"
+
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnFixedString.h>
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeDateTime64.h>
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypesDecimal.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <Functions/FunctionHelpers.h>
+#include <Functions/IFunction.h>
+#include <core/utils/SparkHash.h>
+#include <Common/assert_cast.h>
+#include <Common/intExp.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+    extern const int BAD_ARGUMENTS;
+    extern const int NOT_IMPLEMENTED;
+    extern const int NUMBER_OF_ARGUMENTS_DOESNT_MATCH;
+}
+}
+
+namespace local_engine
+{
+namespace sparkhash = gluten::sparkhash;
+
+namespace
+{
+using Hashes = SparkBucketHasher::Hashes;
+
+__int128 toInt128(const DB::Int128 & value)
+{
+    return static_cast<__int128>((static_cast<unsigned __int128>(value.items[1]) << 64) | value.items[0]);
+}
+
+/// Spark's Murmur3Hash passes the hash of the previous columns as the seed, and skips null values.
+struct Murmur3Fold
+{
+    static Int32 null(Int32 hash) { return hash; }
+    static Int32 int32(Int32 value, Int32 hash) { return sparkhash::murmur3::hashInt(value, hash); }
+    static Int32 int64(Int64 value, Int32 hash) { return sparkhash::murmur3::hashLong(value, hash); }
+    static Int32 float32(Float32 value, Int32 hash) { return sparkhash::murmur3::hashFloat(value, hash); }
+    static Int32 float64(Float64 value, Int32 hash) { return sparkhash::murmur3::hashDouble(value, hash); }
+    static Int32 timestamp(Int64 micros, Int32 hash) { return sparkhash::murmur3::hashLong(micros, hash); }
+    static Int32 bytes(const char * data, size_t size, Int32 hash) { return sparkhash::murmur3::hashBytes(data, size, hash); }
+
+    static Int32 decimal(__int128 unscaled, UInt32 precision, UInt32 /*scale*/, Int32 hash)
+    {
+        return sparkhash::murmur3::hashDecimal(unscaled, precision, hash);
+    }
+};
+
+/// Spark's HiveHash computes 31 * hash + value_hash, where the hash of null is 0.
+struct HiveFold
+{
+    static Int32 null(Int32 hash) { return sparkhash::hive::combine(hash, 0); }
+    static Int32 int32(Int32 value, Int32 hash) { return sparkhash::hive::combine(hash, sparkhash::hive::hashInt(value)); }
+    static Int32 int64(Int64 value, Int32 hash) { return sparkhash::hive::combine(hash, sparkhash::hive::hashLong(value)); }
+    static Int32 float32(Float32 value, Int32 hash) { return sparkhash::hive::combine(hash, sparkhash::hive::hashFloat(value)); }
+    static Int32 float64(Float64 value, Int32 hash) { return sparkhash::hive::combine(hash, sparkhash::hive::hashDouble(value)); }
+    static Int32 timestamp(Int64 micros, Int32 hash) { return sparkhash::hive::combine(hash, sparkhash::hive::hashTimestamp(micros)); }
+
+    static Int32 bytes(const char * data, size_t size, Int32 hash)
+    {
+        return sparkhash::hive::combine(hash, sparkhash::hive::hashBytes(data, size));
+    }
+
+    static Int32 decimal(__int128 unscaled, UInt32 /*precision*/, UInt32 scale, Int32 hash)
+    {
+        return sparkhash::hive::combine(hash, sparkhash::hive::hashDecimal(unscaled, scale));
+    }
+};
+
+template <typename Fold, typename HashRow>
+void foldRows(const DB::NullMap * null_map, Hashes & hashes, HashRow && hash_row)
+{
+    if (!null_map)
+    {
+        for (size_t i = 0; i < hashes.size(); ++i)
+            hashes[i] = hash_row(i, hashes[i]);
+    }
+    else
+    {
+        for (size_t i = 0; i < hashes.size(); ++i)
+            hashes[i] = (*null_map)[i] ? Fold::null(hashes[i]) : hash_row(i, hashes[i]);
+    }
+}
+
+template <typename Fold, typename T, typename HashValue>
+void foldValues(const DB::IColumn & data, const DB::NullMap * null_map, Hashes & hashes, HashValue && hash_value)
+{
+    const auto & values = assert_cast<const DB::ColumnVectorOrDecimal<T> &>(data).getData();
+    foldRows<Fold>(null_map, hashes, [&](size_t row, Int32 hash) { return hash_value(values[row], hash); });
+}
+
+template <typename Fold, typename T>
+void foldDecimals(const DB::IColumn & data, const DB::IDataType & type, const DB::NullMap * null_map, Hashes & hashes)
+{
+    const UInt32 precision = DB::getDecimalPrecision(type);
+    const UInt32 scale = DB::getDecimalScale(type);
+    foldValues<Fold, T>(
+        data,
+        null_map,
+        hashes,
+        [&](const T & value, Int32 hash)
+        {
+            if constexpr (std::is_same_v<T, DB::Decimal128>)
+                return Fold::decimal(toInt128(value.value), precision, scale, hash);
+            else
+                return Fold::decimal(value.value, precision, scale, hash);
+        });
+}
+
+template <typename Fold>
+void foldColumn(const DB::ColumnWithTypeAndName & column, Hashes & hashes)
+{
+    auto full_column = column.column->convertToFullIfNeeded();
+    const DB::IColumn * data = full_column.get();
+    const DB::NullMap * null_map = nullptr;
+    if (const auto * nullable = DB::checkAndGetColumn<DB::ColumnNullable>(data))
+    {
+        null_map = &nullable->getNullMapData();
+        data = &nullable->getNestedColumn();
+    }
+
+    auto type = DB::removeLowCardinalityAndNullable(column.type);
+    DB::WhichDataType which(type);
+    if (which.isNothing())
+    {
+        for (auto & hash : hashes)
+            hash = Fold::null(hash);
+    }
+    else if (which.isUInt8())
+        foldValues<Fold, UInt8>(*data, null_map, hashes, [](UInt8 value, Int32 hash) { return Fold::int32(value, hash); });
+    else if (which.isInt8())
+        foldValues<Fold, Int8>(*data, null_map, hashes, [](Int8 value, Int32 hash) { return Fold::int32(value, hash); });
+    else if (which.isInt16())
+        foldValues<Fold, Int16>(*data, null_map, hashes, [](Int16 value, Int32 hash) { return Fold::int32(value, hash); });
+    else if (which.isInt32() || which.isDate32())
+        foldValues<Fold, Int32>(*data, null_map, hashes, [](Int32 value, Int32 hash) { return Fold::int32(value, hash); });
+    else if (which.isDate())
+        foldValues<Fold, UInt16>(*data, null_map, hashes, [](UInt16 value, Int32 hash) { return Fold::int32(value, hash); });
+    else if (which.isInt64())
+        foldValues<Fold, Int64>(*data, null_map, hashes, [](Int64 value, Int32 hash) { return Fold::int64(value, hash); });
+    else if (which.isFloat32())
+        foldValues<Fold, Float32>(*data, null_map, hashes, [](Float32 value, Int32 hash) { return Fold::float32(value, hash); });
+    else if (which.isFloat64())
+        foldValues<Fold, Float64>(*data, null_map, hashes, [](Float64 value, Int32 hash) { return Fold::float64(value, hash); });
+    else if (which.isDateTime64())
+    {
+        /// Spark's timestamps are microseconds, i.e. DateTime64(6).
+        const auto scale = assert_cast<const DB::DataTypeDateTime64 &>(*type).getScale();
+        const Int64 multiplier = scale < 6 ? common::exp10_i64(6 - scale) : 1;
+        const Int64 divisor = scale > 6 ? common::exp10_i64(scale - 6) : 1;
+        foldValues<Fold, DB::DateTime64>(
+            *data,
+            null_map,
+            hashes,
+            [&](const DB::DateTime64 & value, Int32 hash) { return Fold::timestamp(value.value * multiplier / divisor, hash); });
+    }
+    else if (which.isDecimal32())
+        foldDecimals<Fold, DB::Decimal32>(*data, *type, null_map, hashes);
+    else if (which.isDecimal64())
+        foldDecimals<Fold, DB::Decimal64>(*data, *type, null_map, hashes);
+    else if (which.isDecimal128())
+        foldDecimals<Fold, DB::Decimal128>(*data, *type, null_map, hashes);
+    else if (which.isString())
+    {
+        const auto & strings = assert_cast<const DB::ColumnString &>(*data);
+        foldRows<Fold>(
+            null_map,
+            hashes,
+            [&](size_t row, Int32 hash)
+            {
+                auto value = strings.getDataAt(row);
+                return Fold::bytes(value.data, value.size, hash);
+            });
+    }
+    else if (which.isFixedString())
+    {
+        const auto & strings = assert_cast<const DB::ColumnFixedString &>(*data);
+        const size_t n = strings.getN();
+        const auto * chars = reinterpret_cast<const char *>(strings.getChars().data());
+        foldRows<Fold>(null_map, hashes, [&](size_t row, Int32 hash) { return Fold::bytes(chars + row * n, n, hash); });
+    }
+    else
+        throw DB::Exception(DB::ErrorCodes::NOT_IMPLEMENTED, "Bucket columns of type {} are not supported", column.type->getName());
+}
+}
+
+bool SparkBucketHasher::isSupported(const DB::DataTypePtr & type)
+{
+    DB::WhichDataType which(DB::removeLowCardinalityAndNullable(type));
+    return which.isNothing() || which.isUInt8() || which.isInt8() || which.isInt16() || which.isInt32() || which.isDate32()
+        || which.isDate() || which.isInt64() || which.isFloat32() || which.isFloat64() || which.isDateTime64() || which.isDecimal32()
+        || which.isDecimal64() || which.isDecimal128() || which.isString() || which.isFixedString();
+}
+
+void SparkBucketHasher::murmur3(const DB::ColumnWithTypeAndName & column, Hashes & hashes)
+{
+    foldColumn<Murmur3Fold>(column, hashes);
+}
+
+void SparkBucketHasher::hive(const DB::ColumnWithTypeAndName & column, Hashes & hashes)
+{
+    foldColumn<HiveFold>(column, hashes);
+}
+
+DB::ColumnPtr SparkBucketHasher::bucketIds(const DB::ColumnsWithTypeAndName & columns, Int32 num_buckets, bool hive_compatible)
+{
+    if (num_buckets <= 0)
+        throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "The number of buckets must be positive, but got {}", num_buckets);
+
+    const size_t rows = columns.empty() ? 0 : columns.front().column->size();
+    auto result = DB::ColumnInt32::create(rows, hive_compatible ? 0 : sparkhash::murmur3::kSeed);
+    auto & hashes = result->getData();
+    if (hive_compatible)
+    {
+        for (const auto & column : columns)
+            hive(column, hashes);
+        for (auto & hash : hashes)
+            hash = sparkhash::hiveBucketId(hash, num_buckets);
+    }
+    else
+    {
+        for (const auto & column : columns)
+            murmur3(column, hashes);
+        for (auto & hash : hashes)
+            hash = sparkhash::bucketId(hash, num_buckets);
+    }
+    return result;
+}
+
+/// sparkHiveHash(cols...), Spark's hive_hash.
+class FunctionSparkHiveHash : public DB::IFunction
+{
+public:
+    static constexpr auto name = "sparkHiveHash";
+    static DB::FunctionPtr create(DB::ContextPtr) { return std::make_shared<FunctionSparkHiveHash>(); }
+
+    String getName() const override { return name; }
+    bool isVariadic() const override { return true; }
+    size_t getNumberOfArguments() const override { return 0; }
+    bool useDefaultImplementationForNulls() const override { return false; }
+    bool useDefaultImplementationForConstants() const override { return true; }
+    bool isSuitableForShortCircuitArgumentsExecution(const DB::DataTypesWithConstInfo & /*arguments*/) const override { return true; }
+
+    DB::DataTypePtr getReturnTypeImpl(const DB::DataTypes & /*arguments*/) const override { return std::make_shared<DB::DataTypeInt32>(); }
+
+    DB::ColumnPtr executeImpl(const DB::ColumnsWithTypeAndName & arguments, const DB::DataTypePtr &, size_t input_rows_count) const override
+    {
+        auto result = DB::ColumnInt32::create(input_rows_count, 0);
+        for (const auto & argument : arguments)
+            SparkBucketHasher::hive(argument, result->getData());
+        return result;
+    }
+};
+
+/// sparkBucketId(num_buckets, hive_compatible, cols...), the bucket id of a bucketed write computed in one pass over
+/// the bucket columns, see SparkBucketHasher.
+class FunctionSparkBucketId : public DB::IFunction
+{
+public:
+    static constexpr auto name = "sparkBucketId";
+    static DB::FunctionPtr create(DB::ContextPtr) { return std::make_shared<FunctionSparkBucketId>(); }
+
+    String getName() const override { return name; }
+    bool isVariadic() const override { return true; }
+    size_t getNumberOfArguments() const override { return 0; }
+    bool useDefaultImplementationForNulls() const override { return false; }
+    bool useDefaultImplementationForConstants() const override { return true; }
+    DB::ColumnNumbers getArgumentsThatAreAlwaysConstant() const override { return {0, 1}; }
+    bool isSuitableForShortCircuitArgumentsExecution(const DB::DataTypesWithConstInfo & /*arguments*/) const override { return true; }
+
+    DB::DataTypePtr getReturnTypeImpl(const DB::DataTypes & arguments) const override
+    {
+        if (arguments.size() < 3)
+            throw DB::Exception(
+                DB::ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH,
+                "Function {} requires at least 3 arguments, got {}",
+                name,
+                arguments.size());
+        return std::make_shared<DB::DataTypeInt32>();
+    }
+
+    DB::ColumnPtr
+    executeImpl(const DB::ColumnsWithTypeAndName & arguments, const DB::DataTypePtr &, size_t /*input_rows_count*/) const override
+    {
+        const auto num_buckets = static_cast<Int32>(arguments[0].column->getInt(0));
+        const bool hive_compatible = arguments[1].column->getBool(0);
+        DB::ColumnsWithTypeAndName columns(arguments.begin() + 2, arguments.end());
+        return SparkBucketHasher::bucketIds(columns, num_buckets, hive_compatible);
+    }
+};
+
+REGISTER_FUNCTION(SparkBucketId)
+{
+    factory.registerFunction<FunctionSparkHiveHash>();
+    factory.registerFunction<FunctionSparkBucketId>();
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Core/ColumnsWithTypeAndName.h>
+#include <DataTypes/IDataType.h>
+#include <Common/PODArray.h>
+
+namespace local_engine
+{
+
+/// Computes the bucket ids of bucketed writes column by column, bit-exact with Spark:
+/// - pmod(murmur3hash(cols...), num_buckets), the bucket id of Spark's bucketed tables, which is also the partition id
+///   of HashPartitioning.
+/// - pmod(hive_hash(cols...) & Int.MaxValue, num_buckets), the bucket id of Hive-compatible bucketed tables.
+/// The per-value hashes are the kernels of core/utils/SparkHash.h, which the Velox backend shares.
+class SparkBucketHasher
+{
+public:
+    using Hashes = DB::PaddedPODArray<Int32>;
+
+    /// Whether columns of type can be hashed. Complex types are not, so their hashes must be computed by the generic
+    /// hash functions.
+    static bool isSupported(const DB::DataTypePtr & type);
+
+    /// Folds Spark's murmur3 hash of each row of column into hashes, which start from the seed 42.
+    static void murmur3(const DB::ColumnWithTypeAndName & column, Hashes & hashes);
+
+    /// Folds Hive's hash of each row of column into hashes, which start from 0.
+    static void hive(const DB::ColumnWithTypeAndName & column, Hashes & hashes);
+
+    /// Returns the bucket id of each row of the bucket columns.
+    static DB::ColumnPtr bucketIds(const DB::ColumnsWithTypeAndName & columns, Int32 num_buckets, bool hive_compatible);
+};
+
+}
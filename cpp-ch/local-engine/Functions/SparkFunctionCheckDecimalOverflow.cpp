@@ -22,10 +22,15 @@
 #include <Core/DecimalFunctions.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypesDecimal.h>
+#include <DataTypes/Native.h>
 #include <Functions/FunctionFactory.h>
 #include <Functions/FunctionHelpers.h>
 #include <Functions/IFunction.h>
 
+#if USE_EMBEDDED_COMPILER
+#include <llvm/IR/IRBuilder.h>
+#endif
+
 namespace DB
 {
 namespace ErrorCodes
@@ -145,6 +150,67 @@ public:
         return result_column;
     }
 
+#if USE_EMBEDDED_COMPILER
+    /// Only checkDecimalOverflowSparkOrNull is compiled, JIT code has no way to throw on overflow.
+    bool isCompilableImpl(const DataTypes & arguments, const DataTypePtr & result_type) const override
+    {
+        if constexpr (exception_mode == CheckExceptionMode::Throw)
+            return false;
+
+        if (arguments.size() != 3 || !isDecimal(arguments[0]))
+            return false;
+
+        return canBeNativeType(*arguments[0]) && canBeNativeType(*arguments[1]) && canBeNativeType(*arguments[2])
+            && canBeNativeType(*removeNullable(result_type));
+    }
+
+    /// Precision and scale of the result are taken from result_type, so the constant arguments are not used here.
+    llvm::Value *
+    compileImpl(llvm::IRBuilderBase & builder, const ValuesWithType & arguments, const DataTypePtr & result_type) const override
+    {
+        auto & b = static_cast<llvm::IRBuilder<> &>(builder);
+        const auto & from_type = arguments[0].type;
+        const auto to_type = removeNullable(result_type);
+        UInt32 scale_from = getDecimalScale(*from_type);
+        UInt32 scale_to = getDecimalScale(*to_type);
+        UInt32 precision_to = getDecimalPrecision(*to_type);
+
+        /// Same as convertDecimalsImpl, calculate in the wider one of the source and result types.
+        auto * from_int_type = llvm::cast<llvm::IntegerType>(arguments[0].value->getType());
+        auto * to_int_type = llvm::cast<llvm::IntegerType>(toNativeType(b, to_type));
+        unsigned bits = std::max(from_int_type->getBitWidth(), to_int_type->getBitWidth());
+        auto * calculate_type = b.getIntNTy(bits);
+        auto power_of_ten = [bits](UInt32 exp) { return llvm::APInt(bits, "1" + std::string(exp, '0'), 10); };
+
+        llvm::Value * value = b.CreateSExt(arguments[0].value, calculate_type);
+        llvm::Value * is_null = b.getFalse();
+        if (scale_to > scale_from)
+        {
+            /// value * 10^n overflows exactly when |value| > max / 10^n, as 10^n never divides max + 1.
+            auto multiplier = power_of_ten(scale_to - scale_from);
+            auto bound = llvm::APInt::getSignedMaxValue(bits).sdiv(multiplier);
+            is_null = b.CreateOr(
+                b.CreateICmpSGT(value, llvm::ConstantInt::get(calculate_type, bound)),
+                b.CreateICmpSLT(value, llvm::ConstantInt::get(calculate_type, -bound)));
+            value = b.CreateMul(value, llvm::ConstantInt::get(calculate_type, multiplier));
+        }
+        else if (scale_to < scale_from)
+            value = b.CreateSDiv(value, llvm::ConstantInt::get(calculate_type, power_of_ten(scale_from - scale_to)));
+
+        auto max_value = power_of_ten(precision_to);
+        auto * is_overflow = b.CreateOr(
+            b.CreateICmpSGE(value, llvm::ConstantInt::get(calculate_type, max_value)),
+            b.CreateICmpSLE(value, llvm::ConstantInt::get(calculate_type, -max_value)));
+        is_null = b.CreateOr(is_null, is_overflow);
+
+        auto * result_value = b.CreateSelect(is_null, llvm::ConstantInt::get(to_int_type, 0), b.CreateTrunc(value, to_int_type));
+        auto * nullable_structure_type = toNativeType(b, makeNullable(to_type));
+        auto * nullable_structure_value = llvm::Constant::getNullValue(nullable_structure_type);
+        auto * nullable_structure_with_result_value = b.CreateInsertValue(nullable_structure_value, result_value, {0});
+        return b.CreateInsertValue(nullable_structure_with_result_value, is_null, {1});
+    }
+#endif // USE_EMBEDDED_COMPILER
+
 private:
     template <typename T, typename ToDataType>
     static void executeInternal(
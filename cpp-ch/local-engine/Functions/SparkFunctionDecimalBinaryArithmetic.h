@@ -16,6 +16,7 @@
  */
 #include "SparkFunctionDecimalBinaryOperator.h"
 
+#include <optional>
 #include <Columns/ColumnDecimal.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnsNumber.h>
@@ -169,28 +170,162 @@ public:
             || DataTypeDecimal<RightFieldType>::maxPrecision() < p2 + max_scale - right_type.getScale())
             calculate_with_i256 = true;
 
+        /// The widths chosen above only depend on declared precisions. Columns declared as e.g. DECIMAL(38, 18) usually hold
+        /// much smaller values, so check the actual values of this batch and calculate with Int64 if nothing can overflow.
         if (calculate_with_i256)
         {
+            if (canCalculateWithInt64(left_type, right_type, result_type, col_left_const, col_right_const, col_left_vec, col_right_vec))
+                return executeDecimalWithInt64<true>(
+                    left_type, right_type, col_left_const, col_right_const, col_left_vec, col_right_vec, rows, result_type);
+
             /// Use Int256 for calculation
-            return executeDecimalImpl<LeftDataType, RightDataType, ResultDataType, Int256>(
+            return executeDecimalImpl<LeftDataType, RightDataType, ResultDataType, Int256, true>(
                 left_type, right_type, col_left_const, col_right_const, col_left_vec, col_right_vec, rows, result_type);
         }
         else if constexpr (is_division)
         {
+            if (canCalculateWithInt64(left_type, right_type, result_type, col_left_const, col_right_const, col_left_vec, col_right_vec))
+                return executeDecimalWithInt64<true>(
+                    left_type, right_type, col_left_const, col_right_const, col_left_vec, col_right_vec, rows, result_type);
+
             /// Use Int128 for calculation
-            return executeDecimalImpl<LeftDataType, RightDataType, ResultDataType, Int128>(
+            return executeDecimalImpl<LeftDataType, RightDataType, ResultDataType, Int128, true>(
                 left_type, right_type, col_left_const, col_right_const, col_left_vec, col_right_vec, rows, result_type);
         }
         else
         {
+            using ResultNativeType = NativeType<ResultFieldType>;
+            if constexpr (sizeof(ResultNativeType) > sizeof(Int64))
+            {
+                if (canCalculateWithInt64(left_type, right_type, result_type, col_left_const, col_right_const, col_left_vec, col_right_vec))
+                    return executeDecimalWithInt64<false>(
+                        left_type, right_type, col_left_const, col_right_const, col_left_vec, col_right_vec, rows, result_type);
+            }
+
             /// Use ResultNativeType for calculation
-            return executeDecimalImpl<LeftDataType, RightDataType, ResultDataType, NativeType<ResultFieldType>>(
+            return executeDecimalImpl<LeftDataType, RightDataType, ResultDataType, ResultNativeType, false>(
                 left_type, right_type, col_left_const, col_right_const, col_left_vec, col_right_vec, rows, result_type);
         }
     }
 
 private:
-    template <typename LeftDataType, typename RightDataType, typename ResultDataType, typename ScaledNativeType>
+    /// Largest absolute value in data if all values fit in Int64, std::nullopt otherwise.
+    /// Int64 minimum is rejected so that its absolute value stays representable.
+    template <typename FieldType>
+    static std::optional<Int64> getMaxAbsInInt64(const FieldType * data, size_t size)
+    {
+        using T = NativeType<FieldType>;
+
+        T min_value = 0;
+        T max_value = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            min_value = std::min(min_value, data[i].value);
+            max_value = std::max(max_value, data[i].value);
+        }
+
+        if constexpr (sizeof(T) > sizeof(Int64))
+        {
+            if (min_value <= static_cast<T>(std::numeric_limits<Int64>::min()) || max_value > static_cast<T>(std::numeric_limits<Int64>::max()))
+                return std::nullopt;
+        }
+        else if constexpr (sizeof(T) == sizeof(Int64))
+        {
+            if (min_value == std::numeric_limits<Int64>::min())
+                return std::nullopt;
+        }
+
+        return std::max(static_cast<Int64>(max_value), -static_cast<Int64>(min_value));
+    }
+
+    template <typename LeftDataType, typename RightDataType, typename ResultDataType>
+    static bool canCalculateWithInt64(
+        const LeftDataType & left_type,
+        const RightDataType & right_type,
+        const ResultDataType & result_type,
+        const ColumnConst * col_left_const,
+        const ColumnConst * col_right_const,
+        const ColumnDecimal<typename LeftDataType::FieldType> * col_left_vec,
+        const ColumnDecimal<typename RightDataType::FieldType> * col_right_vec)
+    {
+        using LeftFieldType = typename LeftDataType::FieldType;
+        using RightFieldType = typename RightDataType::FieldType;
+
+        size_t max_scale = getMaxScaled(left_type.getScale(), right_type.getScale(), result_type.getScale());
+        size_t left_exp = 0;
+        size_t right_exp = 0;
+        if constexpr (is_division)
+            left_exp = max_scale - left_type.getScale() + max_scale;
+        else if constexpr (!is_multiply)
+            left_exp = max_scale - left_type.getScale();
+        if constexpr (!is_multiply)
+            right_exp = max_scale - right_type.getScale();
+
+        /// 10^18 is the largest power of ten in Int64
+        if (left_exp > 18 || right_exp > 18 || max_scale - result_type.getScale() > 18)
+            return false;
+
+        std::optional<Int64> left_max_abs;
+        if (col_left_vec)
+            left_max_abs = getMaxAbsInInt64(col_left_vec->getData().data(), col_left_vec->size());
+        else if (col_left_const)
+        {
+            LeftFieldType value = col_left_const->getValue<LeftFieldType>();
+            left_max_abs = getMaxAbsInInt64(&value, 1);
+        }
+        if (!left_max_abs)
+            return false;
+
+        std::optional<Int64> right_max_abs;
+        if (col_right_vec)
+            right_max_abs = getMaxAbsInInt64(col_right_vec->getData().data(), col_right_vec->size());
+        else if (col_right_const)
+        {
+            RightFieldType value = col_right_const->getValue<RightFieldType>();
+            right_max_abs = getMaxAbsInInt64(&value, 1);
+        }
+        if (!right_max_abs)
+            return false;
+
+        Int64 scaled_left;
+        Int64 scaled_right;
+        if (common::mulOverflow(*left_max_abs, DecimalUtils::scaleMultiplier<Int64>(left_exp), scaled_left)
+            || common::mulOverflow(*right_max_abs, DecimalUtils::scaleMultiplier<Int64>(right_exp), scaled_right))
+            return false;
+
+        /// Division and modulo never produce a result larger than their scaled operands
+        Int64 bound;
+        if constexpr (is_multiply)
+            return !common::mulOverflow(scaled_left, scaled_right, bound);
+        else if constexpr (is_plus_minus)
+            return !common::addOverflow(scaled_left, scaled_right, bound);
+        else
+            return true;
+    }
+
+    /// Runs the calculation with Int64 once canCalculateWithInt64 has proved that no intermediate value overflows.
+    /// Division and unscaling truncate the same way on every width, so the results equal those of the wider types.
+    template <bool check_result_range, typename LeftDataType, typename RightDataType, typename ResultDataType>
+    static ColumnPtr executeDecimalWithInt64(
+        const LeftDataType & left_type,
+        const RightDataType & right_type,
+        const ColumnConst * col_left_const,
+        const ColumnConst * col_right_const,
+        const ColumnDecimal<typename LeftDataType::FieldType> * col_left_vec,
+        const ColumnDecimal<typename RightDataType::FieldType> * col_right_vec,
+        size_t rows,
+        const ResultDataType & result_type)
+    {
+        /// Any Int64 has at most 19 digits, so a wider result precision can't be exceeded.
+        if (check_result_range && result_type.getPrecision() <= 18)
+            return executeDecimalImpl<LeftDataType, RightDataType, ResultDataType, Int64, true>(
+                left_type, right_type, col_left_const, col_right_const, col_left_vec, col_right_vec, rows, result_type);
+        else
+            return executeDecimalImpl<LeftDataType, RightDataType, ResultDataType, Int64, false>(
+                left_type, right_type, col_left_const, col_right_const, col_left_vec, col_right_vec, rows, result_type);
+    }
+
+    template <typename LeftDataType, typename RightDataType, typename ResultDataType, typename ScaledNativeType, bool check_result_range>
     static ColumnPtr executeDecimalImpl(
         const LeftDataType & left_type,
         const RightDataType & right_type,
@@ -236,7 +371,9 @@ private:
             return DecimalUtils::scaleMultiplier<ScaledNativeType>(diff);
         }();
 
-        ScaledNativeType max_value = intExp10OfSize<ScaledNativeType>(result_type.getPrecision());
+        ScaledNativeType max_value = 0;
+        if constexpr (check_result_range)
+            max_value = intExp10OfSize<ScaledNativeType>(result_type.getPrecision());
 
         auto res_vec = ColVecResult::create(rows, result_type.getScale());
         auto & res_vec_data = res_vec->getData();
@@ -245,7 +382,7 @@ private:
 
         if (col_left_vec && col_right_vec)
         {
-                process<OpCase::Vector>(
+                process<OpCase::Vector, check_result_range>(
                     col_left_vec->getData().data(),
                     col_right_vec->getData().data(),
                     res_vec_data,
@@ -259,7 +396,7 @@ private:
         else if (col_left_const && col_right_vec)
         {
             LeftFieldType left_value = col_left_const->getValue<LeftFieldType>();
-            process<OpCase::LeftConstant>(
+            process<OpCase::LeftConstant, check_result_range>(
                 &left_value,
                 col_right_vec->getData().data(),
                 res_vec_data,
@@ -273,7 +410,7 @@ private:
         else if (col_left_vec && col_right_const)
         {
             RightFieldType right_value = col_right_const->getValue<RightFieldType>();
-            process<OpCase::RightConstant>(
+            process<OpCase::RightConstant, check_result_range>(
                 col_left_vec->getData().data(),
                 &right_value,
                 res_vec_data,
@@ -297,6 +434,7 @@ private:
 
         template <
             OpCase op_case,
+            bool check_result_range,
             typename LeftFieldType,
             typename RightFieldType,
             typename ResultFieldType,
@@ -317,7 +455,7 @@ private:
             if constexpr (op_case == OpCase::Vector)
             {
                 for (size_t i = 0; i < rows; ++i)
-                    res_nullmap_data[i] = !calculate(
+                    res_nullmap_data[i] = !calculate<check_result_range>(
                         static_cast<ScaledNativeType>(unwrap<op_case == OpCase::LeftConstant>(left_data, i)),
                         static_cast<ScaledNativeType>(unwrap<op_case == OpCase::RightConstant>(right_data, i)),
                         scale_left,
@@ -332,7 +470,7 @@ private:
                     = applyScaled(static_cast<ScaledNativeType>(unwrap<op_case == OpCase::LeftConstant>(left_data, 0)), scale_left);
 
                 for (size_t i = 0; i < rows; ++i)
-                    res_nullmap_data[i] = !calculate(
+                    res_nullmap_data[i] = !calculate<check_result_range>(
                         scaled_left,
                         static_cast<ScaledNativeType>(unwrap<op_case == OpCase::RightConstant>(right_data, i)),
                         static_cast<ScaledNativeType>(1),
@@ -347,7 +485,7 @@ private:
                     = applyScaled(static_cast<ScaledNativeType>(unwrap<op_case == OpCase::RightConstant>(right_data, 0)), scale_right);
 
                 for (size_t i = 0; i < rows; ++i)
-                    res_nullmap_data[i] = !calculate(
+                    res_nullmap_data[i] = !calculate<check_result_range>(
                         static_cast<ScaledNativeType>(unwrap<op_case == OpCase::LeftConstant>(left_data, i)),
                         scaled_right,
                         scale_left,
@@ -359,6 +497,7 @@ private:
     }
 
     template <
+        bool check_result_range,
         typename ScaledNativeType,
         typename ResultNativeType>
     static ALWAYS_INLINE bool calculate(
@@ -383,7 +522,7 @@ private:
 
         res = static_cast<ResultNativeType>(c_res);
 
-        if constexpr (std::is_same_v<ScaledNativeType, Int256> || is_division)
+        if constexpr (check_result_range)
             return c_res > -max_value && c_res < max_value;
         else
             return true;
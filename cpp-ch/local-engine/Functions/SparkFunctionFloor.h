@@ -18,11 +18,18 @@
 
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnVector.h>
+#include <DataTypes/DataTypesDecimal.h>
 #include <DataTypes/DataTypesNumber.h>
 #include <DataTypes/IDataType.h>
+#include <DataTypes/Native.h>
 #include <Functions/FunctionFactory.h>
 #include <Functions/FunctionsRound.h>
 
+#if USE_EMBEDDED_COMPILER
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
+#endif
+
 #if USE_MULTITARGET_CODE
 #include <immintrin.h>
 #endif
@@ -273,5 +280,65 @@ public:
         }
         return DB::ColumnNullable::create(std::move(col_res), std::move(null_map_col));
     }
+
+#if USE_EMBEDDED_COMPILER
+    /// Only the form without scale is compiled, which is the only one Spark's floor produces.
+    bool isCompilableImpl(const DB::DataTypes & arguments, const DB::DataTypePtr & result_type) const override
+    {
+        if (arguments.size() != 1)
+            return false;
+
+        if (!canBeNativeType(*arguments[0]) || !canBeNativeType(*removeNullable(result_type)))
+            return false;
+
+        DB::WhichDataType which(arguments[0]);
+        return which.isNativeInt() || which.isNativeUInt() || which.isFloat32() || which.isFloat64() || which.isDecimal();
+    }
+
+    llvm::Value *
+    compileImpl(llvm::IRBuilderBase & builder, const DB::ValuesWithType & arguments, const DB::DataTypePtr & result_type) const override
+    {
+        auto & b = static_cast<llvm::IRBuilder<> &>(builder);
+        const auto & type = arguments[0].type;
+        llvm::Value * src_value = arguments[0].value;
+        llvm::Value * result_value = src_value;
+        llvm::Value * result_is_null = b.getFalse();
+
+        DB::WhichDataType which(type);
+        if (which.isFloat32() || which.isFloat64())
+        {
+            /// Same as checkAndSetNullable: NaN and +/-Inf become NULL with a zero value.
+            llvm::Type * float_type = src_value->getType();
+            llvm::Value * floor_value = b.CreateUnaryIntrinsic(llvm::Intrinsic::floor, src_value);
+            llvm::Value * is_nan = b.CreateFCmpUNO(floor_value, floor_value);
+            llvm::Value * is_inf = b.CreateOr(
+                b.CreateFCmpOEQ(floor_value, llvm::ConstantFP::getInfinity(float_type, false)),
+                b.CreateFCmpOEQ(floor_value, llvm::ConstantFP::getInfinity(float_type, true)));
+            result_is_null = b.CreateOr(is_nan, is_inf);
+            result_value = b.CreateSelect(result_is_null, llvm::ConstantFP::get(float_type, 0.0), floor_value);
+        }
+        else if (which.isDecimal())
+        {
+            /// Same as IntegerRoundingComputation<RoundingMode::Floor>: x < 0 ? (x - (scale - 1)) / scale * scale : x / scale * scale
+            UInt32 scale = DB::getDecimalScale(*type);
+            if (scale)
+            {
+                auto * int_type = llvm::cast<llvm::IntegerType>(src_value->getType());
+                llvm::APInt multiplier(int_type->getBitWidth(), "1" + std::string(scale, '0'), 10);
+                auto * multiplier_value = llvm::ConstantInt::get(int_type, multiplier);
+                auto * adjusted_value = b.CreateSelect(
+                    b.CreateICmpSLT(src_value, llvm::ConstantInt::get(int_type, 0)),
+                    b.CreateSub(src_value, llvm::ConstantInt::get(int_type, multiplier - 1)),
+                    src_value);
+                result_value = b.CreateMul(b.CreateSDiv(adjusted_value, multiplier_value), multiplier_value);
+            }
+        }
+
+        auto * nullable_structure_type = toNativeType(b, makeNullable(result_type));
+        auto * nullable_structure_value = llvm::Constant::getNullValue(nullable_structure_type);
+        auto * nullable_structure_with_result_value = b.CreateInsertValue(nullable_structure_value, result_value, {0});
+        return b.CreateInsertValue(nullable_structure_with_result_value, result_is_null, {1});
+    }
+#endif // USE_EMBEDDED_COMPILER
 };
 }
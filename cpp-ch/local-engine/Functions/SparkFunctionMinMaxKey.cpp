@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/IDataType.h>
+#include <Functions/FunctionFactory.h>
+#include <Functions/FunctionHelpers.h>
+#include <Functions/IFunction.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int ILLEGAL_COLUMN;
+extern const int ILLEGAL_TYPE_OF_ARGUMENT;
+}
+}
+
+namespace local_engine
+{
+using namespace DB;
+
+namespace
+{
+/// The value which the automatic minmax index of a Gluten MergeTree table keeps for a string or float column.
+/// Strings are cut to their first STRING_PREFIX_SIZE bytes, so that an index entry stays small. NaN becomes +inf,
+/// since Spark orders NaN above every other value while the minmax range of ClickHouse leaves NaN out.
+///
+/// The key is monotonic but not strictly, so the index serves predicates on the column itself: KeyCondition takes the
+/// key of the constant and relaxes `<` and `>` to `<=` and `>=`. For a cut string this amounts to rounding the maximum
+/// of a granule up.
+class SparkFunctionMinMaxKey : public IFunction
+{
+public:
+    static constexpr auto name = "sparkMinMaxKey";
+    static constexpr size_t STRING_PREFIX_SIZE = 32;
+
+    static FunctionPtr create(ContextPtr) { return std::make_shared<SparkFunctionMinMaxKey>(); }
+
+    String getName() const override { return name; }
+    size_t getNumberOfArguments() const override { return 1; }
+    bool isSuitableForShortCircuitArgumentsExecution(const DataTypesWithConstInfo & /*arguments*/) const override { return true; }
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes & arguments) const override
+    {
+        if (!isString(arguments[0]) && !isFloat32(arguments[0]) && !isFloat64(arguments[0]))
+            throw Exception(
+                ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+                "Illegal type {} of argument of function {}, expected String, Float32 or Float64",
+                arguments[0]->getName(),
+                getName());
+        return arguments[0];
+    }
+
+    bool hasInformationAboutMonotonicity() const override { return true; }
+
+    Monotonicity getMonotonicityForRange(const IDataType &, const Field &, const Field &) const override
+    {
+        return {.is_monotonic = true, .is_always_monotonic = true};
+    }
+
+    ColumnPtr executeImpl(const ColumnsWithTypeAndName & arguments, const DataTypePtr &, size_t input_rows_count) const override
+    {
+        const auto * column = arguments[0].column.get();
+        if (const auto * strings = checkAndGetColumn<ColumnString>(column))
+            return prefixes(*strings, input_rows_count);
+        if (const auto * floats = checkAndGetColumn<ColumnFloat64>(column))
+            return nanToInfinity(*floats);
+        if (const auto * floats = checkAndGetColumn<ColumnFloat32>(column))
+            return nanToInfinity(*floats);
+        throw Exception(ErrorCodes::ILLEGAL_COLUMN, "Illegal column {} of argument of function {}", column->getName(), getName());
+    }
+
+private:
+    static ColumnPtr prefixes(const ColumnString & strings, size_t input_rows_count)
+    {
+        auto result = ColumnString::create();
+        result->reserve(input_rows_count);
+        for (size_t i = 0; i < input_rows_count; ++i)
+        {
+            const auto value = strings.getDataAt(i);
+            result->insertData(value.data, std::min(value.size, STRING_PREFIX_SIZE));
+        }
+        return result;
+    }
+
+    template <typename T>
+    static ColumnPtr nanToInfinity(const ColumnVector<T> & floats)
+    {
+        const auto & from = floats.getData();
+        auto result = ColumnVector<T>::create(from.size());
+        auto & to = result->getData();
+        for (size_t i = 0; i < from.size(); ++i)
+            to[i] = std::isnan(from[i]) ? std::numeric_limits<T>::infinity() : from[i];
+        return result;
+    }
+};
+}
+
+REGISTER_FUNCTION(SparkMinMaxKey)
+{
+    factory.registerFunction<SparkFunctionMinMaxKey>(FunctionDocumentation{.description = R"(
+The value kept by the automatic minmax index of a Gluten MergeTree table: the prefix of a string, or a float with NaN
+replaced by +inf.
+)"});
+}
+}
@@ -17,8 +17,14 @@
 #pragma once
 
 #include <DataTypes/DataTypesNumber.h>
+#include <DataTypes/Native.h>
 #include <Functions/FunctionFactory.h>
 
+#if USE_EMBEDDED_COMPILER
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
+#endif
+
 namespace local_engine
 {
 class SparkFunctionRint : public DB::IFunction
@@ -53,5 +59,25 @@ public:
     {
         return std::make_shared<DB::DataTypeFloat64>();
     }
+
+#if USE_EMBEDDED_COMPILER
+    bool isCompilableImpl(const DB::DataTypes & arguments, const DB::DataTypePtr & result_type) const override
+    {
+        if (arguments.size() != 1)
+            return false;
+
+        DB::WhichDataType which(arguments[0]);
+        return (which.isFloat32() || which.isFloat64()) && canBeNativeType(*result_type);
+    }
+
+    llvm::Value *
+    compileImpl(llvm::IRBuilderBase & builder, const DB::ValuesWithType & arguments, const DB::DataTypePtr & result_type) const override
+    {
+        auto & b = static_cast<llvm::IRBuilder<> &>(builder);
+        /// Widening Float32 first is exact, so rounding in Float64 matches std::rint on the Float32 value.
+        auto * value = nativeCast(b, arguments[0], result_type);
+        return b.CreateUnaryIntrinsic(llvm::Intrinsic::rint, value);
+    }
+#endif // USE_EMBEDDED_COMPILER
 };
 }
@@ -16,8 +16,16 @@
  */
 #pragma once
 
+#include <optional>
+#include <DataTypes/DataTypesDecimal.h>
+#include <DataTypes/Native.h>
 #include <Functions/FunctionsRound.h>
 
+#if USE_EMBEDDED_COMPILER
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
+#endif
+
 namespace DB::ErrorCodes
 {
 extern const int NUMBER_OF_ARGUMENTS_DOESNT_MATCH;
@@ -387,6 +395,127 @@ public:
     {
         return {.is_monotonic = true, .is_always_monotonic = true};
     }
+
+#if USE_EMBEDDED_COMPILER
+    bool isCompilableImpl(const DB::DataTypes & arguments, const DB::DataTypePtr & result_type) const override
+    {
+        if (arguments.empty() || arguments.size() > 2)
+            return false;
+
+        if (!canBeNativeType(*arguments[0]) || !canBeNativeType(*result_type))
+            return false;
+
+        if (arguments.size() == 2)
+        {
+            DB::WhichDataType which_scale(arguments[1]);
+            if (!which_scale.isNativeInt() && !which_scale.isNativeUInt())
+                return false;
+        }
+
+        DB::WhichDataType which(arguments[0]);
+        return which.isNativeInt() || which.isNativeUInt() || which.isFloat32() || which.isFloat64() || which.isDecimal();
+    }
+
+    llvm::Value *
+    compileImpl(llvm::IRBuilderBase & builder, const DB::ValuesWithType & arguments, const DB::DataTypePtr & /*result_type*/) const override
+    {
+        auto & b = static_cast<llvm::IRBuilder<> &>(builder);
+        const auto & type = arguments[0].type;
+        llvm::Value * src_value = arguments[0].value;
+        DB::Scale scale_arg = getCompiledScaleArg(arguments);
+
+        DB::WhichDataType which(type);
+        if (which.isFloat32() || which.isFloat64())
+        {
+            /// llvm.round rounds half away from zero, the same as std::round used by FloatRoundingHalfUpComputation.
+            if (scale_arg == 0)
+                return b.CreateUnaryIntrinsic(llvm::Intrinsic::round, src_value);
+
+            size_t scale = intExp10(scale_arg > 0 ? scale_arg : -scale_arg);
+            auto * scale_value = llvm::ConstantFP::get(src_value->getType(), static_cast<Float64>(scale));
+            if (scale_arg > 0)
+                return b.CreateFDiv(b.CreateUnaryIntrinsic(llvm::Intrinsic::round, b.CreateFMul(src_value, scale_value)), scale_value);
+            return b.CreateFMul(b.CreateUnaryIntrinsic(llvm::Intrinsic::round, b.CreateFDiv(src_value, scale_value)), scale_value);
+        }
+
+        auto * int_type = llvm::cast<llvm::IntegerType>(src_value->getType());
+        if (which.isDecimal())
+        {
+            Int64 scale_diff = static_cast<Int64>(DB::getDecimalScale(*type)) - scale_arg;
+            if (scale_diff <= 0)
+                return src_value;
+
+            auto multiplier = getPowerOfTen(int_type->getBitWidth(), scale_diff);
+            if (!multiplier)
+                return llvm::ConstantInt::get(int_type, 0);
+            return compileIntegerRounding(b, src_value, *multiplier, true);
+        }
+
+        if (scale_arg >= 0)
+            return src_value;
+
+        /// Same as IntegerRoundingComputation::compute, a scale wider than the type rounds everything to zero.
+        bool is_signed = which.isNativeInt();
+        size_t scale = intExp10(-scale_arg);
+        llvm::APInt max_value
+            = is_signed ? llvm::APInt::getSignedMaxValue(int_type->getBitWidth()) : llvm::APInt::getMaxValue(int_type->getBitWidth());
+        if (scale > max_value.getZExtValue())
+            return llvm::ConstantInt::get(int_type, 0);
+        return compileIntegerRounding(b, src_value, llvm::APInt(int_type->getBitWidth(), scale), is_signed);
+    }
+
+private:
+    static DB::Scale getCompiledScaleArg(const DB::ValuesWithType & arguments)
+    {
+        if (arguments.size() != 2)
+            return 0;
+
+        /// Constant arguments are compiled into LLVM constants, so the scale is known while building the IR.
+        const auto * scale_value = llvm::dyn_cast<llvm::ConstantInt>(arguments[1].value);
+        if (!scale_value)
+            throw DB::Exception(DB::ErrorCodes::ILLEGAL_COLUMN, "DB::Scale argument for rounding functions must be constant");
+
+        bool is_unsigned = DB::WhichDataType(arguments[1].type).isNativeUInt();
+        if (is_unsigned && scale_value->getZExtValue() > static_cast<UInt64>(std::numeric_limits<DB::Scale>::max()))
+            throw DB::Exception(DB::ErrorCodes::ARGUMENT_OUT_OF_BOUND, "DB::Scale argument for rounding function is too large");
+
+        Int64 scale64 = is_unsigned ? static_cast<Int64>(scale_value->getZExtValue()) : scale_value->getSExtValue();
+        if (scale64 > std::numeric_limits<DB::Scale>::max() || scale64 < std::numeric_limits<DB::Scale>::min())
+            throw DB::Exception(DB::ErrorCodes::ARGUMENT_OUT_OF_BOUND, "DB::Scale argument for rounding function is too large");
+
+        return static_cast<DB::Scale>(scale64);
+    }
+
+    /// Returns 10^exp, or nothing if it does not fit into a signed integer of the given width.
+    static std::optional<llvm::APInt> getPowerOfTen(unsigned bits, Int64 exp)
+    {
+        llvm::APInt result(bits, 1);
+        llvm::APInt ten(bits, 10);
+        for (Int64 i = 0; i < exp; ++i)
+        {
+            bool overflow = false;
+            result = result.smul_ov(ten, overflow);
+            if (overflow)
+                return {};
+        }
+        return result;
+    }
+
+    /// Same as IntegerRoundingComputation<RoundingMode::Round, TieBreakingMode::Auto>::computeImpl,
+    /// including its wrap-around on overflow: x < 0 ? (x - scale + scale / 2) / scale * scale : (x + scale / 2) / scale * scale
+    static llvm::Value * compileIntegerRounding(llvm::IRBuilder<> & b, llvm::Value * value, const llvm::APInt & scale, bool is_signed)
+    {
+        auto * int_type = value->getType();
+        auto * scale_value = llvm::ConstantInt::get(int_type, scale);
+        auto * half_scale_value = llvm::ConstantInt::get(int_type, scale.lshr(1));
+        if (!is_signed)
+            return b.CreateMul(b.CreateUDiv(b.CreateAdd(value, half_scale_value), scale_value), scale_value);
+
+        auto * adjusted_value
+            = b.CreateSelect(b.CreateICmpSLT(value, llvm::ConstantInt::get(int_type, 0)), b.CreateSub(value, scale_value), value);
+        return b.CreateMul(b.CreateSDiv(b.CreateAdd(adjusted_value, half_scale_value), scale_value), scale_value);
+    }
+#endif // USE_EMBEDDED_COMPILER
 };
 
 
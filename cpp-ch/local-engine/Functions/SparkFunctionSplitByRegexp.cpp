@@ -24,6 +24,7 @@
 #include <Functions/Regexps.h>
 #include <base/map.h>
 #include <Common/assert_cast.h>
+#include <core/utils/SparkStringKernels.h>
 
 
 namespace DB
@@ -175,7 +176,76 @@ public:
 
 using SparkFunctionSplitByRegexp = FunctionTokens<SparkSplitByRegexpImpl>;
 
-/// Fallback splitByRegexp to splitByChar when its 1st argument is a trivial char for better performance
+/// splitByRegexpSpark whose regexp matches a literal string, e.g. ',' or '\\|', split with memchr instead of regexp
+/// matching.
+class SparkSplitByLiteralImpl
+{
+private:
+    std::optional<gluten::sparkstring::LiteralSplitter> splitter;
+
+    std::optional<size_t> max_splits;
+    size_t splits;
+    bool max_substrings_includes_remaining_string;
+
+public:
+    static constexpr auto name = "splitByRegexpSpark";
+
+    static bool isVariadic() { return true; }
+    static size_t getNumberOfArguments() { return 0; }
+
+    static ColumnNumbers getArgumentsThatAreAlwaysConstant() { return {0, 2}; }
+
+    static void checkArguments(const IFunction & func, const ColumnsWithTypeAndName & arguments)
+    {
+        checkArgumentsWithSeparatorAndOptionalMaxSubstrings(func, arguments);
+    }
+
+    static constexpr auto strings_argument_position = 1uz;
+
+    void init(const ColumnsWithTypeAndName & arguments, bool max_substrings_includes_remaining_string_)
+    {
+        const ColumnConst * col = checkAndGetColumnConstStringOrFixedString(arguments[0].column.get());
+        auto delimiter = col ? gluten::sparkstring::literalSplitDelimiter(col->getValue<String>()) : std::nullopt;
+        if (!delimiter)
+            throw Exception(ErrorCodes::ILLEGAL_COLUMN, "Illegal column {} of first argument of function {}. "
+                            "Must be a constant literal pattern.", arguments[0].column->getName(), name);
+
+        max_substrings_includes_remaining_string = max_substrings_includes_remaining_string_;
+        max_splits = extractMaxSplits(arguments, 2);
+        Int32 limit = -1;
+        if (max_splits && max_substrings_includes_remaining_string)
+            limit = static_cast<Int32>(std::min<size_t>(*max_splits, std::numeric_limits<Int32>::max()));
+        splitter.emplace(std::move(*delimiter), limit);
+    }
+
+    /// Called for each next string.
+    void set(Pos pos_, Pos end_)
+    {
+        splitter->reset(std::string_view(pos_, end_ - pos_));
+        splits = 0;
+    }
+
+    /// Get the next token, if any, or return false.
+    bool get(Pos & token_begin, Pos & token_end)
+    {
+        if (max_splits && !max_substrings_includes_remaining_string && splits == *max_splits)
+            return false;
+
+        std::string_view token;
+        if (!splitter->next(token))
+            return false;
+
+        token_begin = token.data();
+        token_end = token.data() + token.size();
+        ++splits;
+        return true;
+    }
+};
+
+using SparkFunctionSplitByLiteral = FunctionTokens<SparkSplitByLiteralImpl>;
+
+/// Split by a literal string without regexp matching when the 1st argument of splitByRegexp is one, for better
+/// performance
 class SparkSplitByRegexpOverloadResolver : public IFunctionOverloadResolver
 {
 public:
@@ -184,7 +254,8 @@ public:
 
     explicit SparkSplitByRegexpOverloadResolver(ContextPtr context_)
         : context(context_)
-        , split_by_regexp(SparkFunctionSplitByRegexp::create(context)) {}
+        , split_by_regexp(SparkFunctionSplitByRegexp::create(context))
+        , split_by_literal(SparkFunctionSplitByLiteral::create(context)) {}
 
     String getName() const override { return name; }
     size_t getNumberOfArguments() const override { return SparkSplitByRegexpImpl::getNumberOfArguments(); }
@@ -192,10 +263,10 @@ public:
 
     FunctionBasePtr buildImpl(const ColumnsWithTypeAndName & arguments, const DataTypePtr & return_type) const override
     {
-        if (patternIsTrivialChar(arguments))
-            return FunctionFactory::instance().getImpl("splitByChar", context)->build(arguments);
-        return std::make_unique<FunctionToFunctionBaseAdaptor>(
-            split_by_regexp, collections::map<DataTypes>(arguments, [](const auto & elem) { return elem.type; }), return_type);
+        auto argument_types = collections::map<DataTypes>(arguments, [](const auto & elem) { return elem.type; });
+        if (patternIsLiteral(arguments))
+            return std::make_unique<FunctionToFunctionBaseAdaptor>(split_by_literal, argument_types, return_type);
+        return std::make_unique<FunctionToFunctionBaseAdaptor>(split_by_regexp, argument_types, return_type);
     }
 
     DataTypePtr getReturnTypeImpl(const ColumnsWithTypeAndName & arguments) const override
@@ -204,30 +275,19 @@ public:
     }
 
 private:
-    bool patternIsTrivialChar(const ColumnsWithTypeAndName & arguments) const
+    static bool patternIsLiteral(const ColumnsWithTypeAndName & arguments)
     {
         if (!arguments[0].column.get())
             return false;
         const ColumnConst * col = checkAndGetColumnConstStringOrFixedString(arguments[0].column.get());
         if (!col)
             return false;
-
-        String pattern = col->getValue<String>();
-        if (pattern.size() == 1)
-        {
-            OptimizedRegularExpression re = Regexps::createRegexp<false, false, false>(pattern);
-
-            std::string required_substring;
-            bool is_trivial;
-            bool required_substring_is_prefix;
-            re.getAnalyzeResult(required_substring, is_trivial, required_substring_is_prefix);
-            return is_trivial && required_substring == pattern;
-        }
-        return false;
+        return gluten::sparkstring::literalSplitDelimiter(col->getValue<String>()).has_value();
     }
 
     ContextPtr context;
     FunctionPtr split_by_regexp;
+    FunctionPtr split_by_literal;
 };
 }
 
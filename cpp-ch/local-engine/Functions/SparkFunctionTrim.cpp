@@ -20,6 +20,7 @@
 #include <Functions/FunctionHelpers.h>
 #include <Functions/IFunction.h>
 #include <IO/WriteHelpers.h>
+#include <core/utils/SparkStringKernels.h>
 
 #include <memory>
 #include <string>
@@ -138,8 +139,8 @@ namespace
                 for (size_t row = 0; row < input_rows_count; ++row)
                 {
                     StringRef trim_str_ref = trim_col->getDataAt(row);
-                    std::unique_ptr<std::bitset<256>> trim_set = buildTrimSet(trim_str_ref.data, trim_str_ref.size);
-                    executeRow(src_const_str.c_str(), src_const_str.size(), res_data, res_offsets, row, *trim_set);
+                    gluten::sparkstring::TrimSet trim_set(trim_str_ref.toView());
+                    executeRow(src_const_str.c_str(), src_const_str.size(), res_data, res_offsets, row, trim_set);
                 }
                 return std::move(res_col);
             }
@@ -148,11 +149,11 @@ namespace
             if (trim_const_col)
             {
                 res_data.reserve_exact(src_col->getChars().size());
-                std::unique_ptr<std::bitset<256>> trim_set = buildTrimSet(trim_const_str.c_str(), trim_const_str.size());
+                gluten::sparkstring::TrimSet trim_set(trim_const_str);
                 for (size_t row = 0; row < input_rows_count; ++row)
                 {
                     StringRef src_str_ref = src_col->getDataAt(row);
-                    executeRow(src_str_ref.data, src_str_ref.size, res_data, res_offsets, row, *trim_set);
+                    executeRow(src_str_ref.data, src_str_ref.size, res_data, res_offsets, row, trim_set);
                 }
                 return std::move(res_col);
             }
@@ -163,8 +164,8 @@ namespace
             {
                 StringRef src_str_ref = src_col->getDataAt(row);
                 StringRef trim_str_ref = trim_col->getDataAt(row);
-                std::unique_ptr<std::bitset<256>> trim_set = buildTrimSet(trim_str_ref.data, trim_str_ref.size);
-                executeRow(src_str_ref.data, src_str_ref.size, res_data, res_offsets, row, *trim_set);
+                gluten::sparkstring::TrimSet trim_set(trim_str_ref.toView());
+                executeRow(src_str_ref.data, src_str_ref.size, res_data, res_offsets, row, trim_set);
             }
             return std::move(res_col);
         }
@@ -176,11 +177,14 @@ namespace
             ColumnString::Chars & res_data,
             ColumnString::Offsets & res_offsets,
             size_t row,
-            const std::bitset<256> & trim_set) const
+            const gluten::sparkstring::TrimSet & trim_set) const
         {
-            const char * dst;
-            size_t dst_size;
-            trim(src, src_size, dst, dst_size, trim_set);
+            /// Trims by UTF-8 characters as Spark does, so a multi-byte character in the trim string doesn't remove
+            /// parts of other characters sharing some of its bytes.
+            auto trimmed
+                = gluten::sparkstring::trim<TrimMode::trim_left, TrimMode::trim_right>(std::string_view(src, src_size), trim_set);
+            const char * dst = trimmed.data();
+            size_t dst_size = trimmed.size();
             size_t res_offset = row > 0 ? res_offsets[row - 1] : 0;
             res_data.resize_exact(res_data.size() + dst_size + 1);
             memcpySmallAllowReadWriteOverflow15(&res_data[res_offset], dst, dst_size);
@@ -189,28 +193,6 @@ namespace
             res_offsets[row] = res_offset;
         }
 
-        std::unique_ptr<std::bitset<256>> buildTrimSet(const char* data, const size_t size) const
-        {
-            auto trim_set = std::make_unique<std::bitset<256>>();
-            for (size_t i = 0; i < size; ++i)
-                trim_set->set((unsigned char)data[i]);
-            return trim_set;
-        }
-
-        void trim(const char * src, const size_t src_size, const char *& dst, size_t & dst_size, const std::bitset<256> & trim_set) const
-        {
-            const char * src_end = src + src_size;
-            if constexpr (TrimMode::trim_left)
-                while (src < src_end && trim_set.test((unsigned char)*src))
-                    ++src;
-
-            if constexpr (TrimMode::trim_right)
-                while (src < src_end && trim_set.test((unsigned char)*(src_end - 1)))
-                    --src_end;
-
-            dst = src;
-            dst_size = src_end - src;
-        }
     };
 
     using FunctionTrimBothSpark = TrimSparkFunction<TrimModeBoth>;
@@ -0,0 +1,59 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CancellableReadBuffer.h"
+
+namespace local_engine
+{
+CancellableReadBuffer::CancellableReadBuffer(std::unique_ptr<DB::SeekableReadBuffer> impl_, CancellationTokenPtr cancellation_token_)
+    : DB::ReadBufferFromFileDecorator(std::move(impl_)), cancellation_token(std::move(cancellation_token_))
+{
+}
+
+bool CancellableReadBuffer::nextImpl()
+{
+    cancellation_token->throwIfCancelled();
+    return DB::ReadBufferFromFileDecorator::nextImpl();
+}
+
+off_t CancellableReadBuffer::seek(off_t off, int whence)
+{
+    cancellation_token->throwIfCancelled();
+    return DB::ReadBufferFromFileDecorator::seek(off, whence);
+}
+
+size_t CancellableReadBuffer::readBigAt(
+    char * to, size_t n, size_t offset, const std::function<bool(size_t m)> & progress_callback) const
+{
+    cancellation_token->throwIfCancelled();
+    const size_t read = impl->readBigAt(
+        to,
+        n,
+        offset,
+        [&](size_t m) { return cancellation_token->isCancelled() || (progress_callback && progress_callback(m)); });
+    cancellation_token->throwIfCancelled();
+    return read;
+}
+
+std::unique_ptr<DB::ReadBuffer>
+CancellableReadBuffer::wrap(std::unique_ptr<DB::ReadBuffer> in, const CancellationTokenPtr & cancellation_token)
+{
+    if (!cancellation_token || !dynamic_cast<DB::SeekableReadBuffer *>(in.get()))
+        return in;
+    std::unique_ptr<DB::SeekableReadBuffer> seekable(static_cast<DB::SeekableReadBuffer *>(in.release()));
+    return std::make_unique<CancellableReadBuffer>(std::move(seekable), cancellation_token);
+}
+}
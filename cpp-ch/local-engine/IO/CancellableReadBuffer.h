@@ -0,0 +1,44 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <IO/ReadBufferFromFileDecorator.h>
+#include <Common/CancellationToken.h>
+
+namespace local_engine
+{
+/// Stops reading once the task is cancelled: before each buffer refill, and at the progress points of big reads. Reads
+/// blocked in remote storage thus end within one chunk, and the prefetches of the wrapped buffer are cancelled when
+/// the pipeline destroys it.
+class CancellableReadBuffer final : public DB::ReadBufferFromFileDecorator
+{
+public:
+    CancellableReadBuffer(std::unique_ptr<DB::SeekableReadBuffer> impl_, CancellationTokenPtr cancellation_token_);
+
+    bool nextImpl() override;
+    off_t seek(off_t off, int whence) override;
+
+    bool supportsReadAt() override { return impl->supportsReadAt(); }
+    size_t readBigAt(char * to, size_t n, size_t offset, const std::function<bool(size_t m)> & progress_callback) const override;
+
+    /// Wraps in a CancellableReadBuffer if there is a token and the buffer is seekable, and returns in as is otherwise.
+    static std::unique_ptr<DB::ReadBuffer> wrap(std::unique_ptr<DB::ReadBuffer> in, const CancellationTokenPtr & cancellation_token);
+
+private:
+    CancellationTokenPtr cancellation_token;
+};
+}
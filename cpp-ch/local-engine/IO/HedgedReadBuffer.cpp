@@ -0,0 +1,355 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "HedgedReadBuffer.h"
+
+#include <cmath>
+#include <condition_variable>
+#include <numeric>
+#include <unordered_map>
+#include <IO/BufferWithOwnMemory.h>
+#include <Common/CurrentMetrics.h>
+#include <Common/Exception.h>
+#include <Common/Stopwatch.h>
+#include <Common/ThreadPool.h>
+#include <Common/logger_useful.h>
+
+namespace DB::ErrorCodes
+{
+extern const int CANNOT_SEEK_THROUGH_FILE;
+}
+
+namespace CurrentMetrics
+{
+extern const Metric LocalThread;
+extern const Metric LocalThreadActive;
+extern const Metric LocalThreadScheduled;
+}
+
+namespace local_engine
+{
+size_t ReadLatencyHistogram::bucketOf(UInt64 micros)
+{
+    if (micros <= 1)
+        return 0;
+    const auto bucket = static_cast<size_t>(std::log2(static_cast<double>(micros)) * BUCKETS_PER_OCTAVE);
+    return std::min(bucket, NUM_BUCKETS - 1);
+}
+
+UInt64 ReadLatencyHistogram::upperBoundOf(size_t bucket)
+{
+    return static_cast<UInt64>(std::ceil(std::exp2(static_cast<double>(bucket + 1) / BUCKETS_PER_OCTAVE)));
+}
+
+void ReadLatencyHistogram::record(UInt64 micros)
+{
+    std::lock_guard lock(mutex);
+    ++counts[bucketOf(micros)];
+    ++total;
+    ++recorded;
+    if (++recorded_since_decay < WINDOW)
+        return;
+    for (auto & count : counts)
+        count /= 2;
+    total = std::accumulate(counts.begin(), counts.end(), UInt64{0});
+    recorded_since_decay = 0;
+}
+
+std::optional<UInt64> ReadLatencyHistogram::percentile(double fraction, size_t min_samples) const
+{
+    std::lock_guard lock(mutex);
+    if (recorded < min_samples || total == 0)
+        return {};
+    const auto target = static_cast<UInt64>(std::ceil(fraction * static_cast<double>(total)));
+    UInt64 seen = 0;
+    for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+    {
+        seen += counts[bucket];
+        if (seen >= target)
+            return upperBoundOf(bucket);
+    }
+    return upperBoundOf(NUM_BUCKETS - 1);
+}
+
+std::shared_ptr<HedgedReadStorage> HedgedReadStorage::get(const String & name)
+{
+    static std::mutex mutex;
+    static std::unordered_map<String, std::shared_ptr<HedgedReadStorage>> storages;
+    std::lock_guard lock(mutex);
+    auto & storage = storages[name];
+    if (!storage)
+        storage = std::make_shared<HedgedReadStorage>();
+    return storage;
+}
+
+HedgeBudget & HedgeBudget::global()
+{
+    static HedgeBudget budget;
+    return budget;
+}
+
+void HedgeBudget::earn(double ratio)
+{
+    std::lock_guard lock(mutex);
+    tokens = std::min(MAX_TOKENS, tokens + ratio);
+}
+
+bool HedgeBudget::tryAcquire()
+{
+    std::lock_guard lock(mutex);
+    if (tokens < 1)
+        return false;
+    tokens -= 1;
+    return true;
+}
+
+namespace
+{
+/// The hedge of one range read of HedgedReadBuffer::readBigAt. The primary attempt reads into the caller's memory, the
+/// hedge into its own, which is copied out only if the hedge wins.
+struct HedgedRequest
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    /// Set once the read is over, so that the hedge is not issued any more, or stops at its next progress point.
+    std::atomic<bool> done = false;
+    bool hedge_running = false;
+    bool hedge_won = false;
+    DB::Memory<> memory;
+    size_t read = 0;
+};
+
+/// Hedges get their own pool. Each one waits out its delay in a thread, and in the IO thread pool it would hold up the
+/// readBigAt calls ParallelReadBuffer makes from there, up to a deadlock. The pool is sized by the first hedged read.
+ThreadPool & hedgedReadThreadPool(size_t max_threads)
+{
+    static ThreadPool pool(
+        CurrentMetrics::LocalThread, CurrentMetrics::LocalThreadActive, CurrentMetrics::LocalThreadScheduled, max_threads, max_threads, 0);
+    return pool;
+}
+}
+
+HedgedReadBuffer::HedgedReadBuffer(
+    std::unique_ptr<DB::ReadBufferFromFileBase> primary_,
+    CreateReader create_backup_,
+    std::shared_ptr<HedgedReadStorage> storage_,
+    HedgeBudget & budget_,
+    const HedgedReadConfig & config_,
+    size_t buf_size)
+    : DB::ReadBufferFromFileBase(buf_size, nullptr, 0)
+    , primary(std::move(primary_))
+    , backup(std::make_shared<Backup>(std::move(create_backup_)))
+    , storage(std::move(storage_))
+    , budget(budget_)
+    , config(config_)
+{
+}
+
+HedgedReadBuffer::ReaderPtr HedgedReadBuffer::Backup::get()
+{
+    std::lock_guard lock(mutex);
+    if (!reader)
+        reader = create();
+    return reader;
+}
+
+size_t HedgedReadBuffer::readBigAt(char * to, size_t n, size_t offset, const std::function<bool(size_t m)> & progress_callback) const
+{
+    ++storage->reads;
+    budget.earn(config.budget_ratio);
+    const auto threshold = storage->latencies.percentile(config.percentile, config.min_samples);
+    Stopwatch watch;
+    if (!threshold)
+    {
+        const size_t read = primary->readBigAt(to, n, offset, progress_callback);
+        storage->latencies.record(watch.elapsedMicroseconds());
+        return read;
+    }
+
+    const auto delay = std::chrono::microseconds(std::max<UInt64>(*threshold, config.min_delay_ms * 1000));
+    auto request = std::make_shared<HedgedRequest>();
+    try
+    {
+        /// The hedge is issued if the primary read has not completed within the delay. It decides under the request mutex,
+        /// so that it never touches the budget once the read is over.
+        hedgedReadThreadPool(config.threads)
+            .scheduleOrThrowOnError(
+                [request, backup_ = backup, storage_ = storage, &budget_ = budget, delay, n, offset]()
+                {
+                    {
+                        std::unique_lock lock(request->mutex);
+                        if (request->changed.wait_for(lock, delay, [&] { return request->done.load(); }) || !budget_.tryAcquire())
+                            return;
+                        request->hedge_running = true;
+                    }
+                    ++storage_->hedges;
+
+                    size_t read = 0;
+                    bool succeeded = false;
+                    try
+                    {
+                        request->memory.resize(n);
+                        read = backup_->get()->readBigAt(request->memory.data(), n, offset, [&](size_t) { return request->done.load(); });
+                        succeeded = true;
+                    }
+                    catch (...)
+                    {
+                        DB::tryLogCurrentException(getLogger("HedgedReadBuffer"), "Hedged read failed");
+                    }
+
+                    std::lock_guard lock(request->mutex);
+                    request->hedge_running = false;
+                    if (succeeded && !request->done)
+                    {
+                        request->read = read;
+                        request->hedge_won = true;
+                        request->done = true;
+                    }
+                    request->changed.notify_all();
+                });
+    }
+    catch (...)
+    {
+        DB::tryLogCurrentException(getLogger("HedgedReadBuffer"), "Failed to schedule a hedged read");
+    }
+
+    /// The primary read stops at its next progress point once the hedge won, or once the caller stops it, which in turn
+    /// stops the hedge.
+    bool stopped_by_hedge = false;
+    size_t read = 0;
+    std::exception_ptr exception;
+    try
+    {
+        read = primary->readBigAt(
+            to,
+            n,
+            offset,
+            [&](size_t m)
+            {
+                if (progress_callback && progress_callback(m))
+                    return true;
+                stopped_by_hedge = request->done;
+                return stopped_by_hedge;
+            });
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+    /// A slow primary read which lost to its hedge still counts with the time it had taken, so that the tail stays in
+    /// the histogram.
+    storage->latencies.record(watch.elapsedMicroseconds());
+
+    std::unique_lock lock(request->mutex);
+    if (exception)
+        request->changed.wait(lock, [&] { return !request->hedge_running; });
+    const bool use_hedge = (exception || stopped_by_hedge) && request->hedge_won;
+    request->done = true;
+    request->changed.notify_all();
+    lock.unlock();
+
+    if (!use_hedge)
+    {
+        if (exception)
+            std::rethrow_exception(exception);
+        return read;
+    }
+
+    /// The hedge finished, and no one writes into its memory any more.
+    ++storage->hedge_wins;
+    memcpy(to, request->memory.data(), request->read);
+    if (progress_callback)
+        progress_callback(request->read);
+    return request->read;
+}
+
+bool HedgedReadBuffer::nextImpl()
+{
+    const size_t end = read_until_position ? *read_until_position : getFileSize();
+    if (file_offset >= end)
+        return false;
+
+    const size_t read = readBigAt(internal_buffer.begin(), std::min(internal_buffer.size(), end - file_offset), file_offset, nullptr);
+    if (read == 0)
+        return false;
+    working_buffer = Buffer(internal_buffer.begin(), internal_buffer.begin() + read);
+    file_offset += read;
+    return true;
+}
+
+off_t HedgedReadBuffer::seek(off_t off, int whence)
+{
+    if (whence != SEEK_SET)
+        throw DB::Exception(DB::ErrorCodes::CANNOT_SEEK_THROUGH_FILE, "Only SEEK_SET mode is allowed.");
+    if (off < 0)
+        throw DB::Exception(DB::ErrorCodes::CANNOT_SEEK_THROUGH_FILE, "Seek position is out of bounds. Offset: {}", off);
+
+    const auto new_offset = static_cast<size_t>(off);
+    if (!working_buffer.empty() && new_offset <= file_offset && new_offset >= file_offset - working_buffer.size())
+    {
+        pos = working_buffer.end() - (file_offset - new_offset);
+        return off;
+    }
+
+    working_buffer.resize(0);
+    pos = working_buffer.begin();
+    file_offset = new_offset;
+    return off;
+}
+
+off_t HedgedReadBuffer::getPosition()
+{
+    return file_offset - available();
+}
+
+size_t HedgedReadBuffer::getFileSize()
+{
+    return primary->getFileSize();
+}
+
+void HedgedReadBuffer::setReadUntilPosition(size_t position)
+{
+    if (read_until_position == position)
+        return;
+    file_offset = getPosition();
+    working_buffer.resize(0);
+    pos = working_buffer.begin();
+    read_until_position = position;
+}
+
+void HedgedReadBuffer::setReadUntilEnd()
+{
+    if (!read_until_position)
+        return;
+    file_offset = getPosition();
+    working_buffer.resize(0);
+    pos = working_buffer.begin();
+    read_until_position.reset();
+}
+
+std::unique_ptr<DB::ReadBufferFromFileBase> HedgedReadBuffer::wrap(
+    std::unique_ptr<DB::ReadBufferFromFileBase> in,
+    CreateReader create_backup,
+    const String & storage_name,
+    const HedgedReadConfig & config,
+    size_t buf_size)
+{
+    if (!config.enabled || !in->supportsReadAt())
+        return in;
+    return std::make_unique<HedgedReadBuffer>(
+        std::move(in), std::move(create_backup), HedgedReadStorage::get(storage_name), HedgeBudget::global(), config, buf_size);
+}
+}
@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <IO/ReadBufferFromFileBase.h>
+#include <Common/GlutenConfig.h>
+
+namespace local_engine
+{
+/// Rolling latency histogram of the reads of one storage. Latencies fall into log-spaced buckets, four per power of two
+/// of microseconds, and all counts are halved every WINDOW samples so that the percentiles follow the recent reads.
+class ReadLatencyHistogram
+{
+public:
+    static constexpr size_t WINDOW = 1024;
+
+    void record(UInt64 micros);
+
+    /// The latency in microseconds under which the given fraction of the recent reads completed, or nullopt while
+    /// fewer than min_samples reads have been recorded.
+    std::optional<UInt64> percentile(double fraction, size_t min_samples) const;
+
+private:
+    static constexpr size_t BUCKETS_PER_OCTAVE = 4;
+    static constexpr size_t NUM_BUCKETS = 40 * BUCKETS_PER_OCTAVE;
+
+    static size_t bucketOf(UInt64 micros);
+    static UInt64 upperBoundOf(size_t bucket);
+
+    mutable std::mutex mutex;
+    std::array<UInt64, NUM_BUCKETS> counts{};
+    UInt64 total = 0;
+    size_t recorded_since_decay = 0;
+    size_t recorded = 0;
+};
+
+/// Latencies and hedging counters of one storage, e.g. an HDFS name service or an S3 bucket.
+struct HedgedReadStorage
+{
+    ReadLatencyHistogram latencies;
+    std::atomic<size_t> reads{0};
+    std::atomic<size_t> hedges{0};
+    std::atomic<size_t> hedge_wins{0};
+
+    static std::shared_ptr<HedgedReadStorage> get(const String & name);
+};
+
+/// Budget of duplicate requests shared by all storages. Every read earns `ratio` of a hedge, and at most MAX_TOKENS
+/// hedges are saved up, so a storage which becomes slow all at once does not double the load on it.
+class HedgeBudget
+{
+public:
+    static constexpr double MAX_TOKENS = 16;
+
+    static HedgeBudget & global();
+
+    void earn(double ratio);
+    bool tryAcquire();
+
+private:
+    std::mutex mutex;
+    double tokens = 0;
+};
+
+/// Reads ranges of a remote file with positional reads. A read which has not completed within the rolling latency
+/// percentile of its storage issues the same read through a second reader, opened from the same object, so that HDFS
+/// may serve it from another replica. The first response is taken and the other read stops at its next progress point.
+///
+/// The primary read runs in the calling thread, straight into the caller's memory. The hedge runs in a dedicated pool
+/// into its own memory, which is copied only if the hedge wins. The caller's progress callback stops both reads.
+class HedgedReadBuffer final : public DB::ReadBufferFromFileBase
+{
+public:
+    using ReaderPtr = std::shared_ptr<DB::ReadBufferFromFileBase>;
+    using CreateReader = std::function<std::unique_ptr<DB::ReadBufferFromFileBase>()>;
+
+    HedgedReadBuffer(
+        std::unique_ptr<DB::ReadBufferFromFileBase> primary_,
+        CreateReader create_backup_,
+        std::shared_ptr<HedgedReadStorage> storage_,
+        HedgeBudget & budget_,
+        const HedgedReadConfig & config_,
+        size_t buf_size);
+
+    bool nextImpl() override;
+    off_t seek(off_t off, int whence) override;
+    off_t getPosition() override;
+
+    String getFileName() const override { return primary->getFileName(); }
+    size_t getFileSize() override;
+    size_t getFileOffsetOfBufferEnd() const override { return file_offset; }
+
+    void setReadUntilPosition(size_t position) override;
+    void setReadUntilEnd() override;
+    bool supportsRightBoundedReads() const override { return true; }
+
+    bool supportsReadAt() override { return true; }
+    size_t readBigAt(char * to, size_t n, size_t offset, const std::function<bool(size_t m)> & progress_callback) const override;
+
+    /// Wraps in a HedgedReadBuffer if hedged reads are enabled and the buffer supports positional reads, and returns in
+    /// as is otherwise.
+    static std::unique_ptr<DB::ReadBufferFromFileBase> wrap(
+        std::unique_ptr<DB::ReadBufferFromFileBase> in,
+        CreateReader create_backup,
+        const String & storage_name,
+        const HedgedReadConfig & config,
+        size_t buf_size);
+
+private:
+    /// The second reader, opened on the first hedge. It is shared with the hedges, which may outlive the buffer.
+    struct Backup
+    {
+        explicit Backup(CreateReader create_) : create(std::move(create_)) { }
+        ReaderPtr get();
+
+        CreateReader create;
+        std::mutex mutex;
+        ReaderPtr reader;
+    };
+
+    ReaderPtr primary;
+    std::shared_ptr<Backup> backup;
+
+    std::shared_ptr<HedgedReadStorage> storage;
+    HedgeBudget & budget;
+    HedgedReadConfig config;
+
+    size_t file_offset = 0;
+    std::optional<size_t> read_until_position;
+};
+}
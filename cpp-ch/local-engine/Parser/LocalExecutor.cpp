@@ -112,6 +112,9 @@ Block * LocalExecutor::nextColumnar()
 
 void LocalExecutor::cancel() const
 {
+    /// First stop the IO of the task, which the executors may be blocked on.
+    if (cancellation_token)
+        cancellation_token->cancel();
     if (executor)
         executor->cancel();
     if (push_executor)
@@ -141,6 +144,7 @@ LocalExecutor::LocalExecutor(QueryPlanPtr query_plan, QueryPipelineBuilderPtr pi
     , dump_pipeline(dump_pipeline_)
     , ch_column_to_spark_row(std::make_unique<CHColumnToSparkRow>())
     , current_query_plan(std::move(query_plan))
+    , cancellation_token(QueryContext::instance().currentCancellationTokenOrNull())
 {
     if (current_executor)
         fallback_mode = true;
@@ -22,6 +22,7 @@
 #include <Processors/QueryPlan/QueryPlan.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Common/BlockIterator.h>
+#include <Common/CancellationToken.h>
 
 namespace local_engine
 {
@@ -82,6 +83,7 @@ private:
     DB::QueryPlanPtr current_query_plan;
     RelMetricPtr metric;
     std::vector<DB::QueryPlanPtr> extra_plan_holder;
+    CancellationTokenPtr cancellation_token;
     bool fallback_mode = false;
 };
 }
@@ -19,6 +19,7 @@
 #include <Processors/IProcessor.h>
 #include <Processors/QueryPlan/AggregatingStep.h>
 #include <Processors/QueryPlan/ReadFromMergeTree.h>
+#include <Storages/SubstraitSource/FormatFile.h>
 #include <Storages/SubstraitSource/SubstraitFileSourceStep.h>
 #include <Common/QueryContext.h>
 
@@ -178,8 +179,13 @@ void RelMetric::serialize(Writer<StringBuffer> & writer, bool) const
                 writer.Uint64(total_marks_pk);
                 writeCacheHits(writer);
             }
-            else if (dynamic_cast<SubstraitFileSourceStep *>(step))
+            else if (auto * file_source = dynamic_cast<SubstraitFileSourceStep *>(step))
             {
+                const auto & scan_stats = file_source->getScanStats();
+                writer.Key("total_stripes");
+                writer.Uint64(scan_stats.total_stripes.load());
+                writer.Key("pruned_stripes");
+                writer.Uint64(scan_stats.pruned_stripes.load());
                 writeCacheHits(writer);
             }
 
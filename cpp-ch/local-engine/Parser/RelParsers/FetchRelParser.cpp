@@ -19,6 +19,7 @@
 #include <optional>
 #include <Parser/RelParsers/RelParser.h>
 #include <Processors/QueryPlan/LimitStep.h>
+#include <Storages/SubstraitSource/SubstraitFileSourceStep.h>
 
 namespace local_engine
 {
@@ -31,6 +32,10 @@ public:
     DB::QueryPlanPtr parse(DB::QueryPlanPtr query_plan, const substrait::Rel & rel, std::list<const substrait::Rel *> &)
     {
         const auto & limit = rel.fetch();
+        /// A file scan right below only needs to read offset + count rows.
+        if (limit.count() >= 0)
+            if (auto * file_source = SubstraitFileSourceStep::findRowPreservingSource(*query_plan))
+                file_source->setRowLimit(limit.offset() + limit.count());
         auto limit_step = std::make_unique<DB::LimitStep>(query_plan->getCurrentHeader(), limit.count(), limit.offset());
         limit_step->setStepDescription("LIMIT");
         steps.push_back(limit_step.get());
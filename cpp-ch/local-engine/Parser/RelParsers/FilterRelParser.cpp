@@ -16,9 +16,14 @@
  */
 
 #include "FilterRelParser.h"
+#include <IO/ReadBufferFromString.h>
+#include <IO/ReadHelpers.h>
 #include <Processors/QueryPlan/FilterStep.h>
 #include <Rewriter/ExpressionRewriter.h>
+#include <Storages/SubstraitSource/SubstraitFileSourceStep.h>
+#include <google/protobuf/wrappers.pb.h>
 #include <Common/CHUtil.h>
+#include <Common/GlutenConfig.h>
 #include <Common/PlanUtil.h>
 
 namespace local_engine
@@ -29,6 +34,14 @@ FilterRelParser::FilterRelParser(ParserContextPtr parser_context_) : RelParser(p
 DB::QueryPlanPtr
 FilterRelParser::parse(DB::QueryPlanPtr query_plan, const substrait::Rel & rel, std::list<const substrait::Rel *> & /*rel_stack_*/)
 {
+    /// Sampling right above a file scan is done by the scan, which then doesn't read the row groups it doesn't choose.
+    if (auto block_sample = parseBlockSample(rel.filter()))
+    {
+        auto * file_source = SubstraitFileSourceStep::findRowPreservingSource(*query_plan);
+        if (file_source && file_source->setBlockSample(*block_sample))
+            return query_plan;
+    }
+
     ExpressionsRewriter rewriter(parser_context);
     substrait::Rel final_rel = rel;
     rewriter.rewrite(final_rel);
@@ -77,6 +90,51 @@ FilterRelParser::parse(DB::QueryPlanPtr query_plan, const substrait::Rel & rel,
     return query_plan;
 }
 
+bool FilterRelParser::isSample(const substrait::FilterRel & filter)
+{
+    if (!filter.has_advanced_extension() || !filter.advanced_extension().has_optimization())
+        return false;
+    google::protobuf::StringValue optimization;
+    optimization.ParseFromString(filter.advanced_extension().optimization().value());
+    DB::ReadBufferFromString in(optimization.value());
+    if (!DB::checkString("isSample=", in))
+        return false;
+    bool is_sample;
+    DB::readBoolText(is_sample, in);
+    return is_sample;
+}
+
+std::optional<BlockSample> FilterRelParser::parseBlockSample(const substrait::FilterRel & filter) const
+{
+    if (!isSample(filter) || !ScanConfig::loadFromContext(getContext()).enable_block_sample)
+        return {};
+    /// Only the one-sided ranges `rand(seed) < upper` and `rand(seed) >= lower` are matched; the clamped form of a range
+    /// with both bounds is left to the row filter.
+    const auto & condition = filter.condition();
+    if (!condition.has_scalar_function())
+        return {};
+    const auto comparison = parseSignatureFunctionName(condition.scalar_function().function_reference());
+    if (comparison != "lt" && comparison != "gte")
+        return {};
+    const auto & args = condition.scalar_function().arguments();
+    if (args.size() != 2 || !args[0].value().has_scalar_function() || !args[1].value().has_literal()
+        || !args[1].value().literal().has_fp64())
+        return {};
+    const auto & rand = args[0].value().scalar_function();
+    if (parseSignatureFunctionName(rand.function_reference()) != "rand" || rand.arguments().size() != 1
+        || !rand.arguments(0).value().has_literal())
+        return {};
+    const auto & seed = rand.arguments(0).value().literal();
+    if (!seed.has_i64() && !seed.has_i32())
+        return {};
+    BlockSample sample{.seed = static_cast<UInt64>(seed.has_i64() ? seed.i64() : seed.i32())};
+    if (comparison == "lt")
+        sample.upper_bound = args[1].value().literal().fp64();
+    else
+        sample.lower_bound = args[1].value().literal().fp64();
+    return sample;
+}
+
 void registerFilterRelParser(RelParserFactory & factory)
 {
     auto builder = [](ParserContextPtr ctx) -> std::unique_ptr<RelParser> { return std::make_unique<FilterRelParser>(ctx); };
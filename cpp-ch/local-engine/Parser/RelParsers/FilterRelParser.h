@@ -19,6 +19,7 @@
 
 #include <optional>
 #include <Parser/RelParsers/RelParser.h>
+#include <Storages/SubstraitSource/FormatFile.h>
 #include <Poco/Logger.h>
 #include <Common/logger_useful.h>
 
@@ -36,6 +37,11 @@ public:
     parse(DB::QueryPlanPtr query_plan, const substrait::Rel & rel, std::list<const substrait::Rel *> & rel_stack_) override;
 
 private:
+    /// Whether the filter is the rand(seed) range of a SampleExec, rather than a filter of the query.
+    static bool isSample(const substrait::FilterRel & filter);
+    /// The block sample equivalent to the filter of a SampleExec, if block sampling is enabled.
+    std::optional<BlockSample> parseBlockSample(const substrait::FilterRel & filter) const;
+
     // Poco::Logger * logger = &Poco::Logger::get("ProjectRelParser");
 };
 }
@@ -22,8 +22,9 @@ namespace local_engine
 using namespace DB;
 /*
 spark: percentile(col, percentage, [, frequency])
-1. When percentage is an array literal, spark returns an array of percentiles, corresponding to CH: quantilesExact(percentage[0], ...)(col)
-1. Otherwise spark return a single percentile, corresponding to CH: quantileExact(percentage)(col)
+1. When percentage is an array literal, spark returns an array of percentiles, corresponding to CH: sparkPercentiles(percentage[0], ...)(col, frequency)
+1. Otherwise spark return a single percentile, corresponding to CH: sparkPercentile(percentage)(col, frequency)
+The state of sparkPercentile[s] spills to disk once a group holds too many distinct values.
 */
 class PercentileParser : public PercentileParserBase
 {
@@ -33,8 +34,8 @@ public:
     explicit PercentileParser(ParserContextPtr parser_context_) : PercentileParserBase(parser_context_) { }
 
     String getName() const override { return name; }
-    String getCHSingularName() const override { return "quantileExactWeightedInterpolated"; }
-    String getCHPluralName() const override { return "quantilesExactWeightedInterpolated"; }
+    String getCHSingularName() const override { return "sparkPercentile"; }
+    String getCHPluralName() const override { return "sparkPercentiles"; }
 
     /// spark percentile(col, percentile[s], frequency)
     size_t expectedArgumentsNumberInFirstStage() const override { return 3; }
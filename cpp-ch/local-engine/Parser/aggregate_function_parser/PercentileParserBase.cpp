@@ -78,7 +78,7 @@ String PercentileParserBase::getCHFunctionName(DB::DataTypes & types) const
 
     if (getName() == "percentile")
     {
-        /// Corresponding CH function requires two arguments: quantileExactWeightedInterpolated(xxx)(col, weight)
+        /// Corresponding CH function requires two arguments: sparkPercentile(xxx)(col, weight)
         types.push_back(std::make_shared<DataTypeUInt64>());
     }
 
@@ -62,7 +62,6 @@ REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Quarter, quarter, toQuarter);
 // math functions
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Position, positive, identity);
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Negative, negative, negate);
-REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Pmod, pmod, pmod);
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Abs, abs, abs);
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Ceil, ceil, ceil);
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Round, round, roundHalfUp);
@@ -135,6 +134,7 @@ REGISTER_COMMON_SCALAR_FUNCTION_PARSER(SoundEx, soundex, soundex);
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Crc32, crc32, CRC32);
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Murmur3Hash, murmur3hash, sparkMurmurHash3_32);
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(Xxhash64, xxhash64, sparkXxHash64);
+REGISTER_COMMON_SCALAR_FUNCTION_PARSER(HiveHash, hive_hash, sparkHiveHash);
 
 REGISTER_COMMON_SCALAR_FUNCTION_PARSER(In, in, in);
 
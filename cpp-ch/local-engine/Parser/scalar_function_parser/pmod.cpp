@@ -0,0 +1,117 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits>
+#include <optional>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/SparkFunctionBucketId.h>
+#include <Parser/FunctionParser.h>
+
+namespace local_engine
+{
+
+class FunctionParserPmod : public FunctionParser
+{
+public:
+    explicit FunctionParserPmod(ParserContextPtr parser_context_) : FunctionParser(parser_context_) { }
+    ~FunctionParserPmod() override = default;
+
+    static constexpr auto name = "pmod";
+
+    String getName() const override { return name; }
+    String getCHFunctionName(const substrait::Expression_ScalarFunction & /*substrait_func*/) const override { return "pmod"; }
+
+    const DB::ActionsDAG::Node *
+    parse(const substrait::Expression_ScalarFunction & substrait_func, DB::ActionsDAG & actions_dag) const override
+    {
+        /*
+            parse the bucket ids of bucketed writes
+                pmod(murmur3hash(cols...), num_buckets)
+                pmod(bitwise_and(hive_hash(cols...), 2147483647), num_buckets)
+            as sparkBucketId(num_buckets, hive_compatible, cols...), which hashes the bucket columns and takes the
+            bucket id in one pass without materializing the hash column, if it supports the types of all cols, and any other
+            pmod as pmod.
+        */
+        if (const auto * bucket_id = tryParseBucketId(substrait_func, actions_dag))
+            return convertNodeTypeIfNeeded(substrait_func, bucket_id, actions_dag);
+        return FunctionParser::parse(substrait_func, actions_dag);
+    }
+
+private:
+    const substrait::Expression_ScalarFunction * asCall(const substrait::Expression & expr, const String & function_name) const
+    {
+        if (!expr.has_scalar_function())
+            return nullptr;
+        auto signature_name = parser_context->getFunctionNameInSignature(expr.scalar_function());
+        return signature_name && *signature_name == function_name ? &expr.scalar_function() : nullptr;
+    }
+
+    static std::optional<Int32> asInt32Literal(const substrait::Expression & expr)
+    {
+        if (expr.has_literal() && expr.literal().has_i32())
+            return expr.literal().i32();
+        return {};
+    }
+
+    const DB::ActionsDAG::Node *
+    tryParseBucketId(const substrait::Expression_ScalarFunction & substrait_func, DB::ActionsDAG & actions_dag) const
+    {
+        const auto & args = substrait_func.arguments();
+        if (args.size() != 2)
+            return nullptr;
+        auto num_buckets = asInt32Literal(args[1].value());
+        if (!num_buckets || *num_buckets <= 0)
+            return nullptr;
+
+        bool hive_compatible = false;
+        const auto * hash = asCall(args[0].value(), "murmur3hash");
+        if (!hash)
+        {
+            const auto * bitwise_and = asCall(args[0].value(), "bitwise_and");
+            if (!bitwise_and || bitwise_and->arguments_size() != 2)
+                return nullptr;
+            auto mask = asInt32Literal(bitwise_and->arguments(1).value());
+            if (!mask || *mask != std::numeric_limits<Int32>::max())
+                return nullptr;
+            hash = asCall(bitwise_and->arguments(0).value(), "hive_hash");
+            hive_compatible = true;
+        }
+        if (!hash || hash->arguments_size() == 0)
+            return nullptr;
+
+        DB::ActionsDAG::NodeRawConstPtrs columns;
+        for (const auto & arg : hash->arguments())
+        {
+            const auto * column = parseExpression(actions_dag, arg.value());
+            /// Leave complex types to the generic hash functions. The nodes parsed so far are unused then, and get removed
+            /// with the other unused actions.
+            if (!SparkBucketHasher::isSupported(column->result_type))
+                return nullptr;
+            columns.emplace_back(column);
+        }
+
+        DB::ActionsDAG::NodeRawConstPtrs bucket_id_args;
+        bucket_id_args.emplace_back(addColumnToActionsDAG(actions_dag, std::make_shared<DB::DataTypeInt32>(), *num_buckets));
+        bucket_id_args.emplace_back(
+            addColumnToActionsDAG(actions_dag, std::make_shared<DB::DataTypeUInt8>(), static_cast<UInt8>(hive_compatible)));
+        bucket_id_args.insert(bucket_id_args.end(), columns.begin(), columns.end());
+        return toFunctionNode(actions_dag, "sparkBucketId", bucket_id_args);
+    }
+};
+
+static FunctionParserRegister<FunctionParserPmod> register_pmod;
+}
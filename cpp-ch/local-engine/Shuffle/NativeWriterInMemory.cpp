@@ -20,9 +20,32 @@ using namespace DB;
 
 namespace local_engine
 {
-NativeWriterInMemory::NativeWriterInMemory()
+ChunkedWriteBuffer::ChunkedWriteBuffer(size_t chunk_size_) : WriteBuffer(nullptr, 0), chunk_size(chunk_size_), current(chunk_size_)
 {
-    write_buffer = std::make_unique<WriteBufferFromOwnString>();
+    set(current.data(), current.size());
+}
+
+void ChunkedWriteBuffer::nextImpl()
+{
+    if (!offset())
+        return;
+    finished_chunks.push_back({std::move(current), offset()});
+    current = Memory<>(chunk_size);
+    set(current.data(), current.size());
+}
+
+void ChunkedWriteBuffer::finalizeImpl()
+{
+    /// Unlike nextImpl, do not allocate a trailing chunk that would never be written.
+    if (offset())
+        finished_chunks.push_back({std::move(current), offset()});
+    bytes += offset();
+    set(nullptr, 0);
+}
+
+NativeWriterInMemory::NativeWriterInMemory(size_t chunk_size)
+{
+    write_buffer = std::make_unique<ChunkedWriteBuffer>(chunk_size);
 }
 void NativeWriterInMemory::write(Block & block)
 {
@@ -34,8 +57,10 @@ void NativeWriterInMemory::write(Block & block)
     }
     writer->write(block);
 }
-std::string & NativeWriterInMemory::collect()
+const std::vector<ChunkedWriteBuffer::Chunk> & NativeWriterInMemory::collect()
 {
-    return write_buffer->str();
+    if (!write_buffer->isFinalized())
+        write_buffer->finalize();
+    return write_buffer->chunks();
 }
 }
@@ -16,19 +16,49 @@
  */
 #pragma once
 #include <Formats/NativeWriter.h>
-#include <IO/WriteBufferFromString.h>
+#include <IO/BufferWithOwnMemory.h>
+#include <IO/WriteBuffer.h>
 
 namespace local_engine
 {
+/// Keeps the written data as a list of separately allocated chunks of at most chunk_size bytes, so the result is
+/// neither one huge contiguous allocation nor limited by the 2GB size of a Java byte array.
+class ChunkedWriteBuffer final : public DB::WriteBuffer
+{
+public:
+    struct Chunk
+    {
+        DB::Memory<> memory;
+        size_t size;
+    };
+
+    explicit ChunkedWriteBuffer(size_t chunk_size_);
+
+    /// Only valid after finalize().
+    const std::vector<Chunk> & chunks() const { return finished_chunks; }
+
+private:
+    void nextImpl() override;
+    void finalizeImpl() override;
+
+    const size_t chunk_size;
+    DB::Memory<> current;
+    std::vector<Chunk> finished_chunks;
+};
+
 class NativeWriterInMemory
 {
 public:
-    NativeWriterInMemory();
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 8 * 1024 * 1024;
+
+    explicit NativeWriterInMemory(size_t chunk_size = DEFAULT_CHUNK_SIZE);
     void write(DB::Block & block);
-    std::string & collect();
+    /// Finish writing and return the serialized blocks. No more blocks can be written afterwards.
+    const std::vector<ChunkedWriteBuffer::Chunk> & collect();
+    size_t size() const { return write_buffer->count(); }
 
 private:
-    std::unique_ptr<DB::WriteBufferFromOwnString> write_buffer;
+    std::unique_ptr<ChunkedWriteBuffer> write_buffer;
     //lazy init
     std::unique_ptr<DB::NativeWriter> writer;
 };
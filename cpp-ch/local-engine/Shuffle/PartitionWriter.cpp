@@ -148,6 +148,7 @@ size_t LocalPartitionWriter::evictPartitions()
         Stopwatch serialization_time_watch;
         for (size_t partition_id = 0; partition_id < partition_buffer.size(); ++partition_id)
         {
+            throwIfCancelled();
             auto & buffer = partition_buffer[partition_id];
 
             auto & block_buffer = partition_block_buffer[partition_id];
@@ -239,6 +240,7 @@ PartitionWriter::PartitionWriter(const SplitOptions & options, LoggerPtr logger_
     , partition_buffer(options.partition_num)
     , last_partition_id(options.partition_num - 1)
     , logger(logger_)
+    , cancellation_token(QueryContext::instance().currentCancellationTokenOrNull())
 {
     for (size_t partition_id = 0; partition_id < options.partition_num; ++partition_id)
     {
@@ -286,6 +288,7 @@ size_t MemorySortLocalPartitionWriter::evictPartitions()
         info.partition_spill_infos[cur_partition_id] = {0, 0};
         while (auto data = sorter.read())
         {
+            throwIfCancelled();
             Block serialized_block = sort_header.cloneWithColumns(data.detachColumns());
             const auto partitions = serialized_block.getByName(PARTITION_COLUMN_NAME).column;
             serialized_block.erase(PARTITION_COLUMN_NAME);
@@ -393,6 +396,7 @@ size_t MemorySortCelebornPartitionWriter::evictPartitions()
 
         while (auto data = sorter.read())
         {
+            throwIfCancelled();
             Block serialized_block = sort_header.cloneWithColumns(data.detachColumns());
             const auto partitions = serialized_block.getByName(PARTITION_COLUMN_NAME).column;
             serialized_block.erase(PARTITION_COLUMN_NAME);
@@ -98,6 +98,13 @@ protected:
 
     virtual bool supportsEvictSinglePartition() const { return false; }
 
+    /// Spilling stops between partitions or blocks once the task is cancelled.
+    void throwIfCancelled() const
+    {
+        if (cancellation_token)
+            cancellation_token->throwIfCancelled();
+    }
+
     virtual size_t evictSinglePartition(size_t partition_id)
     {
         throw DB::Exception(DB::ErrorCodes::NOT_IMPLEMENTED, "Evict single partition is not supported for {}", getName());
@@ -114,6 +121,7 @@ protected:
     SplitResult * split_result = nullptr;
     DB::Block output_header;
     LoggerPtr logger = nullptr;
+    CancellationTokenPtr cancellation_token;
     bool init = false;
 };
 
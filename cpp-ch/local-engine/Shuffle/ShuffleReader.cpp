@@ -93,14 +93,45 @@ ReadBufferFromJavaInputStream::~ReadBufferFromJavaInputStream()
     CLEAN_JNIENV
 }
 
-bool ReadBufferFromByteArray::nextImpl()
+ReadBufferFromByteArrays::ReadBufferFromByteArrays(const jobjectArray arrays_)
+    : DB::BufferWithOwnMemory<DB::ReadBuffer>(DB::DBMS_DEFAULT_BUFFER_SIZE), arrays(arrays_)
 {
-    if (read_pos >= array_size)
-        return false;
+    GET_JNIENV(env)
+    num_arrays = env->GetArrayLength(arrays);
+    CLEAN_JNIENV
+}
+
+ReadBufferFromByteArrays::~ReadBufferFromByteArrays()
+{
+    if (!current_array)
+        return;
+    GET_JNIENV(env)
+    env->DeleteLocalRef(current_array);
+    CLEAN_JNIENV
+}
 
+bool ReadBufferFromByteArrays::nextImpl()
+{
     GET_JNIENV(env)
-    const size_t read_size = std::min(internal_buffer.size(), array_size - read_pos);
-    env->GetByteArrayRegion(array, read_pos, read_size, reinterpret_cast<jbyte *>(internal_buffer.begin()));
+    while (read_pos >= current_size)
+    {
+        if (current_array)
+        {
+            env->DeleteLocalRef(current_array);
+            current_array = nullptr;
+        }
+        if (next_array >= num_arrays)
+        {
+            CLEAN_JNIENV
+            return false;
+        }
+        current_array = static_cast<jbyteArray>(env->GetObjectArrayElement(arrays, next_array++));
+        current_size = env->GetArrayLength(current_array);
+        read_pos = 0;
+    }
+
+    const size_t read_size = std::min(internal_buffer.size(), current_size - read_pos);
+    env->GetByteArrayRegion(current_array, read_pos, read_size, reinterpret_cast<jbyte *>(internal_buffer.begin()));
     working_buffer.resize(read_size);
     read_pos += read_size;
     CLEAN_JNIENV
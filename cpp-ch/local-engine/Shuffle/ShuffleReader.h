@@ -64,23 +64,23 @@ private:
     bool nextImpl() override;
 };
 
-class ReadBufferFromByteArray final : public DB::BufferWithOwnMemory<DB::ReadBuffer>
+/// Reads a Java byte[][] one array after another, e.g. the chunks of a broadcast relation, so the data is never
+/// limited by the 2GB size of a single Java array. The arrays are copied region by region into an own buffer.
+class ReadBufferFromByteArrays final : public DB::BufferWithOwnMemory<DB::ReadBuffer>
 {
 public:
-    ReadBufferFromByteArray(const jbyteArray array_, size_t array_size_)
-        : DB::BufferWithOwnMemory<DB::ReadBuffer>(std::min<size_t>(DB::DBMS_DEFAULT_BUFFER_SIZE, array_size_))
-        , array(array_)
-        , array_size(array_size_)
-        , read_pos(0)
-    {
-    }
+    explicit ReadBufferFromByteArrays(const jobjectArray arrays_);
+    ~ReadBufferFromByteArrays() override;
 
 private:
     bool nextImpl() override;
 
-    const jbyteArray array;
-    const size_t array_size;
-    size_t read_pos;
+    const jobjectArray arrays;
+    jsize num_arrays;
+    jsize next_array = 0;
+    jbyteArray current_array = nullptr;
+    size_t current_size = 0;
+    size_t read_pos = 0;
 };
 
 }
@@ -16,6 +16,9 @@
  */
 #include "SparkMergeTreeMeta.h"
 
+#include <DataTypes/DataTypeFixedString.h>
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <IO/ReadBufferFromString.h>
 #include <IO/ReadHelpers.h>
 #include <Parser/SubstraitParserUtils.h>
@@ -30,11 +33,35 @@
 #include <write_optimization.pb.h>
 #include <Poco/StringTokenizer.h>
 #include <Common/DebugUtils.h>
+#include <Common/GlutenConfig.h>
+#include <Common/quoteString.h>
 
 using namespace DB;
 using namespace local_engine;
 namespace
 {
+/// Longest FixedString which gets an automatic minmax index.
+constexpr size_t AUTO_MINMAX_INDEX_MAX_STRING_SIZE = 64;
+
+/// The expression of the automatic minmax index of the column, if the index pays off: per granule it keeps two values of
+/// bounded size. Integers, dates, decimals and short FixedStrings are kept as they are. Strings and floats are kept by
+/// sparkMinMaxKey, which cuts strings to a prefix and orders NaN as Spark does. Composite types get no index.
+std::optional<String> autoMinMaxIndexExpression(const NameAndTypePair & column)
+{
+    const auto nested = removeNullable(removeLowCardinality(column.type));
+    if (isString(nested) || isFloat32(nested) || isFloat64(nested))
+        return "sparkMinMaxKey(" + backQuoteIfNeed(column.name) + ")";
+    if (const auto * fixed_string = typeid_cast<const DataTypeFixedString *>(nested.get()))
+    {
+        if (fixed_string->getN() > AUTO_MINMAX_INDEX_MAX_STRING_SIZE)
+            return {};
+        return backQuoteIfNeed(column.name);
+    }
+    if (nested->isValueRepresentedByNumber())
+        return backQuoteIfNeed(column.name);
+    return {};
+}
+
 // set skip index for each column if specified
 void setSecondaryIndex(
     const DB::NamesAndTypesList & columns,
@@ -60,6 +87,7 @@ void setSecondaryIndex(
         for (const auto & token : tokenizer)
             set_index_cols.insert(token);
     }
+    const bool auto_minmax_index = MergeTreeConfig::loadFromContext(context).auto_minmax_index;
 
     std::stringstream ss;
     bool first = true;
@@ -73,6 +101,17 @@ void setSecondaryIndex(
                 first = false;
             ss << "_minmax_" << column.name << " " << column.name << " TYPE minmax GRANULARITY 1";
         }
+        else if (const auto expression = auto_minmax_index ? autoMinMaxIndexExpression(column) : std::nullopt)
+        {
+            if (!first)
+                ss << ", ";
+            else
+                first = false;
+            /// An index on a key gets its own name, so that it is never read as an index on the column itself.
+            const bool is_key = *expression != backQuoteIfNeed(column.name);
+            ss << backQuoteIfNeed((is_key ? "_minmax_key_" : "_minmax_") + column.name) << " " << *expression
+               << " TYPE minmax GRANULARITY 1";
+        }
 
         if (bf_index_cols.contains(column.name))
         {
@@ -18,11 +18,13 @@
 
 #include <Disks/ObjectStorages/CompactObjectStorageDiskTransaction.h>
 #include <Disks/SingleDiskVolume.h>
+#include <IO/SharedThreadPools.h>
 #include <Interpreters/MergeTreeTransaction.h>
 #include <Storages/MergeTree/DataPartStorageOnDiskFull.h>
 #include <Storages/MergeTree/MergeTreeSettings.h>
 #include <Storages/MergeTree/SparkMergeTreeSink.h>
 #include <Storages/MergeTree/checkDataPart.h>
+#include <Common/threadPoolCallbackRunner.h>
 
 namespace ProfileEvents
 {
@@ -195,16 +197,23 @@ void SparkStorageMergeTree::prefetchMetaDataFile(const std::unordered_set<std::s
 std::vector<MergeTreeDataPartPtr> SparkStorageMergeTree::loadDataPartsWithNames(const std::unordered_set<std::string> & parts)
 {
     Stopwatch watch;
-    prefetchMetaDataFile(parts);
-    std::vector<MergeTreeDataPartPtr> data_parts;
+    std::vector<MergeTreeDataPartPtr> data_parts(parts.size());
     const auto disk = getStoragePolicy()->getDisks().at(0);
+    /// Load the parts concurrently, as their metadata is read from remote storage one by one.
+    ThreadPoolCallbackRunnerLocal<void> runner(getActivePartsLoadingThreadPool().get(), "ActiveParts");
+    size_t i = 0;
     for (const auto & name : parts)
     {
-        const auto num = part_num.fetch_add(1);
-        MergeTreePartInfo part_info = {"all", num, num, 0};
-        auto res = loadDataPart(part_info, name, disk, MergeTreeDataPartState::Active);
-        data_parts.emplace_back(res.part);
+        runner(
+            [this, &name, &disk, &part = data_parts[i++]]
+            {
+                prefetchMetaDataFile({name});
+                const auto num = part_num.fetch_add(1);
+                MergeTreePartInfo part_info = {"all", num, num, 0};
+                part = loadDataPart(part_info, name, disk, MergeTreeDataPartState::Active).part;
+            });
     }
+    runner.waitForAllToFinishAndRethrowFirstError();
 
     watch.stop();
     LOG_DEBUG(log, "Loaded data parts ({} items) took {} microseconds", parts.size(), watch.elapsedMicroseconds());
@@ -530,6 +539,9 @@ SparkWriteStorageMergeTree::buildMergeTreeSettings(const ContextMutablePtr & con
     auto settings = std::make_unique<DB::MergeTreeSettings>();
 
     settings->set("allow_nullable_key", Field(true));
+    /// Parts are loaded when a scan first touches them, so leave their primary index to the first read that needs it.
+    /// Their marks are loaded on first use anyway.
+    settings->set("primary_key_lazy_load", Field(true));
     if (!config.storage_policy.empty())
         settings->set("storage_policy", Field(config.storage_policy));
 
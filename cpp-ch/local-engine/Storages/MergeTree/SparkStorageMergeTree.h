@@ -70,7 +70,8 @@ public:
     std::vector<DB::MergeTreeMutationStatus> getMutationsStatus() const override;
     bool scheduleDataProcessingJob(DB::BackgroundJobsAssignee & executor) override;
     std::map<std::string, DB::MutationCommands> getUnfinishedMutationCommands() const override;
-    std::vector<DB::MergeTreeDataPartPtr> loadDataPartsWithNames(const std::unordered_set<std::string> & parts);
+    /// Loads the parts concurrently and returns them in the order of parts, with nullptr for the ones that are broken.
+    virtual std::vector<DB::MergeTreeDataPartPtr> loadDataPartsWithNames(const std::unordered_set<std::string> & parts);
     void removePartFromMemory(const MergeTreeData::DataPart & part_to_detach);
     void prefetchPartDataFile(const std::unordered_set<std::string> & parts) const;
 
@@ -19,6 +19,12 @@
 #include <Storages/MergeTree/SparkMergeTreeMeta.h>
 #include <Storages/MergeTree/SparkStorageMergeTree.h>
 #include <Common/GlutenConfig.h>
+#include <Common/QueryContext.h>
+
+namespace DB::ErrorCodes
+{
+extern const int NO_SUCH_DATA_PART;
+}
 
 namespace local_engine
 {
@@ -77,47 +83,96 @@ SparkStorageMergeTreePtr StorageMergeTreeFactory::getStorage(
     return storage_map->get(table_name)->first;
 }
 
-DataPartsVector
-StorageMergeTreeFactory::getDataPartsByNames(const StorageID & id, const String & snapshot_id, const std::unordered_set<String> & part_name)
+std::shared_ptr<Poco::LRUCache<std::string, DataPartStorageHolderPtr>> StorageMergeTreeFactory::getDataPartCache(const String & table_name)
 {
-    DataPartsVector res;
-    auto table_name = getTableName(id, snapshot_id);
-    auto config = MergeTreeConfig::loadFromContext(QueryContext::globalContext());
-    std::lock_guard lock(datapart_mutex);
-    std::unordered_set<String> missing_names;
     if (!datapart_map->has(table_name)) [[unlikely]]
     {
+        auto config = MergeTreeConfig::loadFromContext(QueryContext::globalContext());
         auto cache = std::make_shared<Poco::LRUCache<std::string, DataPartStorageHolderPtr>>(config.table_part_metadata_cache_max_count);
         datapart_map->add(table_name, cache);
     }
+    return *datapart_map->get(table_name);
+}
+
+DataPartsVector
+StorageMergeTreeFactory::getDataPartsByNames(const StorageID & id, const String & snapshot_id, const std::unordered_set<String> & part_name)
+{
+    DataPartsVector res;
+    auto table_name = getTableName(id, snapshot_id);
 
-    // find the missing cache part name
-    for (const auto & name : part_name)
+    /// The parts that this call loads, and the parts that other calls are loading, which it waits for.
+    std::unordered_set<String> missing_names;
+    std::unordered_map<String, std::promise<DataPartPtr>> promises;
+    std::vector<std::shared_future<DataPartPtr>> loading;
     {
-        if (!(*datapart_map->get(table_name))->has(name))
-        {
-            missing_names.emplace(name);
-        }
-        else
+        std::lock_guard lock(datapart_mutex);
+        auto cache = getDataPartCache(table_name);
+        for (const auto & name : part_name)
         {
-            res.emplace_back((*datapart_map->get(table_name))->get(name)->get()->dataPart());
+            if (auto holder = cache->get(name); !holder.isNull())
+                res.emplace_back((*holder)->dataPart());
+            else if (auto it = loading_parts.find({table_name, name}); it != loading_parts.end())
+                loading.emplace_back(it->second);
+            else
+            {
+                missing_names.emplace(name);
+                loading_parts.emplace(std::make_pair(table_name, name), promises[name].get_future().share());
+            }
         }
     }
 
     if (!missing_names.empty())
     {
+        /// Load the parts without holding datapart_mutex, so that the loads of other tables and parts aren't blocked.
+        std::vector<DataPartPtr> missing_parts;
         SparkStorageMergeTreePtr storage_merge_tree;
+        try
+        {
+            {
+                std::lock_guard storage_lock(storage_map_mutex);
+                storage_merge_tree = storage_map->get(table_name)->first;
+            }
+            missing_parts = storage_merge_tree->loadDataPartsWithNames(missing_names);
+        }
+        catch (...)
         {
-            std::lock_guard storage_lock(storage_map_mutex);
-            storage_merge_tree = storage_map->get(table_name)->first;
+            std::lock_guard lock(datapart_mutex);
+            for (const auto & name : missing_names)
+                loading_parts.erase({table_name, name});
+            for (auto & [_, promise] : promises)
+                promise.set_exception(std::current_exception());
+            throw;
         }
-        auto missing_parts = storage_merge_tree->loadDataPartsWithNames(missing_names);
-        for (auto & part : missing_parts)
+
+        std::lock_guard lock(datapart_mutex);
+        auto cache = getDataPartCache(table_name);
+        /// loadDataPartsWithNames returns the parts in the order of missing_names.
+        std::optional<String> failed_part;
+        size_t i = 0;
+        for (const auto & name : missing_names)
         {
+            loading_parts.erase({table_name, name});
+            const auto & part = missing_parts[i++];
+            auto & promise = promises.at(name);
+            if (!part)
+            {
+                failed_part = name;
+                promise.set_exception(std::make_exception_ptr(
+                    Exception(ErrorCodes::NO_SUCH_DATA_PART, "Failed to load data part {} of {}", name, table_name)));
+                continue;
+            }
             res.emplace_back(part);
-            (*datapart_map->get(table_name))->add(part->name, std::make_shared<DataPartStorageHolder>(part, storage_merge_tree));
+            cache->add(part->name, std::make_shared<DataPartStorageHolder>(part, storage_merge_tree));
+            promise.set_value(part);
         }
+        if (failed_part)
+            throw Exception(ErrorCodes::NO_SUCH_DATA_PART, "Failed to load data part {} of {}", *failed_part, table_name);
     }
+
+    /// A cancelled task stops waiting for the parts other tasks load.
+    const auto cancellation_token = QueryContext::instance().currentCancellationTokenOrNull();
+    for (auto & future : loading)
+        res.emplace_back(cancellation_token ? cancellation_token->get(future) : future.get());
     return res;
 }
 // will be inited in native init phase
@@ -125,5 +180,6 @@ std::unique_ptr<storage_map_cache> StorageMergeTreeFactory::storage_map = nullpt
 std::unique_ptr<datapart_map_cache> StorageMergeTreeFactory::datapart_map = nullptr;
 std::recursive_mutex StorageMergeTreeFactory::storage_map_mutex;
 std::recursive_mutex StorageMergeTreeFactory::datapart_mutex;
+std::map<std::pair<String, String>, std::shared_future<DataPartPtr>> StorageMergeTreeFactory::loading_parts;
 
 }
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 #pragma once
+#include <future>
+#include <map>
 #include <Interpreters/MergeTreeTransaction.h>
 #include <Storages/MergeTree/SparkMergeTreeMeta.h>
 #include <Storages/MergeTree/SparkStorageMergeTree.h>
@@ -67,6 +69,7 @@ public:
     static SparkStorageMergeTreePtr
     getStorage(const DB::StorageID& id, const String & snapshot_id, const MergeTreeTable & merge_tree_table,
         const std::function<SparkStorageMergeTreePtr()> & creator);
+    /// Returns the parts of the table, loading the ones that are not cached. Concurrent calls load each part only once.
     static DB::DataPartsVector getDataPartsByNames(const DB::StorageID & id, const String & snapshot_id, const std::unordered_set<String> & part_name);
     static void init_cache_map()
     {
@@ -104,6 +107,10 @@ private:
 
     static std::recursive_mutex storage_map_mutex;
     static std::recursive_mutex datapart_mutex;
+    /// The parts being loaded by (table name, part name), guarded by datapart_mutex.
+    static std::map<std::pair<String, String>, std::shared_future<DB::DataPartPtr>> loading_parts;
+
+    static std::shared_ptr<Poco::LRUCache<std::string, DataPartStorageHolderPtr>> getDataPartCache(const String & table_name);
 };
 
 }
@@ -22,6 +22,8 @@
 #include <Storages/MergeTree/KeyCondition.h>
 #include <Storages/MergeTree/RPNBuilder.h>
 #include <Storages/Parquet/ParquetConverter.h>
+#include <parquet/column_page.h>
+#include <parquet/encoding.h>
 #include <parquet/schema.h>
 #include <parquet/statistics.h>
 #include <Common/logger_useful.h>
@@ -716,6 +718,122 @@ ColumnIndexPtr ColumnIndex::create(
     throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Unsupported UNDEFINED BoundaryOrder: {}", order);
 }
 
+template <typename DType>
+class TypedColumnDictionary final : public ColumnDictionary
+{
+    using T = typename DType::c_type;
+
+    const parquet::ColumnDescriptor * descr_;
+    std::shared_ptr<parquet::TypedComparator<DType>> comparator_;
+    /// The decoded byte arrays point into it.
+    std::string data_;
+    std::vector<T> values_;
+
+    template <typename Predict>
+    std::vector<bool> test(Predict predict) const
+    {
+        std::vector<bool> result(values_.size());
+        for (size_t i = 0; i < values_.size(); ++i)
+            result[i] = predict(values_[i]);
+        return result;
+    }
+
+    std::vector<bool> in(const DB::ColumnPtr & column) const
+    {
+        std::shared_ptr<ParquetConverter<DType>> converter = ParquetConverter<DType>::Make(column, *descr_);
+        const auto * set = converter->getBatch(0, column->size());
+        const auto less = [&](const T & a, const T & b) { return comparator_->Compare(a, b); };
+        std::vector<T> sorted(set, set + column->size());
+        std::ranges::sort(sorted, less);
+        return test([&](const T & x) { return std::ranges::binary_search(sorted, x, less); });
+    }
+
+public:
+    TypedColumnDictionary(const parquet::ColumnDescriptor * descr, const parquet::DictionaryPage & page)
+        : descr_(descr)
+        , comparator_(parquet::MakeComparator<DType>(descr))
+        , data_(reinterpret_cast<const char *>(page.data()), page.size())
+        , values_(page.num_values())
+    {
+        auto decoder = parquet::MakeTypedDecoder<DType>(parquet::Encoding::PLAIN, descr);
+        decoder->SetData(page.num_values(), reinterpret_cast<const uint8_t *>(data_.data()), static_cast<int>(data_.size()));
+        const int decoded = decoder->Decode(values_.data(), page.num_values());
+        values_.resize(decoded);
+    }
+
+    size_t size() const override { return values_.size(); }
+
+    std::optional<std::vector<bool>> matches(const ColumnIndexFilter::RPNElement & element) const override
+    {
+        using RPNElement = ColumnIndexFilter::RPNElement;
+        if (element.function == RPNElement::FUNCTION_IN)
+        {
+            if (!element.column || element.column->isNullable())
+                return {};
+            return in(element.column);
+        }
+
+        /// A null test depends on the definition levels, which the dictionary doesn't have.
+        if (element.value.isNull())
+            return {};
+
+        /// Owns the buffer of a fixed length byte array.
+        ToParquet<DType> to_parquet;
+        const T value{to_parquet.as(element.value, *descr_)};
+        const auto & comparator = *comparator_;
+        switch (element.function)
+        {
+            case RPNElement::FUNCTION_EQUALS:
+                return test([&](const T & x) { return !comparator.Compare(x, value) && !comparator.Compare(value, x); });
+            case RPNElement::FUNCTION_NOT_EQUALS:
+                return test([&](const T & x) { return comparator.Compare(x, value) || comparator.Compare(value, x); });
+            case RPNElement::FUNCTION_LESS:
+                return test([&](const T & x) { return comparator.Compare(x, value); });
+            case RPNElement::FUNCTION_GREATER:
+                return test([&](const T & x) { return comparator.Compare(value, x); });
+            case RPNElement::FUNCTION_LESS_OR_EQUALS:
+                return test([&](const T & x) { return !comparator.Compare(value, x); });
+            case RPNElement::FUNCTION_GREATER_OR_EQUALS:
+                return test([&](const T & x) { return !comparator.Compare(x, value); });
+            default:
+                return {};
+        }
+    }
+};
+
+bool ColumnDictionary::supports(const parquet::ColumnDescriptor * descr)
+{
+    switch (descr->physical_type())
+    {
+        case parquet::Type::INT32:
+        case parquet::Type::INT64:
+        case parquet::Type::BYTE_ARRAY:
+        case parquet::Type::FIXED_LEN_BYTE_ARRAY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+ColumnDictionaryPtr ColumnDictionary::create(const parquet::ColumnDescriptor * descr, const parquet::DictionaryPage & page)
+{
+    switch (descr->physical_type())
+    {
+        case parquet::Type::INT32:
+            return std::make_unique<TypedColumnDictionary<parquet::Int32Type>>(descr, page);
+        case parquet::Type::INT64:
+            return std::make_unique<TypedColumnDictionary<parquet::Int64Type>>(descr, page);
+        case parquet::Type::BYTE_ARRAY:
+            return std::make_unique<TypedColumnDictionary<parquet::ByteArrayType>>(descr, page);
+        case parquet::Type::FIXED_LEN_BYTE_ARRAY:
+            return std::make_unique<TypedColumnDictionary<parquet::FLBAType>>(descr, page);
+        default:
+            break;
+    }
+    throw DB::Exception(
+        DB::ErrorCodes::LOGICAL_ERROR, "Unsupported physical type {} of dictionary", TypeToString(descr->physical_type()));
+}
+
 ///
 const ColumnIndexFilter::AtomMap ColumnIndexFilter::atom_map{
     {"notEquals",
@@ -987,5 +1105,90 @@ RowRanges ColumnIndexFilter::calculateRowRanges(const ColumnIndexStore & index_s
 
     return rpn_stack[0];
 }
+
+bool ColumnIndexFilter::mayMatchDictionaries(const ColumnDictionaryStore & dictionary_store) const
+{
+    std::vector<bool> rpn_stack;
+
+    auto CALL_ATOM = [&rpn_stack, &dictionary_store](const RPNElement & element)
+    {
+        const auto it = dictionary_store.find(element.columnName);
+        if (it == dictionary_store.end())
+        {
+            rpn_stack.push_back(true);
+            return;
+        }
+        try
+        {
+            const auto matched = it->second->matches(element);
+            rpn_stack.push_back(!matched || std::ranges::find(*matched, true) != matched->end());
+        }
+        catch (const DB::Exception & e)
+        {
+            /// E.g. the literal doesn't convert to the physical type of the column.
+            LOG_DEBUG(
+                &Poco::Logger::get("ColumnIndexFilter"), "Skip dictionary filtering on column {}: {}", element.columnName, e.message());
+            rpn_stack.push_back(true);
+        }
+    };
+
+    for (const auto & element : rpn_)
+    {
+        switch (element.function)
+        {
+            case RPNElement::FUNCTION_EQUALS:
+            case RPNElement::FUNCTION_NOT_EQUALS:
+            case RPNElement::FUNCTION_LESS:
+            case RPNElement::FUNCTION_GREATER:
+            case RPNElement::FUNCTION_LESS_OR_EQUALS:
+            case RPNElement::FUNCTION_GREATER_OR_EQUALS:
+            case RPNElement::FUNCTION_IN:
+                CALL_ATOM(element);
+                break;
+            case RPNElement::FUNCTION_NOT_IN:
+            case RPNElement::FUNCTION_UNKNOWN:
+            case RPNElement::ALWAYS_TRUE:
+                rpn_stack.push_back(true);
+                break;
+            case RPNElement::ALWAYS_FALSE:
+                rpn_stack.push_back(false);
+                break;
+            case RPNElement::FUNCTION_NOT:
+                /// Rows with null values match neither an atom nor its negation, so a row group whose dictionary
+                /// entries all satisfy an atom may still match its negation.
+                assert(!rpn_stack.empty());
+                rpn_stack.back() = true;
+                break;
+            case RPNElement::FUNCTION_AND: {
+                assert(rpn_stack.size() >= 2);
+                const bool arg = rpn_stack.back();
+                rpn_stack.pop_back();
+                rpn_stack.back() = rpn_stack.back() && arg;
+                break;
+            }
+            case RPNElement::FUNCTION_OR: {
+                assert(rpn_stack.size() >= 2);
+                const bool arg = rpn_stack.back();
+                rpn_stack.pop_back();
+                rpn_stack.back() = rpn_stack.back() || arg;
+                break;
+            }
+        }
+    }
+
+    if (rpn_stack.size() != 1)
+        throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Unexpected stack size in ColumnIndexFilter::mayMatchDictionaries");
+
+    return rpn_stack[0];
+}
+
+std::unordered_set<std::string> ColumnIndexFilter::columnNames() const
+{
+    std::unordered_set<std::string> names;
+    for (const auto & element : rpn_)
+        if (!element.columnName.empty())
+            names.insert(element.columnName);
+    return names;
+}
 }
 #endif //USE_PARQUET
\ No newline at end of file
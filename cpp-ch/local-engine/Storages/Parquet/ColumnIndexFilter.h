@@ -19,6 +19,8 @@
 
 #if USE_PARQUET
 #include <memory>
+#include <optional>
+#include <unordered_set>
 #include <Columns/IColumn.h>
 #include <Core/Field.h>
 #include <Interpreters/ActionsDAG.h>
@@ -32,14 +34,22 @@ class Context;
 using ContextPtr = std::shared_ptr<const Context>;
 }
 
+namespace parquet
+{
+class DictionaryPage;
+}
+
 namespace local_engine
 {
 class ColumnIndexFilter;
 class ColumnIndex;
+class ColumnDictionary;
 using ColumnIndexPtr = std::unique_ptr<ColumnIndex>;
 using PageIndexs = std::vector<Int32>;
 using ColumnIndexStore = std::unordered_map<std::string, ColumnIndexPtr>;
 using ColumnIndexFilterPtr = std::shared_ptr<ColumnIndexFilter>;
+using ColumnDictionaryPtr = std::unique_ptr<ColumnDictionary>;
+using ColumnDictionaryStore = std::unordered_map<std::string, ColumnDictionaryPtr>;
 
 struct PageIndexsBuilder
 {
@@ -204,6 +214,36 @@ private:
 
 public:
     RowRanges calculateRowRanges(const ColumnIndexStore & index_store, size_t rowgroup_count) const;
+
+    /// Returns false if no row of a row group can match, given the dictionaries of its fully dictionary-encoded
+    /// columns. The atoms on the other columns may match any row.
+    bool mayMatchDictionaries(const ColumnDictionaryStore & dictionary_store) const;
+
+    /// The names of the columns the atoms refer to.
+    std::unordered_set<std::string> columnNames() const;
+};
+
+/**
+ * The dictionary page of a column chunk whose data pages are all dictionary encoded, so that every non-null value of
+ * the chunk is one of its entries. An atom is evaluated once per entry instead of once per row, and a row group where
+ * no entry matches is skipped without reading its data pages.
+ */
+class ColumnDictionary
+{
+public:
+    virtual ~ColumnDictionary() = default;
+
+    virtual size_t size() const = 0;
+
+    /// Returns whether each entry satisfies the atom, or nullopt if the atom can't be evaluated on the entries, e.g. a
+    /// null test.
+    virtual std::optional<std::vector<bool>> matches(const ColumnIndexFilter::RPNElement & element) const = 0;
+
+    /// Whether atoms on the column are evaluated on its dictionaries. Floating point columns are not, since NaN equals
+    /// NaN in Spark but not in the parquet comparators.
+    static bool supports(const parquet::ColumnDescriptor * descr);
+
+    static ColumnDictionaryPtr create(const parquet::ColumnDescriptor * descr, const parquet::DictionaryPage & page);
 };
 }
 #endif
@@ -196,7 +196,7 @@ bool VectorizedParquetRecordReader::initialize(
     /// column pruning
     DB::ArrowFieldIndexUtil field_util(
         format_settings_.parquet.case_insensitive_column_matching, format_settings_.parquet.allow_missing_columns);
-    auto index_mapping = field_util.findRequiredIndices(header, schema, *metadata);
+    auto index_mapping = field_util.findRequiredIndices(header, schema, file_metadata);
 
     std::vector<Int32> column_indices;
     for (const auto & [clickhouse_header_index, parquet_indexes] : index_mapping)
@@ -279,7 +279,7 @@ std::optional<ColumnChunkPageRead> PageIterator::nextChunkWithRowRange()
         const auto rg = reader_ext_->rowGroup(row_group_index);
         const auto rg_count = rg->num_rows();
 
-        if (rg_count == 0)
+        if (rg_count == 0 || reader_ext_->canSkipRowGroupByDictionary(row_group_index))
         {
             row_groups_.pop_front();
             continue;
@@ -311,6 +311,62 @@ std::optional<ColumnChunkPageRead> PageIterator::nextChunkWithRowRange()
     return {};
 }
 
+bool ParquetFileReaderExt::canSkipRowGroupByDictionary(const Int32 row_group)
+{
+    if (!column_index_filter_ || !format_settings_.parquet.filter_push_down)
+        return false;
+    if (!row_group_dictionary_skips_.contains(row_group))
+    {
+        const ColumnDictionaryStore dictionary_store = readColumnDictionaries(row_group);
+        row_group_dictionary_skips_[row_group] = !dictionary_store.empty() && !column_index_filter_->mayMatchDictionaries(dictionary_store);
+    }
+    return row_group_dictionary_skips_[row_group];
+}
+
+ColumnDictionaryStore ParquetFileReaderExt::readColumnDictionaries(const Int32 row_group) const
+{
+    const auto file_metadata = file_reader_->metadata();
+    const auto rg = rowGroup(row_group);
+    const auto filter_columns = column_index_filter_->columnNames();
+    const bool always_compressed
+        = file_metadata->writer_version().VersionLt(parquet::ApplicationVersion::PARQUET_CPP_10353_FIXED_VERSION());
+
+    ColumnDictionaryStore dictionary_store;
+    for (auto const column_index : column_indices_)
+    {
+        const auto * col_desc = rg->schema()->Column(column_index);
+        const auto column_name = lowerColumnNameIfNeed(col_desc->name(), format_settings_);
+        if (!filter_columns.contains(column_name) || !ColumnDictionary::supports(col_desc))
+            continue;
+
+        /// A chunk whose writer fell back to plain encoding has values outside of the dictionary.
+        const auto column_metadata = rg->ColumnChunk(column_index);
+        const auto & encoding_stats = column_metadata->encoding_stats();
+        const bool fully_dictionary_encoded = column_metadata->has_dictionary_page() && !encoding_stats.empty()
+            && std::ranges::all_of(
+                encoding_stats,
+                [](const parquet::PageEncodingStats & stats)
+                {
+                    return stats.page_type == parquet::PageType::DICTIONARY_PAGE
+                        || stats.encoding == parquet::Encoding::PLAIN_DICTIONARY || stats.encoding == parquet::Encoding::RLE_DICTIONARY;
+                });
+        const int64_t dictionary_offset = column_metadata->dictionary_page_offset();
+        const int64_t data_offset = column_metadata->data_page_offset();
+        if (!fully_dictionary_encoded || dictionary_offset <= 0 || dictionary_offset >= data_offset || data_offset > source_size_)
+            continue;
+
+        const parquet::ReaderProperties properties;
+        const auto input_stream = getStream(*source_, {arrow::io::ReadRange{dictionary_offset, data_offset - dictionary_offset}});
+        const auto page_reader = parquet::PageReader::Open(
+            input_stream, column_metadata->num_values(), column_metadata->compression(), properties, always_compressed);
+        const auto page = page_reader->NextPage();
+        if (!page || page->type() != parquet::PageType::DICTIONARY_PAGE)
+            continue;
+        dictionary_store[column_name] = ColumnDictionary::create(col_desc, static_cast<const parquet::DictionaryPage &>(*page));
+    }
+    return dictionary_store;
+}
+
 ColumnChunkPageRead ParquetFileReaderExt::readColumnChunkPageBase(
     const parquet::RowGroupMetaData & rg, const Int32 column_index, const BuildRead & build_read) const
 {
@@ -389,7 +445,16 @@ DB::Chunk VectorizedParquetBlockInputFormat::read()
         const auto arrow_file = DB::asArrowFile(*in, record_reader_.format_settings_, is_stopped, "Parquet", PARQUET_MAGIC_BYTES);
         if (is_stopped != 0)
             return {};
-        if (!record_reader_.initialize(getPort().getHeader(), arrow_file, column_index_filter_))
+        /// ParquetFileReader takes mutable metadata, while file_metadata_ may be shared with other readers through
+        /// FileFooterCache, so it gets a copy, which is still much cheaper than reading and parsing the footer again.
+        std::shared_ptr<parquet::FileMetaData> metadata;
+        if (file_metadata_)
+        {
+            std::vector<int> all_row_groups(file_metadata_->num_row_groups());
+            std::iota(all_row_groups.begin(), all_row_groups.end(), 0);
+            metadata = file_metadata_->Subset(all_row_groups);
+        }
+        if (!record_reader_.initialize(getPort().getHeader(), arrow_file, column_index_filter_, metadata))
             return {};
     }
     return record_reader_.nextBatch();
@@ -117,6 +117,7 @@ class ParquetFileReaderExt
 {
     using RowRangesMap = absl::flat_hash_map<Int32, std::unique_ptr<RowRanges>>;
     using ColumnIndexStoreMap = absl::flat_hash_map<Int32, std::unique_ptr<ColumnIndexStore>>;
+    using DictionarySkipMap = absl::flat_hash_map<Int32, bool>;
     friend class PageIterator;
     std::shared_ptr<::arrow::io::RandomAccessFile> source_;
     int64_t source_size_;
@@ -124,6 +125,7 @@ class ParquetFileReaderExt
     ColumnIndexFilterPtr column_index_filter_;
     RowRangesMap row_group_row_ranges_;
     ColumnIndexStoreMap row_group_column_index_stores_;
+    DictionarySkipMap row_group_dictionary_skips_;
     const DB::FormatSettings & format_settings_;
 
 protected:
@@ -131,6 +133,11 @@ protected:
     const RowRanges & getRowRanges(Int32 row_group);
     const ColumnIndexStore & getColumnIndexStore(Int32 row_group);
 
+    /// Whether no row of the row group matches the filter, judging by the dictionaries of the filter columns.
+    bool canSkipRowGroupByDictionary(Int32 row_group);
+    /// Reads the dictionary pages of the filter columns whose chunks are entirely dictionary encoded.
+    ColumnDictionaryStore readColumnDictionaries(Int32 row_group) const;
+
     bool canPruningPage(const Int32 row_group) const { return column_index_filter_ && rowGroupPageIndexReader(row_group) != nullptr; }
     std::unique_ptr<RowRanges> calculateRowRanges(const ColumnIndexStore & index_store, const size_t rowgroup_count) const
     {
@@ -232,6 +239,7 @@ class VectorizedParquetBlockInputFormat final : public DB::IInputFormat
     std::atomic<int> is_stopped{0};
     VectorizedParquetRecordReader record_reader_;
     ColumnIndexFilterPtr column_index_filter_;
+    std::shared_ptr<const parquet::FileMetaData> file_metadata_;
 
 protected:
     void onCancel() noexcept override { is_stopped = 1; }
@@ -239,6 +247,8 @@ protected:
 public:
     VectorizedParquetBlockInputFormat(DB::ReadBuffer & in_, const DB::Block & header_, const DB::FormatSettings & format_settings);
     void setColumnIndexFilter(const ColumnIndexFilterPtr & column_index_filter) { column_index_filter_ = column_index_filter; }
+    /// The already parsed metadata of the file, e.g. from FileFooterCache, so that the footer isn't read again.
+    void setFileMetaData(const std::shared_ptr<const parquet::FileMetaData> & file_metadata) { file_metadata_ = file_metadata; }
     String getName() const override { return "VectorizedParquetBlockInputFormat"; }
     void resetParser() override;
 
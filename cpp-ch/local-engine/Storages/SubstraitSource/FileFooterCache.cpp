@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FileFooterCache.h"
+
+#include <Common/GlutenConfig.h>
+#include <Common/SipHash.h>
+#include <Common/logger_useful.h>
+
+namespace local_engine
+{
+
+FileFooterCache & FileFooterCache::instance()
+{
+    static FileFooterCache cache;
+    return cache;
+}
+
+void FileFooterCache::initialize(const DB::ContextPtr & context)
+{
+    auto config = FileFooterCacheConfig::loadFromContext(context);
+    auto & cache = instance();
+    cache.clear();
+    cache.max_bytes = config.file_footer_cache_max_bytes;
+    LOG_INFO(getLogger("FileFooterCache"), "Initialize file footer cache with {} bytes.", config.file_footer_cache_max_bytes);
+}
+
+std::optional<FileFooterCache::Key> FileFooterCache::keyOf(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info)
+{
+    if (!file_info.has_properties() || file_info.properties().filesize() <= 0 || file_info.properties().modificationtime() <= 0)
+        return {};
+    return Key{file_info.uri_file(), static_cast<UInt64>(file_info.properties().filesize()), file_info.properties().modificationtime()};
+}
+
+size_t FileFooterCache::KeyHash::operator()(const TypedKey & typed_key) const
+{
+    SipHash hash;
+    hash.update(typed_key.key.path);
+    hash.update(typed_key.key.size);
+    hash.update(typed_key.key.modification_time);
+    hash.update(typed_key.type.hash_code());
+    return hash.get64();
+}
+
+std::shared_ptr<const void> FileFooterCache::get(const Key & key, std::type_index type)
+{
+    std::lock_guard lock(mutex);
+    auto it = index.find(TypedKey{key, type});
+    if (it == index.end())
+    {
+        ++misses;
+        LOG_DEBUG(
+            getLogger("FileFooterCache"),
+            "Footer of {} is not cached, hits: {}, misses: {}, evictions: {}, entries: {}, bytes: {}.",
+            key.path,
+            hits.load(),
+            misses.load(),
+            evictions.load(),
+            entries.size(),
+            bytes);
+        return nullptr;
+    }
+    ++hits;
+    LOG_TRACE(getLogger("FileFooterCache"), "Footer of {} is cached, hits: {}, misses: {}.", key.path, hits.load(), misses.load());
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->footer;
+}
+
+void FileFooterCache::set(const Key & key, std::type_index type, std::shared_ptr<const void> footer, size_t footer_bytes)
+{
+    if (footer_bytes > max_bytes)
+        return;
+
+    const TypedKey typed_key{key, type};
+    std::lock_guard lock(mutex);
+    if (auto it = index.find(typed_key); it != index.end())
+    {
+        bytes -= it->second->bytes;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    while (!entries.empty() && bytes + footer_bytes > max_bytes)
+    {
+        const auto & victim = entries.back();
+        bytes -= victim.bytes;
+        index.erase(victim.key);
+        entries.pop_back();
+        ++evictions;
+    }
+    entries.push_front(Entry{typed_key, std::move(footer), footer_bytes});
+    index.emplace(typed_key, entries.begin());
+    bytes += footer_bytes;
+}
+
+FileFooterCache::Stats FileFooterCache::getStats() const
+{
+    std::lock_guard lock(mutex);
+    return Stats{hits, misses, evictions, entries.size(), bytes};
+}
+
+void FileFooterCache::clear()
+{
+    std::lock_guard lock(mutex);
+    entries.clear();
+    index.clear();
+    bytes = 0;
+}
+
+}
@@ -0,0 +1,134 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <typeindex>
+#include <unordered_map>
+#include <Interpreters/Context_fwd.h>
+#include <base/types.h>
+#include <substrait/algebra.pb.h>
+
+namespace local_engine
+{
+
+/// A process-wide LRU cache of the parsed footers of Parquet and ORC files, i.e. parquet::FileMetaData and the stripe
+/// information of ORC files. Spark splits a large file into many partitions, and every split used to fetch and parse
+/// the same footer again, once for split selection and once more for its row count, which is slow on object storage.
+///
+/// Entries are keyed by path, size and modification time, so a rewritten file never hits a stale footer, and files
+/// whose size or modification time is unknown are not cached. Footers of different types are kept apart, so a file
+/// read as both Parquet and ORC never returns the footer of the other format. The cache is bounded by the estimated
+/// bytes of its entries and evicts the least recently used ones. Misses are logged at debug level and hits at trace
+/// level, together with the counters of getStats().
+class FileFooterCache
+{
+public:
+    struct Key
+    {
+        String path;
+        UInt64 size;
+        Int64 modification_time;
+
+        bool operator==(const Key & other) const = default;
+    };
+
+    struct Stats
+    {
+        UInt64 hits = 0;
+        UInt64 misses = 0;
+        UInt64 evictions = 0;
+        UInt64 entries = 0;
+        UInt64 bytes = 0;
+    };
+
+    /// A footer and its estimated size in bytes.
+    template <typename T>
+    using Loaded = std::pair<std::shared_ptr<const T>, size_t>;
+
+    explicit FileFooterCache(size_t max_bytes_ = 0) : max_bytes(max_bytes_) { }
+
+    static FileFooterCache & instance();
+
+    /// Applies file_footer_cache_max_bytes and drops all entries.
+    static void initialize(const DB::ContextPtr & context);
+
+    /// Returns the cache key of the file, or nullopt if the file can't be validated against a cached footer.
+    static std::optional<Key> keyOf(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info);
+
+    /// Returns the cached footer of type T of the file, or loads and caches it. Concurrent misses on the same file may
+    /// load it more than once, and the last one wins.
+    template <typename T>
+    std::shared_ptr<const T> getOrLoad(const std::optional<Key> & key, const std::function<Loaded<T>()> & load)
+    {
+        if (!key || !max_bytes)
+            return load().first;
+        const std::type_index type(typeid(T));
+        if (auto cached = get(*key, type))
+            return std::static_pointer_cast<const T>(cached);
+        auto [footer, bytes] = load();
+        set(*key, type, footer, bytes);
+        return footer;
+    }
+
+    Stats getStats() const;
+
+    void clear();
+
+private:
+    /// Key and the type of the footer.
+    struct TypedKey
+    {
+        Key key;
+        std::type_index type;
+
+        bool operator==(const TypedKey & other) const = default;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const TypedKey & key) const;
+    };
+
+    struct Entry
+    {
+        TypedKey key;
+        std::shared_ptr<const void> footer;
+        size_t bytes;
+    };
+
+    std::shared_ptr<const void> get(const Key & key, std::type_index type);
+    void set(const Key & key, std::type_index type, std::shared_ptr<const void> footer, size_t bytes);
+
+    mutable std::mutex mutex;
+    std::atomic<size_t> max_bytes = 0;
+    size_t bytes = 0;
+    /// Most recently used first.
+    std::list<Entry> entries;
+    std::unordered_map<TypedKey, std::list<Entry>::iterator, KeyHash> index;
+
+    std::atomic<UInt64> hits = 0;
+    std::atomic<UInt64> misses = 0;
+    std::atomic<UInt64> evictions = 0;
+};
+
+}
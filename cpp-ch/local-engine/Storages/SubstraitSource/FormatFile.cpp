@@ -22,6 +22,7 @@
 #include <boost/algorithm/string/case_conv.hpp>
 #include <Common/GlutenConfig.h>
 #include <Common/GlutenStringUtils.h>
+#include <Common/SipHash.h>
 #include <Common/logger_useful.h>
 
 
@@ -47,6 +48,21 @@ extern const int NOT_IMPLEMENTED;
 }
 namespace local_engine
 {
+bool BlockSample::chooses(const String & file, size_t block) const
+{
+    if (lower_bound <= 0.0 && upper_bound >= 1.0)
+        return true;
+    if (lower_bound >= upper_bound)
+        return false;
+    SipHash hash;
+    hash.update(seed);
+    hash.update(file);
+    hash.update(block);
+    /// The top 53 bits of the hash make a uniform double in [0, 1).
+    const double value = static_cast<double>(hash.get64() >> 11) * 0x1.0p-53;
+    return lower_bound <= value && value < upper_bound;
+}
+
 FormatFile::FormatFile(
     DB::ContextPtr context_,
     const substrait::ReadRel::LocalFiles::FileOrFiles & file_info_,
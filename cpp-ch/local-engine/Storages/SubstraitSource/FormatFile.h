@@ -16,6 +16,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -38,6 +39,28 @@ extern const int NOT_IMPLEMENTED;
 
 namespace local_engine
 {
+/// Bernoulli sampling by block: each block of a file (e.g. a parquet row group) is chosen if a hash of it falls within
+/// [lower_bound, upper_bound), so the blocks which are not chosen are never read. Samples with the same seed and
+/// adjacent ranges, as those of `Dataset.randomSplit`, choose disjoint blocks.
+struct BlockSample
+{
+    double lower_bound = 0.0;
+    double upper_bound = 1.0;
+    UInt64 seed = 0;
+
+    /// The same seed always chooses the same blocks of a file.
+    bool chooses(const String & file, size_t block) const;
+};
+
+/// Counters of a scan, shared by the files it reads and reported with the metrics of its SubstraitFileSourceStep.
+struct FileScanStats
+{
+    /// Stripes of ORC files within the splits of the scan, and those pruned by their statistics.
+    std::atomic<size_t> total_stripes = 0;
+    std::atomic<size_t> pruned_stripes = 0;
+};
+using FileScanStatsPtr = std::shared_ptr<FileScanStats>;
+
 class FormatFile
 {
 public:
@@ -61,6 +84,18 @@ public:
     /// If this file doesn't support the split feacture, only the task with offset 0 will generate data.
     virtual bool supportSplit() const { return false; }
 
+    /// The filter of the scan, which the format may use to skip parts of the file before createInputFormat reads it.
+    void setKeyCondition(const std::shared_ptr<const DB::KeyCondition> & key_condition_) { key_condition = key_condition_; }
+
+    void setScanStats(const FileScanStatsPtr & scan_stats_) { scan_stats = scan_stats_; }
+
+    /// Whether the format honors setBlockSample.
+    virtual bool supportBlockSample() const { return false; }
+    void setBlockSample(const std::optional<BlockSample> & block_sample_) { block_sample = block_sample_; }
+
+    /// The number of rows the scan still needs. The format may skip the blocks after the ones holding that many rows.
+    void setRowLimit(const std::optional<size_t> & row_limit_) { row_limit = row_limit_; }
+
     /// Try to get rows from file metadata
     virtual std::optional<size_t> getTotalRows() { return {}; }
 
@@ -86,6 +121,9 @@ protected:
     /// partition keys are normalized to lower cases for partition column case-insensitive matching
     std::map<String, String> normalized_partition_values;
     std::shared_ptr<const DB::KeyCondition> key_condition;
+    std::optional<BlockSample> block_sample;
+    std::optional<size_t> row_limit;
+    FileScanStatsPtr scan_stats;
 };
 using FormatFilePtr = std::shared_ptr<FormatFile>;
 using FormatFiles = std::vector<FormatFilePtr>;
@@ -23,9 +23,11 @@
 #include <IO/SeekableReadBuffer.h>
 #include <Processors/Formats/Impl/ArrowBufferedStreams.h>
 #include <Processors/Formats/Impl/NativeORCBlockInputFormat.h>
+#include <Storages/SubstraitSource/FileFooterCache.h>
 #include <Storages/SubstraitSource/OrcUtil.h>
 #include <Poco/Util/AbstractConfiguration.h>
 #include <Common/CHUtil.h>
+#include <Common/logger_useful.h>
 
 namespace local_engine
 {
@@ -41,15 +43,16 @@ FormatFile::InputFormatPtr ORCFormatFile::createInputFormat(const DB::Block & he
     auto file_format = std::make_shared<FormatFile::InputFormat>();
     file_format->read_buffer = read_buffer_builder->build(file_info);
 
-    std::vector<StripeInformation> stripes;
-    [[maybe_unused]] UInt64 total_stripes = 0;
+    std::shared_ptr<const OrcFooter> footer;
     if (auto * seekable_in = dynamic_cast<DB::SeekableReadBuffer *>(file_format->read_buffer.get()))
     {
-        stripes = collectRequiredStripes(seekable_in, total_stripes);
+        footer = readFooter(seekable_in);
         seekable_in->seek(0, SEEK_SET);
     }
     else
-        stripes = collectRequiredStripes(total_stripes);
+        footer = readFooter(nullptr);
+    auto stripes = pruneStripes(*footer, collectRequiredStripes(footer->stripes), header);
+    const UInt64 total_stripes = footer->stripes.size();
 
     auto format_settings = DB::getFormatSettings(context);
 
@@ -88,8 +91,7 @@ std::optional<size_t> ORCFormatFile::getTotalRows()
             return total_rows;
     }
 
-    UInt64 _;
-    auto required_stripes = collectRequiredStripes(_);
+    auto required_stripes = collectRequiredStripes(readFooter(nullptr)->stripes);
 
     {
         std::lock_guard lock(mutex);
@@ -105,44 +107,92 @@ std::optional<size_t> ORCFormatFile::getTotalRows()
     }
 }
 
-std::vector<StripeInformation> ORCFormatFile::collectRequiredStripes(UInt64 & total_stripes)
+std::shared_ptr<const OrcFooter> ORCFormatFile::readFooter(DB::ReadBuffer * read_buffer) const
 {
-    auto in = read_buffer_builder->build(file_info);
-    return collectRequiredStripes(in.get(), total_stripes);
+    return FileFooterCache::instance().getOrLoad<OrcFooter>(
+        FileFooterCache::keyOf(file_info),
+        [&]() -> FileFooterCache::Loaded<OrcFooter>
+        {
+            std::unique_ptr<DB::ReadBuffer> in;
+            if (!read_buffer)
+            {
+                in = read_buffer_builder->build(file_info);
+                read_buffer = in.get();
+            }
+
+            DB::FormatSettings format_settings{
+                .seekable_read = true,
+            };
+            std::atomic<int> is_stopped{0};
+            auto arrow_file = DB::asArrowFile(*read_buffer, format_settings, is_stopped, "ORC", ORC_MAGIC_BYTES);
+            auto orc_reader = OrcUtil::createOrcReader(arrow_file);
+            const UInt64 total_stripes = orc_reader->getNumberOfStripes();
+            /// Old writers may leave out the stripe statistics.
+            const bool has_statistics = orc_reader->getNumberOfStripeStatistics() == total_stripes;
+
+            auto footer = std::make_shared<OrcFooter>();
+            footer->stripes.reserve(total_stripes);
+            size_t total_num_rows = 0;
+            for (size_t i = 0; i < total_stripes; ++i)
+            {
+                auto stripe_metadata = orc_reader->getStripe(i);
+                StripeInformation stripe_info;
+                stripe_info.index = i;
+                stripe_info.offset = stripe_metadata->getOffset();
+                stripe_info.length = stripe_metadata->getLength();
+                stripe_info.num_rows = stripe_metadata->getNumberOfRows();
+                stripe_info.start_row = total_num_rows;
+                footer->stripes.emplace_back(stripe_info);
+                total_num_rows += stripe_info.num_rows;
+                if (has_statistics)
+                    footer->stripe_statistics.emplace_back(orc_reader->getStripeStatistics(i));
+            }
+            footer->column_ids = OrcUtil::getColumnIds(orc_reader->getType());
+
+            /// A parsed orc::ColumnStatistics takes roughly 128 bytes.
+            size_t bytes = sizeof(OrcFooter) + footer->stripes.capacity() * sizeof(StripeInformation);
+            for (const auto & statistics : footer->stripe_statistics)
+                bytes += statistics->getNumberOfColumns() * 128;
+            return {footer, bytes};
+        });
 }
 
-std::vector<StripeInformation> ORCFormatFile::collectRequiredStripes(DB::ReadBuffer * read_buffer, UInt64 & total_stripes)
+std::vector<StripeInformation> ORCFormatFile::collectRequiredStripes(const std::vector<StripeInformation> & stripes) const
 {
-    DB::FormatSettings format_settings{
-        .seekable_read = true,
-    };
-    std::atomic<int> is_stopped{0};
-    auto arrow_file = DB::asArrowFile(*read_buffer, format_settings, is_stopped, "ORC", ORC_MAGIC_BYTES);
-    auto orc_reader = OrcUtil::createOrcReader(arrow_file);
-    total_stripes = orc_reader->getNumberOfStripes();
-
-    size_t total_num_rows = 0;
-    std::vector<StripeInformation> stripes;
-    stripes.reserve(total_stripes);
-    for (size_t i = 0; i < total_stripes; ++i)
+    std::vector<StripeInformation> required_stripes;
+    for (const auto & stripe : stripes)
     {
-        auto stripe_metadata = orc_reader->getStripe(i);
-
-        auto offset = stripe_metadata->getOffset() + stripe_metadata->getLength() / 2;
+        auto offset = stripe.offset + stripe.length / 2;
         if (file_info.start() <= offset && offset < file_info.start() + file_info.length())
-        {
-            StripeInformation stripe_info;
-            stripe_info.index = i;
-            stripe_info.offset = stripe_metadata->getLength();
-            stripe_info.length = stripe_metadata->getLength();
-            stripe_info.num_rows = stripe_metadata->getNumberOfRows();
-            stripe_info.start_row = total_num_rows;
-            stripes.emplace_back(stripe_info);
-        }
-
-        total_num_rows += stripe_metadata->getNumberOfRows();
+            required_stripes.emplace_back(stripe);
     }
-    return stripes;
+    return required_stripes;
+}
+
+std::vector<StripeInformation>
+ORCFormatFile::pruneStripes(const OrcFooter & footer, const std::vector<StripeInformation> & stripes, const DB::Block & header) const
+{
+    if (scan_stats)
+        scan_stats->total_stripes += stripes.size();
+    if (!key_condition || key_condition->alwaysUnknownOrTrue() || footer.stripe_statistics.empty())
+        return stripes;
+
+    std::vector<StripeInformation> required_stripes;
+    for (const auto & stripe : stripes)
+        if (OrcUtil::mayMatch(*key_condition, header, footer.column_ids, *footer.stripe_statistics[stripe.index]))
+            required_stripes.emplace_back(stripe);
+
+    if (scan_stats)
+        scan_stats->pruned_stripes += stripes.size() - required_stripes.size();
+
+    if (required_stripes.size() < stripes.size())
+        LOG_DEBUG(
+            getLogger("ORCFormatFile"),
+            "Pruned {} of {} stripes of {} by statistics",
+            stripes.size() - required_stripes.size(),
+            stripes.size(),
+            file_info.uri_file());
+    return required_stripes;
 }
 }
 #endif
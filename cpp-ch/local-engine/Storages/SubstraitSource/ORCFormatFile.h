@@ -25,6 +25,10 @@
 #    include <Storages/SubstraitSource/FormatFile.h>
 #    include <base/types.h>
 
+namespace orc
+{
+class StripeStatistics;
+}
 
 namespace local_engine
 {
@@ -37,6 +41,16 @@ struct StripeInformation
     UInt64 start_row;
 };
 
+/// The parsed footer of an ORC file, as cached by FileFooterCache.
+struct OrcFooter
+{
+    std::vector<StripeInformation> stripes;
+    /// The column statistics of each stripe, or empty if the file has none.
+    std::vector<std::shared_ptr<const orc::StripeStatistics>> stripe_statistics;
+    /// The ORC column ids of the top-level columns by their lower-cased names.
+    std::unordered_map<String, UInt64> column_ids;
+};
+
 class ORCFormatFile : public FormatFile
 {
 public:
@@ -56,8 +70,14 @@ private:
     mutable std::mutex mutex;
     std::optional<size_t> total_rows;
 
-    std::vector<StripeInformation> collectRequiredStripes(UInt64 & total_stripes);
-    std::vector<StripeInformation> collectRequiredStripes(DB::ReadBuffer * read_buffer, UInt64 & total_strpes);
+    /// Returns the footer of the file, from FileFooterCache or read through read_buffer, or through a new read buffer if
+    /// it is null.
+    std::shared_ptr<const OrcFooter> readFooter(DB::ReadBuffer * read_buffer) const;
+    /// Returns the stripes whose middle is in the split.
+    std::vector<StripeInformation> collectRequiredStripes(const std::vector<StripeInformation> & stripes) const;
+    /// Drops the stripes whose statistics show that none of their rows satisfies key_condition.
+    std::vector<StripeInformation>
+    pruneStripes(const OrcFooter & footer, const std::vector<StripeInformation> & stripes, const DB::Block & header) const;
 };
 }
 
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "OrcUtil.h"
+#include <DataTypes/DataTypeNullable.h>
 #include <IO/Operators.h>
 #include <IO/WriteBufferFromString.h>
 #include <Processors/Formats/Impl/ArrowBufferedStreams.h>
@@ -175,4 +176,68 @@ void OrcUtil::getFileReaderAndSchema(
         schema = arrow::schema(fields, schema->metadata());
     }
 }
+
+std::unordered_map<String, UInt64> OrcUtil::getColumnIds(const orc::Type & schema)
+{
+    std::unordered_map<String, UInt64> column_ids;
+    for (UInt64 i = 0; i < schema.getSubtypeCount(); ++i)
+        column_ids.emplace(boost::to_lower_copy(schema.getFieldName(i)), schema.getSubtype(i)->getColumnId());
+    return column_ids;
+}
+
+DB::Range OrcUtil::statisticsToRange(const orc::ColumnStatistics & statistics, const DB::DataTypePtr & type)
+{
+    const bool may_be_null = statistics.hasNull();
+    if (!statistics.getNumberOfValues())
+        return may_be_null ? DB::Range(DB::POSITIVE_INFINITY) : DB::Range::createWholeUniverse();
+
+    /// Only the types whose ORC statistics order values like ClickHouse does. Floats are left out since NaNs aren't in
+    /// their statistics, and timestamps since their statistics depend on the writer's timezone.
+    std::optional<std::pair<DB::Field, DB::Field>> min_max;
+    const DB::WhichDataType which(DB::removeNullable(type));
+    if (which.isInt8() || which.isInt16() || which.isInt32() || which.isInt64())
+    {
+        if (const auto * ints = dynamic_cast<const orc::IntegerColumnStatistics *>(&statistics); ints && ints->hasMinimum()
+            && ints->hasMaximum())
+            min_max.emplace(static_cast<Int64>(ints->getMinimum()), static_cast<Int64>(ints->getMaximum()));
+    }
+    else if (which.isDate32())
+    {
+        if (const auto * dates = dynamic_cast<const orc::DateColumnStatistics *>(&statistics); dates && dates->hasMinimum()
+            && dates->hasMaximum())
+            min_max.emplace(static_cast<Int64>(dates->getMinimum()), static_cast<Int64>(dates->getMaximum()));
+    }
+    else if (which.isString())
+    {
+        if (const auto * strings = dynamic_cast<const orc::StringColumnStatistics *>(&statistics); strings && strings->hasMinimum()
+            && strings->hasMaximum())
+            min_max.emplace(strings->getMinimum(), strings->getMaximum());
+    }
+    if (!min_max)
+        return DB::Range::createWholeUniverse();
+
+    if (may_be_null)
+        return DB::Range(min_max->first, true, DB::POSITIVE_INFINITY, true);
+    return DB::Range(min_max->first, true, min_max->second, true);
+}
+
+bool OrcUtil::mayMatch(
+    const DB::KeyCondition & key_condition,
+    const DB::Block & header,
+    const std::unordered_map<String, UInt64> & column_ids,
+    const orc::Statistics & statistics)
+{
+    DB::Hyperrectangle hyperrectangle(header.columns(), DB::Range::createWholeUniverse());
+    bool any_statistics = false;
+    for (size_t i = 0; i < header.columns(); ++i)
+    {
+        const auto & column = header.getByPosition(i);
+        auto it = column_ids.find(boost::to_lower_copy(column.name));
+        if (it == column_ids.end() || it->second >= statistics.getNumberOfColumns())
+            continue;
+        hyperrectangle[i] = statisticsToRange(*statistics.getColumnStatistics(static_cast<uint32_t>(it->second)), column.type);
+        any_statistics = true;
+    }
+    return !any_statistics || key_condition.checkInHyperrectangle(hyperrectangle, header.getDataTypes()).can_be_true;
+}
 }
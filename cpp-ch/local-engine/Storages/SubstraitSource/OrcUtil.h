@@ -25,7 +25,11 @@
 #include <orc/Reader.hh>
 #pragma GCC diagnostic pop
 #include <memory>
+#include <unordered_map>
+#include <Core/Block.h>
+#include <Storages/MergeTree/KeyCondition.h>
 #include <orc/Exceptions.hh>
+#include <orc/Statistics.hh>
 
 namespace local_engine
 {
@@ -58,6 +62,21 @@ public:
         std::shared_ptr<arrow::Schema> & schema,
         const DB::FormatSettings & format_settings,
         std::atomic<int> & is_stopped);
+
+    /// Returns the ORC column ids of the top-level columns of the file by their lower-cased names.
+    static std::unordered_map<String, UInt64> getColumnIds(const orc::Type & schema);
+
+    /// Returns the range of the values described by the statistics of a column read as type, with NULL as
+    /// POSITIVE_INFINITY like KeyCondition does, or the whole universe if the statistics can't describe it.
+    static DB::Range statisticsToRange(const orc::ColumnStatistics & statistics, const DB::DataTypePtr & type);
+
+    /// Returns whether any row described by statistics, e.g. those of a stripe, may satisfy key_condition, whose key
+    /// columns are the columns of header.
+    static bool mayMatch(
+        const DB::KeyCondition & key_condition,
+        const DB::Block & header,
+        const std::unordered_map<String, UInt64> & column_ids,
+        const orc::Statistics & statistics);
 };
 
 }
@@ -31,7 +31,9 @@
 #include <Processors/Formats/Impl/ArrowColumnToCHColumn.h>
 #include <Processors/Formats/Impl/ParquetBlockInputFormat.h>
 #include <Storages/Parquet/VectorizedParquetRecordReader.h>
+#include <Storages/SubstraitSource/FileFooterCache.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
 #include <parquet/metadata.h>
 #include <Common/Exception.h>
 
@@ -53,6 +55,27 @@ extern const int UNKNOWN_TYPE;
 namespace local_engine
 {
 
+namespace
+{
+/// Estimates the memory of parsed metadata. The serialized footer accounts for the payload of its strings, e.g. the
+/// min/max statistics and column paths, which the parsed Thrift structs copy. On top of that, every column chunk, row
+/// group and schema column is a separate set of Thrift structs, vectors and strings, which for wide files with many row
+/// groups takes several times the serialized size.
+size_t estimateParsedBytes(const parquet::FileMetaData & file_meta)
+{
+    /// Approximate sizes of format::ColumnChunk with its ColumnMetaData and Statistics, of format::RowGroup, and of a
+    /// format::SchemaElement with its schema::Node and ColumnDescriptor.
+    constexpr size_t column_chunk_bytes = 512;
+    constexpr size_t row_group_bytes = 128;
+    constexpr size_t schema_column_bytes = 256;
+
+    const size_t row_groups = file_meta.num_row_groups();
+    const size_t columns = file_meta.num_columns();
+    return sizeof(parquet::FileMetaData) + file_meta.size() + row_groups * (row_group_bytes + columns * column_chunk_bytes)
+        + columns * schema_column_bytes;
+}
+}
+
 ParquetFormatFile::ParquetFormatFile(
     const DB::ContextPtr & context_,
     const substrait::ReadRel::LocalFiles::FileOrFiles & file_info_,
@@ -67,17 +90,27 @@ FormatFile::InputFormatPtr ParquetFormatFile::createInputFormat(const DB::Block
     auto res = std::make_shared<FormatFile::InputFormat>();
     res->read_buffer = read_buffer_builder->build(file_info);
 
-    std::vector<RowGroupInformation> required_row_groups;
-    int total_row_groups = 0;
+    std::shared_ptr<const parquet::FileMetaData> file_meta;
     if (auto * seekable_in = dynamic_cast<DB::SeekableReadBuffer *>(res->read_buffer.get()))
     {
         // reuse the read_buffer to avoid opening the file twice.
         // especially，the cost of opening a hdfs file is large.
-        required_row_groups = collectRequiredRowGroups(seekable_in, total_row_groups);
+        file_meta = readFileMetaData(seekable_in);
         seekable_in->seek(0, SEEK_SET);
     }
     else
-        required_row_groups = collectRequiredRowGroups(total_row_groups);
+        file_meta = readFileMetaData(nullptr);
+    auto required_row_groups = collectRequiredRowGroups(*file_meta);
+    if (row_limit)
+    {
+        /// The row groups after the ones holding row_limit rows are never read.
+        size_t kept = 0;
+        size_t rows = 0;
+        while (kept < required_row_groups.size() && rows < *row_limit)
+            rows += required_row_groups[kept++].num_rows;
+        required_row_groups.resize(kept);
+    }
+    const int total_row_groups = file_meta->num_row_groups();
 
     auto format_settings = DB::getFormatSettings(context);
 
@@ -97,7 +130,9 @@ FormatFile::InputFormatPtr ParquetFormatFile::createInputFormat(const DB::Block
 
     if (use_pageindex_reader && supportPageindexReader(header))
     {
-        res->input = std::make_shared<VectorizedParquetBlockInputFormat>(*(res->read_buffer), header, format_settings);
+        auto input = std::make_shared<VectorizedParquetBlockInputFormat>(*(res->read_buffer), header, format_settings);
+        input->setFileMetaData(file_meta);
+        res->input = input;
     }
     else
     {
@@ -120,8 +155,7 @@ std::optional<size_t> ParquetFormatFile::getTotalRows()
             return total_rows;
     }
 
-    int _;
-    auto rowgroups = collectRequiredRowGroups(_);
+    auto rowgroups = collectRequiredRowGroups(*readFileMetaData(nullptr));
     size_t rows = 0;
     for (const auto & rowgroup : rowgroups)
         rows += rowgroup.num_rows;
@@ -147,26 +181,39 @@ bool ParquetFormatFile::supportPageindexReader(const DB::Block & header)
     return result == header.end();
 }
 
-std::vector<RowGroupInformation> ParquetFormatFile::collectRequiredRowGroups(int & total_row_groups) const
+std::shared_ptr<const parquet::FileMetaData> ParquetFormatFile::readFileMetaData(DB::ReadBuffer * read_buffer) const
 {
-    auto in = read_buffer_builder->build(file_info);
-    return collectRequiredRowGroups(in.get(), total_row_groups);
+    return FileFooterCache::instance().getOrLoad<parquet::FileMetaData>(
+        FileFooterCache::keyOf(file_info),
+        [&]() -> FileFooterCache::Loaded<parquet::FileMetaData>
+        {
+            std::unique_ptr<DB::ReadBuffer> in;
+            if (!read_buffer)
+            {
+                in = read_buffer_builder->build(file_info);
+                read_buffer = in.get();
+            }
+
+            const DB::FormatSettings format_settings{
+                .seekable_read = true,
+            };
+            std::atomic<int> is_stopped{0};
+            std::shared_ptr<parquet::FileMetaData> file_meta;
+            try
+            {
+                file_meta = parquet::ReadMetaData(asArrowFile(*read_buffer, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES));
+            }
+            catch (const parquet::ParquetException & e)
+            {
+                throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "Open file({}) failed. {}", file_info.uri_file(), e.what());
+            }
+            return {file_meta, estimateParsedBytes(*file_meta)};
+        });
 }
 
-std::vector<RowGroupInformation> ParquetFormatFile::collectRequiredRowGroups(DB::ReadBuffer * read_buffer, int & total_row_groups) const
+std::vector<RowGroupInformation> ParquetFormatFile::collectRequiredRowGroups(const parquet::FileMetaData & file_meta) const
 {
-    const DB::FormatSettings format_settings{
-        .seekable_read = true,
-    };
-    std::atomic<int> is_stopped{0};
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    auto status = parquet::arrow::OpenFile(
-        asArrowFile(*read_buffer, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES), arrow::default_memory_pool(), &reader);
-    if (!status.ok())
-        throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "Open file({}) failed. {}", file_info.uri_file(), status.ToString());
-
-    const auto file_meta = reader->parquet_reader()->metadata();
-    total_row_groups = file_meta->num_row_groups();
+    const int total_row_groups = file_meta.num_row_groups();
 
     std::vector<RowGroupInformation> row_group_metadatas;
     row_group_metadatas.reserve(total_row_groups);
@@ -181,7 +228,7 @@ std::vector<RowGroupInformation> ParquetFormatFile::collectRequiredRowGroups(DB:
 
     for (int i = 0; i < total_row_groups; ++i)
     {
-        const auto row_group_meta = file_meta->RowGroup(i);
+        const auto row_group_meta = file_meta.RowGroup(i);
         Int64 start_offset = 0;
         Int64 total_bytes = 0;
         start_offset = get_column_start_offset(*row_group_meta->ColumnChunk(0));
@@ -192,7 +239,8 @@ std::vector<RowGroupInformation> ParquetFormatFile::collectRequiredRowGroups(DB:
 
         const UInt64 midpoint_offset = static_cast<UInt64>(start_offset + total_bytes / 2);
         /// Current row group has intersection with the required range.
-        if (file_info.start() <= midpoint_offset && midpoint_offset < file_info.start() + file_info.length())
+        if (file_info.start() <= midpoint_offset && midpoint_offset < file_info.start() + file_info.length()
+            && (!block_sample || block_sample->chooses(file_info.uri_file(), i)))
         {
             RowGroupInformation info;
             info.index = i;
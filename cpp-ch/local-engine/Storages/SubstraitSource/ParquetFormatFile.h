@@ -52,6 +52,7 @@ public:
     std::optional<size_t> getTotalRows() override;
 
     bool supportSplit() const override { return true; }
+    bool supportBlockSample() const override { return true; }
 
     String getFileFormat() const override { return "Parquet"; }
 
@@ -62,8 +63,11 @@ private:
     std::mutex mutex;
     std::optional<size_t> total_rows;
 
-    std::vector<RowGroupInformation> collectRequiredRowGroups(int & total_row_groups) const;
-    std::vector<RowGroupInformation> collectRequiredRowGroups(DB::ReadBuffer * read_buffer, int & total_row_groups) const;
+    /// Returns the metadata of the file, from FileFooterCache or from the footer read through read_buffer, or through
+    /// a new read buffer if it is null.
+    std::shared_ptr<const parquet::FileMetaData> readFileMetaData(DB::ReadBuffer * read_buffer) const;
+    /// Returns the row groups whose middle is in the split, and which block_sample chooses.
+    std::vector<RowGroupInformation> collectRequiredRowGroups(const parquet::FileMetaData & file_meta) const;
 };
 
 }
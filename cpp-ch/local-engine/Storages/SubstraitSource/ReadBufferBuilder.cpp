@@ -25,6 +25,8 @@
 #include <Disks/IO/ReadBufferFromAzureBlobStorage.h>
 #include <Disks/IO/ReadBufferFromRemoteFSGather.h>
 #include <IO/BoundedReadBuffer.h>
+#include <IO/CancellableReadBuffer.h>
+#include <IO/HedgedReadBuffer.h>
 #include <IO/ReadBufferFromFile.h>
 #include <IO/ReadBufferFromS3.h>
 #include <IO/ReadSettings.h>
@@ -50,6 +52,7 @@
 #include <Common/CHUtil.h>
 #include <Common/GlutenConfig.h>
 #include <Common/GlutenSettings.h>
+#include <Common/QueryContext.h>
 #include <Common/logger_useful.h>
 #include <Common/safe_cast.h>
 
@@ -304,7 +307,13 @@ public:
                 read_buffer = std::make_unique<AsynchronousReadBufferFromHDFS>(
                     getThreadPoolReader(FilesystemReaderType::ASYNCHRONOUS_REMOTE_FS_READER), read_settings, std::move(raw_read_buffer));
             else
-                read_buffer = std::move(raw_read_buffer);
+                read_buffer = HedgedReadBuffer::wrap(
+                    std::move(raw_read_buffer),
+                    [hdfs_uri, hdfs_file_path, read_settings, file_size, &config]
+                    { return std::make_unique<ReadBufferFromHDFS>(hdfs_uri, hdfs_file_path, config, read_settings, 0, true, file_size); },
+                    hdfs_uri,
+                    HedgedReadConfig::loadFromContext(context),
+                    std::max<size_t>(read_settings.remote_fs_buffer_size, DBMS_DEFAULT_BUFFER_SIZE));
         }
         else
         {
@@ -335,7 +344,7 @@ public:
             auto remote_path = uri.getPath().substr(1);
             DB::StoredObjects stored_objects{DB::StoredObject{remote_path, "", *file_size}};
             auto cache_creator = wrapWithCache(
-                read_buffer_creator, read_settings, remote_path, *modified_time, *file_size);
+                wrapWithHedging(read_buffer_creator, hdfs_uri), read_settings, remote_path, *modified_time, *file_size);
             size_t buffer_size = std::max<size_t>(read_settings.remote_fs_buffer_size, DBMS_DEFAULT_BUFFER_SIZE);
             if (*file_size > 0)
                 buffer_size = std::min(*file_size, buffer_size);
@@ -420,7 +429,8 @@ public:
                     restricted_seek);
         };
 
-        auto cache_creator = wrapWithCache(read_buffer_creator, read_settings, pathKey, object_modified_time, object_size);
+        auto hedged_creator = wrapWithHedging(read_buffer_creator, "s3://" + bucket);
+        auto cache_creator = wrapWithCache(hedged_creator, read_settings, pathKey, object_modified_time, object_size);
 
         DB::StoredObjects stored_objects{DB::StoredObject{pathKey, "", object_size}};
         auto s3_impl = std::make_unique<DB::ReadBufferFromRemoteFSGather>(
@@ -756,14 +766,14 @@ ReadBufferBuilder::wrapWithBzip2(std::unique_ptr<DB::ReadBuffer> in, const subst
     bool last_block_need_special_process = (new_end < file_size);
     size_t buffer_size = context->getSettingsRef()[DB::Setting::max_read_buffer_size];
     auto decompressed_in = std::make_unique<SplittableBzip2ReadBuffer>(
-        std::move(bounded_in), first_block_need_special_process, last_block_need_special_process, buffer_size);
+        wrapFileBuffer(std::move(bounded_in)), first_block_need_special_process, last_block_need_special_process, buffer_size);
     return std::move(decompressed_in);
 }
 
 std::unique_ptr<DB::ReadBuffer>
 ReadBufferBuilder::buildWithCompressionWrapper(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info)
 {
-    auto in = build(file_info);
+    auto in = buildFileBuffer(file_info);
 
     /// Wrap the read buffer with compression method if exists
     Poco::URI file_uri(file_info.uri_file());
@@ -774,7 +784,7 @@ ReadBufferBuilder::buildWithCompressionWrapper(const substrait::ReadRel::LocalFi
     else
     {
         /// In this case we are pretty sure that current split covers the whole file because only bzip2 compression is splittable
-        auto parallel = wrapWithParallelIfNeeded(std::move(in), file_info);
+        auto parallel = wrapWithParallelIfNeeded(wrapFileBuffer(std::move(in)), file_info);
         return wrapReadBufferWithCompressionMethod(std::move(parallel), compression);
     }
 }
@@ -839,6 +849,26 @@ ReadBufferBuilder::ReadBufferCreator ReadBufferBuilder::wrapWithCache(
     };
 }
 
+ReadBufferBuilder::ReadBufferCreator
+ReadBufferBuilder::wrapWithHedging(ReadBufferCreator read_buffer_creator, const String & storage_name) const
+{
+    const auto config = HedgedReadConfig::loadFromContext(context);
+    if (!config.enabled)
+        return read_buffer_creator;
+
+    const size_t buffer_size = std::max<size_t>(getReadSettings().remote_fs_buffer_size, DBMS_DEFAULT_BUFFER_SIZE);
+    return [read_buffer_creator, storage_name, config, buffer_size](
+               bool restricted_seek, const DB::StoredObject & object) -> std::unique_ptr<DB::ReadBufferFromFileBase>
+    {
+        return HedgedReadBuffer::wrap(
+            read_buffer_creator(restricted_seek, object),
+            [read_buffer_creator, restricted_seek, object]() { return read_buffer_creator(restricted_seek, object); },
+            storage_name,
+            config,
+            buffer_size);
+    };
+}
+
 void ReadBufferBuilder::updateCaches(const String & key, size_t last_modified_time, size_t file_size) const
 {
     if (!file_cache)
@@ -908,12 +938,40 @@ void ReadBufferBuilderFactory::registerBuilder(const String & schema, NewBuilder
     builders[schema] = newer;
 }
 
+CancellableReadBufferBuilder::CancellableReadBufferBuilder(
+    const DB::ContextPtr & context_, ReadBufferBuilderPtr builder_, CancellationTokenPtr cancellation_token_)
+    : ReadBufferBuilder(context_), builder(std::move(builder_)), cancellation_token(std::move(cancellation_token_))
+{
+    file_cache = builder->file_cache;
+}
+
+std::unique_ptr<DB::ReadBuffer> CancellableReadBufferBuilder::build(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info)
+{
+    cancellation_token->throwIfCancelled();
+    return CancellableReadBuffer::wrap(builder->build(file_info), cancellation_token);
+}
+
+std::unique_ptr<DB::ReadBuffer> CancellableReadBufferBuilder::buildFileBuffer(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info)
+{
+    cancellation_token->throwIfCancelled();
+    return builder->build(file_info);
+}
+
+std::unique_ptr<DB::ReadBuffer> CancellableReadBufferBuilder::wrapFileBuffer(std::unique_ptr<DB::ReadBuffer> in) const
+{
+    return CancellableReadBuffer::wrap(std::move(in), cancellation_token);
+}
+
 ReadBufferBuilderPtr ReadBufferBuilderFactory::createBuilder(const String & schema, DB::ContextPtr context)
 {
     auto it = builders.find(schema);
     if (it == builders.end())
         throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "Not found read buffer builder for {}", schema);
-    return it->second(context);
+    auto builder = it->second(context);
+    /// The reads of a task stop once it is cancelled.
+    if (auto cancellation_token = QueryContext::instance().currentCancellationTokenOrNull())
+        return std::make_shared<CancellableReadBufferBuilder>(context, std::move(builder), std::move(cancellation_token));
+    return builder;
 }
 
 void ReadBufferBuilderFactory::registerCleaner(Cleaner cleaner)
@@ -23,6 +23,7 @@
 #include <IO/ReadBuffer.h>
 #include <IO/ReadBufferFromFileBase.h>
 #include <substrait/plan.pb.h>
+#include <Common/CancellationToken.h>
 #include <Common/FileCacheConcurrentMap.h>
 
 
@@ -46,6 +47,15 @@ public:
     std::unique_ptr<DB::ReadBuffer> buildWithCompressionWrapper(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info);
 
 protected:
+    /// Builds the buffer which reads the file for buildWithCompressionWrapper, before wrapFileBuffer applies.
+    virtual std::unique_ptr<DB::ReadBuffer> buildFileBuffer(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info)
+    {
+        return build(file_info);
+    }
+
+    /// Wraps the buffer which reads the file, after it is bounded to the split and before it is decompressed.
+    virtual std::unique_ptr<DB::ReadBuffer> wrapFileBuffer(std::unique_ptr<DB::ReadBuffer> in) const { return in; }
+
     using ReadBufferCreator = std::function<std::unique_ptr<DB::ReadBufferFromFileBase>(bool restricted_seek, const DB::StoredObject & object)>;
 
     std::unique_ptr<DB::ReadBuffer>
@@ -58,6 +68,9 @@ protected:
         size_t last_modified_time,
         size_t file_size);
 
+    /// Reads through the buffers of read_buffer_creator hedge their slow range reads if hedged reads are enabled.
+    ReadBufferCreator wrapWithHedging(ReadBufferCreator read_buffer_creator, const String & storage_name) const;
+
     std::unique_ptr<DB::ReadBuffer>
     wrapWithParallelIfNeeded(std::unique_ptr<DB::ReadBuffer> in, const substrait::ReadRel::LocalFiles::FileOrFiles & file_info);
 
@@ -75,6 +88,27 @@ public:
 
 using ReadBufferBuilderPtr = std::shared_ptr<ReadBufferBuilder>;
 
+/// Builds the read buffers of another builder, wrapped to stop reading once the task is cancelled.
+class CancellableReadBufferBuilder : public ReadBufferBuilder
+{
+public:
+    CancellableReadBufferBuilder(const DB::ContextPtr & context_, ReadBufferBuilderPtr builder_, CancellationTokenPtr cancellation_token_);
+    ~CancellableReadBufferBuilder() override = default;
+
+    bool isRemote() const override { return builder->isRemote(); }
+
+    std::unique_ptr<DB::ReadBuffer> build(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info) override;
+
+protected:
+    /// The cancellation wrapper applies last, so that wrapWithBzip2 still sees the storage buffer it bounds.
+    std::unique_ptr<DB::ReadBuffer> buildFileBuffer(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info) override;
+    std::unique_ptr<DB::ReadBuffer> wrapFileBuffer(std::unique_ptr<DB::ReadBuffer> in) const override;
+
+private:
+    ReadBufferBuilderPtr builder;
+    CancellationTokenPtr cancellation_token;
+};
+
 class ReadBufferBuilderFactory : public boost::noncopyable
 {
 public:
@@ -14,6 +14,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <functional>
 #include <memory>
 
@@ -100,6 +101,14 @@ void SubstraitFileSource::setKeyCondition(const std::optional<DB::ActionsDAG> &
         column_index_filter = std::make_shared<ColumnIndexFilter>(filter_actions_dag.value(), context_);
 }
 
+bool SubstraitFileSource::setBlockSample(const BlockSample & sample)
+{
+    if (!std::ranges::all_of(files, [](const FormatFilePtr & file) { return file->supportBlockSample(); }))
+        return false;
+    block_sample = sample;
+    return true;
+}
+
 DB::Chunk SubstraitFileSource::generate()
 {
     while (true)
@@ -113,6 +122,7 @@ DB::Chunk SubstraitFileSource::generate()
         DB::Chunk chunk;
         if (file_reader->pull(chunk))
         {
+            read_rows += chunk.getNumRows();
             if (input_file_name)
                 input_file_name_parser.addInputFileColumnsToChunk(output.getHeader(), chunk);
             return chunk;
@@ -131,7 +141,7 @@ bool SubstraitFileSource::tryPrepareReader()
     if (file_reader)
         return true;
 
-    if (current_file_index >= files.size())
+    if (current_file_index >= files.size() || (row_limit && read_rows >= *row_limit))
         return false;
 
     auto current_file = files[current_file_index];
@@ -144,6 +154,11 @@ bool SubstraitFileSource::tryPrepareReader()
         return true;
     }
 
+    current_file->setKeyCondition(key_condition);
+    current_file->setBlockSample(block_sample);
+    current_file->setScanStats(scan_stats);
+    if (row_limit)
+        current_file->setRowLimit(*row_limit - read_rows);
     if (!to_read_header)
     {
         auto total_rows = current_file->getTotalRows();
@@ -128,6 +128,13 @@ public:
 
     void setKeyCondition(const std::optional<DB::ActionsDAG> & filter_actions_dag, DB::ContextPtr context_) override;
 
+    /// Stops opening files once `rows` rows have been read, and lets each file skip the blocks beyond its share.
+    void setRowLimit(size_t rows) { row_limit = rows; }
+    /// Samples whole blocks of the files instead of rows. Returns false, and samples nothing, if some file can't.
+    bool setBlockSample(const BlockSample & sample);
+    /// Shares the counters of the scan with every file it reads.
+    void setScanStats(const FileScanStatsPtr & scan_stats_) { scan_stats = scan_stats_; }
+
 protected:
     DB::Chunk generate() override;
 
@@ -146,5 +153,9 @@ private:
     std::unique_ptr<FileReaderWrapper> file_reader;
     ReadBufferBuilderPtr read_buffer_builder;
     ColumnIndexFilterPtr column_index_filter;
+    std::optional<BlockSample> block_sample;
+    FileScanStatsPtr scan_stats;
+    std::optional<size_t> row_limit;
+    size_t read_rows = 0;
 };
 }
@@ -17,6 +17,8 @@
 
 #include <Interpreters/Context_fwd.h>
 #include <Processors/QueryPlan/IQueryPlanStep.h>
+#include <Processors/QueryPlan/ITransformingStep.h>
+#include <Processors/QueryPlan/QueryPlan.h>
 #include <QueryPipeline/Pipe.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Storages/IStorage.h>
@@ -52,8 +54,13 @@ SubstraitFileStorage dummy_storage{DB::StorageID("dummy_db", "dummy_table")};
 }
 
 SubstraitFileSourceStep::SubstraitFileSourceStep(const DB::ContextPtr & context_, DB::Pipe pipe_, const String &)
-    : SourceStepWithFilter(pipe_.getHeader(), {}, {}, dummy_storage.getStorageSnapshot(nullptr, nullptr), context_), pipe(std::move(pipe_))
+    : SourceStepWithFilter(pipe_.getHeader(), {}, {}, dummy_storage.getStorageSnapshot(nullptr, nullptr), context_)
+    , pipe(std::move(pipe_))
+    , scan_stats(std::make_shared<FileScanStats>())
 {
+    for (const auto & processor : pipe.getProcessors())
+        if (auto * source = dynamic_cast<SubstraitFileSource *>(processor.get()))
+            source->setScanStats(scan_stats);
 }
 
 void SubstraitFileSourceStep::initializePipeline(DB::QueryPipelineBuilder & pipeline, const DB::BuildQueryPipelineSettings &)
@@ -71,4 +78,35 @@ void SubstraitFileSourceStep::applyFilters(const DB::ActionDAGNodes added_filter
         if (auto * source = dynamic_cast<DB::SourceWithKeyCondition *>(processor.get()))
             source->setKeyCondition(filter_actions_dag, context);
 }
+
+void SubstraitFileSourceStep::setRowLimit(const size_t rows)
+{
+    for (const auto & processor : pipe.getProcessors())
+        if (auto * source = dynamic_cast<SubstraitFileSource *>(processor.get()))
+            source->setRowLimit(rows);
+}
+
+bool SubstraitFileSourceStep::setBlockSample(const BlockSample & sample)
+{
+    bool sampled = true;
+    for (const auto & processor : pipe.getProcessors())
+        if (auto * source = dynamic_cast<SubstraitFileSource *>(processor.get()))
+            sampled = source->setBlockSample(sample) && sampled;
+    return sampled;
+}
+
+SubstraitFileSourceStep * SubstraitFileSourceStep::findRowPreservingSource(DB::QueryPlan & plan)
+{
+    if (!plan.isInitialized())
+        return nullptr;
+    auto * node = plan.getRootNode();
+    while (node->children.size() == 1)
+    {
+        const auto * transforming = dynamic_cast<const DB::ITransformingStep *>(node->step.get());
+        if (!transforming || !transforming->getTransformTraits().preserves_number_of_rows)
+            return nullptr;
+        node = node->children.front();
+    }
+    return dynamic_cast<SubstraitFileSourceStep *>(node->step.get());
+}
 }
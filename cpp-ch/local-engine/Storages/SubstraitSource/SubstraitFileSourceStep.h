@@ -23,8 +23,16 @@
 #include <Interpreters/Context_fwd.h>
 #include <Core/NamesAndTypes.h>
 
+namespace DB
+{
+class QueryPlan;
+}
+
 namespace local_engine
 {
+struct BlockSample;
+struct FileScanStats;
+
 class SubstraitFileSourceStep : public DB::SourceStepWithFilter
 {
 public:
@@ -36,8 +44,20 @@ public:
 
     void initializePipeline(DB::QueryPipelineBuilder &, const DB::BuildQueryPipelineSettings &) override;
 
+    /// See SubstraitFileSource::setRowLimit.
+    void setRowLimit(size_t rows);
+    /// See SubstraitFileSource::setBlockSample.
+    bool setBlockSample(const BlockSample & sample);
+
+    /// Counters collected by the files of this scan while they are read.
+    const FileScanStats & getScanStats() const { return *scan_stats; }
+
+    /// The file scan at the bottom of the plan, if every step above it keeps the number of rows.
+    static SubstraitFileSourceStep * findRowPreservingSource(DB::QueryPlan & plan);
+
 private:
     DB::Pipe pipe;
+    std::shared_ptr<FileScanStats> scan_stats;
 };
 
 }
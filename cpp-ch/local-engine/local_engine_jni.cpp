@@ -65,6 +65,7 @@ namespace DB
 namespace ErrorCodes
 {
 extern const int CANNOT_PARSE_PROTOBUF_SCHEMA;
+extern const int LOGICAL_ERROR;
 extern const int UNKNOWN_EXCEPTION;
 }
 }
@@ -858,11 +859,12 @@ Java_org_apache_gluten_vectorized_CHBlockWriterJniWrapper_nativeWrite(JNIEnv * e
     LOCAL_ENGINE_JNI_METHOD_END(env, )
 }
 
-JNIEXPORT jint Java_org_apache_gluten_vectorized_CHBlockWriterJniWrapper_nativeResultSize(JNIEnv * env, jobject, jlong instance)
+JNIEXPORT jlong Java_org_apache_gluten_vectorized_CHBlockWriterJniWrapper_nativeResultSize(JNIEnv * env, jobject, jlong instance)
 {
     LOCAL_ENGINE_JNI_METHOD_START
     auto * writer = reinterpret_cast<local_engine::NativeWriterInMemory *>(instance);
-    return static_cast<jint>(writer->collect().size());
+    writer->collect();
+    return static_cast<jlong>(writer->size());
     LOCAL_ENGINE_JNI_METHOD_END(env, -1)
 }
 
@@ -871,8 +873,12 @@ Java_org_apache_gluten_vectorized_CHBlockWriterJniWrapper_nativeCollect(JNIEnv *
 {
     LOCAL_ENGINE_JNI_METHOD_START
     auto * writer = reinterpret_cast<local_engine::NativeWriterInMemory *>(instance);
-    auto data = writer->collect();
-    env->SetByteArrayRegion(result, 0, data.size(), reinterpret_cast<const jbyte *>(data.data()));
+    jsize offset = 0;
+    for (const auto & chunk : writer->collect())
+    {
+        env->SetByteArrayRegion(result, offset, chunk.size, reinterpret_cast<const jbyte *>(chunk.memory.data()));
+        offset += chunk.size;
+    }
     LOCAL_ENGINE_JNI_METHOD_END(env, )
 }
 
@@ -1054,7 +1060,7 @@ JNIEXPORT jlong Java_org_apache_gluten_vectorized_StorageJoinBuilder_nativeBuild
     JNIEnv * env,
     jclass,
     jstring key,
-    jbyteArray in,
+    jobjectArray in,
     jlong row_count_,
     jstring join_key_,
     jint join_type_,
@@ -1070,8 +1076,8 @@ JNIEXPORT jlong Java_org_apache_gluten_vectorized_StorageJoinBuilder_nativeBuild
     const auto named_struct_a = local_engine::getByteArrayElementsSafe(env, named_struct);
     const std::string::size_type struct_size = named_struct_a.length();
     std::string struct_string{reinterpret_cast<const char *>(named_struct_a.elems()), struct_size};
-    const jsize length = env->GetArrayLength(in);
-    local_engine::ReadBufferFromByteArray read_buffer_from_java_array(in, length);
+    /// The relation is held as byte[] chunks, so it may be larger than any single Java array.
+    local_engine::ReadBufferFromByteArrays read_buffer_from_java_array(in);
     DB::CompressedReadBuffer input(read_buffer_from_java_array);
     local_engine::configureCompressedReadBuffer(input);
     const auto * obj = make_wrapper(local_engine::BroadCastJoinBuilder::buildJoin(
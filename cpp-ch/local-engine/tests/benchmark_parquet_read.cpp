@@ -23,12 +23,20 @@
 #include <Processors/Formats/Impl/ParquetBlockInputFormat.h>
 #include <QueryPipeline/QueryPipeline.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
+#include <Storages/Parquet/ArrowUtils.h>
+#include <Storages/Parquet/ColumnIndexFilter.h>
+#include <Storages/Parquet/VectorizedParquetRecordReader.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
+#include <arrow/builder.h>
+#include <arrow/io/memory.h>
+#include <arrow/table.h>
 #include <benchmark/benchmark.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/arrow/writer.h>
 #include <substrait/plan.pb.h>
 #include <tests/gluten_test_util.h>
 #include <Poco/Util/MapConfiguration.h>
+#include <Common/BlockTypeUtils.h>
 #include <Common/DebugUtils.h>
 #include <Common/QueryContext.h>
 
@@ -239,6 +247,56 @@ void BM_ColumnIndexRead_Filter_ReturnHalfResult(benchmark::State & state)
     local_engine::QueryContext::globalMutableContext()->setConfig(Poco::AutoPtr(new Poco::Util::MapConfiguration()));
 }
 
+
+/// Reads a dictionary encoded file of 32 row groups, with a filter matching the status values of `range(0)` of them,
+/// with or without skipping row groups by their dictionaries (range(1)).
+void BM_DictionaryFilterRead(benchmark::State & state)
+{
+    using namespace DB;
+    constexpr int64_t row_groups = 32;
+    constexpr int64_t rows_per_group = 64 * 1024;
+    static const auto file = []
+    {
+        arrow::StringBuilder status_builder;
+        arrow::StringBuilder payload_builder;
+        for (int64_t i = 0; i < row_groups * rows_per_group; ++i)
+        {
+            THROW_ARROW_NOT_OK(status_builder.Append(fmt::format("status-{}-{}", i / rows_per_group, i % 4)));
+            THROW_ARROW_NOT_OK(payload_builder.Append(fmt::format("payload-{}", i % 1024)));
+        }
+        std::shared_ptr<arrow::Array> status;
+        std::shared_ptr<arrow::Array> payload;
+        THROW_ARROW_NOT_OK(status_builder.Finish(&status));
+        THROW_ARROW_NOT_OK(payload_builder.Finish(&payload));
+        const auto schema = arrow::schema({arrow::field("status", arrow::utf8(), false), arrow::field("payload", arrow::utf8(), false)});
+        THROW_ARROW_NOT_OK_OR_ASSIGN(const auto sink, arrow::io::BufferOutputStream::Create());
+        THROW_ARROW_NOT_OK(
+            parquet::arrow::WriteTable(*arrow::Table::Make(schema, {status, payload}), arrow::default_memory_pool(), sink, rows_per_group));
+        THROW_ARROW_NOT_OK_OR_ASSIGN(const auto buffer, sink->Finish());
+        return buffer;
+    }();
+
+    std::vector<std::string> values;
+    for (int64_t rg = 0; rg < state.range(0); ++rg)
+        values.push_back(fmt::format("'status-{}-1'", rg));
+    const std::string filter = values.empty() ? "status = 'none'" : fmt::format("status in ({})", fmt::join(values, ", "));
+    static const AnotherRowType name_and_types{{"status", STRING()}, {"payload", STRING()}};
+    const auto column_index_filter = std::make_shared<local_engine::ColumnIndexFilter>(
+        local_engine::test::parseFilter(filter, name_and_types).value(), local_engine::QueryContext::globalContext());
+
+    FormatSettings format_settings;
+    format_settings.parquet.filter_push_down = state.range(1);
+    const Block header({{STRING(), "status"}, {STRING(), "payload"}});
+    size_t rows = 0;
+    for (auto _ : state)
+    {
+        local_engine::VectorizedParquetRecordReader record_reader(header, format_settings);
+        record_reader.initialize(header, std::make_shared<arrow::io::BufferReader>(file), column_index_filter);
+        for (auto chunk = record_reader.nextBatch(); chunk.getNumRows() > 0; chunk = record_reader.nextBatch())
+            rows += chunk.getNumRows();
+    }
+    state.counters["rows"] = benchmark::Counter(static_cast<double>(rows), benchmark::Counter::kAvgIterations);
+}
 }
 
 BENCHMARK(BM_ColumnIndexRead_Old)->Unit(benchmark::kMillisecond)->Iterations(20);
@@ -248,3 +306,7 @@ BENCHMARK(BM_ColumnIndexRead_Filter_ReturnHalfResult)->Unit(benchmark::kMillisec
 BENCHMARK(BM_ParquetReadDate32)->Unit(benchmark::kMillisecond)->Iterations(10);
 BENCHMARK(BM_OptimizedParquetReadString)->Unit(benchmark::kMillisecond)->Iterations(10);
 BENCHMARK(BM_OptimizedParquetReadDate32)->Unit(benchmark::kMillisecond)->Iterations(200);
+BENCHMARK(BM_DictionaryFilterRead)
+    ->ArgNames({"matched_row_groups", "dictionary"})
+    ->ArgsProduct({{0, 1, 8, 32}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
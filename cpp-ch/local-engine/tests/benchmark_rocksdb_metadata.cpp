@@ -0,0 +1,87 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <config.h>
+
+#if USE_ROCKSDB
+
+#include <Disks/ObjectStorages/MetadataStorageFromRocksDBTransactionOperations.h>
+#include <benchmark/benchmark.h>
+#include <Poco/TemporaryFile.h>
+#include <Common/SharedMutex.h>
+
+using namespace local_engine;
+
+namespace
+{
+constexpr size_t FILES_PER_PART = 20;
+
+/// A table directory of state.range(0) parts with FILES_PER_PART files each.
+class RocksDBMetadataTree : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        dir = std::make_unique<Poco::TemporaryFile>();
+        rocksdb::Options options;
+        options.create_if_missing = true;
+        rocksdb::DB * raw_db = nullptr;
+        throwRockDBErrorNotOk(rocksdb::DB::Open(options, dir->path(), &raw_db));
+        db.reset(raw_db);
+
+        for (Int64 part = 0; part < state.range(0); ++part)
+            commitPart("store/table/all_" + std::to_string(part) + "_0");
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        db.reset();
+        dir.reset();
+    }
+
+    void commitPart(const String & part)
+    {
+        DB::SharedMutex mutex;
+        std::unique_lock lock(mutex);
+        rocksdb::WriteBatchWithIndex batch(rocksdb::BytewiseComparator(), 0, true);
+        RocksDBCreateDirectoryRecursiveOperation(part, *db, batch).execute(lock);
+        for (size_t i = 0; i < FILES_PER_PART; ++i)
+            RocksDBWriteFileOperation(part + "/column_" + std::to_string(i) + ".bin", *db, batch, "metadata").execute(lock);
+        RocksDBCommitBatchOperation(*db, batch).execute(lock);
+    }
+
+    std::unique_ptr<Poco::TemporaryFile> dir;
+    std::unique_ptr<rocksdb::DB> db;
+};
+}
+
+BENCHMARK_DEFINE_F(RocksDBMetadataTree, ListTableDirectory)(benchmark::State & state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(listKeys(*db, "store/table"));
+}
+
+BENCHMARK_DEFINE_F(RocksDBMetadataTree, CommitPart)(benchmark::State & state)
+{
+    size_t part = 0;
+    for (auto _ : state)
+        commitPart("store/table/new_" + std::to_string(part++) + "_0");
+}
+
+BENCHMARK_REGISTER_F(RocksDBMetadataTree, ListTableDirectory)->Unit(benchmark::kMillisecond)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_REGISTER_F(RocksDBMetadataTree, CommitPart)->Unit(benchmark::kMicrosecond)->Arg(1000)->Arg(100000);
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Columns/ColumnDecimal.h>
+#include <Core/Block.h>
+#include <DataTypes/DataTypeFactory.h>
+#include <DataTypes/DataTypesDecimal.h>
+#include <Functions/FunctionFactory.h>
+#include <benchmark/benchmark.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+
+/// When large_values is true, every row needs Int128, which forces the wide calculation path for the whole batch.
+static Block createDecimalBlock(const DataTypePtr & type, const DataTypePtr & result_type, bool large_values, size_t rows)
+{
+    auto left = ColumnDecimal<Decimal128>::create(0, getDecimalScale(*type));
+    auto right = ColumnDecimal<Decimal128>::create(0, getDecimalScale(*type));
+    Int128 offset = large_values ? intExp10OfSize<Int128>(30) : 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        left->getData().push_back(Decimal128(offset + static_cast<Int128>(i * 12345)));
+        right->getData().push_back(Decimal128(static_cast<Int128>(i % 1000 + 1)));
+    }
+
+    Block block;
+    block.insert(ColumnWithTypeAndName(std::move(left), type, "left"));
+    block.insert(ColumnWithTypeAndName(std::move(right), type, "right"));
+    block.insert(ColumnWithTypeAndName(result_type->createColumnConst(rows, result_type->getDefault()), result_type, "result"));
+    return block;
+}
+
+static void BM_SparkDecimalArithmetic(benchmark::State & state, const String & name, const String & result_type_name, bool large_values)
+{
+    auto function = FunctionFactory::instance().get(name, local_engine::QueryContext::globalContext());
+    auto type = DataTypeFactory::instance().get("Decimal(38, 4)");
+    auto result_type = DataTypeFactory::instance().get(result_type_name);
+    Block block = createDecimalBlock(type, result_type, large_values, 65536);
+    auto executable = function->build(block.getColumnsWithTypeAndName());
+    for (auto _ : state)
+    {
+        auto result = executable->execute(block.getColumnsWithTypeAndName(), executable->getResultType(), block.rows(), false);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK_CAPTURE(BM_SparkDecimalArithmetic, plus_small, "sparkDecimalPlus", "Decimal(38, 4)", false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SparkDecimalArithmetic, plus_large, "sparkDecimalPlus", "Decimal(38, 4)", true)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SparkDecimalArithmetic, multiply_small, "sparkDecimalMultiply", "Decimal(38, 6)", false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SparkDecimalArithmetic, multiply_large, "sparkDecimalMultiply", "Decimal(38, 6)", true)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SparkDecimalArithmetic, divide_small, "sparkDecimalDivide", "Decimal(38, 6)", false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SparkDecimalArithmetic, divide_large, "sparkDecimalDivide", "Decimal(38, 6)", true)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Columns/IColumn.h>
+#include <Core/Block.h>
+#include <DataTypes/DataTypeFactory.h>
+#include <DataTypes/IDataType.h>
+#include <Functions/FunctionFactory.h>
+#include <Interpreters/ActionsDAG.h>
+#include <Interpreters/ExpressionActions.h>
+#include <Interpreters/ExpressionActionsSettings.h>
+#include <benchmark/benchmark.h>
+#include <Common/FieldVisitorToString.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+
+/// Compares interpreted and JIT compiled execution of expression chains made of Spark functions.
+/// The argument of each benchmark selects the mode: 0 interprets, 1 compiles.
+
+static constexpr size_t ROWS = 65536;
+
+static Block createDataBlock()
+{
+    auto f64_type = DataTypeFactory::instance().get("Nullable(Float64)");
+    auto d64_type = DataTypeFactory::instance().get("Decimal(18, 4)");
+    auto f64_column = f64_type->createColumn();
+    auto d64_column = d64_type->createColumn();
+    for (size_t i = 0; i < ROWS; ++i)
+    {
+        if (i % 100 == 0)
+            f64_column->insertDefault();
+        else
+            f64_column->insert(static_cast<Float64>(rand()) / 997.0 - 1000000.0);
+        d64_column->insert(DecimalField<Decimal64>(static_cast<Int64>(rand()) - RAND_MAX / 2, 4));
+    }
+    return Block({{std::move(f64_column), f64_type, "f64"}, {std::move(d64_column), d64_type, "d64"}});
+}
+
+static const ActionsDAG::Node * addFunction(ActionsDAG & dag, const String & function, const ActionsDAG::NodeRawConstPtrs & args)
+{
+    auto function_builder = FunctionFactory::instance().get(function, local_engine::QueryContext::globalContext());
+    String result_name = function + "(";
+    for (size_t i = 0; i < args.size(); ++i)
+        result_name += (i ? "," : "") + args[i]->result_name;
+    result_name += ")";
+    return &dag.addFunction(function_builder, args, result_name);
+}
+
+static const ActionsDAG::Node * addConstant(ActionsDAG & dag, const String & type_name, const Field & value)
+{
+    auto type = DataTypeFactory::instance().get(type_name);
+    return &dag.addColumn(ColumnWithTypeAndName(type->createColumnConst(1, value), type, applyVisitor(FieldVisitorToString(), value)));
+}
+
+template <typename Build>
+static void runExpression(benchmark::State & state, Build && build)
+{
+    Block block = createDataBlock();
+    ActionsDAG dag;
+    const auto * f64 = &dag.addInput("f64", block.getByName("f64").type);
+    const auto * d64 = &dag.addInput("d64", block.getByName("d64").type);
+    dag.addOrReplaceInOutputs(*build(dag, f64, d64));
+
+    ExpressionActionsSettings settings;
+    if (state.range(0))
+    {
+        settings.can_compile_expressions = true;
+        settings.compile_expressions = CompileExpressions::yes;
+        settings.min_count_to_compile_expression = 0;
+    }
+    ExpressionActions actions(std::move(dag), settings);
+    for (auto _ : state)
+    {
+        Block result = block;
+        actions.execute(result);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+/// sparkFloor(f64 * 10 + 0.5)
+static void BM_SparkFloorChain(benchmark::State & state)
+{
+    runExpression(
+        state,
+        [](ActionsDAG & dag, const ActionsDAG::Node * f64, const ActionsDAG::Node *)
+        {
+            const auto * scaled = addFunction(dag, "multiply", {f64, addConstant(dag, "Float64", 10.0)});
+            const auto * shifted = addFunction(dag, "plus", {scaled, addConstant(dag, "Float64", 0.5)});
+            return addFunction(dag, "sparkFloor", {shifted});
+        });
+}
+
+/// roundHalfUp(sparkDivide(f64, f64 - 1), 2)
+static void BM_SparkRoundHalfUpDivideChain(benchmark::State & state)
+{
+    runExpression(
+        state,
+        [](ActionsDAG & dag, const ActionsDAG::Node * f64, const ActionsDAG::Node *)
+        {
+            const auto * divisor = addFunction(dag, "minus", {f64, addConstant(dag, "Float64", 1.0)});
+            const auto * divided = addFunction(dag, "sparkDivide", {f64, divisor});
+            return addFunction(dag, "roundHalfUp", {divided, addConstant(dag, "Int32", Int64(2))});
+        });
+}
+
+/// sparkRint(sparkFloor(f64) / 3)
+static void BM_SparkRintFloorChain(benchmark::State & state)
+{
+    runExpression(
+        state,
+        [](ActionsDAG & dag, const ActionsDAG::Node * f64, const ActionsDAG::Node *)
+        {
+            const auto * floored = addFunction(dag, "sparkFloor", {f64});
+            const auto * divided = addFunction(dag, "divide", {floored, addConstant(dag, "Float64", 3.0)});
+            return addFunction(dag, "sparkRint", {divided});
+        });
+}
+
+/// checkDecimalOverflowSparkOrNull(roundHalfUp(d64, 2), 8, 2)
+static void BM_SparkDecimalRoundCheckOverflowChain(benchmark::State & state)
+{
+    runExpression(
+        state,
+        [](ActionsDAG & dag, const ActionsDAG::Node *, const ActionsDAG::Node * d64)
+        {
+            const auto * rounded = addFunction(dag, "roundHalfUp", {d64, addConstant(dag, "Int32", Int64(2))});
+            return addFunction(
+                dag,
+                "checkDecimalOverflowSparkOrNull",
+                {rounded, addConstant(dag, "UInt32", UInt64(8)), addConstant(dag, "UInt32", UInt64(2))});
+        });
+}
+
+BENCHMARK(BM_SparkFloorChain)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SparkRoundHalfUpDivideChain)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SparkRintFloorChain)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SparkDecimalRoundCheckOverflowChain)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,224 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "config.h"
+
+#include <array>
+#include <filesystem>
+#include <future>
+#include <thread>
+#include <IO/CancellableReadBuffer.h>
+#include <IO/CompressionMethod.h>
+#include <IO/ReadHelpers.h>
+#include <IO/SeekableReadBuffer.h>
+#include <IO/WithFileSize.h>
+#include <IO/WriteBufferFromFile.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/SubstraitSource/ReadBufferBuilder.h>
+#include <gtest/gtest.h>
+#include <Common/CancellationToken.h>
+#include <Common/QueryContext.h>
+#include <Common/Stopwatch.h>
+#include <Common/filesystemHelpers.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+constexpr size_t CHUNK_SIZE = 1024;
+constexpr auto CHUNK_DELAY = std::chrono::milliseconds(20);
+
+/// Remote storage stub, which takes CHUNK_DELAY for each chunk, so reading it all takes about 20 seconds.
+class SlowReadBuffer final : public SeekableReadBuffer, public WithFileSize
+{
+public:
+    SlowReadBuffer(size_t size_, std::atomic<bool> & released_) : SeekableReadBuffer(nullptr, 0), size(size_), released(released_) { }
+    ~SlowReadBuffer() override { released = true; }
+
+    bool nextImpl() override
+    {
+        if (offset >= size)
+            return false;
+        std::this_thread::sleep_for(CHUNK_DELAY);
+        const size_t n = std::min(CHUNK_SIZE, size - offset);
+        working_buffer = Buffer(chunk.data(), chunk.data() + n);
+        offset += n;
+        return true;
+    }
+
+    off_t seek(off_t off, int whence) override
+    {
+        chassert(whence == SEEK_SET);
+        offset = off;
+        working_buffer = Buffer(chunk.data(), chunk.data());
+        pos = working_buffer.end();
+        return off;
+    }
+
+    off_t getPosition() override { return offset - available(); }
+
+    bool supportsReadAt() override { return true; }
+
+    size_t readBigAt(char *, size_t n, size_t, const std::function<bool(size_t m)> & progress_callback) const override
+    {
+        size_t read = 0;
+        while (read < n)
+        {
+            std::this_thread::sleep_for(CHUNK_DELAY);
+            read = std::min(read + CHUNK_SIZE, n);
+            if (progress_callback && progress_callback(read))
+                break;
+        }
+        return read;
+    }
+
+    size_t getFileSize() override { return size; }
+
+private:
+    std::array<char, CHUNK_SIZE> chunk{};
+    size_t size;
+    size_t offset = 0;
+    std::atomic<bool> & released;
+};
+
+constexpr size_t FILE_SIZE = 1000 * CHUNK_SIZE;
+
+/// Cancels the token after 100ms.
+std::jthread cancelSoon(const CancellationTokenPtr & token)
+{
+    return std::jthread(
+        [token]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            token->cancel();
+        });
+}
+}
+
+TEST(Cancellation, StopsReadingMidScan)
+{
+    const auto token = std::make_shared<CancellationToken>();
+    std::atomic<bool> released = false;
+    auto in = CancellableReadBuffer::wrap(std::make_unique<SlowReadBuffer>(FILE_SIZE, released), token);
+    ASSERT_NE(dynamic_cast<CancellableReadBuffer *>(in.get()), nullptr);
+
+    const auto canceller = cancelSoon(token);
+    Stopwatch watch;
+    EXPECT_THROW(
+        {
+            while (!in->eof())
+                in->position() = in->buffer().end();
+        },
+        Exception);
+    EXPECT_LT(watch.elapsedMilliseconds(), 1000U);
+
+    /// The task releases the storage buffer as soon as the reader unwinds.
+    in.reset();
+    EXPECT_TRUE(released);
+}
+
+TEST(Cancellation, StopsBigRead)
+{
+    const auto token = std::make_shared<CancellationToken>();
+    std::atomic<bool> released = false;
+    auto in = CancellableReadBuffer::wrap(std::make_unique<SlowReadBuffer>(FILE_SIZE, released), token);
+    auto & seekable = dynamic_cast<SeekableReadBuffer &>(*in);
+    ASSERT_TRUE(seekable.supportsReadAt());
+
+    std::vector<char> to(FILE_SIZE);
+    const auto canceller = cancelSoon(token);
+    Stopwatch watch;
+    EXPECT_THROW(seekable.readBigAt(to.data(), to.size(), 0, nullptr), Exception);
+    EXPECT_LT(watch.elapsedMilliseconds(), 1000U);
+}
+
+TEST(Cancellation, StopsWaiting)
+{
+    const auto token = std::make_shared<CancellationToken>();
+    std::promise<int> never_fulfilled;
+    const auto future = never_fulfilled.get_future().share();
+
+    const auto canceller = cancelSoon(token);
+    Stopwatch watch;
+    EXPECT_THROW(token->get(future), Exception);
+    EXPECT_LT(watch.elapsedMilliseconds(), 1000U);
+
+    /// A token which is not cancelled waits for the result.
+    const auto other = std::make_shared<CancellationToken>();
+    std::promise<int> fulfilled;
+    fulfilled.set_value(42);
+    const auto fulfilled_future = fulfilled.get_future().share();
+    EXPECT_EQ(other->get(fulfilled_future), 42);
+}
+
+TEST(Cancellation, WrapsOnlyWithToken)
+{
+    std::atomic<bool> released = false;
+    auto in = CancellableReadBuffer::wrap(std::make_unique<SlowReadBuffer>(FILE_SIZE, released), nullptr);
+    EXPECT_NE(dynamic_cast<SlowReadBuffer *>(in.get()), nullptr);
+}
+
+#if USE_BZIP2
+TEST(Cancellation, KeepsBzip2SplitsBounded)
+{
+    /// Level 1 compresses in blocks of 100KB, so the file has about 20 blocks.
+    constexpr Int64 ROWS = 300000;
+    const auto tmp_file = createTemporaryFile("/tmp/");
+    const String path = tmp_file->path() + ".bz2";
+    {
+        auto out = wrapWriteBufferWithCompressionMethod(std::make_unique<WriteBufferFromFile>(path), CompressionMethod::Bzip2, 1);
+        for (Int64 i = 0; i < ROWS; ++i)
+        {
+            writeIntText(i, *out);
+            writeChar('\n', *out);
+        }
+        out->finalize();
+    }
+
+    const auto context = QueryContext::globalContext();
+    const auto token = std::make_shared<CancellationToken>();
+    CancellableReadBufferBuilder builder(context, ReadBufferBuilderFactory::instance().createBuilder("file", context), token);
+
+    const size_t file_size = std::filesystem::file_size(path);
+    const size_t middle = file_size / 2;
+    Int64 rows = 0;
+    Int64 sum = 0;
+    for (const auto & [start, length] : {std::pair<size_t, size_t>{0, middle}, {middle, file_size - middle}})
+    {
+        substrait::ReadRel::LocalFiles::FileOrFiles file_info;
+        file_info.set_uri_file("file://" + path);
+        file_info.set_start(start);
+        file_info.set_length(length);
+        file_info.mutable_text();
+
+        auto in = builder.buildWithCompressionWrapper(file_info);
+        while (!in->eof())
+        {
+            Int64 id = 0;
+            readIntText(id, *in);
+            assertChar('\n', *in);
+            ++rows;
+            sum += id;
+        }
+    }
+    std::filesystem::remove(path);
+
+    /// Each row is read by exactly one split.
+    EXPECT_EQ(rows, ROWS);
+    EXPECT_EQ(sum, ROWS * (ROWS - 1) / 2);
+}
+#endif
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 #include <Columns/ColumnSet.h>
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnNullable.h>
 #include <DataTypes/DataTypeFactory.h>
 #include <DataTypes/DataTypeSet.h>
 #include <Functions/FunctionFactory.h>
@@ -191,3 +193,58 @@ TEST(TestFunction, NotIn2)
     debug::headColumn(result2);
     ASSERT_EQ(result2->getUInt(3), 1);
 }
+
+TEST(TestFunction, DecimalArithmeticNarrowing)
+{
+    using namespace DB;
+    auto & factory = FunctionFactory::instance();
+    auto arg_type = DataTypeFactory::instance().get("Decimal(38, 4)");
+
+    /// Values are small enough to be calculated with Int64, unless the huge value is appended to the batch.
+    const std::vector<Int64> left_values = {0, 1, -1, 123456789, -987654321, 1000000000, -999999999};
+    const std::vector<Int64> right_values = {1, 3, -7, 0, 11, -1000000000, 999999999};
+    auto make_args = [&](bool with_huge_value)
+    {
+        auto left = ColumnDecimal<Decimal128>::create(0, 4);
+        auto right = ColumnDecimal<Decimal128>::create(0, 4);
+        for (size_t i = 0; i < left_values.size(); ++i)
+        {
+            left->getData().push_back(Decimal128(left_values[i]));
+            right->getData().push_back(Decimal128(right_values[i]));
+        }
+        if (with_huge_value)
+        {
+            left->getData().push_back(Decimal128(intExp10OfSize<Int128>(37)));
+            right->getData().push_back(Decimal128(intExp10OfSize<Int128>(37)));
+        }
+        return std::make_pair(std::move(left), std::move(right));
+    };
+
+    const std::vector<std::pair<String, String>> functions
+        = {{"sparkDecimalPlus", "Decimal(38, 4)"},
+           {"sparkDecimalMinus", "Decimal(38, 4)"},
+           {"sparkDecimalMultiply", "Decimal(38, 6)"},
+           {"sparkDecimalDivide", "Decimal(38, 6)"},
+           {"sparkDecimalModulo", "Decimal(38, 4)"}};
+    for (const auto & [name, result_type_name] : functions)
+    {
+        auto function = factory.get(name, local_engine::QueryContext::globalContext());
+        auto result_type = DataTypeFactory::instance().get(result_type_name);
+        auto execute = [&](bool with_huge_value)
+        {
+            auto [left, right] = make_args(with_huge_value);
+            size_t rows = left->size();
+            ColumnsWithTypeAndName columns
+                = {ColumnWithTypeAndName(std::move(left), arg_type, "left"),
+                   ColumnWithTypeAndName(std::move(right), arg_type, "right"),
+                   ColumnWithTypeAndName(result_type->createColumnConst(rows, result_type->getDefault()), result_type, "result")};
+            auto executable = function->build(columns);
+            return executable->execute(columns, executable->getResultType(), rows, false);
+        };
+
+        auto narrow = execute(false);
+        auto wide = execute(true);
+        for (size_t i = 0; i < left_values.size(); ++i)
+            ASSERT_EQ((*narrow)[i], (*wide)[i]) << name << " row " << i;
+    }
+}
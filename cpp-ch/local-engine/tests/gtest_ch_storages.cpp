@@ -21,6 +21,7 @@
 #include <Processors/Executors/PullingPipelineExecutor.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Storages/MergeTree/SparkMergeTreeMeta.h>
+#include <Storages/SubstraitSource/FileFooterCache.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
 #include <google/protobuf/util/json_util.h>
 #include <google/protobuf/wrappers.pb.h>
@@ -281,3 +282,66 @@ TEST(TestPrewhere, OptimizePrewhereCondition)
     ASSERT_TRUE(res.front().table_columns.contains("l_discount"));
     ASSERT_TRUE(res.back().table_columns.contains("l_shipdate"));
 }
+
+TEST(FileFooterCache, LRU)
+{
+    FileFooterCache cache(100);
+    size_t loads = 0;
+    auto load = [&](Int64 value, size_t bytes)
+    {
+        return [&loads, value, bytes]() -> FileFooterCache::Loaded<Int64>
+        {
+            ++loads;
+            return {std::make_shared<const Int64>(value), bytes};
+        };
+    };
+    const FileFooterCache::Key a{"file:///a.parquet", 1024, 1};
+    const FileFooterCache::Key b{"file:///b.parquet", 1024, 1};
+    const FileFooterCache::Key c{"file:///c.parquet", 1024, 1};
+
+    EXPECT_EQ(*cache.getOrLoad<Int64>(a, load(1, 40)), 1);
+    EXPECT_EQ(*cache.getOrLoad<Int64>(b, load(2, 40)), 2);
+    EXPECT_EQ(*cache.getOrLoad<Int64>(a, load(-1, 40)), 1);
+    EXPECT_EQ(loads, 2U);
+
+    /// b is the least recently used one.
+    EXPECT_EQ(*cache.getOrLoad<Int64>(c, load(3, 40)), 3);
+    EXPECT_EQ(*cache.getOrLoad<Int64>(a, load(-1, 40)), 1);
+    EXPECT_EQ(*cache.getOrLoad<Int64>(b, load(4, 40)), 4);
+    EXPECT_EQ(loads, 4U);
+
+    /// A rewritten file misses.
+    const FileFooterCache::Key rewritten_a{"file:///a.parquet", 1024, 2};
+    EXPECT_EQ(*cache.getOrLoad<Int64>(rewritten_a, load(5, 40)), 5);
+
+    /// Files without a key and footers larger than the cache are never cached.
+    EXPECT_EQ(*cache.getOrLoad<Int64>(std::nullopt, load(6, 40)), 6);
+    const FileFooterCache::Key d{"file:///d.parquet", 1024, 1};
+    EXPECT_EQ(*cache.getOrLoad<Int64>(d, load(7, 200)), 7);
+    EXPECT_EQ(*cache.getOrLoad<Int64>(d, load(8, 200)), 8);
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 2U);
+    EXPECT_EQ(stats.misses, 7U);
+    EXPECT_EQ(stats.evictions, 3U);
+    EXPECT_EQ(stats.entries, 2U);
+    EXPECT_EQ(stats.bytes, 80U);
+}
+
+TEST(FileFooterCache, KeyedByType)
+{
+    FileFooterCache cache(100);
+    const FileFooterCache::Key key{"file:///a.orc", 1024, 1};
+    auto load_int = []() -> FileFooterCache::Loaded<Int64> { return {std::make_shared<const Int64>(1), 8}; };
+    auto load_string = []() -> FileFooterCache::Loaded<String> { return {std::make_shared<const String>("footer"), 8}; };
+
+    /// The same file cached as two types of footers doesn't return one as the other.
+    EXPECT_EQ(*cache.getOrLoad<Int64>(key, load_int), 1);
+    EXPECT_EQ(*cache.getOrLoad<String>(key, load_string), "footer");
+    EXPECT_EQ(*cache.getOrLoad<Int64>(key, load_int), 1);
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 1U);
+    EXPECT_EQ(stats.misses, 2U);
+    EXPECT_EQ(stats.entries, 2U);
+}
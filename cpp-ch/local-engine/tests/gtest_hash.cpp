@@ -14,6 +14,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeArray.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/SparkFunctionBucketId.h>
 #include <Functions/SparkFunctionHashingExtended.h>
 #include <base/types.h>
 #include <gtest/gtest.h>
@@ -36,3 +44,43 @@ TEST(Hash, SparkMurmurHash3_32)
         EXPECT_EQ(static_cast<Int32>(result), -1346355085);
     }
 }
+
+TEST(Hash, SparkBucketId)
+{
+    /// Rows (1, 'abc') and (null, 'abc').
+    auto ints = ColumnInt32::create();
+    ints->insert(1);
+    ints->insert(0);
+    auto null_map = ColumnUInt8::create();
+    null_map->insert(0);
+    null_map->insert(1);
+    auto strings = ColumnString::create();
+    strings->insert(String("abc"));
+    strings->insert(String("abc"));
+    ColumnsWithTypeAndName columns{
+        {ColumnNullable::create(std::move(ints), std::move(null_map)), makeNullable(std::make_shared<DataTypeInt32>()), "id"},
+        {std::move(strings), std::make_shared<DataTypeString>(), "name"}};
+
+    /// pmod(hash(id, name), 8): murmur3 skips the null.
+    auto bucket_ids = SparkBucketHasher::bucketIds(columns, 8, false);
+    EXPECT_EQ(bucket_ids->getInt(0), 6);
+    EXPECT_EQ(bucket_ids->getInt(1), 4);
+
+    /// hive_hash(id, name), where null hashes as 0, and its bucket id with 8 buckets.
+    SparkBucketHasher::Hashes hashes(2, 0);
+    for (const auto & column : columns)
+        SparkBucketHasher::hive(column, hashes);
+    EXPECT_EQ(hashes[0], 96385);
+    EXPECT_EQ(hashes[1], 96354);
+    bucket_ids = SparkBucketHasher::bucketIds(columns, 8, true);
+    EXPECT_EQ(bucket_ids->getInt(0), 1);
+    EXPECT_EQ(bucket_ids->getInt(1), 2);
+}
+
+TEST(Hash, SparkBucketIdSupportedTypes)
+{
+    EXPECT_TRUE(SparkBucketHasher::isSupported(makeNullable(std::make_shared<DataTypeInt64>())));
+    EXPECT_TRUE(SparkBucketHasher::isSupported(std::make_shared<DataTypeString>()));
+    EXPECT_FALSE(SparkBucketHasher::isSupported(std::make_shared<DataTypeArray>(std::make_shared<DataTypeInt32>())));
+    EXPECT_FALSE(SparkBucketHasher::isSupported(std::make_shared<DataTypeUInt64>()));
+}
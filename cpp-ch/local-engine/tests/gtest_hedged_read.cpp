@@ -0,0 +1,230 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thread>
+#include <IO/HedgedReadBuffer.h>
+#include <gtest/gtest.h>
+#include <Common/Stopwatch.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+constexpr size_t FILE_SIZE = 1 << 20;
+constexpr size_t BUFFER_SIZE = 64 << 10;
+constexpr UInt64 TYPICAL_LATENCY_US = 10'000;
+
+char byteAt(size_t offset)
+{
+    return static_cast<char>(offset % 251);
+}
+
+/// Remote storage stub, whose positional reads take `latency`, checking the progress callback every millisecond. Counts
+/// the reads the callback stopped in `interrupted`.
+class DelayedReadBuffer final : public ReadBufferFromFileBase
+{
+public:
+    DelayedReadBuffer(std::chrono::milliseconds latency_, std::atomic<size_t> & interrupted_)
+        : ReadBufferFromFileBase(0, nullptr, 0), latency(latency_), interrupted(interrupted_)
+    {
+    }
+
+    bool nextImpl() override { return false; }
+    off_t seek(off_t off, int) override { return off; }
+    off_t getPosition() override { return 0; }
+    String getFileName() const override { return "delayed"; }
+    size_t getFileSize() override { return FILE_SIZE; }
+
+    bool supportsReadAt() override { return true; }
+
+    size_t readBigAt(char * to, size_t n, size_t offset, const std::function<bool(size_t m)> & progress_callback) const override
+    {
+        Stopwatch watch;
+        while (watch.elapsedMilliseconds() < static_cast<UInt64>(latency.count()))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (progress_callback && progress_callback(0))
+            {
+                ++interrupted;
+                return 0;
+            }
+        }
+        n = std::min(n, FILE_SIZE - std::min(offset, FILE_SIZE));
+        for (size_t i = 0; i < n; ++i)
+            to[i] = byteAt(offset + i);
+        return n;
+    }
+
+private:
+    std::chrono::milliseconds latency;
+    std::atomic<size_t> & interrupted;
+};
+
+struct HedgedReadTest
+{
+    std::shared_ptr<HedgedReadStorage> storage = std::make_shared<HedgedReadStorage>();
+    HedgeBudget budget;
+    HedgedReadConfig config;
+    std::atomic<size_t> backups_opened = 0;
+    std::atomic<size_t> interrupted = 0;
+
+    HedgedReadTest()
+    {
+        config.enabled = true;
+        for (size_t i = 0; i < config.min_samples; ++i)
+            storage->latencies.record(TYPICAL_LATENCY_US);
+    }
+
+    std::unique_ptr<HedgedReadBuffer> open(std::chrono::milliseconds primary_latency, std::chrono::milliseconds backup_latency)
+    {
+        return std::make_unique<HedgedReadBuffer>(
+            std::make_unique<DelayedReadBuffer>(primary_latency, interrupted),
+            [this, backup_latency]()
+            {
+                ++backups_opened;
+                return std::make_unique<DelayedReadBuffer>(backup_latency, interrupted);
+            },
+            storage,
+            budget,
+            config,
+            BUFFER_SIZE);
+    }
+};
+
+void expectRange(const std::vector<char> & data, size_t offset)
+{
+    for (size_t i = 0; i < data.size(); ++i)
+        ASSERT_EQ(data[i], byteAt(offset + i)) << "at " << offset + i;
+}
+}
+
+TEST(HedgedRead, LatencyPercentile)
+{
+    ReadLatencyHistogram histogram;
+    for (size_t i = 0; i < 95; ++i)
+        histogram.record(1'000);
+    EXPECT_FALSE(histogram.percentile(0.95, 100));
+
+    for (size_t i = 0; i < 5; ++i)
+        histogram.record(100'000);
+    const auto p95 = histogram.percentile(0.95, 100);
+    ASSERT_TRUE(p95);
+    EXPECT_GE(*p95, 1'000U);
+    EXPECT_LT(*p95, 1'500U);
+    EXPECT_GE(*histogram.percentile(0.99, 100), 100'000U);
+}
+
+TEST(HedgedRead, LatencyPercentileFollowsRecentReads)
+{
+    ReadLatencyHistogram histogram;
+    for (size_t i = 0; i < ReadLatencyHistogram::WINDOW; ++i)
+        histogram.record(1'000);
+    EXPECT_LT(*histogram.percentile(0.5, 1), 1'500U);
+
+    /// The storage slows down: after two windows, most of the counts are slow reads.
+    for (size_t i = 0; i < 2 * ReadLatencyHistogram::WINDOW; ++i)
+        histogram.record(100'000);
+    EXPECT_GE(*histogram.percentile(0.5, 1), 100'000U);
+}
+
+TEST(HedgedRead, HedgesSlowRead)
+{
+    HedgedReadTest test;
+    test.budget.earn(1);
+    auto in = test.open(std::chrono::seconds(5), std::chrono::milliseconds(1));
+
+    std::vector<char> to(100'000);
+    Stopwatch watch;
+    EXPECT_EQ(in->readBigAt(to.data(), to.size(), 1'000, nullptr), to.size());
+    EXPECT_LT(watch.elapsedMilliseconds(), 1'000U);
+    expectRange(to, 1'000);
+    EXPECT_EQ(test.backups_opened, 1U);
+    EXPECT_EQ(test.storage->hedges, 1U);
+    EXPECT_EQ(test.storage->hedge_wins, 1U);
+
+    /// The cancelled primary read still counts with the time it had taken.
+    EXPECT_GE(*test.storage->latencies.percentile(1.0, 1), TYPICAL_LATENCY_US);
+}
+
+TEST(HedgedRead, CallerStopsEveryAttempt)
+{
+    HedgedReadTest test;
+    test.budget.earn(1);
+    auto in = test.open(std::chrono::seconds(5), std::chrono::seconds(5));
+
+    /// The caller gives up once the hedge was issued, which stops the primary read and the hedge alike.
+    std::vector<char> to(1'000);
+    Stopwatch watch;
+    in->readBigAt(to.data(), to.size(), 0, [&](size_t) { return watch.elapsedMilliseconds() > 200; });
+    EXPECT_LT(watch.elapsedMilliseconds(), 1'000U);
+    EXPECT_EQ(test.storage->hedges, 1U);
+    while (test.interrupted < 2 && watch.elapsedMilliseconds() < 2'000)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(test.interrupted, 2U);
+    EXPECT_EQ(test.storage->hedge_wins, 0U);
+}
+
+TEST(HedgedRead, DoesNotHedgeFastRead)
+{
+    HedgedReadTest test;
+    test.budget.earn(1);
+    auto in = test.open(std::chrono::milliseconds(1), std::chrono::milliseconds(1));
+
+    std::vector<char> data;
+    while (!in->eof())
+    {
+        data.insert(data.end(), in->position(), in->buffer().end());
+        in->position() = in->buffer().end();
+    }
+    EXPECT_EQ(data.size(), FILE_SIZE);
+    expectRange(data, 0);
+    EXPECT_EQ(test.storage->reads, FILE_SIZE / BUFFER_SIZE);
+    EXPECT_EQ(test.storage->hedges, 0U);
+    EXPECT_EQ(test.backups_opened, 0U);
+}
+
+TEST(HedgedRead, RespectsBudget)
+{
+    HedgedReadTest test;
+    test.config.budget_ratio = 0;
+    auto in = test.open(std::chrono::milliseconds(200), std::chrono::milliseconds(1));
+
+    std::vector<char> to(1'000);
+    Stopwatch watch;
+    EXPECT_EQ(in->readBigAt(to.data(), to.size(), 0, nullptr), to.size());
+    EXPECT_GE(watch.elapsedMilliseconds(), 200U);
+    expectRange(to, 0);
+    EXPECT_EQ(test.storage->hedges, 0U);
+    EXPECT_EQ(test.backups_opened, 0U);
+}
+
+TEST(HedgedRead, ReadsRangeAfterSeek)
+{
+    HedgedReadTest test;
+    auto in = test.open(std::chrono::milliseconds(0), std::chrono::milliseconds(0));
+    in->seek(FILE_SIZE - 100, SEEK_SET);
+    in->setReadUntilPosition(FILE_SIZE - 10);
+
+    std::vector<char> data;
+    while (!in->eof())
+    {
+        data.insert(data.end(), in->position(), in->buffer().end());
+        in->position() = in->buffer().end();
+    }
+    EXPECT_EQ(data.size(), 90U);
+    expectRange(data, FILE_SIZE - 100);
+}
@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+
+#if USE_ORC
+
+#include <filesystem>
+
+#include <Interpreters/ActionsDAG.h>
+#include <Interpreters/ExpressionActions.h>
+#include <Storages/MergeTree/KeyCondition.h>
+#include <Storages/SubstraitSource/ORCFormatFile.h>
+#include <Storages/SubstraitSource/OrcUtil.h>
+#include <Storages/SubstraitSource/ReadBufferBuilder.h>
+#include <gtest/gtest.h>
+#include <tests/gluten_test_util.h>
+#include <Common/BlockTypeUtils.h>
+#include <Common/QueryContext.h>
+#include <Common/filesystemHelpers.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+constexpr size_t ROWS_PER_STRIPE = 1000;
+constexpr size_t STRIPES = 4;
+
+/// Writes STRIPES stripes, where stripe i has ids [i * 1000, (i + 1) * 1000) and names 'name_<i>', except for the last
+/// stripe whose names are all null.
+void writeOrcFile(const String & path)
+{
+    const auto type = orc::Type::buildTypeFromString("struct<id:bigint,name:string>");
+    auto out = orc::writeLocalFile(path);
+    orc::WriterOptions options;
+    /// Flush a stripe after every batch.
+    options.setStripeSize(1);
+    options.setRowIndexStride(100);
+    auto writer = orc::createWriter(*type, out.get(), options);
+
+    auto batch = writer->createRowBatch(ROWS_PER_STRIPE);
+    auto & root = dynamic_cast<orc::StructVectorBatch &>(*batch);
+    auto & ids = dynamic_cast<orc::LongVectorBatch &>(*root.fields[0]);
+    auto & names = dynamic_cast<orc::StringVectorBatch &>(*root.fields[1]);
+    for (size_t stripe = 0; stripe < STRIPES; ++stripe)
+    {
+        const String name = "name_" + std::to_string(stripe);
+        const bool null_names = stripe == STRIPES - 1;
+        for (size_t i = 0; i < ROWS_PER_STRIPE; ++i)
+        {
+            ids.data[i] = static_cast<int64_t>(stripe * ROWS_PER_STRIPE + i);
+            names.data[i] = const_cast<char *>(name.data());
+            names.length[i] = static_cast<int64_t>(name.size());
+            names.notNull[i] = !null_names;
+        }
+        names.hasNulls = null_names;
+        root.numElements = ids.numElements = names.numElements = ROWS_PER_STRIPE;
+        writer->add(*batch);
+    }
+    writer->close();
+}
+
+std::vector<size_t> requiredStripes(const String & path, const String & filter)
+{
+    const Block header = makeBlockHeader({{wrapNullableType(BIGINT()), "id"}, {wrapNullableType(STRING()), "name"}});
+    const auto filter_dag = test::parseFilter(filter, blockToNameAndTypeList(header));
+    const KeyCondition key_condition(
+        &*filter_dag,
+        QueryContext::globalContext(),
+        header.getNames(),
+        std::make_shared<ExpressionActions>(ActionsDAG(header.getColumnsWithTypeAndName())));
+
+    const auto reader = orc::createReader(orc::readLocalFile(path), orc::ReaderOptions{});
+    const auto column_ids = OrcUtil::getColumnIds(reader->getType());
+    std::vector<size_t> stripes;
+    for (size_t i = 0; i < reader->getNumberOfStripeStatistics(); ++i)
+        if (OrcUtil::mayMatch(key_condition, header, column_ids, *reader->getStripeStatistics(i)))
+            stripes.push_back(i);
+    return stripes;
+}
+}
+
+TEST(OrcRead, PruneStripesByStatistics)
+{
+    const auto tmp_file = createTemporaryFile("/tmp/");
+    const String path = tmp_file->path();
+    writeOrcFile(path);
+    ASSERT_EQ(orc::createReader(orc::readLocalFile(path), orc::ReaderOptions{})->getNumberOfStripes(), STRIPES);
+
+    EXPECT_EQ(requiredStripes(path, "id = 1500"), std::vector<size_t>({1}));
+    EXPECT_EQ(requiredStripes(path, "id = 1500 or id = 3500"), std::vector<size_t>({1, 3}));
+    EXPECT_EQ(requiredStripes(path, "id >= 2500"), std::vector<size_t>({2, 3}));
+    EXPECT_EQ(requiredStripes(path, "id < 0"), std::vector<size_t>());
+    EXPECT_EQ(requiredStripes(path, "name = 'name_0'"), std::vector<size_t>({0}));
+    EXPECT_EQ(requiredStripes(path, "name is null"), std::vector<size_t>({3}));
+    EXPECT_EQ(requiredStripes(path, "id < 1000 and name = 'name_2'"), std::vector<size_t>());
+}
+
+TEST(OrcRead, ReportPrunedStripes)
+{
+    const auto tmp_file = createTemporaryFile("/tmp/");
+    const String path = tmp_file->path();
+    writeOrcFile(path);
+
+    substrait::ReadRel::LocalFiles::FileOrFiles file_info;
+    file_info.set_uri_file("file://" + path);
+    file_info.set_start(0);
+    file_info.set_length(std::filesystem::file_size(path));
+    file_info.mutable_orc();
+
+    const auto context = QueryContext::globalContext();
+    const Block header = makeBlockHeader({{wrapNullableType(BIGINT()), "id"}, {wrapNullableType(STRING()), "name"}});
+    const auto filter_dag = test::parseFilter("id = 1500 or id = 3500", blockToNameAndTypeList(header));
+    const auto key_condition = std::make_shared<const KeyCondition>(
+        &*filter_dag, context, header.getNames(), std::make_shared<ExpressionActions>(ActionsDAG(header.getColumnsWithTypeAndName())));
+
+    const auto scan_stats = std::make_shared<FileScanStats>();
+    ORCFormatFile file(context, file_info, ReadBufferBuilderFactory::instance().createBuilder("file", context));
+    file.setKeyCondition(key_condition);
+    file.setScanStats(scan_stats);
+    file.createInputFormat(header);
+    EXPECT_EQ(scan_stats->total_stripes, STRIPES);
+    EXPECT_EQ(scan_stats->pruned_stripes, STRIPES - 2);
+}
+
+#endif
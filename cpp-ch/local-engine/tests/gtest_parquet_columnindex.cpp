@@ -31,8 +31,12 @@
 #include <Storages/Parquet/ParquetConverter.h>
 #include <Storages/Parquet/RowRanges.h>
 #include <Storages/Parquet/VectorizedParquetRecordReader.h>
+#include <arrow/builder.h>
+#include <arrow/io/memory.h>
+#include <arrow/table.h>
 #include <boost/iterator/counting_iterator.hpp>
 #include <gtest/gtest.h>
+#include <parquet/arrow/writer.h>
 #include <parquet/page_index.h>
 #include <parquet/schema.h>
 #include <parquet/statistics.h>
@@ -1124,4 +1128,77 @@ TEST(ColumnIndex, VectorizedParquetRecordReader)
     } while (chunk.getNumRows() > 0);
 }
 
+namespace
+{
+/// A dictionary encoded parquet file in memory, whose row group `i` has the status (char)('A' + i) in all of its rows.
+std::shared_ptr<arrow::io::RandomAccessFile> makeDictionaryEncodedParquet(const int64_t row_groups, const int64_t rows_per_group)
+{
+    arrow::StringBuilder status_builder;
+    arrow::Int64Builder id_builder;
+    for (int64_t rg = 0; rg < row_groups; ++rg)
+    {
+        for (int64_t i = 0; i < rows_per_group; ++i)
+        {
+            THROW_ARROW_NOT_OK(status_builder.Append(std::string(1, static_cast<char>('A' + rg))));
+            THROW_ARROW_NOT_OK(id_builder.Append(rg * rows_per_group + i));
+        }
+    }
+    std::shared_ptr<arrow::Array> status;
+    std::shared_ptr<arrow::Array> id;
+    THROW_ARROW_NOT_OK(status_builder.Finish(&status));
+    THROW_ARROW_NOT_OK(id_builder.Finish(&id));
+    const auto schema = arrow::schema({arrow::field("status", arrow::utf8(), false), arrow::field("id", arrow::int64(), false)});
+    const auto table = arrow::Table::Make(schema, {status, id});
+
+    THROW_ARROW_NOT_OK_OR_ASSIGN(const auto sink, arrow::io::BufferOutputStream::Create());
+    const auto properties = parquet::WriterProperties::Builder().enable_dictionary()->build();
+    THROW_ARROW_NOT_OK(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), sink, rows_per_group, properties));
+    THROW_ARROW_NOT_OK_OR_ASSIGN(const auto buffer, sink->Finish());
+    return std::make_shared<arrow::io::BufferReader>(buffer);
+}
+
+/// Returns the number of rows read with the filter, and the distinct statuses of them.
+std::pair<size_t, std::set<std::string>> readWithDictionaryFilter(const std::string & filter, const FormatSettings & format_settings)
+{
+    static const AnotherRowType name_and_types{{"status", STRING()}, {"id", BIGINT()}};
+    const auto arrow_file = makeDictionaryEncodedParquet(8, 1000);
+    const auto column_index_filter = std::make_shared<local_engine::ColumnIndexFilter>(
+        local_engine::test::parseFilter(filter, name_and_types).value(), local_engine::QueryContext::globalContext());
+
+    const Block header({{STRING(), "status"}, {BIGINT(), "id"}});
+    local_engine::VectorizedParquetRecordReader record_reader(header, format_settings);
+    record_reader.initialize(header, arrow_file, column_index_filter);
+
+    size_t rows = 0;
+    std::set<std::string> statuses;
+    for (auto chunk = record_reader.nextBatch(); chunk.getNumRows() > 0; chunk = record_reader.nextBatch())
+    {
+        const auto & status = *chunk.getColumns()[0];
+        for (size_t i = 0; i < chunk.getNumRows(); ++i)
+            statuses.emplace(status.getDataAt(i).toView());
+        rows += chunk.getNumRows();
+    }
+    return {rows, statuses};
+}
+}
+
+TEST(ColumnIndex, SkipRowGroupsByDictionary)
+{
+    const FormatSettings format_settings{};
+
+    EXPECT_EQ(readWithDictionaryFilter("status = 'C'", format_settings), std::make_pair(1000UL, std::set<std::string>{"C"}));
+    EXPECT_EQ(readWithDictionaryFilter("status = 'Z'", format_settings).first, 0UL);
+    EXPECT_EQ(readWithDictionaryFilter("status in ('B', 'F', 'Z')", format_settings).second, (std::set<std::string>{"B", "F"}));
+    EXPECT_EQ(readWithDictionaryFilter("status > 'F'", format_settings).second, (std::set<std::string>{"G", "H"}));
+    EXPECT_EQ(readWithDictionaryFilter("status = 'A' or id >= 7500", format_settings).second, (std::set<std::string>{"A", "H"}));
+    EXPECT_EQ(readWithDictionaryFilter("status = 'D' and id < 1000", format_settings).first, 0UL);
+
+    /// Row groups are not skipped on negations, and the rows of the kept row groups are filtered later.
+    EXPECT_EQ(readWithDictionaryFilter("not (status = 'C')", format_settings).first, 8000UL);
+
+    FormatSettings no_filter_push_down{};
+    no_filter_push_down.parquet.filter_push_down = false;
+    EXPECT_EQ(readWithDictionaryFilter("status = 'Z'", no_filter_push_down).first, 8000UL);
+}
+
 #endif //USE_PARQUET
\ No newline at end of file
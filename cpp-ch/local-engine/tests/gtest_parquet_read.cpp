@@ -19,6 +19,7 @@
 
 #if USE_PARQUET
 
+#include <filesystem>
 #include <ranges>
 #include <incbin.h>
 #include <Core/Range.h>
@@ -36,15 +37,30 @@
 #include <Processors/Formats/Impl/ArrowColumnToCHColumn.h>
 #include <Processors/Formats/Impl/ParquetBlockInputFormat.h>
 #include <QueryPipeline/QueryPipeline.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Storages/Parquet/ArrowUtils.h>
 #include <Storages/Parquet/VectorizedParquetRecordReader.h>
 #include <Storages/SubstraitSource/ParquetFormatFile.h>
+#include <Storages/SubstraitSource/SubstraitFileSource.h>
+#include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/table.h>
 #include <gtest/gtest.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/arrow/writer.h>
 #include <parquet/level_conversion.h>
+#include <Poco/URI.h>
 #include <tests/gluten_test_util.h>
 #include <Common/BlockTypeUtils.h>
 #include <Common/DebugUtils.h>
+#include <Common/ProfileEvents.h>
+#include <Common/QueryContext.h>
+#include <Common/filesystemHelpers.h>
+
+namespace ProfileEvents
+{
+extern const Event ReadBufferFromFileDescriptorReadBytes;
+}
 
 using namespace DB;
 
@@ -460,4 +476,202 @@ TEST(ParquetRead, UpperColRead)
 
     debug::headBlock(block);
 }
+namespace
+{
+constexpr int64_t ROW_GROUPS = 32;
+constexpr int64_t ROWS_PER_GROUP = 65536;
+
+/// Writes ROW_GROUPS plain encoded row groups, where row group i has ids [i * ROWS_PER_GROUP, (i + 1) * ROWS_PER_GROUP).
+void writeRowGroups(const String & path)
+{
+    arrow::Int64Builder id_builder;
+    for (int64_t id = 0; id < ROW_GROUPS * ROWS_PER_GROUP; ++id)
+        THROW_ARROW_NOT_OK(id_builder.Append(id));
+    std::shared_ptr<arrow::Array> id;
+    THROW_ARROW_NOT_OK(id_builder.Finish(&id));
+    const auto table = arrow::Table::Make(arrow::schema({arrow::field("id", arrow::int64(), false)}), {id});
+
+    THROW_ARROW_NOT_OK_OR_ASSIGN(const auto sink, arrow::io::FileOutputStream::Open(path));
+    const auto properties = parquet::WriterProperties::Builder().disable_dictionary()->build();
+    THROW_ARROW_NOT_OK(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), sink, ROWS_PER_GROUP, properties));
+    THROW_ARROW_NOT_OK(sink->Close());
+}
+
+struct ScanResult
+{
+    size_t rows = 0;
+    Int64 id_sum = 0;
+    UInt64 read_bytes = 0;
+};
+
+ScanResult scan(const String & uri, const std::function<void(local_engine::SubstraitFileSource &)> & push_down)
+{
+    substrait::ReadRel::LocalFiles files;
+    auto * file = files.add_items();
+    file->set_uri_file(uri);
+    file->set_start(0);
+    file->set_length(std::filesystem::file_size(Poco::URI(uri).getPath()));
+    file->mutable_parquet();
+
+    const Block header({{local_engine::BIGINT(), "id"}});
+    const auto source = std::make_shared<local_engine::SubstraitFileSource>(local_engine::QueryContext::globalContext(), header, files);
+    push_down(*source);
+
+    QueryPipelineBuilder builder;
+    builder.init(Pipe(source));
+    auto pipeline = QueryPipelineBuilder::getPipeline(std::move(builder));
+    PullingPipelineExecutor executor(pipeline);
+
+    const auto & read_bytes = ProfileEvents::global_counters[ProfileEvents::ReadBufferFromFileDescriptorReadBytes];
+    const UInt64 read_bytes_before = read_bytes.load();
+    ScanResult result;
+    Block block;
+    while (executor.pull(block))
+    {
+        const auto & id = *block.getByName("id").column;
+        for (size_t i = 0; i < block.rows(); ++i)
+            result.id_sum += id.getInt(i);
+        result.rows += block.rows();
+    }
+    result.read_bytes = read_bytes.load() - read_bytes_before;
+    return result;
+}
+}
+
+TEST(ParquetRead, BlockSampleAndRowLimitPushDown)
+{
+    const auto tmp_file = createTemporaryFile("/tmp/");
+    writeRowGroups(tmp_file->path());
+    const String uri = "file://" + tmp_file->path();
+
+    const auto full = scan(uri, [](local_engine::SubstraitFileSource &) { });
+    EXPECT_EQ(full.rows, static_cast<size_t>(ROW_GROUPS * ROWS_PER_GROUP));
+
+    const local_engine::BlockSample sample{.upper_bound = 0.25, .seed = 42};
+    size_t chosen_rows = 0;
+    for (int64_t rg = 0; rg < ROW_GROUPS; ++rg)
+        chosen_rows += sample.chooses(uri, rg) ? ROWS_PER_GROUP : 0;
+    ASSERT_GT(chosen_rows, 0UL);
+    ASSERT_LT(chosen_rows, full.rows);
+
+    const auto sampled = scan(uri, [&](local_engine::SubstraitFileSource & source) { ASSERT_TRUE(source.setBlockSample(sample)); });
+    EXPECT_EQ(sampled.rows, chosen_rows);
+    EXPECT_LT(sampled.read_bytes, full.read_bytes);
+
+    /// Adjacent ranges with the same seed, as the samples of randomSplit, choose each row group exactly once.
+    const std::vector<local_engine::BlockSample> splits{
+        {.upper_bound = 0.25, .seed = 42}, {.lower_bound = 0.25, .upper_bound = 0.6, .seed = 42}, {.lower_bound = 0.6, .seed = 42}};
+    for (int64_t rg = 0; rg < ROW_GROUPS; ++rg)
+        EXPECT_EQ(std::ranges::count_if(splits, [&](const auto & split) { return split.chooses(uri, rg); }), 1);
+
+    /// The same seed samples the same rows.
+    const auto resampled = scan(uri, [&](local_engine::SubstraitFileSource & source) { source.setBlockSample(sample); });
+    EXPECT_EQ(resampled.rows, sampled.rows);
+    EXPECT_EQ(resampled.id_sum, sampled.id_sum);
+
+    /// The scan stops at the row group which reaches the limit.
+    const auto limited = scan(uri, [](local_engine::SubstraitFileSource & source) { source.setRowLimit(ROWS_PER_GROUP + 1); });
+    EXPECT_EQ(limited.rows, static_cast<size_t>(2 * ROWS_PER_GROUP));
+    EXPECT_EQ(limited.id_sum, (2 * ROWS_PER_GROUP - 1) * ROWS_PER_GROUP);
+    EXPECT_LT(limited.read_bytes, full.read_bytes / 4);
+}
+
+namespace
+{
+constexpr std::string_view READ_ID_REL = R"({"read": {"common": {"direct": {}},
+    "baseSchema": {"names": ["id"], "struct": {"types": [{"i64": {"nullability": "NULLABILITY_REQUIRED"}}]}, "columnTypes": ["NORMAL_COL"]},
+    "advancedExtension": {"optimization": {"@type": "type.googleapis.com/google.protobuf.StringValue", "value": "isMergeTree=0\n"}}}})";
+
+/// `rand(42) < 0.25` on READ_ID_REL, marked as the sample of a SampleExec if `is_sample`.
+std::string sampleRel(bool is_sample)
+{
+    constexpr std::string_view filter = R"({"filter": {"common": {"direct": {}}, "input": {input},
+    "condition": {"scalarFunction": {"functionReference": 1, "outputType": {"bool": {"nullability": "NULLABILITY_REQUIRED"}},
+      "arguments": [
+        {"value": {"scalarFunction": {"functionReference": 2, "outputType": {"fp64": {"nullability": "NULLABILITY_REQUIRED"}},
+          "arguments": [{"value": {"literal": {"i64": "42"}}}]}}},
+        {"value": {"literal": {"fp64": 0.25}}}]}}{extension}}})";
+    constexpr std::string_view sample_extension = R"(, "advancedExtension": {"optimization": {
+    "@type": "type.googleapis.com/google.protobuf.StringValue", "value": "isSample=1\n"}})";
+    auto rel = boost::replace_all_copy(std::string{filter}, "{input}", std::string{READ_ID_REL});
+    return boost::replace_all_copy(rel, "{extension}", is_sample ? std::string{sample_extension} : "");
+}
+
+std::string planJson(const std::string & rel)
+{
+    constexpr std::string_view plan = R"({"extensions": [
+    {"extensionFunction": {"functionAnchor": 1, "name": "lt:fp64_fp64"}},
+    {"extensionFunction": {"functionAnchor": 2, "name": "rand:i64"}}],
+  "relations": [{"root": {"input": {rel}, "names": ["id"],
+    "outputSchema": {"types": [{"i64": {"nullability": "NULLABILITY_REQUIRED"}}], "nullability": "NULLABILITY_REQUIRED"}}}]})";
+    return boost::replace_all_copy(std::string{plan}, "{rel}", rel);
+}
+
+ScanResult scanPlan(const String & uri, const std::string & rel)
+{
+    const auto size = std::to_string(std::filesystem::file_size(Poco::URI(uri).getPath()));
+    const std::string split = R"({"items": [{"uriFile": ")" + uri + R"(", "start": "0", "length": ")" + size
+        + R"(", "parquet": {}, "schema": {}, "properties": {"fileSize": ")" + size + R"(", "modificationTime": "0"}}]})";
+    auto [_, executor] = local_engine::test::create_plan_and_executor(planJson(rel), split);
+
+    const auto & read_bytes = ProfileEvents::global_counters[ProfileEvents::ReadBufferFromFileDescriptorReadBytes];
+    const UInt64 read_bytes_before = read_bytes.load();
+    ScanResult result;
+    while (executor->hasNext())
+    {
+        const Block & block = *executor->nextColumnar();
+        const auto & id = *block.getByPosition(0).column;
+        for (size_t i = 0; i < block.rows(); ++i)
+            result.id_sum += id.getInt(i);
+        result.rows += block.rows();
+    }
+    result.read_bytes = read_bytes.load() - read_bytes_before;
+    return result;
+}
+}
+
+/// gtest_local_engine_config.json enables scan.enable_block_sample.
+TEST(ParquetRead, SampleFilterPushDown)
+{
+    const auto tmp_file = createTemporaryFile("/tmp/");
+    writeRowGroups(tmp_file->path());
+    const String uri = "file://" + tmp_file->path();
+
+    const auto full = scanPlan(uri, std::string{READ_ID_REL});
+    EXPECT_EQ(full.rows, static_cast<size_t>(ROW_GROUPS * ROWS_PER_GROUP));
+
+    /// The sample of a SampleExec reads the row groups chosen with its seed and fraction.
+    const local_engine::BlockSample sample{.upper_bound = 0.25, .seed = 42};
+    size_t chosen_rows = 0;
+    for (int64_t rg = 0; rg < ROW_GROUPS; ++rg)
+        chosen_rows += sample.chooses(uri, rg) ? ROWS_PER_GROUP : 0;
+    const auto sampled = scanPlan(uri, sampleRel(true));
+    EXPECT_EQ(sampled.rows, chosen_rows);
+    EXPECT_LT(sampled.read_bytes, full.read_bytes);
+
+    /// The same condition in a filter of the query samples rows, and reads the whole file.
+    const auto filtered = scanPlan(uri, sampleRel(false));
+    EXPECT_GT(filtered.rows, 0UL);
+    EXPECT_LT(filtered.rows, full.rows);
+    EXPECT_NE(filtered.rows, chosen_rows);
+    EXPECT_GT(filtered.read_bytes, full.read_bytes * 9 / 10);
+}
+
+TEST(ParquetRead, FetchPushDown)
+{
+    const auto tmp_file = createTemporaryFile("/tmp/");
+    writeRowGroups(tmp_file->path());
+    const String uri = "file://" + tmp_file->path();
+
+    const auto full = scanPlan(uri, std::string{READ_ID_REL});
+    const auto fetch = boost::replace_all_copy(
+        std::string{R"({"fetch": {"common": {"direct": {}}, "input": {input}, "offset": "10", "count": "100"}})"},
+        "{input}",
+        std::string{READ_ID_REL});
+    const auto limited = scanPlan(uri, fetch);
+    EXPECT_EQ(limited.rows, 100UL);
+    EXPECT_EQ(limited.id_sum, (10 + 109) * 100 / 2);
+    /// Only the first row group is read.
+    EXPECT_LT(limited.read_bytes, full.read_bytes / 4);
+}
 #endif
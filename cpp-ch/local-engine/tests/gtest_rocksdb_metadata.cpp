@@ -0,0 +1,127 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <config.h>
+
+#if USE_ROCKSDB
+
+#include <Disks/ObjectStorages/MetadataStorageFromRocksDBTransactionOperations.h>
+#include <gtest/gtest.h>
+#include <Poco/TemporaryFile.h>
+#include <Common/SharedMutex.h>
+
+using namespace local_engine;
+
+namespace
+{
+class RocksDBMetadata : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        rocksdb::Options options;
+        options.create_if_missing = true;
+        rocksdb::DB * raw_db = nullptr;
+        throwRockDBErrorNotOk(rocksdb::DB::Open(options, dir.path(), &raw_db));
+        db.reset(raw_db);
+    }
+
+    /// Runs the operations as one transaction would.
+    template <typename... Operations>
+    void commit(Operations &&... operations)
+    {
+        DB::SharedMutex mutex;
+        std::unique_lock lock(mutex);
+        (operations.execute(lock), ...);
+        RocksDBCommitBatchOperation(*db, batch).execute(lock);
+        batch.Clear();
+    }
+
+    void writeFile(const String & path) { commit(RocksDBWriteFileOperation(path, *db, batch, "data")); }
+
+    Poco::TemporaryFile dir;
+    std::unique_ptr<rocksdb::DB> db;
+    rocksdb::WriteBatchWithIndex batch{rocksdb::BytewiseComparator(), 0, true};
+};
+}
+
+TEST_F(RocksDBMetadata, ListDirectChildren)
+{
+    commit(RocksDBCreateDirectoryRecursiveOperation("store/table/all_1_1_0/", *db, batch));
+    commit(RocksDBCreateDirectoryOperation("store/table/all_10_10_0", *db, batch));
+    commit(RocksDBCreateDirectoryOperation("store/table/all_2_2_0", *db, batch));
+    commit(RocksDBCreateDirectoryOperation("store/table_2", *db, batch));
+    writeFile("store/table/all_1_1_0/data.bin");
+    writeFile("store/table/all_1_1_0/p.proj/data.bin");
+    writeFile("store/table_2/data.bin");
+
+    const std::vector<String> parts{"store/table/all_10_10_0", "store/table/all_1_1_0", "store/table/all_2_2_0"};
+    EXPECT_EQ(listKeys(*db, "store/table"), parts);
+    EXPECT_EQ(listKeys(*db, "store/table/"), parts);
+    EXPECT_EQ(listKeys(*db, "store/table/all_1_1_0"), std::vector<String>({"store/table/all_1_1_0/data.bin"}));
+    EXPECT_EQ(listKeys(*db, ""), std::vector<String>({"store"}));
+    EXPECT_TRUE(hasChildren(*db, "store/table_2"));
+    EXPECT_FALSE(hasChildren(*db, "store/table/all_2_2_0"));
+    EXPECT_EQ(getData(*db, "store/table/all_1_1_0/"), RocksDBCreateDirectoryOperation::DIR_DATA);
+}
+
+TEST_F(RocksDBMetadata, AtomicCommit)
+{
+    DB::SharedMutex mutex;
+    std::unique_lock lock(mutex);
+    RocksDBCreateDirectoryRecursiveOperation("store/table/all_1_1_0", *db, batch).execute(lock);
+    RocksDBWriteFileOperation("store/table/all_1_1_0/data.bin", *db, batch, "data").execute(lock);
+    /// Later operations see the writes of earlier ones, but nothing is written before the commit.
+    EXPECT_THROW(RocksDBRemoveDirectoryOperation("store/table/all_1_1_0", *db, batch).execute(lock), DB::Exception);
+    EXPECT_FALSE(exist(*db, "store/table/all_1_1_0/data.bin"));
+
+    RocksDBCommitBatchOperation(*db, batch).execute(lock);
+    EXPECT_EQ(getData(*db, "store/table/all_1_1_0/data.bin"), "data");
+}
+
+TEST_F(RocksDBMetadata, RemoveRecursive)
+{
+    commit(RocksDBCreateDirectoryRecursiveOperation("store/table/all_1_1_0/p.proj", *db, batch));
+    writeFile("store/table/all_1_1_0/data.bin");
+    writeFile("store/table/all_1_1_0/p.proj/data.bin");
+    writeFile("store/table/all_1_1_1");
+
+    commit(RocksDBRemoveRecursiveOperation("store/table/all_1_1_0", *db, batch));
+    EXPECT_EQ(listKeys(*db, "store/table"), std::vector<String>({"store/table/all_1_1_1"}));
+    EXPECT_FALSE(exist(*db, "store/table/all_1_1_0/p.proj/data.bin"));
+
+    commit(RocksDBUnlinkFileOperation("store/table/all_1_1_1", *db, batch), RocksDBRemoveDirectoryOperation("store/table", *db, batch));
+    EXPECT_FALSE(exist(*db, "store/table"));
+}
+
+TEST_F(RocksDBMetadata, MigrateFlatKeys)
+{
+    throwRockDBErrorNotOk(db->Put({}, "store/table/", RocksDBCreateDirectoryOperation::DIR_DATA));
+    throwRockDBErrorNotOk(db->Put({}, "store/table/all_1_1_0", RocksDBCreateDirectoryOperation::DIR_DATA));
+    throwRockDBErrorNotOk(db->Put({}, "store/table/all_1_1_0/data.bin", "data"));
+
+    migrateToHierarchicalKeys(*db);
+    migrateToHierarchicalKeys(*db);
+    EXPECT_EQ(listKeys(*db, "store/table"), std::vector<String>({"store/table/all_1_1_0"}));
+    EXPECT_EQ(getData(*db, "store/table/all_1_1_0/data.bin"), "data");
+    EXPECT_TRUE(exist(*db, "store/table"));
+
+    std::unique_ptr<rocksdb::Iterator> it(db->NewIterator({}));
+    for (it->SeekToFirst(); it->Valid(); it->Next())
+        EXPECT_EQ(it->key()[0], '\0');
+}
+
+#endif
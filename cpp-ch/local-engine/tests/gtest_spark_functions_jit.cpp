@@ -0,0 +1,231 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "config.h"
+
+#include <functional>
+#include <Columns/IColumn.h>
+#include <Core/Block.h>
+#include <DataTypes/DataTypeFactory.h>
+#include <Functions/FunctionFactory.h>
+#include <Interpreters/ActionsDAG.h>
+#include <Interpreters/ExpressionActions.h>
+#include <Interpreters/ExpressionActionsSettings.h>
+#include <gtest/gtest.h>
+#include <Common/FieldVisitorToString.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+
+namespace
+{
+/// Builds the expression on top of the DAG inputs and returns the node to check.
+using BuildExpression = std::function<const ActionsDAG::Node *(ActionsDAG &, const ActionsDAG::NodeRawConstPtrs &)>;
+
+const ActionsDAG::Node * addFunction(ActionsDAG & dag, const String & function, const ActionsDAG::NodeRawConstPtrs & args)
+{
+    auto function_builder = FunctionFactory::instance().get(function, local_engine::QueryContext::globalContext());
+    String result_name = function + "(";
+    for (size_t i = 0; i < args.size(); ++i)
+        result_name += (i ? "," : "") + args[i]->result_name;
+    result_name += ")";
+    return &dag.addFunction(function_builder, args, result_name);
+}
+
+const ActionsDAG::Node * addConstant(ActionsDAG & dag, const String & type_name, const Field & value)
+{
+    auto type = DataTypeFactory::instance().get(type_name);
+    return &dag.addColumn(ColumnWithTypeAndName(type->createColumnConst(1, value), type, applyVisitor(FieldVisitorToString(), value)));
+}
+
+ColumnWithTypeAndName execute(const Block & input, const BuildExpression & build, bool compile)
+{
+    ActionsDAG dag;
+    ActionsDAG::NodeRawConstPtrs inputs;
+    for (const auto & column : input)
+        inputs.push_back(&dag.addInput(column.name, column.type));
+    const auto * result_node = build(dag, inputs);
+    dag.addOrReplaceInOutputs(*result_node);
+    String result_name = result_node->result_name;
+
+    ExpressionActionsSettings settings;
+    if (compile)
+    {
+        settings.can_compile_expressions = true;
+        settings.compile_expressions = CompileExpressions::yes;
+        settings.min_count_to_compile_expression = 0;
+    }
+    ExpressionActions actions(std::move(dag), settings);
+
+#if USE_EMBEDDED_COMPILER
+    if (compile)
+    {
+        bool has_compiled_function = false;
+        for (const auto & action : actions.getActions())
+            has_compiled_function |= action.node->is_function_compiled;
+        EXPECT_TRUE(has_compiled_function) << "Expression " << result_name << " was not compiled";
+    }
+#endif
+
+    Block block = input;
+    actions.execute(block);
+    auto result = block.getByName(result_name);
+    result.column = result.column->convertToFullColumnIfConst();
+    return result;
+}
+
+void assertCompiledMatchesInterpreted(const Block & input, const BuildExpression & build)
+{
+    auto interpreted = execute(input, build, false);
+    auto compiled = execute(input, build, true);
+
+    ASSERT_TRUE(interpreted.type->equals(*compiled.type)) << interpreted.type->getName() << " vs " << compiled.type->getName();
+    ASSERT_EQ(interpreted.column->size(), compiled.column->size());
+    for (size_t i = 0; i < interpreted.column->size(); ++i)
+        EXPECT_EQ(0, interpreted.column->compareAt(i, i, *compiled.column, 1))
+            << interpreted.name << " row " << i << ": " << applyVisitor(FieldVisitorToString(), (*interpreted.column)[i]) << " vs "
+            << applyVisitor(FieldVisitorToString(), (*compiled.column)[i]);
+}
+
+Block createFloatBlock()
+{
+    auto f64_type = DataTypeFactory::instance().get("Nullable(Float64)");
+    auto f32_type = DataTypeFactory::instance().get("Float32");
+    auto f64_column = f64_type->createColumn();
+    auto f32_column = f32_type->createColumn();
+    const std::vector<Float64> values
+        = {2.5, -2.5, 0.5, -0.5, 0.05, -0.05, 1.4999999, -1.5000001, 123.456, -123.455, 0.0, -0.0, 1e300, -1e300,
+           std::numeric_limits<Float64>::quiet_NaN(), std::numeric_limits<Float64>::infinity(), -std::numeric_limits<Float64>::infinity()};
+    for (auto value : values)
+    {
+        f64_column->insert(value);
+        f32_column->insert(static_cast<Float32>(value));
+    }
+    f64_column->insert(Field());
+    f32_column->insert(static_cast<Float32>(7.5));
+    return Block({{std::move(f64_column), f64_type, "f64"}, {std::move(f32_column), f32_type, "f32"}});
+}
+
+Block createIntBlock()
+{
+    auto i32_type = DataTypeFactory::instance().get("Int32");
+    auto u16_type = DataTypeFactory::instance().get("UInt16");
+    auto i32_column = i32_type->createColumn();
+    auto u16_column = u16_type->createColumn();
+    const std::vector<Int32> values = {125, -125, 150, -150, 149, -149, 5, -5, 0, 65535, 1 << 30};
+    for (auto value : values)
+    {
+        i32_column->insert(value);
+        u16_column->insert(static_cast<UInt16>(value));
+    }
+    return Block({{std::move(i32_column), i32_type, "i32"}, {std::move(u16_column), u16_type, "u16"}});
+}
+
+Block createDecimalBlock()
+{
+    auto d64_type = DataTypeFactory::instance().get("Decimal(10, 3)");
+    auto d128_type = DataTypeFactory::instance().get("Nullable(Decimal(20, 3))");
+    auto d64_column = d64_type->createColumn();
+    auto d128_column = d128_type->createColumn();
+    const std::vector<Int64> values = {1250, -1250, 1249, -1249, 1251, -1251, 500, -500, 0, 99999, -99999, 9999999999, -9999999999};
+    for (auto value : values)
+    {
+        d64_column->insert(DecimalField<Decimal64>(value, 3));
+        d128_column->insert(DecimalField<Decimal128>(value, 3));
+    }
+    d64_column->insert(DecimalField<Decimal64>(1, 3));
+    d128_column->insert(Field());
+    return Block({{std::move(d64_column), d64_type, "d64"}, {std::move(d128_column), d128_type, "d128"}});
+}
+}
+
+TEST(SparkFunctionsJIT, Floor)
+{
+    for (size_t i = 0; i < 2; ++i)
+    {
+        auto floor_of_negated = [i](ActionsDAG & dag, const ActionsDAG::NodeRawConstPtrs & inputs)
+        { return addFunction(dag, "sparkFloor", {addFunction(dag, "negate", {inputs[i]})}); };
+        assertCompiledMatchesInterpreted(createFloatBlock(), floor_of_negated);
+        assertCompiledMatchesInterpreted(createIntBlock(), floor_of_negated);
+    }
+
+    for (size_t i = 0; i < 2; ++i)
+        assertCompiledMatchesInterpreted(
+            createDecimalBlock(),
+            [i](ActionsDAG & dag, const ActionsDAG::NodeRawConstPtrs & inputs) {
+                const auto * rounded = addFunction(dag, "roundHalfUp", {inputs[i], addConstant(dag, "Int32", Int64(2))});
+                return addFunction(dag, "sparkFloor", {rounded});
+            });
+}
+
+TEST(SparkFunctionsJIT, RoundHalfUp)
+{
+    for (Int32 scale : {0, 1, 2, -1, -3})
+    {
+        for (size_t i = 0; i < 2; ++i)
+        {
+            assertCompiledMatchesInterpreted(
+                createFloatBlock(),
+                [i, scale](ActionsDAG & dag, const ActionsDAG::NodeRawConstPtrs & inputs)
+                {
+                    const auto * negated = addFunction(dag, "negate", {inputs[i]});
+                    return addFunction(dag, "roundHalfUp", {negated, addConstant(dag, "Int32", Int64(scale))});
+                });
+            assertCompiledMatchesInterpreted(
+                createIntBlock(),
+                [i, scale](ActionsDAG & dag, const ActionsDAG::NodeRawConstPtrs & inputs)
+                {
+                    const auto * inverted = addFunction(dag, "bitNot", {inputs[i]});
+                    return addFunction(dag, "roundHalfUp", {inverted, addConstant(dag, "Int32", Int64(scale))});
+                });
+            assertCompiledMatchesInterpreted(
+                createDecimalBlock(),
+                [i, scale](ActionsDAG & dag, const ActionsDAG::NodeRawConstPtrs & inputs)
+                {
+                    const auto * rounded = addFunction(dag, "roundHalfUp", {inputs[i], addConstant(dag, "Int32", Int64(scale))});
+                    return addFunction(dag, "roundHalfUp", {rounded, addConstant(dag, "UInt8", UInt64(0))});
+                });
+        }
+    }
+}
+
+TEST(SparkFunctionsJIT, CheckDecimalOverflow)
+{
+    /// Widening and narrowing the scale, and narrowing the precision until values overflow.
+    const std::vector<std::pair<UInt64, UInt64>> precision_and_scales
+        = {{10, 3}, {8, 4}, {5, 1}, {4, 0}, {18, 6}, {30, 10}, {38, 2}, {9, 2}};
+    for (const auto & [precision, scale] : precision_and_scales)
+        for (size_t i = 0; i < 2; ++i)
+            assertCompiledMatchesInterpreted(
+                createDecimalBlock(),
+                [i, precision, scale](ActionsDAG & dag, const ActionsDAG::NodeRawConstPtrs & inputs)
+                {
+                    const auto * rounded = addFunction(dag, "roundHalfUp", {inputs[i], addConstant(dag, "Int32", Int64(2))});
+                    return addFunction(
+                        dag,
+                        "checkDecimalOverflowSparkOrNull",
+                        {rounded, addConstant(dag, "UInt32", precision), addConstant(dag, "UInt32", scale)});
+                });
+}
+
+TEST(SparkFunctionsJIT, Rint)
+{
+    for (size_t i = 0; i < 2; ++i)
+        assertCompiledMatchesInterpreted(
+            createFloatBlock(),
+            [i](ActionsDAG & dag, const ActionsDAG::NodeRawConstPtrs & inputs)
+            { return addFunction(dag, "sparkRint", {addFunction(dag, "negate", {inputs[i]})}); });
+}
@@ -0,0 +1,203 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <AggregateFunctions/AggregateFunctionSparkPercentile.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <base/scope_guard.h>
+#include <gtest/gtest.h>
+#include <Common/AlignedBuffer.h>
+#include <Common/BlockTypeUtils.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// Runs sparkPercentiles(levels)(value, frequency) over `rows`, the way the CH backend plans Spark's percentile.
+std::vector<Float64> percentiles(const Array & levels, const std::vector<std::pair<Float64, UInt64>> & rows)
+{
+    AggregateFunctionProperties properties;
+    const auto function
+        = AggregateFunctionFactory::instance().get("sparkPercentiles", NullsAction::EMPTY, {DOUBLE(), UBIGINT()}, levels, properties);
+
+    auto values = DOUBLE()->createColumn();
+    auto weights = UBIGINT()->createColumn();
+    for (const auto & [value, weight] : rows)
+    {
+        values->insert(value);
+        weights->insert(weight);
+    }
+    const IColumn * columns[] = {values.get(), weights.get()};
+
+    AlignedBuffer place(function->sizeOfData(), function->alignOfData());
+    function->create(place.data());
+    SCOPE_EXIT(function->destroy(place.data()));
+    for (size_t i = 0; i < rows.size(); ++i)
+        function->add(place.data(), columns, i, nullptr);
+
+    auto result = function->getResultType()->createColumn();
+    function->insertResultInto(place.data(), *result, nullptr);
+    std::vector<Float64> output;
+    for (const auto & field : (*result)[0].safeGet<Array>())
+        output.push_back(field.safeGet<Float64>());
+    return output;
+}
+
+/// Spark's Percentile.getPercentile on plain sorted values.
+Float64 referencePercentile(const std::vector<Float64> & sorted, Float64 level)
+{
+    const Float64 position = static_cast<Float64>(sorted.size() - 1) * level;
+    const auto lower = static_cast<size_t>(std::floor(position));
+    const auto higher = static_cast<size_t>(std::ceil(position));
+    if (lower == higher || sorted[lower] == sorted[higher])
+        return sorted[lower];
+    return (static_cast<Float64>(higher) - position) * sorted[lower] + (position - static_cast<Float64>(lower)) * sorted[higher];
+}
+
+std::vector<Float64> getPercentiles(const SparkPercentileData & data, const std::vector<Float64> & levels)
+{
+    std::vector<Float64> result(levels.size());
+    data.getPercentiles(levels, result.data());
+    return result;
+}
+}
+
+TEST(SparkPercentile, MatchesSpark)
+{
+    /// Examples from Spark's documentation of percentile.
+    EXPECT_EQ(percentiles({0.3}, {{0, 1}, {10, 1}}), std::vector<Float64>{3.0});
+    EXPECT_EQ(percentiles({0.25, 0.75}, {{0, 1}, {10, 1}}), (std::vector<Float64>{2.5, 7.5}));
+
+    /// Frequencies repeat a value, a zero frequency drops it.
+    EXPECT_EQ(percentiles({0.5, 1.0}, {{1, 3}, {2, 1}, {100, 0}}), (std::vector<Float64>{1.0, 2.0}));
+    EXPECT_EQ(percentiles({0.0, 0.5, 1.0}, {{-5, 2}, {7, 2}}), (std::vector<Float64>{-5.0, 1.0, 7.0}));
+
+    /// NaN sorts after every other value.
+    const auto with_nan = percentiles({0.0, 0.5, 1.0}, {{std::numeric_limits<Float64>::quiet_NaN(), 1}, {1, 1}});
+    EXPECT_EQ(with_nan[0], 1.0);
+    EXPECT_TRUE(std::isnan(with_nan[1]));
+    EXPECT_TRUE(std::isnan(with_nan[2]));
+
+    EXPECT_TRUE(std::isnan(percentiles({0.5}, {})[0]));
+}
+
+TEST(SparkPercentile, SpillsWithinMemoryBound)
+{
+    constexpr size_t rows = 200000;
+    const std::vector<Float64> levels{0.0, 0.001, 0.25, 0.5, 0.7, 0.999, 1.0};
+    const PercentileSpillSettings spill_settings{.max_entries_in_memory = 1000, .max_runs = 4, .tmp_path = "/tmp/"};
+    const PercentileSpillSettings in_memory_settings{.max_entries_in_memory = rows * 2, .tmp_path = "/tmp/"};
+
+    std::mt19937_64 rng(42);
+    constexpr Int64 range = rows;
+    std::uniform_int_distribution<Int64> distribution(-range, range);
+    std::vector<Float64> values(rows);
+    for (auto & value : values)
+        value = static_cast<Float64>(distribution(rng)) / 8;
+
+    SparkPercentileData spilled;
+    SparkPercentileData in_memory;
+    SparkPercentileData first_half;
+    SparkPercentileData second_half;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        spilled.add(values[i], 1, spill_settings);
+        in_memory.add(values[i], 1, in_memory_settings);
+        (i < rows / 2 ? first_half : second_half).add(values[i], 1, spill_settings);
+        ASSERT_LT(spilled.entriesInMemory(), spill_settings.max_entries_in_memory);
+        ASSERT_LT(spilled.spilledRuns(), spill_settings.max_runs);
+    }
+    EXPECT_GT(spilled.spilledRuns(), 0);
+    EXPECT_EQ(in_memory.spilledRuns(), 0);
+
+    std::vector<Float64> expected;
+    std::ranges::sort(values);
+    for (const Float64 level : levels)
+        expected.push_back(referencePercentile(values, level));
+
+    EXPECT_EQ(getPercentiles(in_memory, levels), expected);
+    EXPECT_EQ(getPercentiles(spilled, levels), expected);
+
+    first_half.merge(second_half, spill_settings);
+    EXPECT_LT(first_half.entriesInMemory(), spill_settings.max_entries_in_memory);
+    EXPECT_EQ(getPercentiles(first_half, levels), expected);
+
+    /// Partial states travel through the shuffle serialized, runs included.
+    WriteBufferFromOwnString out;
+    spilled.serialize(out, spill_settings);
+    ReadBufferFromString in(out.str());
+    SparkPercentileData deserialized;
+    deserialized.deserialize(in, spill_settings);
+    EXPECT_GT(deserialized.spilledRuns(), 0);
+    EXPECT_EQ(getPercentiles(deserialized, levels), expected);
+
+    /// A value found in several runs is written once, so both states serialize to the same number of bytes.
+    WriteBufferFromOwnString in_memory_out;
+    in_memory.serialize(in_memory_out, spill_settings);
+    EXPECT_EQ(out.str().size(), in_memory_out.str().size());
+}
+
+TEST(SparkPercentile, PartialToFinalWithinMemoryBound)
+{
+    /// The partial states of four tasks, each with more distinct values than a state keeps in memory, cross the exchange
+    /// serialized, and the final stage deserializes and merges them as the final aggregation of a GROUP BY does.
+    constexpr size_t partials = 4;
+    constexpr size_t rows_per_partial = 50000;
+    const PercentileSpillSettings settings{.max_entries_in_memory = 1000, .max_runs = 4, .tmp_path = "/tmp/"};
+    const std::vector<Float64> levels{0.0, 0.1, 0.5, 0.9, 1.0};
+
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<Int64> distribution(-1000000, 1000000);
+    std::vector<Float64> values;
+    std::vector<String> exchanged;
+    for (size_t p = 0; p < partials; ++p)
+    {
+        SparkPercentileData partial;
+        for (size_t i = 0; i < rows_per_partial; ++i)
+        {
+            values.push_back(static_cast<Float64>(distribution(rng)) / 4);
+            partial.add(values.back(), 1, settings);
+        }
+        WriteBufferFromOwnString out;
+        partial.serialize(out, settings);
+        exchanged.push_back(out.str());
+    }
+
+    SparkPercentileData final_state;
+    for (const auto & serialized : exchanged)
+    {
+        ReadBufferFromString in(serialized);
+        SparkPercentileData deserialized;
+        deserialized.deserialize(in, settings);
+        EXPECT_TRUE(in.eof());
+        EXPECT_GT(deserialized.spilledRuns(), 0);
+        EXPECT_LT(deserialized.spilledRuns(), settings.max_runs);
+        EXPECT_LT(deserialized.entriesInMemory(), settings.max_entries_in_memory);
+
+        final_state.merge(deserialized, settings);
+        EXPECT_LT(final_state.spilledRuns(), settings.max_runs);
+        EXPECT_LT(final_state.entriesInMemory(), settings.max_entries_in_memory);
+    }
+
+    std::ranges::sort(values);
+    std::vector<Float64> expected;
+    for (const Float64 level : levels)
+        expected.push_back(referencePercentile(values, level));
+    EXPECT_EQ(getPercentiles(final_state, levels), expected);
+}
@@ -15,10 +15,14 @@
  * limitations under the License.
  */
 
+#include <latch>
+#include <thread>
 #include <gluten_test_util.h>
 #include <incbin.h>
 #include <testConfig.h>
 #include <Core/Settings.h>
+#include <DataTypes/DataTypeArray.h>
+#include <DataTypes/DataTypeFixedString.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/InterpreterCreateQuery.h>
@@ -28,18 +32,22 @@
 #include <Parsers/ASTCreateQuery.h>
 #include <Parsers/ParserQuery.h>
 #include <Parsers/parseQuery.h>
+#include <Processors/QueryPlan/QueryPlan.h>
+#include <Processors/QueryPlan/ReadFromMergeTree.h>
 #include <Processors/Transforms/DeduplicationTokenTransforms.h>
 #include <Storages/MergeTree/MergeTreeData.h>
 #include <Storages/MergeTree/MergeTreeSink.h>
 #include <Storages/MergeTree/SparkMergeTreeMeta.h>
 #include <Storages/MergeTree/SparkMergeTreeWriteSettings.h>
 #include <Storages/MergeTree/SparkMergeTreeWriter.h>
+#include <Storages/MergeTree/StorageMergeTreeFactory.h>
 #include <Storages/StorageMergeTree.h>
 #include <gtest/gtest.h>
 #include <substrait/algebra.pb.h>
 #include <Common/BlockTypeUtils.h>
 #include <Common/DebugUtils.h>
 #include <Common/QueryContext.h>
+#include <Common/Stopwatch.h>
 #include <Common/ThreadStatus.h>
 
 namespace DB::Setting
@@ -52,6 +60,11 @@ extern const SettingsUInt64 min_insert_block_size_rows;
 extern const SettingsUInt64 min_insert_block_size_bytes;
 }
 
+namespace DB::ErrorCodes
+{
+extern const int NO_SUCH_DATA_PART;
+}
+
 using namespace local_engine;
 using namespace DB;
 
@@ -341,4 +354,352 @@ TEST(MergeTree, case_sensitive)
             EXPECT_EQ(1, block.rows());
             std::cerr << debug::showString(block, 20, 50) << std::endl;
         });
-}
\ No newline at end of file
+}
+namespace
+{
+constexpr size_t ZONE_MAP_GRANULES = 64;
+constexpr size_t ZONE_MAP_GRANULE_ROWS = 8192;
+
+/// The names of row i, longer than the prefix kept by the minmax index of `name`.
+std::string zone_map_name(size_t i)
+{
+    return fmt::format("k{:08}-{}", i, std::string(40, 'x'));
+}
+
+/// `id`, `name`, `code` and `score` grow with the row number. The third granule has NaN scores.
+Chunk zone_map_chunk()
+{
+    constexpr size_t rows = ZONE_MAP_GRANULES * ZONE_MAP_GRANULE_ROWS;
+    auto id = BIGINT()->createColumn();
+    auto name = STRING()->createColumn();
+    auto code = std::make_shared<DataTypeFixedString>(9)->createColumn();
+    auto score = makeNullable(DOUBLE())->createColumn();
+    auto tags = std::make_shared<DataTypeArray>(INT())->createColumn();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        id->insert(static_cast<Int64>(i));
+        name->insert(zone_map_name(i));
+        code->insert(fmt::format("k{:08}", i));
+        if (i % 11 == 0)
+            score->insert(Field{});
+        else if (i / ZONE_MAP_GRANULE_ROWS == 3 && i % 97 == 0)
+            score->insert(std::numeric_limits<Float64>::quiet_NaN());
+        else
+            score->insert(static_cast<Float64>(i) / 1000);
+        tags->insert(Array{static_cast<Int32>(i % 7)});
+    }
+    MutableColumns columns;
+    columns.push_back(std::move(id));
+    columns.push_back(std::move(name));
+    columns.push_back(std::move(code));
+    columns.push_back(std::move(score));
+    columns.push_back(std::move(tags));
+    return {std::move(columns), rows};
+}
+
+struct ZoneMapRun
+{
+    size_t bytes_on_disk = 0;
+    UInt64 write_ms = 0;
+    size_t marks_by_id = 0;
+    size_t marks_by_name = 0;
+    size_t marks_by_full_name = 0;
+    size_t marks_by_code = 0;
+    size_t marks_by_score = 0;
+};
+
+size_t selectedMarks(StorageMergeTree & storage, const ContextPtr & context, const std::string & filter)
+{
+    const auto metadata_snapshot = storage.getInMemoryMetadataPtr();
+    auto names_and_types = metadata_snapshot->getColumns().getAllPhysical();
+    const auto query_info = buildQueryInfo(names_and_types);
+    const auto storage_snapshot = storage.getStorageSnapshot(metadata_snapshot, context);
+
+    QueryPlan plan;
+    storage.read(
+        plan, names_and_types.getNames(), storage_snapshot, *query_info, context, QueryProcessingStage::FetchColumns, 8192, 1);
+    auto * read_step = dynamic_cast<ReadFromMergeTree *>(plan.getRootNode()->step.get());
+    EXPECT_TRUE(read_step);
+
+    const auto filter_dag = test::parseFilter(filter, names_and_types);
+    ActionDAGNodes filter_nodes;
+    filter_nodes.nodes.emplace_back(filter_dag->getOutputs().front());
+    read_step->applyFilters(std::move(filter_nodes));
+    return read_step->getAnalysisResult().selected_marks;
+}
+
+ZoneMapRun writeZoneMapTable(const ContextMutablePtr & context, const std::string & path, const StorageInMemoryMetadata & metadata)
+{
+    StorageInMemoryMetadata table_metadata(metadata);
+    table_metadata.partition_key = KeyDescription::getKeyFromAST(nullptr, table_metadata.columns, context);
+    auto storage_settings = std::make_unique<MergeTreeSettings>(context->getMergeTreeSettings());
+    auto merge_tree = std::make_shared<StorageMergeTree>(
+        StorageID("", path),
+        path,
+        table_metadata,
+        LoadingStrictnessLevel::CREATE,
+        context,
+        "",
+        MergeTreeData::MergingParams{},
+        std::move(storage_settings));
+
+    ZoneMapRun run;
+    auto chunk = zone_map_chunk();
+    chunk.getChunkInfos().add(std::make_shared<DeduplicationToken::TokenInfo>());
+    Stopwatch watch;
+    ASTPtr none;
+    auto sink = std::static_pointer_cast<MergeTreeSink>(merge_tree->write(none, merge_tree->getInMemoryMetadataPtr(), context, false));
+    sink->consume(chunk);
+    sink->onFinish();
+    run.write_ms = watch.elapsedMilliseconds();
+
+    for (const auto & part : merge_tree->getDataPartsVectorForInternalUsage())
+        run.bytes_on_disk += part->getBytesOnDisk();
+    run.marks_by_id = selectedMarks(*merge_tree, context, "id < 30000");
+    run.marks_by_name = selectedMarks(*merge_tree, context, "name >= 'k00500000'");
+    run.marks_by_code = selectedMarks(*merge_tree, context, "code >= 'k00500000'");
+    run.marks_by_full_name = selectedMarks(*merge_tree, context, fmt::format("name = '{}'", zone_map_name(100000)));
+    run.marks_by_score = selectedMarks(*merge_tree, context, "score > 400");
+    merge_tree->flushAndShutdown();
+    return run;
+}
+}
+
+TEST(MergeTree, AutoMinMaxIndex)
+{
+    ThreadStatus thread_status;
+
+    const auto context = DB::Context::createCopy(QueryContext::globalContext());
+    context->setPath("./");
+
+    MergeTreeTable table;
+    table.order_by_key = MergeTreeTable::TUPLE;
+    const Block header{
+        {BIGINT(), "id"},
+        {STRING(), "name"},
+        {std::make_shared<DataTypeFixedString>(9), "code"},
+        {makeNullable(DOUBLE()), "score"},
+        {std::make_shared<DataTypeArray>(INT()), "tags"}};
+    const auto metadata = table.buildMetaData(header, context);
+
+    Names indexes;
+    for (const auto & index : metadata->getSecondaryIndices())
+    {
+        EXPECT_EQ(index.type, "minmax");
+        indexes.push_back(index.name);
+    }
+    EXPECT_EQ(indexes, (Names{"_minmax_id", "_minmax_key_name", "_minmax_code", "_minmax_key_score"}));
+
+    StorageInMemoryMetadata plain_metadata(*metadata);
+    plain_metadata.setSecondaryIndices({});
+
+    SCOPE_EXIT({
+        do_remove("AutoMinMaxIndex_Plain");
+        do_remove("AutoMinMaxIndex_ZoneMap");
+    });
+    const ZoneMapRun plain = writeZoneMapTable(context, "AutoMinMaxIndex_Plain", plain_metadata);
+    const ZoneMapRun zone_map = writeZoneMapTable(context, "AutoMinMaxIndex_ZoneMap", *metadata);
+
+    /// Two values of bounded size per granule and column, far below the data itself, and cheap to compute.
+    EXPECT_GT(zone_map.bytes_on_disk, plain.bytes_on_disk);
+    EXPECT_LT(zone_map.bytes_on_disk - plain.bytes_on_disk, plain.bytes_on_disk / 100);
+    EXPECT_LT(zone_map.write_ms, plain.write_ms * 3 / 2 + 100);
+
+    /// Without a sorting key nothing can be skipped.
+    EXPECT_EQ(plain.marks_by_id, ZONE_MAP_GRANULES);
+    EXPECT_EQ(plain.marks_by_name, ZONE_MAP_GRANULES);
+    EXPECT_EQ(plain.marks_by_full_name, ZONE_MAP_GRANULES);
+    EXPECT_EQ(plain.marks_by_code, ZONE_MAP_GRANULES);
+    EXPECT_EQ(plain.marks_by_score, ZONE_MAP_GRANULES);
+
+    EXPECT_EQ(zone_map.marks_by_id, 30000 / ZONE_MAP_GRANULE_ROWS + 1);
+    EXPECT_EQ(zone_map.marks_by_code, ZONE_MAP_GRANULES - 500000 / ZONE_MAP_GRANULE_ROWS);
+
+    /// The prefixes of the names prune as well as the whole names would.
+    EXPECT_EQ(zone_map.marks_by_name, ZONE_MAP_GRANULES - 500000 / ZONE_MAP_GRANULE_ROWS);
+    EXPECT_EQ(zone_map.marks_by_full_name, 1);
+
+    /// NaN is above every score, so the granule with NaN is kept along with those above 400.
+    EXPECT_EQ(zone_map.marks_by_score, ZONE_MAP_GRANULES - 400000 / ZONE_MAP_GRANULE_ROWS + 1);
+}
+
+namespace
+{
+constexpr size_t LOADING_CALLERS = 4;
+
+/// Counts the parts it is asked to load and holds each load long enough for concurrent callers to overlap with it.
+class CountingStorageMergeTree final : public SparkStorageMergeTree
+{
+public:
+    CountingStorageMergeTree(const String & path, const StorageInMemoryMetadata & metadata, const ContextMutablePtr & context, bool fail_)
+        : SparkStorageMergeTree(
+              StorageID("default", path),
+              path,
+              metadata,
+              false,
+              context,
+              "",
+              MergingParams(),
+              std::make_unique<MergeTreeSettings>(context->getMergeTreeSettings()))
+        , fail(fail_)
+    {
+    }
+
+    std::vector<MergeTreeDataPartPtr> loadDataPartsWithNames(const std::unordered_set<std::string> & parts) override
+    {
+        loaded += parts.size();
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        if (fail)
+            throw Exception(ErrorCodes::NO_SUCH_DATA_PART, "Injected failure");
+        return SparkStorageMergeTree::loadDataPartsWithNames(parts);
+    }
+
+    std::atomic<size_t> loaded = 0;
+
+private:
+    const bool fail;
+};
+
+StorageInMemoryMetadata partsMetadata(const ContextPtr & context)
+{
+    MergeTreeTable table;
+    table.order_by_key = MergeTreeTable::TUPLE;
+    StorageInMemoryMetadata metadata(*table.buildMetaData(Block{{BIGINT(), "id"}}, context));
+    metadata.partition_key = KeyDescription::getKeyFromAST(nullptr, metadata.columns, context);
+    return metadata;
+}
+
+/// Writes one part per element of `parts` and returns their names.
+Names writeParts(const ContextMutablePtr & context, const String & path, const StorageInMemoryMetadata & metadata, size_t parts)
+{
+    auto merge_tree = std::make_shared<StorageMergeTree>(
+        StorageID("", path),
+        path,
+        metadata,
+        LoadingStrictnessLevel::CREATE,
+        context,
+        "",
+        MergeTreeData::MergingParams{},
+        std::make_unique<MergeTreeSettings>(context->getMergeTreeSettings()));
+    for (size_t i = 0; i < parts; ++i)
+    {
+        auto id = BIGINT()->createColumn();
+        id->insert(static_cast<Int64>(i));
+        MutableColumns columns;
+        columns.push_back(std::move(id));
+        Chunk chunk(std::move(columns), 1);
+        chunk.getChunkInfos().add(std::make_shared<DeduplicationToken::TokenInfo>());
+        ASTPtr none;
+        auto sink = std::static_pointer_cast<MergeTreeSink>(merge_tree->write(none, merge_tree->getInMemoryMetadataPtr(), context, false));
+        sink->consume(chunk);
+        sink->onFinish();
+    }
+    Names names;
+    for (const auto & part : merge_tree->getDataPartsVectorForInternalUsage())
+        names.emplace_back(part->name);
+    merge_tree->flushAndShutdown();
+    return names;
+}
+
+/// Registers `storage` in StorageMergeTreeFactory as the table `path`.
+StorageID registerStorage(const String & path, const SparkStorageMergeTreePtr & storage)
+{
+    MergeTreeTable table;
+    table.database = "default";
+    table.table = path;
+    table.relative_path = path;
+    const StorageID id(table.database, table.table);
+    StorageMergeTreeFactory::getStorage(id, "", table, [&] { return storage; });
+    return id;
+}
+}
+
+TEST(MergeTree, LoadPartsOnceForConcurrentCallers)
+{
+    ThreadStatus thread_status;
+
+    const auto context = DB::Context::createCopy(QueryContext::globalContext());
+    context->setPath("./");
+    const String path = "LoadPartsOnceForConcurrentCallers";
+    do_remove(path);
+    SCOPE_EXIT({ do_remove(path); });
+
+    const auto metadata = partsMetadata(context);
+    const Names names = writeParts(context, path, metadata, 3);
+    ASSERT_EQ(names.size(), 3);
+
+    const auto storage = std::make_shared<CountingStorageMergeTree>(path, metadata, context, false);
+    const auto id = registerStorage(path, storage);
+    SCOPE_EXIT({ StorageMergeTreeFactory::freeStorage(id); });
+
+    /// Every caller asks for two of the three parts, so that each part is wanted by several callers at once.
+    std::latch start(LOADING_CALLERS);
+    std::vector<DataPartsVector> results(LOADING_CALLERS);
+    std::vector<std::thread> callers;
+    for (size_t i = 0; i < LOADING_CALLERS; ++i)
+        callers.emplace_back(
+            [&, i]
+            {
+                ThreadStatus caller_status;
+                start.arrive_and_wait();
+                results[i] = StorageMergeTreeFactory::getDataPartsByNames(id, "", {names[i % 3], names[(i + 1) % 3]});
+            });
+    for (auto & caller : callers)
+        caller.join();
+
+    EXPECT_EQ(storage->loaded, names.size());
+    std::unordered_map<String, DataPartPtr> parts_by_name;
+    for (const auto & parts : results)
+    {
+        ASSERT_EQ(parts.size(), 2);
+        for (const auto & part : parts)
+        {
+            /// All the callers share the single copy of each part.
+            const auto [it, _] = parts_by_name.emplace(part->name, part);
+            EXPECT_EQ(it->second, part);
+        }
+    }
+    EXPECT_EQ(parts_by_name.size(), names.size());
+}
+
+TEST(MergeTree, LoadPartsFailureReachesWaiters)
+{
+    ThreadStatus thread_status;
+
+    const auto context = DB::Context::createCopy(QueryContext::globalContext());
+    context->setPath("./");
+    const String path = "LoadPartsFailureReachesWaiters";
+    const auto storage = std::make_shared<CountingStorageMergeTree>(path, partsMetadata(context), context, true);
+    const auto id = registerStorage(path, storage);
+    SCOPE_EXIT({ StorageMergeTreeFactory::freeStorage(id); });
+
+    std::latch start(LOADING_CALLERS);
+    std::atomic<size_t> failed = 0;
+    std::vector<std::thread> callers;
+    for (size_t i = 0; i < LOADING_CALLERS; ++i)
+        callers.emplace_back(
+            [&]
+            {
+                ThreadStatus caller_status;
+                start.arrive_and_wait();
+                try
+                {
+                    StorageMergeTreeFactory::getDataPartsByNames(id, "", {"all_1_1_0"});
+                }
+                catch (const Exception & e)
+                {
+                    EXPECT_EQ(e.message(), "Injected failure");
+                    ++failed;
+                }
+            });
+    for (auto & caller : callers)
+        caller.join();
+
+    /// One caller loaded the part while the others waited for it, and all of them saw its failure.
+    EXPECT_EQ(failed, LOADING_CALLERS);
+    EXPECT_EQ(storage->loaded, 1);
+
+    /// The failed load isn't left behind, so the next caller loads the part again.
+    EXPECT_THROW(StorageMergeTreeFactory::getDataPartsByNames(id, "", {"all_1_1_0"}), Exception);
+    EXPECT_EQ(storage->loaded, 2);
+}
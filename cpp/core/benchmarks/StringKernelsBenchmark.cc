@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "utils/SparkStringKernels.h"
+
+// Compares the kernels in utils/SparkStringKernels.h with byte-by-byte loops implementing the same Spark semantics,
+// on ASCII strings and on strings with 1 in 8 characters being multi-byte. The first argument is the average string
+// length.
+
+using namespace gluten::sparkstring;
+
+namespace {
+
+constexpr size_t kNumStrings = 1 << 14;
+
+std::vector<std::string> makeStrings(size_t length, bool ascii) {
+  static const std::vector<std::string> kMultiByte = {"é", "数", "😀"};
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> lengthDist(length / 2, length * 3 / 2);
+  std::vector<std::string> strings(kNumStrings);
+  for (auto& str : strings) {
+    auto numChars = lengthDist(rng);
+    for (size_t i = 0; i < numChars; ++i) {
+      if (!ascii && rng() % 8 == 0) {
+        str += kMultiByte[rng() % kMultiByte.size()];
+      } else {
+        str += static_cast<char>('a' + rng() % 26);
+      }
+    }
+    str += "needle";
+  }
+  return strings;
+}
+
+int64_t numCharsScalar(const std::string& str) {
+  int64_t chars = 0;
+  for (size_t i = 0; i < str.size(); i += numBytesForFirstByte(str[i])) {
+    ++chars;
+  }
+  return chars;
+}
+
+void upperScalar(const std::string& str, char* out) {
+  for (size_t i = 0; i < str.size(); ++i) {
+    out[i] = (str[i] >= 'a' && str[i] <= 'z') ? str[i] - 32 : str[i];
+  }
+}
+
+int64_t indexOfScalar(const std::string& str, std::string_view pattern) {
+  int64_t chars = 0;
+  for (size_t i = 0; i + pattern.size() <= str.size(); i += numBytesForFirstByte(str[i])) {
+    if (std::memcmp(str.data() + i, pattern.data(), pattern.size()) == 0) {
+      return chars;
+    }
+    ++chars;
+  }
+  return -1;
+}
+
+void BM_NumChars(benchmark::State& state) {
+  auto strings = makeStrings(state.range(0), state.range(1));
+  const bool kernel = state.range(2);
+  for (auto _ : state) {
+    for (const auto& str : strings) {
+      benchmark::DoNotOptimize(kernel ? numChars(str.data(), str.size()) : numCharsScalar(str));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumStrings);
+}
+
+void BM_Upper(benchmark::State& state) {
+  auto strings = makeStrings(state.range(0), /*ascii=*/true);
+  const bool kernel = state.range(2);
+  std::string out(state.range(0) * 2 + 16, '\0');
+  for (auto _ : state) {
+    for (const auto& str : strings) {
+      if (kernel) {
+        toUpperAscii(str.data(), str.size(), out.data());
+      } else {
+        upperScalar(str, out.data());
+      }
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumStrings);
+}
+
+void BM_IndexOf(benchmark::State& state) {
+  auto strings = makeStrings(state.range(0), state.range(1));
+  const bool kernel = state.range(2);
+  for (auto _ : state) {
+    for (const auto& str : strings) {
+      benchmark::DoNotOptimize(kernel ? indexOf(str, "needle", 0) : indexOfScalar(str, "needle"));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumStrings);
+}
+
+} // namespace
+
+BENCHMARK(BM_NumChars)->ArgNames({"length", "ascii", "kernel"})->ArgsProduct({{16, 256}, {0, 1}, {0, 1}});
+BENCHMARK(BM_Upper)->ArgNames({"length", "ascii", "kernel"})->ArgsProduct({{16, 256}, {1}, {0, 1}});
+BENCHMARK(BM_IndexOf)->ArgNames({"length", "ascii", "kernel"})->ArgsProduct({{16, 256}, {0, 1}, {0, 1}});
+
+BENCHMARK_MAIN();
@@ -27,4 +27,11 @@ Metrics* ResultIterator::getMetrics() {
   return nullptr;
 }
 
+MetricsSnapshot* ResultIterator::getMetricsSnapshot() {
+  if (runtime_) {
+    return runtime_->getMetricsSnapshot(getInputIter());
+  }
+  return nullptr;
+}
+
 } // namespace gluten
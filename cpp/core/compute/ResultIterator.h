@@ -20,6 +20,7 @@
 #include "memory/ColumnarBatch.h"
 #include "memory/ColumnarBatchIterator.h"
 #include "utils/Metrics.h"
+#include "utils/MetricsSnapshot.h"
 
 namespace gluten {
 
@@ -59,6 +60,8 @@ class ResultIterator {
 
   Metrics* getMetrics();
 
+  MetricsSnapshot* getMetricsSnapshot();
+
   void setExportNanos(int64_t exportNanos) {
     exportNanos_ = exportNanos;
   }
@@ -137,6 +137,10 @@ class Runtime : public std::enable_shared_from_this<Runtime> {
     throw GlutenException("Not implemented");
   }
 
+  virtual MetricsSnapshot* getMetricsSnapshot(ColumnarBatchIterator* rawIter) {
+    throw GlutenException("Not implemented");
+  }
+
   virtual std::shared_ptr<ShuffleReader> createShuffleReader(
       std::shared_ptr<arrow::Schema> schema,
       ShuffleReaderOptions options) {
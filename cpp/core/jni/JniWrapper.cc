@@ -19,6 +19,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <mutex>
 
 #include "compute/Runtime.h"
 #include "config/GlutenConfig.h"
@@ -60,6 +62,12 @@ jmethodID splitResultConstructor;
 jclass columnarBatchSerializeResultClass;
 jmethodID columnarBatchSerializeResultConstructor;
 
+jclass columnarBatchSerializedChunksClass;
+jmethodID columnarBatchSerializedChunksConstructor;
+
+jclass byteBufferClass;
+jmethodID byteBufferAllocateDirect;
+
 jclass metricsBuilderClass;
 jmethodID metricsBuilderConstructor;
 jclass nativeColumnarToRowInfoClass;
@@ -69,6 +77,43 @@ jclass shuffleReaderMetricsClass;
 jmethodID shuffleReaderMetricsSetDecompressTime;
 jmethodID shuffleReaderMetricsSetDeserializeTime;
 
+// The files to save the shuffle writer configurations of the tasks whose inputs are saved, by task attempt id, with
+// the runtime of the task's kernel. The shuffle writer of a task is created on another runtime after the task's kernel,
+// and the entry is dropped when the kernel's runtime is released, whether or not the task wrote a shuffle.
+std::mutex shuffleWriterConfFilesMutex;
+std::unordered_map<int64_t, std::pair<const Runtime*, std::string>> shuffleWriterConfFiles;
+
+std::optional<std::string> takeShuffleWriterConfFile(int64_t taskAttemptId) {
+  std::lock_guard<std::mutex> lock(shuffleWriterConfFilesMutex);
+  auto it = shuffleWriterConfFiles.find(taskAttemptId);
+  if (it == shuffleWriterConfFiles.end()) {
+    return std::nullopt;
+  }
+  auto file = std::move(it->second.second);
+  shuffleWriterConfFiles.erase(it);
+  return file;
+}
+
+void dropShuffleWriterConfFiles(const Runtime* runtime) {
+  std::lock_guard<std::mutex> lock(shuffleWriterConfFilesMutex);
+  for (auto it = shuffleWriterConfFiles.begin(); it != shuffleWriterConfFiles.end();) {
+    it = it->second.first == runtime ? shuffleWriterConfFiles.erase(it) : std::next(it);
+  }
+}
+
+// Saves the shuffle writer configuration in the format of the configuration file, keyed by the GenericBenchmark flags
+// and options that replay it.
+void saveShuffleWriterConf(const std::string& path, const std::vector<std::pair<std::string, std::string>>& conf) {
+  std::ofstream outFile(path);
+  if (!outFile.is_open()) {
+    LOG(ERROR) << "Failed to open file for writing: " << path;
+    return;
+  }
+  for (const auto& [key, value] : conf) {
+    outFile << key << " " << value << std::endl;
+  }
+}
+
 class JavaInputStreamAdaptor final : public arrow::io::InputStream {
  public:
   JavaInputStreamAdaptor(JNIEnv* env, arrow::MemoryPool* pool, jobject jniIn) : pool_(pool) {
@@ -219,20 +264,29 @@ jint JNI_OnLoad(JavaVM* vm, void* reserved) {
   jniByteInputStreamClose = getMethodIdOrError(env, jniByteInputStreamClass, "close", "()V");
 
   splitResultClass = createGlobalClassReferenceOrError(env, "Lorg/apache/gluten/vectorized/GlutenSplitResult;");
-  splitResultConstructor = getMethodIdOrError(env, splitResultClass, "<init>", "(JJJJJJJJJJ[J[J)V");
+  splitResultConstructor = getMethodIdOrError(env, splitResultClass, "<init>", "(JJJJJJJJJJ[J[JLjava/lang/String;JDIDJ)V");
 
   columnarBatchSerializeResultClass =
       createGlobalClassReferenceOrError(env, "Lorg/apache/gluten/vectorized/ColumnarBatchSerializeResult;");
   columnarBatchSerializeResultConstructor =
       getMethodIdOrError(env, columnarBatchSerializeResultClass, "<init>", "(J[B)V");
 
+  columnarBatchSerializedChunksClass =
+      createGlobalClassReferenceOrError(env, "Lorg/apache/gluten/vectorized/ColumnarBatchSerializedChunks;");
+  columnarBatchSerializedChunksConstructor =
+      getMethodIdOrError(env, columnarBatchSerializedChunksClass, "<init>", "(J[Ljava/nio/ByteBuffer;)V");
+
+  byteBufferClass = createGlobalClassReferenceOrError(env, "Ljava/nio/ByteBuffer;");
+  byteBufferAllocateDirect =
+      getStaticMethodIdOrError(env, byteBufferClass, "allocateDirect", "(I)Ljava/nio/ByteBuffer;");
+
   metricsBuilderClass = createGlobalClassReferenceOrError(env, "Lorg/apache/gluten/metrics/Metrics;");
 
   metricsBuilderConstructor = getMethodIdOrError(
       env,
       metricsBuilderClass,
       "<init>",
-      "([J[J[J[J[J[J[J[J[J[JJ[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J)V");
+      "([J[J[J[J[J[J[J[J[J[JJJ[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J[J)V");
 
   nativeColumnarToRowInfoClass =
       createGlobalClassReferenceOrError(env, "Lorg/apache/gluten/vectorized/NativeColumnarToRowInfo;");
@@ -262,6 +316,8 @@ void JNI_OnUnload(JavaVM* vm, void* reserved) {
   env->DeleteGlobalRef(jniByteInputStreamClass);
   env->DeleteGlobalRef(splitResultClass);
   env->DeleteGlobalRef(columnarBatchSerializeResultClass);
+  env->DeleteGlobalRef(columnarBatchSerializedChunksClass);
+  env->DeleteGlobalRef(byteBufferClass);
   env->DeleteGlobalRef(nativeColumnarToRowInfoClass);
   env->DeleteGlobalRef(byteArrayClass);
   env->DeleteGlobalRef(shuffleReaderMetricsClass);
@@ -294,6 +350,7 @@ JNIEXPORT void JNICALL Java_org_apache_gluten_runtime_RuntimeJniWrapper_releaseR
   JNI_METHOD_START
   auto runtime = jniCastOrThrow<Runtime>(ctxHandle);
 
+  dropShuffleWriterConfFiles(runtime);
   Runtime::release(runtime);
   JNI_METHOD_END()
 }
@@ -447,6 +504,8 @@ Java_org_apache_gluten_vectorized_PlanEvaluatorJniWrapper_nativeCreateKernelWith
       }
     }
     ctx->dumpConf(saveDir + "/conf" + fileIdentifier + ".ini");
+    std::lock_guard<std::mutex> lock(shuffleWriterConfFilesMutex);
+    shuffleWriterConfFiles[taskId] = {ctx, saveDir + "/shuffle_writer" + fileIdentifier + ".ini"};
   }
 
   auto spillDirStr = jStringToCString(env, spillDir);
@@ -558,6 +617,7 @@ JNIEXPORT jobject JNICALL Java_org_apache_gluten_metrics_IteratorMetricsJniWrapp
       longArray[Metrics::kCpuCount],
       longArray[Metrics::kWallNanos],
       metrics ? metrics->veloxToArrow : -1,
+      metrics ? metrics->spilledMemoryTierBytes : 0,
       longArray[Metrics::kPeakMemoryBytes],
       longArray[Metrics::kNumMemoryAllocations],
       longArray[Metrics::kSpilledInputBytes],
@@ -588,6 +648,20 @@ JNIEXPORT jobject JNICALL Java_org_apache_gluten_metrics_IteratorMetricsJniWrapp
   JNI_METHOD_END(nullptr)
 }
 
+JNIEXPORT jobject JNICALL Java_org_apache_gluten_metrics_IteratorMetricsJniWrapper_nativeMetricsSnapshot( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jlong iterHandle) {
+  JNI_METHOD_START
+  auto iter = ObjectStore::retrieve<ResultIterator>(iterHandle);
+  auto snapshot = iter->getMetricsSnapshot();
+  if (snapshot == nullptr) {
+    return nullptr;
+  }
+  return env->NewDirectByteBuffer(snapshot->data(), snapshot->sizeInBytes());
+  JNI_METHOD_END(nullptr)
+}
+
 JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ColumnarBatchOutIterator_nativeSpill( // NOLINT
     JNIEnv* env,
     jobject wrapper,
@@ -832,6 +906,8 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
     jobject wrapper,
     jstring partitioningNameJstr,
     jint numPartitions,
+    jstring hashPartitionKeysJstr,
+    jstring sortKeysJstr,
     jint bufferSize,
     jint mergeBufferSize,
     jdouble mergeThreshold,
@@ -861,17 +937,28 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
     throw GlutenException(std::string("Short partitioning name can't be null"));
   }
 
+  const auto partitioningName = jStringToCString(env, partitioningNameJstr);
+  const auto shuffleWriterTypeName = jStringToCString(env, shuffleWriterTypeJstr);
+
   // Build ShuffleWriterOptions.
   auto shuffleWriterOptions = ShuffleWriterOptions{
       .bufferSize = bufferSize,
       .bufferReallocThreshold = reallocThreshold,
-      .partitioning = toPartitioning(jStringToCString(env, partitioningNameJstr)),
+      .partitioning = toPartitioning(partitioningName),
       .taskAttemptId = static_cast<int64_t>(taskAttemptId),
       .startPartitionId = startPartitionId,
-      .shuffleWriterType = ShuffleWriter::stringToType(jStringToCString(env, shuffleWriterTypeJstr)),
+      .shuffleWriterType = ShuffleWriter::stringToType(shuffleWriterTypeName),
       .sortBufferInitialSize = sortBufferInitialSize,
       .sortEvictBufferSize = sortEvictBufferSize,
       .useRadixSort = static_cast<bool>(useRadixSort)};
+  if (hashPartitionKeysJstr != nullptr) {
+    for (const auto& key : splitByDelim(jStringToCString(env, hashPartitionKeysJstr), ',')) {
+      shuffleWriterOptions.hashPartitionKeys.push_back(std::stoi(key));
+    }
+  }
+  if (sortKeysJstr != nullptr) {
+    shuffleWriterOptions.sortKeys = parseShuffleSortKeys(jStringToCString(env, sortKeysJstr));
+  }
 
   // Build PartitionWriterOptions.
   auto partitionWriterOptions = PartitionWriterOptions{
@@ -903,6 +990,29 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
   auto partitionWriterType = std::string(partitionWriterTypeC);
   env->ReleaseStringUTFChars(partitionWriterTypeJstr, partitionWriterTypeC);
 
+  if (auto confFile = takeShuffleWriterConfFile(taskAttemptId)) {
+    auto compression = partitionWriterOptions.compressionTypeStr;
+    if (codecJstr != nullptr && codecBackendJstr != nullptr) {
+      compression = jStringToCString(env, codecBackendJstr) + "_" + compression;
+    }
+    saveShuffleWriterConf(
+        *confFile,
+        {{"partitioning", partitioningName},
+         {"shuffle_partitions", std::to_string(numPartitions)},
+         {"shuffle_writer", shuffleWriterTypeName},
+         {"partition_writer", partitionWriterType},
+         {"compression", compression},
+         {"compression_level", std::to_string(compressionLevel)},
+         {"compression_threshold", std::to_string(compressionThreshold)},
+         {"merge_buffer_size", std::to_string(mergeBufferSize)},
+         {"merge_threshold", std::to_string(mergeThreshold)},
+         {"buffer_size", std::to_string(bufferSize)},
+         {"buffer_realloc_threshold", std::to_string(reallocThreshold)},
+         {"sort_buffer_initial_size", std::to_string(sortBufferInitialSize)},
+         {"sort_evict_buffer_size", std::to_string(sortEvictBufferSize)},
+         {"use_radix_sort", std::to_string(static_cast<bool>(useRadixSort))}});
+  }
+
   if (partitionWriterType == "local") {
     if (dataFileJstr == NULL) {
       throw GlutenException(std::string("Shuffle DataFile can't be null"));
@@ -1028,6 +1138,12 @@ JNIEXPORT jobject JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrap
   auto rawSrc = reinterpret_cast<const jlong*>(rawPartitionLengths.data());
   env->SetLongArrayRegion(rawPartitionLengthArr, 0, rawPartitionLengths.size(), rawSrc);
 
+  // The writer the adaptive shuffle writer picked, null for the other writers.
+  const auto& adaptiveDecision = shuffleWriter->metrics().adaptiveDecision;
+  const auto decision = adaptiveDecision.value_or(AdaptiveShuffleWriterDecision{});
+  jstring adaptiveWriterType =
+      adaptiveDecision ? env->NewStringUTF(ShuffleWriter::typeToString(decision.writerType).c_str()) : nullptr;
+
   jobject splitResult = env->NewObject(
       splitResultClass,
       splitResultConstructor,
@@ -1042,7 +1158,13 @@ JNIEXPORT jobject JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrap
       shuffleWriter->totalBytesToEvict(),
       shuffleWriter->peakBytesAllocated(),
       partitionLengthArr,
-      rawPartitionLengthArr);
+      rawPartitionLengthArr,
+      adaptiveWriterType,
+      decision.sampledRows,
+      decision.avgRowBytes,
+      decision.activePartitions,
+      decision.partitionSkew,
+      decision.hashBufferRows);
 
   return splitResult;
   JNI_METHOD_END(nullptr)
@@ -1173,6 +1295,51 @@ JNIEXPORT jobject JNICALL Java_org_apache_gluten_vectorized_ColumnarBatchSeriali
   JNI_METHOD_END(nullptr)
 }
 
+JNIEXPORT jobject JNICALL Java_org_apache_gluten_vectorized_ColumnarBatchSerializerJniWrapper_serializeToChunks( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jlongArray handles,
+    jint chunkSize) {
+  JNI_METHOD_START
+  auto ctx = getRuntime(env, wrapper);
+
+  int32_t numBatches = env->GetArrayLength(handles);
+  auto safeArray = getLongArrayElementsSafe(env, handles);
+
+  std::vector<std::shared_ptr<ColumnarBatch>> batches;
+  int64_t numRows = 0L;
+  for (int32_t i = 0; i < numBatches; i++) {
+    auto batch = ObjectStore::retrieve<ColumnarBatch>(safeArray.elems()[i]);
+    GLUTEN_DCHECK(
+        batch != nullptr, "Cannot find the ColumnarBatch with handle " + std::to_string(safeArray.elems()[i]));
+    numRows += batch->numRows();
+    batches.emplace_back(batch);
+  }
+
+  auto serializer = ctx->createColumnarBatchSerializer(nullptr);
+  auto chunks = serializer->serializeColumnarBatchesToChunks(batches, chunkSize);
+
+  // Move every chunk into a JVM-owned direct buffer and free the native copy right away, so the serialized data never
+  // lives on the Java heap and at most one extra chunk is held twice.
+  auto chunkArr = env->NewObjectArray(chunks.size(), byteBufferClass, nullptr);
+  GLUTEN_CHECK(chunkArr != nullptr, "Cannot construct an array of " + std::to_string(chunks.size()) + " chunk(s)");
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    auto size = chunks[i]->size();
+    jobject chunk = env->CallStaticObjectMethod(byteBufferClass, byteBufferAllocateDirect, static_cast<jint>(size));
+    checkException(env);
+    auto address = env->GetDirectBufferAddress(chunk);
+    GLUTEN_CHECK(address != nullptr, "Cannot allocate a direct buffer of size " + std::to_string(size));
+    memcpy(address, chunks[i]->data(), size);
+    chunks[i].reset();
+    env->SetObjectArrayElement(chunkArr, i, chunk);
+    env->DeleteLocalRef(chunk);
+  }
+
+  return env->NewObject(
+      columnarBatchSerializedChunksClass, columnarBatchSerializedChunksConstructor, numRows, chunkArr);
+  JNI_METHOD_END(nullptr)
+}
+
 JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ColumnarBatchSerializerJniWrapper_init( // NOLINT
     JNIEnv* env,
     jobject wrapper,
@@ -1200,6 +1367,31 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ColumnarBatchSerialize
   JNI_METHOD_END(kInvalidObjectHandle)
 }
 
+JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ColumnarBatchSerializerJniWrapper_deserializeChunks( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jlong serializerHandle,
+    jobjectArray chunks) {
+  JNI_METHOD_START
+  auto ctx = getRuntime(env, wrapper);
+
+  auto serializer = ObjectStore::retrieve<ColumnarBatchSerializer>(serializerHandle);
+  GLUTEN_DCHECK(serializer != nullptr, "ColumnarBatchSerializer cannot be null");
+  int32_t numChunks = env->GetArrayLength(chunks);
+  std::vector<std::pair<uint8_t*, int64_t>> ranges;
+  ranges.reserve(numChunks);
+  for (int32_t i = 0; i < numChunks; ++i) {
+    jobject chunk = env->GetObjectArrayElement(chunks, i);
+    auto address = reinterpret_cast<uint8_t*>(env->GetDirectBufferAddress(chunk));
+    GLUTEN_CHECK(address != nullptr, "Serialized chunk " + std::to_string(i) + " is not a direct buffer");
+    ranges.emplace_back(address, env->GetDirectBufferCapacity(chunk));
+    env->DeleteLocalRef(chunk);
+  }
+  auto iter = serializer->deserializeChunks(std::move(ranges));
+  return ctx->saveObject(std::make_shared<ResultIterator>(std::move(iter)));
+  JNI_METHOD_END(kInvalidObjectHandle)
+}
+
 JNIEXPORT void JNICALL Java_org_apache_gluten_vectorized_ColumnarBatchSerializerJniWrapper_close( // NOLINT
     JNIEnv* env,
     jobject wrapper,
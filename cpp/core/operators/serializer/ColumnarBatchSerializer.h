@@ -17,9 +17,12 @@
 
 #pragma once
 
+#include <arrow/buffer.h>
 #include <arrow/c/abi.h>
 
 #include "memory/ColumnarBatch.h"
+#include "memory/ColumnarBatchIterator.h"
+#include "utils/Exception.h"
 
 namespace gluten {
 
@@ -34,6 +37,21 @@ class ColumnarBatchSerializer {
 
   virtual std::shared_ptr<ColumnarBatch> deserialize(uint8_t* data, int32_t size) = 0;
 
+  // Serializes the batches into a sequence of off-heap buffers, each at most `chunkSize` bytes. The concatenation of
+  // the chunks forms one stream that can be read back with deserializeChunks. A serialized batch may span chunks, so
+  // the total size is not bounded by the 2GB limit of a single Java byte array.
+  virtual std::vector<std::shared_ptr<arrow::Buffer>> serializeColumnarBatchesToChunks(
+      const std::vector<std::shared_ptr<ColumnarBatch>>& batches,
+      int64_t chunkSize) {
+    throw GlutenException("serializeColumnarBatchesToChunks is not supported by this serializer.");
+  }
+
+  // Returns an iterator that lazily deserializes batches from the chunks produced by serializeColumnarBatchesToChunks.
+  // The chunk memory is not copied and must stay valid until the iterator is destroyed.
+  virtual std::unique_ptr<ColumnarBatchIterator> deserializeChunks(std::vector<std::pair<uint8_t*, int64_t>> chunks) {
+    throw GlutenException("deserializeChunks is not supported by this serializer.");
+  }
+
  protected:
   arrow::MemoryPool* arrowPool_;
 };
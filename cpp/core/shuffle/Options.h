@@ -19,6 +19,9 @@
 
 #include <arrow/ipc/options.h>
 #include <arrow/util/compression.h>
+#include <optional>
+#include <vector>
+
 #include "shuffle/Partitioning.h"
 #include "utils/Compression.h"
 
@@ -40,11 +43,22 @@ static constexpr bool kDefaultUseRadixSort = true;
 static constexpr int32_t kDefaultSortBufferSize = 4096;
 static constexpr int64_t kDefaultReadBufferSize = 1 << 20;
 static constexpr int64_t kDefaultShuffleFileBufferSize = 32 << 10;
+static constexpr int32_t kDefaultAdaptiveSampleBatches = 4;
+static constexpr int32_t kDefaultAdaptiveMinHashBufferRows = 64;
+static constexpr int32_t kDefaultAdaptiveMinRowsPerPartition = 4;
 
-enum ShuffleWriterType { kHashShuffle, kSortShuffle, kRssSortShuffle };
+enum ShuffleWriterType { kHashShuffle, kSortShuffle, kRssSortShuffle, kAdaptiveShuffle };
 enum PartitionWriterType { kLocal, kRss };
 enum SortAlgorithm { kRadixSort, kQuickSort };
 
+// A key the sort shuffle writer orders the rows of each partition by. The channel is the ordinal of the column among
+// the written columns, i.e. excluding the partition id or hash column.
+struct ShuffleSortKey {
+  int32_t channel = 0;
+  bool ascending = true;
+  bool nullsFirst = true;
+};
+
 struct ShuffleReaderOptions {
   arrow::Compression::type compressionType = arrow::Compression::type::LZ4_FRAME;
   std::string compressionTypeStr = "lz4";
@@ -63,11 +77,25 @@ struct ShuffleWriterOptions {
   int32_t startPartitionId = 0;
   int64_t threadId = -1;
   ShuffleWriterType shuffleWriterType = kHashShuffle;
+  // Ordinals of the hash partitioning keys. If not empty, the shuffle writer computes the partition key hash from
+  // these columns instead of reading it from the first column.
+  std::vector<int32_t> hashPartitionKeys{};
 
   // Sort shuffle writer.
   int32_t sortBufferInitialSize = kDefaultSortBufferSize;
   int32_t sortEvictBufferSize = kDefaultSortEvictBufferSize;
   bool useRadixSort = kDefaultUseRadixSort;
+  // If not empty, rows are also ordered by these keys within each partition. Every evicted run of a partition is then
+  // sorted, and the reducer only has to merge the runs, see VeloxSortedRunMerger.
+  std::vector<ShuffleSortKey> sortKeys{};
+
+  // Adaptive shuffle writer. It buffers the first batches and then picks the sort writer if, given the sampled row
+  // width, the hash writer could only afford partition buffers smaller than adaptiveMinHashBufferRows rows, or if the
+  // partitions receiving rows get fewer than adaptiveMinRowsPerPartition rows per batch on average without being
+  // skewed towards a few hot ones.
+  int32_t adaptiveSampleBatches = kDefaultAdaptiveSampleBatches;
+  int32_t adaptiveMinHashBufferRows = kDefaultAdaptiveMinHashBufferRows;
+  int32_t adaptiveMinRowsPerPartition = kDefaultAdaptiveMinRowsPerPartition;
 };
 
 struct PartitionWriterOptions {
@@ -91,6 +119,19 @@ struct PartitionWriterOptions {
   int64_t shuffleFileBufferSize = kDefaultShuffleFileBufferSize;
 };
 
+// The writer the adaptive shuffle writer picked and the sampled inputs of that choice.
+struct AdaptiveShuffleWriterDecision {
+  ShuffleWriterType writerType{kHashShuffle};
+  int64_t sampledRows{0};
+  double avgRowBytes{0};
+  // Partitions that received at least one sampled row.
+  int32_t activePartitions{0};
+  // Rows of the largest partition over the mean rows of the active partitions.
+  double partitionSkew{0};
+  // Per-partition buffer rows the hash writer would allocate under the memory limit.
+  int64_t hashBufferRows{0};
+};
+
 struct ShuffleWriterMetrics {
   int64_t totalBytesWritten{0};
   int64_t totalBytesEvicted{0};
@@ -100,5 +141,6 @@ struct ShuffleWriterMetrics {
   int64_t totalCompressTime{0};
   std::vector<int64_t> partitionLengths{};
   std::vector<int64_t> rawPartitionLengths{}; // Uncompressed size.
+  std::optional<AdaptiveShuffleWriterDecision> adaptiveDecision{};
 };
 } // namespace gluten
@@ -24,6 +24,7 @@ namespace {
 const std::string kHashShuffleName = "hash";
 const std::string kSortShuffleName = "sort";
 const std::string kRssSortShuffleName = "rss_sort";
+const std::string kAdaptiveShuffleName = "adaptive";
 } // namespace
 
 ShuffleWriterType ShuffleWriter::stringToType(const std::string& type) {
@@ -36,9 +37,26 @@ ShuffleWriterType ShuffleWriter::stringToType(const std::string& type) {
   if (type == kRssSortShuffleName) {
     return ShuffleWriterType::kRssSortShuffle;
   }
+  if (type == kAdaptiveShuffleName) {
+    return ShuffleWriterType::kAdaptiveShuffle;
+  }
   throw GlutenException("Unrecognized shuffle writer type: " + type);
 }
 
+std::string ShuffleWriter::typeToString(ShuffleWriterType type) {
+  switch (type) {
+    case ShuffleWriterType::kHashShuffle:
+      return kHashShuffleName;
+    case ShuffleWriterType::kSortShuffle:
+      return kSortShuffleName;
+    case ShuffleWriterType::kRssSortShuffle:
+      return kRssSortShuffleName;
+    case ShuffleWriterType::kAdaptiveShuffle:
+      return kAdaptiveShuffleName;
+  }
+  throw GlutenException("Unrecognized shuffle writer type: " + std::to_string(type));
+}
+
 int32_t ShuffleWriter::numPartitions() const {
   return numPartitions_;
 }
@@ -91,6 +109,10 @@ const std::vector<int64_t>& ShuffleWriter::rawPartitionLengths() const {
   return metrics_.rawPartitionLengths;
 }
 
+const ShuffleWriterMetrics& ShuffleWriter::metrics() const {
+  return metrics_;
+}
+
 ShuffleWriter::ShuffleWriter(int32_t numPartitions, ShuffleWriterOptions options, arrow::MemoryPool* pool)
     : numPartitions_(numPartitions), options_(std::move(options)), pool_(pool) {}
 } // namespace gluten
@@ -40,6 +40,8 @@ class ShuffleWriter : public Reclaimable {
 
   static ShuffleWriterType stringToType(const std::string& type);
 
+  static std::string typeToString(ShuffleWriterType type);
+
   virtual arrow::Status write(std::shared_ptr<ColumnarBatch> cb, int64_t memLimit) = 0;
 
   virtual arrow::Status stop() = 0;
@@ -70,6 +72,8 @@ class ShuffleWriter : public Reclaimable {
 
   const std::vector<int64_t>& rawPartitionLengths() const;
 
+  const ShuffleWriterMetrics& metrics() const;
+
  protected:
   ShuffleWriter(int32_t numPartitions, ShuffleWriterOptions options, arrow::MemoryPool* pool);
 
@@ -28,6 +28,7 @@
 #include <sstream>
 #include <thread>
 #include "shuffle/Options.h"
+#include "utils/Exception.h"
 #include "utils/StringUtil.h"
 #include "utils/Timer.h"
 
@@ -332,6 +333,21 @@ std::string gluten::getShuffleSpillDir(const std::string& configuredDir, int32_t
   return std::filesystem::path(configuredDir) / ss.str();
 }
 
+std::vector<gluten::ShuffleSortKey> gluten::parseShuffleSortKeys(const std::string& keys) {
+  std::vector<ShuffleSortKey> result;
+  for (const auto& key : splitByDelim(keys, ',')) {
+    auto parts = splitByDelim(key, ':');
+    GLUTEN_CHECK(
+        parts.size() == 3 && (parts[1] == "asc" || parts[1] == "desc") &&
+            (parts[2] == "nulls_first" || parts[2] == "nulls_last"),
+        "Invalid shuffle sort key: " + key);
+    result.push_back(
+        ShuffleSortKey{
+            .channel = std::stoi(parts[0]), .ascending = parts[1] == "asc", .nullsFirst = parts[2] == "nulls_first"});
+  }
+  return result;
+}
+
 arrow::Result<std::string> gluten::createTempShuffleFile(const std::string& dir) {
   if (dir.length() == 0) {
     return arrow::Status::Invalid("Failed to create spilled file, got empty path.");
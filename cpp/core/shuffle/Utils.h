@@ -25,6 +25,7 @@
 #include <chrono>
 #include <filesystem>
 
+#include "shuffle/Options.h"
 #include "utils/Compression.h"
 
 namespace gluten {
@@ -40,6 +41,10 @@ std::string getShuffleSpillDir(const std::string& configuredDir, int32_t subDirI
 
 arrow::Result<std::string> createTempShuffleFile(const std::string& dir);
 
+// Parses comma-separated sort keys of the form <ordinal>:<asc|desc>:<nulls_first|nulls_last>, e.g.
+// "0:asc:nulls_first,2:desc:nulls_last".
+std::vector<ShuffleSortKey> parseShuffleSortKeys(const std::string& keys);
+
 arrow::Result<std::vector<std::shared_ptr<arrow::DataType>>> toShuffleTypeId(
     const std::vector<std::shared_ptr<arrow::Field>>& fields);
 
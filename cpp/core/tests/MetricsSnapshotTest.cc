@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/MetricsSnapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace gluten;
+
+namespace {
+void fill(Metrics& metrics, long value) {
+  std::fill(metrics.arrayRawPtr, metrics.arrayRawPtr + metrics.numMetrics * Metrics::kNum, value);
+}
+} // namespace
+
+TEST(MetricsSnapshot, layout) {
+  MetricsSnapshot snapshot(3);
+  ASSERT_EQ(snapshot.sizeInBytes(), (MetricsSnapshot::kHeaderSlots + 3 * Metrics::kNum) * sizeof(int64_t));
+
+  auto* slots = static_cast<int64_t*>(snapshot.data());
+  ASSERT_EQ(slots[MetricsSnapshot::kSequenceSlot], 0);
+  ASSERT_EQ(slots[MetricsSnapshot::kNumMetricsSlot], 3);
+  ASSERT_EQ(slots[MetricsSnapshot::kNumTypesSlot], Metrics::kNum);
+  ASSERT_EQ(slots[MetricsSnapshot::kPeakMemoryBytesTypeSlot], Metrics::kPeakMemoryBytes);
+
+  std::vector<int64_t> values;
+  ASSERT_EQ(snapshot.read(values), 0);
+  ASSERT_EQ(values.size(), 3 * Metrics::kNum);
+
+  Metrics metrics(3);
+  fill(metrics, 0);
+  metrics.get(Metrics::kOutputRows)[1] = 42;
+  snapshot.publish(metrics);
+  ASSERT_EQ(slots[MetricsSnapshot::kSequenceSlot], 2);
+  ASSERT_EQ(slots[MetricsSnapshot::kHeaderSlots + Metrics::kOutputRows * 3 + 1], 42);
+
+  ASSERT_EQ(snapshot.read(values), 1);
+  ASSERT_EQ(values[Metrics::kOutputRows * 3 + 1], 42);
+}
+
+TEST(MetricsSnapshot, readConcurrentlyWithPublish) {
+  constexpr unsigned int kNumMetrics = 16;
+  constexpr long kGenerations = 20000;
+  MetricsSnapshot snapshot(kNumMetrics);
+
+  // Every publication sets all values to its generation, so a torn read would see different values.
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    Metrics metrics(kNumMetrics);
+    for (long generation = 1; generation <= kGenerations; ++generation) {
+      fill(metrics, generation);
+      snapshot.publish(metrics);
+    }
+    done = true;
+  });
+
+  std::vector<int64_t> values;
+  int64_t lastSequence = 0;
+  int64_t numInconsistentReads = 0;
+  while (!done || lastSequence < kGenerations) {
+    auto sequence = snapshot.read(values);
+    if (sequence < lastSequence ||
+        std::any_of(values.begin(), values.end(), [&](auto value) { return value != sequence; })) {
+      ++numInconsistentReads;
+    }
+    lastSequence = sequence;
+  }
+  writer.join();
+
+  ASSERT_EQ(numInconsistentReads, 0);
+  ASSERT_EQ(lastSequence, kGenerations);
+}
@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/SparkHash.h"
+
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace gluten::sparkhash;
+
+namespace {
+int32_t murmur3String(const std::string& str, int32_t seed = murmur3::kSeed) {
+  return murmur3::hashBytes(str.data(), str.size(), seed);
+}
+
+int32_t hiveString(const std::string& str) {
+  return hive::hashBytes(str.data(), str.size());
+}
+
+__int128 pow10(int32_t exponent) {
+  __int128 result = 1;
+  for (int32_t i = 0; i < exponent; ++i) {
+    result *= 10;
+  }
+  return result;
+}
+} // namespace
+
+TEST(SparkHash, murmur3Primitives) {
+  // SELECT hash(1), also of true, 1Y, 1S and DATE'1970-01-02'.
+  EXPECT_EQ(murmur3::hashInt(1, murmur3::kSeed), -559580957);
+  EXPECT_EQ(murmur3::hashInt(0, murmur3::kSeed), 933211791);
+  EXPECT_EQ(murmur3::hashInt(-7, murmur3::kSeed), -1618159745);
+  EXPECT_EQ(murmur3::hashLong(1, murmur3::kSeed), -1712319331);
+  EXPECT_EQ(murmur3::hashLong(-1, murmur3::kSeed), -939490007);
+  EXPECT_EQ(murmur3::hashLong(std::numeric_limits<int64_t>::max(), murmur3::kSeed), -1604625029);
+
+  EXPECT_EQ(murmur3::hashFloat(1.5f, murmur3::kSeed), -221251528);
+  EXPECT_EQ(murmur3::hashDouble(1.5, murmur3::kSeed), 1290763749);
+  // -0.0 hashes as 0, and all NaNs as the canonical one.
+  EXPECT_EQ(murmur3::hashFloat(-0.0f, murmur3::kSeed), murmur3::hashInt(0, murmur3::kSeed));
+  EXPECT_EQ(murmur3::hashDouble(-0.0, murmur3::kSeed), murmur3::hashLong(0, murmur3::kSeed));
+  EXPECT_EQ(murmur3::hashFloat(std::numeric_limits<float>::quiet_NaN(), murmur3::kSeed), -349261430);
+  EXPECT_EQ(murmur3::hashFloat(-std::numeric_limits<float>::quiet_NaN(), murmur3::kSeed), -349261430);
+  EXPECT_EQ(murmur3::hashDouble(std::numeric_limits<double>::quiet_NaN(), murmur3::kSeed), -1281358385);
+}
+
+TEST(SparkHash, murmur3Strings) {
+  EXPECT_EQ(murmur3String(""), 142593372);
+  EXPECT_EQ(murmur3String("abc"), 1322437556);
+  // Spark mixes the trailing bytes one by one as sign-extended ints.
+  EXPECT_EQ(murmur3String("Spark SQL \xc3\xa9"), 329300937);
+  // The example of Spark's documentation: SELECT hash('Spark', array(123), 2).
+  auto hash = murmur3String("Spark");
+  hash = murmur3::hashInt(123, hash);
+  hash = murmur3::hashInt(2, hash);
+  EXPECT_EQ(hash, -1321691492);
+}
+
+TEST(SparkHash, murmur3Decimals) {
+  // Up to 18 digits, the unscaled long value.
+  EXPECT_EQ(murmur3::hashDecimal(12345, 10, murmur3::kSeed), murmur3::hashLong(12345, murmur3::kSeed));
+  EXPECT_EQ(murmur3::hashDecimal(12345, 10, murmur3::kSeed), 1416086240);
+  // Beyond, the shortest big-endian two's complement bytes of the unscaled value.
+  EXPECT_EQ(murmur3::hashDecimal(0, 38, murmur3::kSeed), -783713497);
+  EXPECT_EQ(murmur3::hashDecimal(12345, 38, murmur3::kSeed), 589679666);
+  EXPECT_EQ(murmur3::hashDecimal(-12345, 38, murmur3::kSeed), 265069572);
+  EXPECT_EQ(murmur3::hashDecimal(128, 38, murmur3::kSeed), -544401882);
+  EXPECT_EQ(murmur3::hashDecimal(-128, 38, murmur3::kSeed), 775851899);
+  EXPECT_EQ(murmur3::hashDecimal(255, 38, murmur3::kSeed), 1246198977);
+  EXPECT_EQ(murmur3::hashDecimal(pow10(37) + 123, 38, murmur3::kSeed), -557181543);
+  EXPECT_EQ(murmur3::hashDecimal(-(pow10(37) + 123), 38, murmur3::kSeed), 93991599);
+  const char oneByte[] = {0x7f};
+  EXPECT_EQ(murmur3::hashDecimal(127, 20, murmur3::kSeed), murmur3::hashBytes(oneByte, 1, murmur3::kSeed));
+  const char twoBytes[] = {0x00, static_cast<char>(0x80)};
+  EXPECT_EQ(murmur3::hashDecimal(128, 20, murmur3::kSeed), murmur3::hashBytes(twoBytes, 2, murmur3::kSeed));
+}
+
+TEST(SparkHash, hivePrimitives) {
+  EXPECT_EQ(hive::hashInt(17167), 17167);
+  EXPECT_EQ(hive::hashLong(-1), 0);
+  EXPECT_EQ(hive::hashLong((1L << 40) | 5), 261);
+  EXPECT_EQ(hive::hashFloat(1.5f), 1069547520);
+  EXPECT_EQ(hive::hashDouble(1.5), 1073217536);
+  EXPECT_EQ(hive::hashFloat(-0.0f), 0);
+  EXPECT_EQ(hive::hashDouble(-0.0), 0);
+  EXPECT_EQ(hive::hashFloat(std::numeric_limits<float>::quiet_NaN()), 0x7fc00000);
+
+  // TIMESTAMP'2017-02-24 10:56:29' and TIMESTAMP'2017-02-24 10:56:29.111111' in UTC.
+  EXPECT_EQ(hive::hashTimestamp(1487933789000000L), 1445725271);
+  EXPECT_EQ(hive::hashTimestamp(1487933789111111L), 1353936655);
+  EXPECT_EQ(hive::hashTimestamp(-1500000), 499999999);
+}
+
+TEST(SparkHash, hiveStrings) {
+  EXPECT_EQ(hiveString(""), 0);
+  EXPECT_EQ(hiveString("abc"), 96354);
+  // Over the signed UTF-8 bytes rather than the UTF-16 chars of java.lang.String.
+  EXPECT_EQ(hiveString("Spark SQL \xc3\xa9"), -753668421);
+}
+
+TEST(SparkHash, hiveDecimals) {
+  // Hashed as java.math.BigDecimal without trailing zeros.
+  EXPECT_EQ(hive::hashDecimal(18, 0), 558);
+  EXPECT_EQ(hive::hashDecimal(-18 * pow10(12), 12), -558);
+  EXPECT_EQ(hive::hashDecimal(150, 2), 466);
+  EXPECT_EQ(hive::hashDecimal(15, 1), 466);
+  // No negative scale.
+  EXPECT_EQ(hive::hashDecimal(100, 0), 3100);
+  EXPECT_EQ(hive::hashDecimal(0, 3), 0);
+  EXPECT_EQ(hive::hashDecimal(pow10(37) + 123, 5), -1331944927);
+  EXPECT_EQ(hive::hashDecimal(-(pow10(37) + 123), 5), 1331944937);
+}
+
+TEST(SparkHash, hiveRows) {
+  // hive_hash(1, 'abc', null).
+  auto hash = hive::combine(0, hive::hashInt(1));
+  hash = hive::combine(hash, hiveString("abc"));
+  hash = hive::combine(hash, 0);
+  EXPECT_EQ(hash, 2987935);
+}
+
+TEST(SparkHash, bucketIds) {
+  EXPECT_EQ(bucketId(murmur3::hashInt(1, murmur3::kSeed), 8), 3);
+  EXPECT_EQ(bucketId(murmur3String("abc"), 7), 6);
+  EXPECT_EQ(bucketId(-1, 7), 6);
+  EXPECT_EQ(bucketId(std::numeric_limits<int32_t>::min(), 7), 5);
+  EXPECT_EQ(hiveBucketId(hiveString("abc"), 7), 6);
+  EXPECT_EQ(hiveBucketId(-1, 7), std::numeric_limits<int32_t>::max() % 7);
+  EXPECT_EQ(hiveBucketId(std::numeric_limits<int32_t>::min(), 7), 0);
+}
@@ -0,0 +1,183 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/SparkStringKernels.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gluten::sparkstring;
+
+namespace {
+std::string upper(const std::string& str) {
+  std::string out(str.size(), '\0');
+  EXPECT_TRUE(toUpperAscii(str.data(), str.size(), out.data()));
+  return out;
+}
+
+std::string lower(const std::string& str) {
+  std::string out(str.size(), '\0');
+  EXPECT_TRUE(toLowerAscii(str.data(), str.size(), out.data()));
+  return out;
+}
+
+std::vector<std::string> split(std::string_view str, const std::string& regex, int32_t limit = -1) {
+  auto delimiter = literalSplitDelimiter(regex);
+  EXPECT_TRUE(delimiter.has_value());
+  LiteralSplitter splitter(*delimiter, limit);
+  splitter.reset(str);
+  std::vector<std::string> tokens;
+  std::string_view token;
+  while (splitter.next(token)) {
+    tokens.emplace_back(token);
+  }
+  return tokens;
+}
+} // namespace
+
+TEST(SparkStringKernels, ascii) {
+  EXPECT_TRUE(isAscii("", 0));
+  EXPECT_TRUE(isAscii("hello, world! 0123456789", 24));
+  const std::string mixed = "0123456789abcdefé";
+  EXPECT_FALSE(isAscii(mixed.data(), mixed.size()));
+  EXPECT_EQ(asciiPrefixLength(mixed.data(), mixed.size()), 16);
+  EXPECT_EQ(asciiPrefixLength("abcé", 5), 3);
+  // Non-ASCII bytes in and after the 16-byte blocks.
+  const std::string longMixed = std::string(37, 'a') + "é" + std::string(20, 'b');
+  EXPECT_EQ(asciiPrefixLength(longMixed.data(), longMixed.size()), 37);
+  EXPECT_EQ(asciiPrefixLength(longMixed.data(), 37), 37);
+  EXPECT_EQ(asciiPrefixLength(longMixed.data() + 5, longMixed.size() - 5), 32);
+}
+
+TEST(SparkStringKernels, numChars) {
+  EXPECT_EQ(numChars("", 0), 0);
+  EXPECT_EQ(numChars("hello", 5), 5);
+  const std::string str = "Spark SQL 数据砖头 ünïcödé 😀!";
+  EXPECT_EQ(numChars(str.data(), str.size()), 25);
+  // Invalid UTF-8: a continuation byte counts as a character, and a truncated character as one.
+  EXPECT_EQ(numChars("\x80\x80" "a", 3), 3);
+  EXPECT_EQ(numChars("a\xe6\x95", 3), 2);
+}
+
+TEST(SparkStringKernels, caseMapping) {
+  EXPECT_EQ(upper("hello, World! @[`{ az AZ 09"), "HELLO, WORLD! @[`{ AZ AZ 09");
+  EXPECT_EQ(lower("hello, World! @[`{ az AZ 09"), "hello, world! @[`{ az az 09");
+  EXPECT_EQ(upper(""), "");
+  std::string out(8, '\0');
+  EXPECT_FALSE(toUpperAscii("straße", 7, out.data()));
+
+  // Every ASCII byte, so that all the boundaries of the letter ranges go through the 16-byte blocks.
+  std::string all(128, '\0');
+  for (int32_t c = 0; c < 128; ++c) {
+    all[c] = static_cast<char>(c);
+  }
+  std::string expectedUpper = all;
+  std::string expectedLower = all;
+  for (int32_t c = 0; c < 128; ++c) {
+    expectedUpper[c] = static_cast<char>(c >= 'a' && c <= 'z' ? c - 32 : c);
+    expectedLower[c] = static_cast<char>(c >= 'A' && c <= 'Z' ? c + 32 : c);
+  }
+  EXPECT_EQ(upper(all), expectedUpper);
+  EXPECT_EQ(lower(all), expectedLower);
+  const std::string longNonAscii = std::string(40, 'a') + "ß";
+  out.resize(longNonAscii.size());
+  EXPECT_FALSE(toLowerAscii(longNonAscii.data(), longNonAscii.size(), out.data()));
+}
+
+TEST(SparkStringKernels, trimSpaces) {
+  EXPECT_EQ((trimSpaces<true, true>("  a b  ")), "a b");
+  EXPECT_EQ((trimSpaces<true, false>("  a b  ")), "a b  ");
+  EXPECT_EQ((trimSpaces<false, true>("  a b  ")), "  a b");
+  // Only spaces are removed.
+  EXPECT_EQ((trimSpaces<true, true>("\t a \n")), "\t a \n");
+  EXPECT_EQ((trimSpaces<true, true>("    ")), "");
+}
+
+TEST(SparkStringKernels, trim) {
+  TrimSet ascii("xy");
+  EXPECT_EQ((trim<true, true>("xyxabcyx", ascii)), "abc");
+  EXPECT_EQ((trim<true, false>("xyxabcyx", ascii)), "abcyx");
+  EXPECT_EQ((trim<false, true>("xyxabcyx", ascii)), "xyxabc");
+  EXPECT_EQ((trim<true, true>("xéx", ascii)), "é");
+
+  TrimSet multiByte("数é");
+  EXPECT_EQ((trim<true, true>("数é数据é数", multiByte)), "据");
+  EXPECT_EQ((trim<true, true>("数数", multiByte)), "");
+  // The bytes of a character of the trim string don't trim another character that shares them.
+  EXPECT_EQ((trim<true, true>("据", multiByte)), "据");
+
+  // Invalid UTF-8: 0xE4 starts a 3-byte character, so 0xE4 followed by "ab" is a single character that is not trimmed,
+  // even though the trim string is ASCII and contains 'b'.
+  TrimSet spaceB(" b");
+  EXPECT_EQ((trim<false, true>("x\xE4" "ab", spaceB)).size(), 4);
+  EXPECT_EQ((trim<true, true>("bx\xE4" "ab", spaceB)).size(), 4);
+  EXPECT_EQ((trim<false, true>("x\xE4" "abb ", spaceB)).size(), 4);
+}
+
+TEST(SparkStringKernels, indexOf) {
+  EXPECT_EQ(indexOf("hello", "", 0), 0);
+  EXPECT_EQ(indexOf("hello", "l", 0), 2);
+  EXPECT_EQ(indexOf("hello", "l", 3), 3);
+  EXPECT_EQ(indexOf("hello", "l", 4), -1);
+  EXPECT_EQ(indexOf("hello", "hello!", 0), -1);
+  EXPECT_EQ(indexOf("数据砖头数据", "数据", 0), 0);
+  EXPECT_EQ(indexOf("数据砖头数据", "数据", 1), 4);
+  EXPECT_EQ(indexOf("ab数据cd", "cd", 0), 4);
+  EXPECT_EQ(indexOf("ab", "b", 10), -1);
+}
+
+TEST(SparkStringKernels, substring) {
+  EXPECT_EQ(substring("Spark SQL", 1, 5), "Spark");
+  EXPECT_EQ(substring("Spark SQL", 0, 5), "Spark");
+  EXPECT_EQ(substring("Spark SQL", 7, 100), "SQL");
+  EXPECT_EQ(substring("Spark SQL", -3, 2), "SQ");
+  EXPECT_EQ(substring("Spark SQL", -100, 3), "");
+  EXPECT_EQ(substring("Spark SQL", 10, 1), "");
+  EXPECT_EQ(substring("Spark SQL", 2, -1), "");
+  EXPECT_EQ(substring("Spark SQL", 1, std::numeric_limits<int32_t>::max()), "Spark SQL");
+  EXPECT_EQ(substring("数据砖头", 2, 2), "据砖");
+  EXPECT_EQ(substring("数据砖头", -1, 1), "头");
+  EXPECT_EQ(substring("数据砖头", 3, 10), "砖头");
+}
+
+TEST(SparkStringKernels, literalSplitDelimiter) {
+  EXPECT_EQ(literalSplitDelimiter(","), ",");
+  EXPECT_EQ(literalSplitDelimiter("::"), "::");
+  EXPECT_EQ(literalSplitDelimiter("\\|"), "|");
+  EXPECT_EQ(literalSplitDelimiter("\\."), ".");
+  EXPECT_EQ(literalSplitDelimiter("数"), "数");
+  EXPECT_FALSE(literalSplitDelimiter("").has_value());
+  EXPECT_FALSE(literalSplitDelimiter("|").has_value());
+  EXPECT_FALSE(literalSplitDelimiter("a|b").has_value());
+  EXPECT_FALSE(literalSplitDelimiter("\\d").has_value());
+  EXPECT_FALSE(literalSplitDelimiter("\\s+").has_value());
+}
+
+TEST(SparkStringKernels, split) {
+  using Tokens = std::vector<std::string>;
+  EXPECT_EQ(split("a,b,,c,,", ","), (Tokens{"a", "b", "", "c", "", ""}));
+  EXPECT_EQ(split(",a", ","), (Tokens{"", "a"}));
+  EXPECT_EQ(split("abc", ","), (Tokens{"abc"}));
+  EXPECT_EQ(split("", ","), (Tokens{""}));
+  EXPECT_EQ(split("a::b::c", "::"), (Tokens{"a", "b", "c"}));
+  EXPECT_EQ(split("a|b|c", "\\|", 2), (Tokens{"a", "b|c"}));
+  EXPECT_EQ(split("a|b|c", "\\|", 1), (Tokens{"a|b|c"}));
+  EXPECT_EQ(split("a|b|c", "\\|", 0), (Tokens{"a", "b", "c"}));
+  EXPECT_EQ(split("数,据", ","), (Tokens{"数", "据"}));
+}
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <cassert>
 #include <memory>
 
 namespace gluten {
@@ -24,6 +25,8 @@ namespace gluten {
 struct Metrics {
   unsigned int numMetrics = 0;
   long veloxToArrow = 0;
+  // Spilled bytes of the task that the memory tier of the tiered spill file system kept, so they never reached disk.
+  long spilledMemoryTierBytes = 0;
 
   // The underlying memory buffer.
   std::unique_ptr<long[]> array;
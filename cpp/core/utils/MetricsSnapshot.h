@@ -0,0 +1,117 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "utils/Metrics.h"
+
+namespace gluten {
+
+/// A preallocated buffer that an iterator's Metrics are republished into while it runs, by a background publisher
+/// thread and finally by the task thread, so that other threads, e.g. the JVM through a direct ByteBuffer over data(),
+/// can read live operator metrics at any time without locking or stopping the task. Publishers must be serialized by
+/// the owner.
+///
+/// Publication is guarded by a sequence lock: the sequence is odd while the values are being written, so a reader
+/// retries if the sequence is odd or has changed during its copy.
+///
+/// The layout is a sequence of native-endian 64-bit slots: [sequence, numMetrics, numTypes, peakMemoryBytesType,
+/// values...], where the values have the layout of Metrics::array, i.e. numTypes (Metrics::kNum) arrays of numMetrics
+/// values each. The header carries the layout of Metrics, so the reader can verify that it matches its own.
+class MetricsSnapshot {
+ public:
+  static constexpr int32_t kSequenceSlot = 0;
+  static constexpr int32_t kNumMetricsSlot = 1;
+  static constexpr int32_t kNumTypesSlot = 2;
+  static constexpr int32_t kPeakMemoryBytesTypeSlot = 3;
+  static constexpr int32_t kHeaderSlots = 4;
+
+  static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t));
+  static_assert(sizeof(long) == sizeof(int64_t));
+
+  explicit MetricsSnapshot(unsigned int numMetrics)
+      : numMetrics_(numMetrics),
+        numSlots_(kHeaderSlots + static_cast<size_t>(numMetrics) * Metrics::kNum),
+        slots_(new std::atomic<int64_t>[numSlots_]) {
+    for (size_t i = 0; i < numSlots_; ++i) {
+      slots_[i].store(0, std::memory_order_relaxed);
+    }
+    slots_[kNumMetricsSlot].store(numMetrics, std::memory_order_relaxed);
+    slots_[kNumTypesSlot].store(Metrics::kNum, std::memory_order_relaxed);
+    slots_[kPeakMemoryBytesTypeSlot].store(Metrics::kPeakMemoryBytes, std::memory_order_relaxed);
+  }
+
+  MetricsSnapshot(const MetricsSnapshot&) = delete;
+  MetricsSnapshot& operator=(const MetricsSnapshot&) = delete;
+
+  unsigned int numMetrics() const {
+    return numMetrics_;
+  }
+
+  /// Publishes the values of metrics, which must have the same number of metrics. Only one thread may publish at a
+  /// time.
+  void publish(const Metrics& metrics) {
+    auto sequence = slots_[kSequenceSlot].load(std::memory_order_relaxed);
+    slots_[kSequenceSlot].store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < numSlots_ - kHeaderSlots; ++i) {
+      slots_[kHeaderSlots + i].store(metrics.arrayRawPtr[i], std::memory_order_relaxed);
+    }
+    slots_[kSequenceSlot].store(sequence + 2, std::memory_order_release);
+  }
+
+  /// Copies a consistent snapshot of the values into out. Returns the number of publications it reflects, which is 0
+  /// if nothing has been published yet.
+  int64_t read(std::vector<int64_t>& out) const {
+    out.resize(numSlots_ - kHeaderSlots);
+    while (true) {
+      auto before = slots_[kSequenceSlot].load(std::memory_order_acquire);
+      if (before & 1) {
+        std::this_thread::yield();
+        continue;
+      }
+      for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = slots_[kHeaderSlots + i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slots_[kSequenceSlot].load(std::memory_order_relaxed) == before) {
+        return before / 2;
+      }
+    }
+  }
+
+  void* data() {
+    return slots_.get();
+  }
+
+  int64_t sizeInBytes() const {
+    return numSlots_ * sizeof(int64_t);
+  }
+
+ private:
+  const unsigned int numMetrics_;
+  const size_t numSlots_;
+  std::unique_ptr<std::atomic<int64_t>[]> slots_;
+};
+
+} // namespace gluten
@@ -0,0 +1,242 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/// Scalar kernels of the hash functions Spark computes bucket ids with, shared by the Velox and the CH backend:
+/// - murmur3: Murmur3Hash with seed 42, i.e. `hash(cols...)`, which HashPartitioning and Spark's bucketed writes use
+///   as pmod(hash(cols...), numBuckets).
+/// - hive: HiveHash, which Hive-compatible bucketed writes use as pmod(hive_hash(cols...) & Int.MaxValue, numBuckets).
+///
+/// A row is hashed by folding the hash of each column into the hash of the previous ones as Spark does: murmur3 passes
+/// it as the seed of the next column and skips null values, hive computes 31 * hash + columnHash where null is 0.
+/// Decimals are passed as their unscaled value.
+namespace gluten::sparkhash {
+
+namespace detail {
+// Same as org.apache.spark.unsafe.hash.Murmur3_x86_32.
+constexpr uint32_t kC1 = 0xcc9e2d51;
+constexpr uint32_t kC2 = 0x1b873593;
+
+inline uint32_t rotateLeft(uint32_t x, int32_t r) {
+  return (x << r) | (x >> (32 - r));
+}
+
+inline uint32_t mixK1(uint32_t k1) {
+  k1 *= kC1;
+  k1 = rotateLeft(k1, 15);
+  return k1 * kC2;
+}
+
+inline uint32_t mixH1(uint32_t h1, uint32_t k1) {
+  h1 ^= k1;
+  h1 = rotateLeft(h1, 13);
+  return h1 * 5 + 0xe6546b64;
+}
+
+inline int32_t fmix(uint32_t h1, uint32_t length) {
+  h1 ^= length;
+  h1 ^= h1 >> 16;
+  h1 *= 0x85ebca6b;
+  h1 ^= h1 >> 13;
+  h1 *= 0xc2b2ae35;
+  h1 ^= h1 >> 16;
+  return static_cast<int32_t>(h1);
+}
+
+/// Java's int arithmetic, which wraps around.
+inline int32_t multiplyAdd(int32_t hash, int32_t multiplier, int32_t addend) {
+  return static_cast<int32_t>(static_cast<uint32_t>(hash) * static_cast<uint32_t>(multiplier) + addend);
+}
+
+inline unsigned __int128 magnitude(__int128 value) {
+  return value < 0 ? -static_cast<unsigned __int128>(value) : static_cast<unsigned __int128>(value);
+}
+} // namespace detail
+
+/// Java's Float.floatToIntBits and Double.doubleToLongBits, which collapse all NaNs into the canonical one. Spark also
+/// hashes -0.0 as 0.
+inline int32_t floatToIntBits(float value) {
+  if (std::isnan(value)) {
+    return 0x7fc00000;
+  }
+  if (value == 0.0f) {
+    return 0;
+  }
+  int32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+inline int64_t doubleToLongBits(double value) {
+  if (std::isnan(value)) {
+    return 0x7ff8000000000000L;
+  }
+  if (value == 0.0) {
+    return 0;
+  }
+  int64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+namespace murmur3 {
+
+constexpr int32_t kSeed = 42;
+
+/// Also boolean (as 1 or 0), tinyint, smallint and date.
+inline int32_t hashInt(int32_t input, int32_t seed) {
+  auto h1 = detail::mixH1(static_cast<uint32_t>(seed), detail::mixK1(static_cast<uint32_t>(input)));
+  return detail::fmix(h1, 4);
+}
+
+/// Also timestamp, as microseconds since the epoch.
+inline int32_t hashLong(int64_t input, int32_t seed) {
+  auto low = static_cast<uint32_t>(input);
+  auto high = static_cast<uint32_t>(static_cast<uint64_t>(input) >> 32);
+  auto h1 = detail::mixH1(static_cast<uint32_t>(seed), detail::mixK1(low));
+  h1 = detail::mixH1(h1, detail::mixK1(high));
+  return detail::fmix(h1, 8);
+}
+
+/// String and binary.
+inline int32_t hashBytes(const char* data, int32_t length, int32_t seed) {
+  auto h1 = static_cast<uint32_t>(seed);
+  auto alignedLength = length - length % 4;
+  for (auto i = 0; i < alignedLength; i += 4) {
+    uint32_t halfWord;
+    std::memcpy(&halfWord, data + i, sizeof(halfWord));
+    h1 = detail::mixH1(h1, detail::mixK1(halfWord));
+  }
+  // Unlike the reference Murmur3, Spark mixes each trailing byte separately as a sign-extended int.
+  for (auto i = alignedLength; i < length; ++i) {
+    h1 = detail::mixH1(h1, detail::mixK1(static_cast<uint32_t>(static_cast<int32_t>(static_cast<int8_t>(data[i])))));
+  }
+  return detail::fmix(h1, length);
+}
+
+inline int32_t hashFloat(float input, int32_t seed) {
+  return hashInt(floatToIntBits(input), seed);
+}
+
+inline int32_t hashDouble(double input, int32_t seed) {
+  return hashLong(doubleToLongBits(input), seed);
+}
+
+/// A decimal of at most 18 digits is hashed by its unscaled long value, a longer one by the bytes of its unscaled
+/// value as java.math.BigInteger.toByteArray returns them: the shortest big-endian two's complement.
+inline int32_t hashDecimal(__int128 unscaled, int32_t precision, int32_t seed) {
+  if (precision <= 18) {
+    return hashLong(static_cast<int64_t>(unscaled), seed);
+  }
+  int8_t bytes[sizeof(unscaled)];
+  auto bits = static_cast<unsigned __int128>(unscaled);
+  for (int i = sizeof(bytes) - 1; i >= 0; --i) {
+    bytes[i] = static_cast<int8_t>(bits & 0xff);
+    bits >>= 8;
+  }
+  // Drop the leading bytes that only repeat the sign of the next one.
+  int32_t offset = 0;
+  while (offset < static_cast<int32_t>(sizeof(bytes)) - 1
+         && ((bytes[offset] == 0 && bytes[offset + 1] >= 0) || (bytes[offset] == -1 && bytes[offset + 1] < 0))) {
+    ++offset;
+  }
+  return hashBytes(reinterpret_cast<const char*>(bytes) + offset, sizeof(bytes) - offset, seed);
+}
+
+} // namespace murmur3
+
+namespace hive {
+
+inline int32_t combine(int32_t hash, int32_t columnHash) {
+  return detail::multiplyAdd(hash, 31, columnHash);
+}
+
+/// Also boolean (as 1 or 0), tinyint, smallint and date.
+inline int32_t hashInt(int32_t input) {
+  return input;
+}
+
+inline int32_t hashLong(int64_t input) {
+  return static_cast<int32_t>((static_cast<uint64_t>(input) >> 32) ^ static_cast<uint64_t>(input));
+}
+
+/// String and binary, as java.lang.String.hashCode over the signed bytes.
+inline int32_t hashBytes(const char* data, int32_t length) {
+  int32_t result = 0;
+  for (int32_t i = 0; i < length; ++i) {
+    result = detail::multiplyAdd(result, 31, static_cast<int8_t>(data[i]));
+  }
+  return result;
+}
+
+inline int32_t hashFloat(float input) {
+  return floatToIntBits(input);
+}
+
+inline int32_t hashDouble(double input) {
+  return hashLong(doubleToLongBits(input));
+}
+
+/// Hive's hash of java.sql.Timestamp: the seconds shifted over the 30 bits of the nanoseconds, folded into 32 bits.
+inline int32_t hashTimestamp(int64_t micros) {
+  int64_t seconds = micros / 1000000;
+  int64_t nanos = (micros % 1000000) * 1000;
+  auto result = static_cast<int64_t>(static_cast<uint64_t>(seconds) << 30) | nanos;
+  return hashLong(result);
+}
+
+/// java.math.BigDecimal.hashCode of the decimal with its trailing zeros stripped, which is how Hive normalizes
+/// decimals before hashing. The scale does not go below 0.
+inline int32_t hashDecimal(__int128 unscaled, int32_t scale) {
+  while (scale > 0 && unscaled % 10 == 0) {
+    unscaled /= 10;
+    --scale;
+  }
+  if (unscaled == 0) {
+    scale = 0;
+  }
+  // java.math.BigInteger.hashCode: the 32-bit words of the magnitude from the most significant one, times the sign.
+  auto magnitude = detail::magnitude(unscaled);
+  int32_t hash = 0;
+  for (int shift = 96; shift >= 0; shift -= 32) {
+    hash = detail::multiplyAdd(hash, 31, static_cast<int32_t>(static_cast<uint32_t>(magnitude >> shift)));
+  }
+  if (unscaled < 0) {
+    hash = static_cast<int32_t>(0u - static_cast<uint32_t>(hash));
+  }
+  return combine(hash, scale);
+}
+
+} // namespace hive
+
+/// pmod(hash, numBuckets), the bucket id of Spark's bucketed writes.
+inline int32_t bucketId(int32_t murmur3Hash, int32_t numBuckets) {
+  auto mod = murmur3Hash % numBuckets;
+  return mod < 0 ? mod + numBuckets : mod;
+}
+
+/// pmod(hash & Int.MaxValue, numBuckets), the bucket id of Hive-compatible bucketed writes.
+inline int32_t hiveBucketId(int32_t hiveHash, int32_t numBuckets) {
+  return (hiveHash & 0x7fffffff) % numBuckets;
+}
+
+} // namespace gluten::sparkhash
@@ -0,0 +1,425 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/// Spark-compatible kernels of hot UTF-8 string functions, shared by the Velox and the CH backend. They are
+/// header-only and depend on the standard library and the compiler's SIMD intrinsics only, so both backends can call
+/// them from their own function registrations.
+///
+/// All kernels follow org.apache.spark.unsafe.types.UTF8String exactly, including on invalid UTF-8, where a character
+/// is as long as its first byte says (see numBytesForFirstByte). ASCII detection and case mapping process 16 bytes at a
+/// time with SSE2 or NEON where available, and 8 bytes at a time in a general purpose register (SWAR) otherwise and for
+/// the tail. The other kernels only walk character by character from the first non-ASCII byte on.
+namespace gluten::sparkstring {
+
+namespace detail {
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+inline uint64_t load(const char* data) {
+  uint64_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+inline void store(char* data, uint64_t word) {
+  std::memcpy(data, &word, sizeof(word));
+}
+
+/// Flips the case of the ASCII letters in [lower, upper] of a word of ASCII bytes.
+template <char lower, char upper>
+inline uint64_t flipCase(uint64_t word) {
+  // The high bit of a byte is set in geLower iff the byte >= lower, and in gtUpper iff the byte > upper.
+  const uint64_t geLower = word + (0x80 - lower) * kOnes;
+  const uint64_t gtUpper = word + (0x7f - upper) * kOnes;
+  const uint64_t inRange = (geLower ^ gtUpper) & kHighBits;
+  return word ^ (inRange >> 2);
+}
+
+template <char lower, char upper>
+inline bool flipAsciiCase(const char* in, size_t size, char* out) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  // Signed comparisons are fine since the bytes are checked to be ASCII first.
+  const auto belowRange = _mm_set1_epi8(lower - 1);
+  const auto aboveRange = _mm_set1_epi8(upper + 1);
+  const auto caseBit = _mm_set1_epi8(0x20);
+  for (; i + 16 <= size; i += 16) {
+    auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    if (_mm_movemask_epi8(bytes)) {
+      return false;
+    }
+    auto inRange = _mm_and_si128(_mm_cmpgt_epi8(bytes, belowRange), _mm_cmplt_epi8(bytes, aboveRange));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(bytes, _mm_and_si128(inRange, caseBit)));
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  const auto rangeBegin = vdupq_n_u8(lower);
+  const auto rangeEnd = vdupq_n_u8(upper);
+  const auto caseBit = vdupq_n_u8(0x20);
+  for (; i + 16 <= size; i += 16) {
+    auto bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(in + i));
+    if (vmaxvq_u8(bytes) >= 0x80) {
+      return false;
+    }
+    auto inRange = vandq_u8(vcgeq_u8(bytes, rangeBegin), vcleq_u8(bytes, rangeEnd));
+    vst1q_u8(reinterpret_cast<uint8_t*>(out + i), veorq_u8(bytes, vandq_u8(inRange, caseBit)));
+  }
+#endif
+  for (; i + 8 <= size; i += 8) {
+    auto word = load(in + i);
+    if (word & kHighBits) {
+      return false;
+    }
+    store(out + i, flipCase<lower, upper>(word));
+  }
+  for (; i < size; ++i) {
+    auto c = in[i];
+    if (static_cast<uint8_t>(c) >= 0x80) {
+      return false;
+    }
+    out[i] = (c >= lower && c <= upper) ? c ^ 0x20 : c;
+  }
+  return true;
+}
+} // namespace detail
+
+/// Same as UTF8String.numBytesForFirstByte: continuation and invalid leading bytes count as 1-byte characters.
+inline int32_t numBytesForFirstByte(uint8_t b) {
+  if (b < 0xc2) {
+    return 1;
+  }
+  if (b < 0xe0) {
+    return 2;
+  }
+  if (b < 0xf0) {
+    return 3;
+  }
+  if (b < 0xf5) {
+    return 4;
+  }
+  return 1;
+}
+
+/// Returns the length of the leading run of ASCII bytes.
+inline size_t asciiPrefixLength(const char* data, size_t size) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 16 <= size; i += 16) {
+    auto highBits = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+    if (highBits) {
+      return i + __builtin_ctz(highBits);
+    }
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  for (; i + 16 <= size; i += 16) {
+    if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(data + i))) >= 0x80) {
+      // The word loop below finds the first non-ASCII byte in this block.
+      break;
+    }
+  }
+#endif
+  for (; i + 8 <= size; i += 8) {
+    auto highBits = detail::load(data + i) & detail::kHighBits;
+    if (highBits) {
+      // Little endian: the lowest set bit is in the first non-ASCII byte.
+      return i + __builtin_ctzll(highBits) / 8;
+    }
+  }
+  while (i < size && static_cast<uint8_t>(data[i]) < 0x80) {
+    ++i;
+  }
+  return i;
+}
+
+inline bool isAscii(const char* data, size_t size) {
+  return asciiPrefixLength(data, size) == size;
+}
+
+/// Advances from byte position pos by up to numChars characters. Returns the new byte position, which may be past
+/// size if the last character is truncated, and the number of characters advanced.
+inline std::pair<size_t, int64_t> advanceChars(const char* data, size_t size, size_t pos, int64_t numChars) {
+  int64_t chars = 0;
+  while (pos < size && chars < numChars) {
+    if (static_cast<uint8_t>(data[pos]) < 0x80) {
+      // Skip a run of ASCII bytes, which are whole characters.
+      auto ascii = std::min<size_t>(asciiPrefixLength(data + pos, size - pos), numChars - chars);
+      pos += ascii;
+      chars += ascii;
+    } else {
+      pos += numBytesForFirstByte(data[pos]);
+      ++chars;
+    }
+  }
+  return {pos, chars};
+}
+
+/// length(): the number of characters.
+inline int64_t numChars(const char* data, size_t size) {
+  return advanceChars(data, size, 0, std::numeric_limits<int64_t>::max()).second;
+}
+
+/// upper() and lower() of ASCII strings, written to out, which must have room for size bytes. Return false if the
+/// string is not ASCII, in which case Spark maps the case with java.lang.String and the caller should fall back to its
+/// Unicode implementation.
+inline bool toUpperAscii(const char* in, size_t size, char* out) {
+  return detail::flipAsciiCase<'a', 'z'>(in, size, out);
+}
+
+inline bool toLowerAscii(const char* in, size_t size, char* out) {
+  return detail::flipAsciiCase<'A', 'Z'>(in, size, out);
+}
+
+/// trim(), ltrim() and rtrim() without a trim string, which remove ASCII spaces only.
+template <bool left, bool right>
+inline std::string_view trimSpaces(std::string_view str) {
+  size_t begin = 0;
+  size_t end = str.size();
+  if constexpr (left) {
+    while (begin < end && str[begin] == ' ') {
+      ++begin;
+    }
+  }
+  if constexpr (right) {
+    while (end > begin && str[end - 1] == ' ') {
+      --end;
+    }
+  }
+  return str.substr(begin, end - begin);
+}
+
+/// The characters to remove of trim(trimStr, str). As in Spark, a character of str is removed if its bytes appear in
+/// trimStr. Refers to trimStr, which must outlive it.
+class TrimSet {
+ public:
+  explicit TrimSet(std::string_view trimStr) : trimStr_(trimStr) {
+    for (auto c : trimStr) {
+      bytes_.set(static_cast<uint8_t>(c));
+    }
+    asciiOnly_ = isAscii(trimStr.data(), trimStr.size());
+  }
+
+  bool contains(const char* data, size_t size) const {
+    if (size == 1) {
+      return bytes_.test(static_cast<uint8_t>(*data));
+    }
+    return !asciiOnly_ && trimStr_.find(std::string_view(data, size)) != std::string_view::npos;
+  }
+
+  bool empty() const {
+    return trimStr_.empty();
+  }
+
+ private:
+  std::string_view trimStr_;
+  std::bitset<256> bytes_;
+  bool asciiOnly_;
+};
+
+/// trim(trimStr, str), ltrim(trimStr, str) and rtrim(trimStr, str).
+template <bool left, bool right>
+inline std::string_view trim(std::string_view str, const TrimSet& trimSet) {
+  const auto* data = str.data();
+  size_t begin = 0;
+  size_t end = str.size();
+  if constexpr (left) {
+    while (begin < end) {
+      auto charSize = std::min<size_t>(numBytesForFirstByte(data[begin]), end - begin);
+      if (!trimSet.contains(data + begin, charSize)) {
+        break;
+      }
+      begin += charSize;
+    }
+  }
+  if constexpr (right) {
+    if (isAscii(data + begin, end - begin)) {
+      // Every byte is a whole character. An ASCII-only trim set is not enough: a trailing ASCII byte may belong to a
+      // character started by an earlier leading byte, e.g. 0xE4 followed by "ab" is a single character.
+      while (end > begin && trimSet.contains(data + end - 1, 1)) {
+        --end;
+      }
+    } else {
+      // Character boundaries are only known from the left, so find the end of the last character not to trim.
+      size_t keepEnd = begin;
+      size_t pos = begin;
+      while (pos < end) {
+        auto charSize = std::min<size_t>(numBytesForFirstByte(data[pos]), end - pos);
+        pos += charSize;
+        if (!trimSet.contains(data + pos - charSize, charSize)) {
+          keepEnd = pos;
+        }
+      }
+      end = keepEnd;
+    }
+  }
+  return str.substr(begin, end - begin);
+}
+
+/// Returns the byte position of the first occurrence of pattern in str at or after from, or npos. Looks for the first
+/// byte with memchr and compares the rest only there.
+inline size_t find(std::string_view str, std::string_view pattern, size_t from = 0) {
+  if (pattern.empty()) {
+    return from <= str.size() ? from : std::string_view::npos;
+  }
+  const auto* data = str.data();
+  const auto* end = data + str.size();
+  const auto* pos = data + from;
+  while (pos + pattern.size() <= end) {
+    pos = static_cast<const char*>(std::memchr(pos, pattern[0], end - pos - pattern.size() + 1));
+    if (pos == nullptr) {
+      return std::string_view::npos;
+    }
+    if (std::memcmp(pos + 1, pattern.data() + 1, pattern.size() - 1) == 0) {
+      return pos - data;
+    }
+    ++pos;
+  }
+  return std::string_view::npos;
+}
+
+/// UTF8String.indexOf(pattern, start): the character position of the first occurrence of pattern starting at a
+/// character boundary at or after character start, or -1. instr(str, substr) is indexOf(substr, 0) + 1, and
+/// locate(substr, str, pos) is indexOf(substr, pos - 1) + 1 for pos >= 1.
+inline int64_t indexOf(std::string_view str, std::string_view pattern, int64_t start) {
+  if (pattern.empty()) {
+    return 0;
+  }
+  const auto* data = str.data();
+  auto [pos, chars] = advanceChars(data, str.size(), 0, start);
+  while (pos < str.size()) {
+    auto match = find(str, pattern, pos);
+    if (match == std::string_view::npos) {
+      return -1;
+    }
+    // Count the characters up to the match, which must start at a character boundary.
+    auto [next, advanced] = advanceChars(data, match, pos, std::numeric_limits<int64_t>::max());
+    chars += advanced;
+    if (next == match) {
+      return chars;
+    }
+    // The match starts inside a character, continue after that character.
+    pos = next;
+  }
+  return -1;
+}
+
+/// substring(str, pos, len), i.e. UTF8String.substringSQL: pos is 1-based, 0 is treated as 1, and a negative pos counts
+/// from the end. Callers that know str is ASCII can skip its detection with knownAscii.
+template <bool knownAscii = false>
+inline std::string_view substring(std::string_view str, int32_t pos, int32_t length) {
+  const auto* data = str.data();
+  const auto size = str.size();
+  const bool ascii = knownAscii || isAscii(data, size);
+  int64_t start;
+  if (pos > 0) {
+    start = pos - 1;
+  } else if (pos < 0) {
+    start = (ascii ? static_cast<int64_t>(size) : numChars(data, size)) + pos;
+  } else {
+    start = 0;
+  }
+  int64_t end = std::clamp<int64_t>(
+      start + length, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+  start = std::max<int64_t>(start, 0);
+  if (start >= end || start >= static_cast<int64_t>(size)) {
+    return {};
+  }
+  if (ascii) {
+    return str.substr(start, std::min<int64_t>(end, size) - start);
+  }
+  auto begin = advanceChars(data, size, 0, start).first;
+  auto until = std::min(advanceChars(data, size, begin, end - start).first, size);
+  if (begin >= until) {
+    return {};
+  }
+  return str.substr(begin, until - begin);
+}
+
+/// Returns the delimiter if the regex of split(str, regex, limit) matches a literal string, either because it has no
+/// metacharacters or because it's a single escaped non-alphanumeric character.
+inline std::optional<std::string> literalSplitDelimiter(std::string_view regex) {
+  static constexpr std::string_view kMetaCharacters = ".$|()[]{}^?*+\\";
+  if (regex.empty()) {
+    return std::nullopt;
+  }
+  if (regex.find_first_of(kMetaCharacters) == std::string_view::npos) {
+    return std::string(regex);
+  }
+  if (regex.size() >= 2 && regex[0] == '\\' && regex.size() - 1 == static_cast<size_t>(numBytesForFirstByte(regex[1])) &&
+      !std::isalnum(static_cast<uint8_t>(regex[1]))) {
+    return std::string(regex.substr(1));
+  }
+  return std::nullopt;
+}
+
+/// Splits strings around a literal delimiter as split(str, regex, limit) does, i.e. java.lang.String.split: a positive
+/// limit caps the number of tokens, the last one holding the rest of the string, and trailing empty tokens are kept.
+class LiteralSplitter {
+ public:
+  LiteralSplitter(std::string delimiter, int32_t limit) : delimiter_(std::move(delimiter)), limit_(limit) {}
+
+  void reset(std::string_view str) {
+    str_ = str;
+    pos_ = 0;
+    numTokens_ = 0;
+    done_ = false;
+  }
+
+  /// Returns the next token, or false if there's none left.
+  bool next(std::string_view& token) {
+    if (done_) {
+      return false;
+    }
+    ++numTokens_;
+    auto match = (limit_ > 0 && numTokens_ == limit_) ? std::string_view::npos : find(str_, delimiter_, pos_);
+    if (match == std::string_view::npos) {
+      token = str_.substr(pos_);
+      done_ = true;
+      return true;
+    }
+    token = str_.substr(pos_, match - pos_);
+    pos_ = match + delimiter_.size();
+    return true;
+  }
+
+ private:
+  const std::string delimiter_;
+  const int32_t limit_;
+  std::string_view str_;
+  size_t pos_{0};
+  int32_t numTokens_{0};
+  bool done_{true};
+};
+
+} // namespace gluten::sparkstring
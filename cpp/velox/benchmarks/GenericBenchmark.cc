@@ -16,6 +16,9 @@
  */
 
 #include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
 #include <thread>
 
 #include <arrow/c/bridge.h>
@@ -50,7 +53,7 @@ DEFINE_string(save_output, "", "Path to parquet file for saving the task output
 DEFINE_bool(with_shuffle, false, "Add shuffle split at end.");
 DEFINE_bool(run_shuffle, false, "Only run shuffle write.");
 DEFINE_bool(run_shuffle_read, false, "Whether to run shuffle read when run_shuffle is true.");
-DEFINE_string(shuffle_writer, "hash", "Shuffle writer type. Can be hash or sort");
+DEFINE_string(shuffle_writer, "hash", "Shuffle writer type. Can be hash, sort or adaptive");
 DEFINE_string(
     partitioning,
     "rr",
@@ -78,6 +81,23 @@ DEFINE_string(
     "'stream' mode: Input file scan happens inside of the pipeline."
     "'buffered' mode: First read all data into memory and feed the pipeline with it.");
 DEFINE_bool(debug_mode, false, "Whether to enable debug mode. Same as setting `spark.gluten.sql.debug`");
+DEFINE_string(
+    replay,
+    "",
+    "Path to the `spark.gluten.saveDir` of a saved task. Replays the task from its plan, splits, input data, "
+    "configuration and shuffle writer configuration. Options given on the command line take precedence.");
+DEFINE_string(
+    replay_task,
+    "",
+    "The task to replay from --replay, as `[stageId]_[partitionId]`. Can be omitted if only one task is saved.");
+DEFINE_string(
+    shuffle_conf,
+    "",
+    "Path to the shuffle writer configuration saved with a task. Implies --with_shuffle, and sets --partitioning, "
+    "--shuffle_partitions, --shuffle_writer, --compression and the writer options to the saved ones.");
+
+// The shuffle writer configuration loaded from --shuffle_conf.
+std::unordered_map<std::string, std::string> shuffleConf;
 
 struct WriterMetrics {
   int64_t splitTime{0};
@@ -94,6 +114,16 @@ struct ReaderMetrics {
   int64_t deserializeTime{0};
 };
 
+// Metrics of a plan node, summed over the iterations.
+struct OperatorMetrics {
+  std::string name;
+  int64_t wallNanos{0};
+  int64_t cpuNanos{0};
+  int64_t outputRows{0};
+  int64_t peakMemoryBytes{0};
+  int64_t spilledBytes{0};
+};
+
 void setUpBenchmark(::benchmark::internal::Benchmark* bm) {
   if (FLAGS_threads > 0) {
     bm->Threads(FLAGS_threads);
@@ -105,6 +135,99 @@ void setUpBenchmark(::benchmark::internal::Benchmark* bm) {
   }
 }
 
+// Sets the flag unless it's given on the command line.
+void setFlagIfDefault(const std::string& name, const std::string& value) {
+  if (!value.empty() && google::GetCommandLineFlagInfoOrDie(name.c_str()).is_default) {
+    google::SetCommandLineOption(name.c_str(), value.c_str());
+  }
+}
+
+// Loads the `key value` lines of a saved shuffle writer configuration.
+std::unordered_map<std::string, std::string> loadShuffleConf(const std::string& path) {
+  abortIfFileNotExists(path);
+  std::ifstream file(path);
+  std::unordered_map<std::string, std::string> conf;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream iss(line);
+    std::string key, value;
+    iss >> key;
+    std::getline(iss >> std::ws, value);
+    if (!key.empty()) {
+      conf[key] = value;
+    }
+  }
+  return conf;
+}
+
+// Sets --plan, --split, --data, --conf and --shuffle_conf to the files of the task saved in --replay, i.e.
+// plan_[id].json, split_[id]_[index].json, data_[id]_[index].parquet, conf_[id].ini and shuffle_writer_[id].ini.
+void setFlagsFromReplayDir() {
+  const std::filesystem::path dir{FLAGS_replay};
+  GLUTEN_CHECK(std::filesystem::is_directory(dir), "Not a directory: " + FLAGS_replay);
+
+  std::string id = FLAGS_replay_task;
+  if (id.empty()) {
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+      const auto name = entry.path().filename().string();
+      if (name.starts_with("plan_") && name.ends_with(".json")) {
+        GLUTEN_CHECK(id.empty(), "More than one task is saved in " + FLAGS_replay + ", specify --replay_task.");
+        id = name.substr(5, name.size() - 10);
+      }
+    }
+    GLUTEN_CHECK(!id.empty(), "No task is saved in " + FLAGS_replay);
+  }
+
+  // Returns the comma-separated paths of `[prefix]_[id]_[index][extension]` ordered by index, which is the order of
+  // the splits and the input iterators of the task.
+  auto indexedFiles = [&](const std::string& prefix, const std::string& extension) {
+    const auto stem = prefix + "_" + id + "_";
+    std::map<int32_t, std::string> files;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+      const auto name = entry.path().filename().string();
+      if (!name.starts_with(stem) || !name.ends_with(extension)) {
+        continue;
+      }
+      const auto index = name.substr(stem.size(), name.size() - stem.size() - extension.size());
+      if (!index.empty() && std::all_of(index.begin(), index.end(), ::isdigit)) {
+        files[std::stoi(index)] = entry.path().string();
+      }
+    }
+    std::string paths;
+    for (const auto& [_, path] : files) {
+      paths += (paths.empty() ? "" : ",") + path;
+    }
+    return paths;
+  };
+
+  auto fileIfExists = [&](const std::string& name) {
+    const auto path = dir / name;
+    return std::filesystem::exists(path) ? path.string() : std::string{};
+  };
+
+  const auto plan = fileIfExists("plan_" + id + ".json");
+  GLUTEN_CHECK(!plan.empty(), "No plan of task " + id + " is saved in " + FLAGS_replay);
+  setFlagIfDefault("plan", plan);
+  setFlagIfDefault("split", indexedFiles("split", ".json"));
+  setFlagIfDefault("data", indexedFiles("data", ".parquet"));
+  setFlagIfDefault("conf", fileIfExists("conf_" + id + ".ini"));
+  setFlagIfDefault("shuffle_conf", fileIfExists("shuffle_writer_" + id + ".ini"));
+}
+
+// Applies the shuffle writer configuration in --shuffle_conf to the shuffle flags.
+void setFlagsFromShuffleConf() {
+  shuffleConf = loadShuffleConf(FLAGS_shuffle_conf);
+  for (const auto* flag : {"partitioning", "shuffle_partitions", "shuffle_writer", "compression"}) {
+    if (auto it = shuffleConf.find(flag); it != shuffleConf.end()) {
+      setFlagIfDefault(flag, it->second);
+    }
+  }
+  if (auto it = shuffleConf.find("partition_writer"); it != shuffleConf.end() && it->second != "local") {
+    setFlagIfDefault("rss", "true");
+  }
+  setFlagIfDefault("with_shuffle", "true");
+}
+
 std::string generateUniqueSubdir(const std::string& parent, const std::string& prefix = "") {
   auto path = std::filesystem::path(parent) / (prefix + generateUuid());
   std::error_code ec{};
@@ -172,6 +295,24 @@ PartitionWriterOptions createPartitionWriterOptions() {
   } else if (FLAGS_compression == "iaa_gzip") {
     partitionWriterOptions.codecBackend = CodecBackend::IAA;
     partitionWriterOptions.compressionType = arrow::Compression::GZIP;
+  } else if (FLAGS_compression == "none") {
+    partitionWriterOptions.codecBackend = CodecBackend::NONE;
+    partitionWriterOptions.compressionType = arrow::Compression::UNCOMPRESSED;
+    partitionWriterOptions.compressionTypeStr = "none";
+  }
+
+  // Replay the saved writer options.
+  if (auto it = shuffleConf.find("compression_level"); it != shuffleConf.end()) {
+    partitionWriterOptions.compressionLevel = std::stoi(it->second);
+  }
+  if (auto it = shuffleConf.find("compression_threshold"); it != shuffleConf.end()) {
+    partitionWriterOptions.compressionThreshold = std::stoi(it->second);
+  }
+  if (auto it = shuffleConf.find("merge_buffer_size"); it != shuffleConf.end()) {
+    partitionWriterOptions.mergeBufferSize = std::stoi(it->second);
+  }
+  if (auto it = shuffleConf.find("merge_threshold"); it != shuffleConf.end()) {
+    partitionWriterOptions.mergeThreshold = std::stod(it->second);
   }
   return partitionWriterOptions;
 }
@@ -209,6 +350,23 @@ std::shared_ptr<VeloxShuffleWriter> createShuffleWriter(
     options.shuffleWriterType = gluten::kRssSortShuffle;
   } else if (FLAGS_shuffle_writer == "sort") {
     options.shuffleWriterType = gluten::kSortShuffle;
+  } else if (FLAGS_shuffle_writer == "adaptive") {
+    options.shuffleWriterType = gluten::kAdaptiveShuffle;
+  }
+  if (auto it = shuffleConf.find("buffer_size"); it != shuffleConf.end()) {
+    options.bufferSize = std::stoi(it->second);
+  }
+  if (auto it = shuffleConf.find("buffer_realloc_threshold"); it != shuffleConf.end()) {
+    options.bufferReallocThreshold = std::stod(it->second);
+  }
+  if (auto it = shuffleConf.find("sort_buffer_initial_size"); it != shuffleConf.end()) {
+    options.sortBufferInitialSize = std::stoi(it->second);
+  }
+  if (auto it = shuffleConf.find("sort_evict_buffer_size"); it != shuffleConf.end()) {
+    options.sortEvictBufferSize = std::stoi(it->second);
+  }
+  if (auto it = shuffleConf.find("use_radix_sort"); it != shuffleConf.end()) {
+    options.useRadixSort = it->second == "1" || it->second == "true";
   }
   auto shuffleWriter =
       runtime->createShuffleWriter(FLAGS_shuffle_partitions, std::move(partitionWriter), std::move(options));
@@ -302,6 +460,48 @@ void runShuffle(
   }
 }
 
+void collectOperatorMetrics(
+    const facebook::velox::core::PlanNode& planNode,
+    const std::unordered_map<facebook::velox::core::PlanNodeId, facebook::velox::exec::PlanNodeStats>& planStats,
+    std::map<std::string, OperatorMetrics>& metrics) {
+  if (auto it = planStats.find(planNode.id()); it != planStats.end()) {
+    const auto& stats = it->second;
+    auto& nodeMetrics = metrics[planNode.id()];
+    nodeMetrics.name = planNode.name();
+    nodeMetrics.wallNanos += stats.cpuWallTiming.wallNanos;
+    nodeMetrics.cpuNanos += stats.cpuWallTiming.cpuNanos;
+    nodeMetrics.outputRows += stats.outputRows;
+    nodeMetrics.peakMemoryBytes = std::max<int64_t>(nodeMetrics.peakMemoryBytes, stats.peakMemoryBytes);
+    nodeMetrics.spilledBytes += stats.spilledBytes;
+  }
+  for (const auto& source : planNode.sources()) {
+    collectOperatorMetrics(*source, planStats, metrics);
+  }
+}
+
+// Reports the metrics of each plan node as `[nodeId]_[nodeName]_[metric]`, and the peak memory of the task as seen by
+// the memory listener, to track regressions of the replayed stage.
+void updateOperatorMetrics(
+    ::benchmark::State& state,
+    const std::map<std::string, OperatorMetrics>& operatorMetrics,
+    int64_t peakMemoryBytes) {
+  for (const auto& [nodeId, metrics] : operatorMetrics) {
+    const auto prefix = nodeId + "_" + metrics.name + "_";
+    state.counters[prefix + "wall_time"] =
+        benchmark::Counter(metrics.wallNanos, benchmark::Counter::kAvgIterations, benchmark::Counter::OneK::kIs1000);
+    state.counters[prefix + "cpu_time"] =
+        benchmark::Counter(metrics.cpuNanos, benchmark::Counter::kAvgIterations, benchmark::Counter::OneK::kIs1000);
+    state.counters[prefix + "output_rows"] =
+        benchmark::Counter(metrics.outputRows, benchmark::Counter::kAvgIterations, benchmark::Counter::OneK::kIs1000);
+    state.counters[prefix + "peak_memory"] = benchmark::Counter(
+        metrics.peakMemoryBytes, benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024);
+    state.counters[prefix + "spilled_bytes"] =
+        benchmark::Counter(metrics.spilledBytes, benchmark::Counter::kAvgIterations, benchmark::Counter::OneK::kIs1024);
+  }
+  state.counters["peak_memory"] =
+      benchmark::Counter(peakMemoryBytes, benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024);
+}
+
 void updateBenchmarkMetrics(
     ::benchmark::State& state,
     const int64_t& elapsedTime,
@@ -377,6 +577,7 @@ auto BM_Generic = [](::benchmark::State& state,
 
   WriterMetrics writerMetrics{};
   ReaderMetrics readerMetrics{};
+  std::map<std::string, OperatorMetrics> operatorMetrics;
   int64_t readInputTime = 0;
   int64_t elapsedTime = 0;
 
@@ -458,10 +659,12 @@ auto BM_Generic = [](::benchmark::State& state,
       const auto* planNode = rawIter->veloxPlan();
       auto statsStr = facebook::velox::exec::printPlanWithStats(*planNode, task->taskStats(), true);
       LOG(WARNING) << statsStr;
+      collectOperatorMetrics(*planNode, facebook::velox::exec::toPlanStats(task->taskStats()), operatorMetrics);
     }
   }
 
   updateBenchmarkMetrics(state, elapsedTime, readInputTime, writerMetrics, readerMetrics);
+  updateOperatorMetrics(state, operatorMetrics, listenerPtr->peakBytes());
   Runtime::release(runtime);
   MemoryManager::release(memoryManager);
 };
@@ -514,6 +717,18 @@ auto BM_ShuffleWriteRead = [](::benchmark::State& state,
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
+  try {
+    if (!FLAGS_replay.empty()) {
+      setFlagsFromReplayDir();
+    }
+    if (!FLAGS_shuffle_conf.empty()) {
+      setFlagsFromShuffleConf();
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Incorrect usage: " << e.what();
+    std::exit(EXIT_FAILURE);
+  }
+
   std::ostringstream ss;
   ss << "Setting flags from command line args: " << std::endl;
   std::vector<google::CommandLineFlagInfo> flags;
@@ -585,6 +800,11 @@ int main(int argc, char** argv) {
     sessionConf = backendConf;
   }
 
+  // Run with the off-heap memory of the saved task unless a limit is given.
+  if (auto it = sessionConf.find(kSparkTaskOffHeapMemory); it != sessionConf.end()) {
+    setFlagIfDefault("memory_limit", it->second);
+  }
+
   initVeloxBackend(backendConf);
   memory::MemoryManager::testingSetInstance({});
 
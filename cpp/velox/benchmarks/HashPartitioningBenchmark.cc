@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+
+#include "benchmarks/common/BenchmarkUtils.h"
+#include "memory/ArrowMemoryPool.h"
+#include "memory/VeloxColumnarBatch.h"
+#include "memory/VeloxMemoryManager.h"
+#include "shuffle/LocalPartitionWriter.h"
+#include "shuffle/VeloxShuffleWriter.h"
+#include "utils/Exception.h"
+#include "velox/core/QueryCtx.h"
+#include "velox/expression/Expr.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+// Compares the two ways of hash partitioning the output of a high-cardinality partial aggregation, where every input
+// row is a distinct group:
+// - projected: a project evaluates hash(keys) into an extra first column, which the shuffle writer reads and strips.
+// - fused: the shuffle writer computes the hash from the key columns itself.
+
+DEFINE_int64(rows, 4L << 20, "Number of distinct groups, i.e. rows written to the shuffle per iteration.");
+DEFINE_int32(partitions, 200, "Number of shuffle partitions.");
+
+using namespace facebook::velox;
+using namespace gluten;
+
+namespace {
+
+std::vector<RowVectorPtr> makeInput(memory::MemoryPool* pool) {
+  test::VectorMaker maker(pool);
+  std::vector<RowVectorPtr> batches;
+  for (int64_t offset = 0; offset < FLAGS_rows; offset += FLAGS_batch_size) {
+    auto size = std::min<int64_t>(FLAGS_batch_size, FLAGS_rows - offset);
+    // Group keys (bigint, string) followed by the intermediate results of count and sum.
+    batches.push_back(maker.rowVector({
+        maker.flatVector<int64_t>(size, [&](auto row) { return (offset + row) * 7919; }),
+        maker.flatVector<std::string>(size, [&](auto row) { return "customer#" + std::to_string(offset + row); }),
+        maker.flatVector<int64_t>(size, [](auto row) { return row % 13; }),
+        maker.flatVector<double>(size, [](auto row) { return row * 0.25; }),
+    }));
+  }
+  return batches;
+}
+
+std::unique_ptr<exec::ExprSet> makeHashExpr(const RowTypePtr& rowType, core::ExecCtx* execCtx) {
+  std::vector<core::TypedExprPtr> keys = {
+      std::make_shared<core::FieldAccessTypedExpr>(rowType->childAt(0), rowType->nameOf(0)),
+      std::make_shared<core::FieldAccessTypedExpr>(rowType->childAt(1), rowType->nameOf(1))};
+  auto hash = std::make_shared<core::CallTypedExpr>(INTEGER(), std::move(keys), "hash");
+  return std::make_unique<exec::ExprSet>(std::vector<core::TypedExprPtr>{hash}, execCtx);
+}
+
+// Prepends the evaluated hash(keys) as the first column, as the JVM side's ProjectExecTransformer does.
+RowVectorPtr project(exec::ExprSet& exprSet, core::ExecCtx* execCtx, const RowVectorPtr& input) {
+  exec::EvalCtx evalCtx(execCtx, &exprSet, input.get());
+  SelectivityVector rows(input->size());
+  std::vector<VectorPtr> result(1);
+  exprSet.eval(rows, evalCtx, result);
+
+  auto names = input->type()->asRow().names();
+  auto types = input->type()->asRow().children();
+  auto children = input->children();
+  names.insert(names.begin(), "hash_partition_key");
+  types.insert(types.begin(), INTEGER());
+  children.insert(children.begin(), result[0]);
+  return std::make_shared<RowVector>(
+      input->pool(), ROW(std::move(names), std::move(types)), nullptr, input->size(), std::move(children));
+}
+
+void BM_HashPartitioning(benchmark::State& state) {
+  const bool fused = state.range(0);
+  const auto writerType = static_cast<ShuffleWriterType>(state.range(1));
+
+  auto pool = defaultLeafVeloxMemoryPool();
+  auto input = makeInput(pool.get());
+  auto queryCtx = core::QueryCtx::create();
+  core::ExecCtx execCtx(pool.get(), queryCtx.get());
+  auto exprSet = makeHashExpr(asRowType(input[0]->type()), &execCtx);
+
+  auto localDir = std::filesystem::temp_directory_path() / "gluten-hash-partitioning-benchmark";
+  std::filesystem::create_directories(localDir);
+  const std::vector<std::string> localDirs{localDir.string()};
+
+  int64_t bytesWritten = 0;
+  for (auto _ : state) {
+    GLUTEN_ASSIGN_OR_THROW(auto dataFile, createTempShuffleFile(localDir.string()));
+    auto partitionWriter = std::make_unique<LocalPartitionWriter>(
+        FLAGS_partitions, PartitionWriterOptions{}, defaultArrowMemoryPool().get(), dataFile, localDirs);
+    ShuffleWriterOptions options;
+    options.partitioning = Partitioning::kHash;
+    options.shuffleWriterType = writerType;
+    if (fused) {
+      options.hashPartitionKeys = {0, 1};
+    }
+    GLUTEN_ASSIGN_OR_THROW(
+        auto shuffleWriter,
+        VeloxShuffleWriter::create(
+            writerType,
+            FLAGS_partitions,
+            std::move(partitionWriter),
+            std::move(options),
+            pool,
+            defaultArrowMemoryPool().get()));
+
+    for (const auto& batch : input) {
+      auto rv = fused ? batch : project(*exprSet, &execCtx, batch);
+      GLUTEN_THROW_NOT_OK(shuffleWriter->write(std::make_shared<VeloxColumnarBatch>(rv), ShuffleWriter::kMaxMemLimit));
+    }
+    GLUTEN_THROW_NOT_OK(shuffleWriter->stop());
+    bytesWritten += shuffleWriter->totalBytesWritten();
+    std::filesystem::remove(dataFile);
+  }
+  std::filesystem::remove_all(localDir);
+
+  state.SetItemsProcessed(state.iterations() * FLAGS_rows);
+  state.counters["bytes_written"] =
+      benchmark::Counter(bytesWritten, benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+}
+
+} // namespace
+
+BENCHMARK(BM_HashPartitioning)
+    ->ArgNames({"fused", "writer"})
+    ->ArgsProduct({{0, 1}, {kHashShuffle, kSortShuffle}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  initVeloxBackend();
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
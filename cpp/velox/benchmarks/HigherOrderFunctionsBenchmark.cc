@@ -0,0 +1,183 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+
+#include "benchmarks/common/BenchmarkUtils.h"
+#include "memory/VeloxMemoryManager.h"
+#include "operators/functions/HigherOrderFunctions.h"
+#include "velox/core/QueryCtx.h"
+#include "velox/expression/Expr.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+// Evaluates higher-order functions with simple lambdas by evaluating the lambda vs. with the fast path kernels, over
+// arrays and maps of varied lengths:
+// - filter(a, x -> x > 500), exists(a, x -> x = -1), transform(a, x -> x * 3) and aggregate(a, 0, (acc, x) -> acc + x)
+//   over array(bigint).
+// - transform(a, x -> x.price) and filter(a, x -> x.id > 500) over array(struct(id bigint, price double)).
+// - map_filter(m, (k, v) -> v > 500) and transform_values(m, (k, v) -> v + 1) over map(bigint, bigint).
+
+DEFINE_int64(elements, 1L << 20, "Number of array elements or map entries per batch.");
+
+using namespace facebook::velox;
+
+namespace {
+
+enum Case { kFilter, kExists, kTransform, kAggregate, kFieldProjection, kFieldFilter, kMapFilter, kTransformValues };
+
+const std::vector<std::string> kCaseNames = {
+    "filter",
+    "exists",
+    "transform",
+    "aggregate",
+    "field_projection",
+    "field_filter",
+    "map_filter",
+    "transform_values"};
+
+core::TypedExprPtr field(const std::string& name, const TypePtr& type) {
+  return std::make_shared<core::FieldAccessTypedExpr>(type, name);
+}
+
+core::TypedExprPtr call(const std::string& name, const TypePtr& type, const std::vector<core::TypedExprPtr>& inputs) {
+  return std::make_shared<core::CallTypedExpr>(type, inputs, name);
+}
+
+core::TypedExprPtr bigint(int64_t value) {
+  return std::make_shared<core::ConstantTypedExpr>(BIGINT(), variant(value));
+}
+
+core::TypedExprPtr lambda(const RowTypePtr& arguments, const core::TypedExprPtr& body) {
+  return std::make_shared<core::LambdaTypedExpr>(arguments, body);
+}
+
+core::TypedExprPtr makeExpr(Case benchmarkCase, const TypePtr& inputType) {
+  auto c0 = field("c0", inputType);
+  auto x = field("x", BIGINT());
+  auto xArgument = ROW({"x"}, {BIGINT()});
+  switch (benchmarkCase) {
+    case kFilter:
+      return call("filter", inputType, {c0, lambda(xArgument, call("greaterthan", BOOLEAN(), {x, bigint(500)}))});
+    case kExists:
+      return call("exists", BOOLEAN(), {c0, lambda(xArgument, call("equalto", BOOLEAN(), {x, bigint(-1)}))});
+    case kTransform:
+      return call("transform", inputType, {c0, lambda(xArgument, call("multiply", BIGINT(), {x, bigint(3)}))});
+    case kAggregate: {
+      auto arguments = ROW({"acc", "x"}, {BIGINT(), BIGINT()});
+      auto add = call("add", BIGINT(), {field("acc", BIGINT()), x});
+      return call("aggregate", BIGINT(), {c0, bigint(0), lambda(arguments, add)});
+    }
+    case kFieldProjection: {
+      const auto& structType = inputType->childAt(0);
+      auto price = std::make_shared<core::DereferenceTypedExpr>(DOUBLE(), field("x", structType), 1);
+      return call("transform", ARRAY(DOUBLE()), {c0, lambda(ROW({"x"}, {structType}), price)});
+    }
+    case kFieldFilter: {
+      const auto& structType = inputType->childAt(0);
+      auto id = std::make_shared<core::DereferenceTypedExpr>(BIGINT(), field("x", structType), 0);
+      auto body = call("greaterthan", BOOLEAN(), {id, bigint(500)});
+      return call("filter", inputType, {c0, lambda(ROW({"x"}, {structType}), body)});
+    }
+    case kMapFilter: {
+      auto arguments = ROW({"k", "v"}, {BIGINT(), BIGINT()});
+      return call(
+          "map_filter",
+          inputType,
+          {c0, lambda(arguments, call("greaterthan", BOOLEAN(), {field("v", BIGINT()), bigint(500)}))});
+    }
+    case kTransformValues: {
+      auto arguments = ROW({"k", "v"}, {BIGINT(), BIGINT()});
+      return call(
+          "transform_values",
+          inputType,
+          {c0, lambda(arguments, call("add", BIGINT(), {field("v", BIGINT()), bigint(1)}))});
+    }
+  }
+  VELOX_UNREACHABLE();
+}
+
+RowVectorPtr makeInput(Case benchmarkCase, vector_size_t length, memory::MemoryPool* pool) {
+  test::VectorMaker maker(pool);
+  auto numElements = static_cast<vector_size_t>(FLAGS_elements);
+  auto numRows = numElements / length;
+  auto values = maker.flatVector<int64_t>(numElements, [](auto i) { return (i * 7919) % 1000; });
+  std::vector<vector_size_t> offsets(numRows);
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    offsets[row] = row * length;
+  }
+  switch (benchmarkCase) {
+    case kFieldProjection:
+    case kFieldFilter: {
+      auto prices = maker.flatVector<double>(numElements, [](auto i) { return i * 0.25; });
+      return maker.rowVector({maker.arrayVector(offsets, maker.rowVector({"id", "price"}, {values, prices}))});
+    }
+    case kMapFilter:
+    case kTransformValues: {
+      auto keys = maker.flatVector<int64_t>(numElements, [&](auto i) { return i % length; });
+      return maker.rowVector({maker.mapVector(offsets, keys, values)});
+    }
+    default:
+      return maker.rowVector({maker.arrayVector(offsets, values)});
+  }
+}
+
+void BM_HigherOrderFunction(benchmark::State& state) {
+  auto benchmarkCase = static_cast<Case>(state.range(0));
+  auto length = static_cast<vector_size_t>(state.range(1));
+  const bool fastPath = state.range(2);
+
+  auto pool = defaultLeafVeloxMemoryPool();
+  auto input = makeInput(benchmarkCase, length, pool.get());
+  auto expr = makeExpr(benchmarkCase, input->childAt(0)->type());
+  if (fastPath) {
+    auto higherOrderCall = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+    expr = gluten::rewriteHigherOrderCall(higherOrderCall->name(), higherOrderCall->inputs(), expr->type());
+    VELOX_CHECK_NOT_NULL(expr);
+  }
+
+  auto queryCtx = core::QueryCtx::create();
+  core::ExecCtx execCtx(pool.get(), queryCtx.get());
+  exec::ExprSet exprSet({expr}, &execCtx);
+  SelectivityVector rows(input->size());
+  for (auto _ : state) {
+    exec::EvalCtx evalCtx(&execCtx, &exprSet, input.get());
+    std::vector<VectorPtr> result(1);
+    exprSet.eval(rows, evalCtx, result);
+    benchmark::DoNotOptimize(result[0]);
+  }
+  state.SetLabel(kCaseNames[benchmarkCase]);
+  state.SetItemsProcessed(state.iterations() * input->size() * length);
+}
+
+} // namespace
+
+BENCHMARK(BM_HigherOrderFunction)
+    ->ArgNames({"case", "length", "fast_path"})
+    ->ArgsProduct({benchmark::CreateDenseRange(kFilter, kTransformValues, 1), {1, 4, 16, 64, 512}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  initVeloxBackend();
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
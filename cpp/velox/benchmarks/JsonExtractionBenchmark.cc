@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <gflags/gflags.h>
+
+#include "benchmarks/common/BenchmarkUtils.h"
+#include "memory/VeloxMemoryManager.h"
+#include "operators/functions/JsonExtraction.h"
+#include "velox/core/QueryCtx.h"
+#include "velox/expression/Expr.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+// Extracts 1 to 8 fields of a column of JSON log records, by a get_json_object call per field vs. by the shared
+// extraction. The records have a few top-level fields, a nested request and a payload of `payload_fields` fields that
+// no path goes through, which is the part the on-demand parser skips.
+
+DEFINE_int32(rows, 1 << 14, "Number of JSON records per batch.");
+DEFINE_int32(payload_fields, 32, "Number of fields in the payload of each record.");
+
+using namespace facebook::velox;
+
+namespace {
+
+const std::vector<std::string> kPaths = {
+    "$.level",
+    "$.request.method",
+    "$.request.status",
+    "$.user.id",
+    "$.latency_ms",
+    "$.request.headers[0]",
+    "$.user.region",
+    "$.message"};
+
+std::string makeRecord(int32_t row) {
+  std::string payload;
+  for (int32_t i = 0; i < FLAGS_payload_fields; ++i) {
+    payload += fmt::format(
+        R"({}"field_{}": {{"value": {}, "label": "label-{}-{}"}})", i ? ", " : "", i, row * i, row, i);
+  }
+  return fmt::format(
+      R"({{"timestamp": "2024-01-01T00:00:{:02}Z", "payload": {{{}}}, "level": "{}", )"
+      R"("request": {{"method": "GET", "path": "/api/v1/items/{}", "status": {}, "headers": ["gzip", "json"]}}, )"
+      R"("user": {{"id": {}, "region": "region-{}"}}, "latency_ms": {}, "message": "request {} served"}})",
+      row % 60,
+      payload,
+      row % 10 ? "INFO" : "WARN",
+      row,
+      row % 7 ? 200 : 500,
+      row * 31,
+      row % 16,
+      (row * 13) % 1000 * 0.5,
+      row);
+}
+
+void BM_JsonExtraction(benchmark::State& state) {
+  auto numPaths = static_cast<size_t>(state.range(0));
+  const bool shared = state.range(1);
+
+  auto pool = defaultLeafVeloxMemoryPool();
+  test::VectorMaker maker(pool.get());
+  std::vector<std::string> records;
+  for (int32_t row = 0; row < FLAGS_rows; ++row) {
+    records.push_back(makeRecord(row));
+  }
+  auto input = maker.rowVector({maker.flatVector(records)});
+
+  auto c0 = std::make_shared<core::FieldAccessTypedExpr>(VARCHAR(), "c0");
+  std::vector<core::TypedExprPtr> exprs;
+  for (size_t i = 0; i < numPaths; ++i) {
+    auto path = std::make_shared<core::ConstantTypedExpr>(VARCHAR(), variant(kPaths[i]));
+    exprs.push_back(std::make_shared<core::CallTypedExpr>(
+        VARCHAR(), std::vector<core::TypedExprPtr>{c0, path}, "get_json_object"));
+  }
+  if (shared) {
+    exprs = gluten::rewriteJsonExtractions(exprs);
+  }
+
+  auto queryCtx = core::QueryCtx::create();
+  core::ExecCtx execCtx(pool.get(), queryCtx.get());
+  exec::ExprSet exprSet(exprs, &execCtx);
+  SelectivityVector rows(input->size());
+  int64_t bytes = 0;
+  for (vector_size_t row = 0; row < input->size(); ++row) {
+    bytes += input->childAt(0)->asFlatVector<StringView>()->valueAt(row).size();
+  }
+  for (auto _ : state) {
+    exec::EvalCtx evalCtx(&execCtx, &exprSet, input.get());
+    std::vector<VectorPtr> results(exprs.size());
+    exprSet.eval(rows, evalCtx, results);
+    benchmark::DoNotOptimize(results);
+  }
+  state.SetItemsProcessed(state.iterations() * input->size());
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+} // namespace
+
+BENCHMARK(BM_JsonExtraction)
+    ->ArgNames({"paths", "shared"})
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  initVeloxBackend();
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
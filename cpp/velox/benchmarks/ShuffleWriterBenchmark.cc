@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+
+#include "benchmarks/common/BenchmarkUtils.h"
+#include "memory/ArrowMemoryPool.h"
+#include "memory/VeloxColumnarBatch.h"
+#include "memory/VeloxMemoryManager.h"
+#include "shuffle/LocalPartitionWriter.h"
+#include "shuffle/VeloxShuffleWriter.h"
+#include "utils/Exception.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+// Compares the hash, sort and adaptive shuffle writers over the number of partitions and the row width. The adaptive
+// shuffle writer should track the faster of the other two.
+
+DEFINE_int64(rows, 1L << 20, "Number of rows written to the shuffle per iteration.");
+DEFINE_int64(mem_limit, gluten::ShuffleWriter::kMinMemLimit, "Memory limit passed to the shuffle writer.");
+
+using namespace facebook::velox;
+using namespace gluten;
+
+namespace {
+
+// The first column is the partition key. The others alternate between bigint and short strings.
+std::vector<RowVectorPtr> makeInput(memory::MemoryPool* pool, int32_t numColumns) {
+  test::VectorMaker maker(pool);
+  std::vector<RowVectorPtr> batches;
+  for (int64_t offset = 0; offset < FLAGS_rows; offset += FLAGS_batch_size) {
+    auto size = std::min<int64_t>(FLAGS_batch_size, FLAGS_rows - offset);
+    std::vector<VectorPtr> children;
+    children.push_back(maker.flatVector<int64_t>(size, [&](auto row) { return (offset + row) * 7919; }));
+    for (auto i = 1; i < numColumns; ++i) {
+      if (i % 2) {
+        children.push_back(maker.flatVector<int64_t>(size, [&](auto row) { return (offset + row) ^ i; }));
+      } else {
+        children.push_back(
+            maker.flatVector<std::string>(size, [&](auto row) { return "value#" + std::to_string(row % 1000); }));
+      }
+    }
+    batches.push_back(maker.rowVector(children));
+  }
+  return batches;
+}
+
+void BM_ShuffleWriter(benchmark::State& state) {
+  const auto numPartitions = static_cast<uint32_t>(state.range(0));
+  const auto numColumns = static_cast<int32_t>(state.range(1));
+  const auto writerType = static_cast<ShuffleWriterType>(state.range(2));
+
+  auto pool = defaultLeafVeloxMemoryPool();
+  auto input = makeInput(pool.get(), numColumns);
+
+  auto localDir = std::filesystem::temp_directory_path() / "gluten-shuffle-writer-benchmark";
+  std::filesystem::create_directories(localDir);
+  const std::vector<std::string> localDirs{localDir.string()};
+
+  int64_t bytesWritten = 0;
+  int64_t bytesSpilled = 0;
+  int64_t sortChosen = 0;
+  for (auto _ : state) {
+    GLUTEN_ASSIGN_OR_THROW(auto dataFile, createTempShuffleFile(localDir.string()));
+    auto partitionWriter = std::make_unique<LocalPartitionWriter>(
+        numPartitions, PartitionWriterOptions{}, defaultArrowMemoryPool().get(), dataFile, localDirs);
+    ShuffleWriterOptions options;
+    options.partitioning = Partitioning::kHash;
+    options.shuffleWriterType = writerType;
+    options.hashPartitionKeys = {0};
+    GLUTEN_ASSIGN_OR_THROW(
+        auto shuffleWriter,
+        VeloxShuffleWriter::create(
+            writerType,
+            numPartitions,
+            std::move(partitionWriter),
+            std::move(options),
+            pool,
+            defaultArrowMemoryPool().get()));
+
+    for (const auto& batch : input) {
+      GLUTEN_THROW_NOT_OK(shuffleWriter->write(std::make_shared<VeloxColumnarBatch>(batch), FLAGS_mem_limit));
+    }
+    GLUTEN_THROW_NOT_OK(shuffleWriter->stop());
+    bytesWritten += shuffleWriter->totalBytesWritten();
+    bytesSpilled += shuffleWriter->totalBytesEvicted();
+    const auto& decision = shuffleWriter->metrics().adaptiveDecision;
+    sortChosen += decision.has_value() && decision->writerType == kSortShuffle;
+    std::filesystem::remove(dataFile);
+  }
+  std::filesystem::remove_all(localDir);
+
+  state.SetItemsProcessed(state.iterations() * FLAGS_rows);
+  state.counters["bytes_written"] =
+      benchmark::Counter(bytesWritten, benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+  state.counters["bytes_spilled"] =
+      benchmark::Counter(bytesSpilled, benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+  state.counters["sort_chosen"] = benchmark::Counter(sortChosen, benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+BENCHMARK(BM_ShuffleWriter)
+    ->ArgNames({"partitions", "columns", "writer"})
+    ->ArgsProduct({{8, 200, 2000, 10000}, {4, 32}, {kHashShuffle, kSortShuffle, kAdaptiveShuffle}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  initVeloxBackend();
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
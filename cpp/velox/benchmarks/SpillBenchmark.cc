@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filesystem>
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+
+#include "utils/TieredSpillFileSystem.h"
+#include "velox/common/file/FileSystems.h"
+
+// Replays the file access patterns of Velox spilling against the local and the tiered spill file systems:
+// - Sort: the operator spills sorted runs one after another, then merges all runs by reading them in small chunks
+//   round-robin.
+// - Hash aggregation: the operator spills every partition (2^spillPartitionBits of them) on each spill, then restores
+//   the partitions one by one.
+
+DEFINE_uint64(spill_memory_tier_capacity, 1L << 30, "Capacity of the memory tier of the tiered spill file system.");
+DEFINE_uint64(spill_bytes, 512L << 20, "Total bytes spilled per iteration.");
+DEFINE_string(spill_dir, "", "Local directory for spill files. Uses the system temp directory if empty.");
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr uint64_t kAppendSize = 64L << 10;
+constexpr uint64_t kReadSize = 1L << 20;
+constexpr uint32_t kSortRuns = 16;
+constexpr uint32_t kAggPartitions = 8;
+constexpr uint32_t kAggSpills = 4;
+
+std::string spillDir(bool tiered) {
+  auto base = FLAGS_spill_dir.empty() ? std::filesystem::temp_directory_path().string() : FLAGS_spill_dir;
+  std::mt19937_64 rng(std::random_device{}());
+  auto dir = base + "/gluten-spill-benchmark-" + std::to_string(rng());
+  return tiered ? "tiered:" + dir : dir;
+}
+
+const std::string& appendData() {
+  static const std::string data = [] {
+    std::string out(kAppendSize, 0);
+    std::mt19937 rng(42);
+    for (auto& c : out) {
+      c = static_cast<char>(rng());
+    }
+    return out;
+  }();
+  return data;
+}
+
+void writeRun(filesystems::FileSystem& fs, const std::string& path, uint64_t bytes) {
+  auto file = fs.openFileForWrite(path);
+  for (uint64_t written = 0; written < bytes; written += kAppendSize) {
+    file->append(appendData());
+  }
+  file->close();
+}
+
+void setCounters(benchmark::State& state, const gluten::TieredSpillStats& before) {
+  auto after = gluten::tieredSpillStats();
+  state.counters["memory_written"] = benchmark::Counter(
+      after.memoryBytesWritten - before.memoryBytesWritten, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+  state.counters["disk_written"] = benchmark::Counter(
+      after.diskBytesWritten - before.diskBytesWritten, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+  state.counters["demoted"] = benchmark::Counter(
+      after.bytesDemoted - before.bytesDemoted, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+
+void BM_SortSpill(benchmark::State& state) {
+  auto dir = spillDir(state.range(0));
+  auto fs = filesystems::getFileSystem(dir, nullptr);
+  auto runBytes = FLAGS_spill_bytes / kSortRuns;
+  auto before = gluten::tieredSpillStats();
+  std::string buffer(kReadSize, 0);
+  for (auto _ : state) {
+    fs->mkdir(dir);
+    for (uint32_t run = 0; run < kSortRuns; ++run) {
+      writeRun(*fs, dir + "/run-" + std::to_string(run), runBytes);
+    }
+    std::vector<std::unique_ptr<ReadFile>> files;
+    for (uint32_t run = 0; run < kSortRuns; ++run) {
+      files.push_back(fs->openFileForRead(dir + "/run-" + std::to_string(run)));
+    }
+    for (uint64_t offset = 0; offset < files[0]->size(); offset += kReadSize) {
+      for (auto& file : files) {
+        auto length = std::min(kReadSize, file->size() - offset);
+        benchmark::DoNotOptimize(file->pread(offset, length, buffer.data()));
+      }
+    }
+    files.clear();
+    fs->rmdir(dir);
+  }
+  state.SetBytesProcessed(state.iterations() * runBytes * kSortRuns * 2);
+  setCounters(state, before);
+}
+
+void BM_HashAggregationSpill(benchmark::State& state) {
+  auto dir = spillDir(state.range(0));
+  auto fs = filesystems::getFileSystem(dir, nullptr);
+  auto fileBytes = FLAGS_spill_bytes / (kAggPartitions * kAggSpills);
+  auto before = gluten::tieredSpillStats();
+  std::string buffer(kReadSize, 0);
+  for (auto _ : state) {
+    fs->mkdir(dir);
+    for (uint32_t spill = 0; spill < kAggSpills; ++spill) {
+      for (uint32_t partition = 0; partition < kAggPartitions; ++partition) {
+        writeRun(*fs, dir + "/p" + std::to_string(partition) + "-" + std::to_string(spill), fileBytes);
+      }
+    }
+    for (uint32_t partition = 0; partition < kAggPartitions; ++partition) {
+      for (uint32_t spill = 0; spill < kAggSpills; ++spill) {
+        auto path = dir + "/p" + std::to_string(partition) + "-" + std::to_string(spill);
+        auto file = fs->openFileForRead(path);
+        for (uint64_t offset = 0; offset < file->size(); offset += kReadSize) {
+          auto length = std::min(kReadSize, file->size() - offset);
+          benchmark::DoNotOptimize(file->pread(offset, length, buffer.data()));
+        }
+        file.reset();
+        fs->remove(path);
+      }
+    }
+    fs->rmdir(dir);
+  }
+  state.SetBytesProcessed(state.iterations() * fileBytes * kAggPartitions * kAggSpills * 2);
+  setCounters(state, before);
+}
+
+} // namespace
+
+BENCHMARK(BM_SortSpill)->ArgName("tiered")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_HashAggregationSpill)->ArgName("tiered")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  filesystems::registerLocalFileSystem();
+  gluten::registerTieredSpillFileSystem(FLAGS_spill_memory_tier_capacity);
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
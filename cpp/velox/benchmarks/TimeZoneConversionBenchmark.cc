@@ -0,0 +1,95 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+
+#include "operators/functions/TimeZoneConversion.h"
+
+// Converts a column of UTC timestamps to local time, as from_utc_timestamp does, by looking up the time zone for every
+// value vs. with an offset table precomputed for the column's range. Covers UTC, a fixed offset, zones with and
+// without daylight saving time, and one with a half-hour daylight saving shift.
+
+DEFINE_int64(values, 1L << 20, "Number of timestamps per iteration.");
+DEFINE_int32(range_days, 365, "Range of the timestamps in days, starting from 2024-01-01.");
+
+using namespace facebook::velox;
+
+namespace {
+
+const std::vector<std::string> kZones = {
+    "UTC",
+    "+08:00",
+    "Asia/Kolkata",
+    "America/Los_Angeles",
+    "Europe/Berlin",
+    "Australia/Lord_Howe"};
+
+std::vector<int64_t> makeInput() {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int64_t> dist(1704067200, 1704067200 + FLAGS_range_days * 86'400L);
+  std::vector<int64_t> seconds(FLAGS_values);
+  for (auto& value : seconds) {
+    value = dist(rng);
+  }
+  return seconds;
+}
+
+void BM_PerValue(benchmark::State& state) {
+  const auto* zone = tz::locateZone(kZones[state.range(0)]);
+  auto input = makeInput();
+  std::vector<int64_t> output(input.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < input.size(); ++i) {
+      output[i] = zone->to_local(std::chrono::seconds(input[i])).count();
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetLabel(kZones[state.range(0)]);
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void BM_OffsetTable(benchmark::State& state) {
+  const auto* zone = tz::locateZone(kZones[state.range(0)]);
+  auto input = makeInput();
+  std::vector<int64_t> output(input.size());
+  for (auto _ : state) {
+    // Building the table is part of converting a batch.
+    auto [min, max] = std::minmax_element(input.begin(), input.end());
+    auto table = gluten::TimeZoneOffsetTable::make(*zone, *min, *max);
+    table->fromUtc(input.data(), output.data(), input.size());
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetLabel(kZones[state.range(0)]);
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_PerValue)->DenseRange(0, kZones.size() - 1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OffsetTable)->DenseRange(0, kZones.size() - 1)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
@@ -154,6 +154,7 @@ void BenchmarkAllocationListener::allocationChanged(int64_t diff) {
     LOG(INFO) << fmt::format("spill finish, got {}.", facebook::velox::succinctBytes(spilledBytes));
   } else {
     usedBytes_ += diff;
+    peakBytes_ = std::max(peakBytes_, usedBytes_);
   }
 }
 } // namespace gluten
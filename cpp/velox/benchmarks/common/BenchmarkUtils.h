@@ -111,8 +111,17 @@ class BenchmarkAllocationListener final : public gluten::AllocationListener {
 
   void allocationChanged(int64_t diff) override;
 
+  int64_t currentBytes() override {
+    return usedBytes_;
+  }
+
+  int64_t peakBytes() override {
+    return peakBytes_;
+  }
+
  private:
   uint64_t usedBytes_{0L};
+  uint64_t peakBytes_{0L};
   const uint64_t limit_{0L};
   gluten::ResultIterator* iterator_{nullptr};
   gluten::ShuffleWriter* shuffleWriter_{nullptr};
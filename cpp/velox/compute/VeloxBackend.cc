@@ -36,6 +36,8 @@
 #include "operators/functions/SparkExprToSubfieldFilterParser.h"
 #include "udf/UdfLoader.h"
 #include "utils/Exception.h"
+#include "utils/HedgedReadFile.h"
+#include "utils/TieredSpillFileSystem.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnector.h"
@@ -135,6 +137,9 @@ void VeloxBackend::init(const std::unordered_map<std::string, std::string>& conf
   // Setup and register.
   velox::filesystems::registerLocalFileSystem();
 
+  // Registered ahead of the remote file systems it wraps.
+  initHedgedReads();
+
 #ifdef ENABLE_HDFS
   velox::filesystems::registerHdfsFileSystem();
 #endif
@@ -149,6 +154,7 @@ void VeloxBackend::init(const std::unordered_map<std::string, std::string>& conf
 #endif
 
   initJolFilesystem();
+  initTieredSpillFilesystem();
   initCache();
   initConnector();
 
@@ -201,6 +207,26 @@ void VeloxBackend::initJolFilesystem() {
   registerJolFileSystem(maxSpillFileSize);
 }
 
+// Memory-over-local filesystem, for keeping spill runs in memory outside of the Spark task memory budget
+void VeloxBackend::initTieredSpillFilesystem() {
+  registerTieredSpillFileSystem(
+      backendConf_->get<uint64_t>(kSpillMemoryTierCapacity, kSpillMemoryTierCapacityDefault));
+}
+
+// Duplicate requests for slow reads of HDFS and object storages
+void VeloxBackend::initHedgedReads() {
+  if (!backendConf_->get<bool>(kHedgedReadEnabled, false)) {
+    return;
+  }
+  HedgedReadOptions options;
+  options.percentile = backendConf_->get<double>(kHedgedReadPercentile, kHedgedReadPercentileDefault);
+  options.minDelayMs = backendConf_->get<uint64_t>(kHedgedReadMinDelayMs, kHedgedReadMinDelayMsDefault);
+  options.budgetRatio = backendConf_->get<double>(kHedgedReadBudgetRatio, kHedgedReadBudgetRatioDefault);
+  hedgedReadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+      backendConf_->get<uint32_t>(kHedgedReadThreads, kHedgedReadThreadsDefault));
+  registerHedgedReadFileSystem(options, hedgedReadExecutor_.get());
+}
+
 void VeloxBackend::initCache() {
   if (backendConf_->get<bool>(kVeloxCacheEnabled, false)) {
     FLAGS_ssd_odirect = true;
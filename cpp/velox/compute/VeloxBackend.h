@@ -64,6 +64,7 @@ class VeloxBackend {
     // On threads exit, thread local variables can be constructed with referencing global variables.
     // So, we need to destruct IOThreadPoolExecutor and stop the threads before global variables get destructed.
     ioExecutor_.reset();
+    hedgedReadExecutor_.reset();
   }
 
  private:
@@ -77,6 +78,8 @@ class VeloxBackend {
   void initUdf();
 
   void initJolFilesystem();
+  void initTieredSpillFilesystem();
+  void initHedgedReads();
 
   std::string getCacheFilePrefix() {
     return "cache." + boost::lexical_cast<std::string>(boost::uuids::random_generator()()) + ".";
@@ -89,6 +92,7 @@ class VeloxBackend {
 
   std::unique_ptr<folly::IOThreadPoolExecutor> ssdCacheExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> hedgedReadExecutor_;
   std::shared_ptr<facebook::velox::memory::MmapAllocator> cacheAllocator_;
 
   std::string cachePathPrefix_;
@@ -66,6 +66,11 @@ class VeloxRuntime final : public Runtime {
     return iter->getMetrics(exportNanos);
   }
 
+  MetricsSnapshot* getMetricsSnapshot(ColumnarBatchIterator* rawIter) override {
+    auto iter = static_cast<WholeStageResultIterator*>(rawIter);
+    return iter->getMetricsSnapshot();
+  }
+
   std::shared_ptr<ShuffleReader> createShuffleReader(
       std::shared_ptr<arrow::Schema> schema,
       ShuffleReaderOptions options) override;
@@ -15,9 +15,16 @@
  * limitations under the License.
  */
 #include "WholeStageResultIterator.h"
+
+#include <condition_variable>
+#include <thread>
+#include <unordered_set>
+
 #include "VeloxBackend.h"
 #include "VeloxRuntime.h"
 #include "config/VeloxConfig.h"
+#include "utils/TieredSpillFileSystem.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -51,6 +58,74 @@ const std::string kWriteIOTime = "writeIOTime";
 // others
 const std::string kHiveDefaultPartition = "__HIVE_DEFAULT_PARTITION__";
 
+// Publishes the live metrics of the registered iterators from a background thread, so they stay fresh while a task
+// thread is blocked in Task::next(), e.g. when an aggregation consumes all its input before producing any output.
+// Task::taskStats() is safe to call concurrently with the task's execution.
+class MetricsPublisher {
+ public:
+  static MetricsPublisher& instance() {
+    static MetricsPublisher publisher;
+    return publisher;
+  }
+
+  void add(WholeStageResultIterator* iter) {
+    std::lock_guard<std::mutex> l(mutex_);
+    iters_.insert(iter);
+    if (!thread_.joinable()) {
+      thread_ = std::thread([this] { run(); });
+    }
+  }
+
+  // Once this returns, the iterator is not accessed anymore.
+  void remove(WholeStageResultIterator* iter) {
+    std::unique_lock<std::mutex> l(mutex_);
+    iters_.erase(iter);
+    cv_.wait(l, [&] { return publishing_ != iter; });
+  }
+
+ private:
+  static constexpr auto kTick = std::chrono::milliseconds(100);
+
+  ~MetricsPublisher() {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // Collecting the stats of a task can take a while, so the mutex is only held to copy the registry and to mark the
+  // iterator being published, which keeps add() and remove() of other iterators from waiting for it.
+  void run() {
+    std::unique_lock<std::mutex> l(mutex_);
+    while (!stopped_) {
+      cv_.wait_for(l, kTick);
+      std::vector<WholeStageResultIterator*> iters(iters_.begin(), iters_.end());
+      for (auto* iter : iters) {
+        if (stopped_ || iters_.count(iter) == 0) {
+          continue;
+        }
+        publishing_ = iter;
+        l.unlock();
+        iter->tryPublishMetrics();
+        l.lock();
+        publishing_ = nullptr;
+        cv_.notify_all();
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::unordered_set<WholeStageResultIterator*> iters_;
+  WholeStageResultIterator* publishing_{nullptr};
+  std::thread thread_;
+  bool stopped_{false};
+};
+
 } // namespace
 
 WholeStageResultIterator::WholeStageResultIterator(
@@ -70,6 +145,7 @@ WholeStageResultIterator::WholeStageResultIterator(
       scanNodeIds_(scanNodeIds),
       scanInfos_(scanInfos),
       streamIds_(streamIds) {
+  metricsPublishIntervalMs_ = veloxCfg_->get<int64_t>(kMetricsPublishIntervalMs, kMetricsPublishIntervalMsDefault);
   spillStrategy_ = veloxCfg_->get<std::string>(kSpillStrategy, kSpillStrategyDefaultValue);
   auto spillThreadNum = veloxCfg_->get<uint32_t>(kSpillThreadNum, kSpillThreadNumDefaultValue);
   if (spillThreadNum > 0) {
@@ -100,6 +176,7 @@ WholeStageResultIterator::WholeStageResultIterator(
   GLUTEN_CHECK(fileSystem != nullptr, "File System for spilling is null!");
   fileSystem->mkdir(spillDir);
   task_->setSpillDirectory(spillDir);
+  spillDir_ = spillDir;
 
   // Generate splits for all scan nodes.
   splits_.reserve(scanInfos.size());
@@ -173,6 +250,20 @@ WholeStageResultIterator::WholeStageResultIterator(
     }
     splits_.emplace_back(scanSplits);
   }
+
+  if (metricsPublishIntervalMs_ > 0) {
+    MetricsPublisher::instance().add(this);
+  }
+}
+
+WholeStageResultIterator::~WholeStageResultIterator() {
+  if (metricsPublishIntervalMs_ > 0) {
+    MetricsPublisher::instance().remove(this);
+  }
+  if (task_ != nullptr && task_->isRunning()) {
+    // calling .wait() may take no effect in single thread execution mode
+    task_->requestCancel().wait();
+  }
 }
 
 std::shared_ptr<velox::core::QueryCtx> WholeStageResultIterator::createNewVeloxQueryCtx() {
@@ -349,6 +440,55 @@ void WholeStageResultIterator::collectMetrics() {
     LOG(INFO) << oss.str();
   }
 
+  metrics_ = toMetrics(taskStats);
+  metrics_->spilledMemoryTierBytes = tieredSpillMemoryResidentBytes(spillDir_);
+  std::lock_guard<std::mutex> l(metricsPublishMutex_);
+  metricsFinalized_ = true;
+  if (metricsSnapshot_ != nullptr && metricsSnapshot_->numMetrics() == metrics_->numMetrics) {
+    metricsSnapshot_->publish(*metrics_);
+  }
+}
+
+void WholeStageResultIterator::tryPublishMetrics() {
+  auto nowMs = static_cast<int64_t>(velox::getCurrentTimeMs());
+  if (nowMs - lastMetricsPublishMs_ < metricsPublishIntervalMs_) {
+    return;
+  }
+  lastMetricsPublishMs_ = nowMs;
+  const auto taskStats = task_->taskStats();
+  if (taskStats.executionStartTimeMs == 0) {
+    return;
+  }
+  std::unique_ptr<Metrics> metrics;
+  try {
+    metrics = toMetrics(taskStats);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to publish metrics of " << taskInfo_ << ": " << e.what();
+    return;
+  }
+  std::lock_guard<std::mutex> l(metricsPublishMutex_);
+  if (metricsFinalized_) {
+    // Don't overwrite the final metrics.
+    return;
+  }
+  if (metricsSnapshot_ == nullptr) {
+    metricsSnapshot_ = std::make_unique<MetricsSnapshot>(metrics->numMetrics);
+  }
+  if (metricsSnapshot_->numMetrics() != metrics->numMetrics) {
+    // The buffer may be read by the JVM at any time, so it can't be reallocated.
+    VLOG(1) << "Skip publishing metrics since the number of metrics changed from " << metricsSnapshot_->numMetrics()
+            << " to " << metrics->numMetrics;
+    return;
+  }
+  metricsSnapshot_->publish(*metrics);
+}
+
+MetricsSnapshot* WholeStageResultIterator::getMetricsSnapshot() {
+  std::lock_guard<std::mutex> l(metricsPublishMutex_);
+  return metricsSnapshot_.get();
+}
+
+std::unique_ptr<Metrics> WholeStageResultIterator::toMetrics(const velox::exec::TaskStats& taskStats) {
   auto planStats = velox::exec::toPlanStats(taskStats);
   // Calculate the total number of metrics.
   int statsNum = 0;
@@ -368,7 +508,7 @@ void WholeStageResultIterator::collectMetrics() {
     statsNum += planStats.at(nodeId).operatorStats.size();
   }
 
-  metrics_ = std::make_unique<Metrics>(statsNum);
+  auto metrics = std::make_unique<Metrics>(statsNum);
 
   int metricIndex = 0;
   for (int idx = 0; idx < orderedNodeIds_.size(); idx++) {
@@ -376,13 +516,13 @@ void WholeStageResultIterator::collectMetrics() {
     if (planStats.find(nodeId) == planStats.end()) {
       // Special handing for Filter over Project case. Filter metrics are
       // omitted.
-      metrics_->get(Metrics::kOutputRows)[metricIndex] = 0;
-      metrics_->get(Metrics::kOutputVectors)[metricIndex] = 0;
-      metrics_->get(Metrics::kOutputBytes)[metricIndex] = 0;
-      metrics_->get(Metrics::kCpuCount)[metricIndex] = 0;
-      metrics_->get(Metrics::kWallNanos)[metricIndex] = 0;
-      metrics_->get(Metrics::kPeakMemoryBytes)[metricIndex] = 0;
-      metrics_->get(Metrics::kNumMemoryAllocations)[metricIndex] = 0;
+      metrics->get(Metrics::kOutputRows)[metricIndex] = 0;
+      metrics->get(Metrics::kOutputVectors)[metricIndex] = 0;
+      metrics->get(Metrics::kOutputBytes)[metricIndex] = 0;
+      metrics->get(Metrics::kCpuCount)[metricIndex] = 0;
+      metrics->get(Metrics::kWallNanos)[metricIndex] = 0;
+      metrics->get(Metrics::kPeakMemoryBytes)[metricIndex] = 0;
+      metrics->get(Metrics::kNumMemoryAllocations)[metricIndex] = 0;
       metricIndex += 1;
       continue;
     }
@@ -391,56 +531,57 @@ void WholeStageResultIterator::collectMetrics() {
     // Add each operator stats into metrics.
     for (const auto& entry : stats.operatorStats) {
       const auto& second = entry.second;
-      metrics_->get(Metrics::kInputRows)[metricIndex] = second->inputRows;
-      metrics_->get(Metrics::kInputVectors)[metricIndex] = second->inputVectors;
-      metrics_->get(Metrics::kInputBytes)[metricIndex] = second->inputBytes;
-      metrics_->get(Metrics::kRawInputRows)[metricIndex] = second->rawInputRows;
-      metrics_->get(Metrics::kRawInputBytes)[metricIndex] = second->rawInputBytes;
-      metrics_->get(Metrics::kOutputRows)[metricIndex] = second->outputRows;
-      metrics_->get(Metrics::kOutputVectors)[metricIndex] = second->outputVectors;
-      metrics_->get(Metrics::kOutputBytes)[metricIndex] = second->outputBytes;
-      metrics_->get(Metrics::kCpuCount)[metricIndex] = second->cpuWallTiming.count;
-      metrics_->get(Metrics::kWallNanos)[metricIndex] = second->cpuWallTiming.wallNanos;
-      metrics_->get(Metrics::kPeakMemoryBytes)[metricIndex] = second->peakMemoryBytes;
-      metrics_->get(Metrics::kNumMemoryAllocations)[metricIndex] = second->numMemoryAllocations;
-      metrics_->get(Metrics::kSpilledInputBytes)[metricIndex] = second->spilledInputBytes;
-      metrics_->get(Metrics::kSpilledBytes)[metricIndex] = second->spilledBytes;
-      metrics_->get(Metrics::kSpilledRows)[metricIndex] = second->spilledRows;
-      metrics_->get(Metrics::kSpilledPartitions)[metricIndex] = second->spilledPartitions;
-      metrics_->get(Metrics::kSpilledFiles)[metricIndex] = second->spilledFiles;
-      metrics_->get(Metrics::kNumDynamicFiltersProduced)[metricIndex] =
+      metrics->get(Metrics::kInputRows)[metricIndex] = second->inputRows;
+      metrics->get(Metrics::kInputVectors)[metricIndex] = second->inputVectors;
+      metrics->get(Metrics::kInputBytes)[metricIndex] = second->inputBytes;
+      metrics->get(Metrics::kRawInputRows)[metricIndex] = second->rawInputRows;
+      metrics->get(Metrics::kRawInputBytes)[metricIndex] = second->rawInputBytes;
+      metrics->get(Metrics::kOutputRows)[metricIndex] = second->outputRows;
+      metrics->get(Metrics::kOutputVectors)[metricIndex] = second->outputVectors;
+      metrics->get(Metrics::kOutputBytes)[metricIndex] = second->outputBytes;
+      metrics->get(Metrics::kCpuCount)[metricIndex] = second->cpuWallTiming.count;
+      metrics->get(Metrics::kWallNanos)[metricIndex] = second->cpuWallTiming.wallNanos;
+      metrics->get(Metrics::kPeakMemoryBytes)[metricIndex] = second->peakMemoryBytes;
+      metrics->get(Metrics::kNumMemoryAllocations)[metricIndex] = second->numMemoryAllocations;
+      metrics->get(Metrics::kSpilledInputBytes)[metricIndex] = second->spilledInputBytes;
+      metrics->get(Metrics::kSpilledBytes)[metricIndex] = second->spilledBytes;
+      metrics->get(Metrics::kSpilledRows)[metricIndex] = second->spilledRows;
+      metrics->get(Metrics::kSpilledPartitions)[metricIndex] = second->spilledPartitions;
+      metrics->get(Metrics::kSpilledFiles)[metricIndex] = second->spilledFiles;
+      metrics->get(Metrics::kNumDynamicFiltersProduced)[metricIndex] =
           runtimeMetric("sum", second->customStats, kDynamicFiltersProduced);
-      metrics_->get(Metrics::kNumDynamicFiltersAccepted)[metricIndex] =
+      metrics->get(Metrics::kNumDynamicFiltersAccepted)[metricIndex] =
           runtimeMetric("sum", second->customStats, kDynamicFiltersAccepted);
-      metrics_->get(Metrics::kNumReplacedWithDynamicFilterRows)[metricIndex] =
+      metrics->get(Metrics::kNumReplacedWithDynamicFilterRows)[metricIndex] =
           runtimeMetric("sum", second->customStats, kReplacedWithDynamicFilterRows);
-      metrics_->get(Metrics::kFlushRowCount)[metricIndex] = runtimeMetric("sum", second->customStats, kFlushRowCount);
-      metrics_->get(Metrics::kLoadedToValueHook)[metricIndex] =
+      metrics->get(Metrics::kFlushRowCount)[metricIndex] = runtimeMetric("sum", second->customStats, kFlushRowCount);
+      metrics->get(Metrics::kLoadedToValueHook)[metricIndex] =
           runtimeMetric("sum", second->customStats, kLoadedToValueHook);
-      metrics_->get(Metrics::kScanTime)[metricIndex] = runtimeMetric("sum", second->customStats, kTotalScanTime);
-      metrics_->get(Metrics::kSkippedSplits)[metricIndex] = runtimeMetric("sum", second->customStats, kSkippedSplits);
-      metrics_->get(Metrics::kProcessedSplits)[metricIndex] =
+      metrics->get(Metrics::kScanTime)[metricIndex] = runtimeMetric("sum", second->customStats, kTotalScanTime);
+      metrics->get(Metrics::kSkippedSplits)[metricIndex] = runtimeMetric("sum", second->customStats, kSkippedSplits);
+      metrics->get(Metrics::kProcessedSplits)[metricIndex] =
           runtimeMetric("sum", second->customStats, kProcessedSplits);
-      metrics_->get(Metrics::kSkippedStrides)[metricIndex] = runtimeMetric("sum", second->customStats, kSkippedStrides);
-      metrics_->get(Metrics::kProcessedStrides)[metricIndex] =
+      metrics->get(Metrics::kSkippedStrides)[metricIndex] = runtimeMetric("sum", second->customStats, kSkippedStrides);
+      metrics->get(Metrics::kProcessedStrides)[metricIndex] =
           runtimeMetric("sum", second->customStats, kProcessedStrides);
-      metrics_->get(Metrics::kRemainingFilterTime)[metricIndex] =
+      metrics->get(Metrics::kRemainingFilterTime)[metricIndex] =
           runtimeMetric("sum", second->customStats, kRemainingFilterTime);
-      metrics_->get(Metrics::kIoWaitTime)[metricIndex] = runtimeMetric("sum", second->customStats, kIoWaitTime);
-      metrics_->get(Metrics::kStorageReadBytes)[metricIndex] =
+      metrics->get(Metrics::kIoWaitTime)[metricIndex] = runtimeMetric("sum", second->customStats, kIoWaitTime);
+      metrics->get(Metrics::kStorageReadBytes)[metricIndex] =
           runtimeMetric("sum", second->customStats, kStorageReadBytes);
-      metrics_->get(Metrics::kLocalReadBytes)[metricIndex] = runtimeMetric("sum", second->customStats, kLocalReadBytes);
-      metrics_->get(Metrics::kRamReadBytes)[metricIndex] = runtimeMetric("sum", second->customStats, kRamReadBytes);
-      metrics_->get(Metrics::kPreloadSplits)[metricIndex] =
+      metrics->get(Metrics::kLocalReadBytes)[metricIndex] = runtimeMetric("sum", second->customStats, kLocalReadBytes);
+      metrics->get(Metrics::kRamReadBytes)[metricIndex] = runtimeMetric("sum", second->customStats, kRamReadBytes);
+      metrics->get(Metrics::kPreloadSplits)[metricIndex] =
           runtimeMetric("sum", entry.second->customStats, kPreloadSplits);
-      metrics_->get(Metrics::kNumWrittenFiles)[metricIndex] =
+      metrics->get(Metrics::kNumWrittenFiles)[metricIndex] =
           runtimeMetric("sum", entry.second->customStats, kNumWrittenFiles);
-      metrics_->get(Metrics::kPhysicalWrittenBytes)[metricIndex] = second->physicalWrittenBytes;
-      metrics_->get(Metrics::kWriteIOTime)[metricIndex] = runtimeMetric("sum", second->customStats, kWriteIOTime);
+      metrics->get(Metrics::kPhysicalWrittenBytes)[metricIndex] = second->physicalWrittenBytes;
+      metrics->get(Metrics::kWriteIOTime)[metricIndex] = runtimeMetric("sum", second->customStats, kWriteIOTime);
 
       metricIndex += 1;
     }
   }
+  return metrics;
 }
 
 int64_t WholeStageResultIterator::runtimeMetric(
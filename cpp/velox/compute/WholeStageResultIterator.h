@@ -23,6 +23,7 @@
 #include "substrait/SubstraitToVeloxPlan.h"
 #include "substrait/plan.pb.h"
 #include "utils/Metrics.h"
+#include "utils/MetricsSnapshot.h"
 #include "velox/common/config/Config.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/core/PlanNode.h"
@@ -42,12 +43,7 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
       const std::unordered_map<std::string, std::string>& confMap,
       const SparkTaskInfo& taskInfo);
 
-  virtual ~WholeStageResultIterator() {
-    if (task_ != nullptr && task_->isRunning()) {
-      // calling .wait() may take no effect in single thread execution mode
-      task_->requestCancel().wait();
-    }
-  }
+  virtual ~WholeStageResultIterator();
 
   std::shared_ptr<ColumnarBatch> next() override;
 
@@ -61,6 +57,14 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
     return metrics_.get();
   }
 
+  /// Returns the buffer the live metrics are published to, or nullptr if nothing has been published yet. The buffer
+  /// lives as long as the iterator.
+  MetricsSnapshot* getMetricsSnapshot();
+
+  /// Publishes the current metrics to the snapshot buffer if the publish interval has elapsed. Called by a background
+  /// thread while the task is running.
+  void tryPublishMetrics();
+
   const facebook::velox::exec::Task* task() const {
     return task_.get();
   }
@@ -95,6 +99,9 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
   /// Collect Velox metrics.
   void collectMetrics();
 
+  /// Convert Velox task stats to metrics.
+  std::unique_ptr<Metrics> toMetrics(const facebook::velox::exec::TaskStats& taskStats);
+
   /// Return a certain type of runtime metric. Supported metric types are: sum, count, min, max.
   static int64_t runtimeMetric(
       const std::string& type,
@@ -112,11 +119,19 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
 
   /// Spill.
   std::string spillStrategy_;
+  std::string spillDir_;
   std::shared_ptr<folly::Executor> spillExecutor_ = nullptr;
 
   /// Metrics
   std::unique_ptr<Metrics> metrics_{};
 
+  /// Live metrics.
+  int64_t metricsPublishIntervalMs_{0};
+  int64_t lastMetricsPublishMs_{0};
+  std::mutex metricsPublishMutex_;
+  bool metricsFinalized_{false};
+  std::unique_ptr<MetricsSnapshot> metricsSnapshot_{};
+
   /// All the children plan node ids with postorder traversal.
   std::vector<facebook::velox::core::PlanNodeId> orderedNodeIds_;
 
@@ -40,6 +40,9 @@ const std::string kMaxSpillRunRows = "spark.gluten.sql.columnar.backend.velox.Ma
 const std::string kMaxSpillBytes = "spark.gluten.sql.columnar.backend.velox.MaxSpillBytes";
 const std::string kSpillReadBufferSize = "spark.unsafe.sorter.spill.reader.buffer.size";
 const uint64_t kMaxSpillFileSizeDefault = 1L * 1024 * 1024 * 1024;
+// Capacity of the process-wide memory tier used when spillFileSystem is memory-over-local.
+const std::string kSpillMemoryTierCapacity = "spark.gluten.sql.columnar.backend.velox.spillMemoryTierCapacity";
+const uint64_t kSpillMemoryTierCapacityDefault = 1L * 1024 * 1024 * 1024;
 
 const std::string kSpillableReservationGrowthPct =
     "spark.gluten.sql.columnar.backend.velox.spillableReservationGrowthPct";
@@ -67,6 +70,10 @@ const std::string kVeloxSplitPreloadPerDriver = "spark.gluten.sql.columnar.backe
 const std::string kShowTaskMetricsWhenFinished = "spark.gluten.sql.columnar.backend.velox.showTaskMetricsWhenFinished";
 const bool kShowTaskMetricsWhenFinishedDefault = false;
 
+// Interval of publishing live task metrics while the task is running. 0 disables it.
+const std::string kMetricsPublishIntervalMs = "spark.gluten.sql.columnar.backend.velox.metricsPublishIntervalMs";
+const int64_t kMetricsPublishIntervalMsDefault = 0;
+
 const std::string kEnableUserExceptionStacktrace =
     "spark.gluten.sql.columnar.backend.velox.enableUserExceptionStacktrace";
 const bool kEnableUserExceptionStacktraceDefault = true;
@@ -109,6 +116,17 @@ const std::string kVeloxAsyncTimeoutOnTaskStopping =
     "spark.gluten.sql.columnar.backend.velox.asyncTimeoutOnTaskStopping";
 const int32_t kVeloxAsyncTimeoutOnTaskStoppingDefault = 30000; // 30s
 
+// hedged reads
+const std::string kHedgedReadEnabled = "spark.gluten.sql.columnar.backend.velox.hedgedRead.enabled";
+const std::string kHedgedReadPercentile = "spark.gluten.sql.columnar.backend.velox.hedgedRead.percentile";
+const double kHedgedReadPercentileDefault = 0.95;
+const std::string kHedgedReadMinDelayMs = "spark.gluten.sql.columnar.backend.velox.hedgedRead.minDelayMs";
+const uint64_t kHedgedReadMinDelayMsDefault = 5;
+const std::string kHedgedReadBudgetRatio = "spark.gluten.sql.columnar.backend.velox.hedgedRead.budgetRatio";
+const double kHedgedReadBudgetRatioDefault = 0.05;
+const std::string kHedgedReadThreads = "spark.gluten.sql.columnar.backend.velox.hedgedRead.threads";
+const uint32_t kHedgedReadThreadsDefault = 64;
+
 // udf
 const std::string kVeloxUdfLibraryPaths = "spark.gluten.sql.columnar.backend.velox.internal.udfLibraryPaths";
 
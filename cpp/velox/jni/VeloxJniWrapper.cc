@@ -30,9 +30,11 @@
 #include "jni/JniFileSystem.h"
 #include "memory/VeloxColumnarBatch.h"
 #include "memory/VeloxMemoryManager.h"
+#include "shuffle/Utils.h"
 #include "substrait/SubstraitToVeloxPlanValidator.h"
 #include "utils/ObjectStore.h"
 #include "utils/VeloxBatchResizer.h"
+#include "utils/VeloxSortedRunMerger.h"
 #include "velox/common/base/BloomFilter.h"
 #include "velox/common/file/FileSystems.h"
 
@@ -311,6 +313,30 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_utils_VeloxBatchResizerJniWrapper
   JNI_METHOD_END(kInvalidObjectHandle)
 }
 
+JNIEXPORT jlong JNICALL Java_org_apache_gluten_utils_VeloxSortedRunMergerJniWrapper_create( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jstring sortKeys,
+    jint batchSize,
+    jlong memoryLimit,
+    jstring spillDir,
+    jobject jIter) {
+  JNI_METHOD_START
+  auto ctx = getRuntime(env, wrapper);
+  auto pool = dynamic_cast<VeloxMemoryManager*>(ctx->memoryManager())->getLeafMemoryPool();
+  auto iter = makeJniColumnarBatchIterator(env, jIter, ctx, nullptr);
+  auto merger = std::make_shared<ResultIterator>(std::make_unique<VeloxSortedRunMerger>(
+      ctx->memoryManager()->getArrowMemoryPool(),
+      pool,
+      parseShuffleSortKeys(jStringToCString(env, sortKeys)),
+      batchSize,
+      memoryLimit,
+      jStringToCString(env, spillDir),
+      std::move(iter)));
+  return ctx->saveObject(merger);
+  JNI_METHOD_END(kInvalidObjectHandle)
+}
+
 JNIEXPORT jboolean JNICALL
 Java_org_apache_gluten_utils_VeloxFileSystemValidationJniWrapper_allSupportedByRegisteredFileSystems( // NOLINT
     JNIEnv* env,
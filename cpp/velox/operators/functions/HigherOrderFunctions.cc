@@ -0,0 +1,913 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "operators/functions/HigherOrderFunctions.h"
+
+#include <cmath>
+#include <optional>
+#include <type_traits>
+
+#include "velox/expression/DecodedArgs.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+namespace {
+
+// The fast path functions, which are only called by the rewritten expressions:
+//   gluten_array_filter(array(T), op, field, U) -> array(T)
+//   gluten_array_exists(array(T), op, field, U) -> boolean
+//   gluten_array_transform(array(T), op, field, U) -> array(U)
+//   gluten_array_sum(array(T), T) -> T
+//   gluten_map_filter(map(K, V), op, argument, U) -> map(K, V)
+//   gluten_map_transform_values(map(K, V), op, V) -> map(K, V)
+// where op names the operation of the lambda, field is the ordinal of the struct field it reads or -1 for the element
+// itself, argument is 0 for the map key and 1 for the value, and U is the constant operand. A field projection has a
+// typed null in place of the constant, so that the result type can be resolved.
+const std::string kArrayFilter = "gluten_array_filter";
+const std::string kArrayExists = "gluten_array_exists";
+const std::string kArrayTransform = "gluten_array_transform";
+const std::string kArraySum = "gluten_array_sum";
+const std::string kMapFilter = "gluten_map_filter";
+const std::string kMapTransformValues = "gluten_map_transform_values";
+
+enum class Op { kEq, kLt, kLte, kGt, kGte, kAdd, kSubtract, kMultiply, kField };
+
+// The Spark functions the operations come from, or the name of the field projection.
+const std::vector<std::string> kOpNames = {
+    "equalto",
+    "lessthan",
+    "lessthanorequal",
+    "greaterthan",
+    "greaterthanorequal",
+    "add",
+    "subtract",
+    "multiply",
+    "field"};
+
+std::optional<Op> toOp(const std::string& name) {
+  for (size_t i = 0; i < kOpNames.size(); ++i) {
+    if (kOpNames[i] == name) {
+      return static_cast<Op>(i);
+    }
+  }
+  return std::nullopt;
+}
+
+bool isComparison(Op op) {
+  return op <= Op::kGte;
+}
+
+bool isArithmetic(Op op) {
+  return op >= Op::kAdd && op <= Op::kMultiply;
+}
+
+// The operation that gives the same result with its operands swapped, if any.
+std::optional<Op> swapOperands(Op op) {
+  switch (op) {
+    case Op::kLt:
+      return Op::kGt;
+    case Op::kLte:
+      return Op::kGte;
+    case Op::kGt:
+      return Op::kLt;
+    case Op::kGte:
+      return Op::kLte;
+    case Op::kEq:
+    case Op::kAdd:
+    case Op::kMultiply:
+      return op;
+    default:
+      return std::nullopt;
+  }
+}
+
+bool isSupportedType(const TypePtr& type, Op op) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      // Comparisons also work on the logical types of these, e.g. date and short decimal, but arithmetic does not.
+      return isComparison(op) || *type == *createScalarType(type->kind());
+    default:
+      return false;
+  }
+}
+
+// An operand of a lambda body: one of the lambda arguments, or a field of it if field >= 0.
+struct Operand {
+  int32_t argument;
+  int32_t field;
+  TypePtr type;
+};
+
+std::optional<Operand> matchOperand(const core::TypedExprPtr& expr, const RowType& arguments) {
+  auto matchArgument = [&](const core::TypedExprPtr& input) -> std::optional<int32_t> {
+    auto fieldAccess = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(input);
+    if (fieldAccess && fieldAccess->isInputColumn()) {
+      if (auto index = arguments.getChildIdxIfExists(fieldAccess->name())) {
+        return static_cast<int32_t>(*index);
+      }
+    }
+    return std::nullopt;
+  };
+
+  if (auto argument = matchArgument(expr)) {
+    return Operand{*argument, -1, expr->type()};
+  }
+  if (auto dereference = std::dynamic_pointer_cast<const core::DereferenceTypedExpr>(expr)) {
+    if (auto argument = matchArgument(dereference->inputs()[0])) {
+      return Operand{*argument, static_cast<int32_t>(dereference->index()), expr->type()};
+    }
+  }
+  if (auto fieldAccess = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(expr)) {
+    if (!fieldAccess->isInputColumn()) {
+      const auto& input = fieldAccess->inputs()[0];
+      auto argument = matchArgument(input);
+      auto index = argument ? asRowType(input->type())->getChildIdxIfExists(fieldAccess->name()) : std::nullopt;
+      if (index.has_value()) {
+        return Operand{*argument, static_cast<int32_t>(*index), expr->type()};
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+bool isNonNullConstant(const core::TypedExprPtr& expr, const TypePtr& type) {
+  auto constant = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(expr);
+  return constant && !constant->hasValueVector() && !constant->value().isNull() && *constant->type() == *type;
+}
+
+// A lambda whose body is `operand op constant`, or the projection of a field.
+struct SimpleLambda {
+  Operand operand;
+  Op op;
+  core::TypedExprPtr constant;
+};
+
+std::optional<SimpleLambda> matchLambda(const core::TypedExprPtr& expr) {
+  auto lambda = std::dynamic_pointer_cast<const core::LambdaTypedExpr>(expr);
+  if (!lambda) {
+    return std::nullopt;
+  }
+  const auto& arguments = *lambda->signature();
+  const auto& body = lambda->body();
+
+  if (auto operand = matchOperand(body, arguments)) {
+    if (operand->field < 0) {
+      return std::nullopt;
+    }
+    return SimpleLambda{*operand, Op::kField, nullptr};
+  }
+
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(body);
+  if (!call || call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto op = toOp(call->name());
+  if (!op.has_value() || *op == Op::kField) {
+    return std::nullopt;
+  }
+  for (auto i = 0; i < 2; ++i) {
+    auto operand = matchOperand(call->inputs()[i], arguments);
+    if (!operand.has_value() || !isNonNullConstant(call->inputs()[1 - i], operand->type)) {
+      continue;
+    }
+    auto normalized = i == 0 ? op : swapOperands(*op);
+    if (!normalized.has_value() || !isSupportedType(operand->type, *normalized)) {
+      return std::nullopt;
+    }
+    if (isArithmetic(*normalized) && !(*call->type() == *operand->type)) {
+      return std::nullopt;
+    }
+    return SimpleLambda{*operand, *normalized, call->inputs()[1 - i]};
+  }
+  return std::nullopt;
+}
+
+core::TypedExprPtr makeConstant(const TypePtr& type, variant value) {
+  return std::make_shared<core::ConstantTypedExpr>(type, std::move(value));
+}
+
+core::TypedExprPtr makeCall(
+    const std::string& name,
+    const TypePtr& outputType,
+    const core::TypedExprPtr& container,
+    const SimpleLambda& lambda,
+    std::optional<int32_t> ordinal) {
+  std::vector<core::TypedExprPtr> inputs{container, makeConstant(VARCHAR(), kOpNames[static_cast<int>(lambda.op)])};
+  if (ordinal.has_value()) {
+    inputs.push_back(makeConstant(INTEGER(), *ordinal));
+  }
+  inputs.push_back(
+      lambda.constant ? lambda.constant
+                      : makeConstant(lambda.operand.type, variant::null(lambda.operand.type->kind())));
+  return std::make_shared<core::CallTypedExpr>(outputType, std::move(inputs), name);
+}
+
+// Matches aggregate(array, init, (acc, x) -> acc + x[, acc -> acc]).
+bool isSumAggregate(const std::vector<core::TypedExprPtr>& params, const TypePtr& outputType) {
+  if (params.size() != 3 && params.size() != 4) {
+    return false;
+  }
+  const auto& elementType = params[0]->type()->childAt(0);
+  if (!(*elementType == *outputType) || !(*params[1]->type() == *outputType) ||
+      !isSupportedType(outputType, Op::kAdd)) {
+    return false;
+  }
+
+  auto merge = std::dynamic_pointer_cast<const core::LambdaTypedExpr>(params[2]);
+  auto add = merge ? std::dynamic_pointer_cast<const core::CallTypedExpr>(merge->body()) : nullptr;
+  if (!add || add->name() != "add" || add->inputs().size() != 2 || !(*add->type() == *outputType)) {
+    return false;
+  }
+  auto left = matchOperand(add->inputs()[0], *merge->signature());
+  auto right = matchOperand(add->inputs()[1], *merge->signature());
+  if (!left.has_value() || !right.has_value() || left->field >= 0 || right->field >= 0 ||
+      left->argument + right->argument != 1) {
+    return false;
+  }
+
+  if (params.size() == 4) {
+    auto finish = std::dynamic_pointer_cast<const core::LambdaTypedExpr>(params[3]);
+    auto identity = finish ? matchOperand(finish->body(), *finish->signature()) : std::nullopt;
+    return identity.has_value() && identity->argument == 0 && identity->field < 0;
+  }
+  return true;
+}
+
+// Spark's comparison, where NaN is larger than any other value and equal to itself.
+template <Op op, typename T>
+FOLLY_ALWAYS_INLINE bool compare(T left, T right) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (FOLLY_UNLIKELY(std::isnan(left) || std::isnan(right))) {
+      int32_t result = std::isnan(left) ? (std::isnan(right) ? 0 : 1) : -1;
+      return compare<op, int32_t>(result, 0);
+    }
+  }
+  if constexpr (op == Op::kEq) {
+    return left == right;
+  } else if constexpr (op == Op::kLt) {
+    return left < right;
+  } else if constexpr (op == Op::kLte) {
+    return left <= right;
+  } else if constexpr (op == Op::kGt) {
+    return left > right;
+  } else {
+    static_assert(op == Op::kGte);
+    return left >= right;
+  }
+}
+
+// Spark's arithmetic without ANSI mode, where integral results wrap around like in Java.
+template <Op op, typename T>
+FOLLY_ALWAYS_INLINE T arithmetic(T left, T right) {
+  if constexpr (std::is_integral_v<T>) {
+    auto l = static_cast<uint64_t>(left);
+    auto r = static_cast<uint64_t>(right);
+    if constexpr (op == Op::kAdd) {
+      return static_cast<T>(l + r);
+    } else if constexpr (op == Op::kSubtract) {
+      return static_cast<T>(l - r);
+    } else {
+      static_assert(op == Op::kMultiply);
+      return static_cast<T>(l * r);
+    }
+  } else {
+    if constexpr (op == Op::kAdd) {
+      return left + right;
+    } else if constexpr (op == Op::kSubtract) {
+      return left - right;
+    } else {
+      static_assert(op == Op::kMultiply);
+      return left * right;
+    }
+  }
+}
+
+template <typename F>
+void dispatchComparison(Op op, F&& f) {
+  switch (op) {
+    case Op::kEq:
+      return f(std::integral_constant<Op, Op::kEq>{});
+    case Op::kLt:
+      return f(std::integral_constant<Op, Op::kLt>{});
+    case Op::kLte:
+      return f(std::integral_constant<Op, Op::kLte>{});
+    case Op::kGt:
+      return f(std::integral_constant<Op, Op::kGt>{});
+    case Op::kGte:
+      return f(std::integral_constant<Op, Op::kGte>{});
+    default:
+      VELOX_FAIL("Not a comparison: {}", kOpNames[static_cast<int>(op)]);
+  }
+}
+
+template <typename F>
+void dispatchArithmetic(Op op, F&& f) {
+  switch (op) {
+    case Op::kAdd:
+      return f(std::integral_constant<Op, Op::kAdd>{});
+    case Op::kSubtract:
+      return f(std::integral_constant<Op, Op::kSubtract>{});
+    case Op::kMultiply:
+      return f(std::integral_constant<Op, Op::kMultiply>{});
+    default:
+      VELOX_FAIL("Not an arithmetic operation: {}", kOpNames[static_cast<int>(op)]);
+  }
+}
+
+template <typename F>
+void dispatchType(TypeKind kind, F&& f) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return f(int8_t{});
+    case TypeKind::SMALLINT:
+      return f(int16_t{});
+    case TypeKind::INTEGER:
+      return f(int32_t{});
+    case TypeKind::BIGINT:
+      return f(int64_t{});
+    case TypeKind::REAL:
+      return f(float{});
+    case TypeKind::DOUBLE:
+      return f(double{});
+    default:
+      VELOX_FAIL("Unsupported lambda operand type: {}", mapTypeKindToName(kind));
+  }
+}
+
+Op opArg(const VectorPtr& arg) {
+  auto name = arg->as<ConstantVector<StringView>>()->valueAt(0).str();
+  auto op = toOp(name);
+  VELOX_CHECK(op.has_value(), "Unknown lambda operation: {}", name);
+  return *op;
+}
+
+int32_t intArg(const VectorPtr& arg) {
+  return arg->as<ConstantVector<int32_t>>()->valueAt(0);
+}
+
+template <typename T>
+T constantArg(const VectorPtr& arg) {
+  return arg->as<SimpleVector<T>>()->valueAt(0);
+}
+
+// The values of a lambda operand over a flattened elements vector, i.e. the elements or a field of them.
+class OperandValues {
+ public:
+  OperandValues(const BaseVector& elements, int32_t field) : nested_(field >= 0) {
+    elements_.decode(elements);
+    if (nested_) {
+      field_.decode(*elements_.base()->as<RowVector>()->childAt(field));
+    }
+  }
+
+  /// Returns the values indexed by element, or nullptr if there may be nulls or an indirection.
+  template <typename T>
+  const T* rawValues() const {
+    if (elements_.mayHaveNulls() || !elements_.isIdentityMapping()) {
+      return nullptr;
+    }
+    if (!nested_) {
+      return elements_.data<T>();
+    }
+    return field_.mayHaveNulls() || !field_.isIdentityMapping() ? nullptr : field_.data<T>();
+  }
+
+  bool isNullAt(vector_size_t i) const {
+    if (elements_.isNullAt(i)) {
+      return true;
+    }
+    return nested_ && field_.isNullAt(elements_.index(i));
+  }
+
+  template <typename T>
+  T valueAt(vector_size_t i) const {
+    return nested_ ? field_.valueAt<T>(elements_.index(i)) : elements_.valueAt<T>(i);
+  }
+
+ private:
+  const bool nested_;
+  DecodedVector elements_;
+  DecodedVector field_;
+};
+
+// Writes the indices of the elements in [begin, end) that satisfy `value op constant` to selected and returns their
+// number.
+template <Op op, typename T>
+vector_size_t selectElements(
+    const OperandValues& values,
+    const T* rawValues,
+    T constant,
+    vector_size_t begin,
+    vector_size_t end,
+    vector_size_t* selected) {
+  vector_size_t numSelected = 0;
+  if (rawValues) {
+    for (auto i = begin; i < end; ++i) {
+      selected[numSelected] = i;
+      numSelected += compare<op>(rawValues[i], constant);
+    }
+  } else {
+    for (auto i = begin; i < end; ++i) {
+      selected[numSelected] = i;
+      numSelected += !values.isNullAt(i) && compare<op>(values.valueAt<T>(i), constant);
+    }
+  }
+  return numSelected;
+}
+
+// Returns whether some element in [begin, end) satisfies `value op constant`, or std::nullopt if none does but the
+// result is unknown for some null element.
+template <Op op, typename T>
+std::optional<bool>
+anyMatch(const OperandValues& values, const T* rawValues, T constant, vector_size_t begin, vector_size_t end) {
+  if (rawValues) {
+    bool match = false;
+    for (auto i = begin; i < end; ++i) {
+      match |= compare<op>(rawValues[i], constant);
+    }
+    return match;
+  }
+  bool hasNull = false;
+  for (auto i = begin; i < end; ++i) {
+    if (values.isNullAt(i)) {
+      hasNull = true;
+    } else if (compare<op>(values.valueAt<T>(i), constant)) {
+      return true;
+    }
+  }
+  return hasNull ? std::nullopt : std::optional<bool>(false);
+}
+
+// Computes `value op constant` into result for the elements in [begin, end).
+template <Op op, typename T>
+void computeElements(
+    const OperandValues& values,
+    const T* rawValues,
+    T constant,
+    vector_size_t begin,
+    vector_size_t end,
+    FlatVector<T>& result) {
+  auto* rawResult = result.mutableRawValues();
+  if (rawValues) {
+    for (auto i = begin; i < end; ++i) {
+      rawResult[i] = arithmetic<op>(rawValues[i], constant);
+    }
+  } else {
+    for (auto i = begin; i < end; ++i) {
+      if (values.isNullAt(i)) {
+        result.setNull(i, true);
+      } else {
+        rawResult[i] = arithmetic<op>(values.valueAt<T>(i), constant);
+      }
+    }
+  }
+}
+
+// Returns the field of each struct element, null where the struct is null, without copying.
+VectorPtr projectField(const VectorPtr& elements, int32_t field, memory::MemoryPool* pool) {
+  if (elements->encoding() == VectorEncoding::Simple::ROW && !elements->mayHaveNulls()) {
+    return elements->asUnchecked<RowVector>()->childAt(field);
+  }
+  DecodedVector decoded(*elements);
+  auto size = elements->size();
+  auto indices = allocateIndices(size, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  BufferPtr nulls = decoded.mayHaveNulls() ? allocateNulls(size, pool) : nullptr;
+  auto* rawNulls = nulls ? nulls->asMutable<uint64_t>() : nullptr;
+  for (vector_size_t i = 0; i < size; ++i) {
+    rawIndices[i] = decoded.index(i);
+    if (rawNulls && decoded.isNullAt(i)) {
+      bits::setNull(rawNulls, i);
+    }
+  }
+  return BaseVector::wrapInDictionary(
+      std::move(nulls), std::move(indices), size, decoded.base()->as<RowVector>()->childAt(field));
+}
+
+// The offsets and sizes of the filtered containers, and the indices of the elements they keep.
+struct FilterResult {
+  BufferPtr nulls;
+  BufferPtr offsets;
+  BufferPtr sizes;
+  BufferPtr indices;
+  vector_size_t numSelected{0};
+};
+
+// Filters the containers at the selected rows, which are decoded to base, by `operand op constant`.
+template <typename Container>
+FilterResult filterContainers(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    const Container& base,
+    const OperandValues& values,
+    Op op,
+    const VectorPtr& constant,
+    memory::MemoryPool* pool) {
+  vector_size_t maxSelected = 0;
+  rows.applyToSelected([&](auto row) {
+    if (!decoded.isNullAt(row)) {
+      maxSelected += base.sizeAt(decoded.index(row));
+    }
+  });
+
+  FilterResult filtered;
+  filtered.nulls = decoded.mayHaveNulls() ? allocateNulls(rows.end(), pool) : nullptr;
+  filtered.offsets = allocateOffsets(rows.end(), pool);
+  filtered.sizes = allocateSizes(rows.end(), pool);
+  filtered.indices = allocateIndices(maxSelected, pool);
+  auto* rawNulls = filtered.nulls ? filtered.nulls->asMutable<uint64_t>() : nullptr;
+  auto* rawOffsets = filtered.offsets->asMutable<vector_size_t>();
+  auto* rawSizes = filtered.sizes->asMutable<vector_size_t>();
+  auto* rawIndices = filtered.indices->asMutable<vector_size_t>();
+
+  dispatchComparison(op, [&](auto opConstant) {
+    dispatchType(constant->typeKind(), [&](auto typeTag) {
+      using T = decltype(typeTag);
+      constexpr Op kOp = decltype(opConstant)::value;
+      const auto* rawValues = values.rawValues<T>();
+      auto constantValue = constantArg<T>(constant);
+      rows.applyToSelected([&](auto row) {
+        rawOffsets[row] = filtered.numSelected;
+        if (decoded.isNullAt(row)) {
+          bits::setNull(rawNulls, row);
+          return;
+        }
+        auto index = decoded.index(row);
+        auto begin = base.offsetAt(index);
+        auto numSelected = selectElements<kOp, T>(
+            values, rawValues, constantValue, begin, begin + base.sizeAt(index), rawIndices + filtered.numSelected);
+        rawSizes[row] = numSelected;
+        filtered.numSelected += numSelected;
+      });
+    });
+  });
+  return filtered;
+}
+
+class ArrayFilterFunction final : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    auto* arrays = decodedArgs.at(0);
+    auto* base = arrays->base()->as<ArrayVector>();
+    OperandValues values(*base->elements(), intArg(args[2]));
+    auto* pool = context.pool();
+    auto filtered = filterContainers(rows, *arrays, *base, values, opArg(args[1]), args[3], pool);
+    auto localResult = std::make_shared<ArrayVector>(
+        pool,
+        outputType,
+        std::move(filtered.nulls),
+        rows.end(),
+        std::move(filtered.offsets),
+        std::move(filtered.sizes),
+        BaseVector::wrapInDictionary(nullptr, std::move(filtered.indices), filtered.numSelected, base->elements()));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+};
+
+class ArrayExistsFunction final : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    auto* arrays = decodedArgs.at(0);
+    auto* base = arrays->base()->as<ArrayVector>();
+    OperandValues values(*base->elements(), intArg(args[2]));
+    context.ensureWritable(rows, outputType, result);
+    auto* flatResult = result->asFlatVector<bool>();
+
+    dispatchComparison(opArg(args[1]), [&](auto opConstant) {
+      dispatchType(args[3]->typeKind(), [&](auto typeTag) {
+        using T = decltype(typeTag);
+        constexpr Op kOp = decltype(opConstant)::value;
+        const auto* rawValues = values.rawValues<T>();
+        auto constant = constantArg<T>(args[3]);
+        rows.applyToSelected([&](auto row) {
+          if (arrays->isNullAt(row)) {
+            flatResult->setNull(row, true);
+            return;
+          }
+          auto index = arrays->index(row);
+          auto begin = base->offsetAt(index);
+          auto match = anyMatch<kOp, T>(values, rawValues, constant, begin, begin + base->sizeAt(index));
+          if (match.has_value()) {
+            flatResult->set(row, *match);
+          } else {
+            flatResult->setNull(row, true);
+          }
+        });
+      });
+    });
+  }
+};
+
+// Computes `operand op constant` for the elements of the containers at the selected rows into a new flat vector that
+// is indexed like values.
+VectorPtr computeContainerElements(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    const ArrayVectorBase& base,
+    const OperandValues& values,
+    vector_size_t numElements,
+    Op op,
+    const VectorPtr& constant,
+    memory::MemoryPool* pool) {
+  auto result = BaseVector::create(constant->type(), numElements, pool);
+  dispatchArithmetic(op, [&](auto opConstant) {
+    dispatchType(constant->typeKind(), [&](auto typeTag) {
+      using T = decltype(typeTag);
+      constexpr Op kOp = decltype(opConstant)::value;
+      auto* flatResult = result->asFlatVector<T>();
+      const auto* rawValues = values.rawValues<T>();
+      auto constantValue = constantArg<T>(constant);
+      rows.applyToSelected([&](auto row) {
+        if (decoded.isNullAt(row)) {
+          return;
+        }
+        auto index = decoded.index(row);
+        auto begin = base.offsetAt(index);
+        computeElements<kOp, T>(values, rawValues, constantValue, begin, begin + base.sizeAt(index), *flatResult);
+      });
+    });
+  });
+  return result;
+}
+
+class ArrayTransformFunction final : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    auto* arrays = decodedArgs.at(0);
+    auto* base = arrays->base()->as<ArrayVector>();
+    auto op = opArg(args[1]);
+    auto field = intArg(args[2]);
+    auto* pool = context.pool();
+
+    VectorPtr elements;
+    if (op == Op::kField) {
+      elements = projectField(base->elements(), field, pool);
+    } else {
+      OperandValues values(*base->elements(), field);
+      elements = computeContainerElements(rows, *arrays, *base, values, base->elements()->size(), op, args[3], pool);
+    }
+    // Shares the offsets and sizes of the input and keeps its encoding.
+    auto baseResult = std::make_shared<ArrayVector>(
+        pool, outputType, base->nulls(), base->size(), base->offsets(), base->sizes(), std::move(elements));
+    auto localResult = arrays->wrap(std::move(baseResult), *args[0], rows.end());
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+};
+
+class ArraySumFunction final : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto* arrays = decodedArgs.at(0);
+    auto* inits = decodedArgs.at(1);
+    auto* base = arrays->base()->as<ArrayVector>();
+    OperandValues values(*base->elements(), -1);
+    context.ensureWritable(rows, outputType, result);
+
+    dispatchType(outputType->kind(), [&](auto typeTag) {
+      using T = decltype(typeTag);
+      auto* flatResult = result->asFlatVector<T>();
+      const auto* rawValues = values.rawValues<T>();
+      rows.applyToSelected([&](auto row) {
+        // The sum is null once the accumulator or an element is null.
+        if (arrays->isNullAt(row) || inits->isNullAt(row)) {
+          flatResult->setNull(row, true);
+          return;
+        }
+        auto index = arrays->index(row);
+        auto begin = base->offsetAt(index);
+        auto end = begin + base->sizeAt(index);
+        auto sum = inits->valueAt<T>(row);
+        if (rawValues) {
+          for (auto i = begin; i < end; ++i) {
+            sum = arithmetic<Op::kAdd>(sum, rawValues[i]);
+          }
+        } else {
+          for (auto i = begin; i < end; ++i) {
+            if (values.isNullAt(i)) {
+              flatResult->setNull(row, true);
+              return;
+            }
+            sum = arithmetic<Op::kAdd>(sum, values.valueAt<T>(i));
+          }
+        }
+        flatResult->set(row, sum);
+      });
+    });
+  }
+};
+
+class MapFilterFunction final : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    auto* maps = decodedArgs.at(0);
+    auto* base = maps->base()->as<MapVector>();
+    OperandValues values(intArg(args[2]) == 0 ? *base->mapKeys() : *base->mapValues(), -1);
+    auto* pool = context.pool();
+    auto filtered = filterContainers(rows, *maps, *base, values, opArg(args[1]), args[3], pool);
+    auto localResult = std::make_shared<MapVector>(
+        pool,
+        outputType,
+        std::move(filtered.nulls),
+        rows.end(),
+        std::move(filtered.offsets),
+        std::move(filtered.sizes),
+        BaseVector::wrapInDictionary(nullptr, filtered.indices, filtered.numSelected, base->mapKeys()),
+        BaseVector::wrapInDictionary(nullptr, filtered.indices, filtered.numSelected, base->mapValues()));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+};
+
+class MapTransformValuesFunction final : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    auto* maps = decodedArgs.at(0);
+    auto* base = maps->base()->as<MapVector>();
+    OperandValues values(*base->mapValues(), -1);
+    auto* pool = context.pool();
+    auto mapValues =
+        computeContainerElements(rows, *maps, *base, values, base->mapValues()->size(), opArg(args[1]), args[2], pool);
+    auto baseResult = std::make_shared<MapVector>(
+        pool,
+        outputType,
+        base->nulls(),
+        base->size(),
+        base->offsets(),
+        base->sizes(),
+        base->mapKeys(),
+        std::move(mapValues));
+    auto localResult = maps->wrap(std::move(baseResult), *args[0], rows.end());
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+};
+
+std::shared_ptr<exec::FunctionSignature> arraySignature(const std::string& returnType) {
+  return exec::FunctionSignatureBuilder()
+      .typeVariable("T")
+      .typeVariable("U")
+      .returnType(returnType)
+      .argumentType("array(T)")
+      .constantArgumentType("varchar")
+      .constantArgumentType("integer")
+      .constantArgumentType("U")
+      .build();
+}
+
+} // namespace
+
+core::TypedExprPtr rewriteHigherOrderCall(
+    const std::string& function,
+    const std::vector<core::TypedExprPtr>& params,
+    const TypePtr& outputType) {
+  if (params.empty()) {
+    return nullptr;
+  }
+  const auto& containerType = params[0]->type();
+
+  if (containerType->isArray() && function == "aggregate") {
+    return isSumAggregate(params, outputType)
+        ? std::make_shared<core::CallTypedExpr>(
+              outputType, std::vector<core::TypedExprPtr>{params[0], params[1]}, kArraySum)
+        : nullptr;
+  }
+
+  if (params.size() != 2) {
+    return nullptr;
+  }
+  auto lambda = matchLambda(params[1]);
+  if (!lambda.has_value()) {
+    return nullptr;
+  }
+  const auto& operand = lambda->operand;
+  auto op = lambda->op;
+
+  if (containerType->isArray() && operand.argument == 0) {
+    if (function == "filter" && isComparison(op)) {
+      return makeCall(kArrayFilter, outputType, params[0], *lambda, operand.field);
+    }
+    if (function == "exists" && isComparison(op)) {
+      return makeCall(kArrayExists, outputType, params[0], *lambda, operand.field);
+    }
+    if (function == "transform" && !isComparison(op) && *outputType->childAt(0) == *operand.type) {
+      return makeCall(kArrayTransform, outputType, params[0], *lambda, operand.field);
+    }
+    return nullptr;
+  }
+
+  if (containerType->isMap() && operand.field < 0) {
+    if (function == "map_filter" && isComparison(op)) {
+      return makeCall(kMapFilter, outputType, params[0], *lambda, operand.argument);
+    }
+    if (function == "transform_values" && isArithmetic(op) && operand.argument == 1 &&
+        *outputType->childAt(1) == *operand.type) {
+      return makeCall(kMapTransformValues, outputType, params[0], *lambda, std::nullopt);
+    }
+  }
+  return nullptr;
+}
+
+void registerHigherOrderFunctions() {
+  auto metadata = exec::VectorFunctionMetadataBuilder().defaultNullBehavior(false).build();
+  exec::registerVectorFunction(
+      kArrayFilter, {arraySignature("array(T)")}, std::make_unique<ArrayFilterFunction>(), metadata);
+  exec::registerVectorFunction(
+      kArrayExists, {arraySignature("boolean")}, std::make_unique<ArrayExistsFunction>(), metadata);
+  exec::registerVectorFunction(
+      kArrayTransform, {arraySignature("array(U)")}, std::make_unique<ArrayTransformFunction>(), metadata);
+  exec::registerVectorFunction(
+      kArraySum,
+      {exec::FunctionSignatureBuilder()
+           .typeVariable("T")
+           .returnType("T")
+           .argumentType("array(T)")
+           .argumentType("T")
+           .build()},
+      std::make_unique<ArraySumFunction>(),
+      metadata);
+  exec::registerVectorFunction(
+      kMapFilter,
+      {exec::FunctionSignatureBuilder()
+           .typeVariable("K")
+           .typeVariable("V")
+           .typeVariable("U")
+           .returnType("map(K,V)")
+           .argumentType("map(K,V)")
+           .constantArgumentType("varchar")
+           .constantArgumentType("integer")
+           .constantArgumentType("U")
+           .build()},
+      std::make_unique<MapFilterFunction>(),
+      metadata);
+  exec::registerVectorFunction(
+      kMapTransformValues,
+      {exec::FunctionSignatureBuilder()
+           .typeVariable("K")
+           .typeVariable("V")
+           .returnType("map(K,V)")
+           .argumentType("map(K,V)")
+           .constantArgumentType("varchar")
+           .constantArgumentType("V")
+           .build()},
+      std::make_unique<MapTransformValuesFunction>(),
+      metadata);
+}
+
+} // namespace gluten
@@ -0,0 +1,46 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "velox/core/Expressions.h"
+
+namespace gluten {
+
+/// Fast paths for Spark higher-order functions whose lambda is a simple expression of one element, e.g.
+///   filter(a, x -> x > 10), exists(a, x -> x.qty = 0), transform(a, x -> x * 2), transform(a, x -> x.price),
+///   aggregate(a, 0, (acc, x) -> acc + x), map_filter(m, (k, v) -> v > 0), transform_values(m, (k, v) -> v + 1).
+/// Such a call is evaluated by a flat kernel over the elements (or keys and values) vector and the offsets instead of
+/// by evaluating the lambda, which saves the expression evaluation and the wrapping of captures per batch.
+///
+/// The supported lambdas compare the element, or a field of it, with a non-null constant of the same type, or add,
+/// subtract or multiply it by one, or project a field of it. Comparisons follow Spark's ordering of NaN, and integral
+/// arithmetic wraps around as Spark does without ANSI mode.
+
+/// Returns an equivalent call of one of the fast path functions if `function` is a higher-order function called with
+/// a supported lambda, or nullptr otherwise.
+facebook::velox::core::TypedExprPtr rewriteHigherOrderCall(
+    const std::string& function,
+    const std::vector<facebook::velox::core::TypedExprPtr>& params,
+    const facebook::velox::TypePtr& outputType);
+
+void registerHigherOrderFunctions();
+
+} // namespace gluten
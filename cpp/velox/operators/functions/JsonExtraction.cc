@@ -0,0 +1,443 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "operators/functions/JsonExtraction.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string_view>
+
+#include <simdjson.h>
+
+#include "velox/expression/VectorFunction.h"
+#include "velox/vector/ComplexVector.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+namespace {
+
+// The shared extraction function, which is only called by the rewritten expressions:
+//   gluten_get_json_objects(varchar json, varchar path...) -> row(varchar...)
+// where the paths are constants and field i of the result is get_json_object(json, path i).
+const std::string kGetJsonObject = "get_json_object";
+const std::string kGetJsonObjects = "gluten_get_json_objects";
+
+// A step of a JSON path: a field of an object, or the element of an array if index >= 0.
+struct JsonPathStep {
+  std::string field;
+  int32_t index;
+};
+
+using JsonPath = std::vector<JsonPathStep>;
+
+bool isFieldNameChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Parses a path of the form $.field.field[index], or returns nullopt for other paths, including $ alone.
+std::optional<JsonPath> parseJsonPath(std::string_view path) {
+  if (path.size() < 2 || path[0] != '$') {
+    return std::nullopt;
+  }
+  JsonPath steps;
+  size_t pos = 1;
+  while (pos < path.size()) {
+    auto begin = pos + 1;
+    if (path[pos] == '.') {
+      pos = begin;
+      while (pos < path.size() && isFieldNameChar(path[pos])) {
+        ++pos;
+      }
+      if (pos == begin) {
+        return std::nullopt;
+      }
+      steps.push_back({std::string(path.substr(begin, pos - begin)), -1});
+    } else if (path[pos] == '[') {
+      int32_t index = 0;
+      for (pos = begin; pos < path.size() && std::isdigit(static_cast<unsigned char>(path[pos])); ++pos) {
+        if (pos - begin >= 9) {
+          return std::nullopt;
+        }
+        index = index * 10 + (path[pos] - '0');
+      }
+      if (pos == begin || pos == path.size() || path[pos] != ']') {
+        return std::nullopt;
+      }
+      ++pos;
+      steps.push_back({"", index});
+    } else {
+      return std::nullopt;
+    }
+  }
+  return steps;
+}
+
+template <typename T>
+void appendInteger(T value, std::string& result) {
+  char buffer[24];
+  const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+  result.append(buffer, end);
+}
+
+// Formats the double as get_json_object does with Java's Double.toString: the shortest digits that read back as the
+// same double, in plain notation if 1e-3 <= |value| < 1e7 and as d.dddE<exponent> otherwise.
+void appendDouble(double value, std::string& result) {
+  if (value == 0) {
+    result.append(std::signbit(value) ? "-0.0" : "0.0");
+    return;
+  }
+  // The shortest round-trip digits, as "-d.ddde-XX".
+  char buffer[32];
+  const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific).ptr;
+  std::string_view scientific(buffer, end - buffer);
+  if (scientific.front() == '-') {
+    result.push_back('-');
+    scientific.remove_prefix(1);
+  }
+  const auto exponentPos = scientific.find('e');
+  int exponent = 0;
+  std::from_chars(
+      scientific.data() + exponentPos + (scientific[exponentPos + 1] == '+' ? 2 : 1), scientific.end(), exponent);
+  std::string digits;
+  for (auto c : scientific.substr(0, exponentPos)) {
+    if (c != '.') {
+      digits.push_back(c);
+    }
+  }
+
+  if (exponent < -3 || exponent >= 7) {
+    result.push_back(digits[0]);
+    result.push_back('.');
+    result.append(digits.size() > 1 ? std::string_view(digits).substr(1) : "0");
+    result.push_back('E');
+    result.append(std::to_string(exponent));
+  } else if (exponent < 0) {
+    result.append("0.");
+    result.append(-exponent - 1, '0');
+    result.append(digits);
+  } else {
+    const size_t integerDigits = exponent + 1;
+    if (digits.size() <= integerDigits) {
+      result.append(digits);
+      result.append(integerDigits - digits.size(), '0');
+      result.append(".0");
+    } else {
+      result.append(digits, 0, integerDigits);
+      result.push_back('.');
+      result.append(digits, integerDigits);
+    }
+  }
+}
+
+// Whether the value just read is followed by the end of its object or array, or by the next value, as get_json_object
+// requires of a valid document.
+bool hasValidEnding(simdjson::ondemand::document& document) {
+  const char* location;
+  if (document.current_location().get(location)) {
+    return false;
+  }
+  return *location == ',' || *location == '}' || *location == ']';
+}
+
+// Evaluates the path on the document and appends the result to `result` as get_json_object does. Returns false if
+// the result is null. The document is rewound first, so that the paths can be evaluated one after another on the
+// structural index built once by the parser.
+bool extract(simdjson::ondemand::document& document, const JsonPath& path, std::string& result) {
+  document.rewind();
+  simdjson::ondemand::value value;
+  if (document.get_value().get(value)) {
+    return false;
+  }
+  for (const auto& step : path) {
+    if (step.index >= 0) {
+      simdjson::ondemand::array array;
+      if (value.get_array().get(array) || array.at(step.index).get(value)) {
+        return false;
+      }
+    } else {
+      simdjson::ondemand::object object;
+      if (value.get_object().get(object) || object.find_field(step.field).get(value)) {
+        return false;
+      }
+    }
+  }
+
+  simdjson::ondemand::json_type type;
+  if (value.type().get(type)) {
+    return false;
+  }
+  switch (type) {
+    case simdjson::ondemand::json_type::number: {
+      simdjson::ondemand::number_type numberType;
+      if (value.get_number_type().get(numberType)) {
+        return false;
+      }
+      if (numberType == simdjson::ondemand::number_type::unsigned_integer) {
+        uint64_t number;
+        if (value.get_uint64().get(number)) {
+          return false;
+        }
+        appendInteger(number, result);
+      } else if (numberType == simdjson::ondemand::number_type::signed_integer) {
+        int64_t number;
+        if (value.get_int64().get(number)) {
+          return false;
+        }
+        appendInteger(number, result);
+      } else if (numberType == simdjson::ondemand::number_type::floating_point_number) {
+        double number;
+        if (value.get_double().get(number)) {
+          return false;
+        }
+        appendDouble(number, result);
+      } else {
+        return false;
+      }
+      break;
+    }
+    case simdjson::ondemand::json_type::boolean: {
+      bool boolean;
+      if (value.get_bool().get(boolean)) {
+        return false;
+      }
+      result.append(boolean ? "true" : "false");
+      break;
+    }
+    case simdjson::ondemand::json_type::string: {
+      std::string_view string;
+      if (value.get_string().get(string)) {
+        return false;
+      }
+      result.append(string);
+      break;
+    }
+    case simdjson::ondemand::json_type::object: {
+      simdjson::ondemand::object object;
+      std::string_view raw;
+      if (value.get_object().get(object) || object.raw_json().get(raw)) {
+        return false;
+      }
+      result.append(raw);
+      break;
+    }
+    case simdjson::ondemand::json_type::array: {
+      simdjson::ondemand::array array;
+      std::string_view raw;
+      if (value.get_array().get(array) || array.raw_json().get(raw)) {
+        return false;
+      }
+      result.append(raw);
+      break;
+    }
+    default:
+      return false;
+  }
+  return hasValidEnding(document);
+}
+
+class GetJsonObjectsFunction : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    std::vector<JsonPath> paths;
+    for (size_t i = 1; i < args.size(); ++i) {
+      auto pathString = args[i]->as<ConstantVector<StringView>>()->valueAt(0);
+      auto path = parseJsonPath(std::string_view(pathString.data(), pathString.size()));
+      VELOX_CHECK(path.has_value(), "Unsupported JSON path: {}", args[i]->toString(0));
+      paths.push_back(std::move(*path));
+    }
+
+    auto* pool = context.pool();
+    std::vector<VectorPtr> fields;
+    std::vector<FlatVector<StringView>*> flatFields;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      auto field = BaseVector::create<FlatVector<StringView>>(VARCHAR(), rows.end(), pool);
+      flatFields.push_back(field.get());
+      fields.push_back(std::move(field));
+    }
+
+    exec::LocalDecodedVector decoded(context, *args[0], rows);
+    simdjson::ondemand::parser parser;
+    std::string padded;
+    std::string value;
+    rows.applyToSelected([&](vector_size_t row) {
+      // The parser requires padding after the document.
+      auto json = decoded->valueAt<StringView>(row);
+      padded.assign(json.data(), json.size());
+      padded.resize(json.size() + simdjson::SIMDJSON_PADDING, '\0');
+      simdjson::ondemand::document document;
+      bool parsed = !parser.iterate(padded.data(), json.size(), padded.size()).get(document);
+      for (size_t i = 0; i < paths.size(); ++i) {
+        value.clear();
+        if (parsed && extract(document, paths[i], value)) {
+          flatFields[i]->set(row, StringView(value));
+        } else {
+          flatFields[i]->setNull(row, true);
+        }
+      }
+    });
+
+    auto extracted = std::make_shared<RowVector>(pool, outputType, nullptr, rows.end(), std::move(fields));
+    context.moveOrCopyResult(extracted, rows, result);
+  }
+};
+
+// The input column and the path of get_json_object(column, 'path') with a supported path.
+struct Extraction {
+  core::TypedExprPtr column;
+  std::string path;
+};
+
+std::optional<Extraction> matchExtraction(const core::TypedExprPtr& expr) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (!call || call->name() != kGetJsonObject || call->inputs().size() != 2 ||
+      call->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  auto column = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(call->inputs()[0]);
+  auto path = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(call->inputs()[1]);
+  if (!column || !column->isInputColumn() || column->type()->kind() != TypeKind::VARCHAR || !path ||
+      path->hasValueVector() || path->type()->kind() != TypeKind::VARCHAR || path->value().isNull()) {
+    return std::nullopt;
+  }
+  const auto& pathString = path->value().value<TypeKind::VARCHAR>();
+  if (!parseJsonPath(pathString).has_value()) {
+    return std::nullopt;
+  }
+  return Extraction{column, pathString};
+}
+
+// Returns the expression with the subexpressions replaced where `replace` returns non-null, looking through calls,
+// casts and struct field accesses.
+core::TypedExprPtr transform(
+    const core::TypedExprPtr& expr,
+    const std::function<core::TypedExprPtr(const core::TypedExprPtr&)>& replace) {
+  if (auto replaced = replace(expr)) {
+    return replaced;
+  }
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  auto cast = std::dynamic_pointer_cast<const core::CastTypedExpr>(expr);
+  auto dereference = std::dynamic_pointer_cast<const core::DereferenceTypedExpr>(expr);
+  auto fieldAccess = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(expr);
+  if (!call && !cast && !dereference && !(fieldAccess && !fieldAccess->isInputColumn())) {
+    return expr;
+  }
+
+  std::vector<core::TypedExprPtr> inputs;
+  bool changed = false;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(transform(input, replace));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  if (call) {
+    return std::make_shared<const core::CallTypedExpr>(call->type(), std::move(inputs), call->name());
+  }
+  if (cast) {
+    return std::make_shared<const core::CastTypedExpr>(cast->type(), std::move(inputs), cast->nullOnFailure());
+  }
+  if (dereference) {
+    return std::make_shared<const core::DereferenceTypedExpr>(dereference->type(), inputs[0], dereference->index());
+  }
+  return std::make_shared<const core::FieldAccessTypedExpr>(fieldAccess->type(), inputs[0], fieldAccess->name());
+}
+
+// The distinct paths extracted from a column, in order of appearance, and the shared call extracting them.
+struct ColumnExtractions {
+  core::TypedExprPtr column;
+  std::vector<std::string> paths;
+  core::TypedExprPtr sharedCall;
+};
+
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractions(const std::vector<core::TypedExprPtr>& expressions) {
+  std::map<std::string, ColumnExtractions> columns;
+  auto collect = [&](const core::TypedExprPtr& expr) -> core::TypedExprPtr {
+    if (auto extraction = matchExtraction(expr)) {
+      auto& column = columns[extraction->column->toString()];
+      column.column = extraction->column;
+      if (std::find(column.paths.begin(), column.paths.end(), extraction->path) == column.paths.end()) {
+        column.paths.push_back(extraction->path);
+      }
+    }
+    return nullptr;
+  };
+  for (const auto& expr : expressions) {
+    transform(expr, collect);
+  }
+
+  bool shared = false;
+  for (auto& [_, column] : columns) {
+    if (column.paths.size() < 2) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{column.column};
+    std::vector<std::string> names;
+    for (size_t i = 0; i < column.paths.size(); ++i) {
+      inputs.push_back(std::make_shared<const core::ConstantTypedExpr>(VARCHAR(), variant(column.paths[i])));
+      names.push_back(fmt::format("p{}", i));
+    }
+    auto type = ROW(std::move(names), std::vector<TypePtr>(column.paths.size(), VARCHAR()));
+    // The same instance in all the rewritten expressions, so that it is evaluated once per batch.
+    column.sharedCall = std::make_shared<const core::CallTypedExpr>(type, std::move(inputs), kGetJsonObjects);
+    shared = true;
+  }
+  if (!shared) {
+    return expressions;
+  }
+
+  auto replace = [&](const core::TypedExprPtr& expr) -> core::TypedExprPtr {
+    auto extraction = matchExtraction(expr);
+    if (!extraction) {
+      return nullptr;
+    }
+    const auto& column = columns.at(extraction->column->toString());
+    if (!column.sharedCall) {
+      return nullptr;
+    }
+    auto index = std::find(column.paths.begin(), column.paths.end(), extraction->path) - column.paths.begin();
+    return std::make_shared<const core::DereferenceTypedExpr>(VARCHAR(), column.sharedCall, index);
+  };
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(expressions.size());
+  for (const auto& expr : expressions) {
+    rewritten.push_back(transform(expr, replace));
+  }
+  return rewritten;
+}
+
+void registerJsonExtractionFunctions() {
+  exec::registerVectorFunction(
+      kGetJsonObjects,
+      std::vector<std::shared_ptr<exec::FunctionSignature>>{},
+      std::make_unique<GetJsonObjectsFunction>());
+}
+
+} // namespace gluten
@@ -0,0 +1,45 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "velox/core/Expressions.h"
+
+namespace gluten {
+
+/// Shared extraction of JSON fields. Queries over JSON log columns typically extract several fields of the same
+/// column, e.g. get_json_object(c, '$.user.id'), get_json_object(c, '$.event') or json_tuple(c, 'a', 'b'), which Spark
+/// plans as one get_json_object per field. Each of them copies and parses the whole document of every row again.
+///
+/// When a projection extracts two or more distinct constant paths of the same input column, the calls are rewritten
+/// into field accesses of one gluten_get_json_objects(c, path...) call, which Velox evaluates once as a common
+/// subexpression. It indexes each document once with simdjson's on-demand parser and walks it lazily for every path,
+/// skipping the values no path goes through, and gives the same results as get_json_object.
+///
+/// Only paths of the form $.field.field[index] are rewritten. Others, e.g. with wildcards or quoted names, keep
+/// get_json_object.
+
+/// Returns the expressions with the get_json_object calls on shared columns rewritten as above. They are returned
+/// unchanged if there is nothing to share.
+std::vector<facebook::velox::core::TypedExprPtr> rewriteJsonExtractions(
+    const std::vector<facebook::velox::core::TypedExprPtr>& expressions);
+
+void registerJsonExtractionFunctions();
+
+} // namespace gluten
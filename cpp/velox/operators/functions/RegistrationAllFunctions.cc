@@ -17,8 +17,12 @@
 #include "operators/functions/RegistrationAllFunctions.h"
 
 #include "operators/functions/Arithmetic.h"
+#include "operators/functions/HigherOrderFunctions.h"
+#include "operators/functions/JsonExtraction.h"
 #include "operators/functions/RowConstructorWithNull.h"
 #include "operators/functions/RowFunctionWithNull.h"
+#include "operators/functions/StringFunctions.h"
+#include "operators/functions/TimeZoneConversion.h"
 #include "velox/expression/SpecialFormRegistry.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/CheckedArithmetic.h"
@@ -56,6 +60,14 @@ void registerFunctionOverwrite() {
   velox::registerFunction<RoundFunction, double, double, int32_t>({"round"});
   velox::registerFunction<RoundFunction, float, float, int32_t>({"round"});
 
+  velox::registerFunction<InstrFunction, int32_t, velox::Varchar, velox::Varchar>({"instr"});
+  velox::registerFunction<LocateFunction, int32_t, velox::Varchar, velox::Varchar, int32_t>({"locate"});
+  velox::registerFunction<LengthFunction, int32_t, velox::Varchar>({"length"});
+  velox::registerFunction<SubstringFunction, velox::Varchar, velox::Varchar, int32_t>({"substring"});
+  velox::registerFunction<SubstringFunction, velox::Varchar, velox::Varchar, int32_t, int32_t>({"substring"});
+  velox::registerFunction<UpperFunction, velox::Varchar, velox::Varchar>({"upper"});
+  velox::registerFunction<LowerFunction, velox::Varchar, velox::Varchar>({"lower"});
+
   auto kRowConstructorWithNull = RowConstructorWithNullCallToSpecialForm::kRowConstructorWithNull;
   velox::exec::registerVectorFunction(
       kRowConstructorWithNull,
@@ -75,6 +87,18 @@ void registerFunctionOverwrite() {
       kRowConstructorWithAllNull,
       std::make_unique<RowConstructorWithNullCallToSpecialForm>(kRowConstructorWithAllNull));
 
+  velox::exec::registerVectorFunction(
+      "from_utc_timestamp",
+      TimeZoneConversionFunction</*fromUtc=*/true>::signatures(),
+      std::make_unique<TimeZoneConversionFunction</*fromUtc=*/true>>());
+  velox::exec::registerVectorFunction(
+      "to_utc_timestamp",
+      TimeZoneConversionFunction</*fromUtc=*/false>::signatures(),
+      std::make_unique<TimeZoneConversionFunction</*fromUtc=*/false>>());
+
+  registerHigherOrderFunctions();
+  registerJsonExtractionFunctions();
+
   velox::functions::registerPrestoVectorFunctions();
 }
 
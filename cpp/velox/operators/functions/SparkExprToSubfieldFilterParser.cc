@@ -16,34 +16,185 @@
  */
 #include "operators/functions/SparkExprToSubfieldFilterParser.h"
 
+#include "velox/vector/VariantToVector.h"
+
 namespace gluten {
 
 using namespace facebook::velox;
 
+namespace {
+
+std::optional<std::string> toConstantString(const core::TypedExprPtr& expr) {
+  auto* constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || !constant->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    const auto& valueVector = constant->valueVector();
+    if (valueVector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    return valueVector->as<SimpleVector<StringView>>()->valueAt(0).str();
+  }
+  if (constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+// Collects the operands of nested 'or' calls.
+void collectDisjuncts(const core::TypedExprPtr& expr, std::vector<core::TypedExprPtr>& disjuncts) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      collectDisjuncts(input, disjuncts);
+    }
+    return;
+  }
+  disjuncts.push_back(expr);
+}
+
+// The types whose 'in' lists are pushed down as BigintValues or BytesValues. Decimals and dates share the physical
+// kinds but not the types.
+bool isInListType(const TypePtr& type) {
+  return *type == *TINYINT() || *type == *SMALLINT() || *type == *INTEGER() || *type == *BIGINT() ||
+      *type == *VARCHAR();
+}
+
+// Returns 'column in (constants)' if every disjunct is 'column = constant' on the same column, nullptr otherwise.
+core::TypedExprPtr toInCall(const core::CallTypedExpr& orCall, memory::MemoryPool* pool) {
+  std::vector<core::TypedExprPtr> disjuncts;
+  collectDisjuncts(orCall.inputs()[0], disjuncts);
+  for (size_t i = 1; i < orCall.inputs().size(); ++i) {
+    collectDisjuncts(orCall.inputs()[i], disjuncts);
+  }
+
+  core::TypedExprPtr column;
+  std::vector<variant> values;
+  for (const auto& disjunct : disjuncts) {
+    auto* equality = dynamic_cast<const core::CallTypedExpr*>(disjunct.get());
+    if (equality == nullptr || equality->name() != "equalto" || equality->inputs().size() != 2) {
+      return nullptr;
+    }
+    const auto& left = equality->inputs()[0];
+    auto* constant = dynamic_cast<const core::ConstantTypedExpr*>(equality->inputs()[1].get());
+    if (constant == nullptr || constant->hasValueVector() || constant->value().isNull() ||
+        dynamic_cast<const core::ConstantTypedExpr*>(left.get()) != nullptr || !isInListType(left->type()) ||
+        !(*constant->type() == *left->type())) {
+      return nullptr;
+    }
+    if (column == nullptr) {
+      column = left;
+    } else if (!(*column == *left)) {
+      return nullptr;
+    }
+    values.push_back(constant->value());
+  }
+  if (values.size() < 2) {
+    return nullptr;
+  }
+
+  auto list = BaseVector::wrapInConstant(
+      1, 0, core::variantArrayToVector(ARRAY(column->type()), variant::array(values).array(), pool));
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(),
+      std::vector<core::TypedExprPtr>{column, std::make_shared<core::ConstantTypedExpr>(list)},
+      "in");
+}
+
+} // namespace
+
+core::TypedExprPtr rewriteEqualityDisjunctions(const core::TypedExprPtr& filter, memory::MemoryPool* pool) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(filter.get());
+  if (call == nullptr || call->inputs().empty()) {
+    return filter;
+  }
+  if (call->name() == "or") {
+    auto in = toInCall(*call, pool);
+    return in != nullptr ? in : filter;
+  }
+  if (call->name() != "and") {
+    return filter;
+  }
+  bool rewritten = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(call->inputs().size());
+  for (const auto& input : call->inputs()) {
+    inputs.push_back(rewriteEqualityDisjunctions(input, pool));
+    rewritten |= inputs.back() != input;
+  }
+  return rewritten ? std::make_shared<core::CallTypedExpr>(call->type(), std::move(inputs), call->name()) : filter;
+}
+
 bool SparkExprToSubfieldFilterParser::toSparkSubfield(const core::ITypedExpr* field, common::Subfield& subfield) {
   std::vector<std::unique_ptr<common::Subfield::PathElement>> path;
   for (auto* current = field;;) {
     if (auto* fieldAccess = dynamic_cast<const core::FieldAccessTypedExpr*>(current)) {
       path.push_back(std::make_unique<common::Subfield::NestedField>(fieldAccess->name()));
-    } else if (dynamic_cast<const core::DereferenceTypedExpr*>(current)) {
-      return false;
+    } else if (auto* dereference = dynamic_cast<const core::DereferenceTypedExpr*>(current)) {
+      const auto& name = dereference->name();
+      // When the field name is empty string, it typically means that the field name was not set in the parent type.
+      if (name.empty()) {
+        return false;
+      }
+      path.push_back(std::make_unique<common::Subfield::NestedField>(name));
     } else if (dynamic_cast<const core::InputTypedExpr*>(current) == nullptr) {
       return false;
     } else {
       break;
     }
 
-    if (!current->inputs().empty()) {
-      return false;
-    } else {
+    if (current->inputs().empty()) {
       break;
     }
+    if (current->inputs().size() != 1) {
+      return false;
+    }
+    current = current->inputs()[0].get();
+    if (current == nullptr) {
+      return false;
+    }
   }
   std::reverse(path.begin(), path.end());
   subfield = common::Subfield(std::move(path));
   return true;
 }
 
+std::unique_ptr<common::Filter> SparkExprToSubfieldFilterParser::makePrefixFilter(
+    const core::TypedExprPtr& prefixExpr,
+    bool isLikePattern) {
+  auto constantPrefix = toConstantString(prefixExpr);
+  if (!constantPrefix.has_value()) {
+    return nullptr;
+  }
+  std::string prefix = std::move(constantPrefix.value());
+  if (isLikePattern) {
+    // Only 'prefix%' without any other wildcard or escape character in the prefix is a plain prefix match.
+    if (prefix.empty() || prefix.back() != '%') {
+      return nullptr;
+    }
+    prefix.pop_back();
+    if (prefix.find_first_of("%_\\") != std::string::npos) {
+      return nullptr;
+    }
+  }
+  if (prefix.empty()) {
+    return nullptr;
+  }
+
+  // Spark and Velox compare strings as unsigned bytes, so all strings starting with 'prefix' lie in
+  // [prefix, upper) where upper is 'prefix' with the trailing 0xFF bytes dropped and the last byte incremented.
+  std::string upper = prefix;
+  while (!upper.empty() && static_cast<uint8_t>(upper.back()) == 0xFF) {
+    upper.pop_back();
+  }
+  if (upper.empty()) {
+    return std::make_unique<common::BytesRange>(prefix, false, false, "", true, false, false);
+  }
+  upper.back() = static_cast<char>(static_cast<uint8_t>(upper.back()) + 1);
+  return std::make_unique<common::BytesRange>(prefix, false, false, upper, false, true, false);
+}
+
 std::unique_ptr<common::Filter> SparkExprToSubfieldFilterParser::leafCallToSubfieldFilter(
     const core::CallTypedExpr& call,
     common::Subfield& subfield,
@@ -79,6 +230,16 @@ std::unique_ptr<common::Filter> SparkExprToSubfieldFilterParser::leafCallToSubfi
       return negated ? makeLessThanOrEqualFilter(call.inputs()[1], evaluator)
                      : makeGreaterThanFilter(call.inputs()[1], evaluator);
     }
+  } else if (call.name() == "between") {
+    if (call.inputs().size() == 3 && toSparkSubfield(leftSide, subfield)) {
+      return makeBetweenFilter(call.inputs()[1], call.inputs()[2], evaluator, negated);
+    }
+  } else if (call.name() == "startswith" || call.name() == "like") {
+    // The negation of a prefix match is not a single range, leave it to the remaining filter. A 'like' with a custom
+    // escape character is not pushed down either.
+    if (!negated && call.inputs().size() == 2 && toSparkSubfield(leftSide, subfield)) {
+      return makePrefixFilter(call.inputs()[1], call.name() == "like");
+    }
   } else if (call.name() == "in") {
     if (toSparkSubfield(leftSide, subfield)) {
       return makeInFilter(call.inputs()[1], evaluator, negated);
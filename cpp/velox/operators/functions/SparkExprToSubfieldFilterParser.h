@@ -21,7 +21,8 @@ namespace gluten {
 /// Parses Spark expression into subfield filter. Differences from Presto's parser include:
 /// 1) Some Spark functions are registered under different names.
 /// 2) The supported functions vary.
-/// 3) Filter push-down on nested fields is disabled.
+/// 3) Nested struct fields are supported, map and array subscripts are not.
+/// 4) Prefix matches, i.e., startswith and like 'prefix%', are pushed down as byte ranges.
 class SparkExprToSubfieldFilterParser : public facebook::velox::exec::ExprToSubfieldFilterParser {
  public:
   std::unique_ptr<facebook::velox::common::Filter> leafCallToSubfieldFilter(
@@ -31,8 +32,25 @@ class SparkExprToSubfieldFilterParser : public facebook::velox::exec::ExprToSubf
       bool negated) override;
 
  private:
-  // Compared to the upstream 'toSubfield', the push-down of filter on nested field is disabled.
+  // Compared to the upstream 'toSubfield', only struct field accesses are supported in the path. Subscripts into maps
+  // and arrays are rejected since the Parquet reader can't apply filters on them.
   bool toSparkSubfield(const facebook::velox::core::ITypedExpr* field, facebook::velox::common::Subfield& subfield);
+
+  // Returns the range [prefix, prefix') where prefix' is the smallest string greater than all strings starting with
+  // 'prefix', or nullptr if the prefix is not a constant.
+  std::unique_ptr<facebook::velox::common::Filter> makePrefixFilter(
+      const facebook::velox::core::TypedExprPtr& prefixExpr,
+      bool isLikePattern);
 };
 
+/// Rewrites disjunctions of equalities between one column and constants, e.g. a = 'x' OR a = 'y' OR a = 'z', anywhere
+/// in the conjunction 'filter' into a IN ('x', 'y', 'z'). Velox pushes an 'or' down as a MultiRange of one filter per
+/// disjunct, which tests every disjunct in turn, while 'in' becomes a single hash or bitmask lookup. On a dictionary
+/// encoded column the reader evaluates the pushed filter once per dictionary entry and selects the rows by their
+/// dictionary indices, so the filter is cheap however many rows share the values. The rewrite keeps the semantics:
+/// both forms are null on a null input and false otherwise when no constant matches.
+facebook::velox::core::TypedExprPtr rewriteEqualityDisjunctions(
+    const facebook::velox::core::TypedExprPtr& filter,
+    facebook::velox::memory::MemoryPool* pool);
+
 } // namespace gluten
@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/CPortability.h>
+
+#include <limits>
+
+#include "utils/SparkStringKernels.h"
+#include "velox/functions/Macros.h"
+#include "velox/functions/lib/string/StringImpl.h"
+
+namespace gluten {
+
+namespace detail {
+template <typename TString>
+FOLLY_ALWAYS_INLINE std::string_view toView(const TString& str) {
+  return std::string_view(str.data(), str.size());
+}
+} // namespace detail
+
+/// instr(str, substr): the 1-based character position of the first occurrence of substr in str, or 0.
+template <typename T>
+struct InstrFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void call(int32_t& result, const arg_type<Varchar>& str, const arg_type<Varchar>& substr) {
+    result = sparkstring::indexOf(detail::toView(str), detail::toView(substr), 0) + 1;
+  }
+
+  FOLLY_ALWAYS_INLINE void callAscii(int32_t& result, const arg_type<Varchar>& str, const arg_type<Varchar>& substr) {
+    // Byte positions are character positions.
+    auto pos = sparkstring::find(detail::toView(str), detail::toView(substr));
+    result = pos == std::string_view::npos ? 0 : pos + 1;
+  }
+};
+
+/// locate(substr, str, start): the 1-based character position of the first occurrence of substr in str at or after
+/// character start, or 0. A null start, or one less than 1, results in 0.
+template <typename T>
+struct LocateFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE bool callNullable(
+      int32_t& result,
+      const arg_type<Varchar>* substr,
+      const arg_type<Varchar>* str,
+      const int32_t* start) {
+    if (start == nullptr) {
+      result = 0;
+      return true;
+    }
+    if (substr == nullptr || str == nullptr) {
+      return false;
+    }
+    result = *start < 1 ? 0 : sparkstring::indexOf(detail::toView(*str), detail::toView(*substr), *start - 1) + 1;
+    return true;
+  }
+};
+
+/// length(str): the number of characters, where a character of invalid UTF-8 is as long as its first byte says.
+template <typename T>
+struct LengthFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void call(int32_t& result, const arg_type<Varchar>& str) {
+    result = sparkstring::numChars(str.data(), str.size());
+  }
+
+  FOLLY_ALWAYS_INLINE void callAscii(int32_t& result, const arg_type<Varchar>& str) {
+    result = str.size();
+  }
+};
+
+/// substring(str, pos[, len]) with 1-based character positions. The result refers to the input string.
+template <typename T>
+struct SubstringFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static constexpr int32_t reuse_strings_from_arg = 0;
+
+  FOLLY_ALWAYS_INLINE void call(out_type<Varchar>& result, const arg_type<Varchar>& str, int32_t pos) {
+    call(result, str, pos, std::numeric_limits<int32_t>::max());
+  }
+
+  FOLLY_ALWAYS_INLINE void call(out_type<Varchar>& result, const arg_type<Varchar>& str, int32_t pos, int32_t length) {
+    auto substr = sparkstring::substring(detail::toView(str), pos, length);
+    result.setNoCopy(facebook::velox::StringView(substr.data(), substr.size()));
+  }
+
+  FOLLY_ALWAYS_INLINE void callAscii(out_type<Varchar>& result, const arg_type<Varchar>& str, int32_t pos) {
+    callAscii(result, str, pos, std::numeric_limits<int32_t>::max());
+  }
+
+  FOLLY_ALWAYS_INLINE void callAscii(
+      out_type<Varchar>& result,
+      const arg_type<Varchar>& str,
+      int32_t pos,
+      int32_t length) {
+    auto substr = sparkstring::substring</*knownAscii=*/true>(detail::toView(str), pos, length);
+    result.setNoCopy(facebook::velox::StringView(substr.data(), substr.size()));
+  }
+};
+
+/// upper(str) and lower(str). ASCII strings are mapped 16 bytes at a time by the kernels, other strings go through
+/// Velox's Unicode case mapping.
+template <typename T, bool upper>
+struct CaseMappingFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static constexpr bool is_default_ascii_behavior = true;
+
+  FOLLY_ALWAYS_INLINE void call(out_type<Varchar>& result, const arg_type<Varchar>& str) {
+    if constexpr (upper) {
+      facebook::velox::functions::stringImpl::upper</*ascii=*/false>(result, str);
+    } else {
+      facebook::velox::functions::stringImpl::lower</*ascii=*/false>(result, str);
+    }
+  }
+
+  FOLLY_ALWAYS_INLINE void callAscii(out_type<Varchar>& result, const arg_type<Varchar>& str) {
+    result.resize(str.size());
+    if constexpr (upper) {
+      sparkstring::toUpperAscii(str.data(), str.size(), result.data());
+    } else {
+      sparkstring::toLowerAscii(str.data(), str.size(), result.data());
+    }
+  }
+};
+
+template <typename T>
+using UpperFunction = CaseMappingFunction<T, true>;
+
+template <typename T>
+using LowerFunction = CaseMappingFunction<T, false>;
+
+} // namespace gluten
@@ -0,0 +1,202 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "operators/functions/TimeZoneConversion.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "velox/expression/DecodedArgs.h"
+#include "velox/type/Timestamp.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+constexpr int64_t kSecondsPerDay = 86'400;
+// Within the years supported by the time zone database.
+constexpr int64_t kMinSupportedSeconds = -(1L << 39);
+constexpr int64_t kMaxSupportedSeconds = 1L << 39;
+// Up to this many transitions, a value's offset is looked up by comparing it with every transition, which is
+// branch-free and vectorizes well.
+constexpr size_t kMaxLinearLookupTransitions = 8;
+} // namespace
+
+std::optional<TimeZoneOffsetTable>
+TimeZoneOffsetTable::make(const tz::TimeZone& zone, int64_t minSeconds, int64_t maxSeconds) {
+  // Local times are at most a day away from UTC.
+  minSeconds -= kSecondsPerDay;
+  maxSeconds += kSecondsPerDay;
+  if (minSeconds < kMinSupportedSeconds || maxSeconds > kMaxSupportedSeconds) {
+    return std::nullopt;
+  }
+
+  TimeZoneOffsetTable table;
+  if (zone.tz() == nullptr) {
+    // Fixed offset.
+    table.offsets_.push_back(std::chrono::seconds(zone.offset()).count());
+    return table;
+  }
+
+  auto info = zone.tz()->get_info(date::sys_seconds(std::chrono::seconds(minSeconds)));
+  table.offsets_.push_back(info.offset.count());
+  while (info.end.time_since_epoch().count() <= maxSeconds) {
+    if (table.utcTransitions_.size() == kMaxTransitions) {
+      return std::nullopt;
+    }
+    auto transition = info.end.time_since_epoch().count();
+    info = zone.tz()->get_info(info.end);
+    auto before = table.offsets_.back();
+    auto after = info.offset.count();
+    table.utcTransitions_.push_back(transition);
+    // The local times in [transition + after, transition + before) are ambiguous when the clocks go back, and the
+    // ones in [transition + before, transition + after) don't exist when they go forward. Both keep the offset from
+    // before the transition.
+    table.localTransitions_.push_back(transition + std::max(before, after));
+    table.offsets_.push_back(after);
+  }
+  return table;
+}
+
+void TimeZoneOffsetTable::fromUtc(const int64_t* in, int64_t* out, size_t size) const {
+  convert(utcTransitions_, 1, in, out, size);
+}
+
+void TimeZoneOffsetTable::toUtc(const int64_t* in, int64_t* out, size_t size) const {
+  convert(localTransitions_, -1, in, out, size);
+}
+
+void TimeZoneOffsetTable::convert(
+    const std::vector<int64_t>& transitions,
+    int32_t sign,
+    const int64_t* in,
+    int64_t* out,
+    size_t size) const {
+  const auto* offsets = offsets_.data();
+  if (transitions.empty()) {
+    const auto delta = sign * offsets[0];
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = in[i] + delta;
+    }
+    return;
+  }
+  if (transitions.size() <= kMaxLinearLookupTransitions) {
+    const auto* begin = transitions.data();
+    const auto numTransitions = transitions.size();
+    for (size_t i = 0; i < size; ++i) {
+      size_t index = 0;
+      for (size_t t = 0; t < numTransitions; ++t) {
+        index += in[i] >= begin[t];
+      }
+      out[i] = in[i] + sign * offsets[index];
+    }
+    return;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    auto index = std::upper_bound(transitions.begin(), transitions.end(), in[i]) - transitions.begin();
+    out[i] = in[i] + sign * offsets[index];
+  }
+}
+
+template <bool fromUtc>
+void TimeZoneConversionFunction<fromUtc>::apply(
+    const SelectivityVector& rows,
+    std::vector<VectorPtr>& args,
+    const TypePtr& outputType,
+    exec::EvalCtx& context,
+    VectorPtr& result) const {
+  exec::DecodedArgs decodedArgs(rows, args, context);
+  auto* timestamps = decodedArgs.at(0);
+  auto* zones = decodedArgs.at(1);
+  context.ensureWritable(rows, outputType, result);
+  auto* rawResult = result->asFlatVector<Timestamp>()->mutableRawValues();
+
+  auto convert = [](const TimeZoneOffsetTable& table, const int64_t* in, int64_t* out, size_t size) {
+    if constexpr (fromUtc) {
+      table.fromUtc(in, out, size);
+    } else {
+      table.toUtc(in, out, size);
+    }
+  };
+
+  if (!zones->isConstantMapping()) {
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      const auto* zone = tz::locateZone(std::string_view(zones->valueAt<StringView>(row)));
+      const auto timestamp = timestamps->valueAt<Timestamp>(row);
+      const auto seconds = timestamp.getSeconds();
+      auto table = TimeZoneOffsetTable::make(*zone, seconds, seconds);
+      VELOX_USER_CHECK(table.has_value(), "Timestamp {} is out of range", timestamp.toString());
+      int64_t converted;
+      convert(*table, &seconds, &converted, 1);
+      rawResult[row] = Timestamp(converted, timestamp.getNanos());
+    });
+    return;
+  }
+
+  if (!rows.hasSelections()) {
+    return;
+  }
+  const auto* zone = tz::locateZone(std::string_view(zones->valueAt<StringView>(rows.begin())));
+
+  // Gather the seconds of the selected rows, convert them in one pass and scatter them back.
+  std::vector<int64_t> seconds;
+  seconds.reserve(rows.countSelected());
+  auto minSeconds = std::numeric_limits<int64_t>::max();
+  auto maxSeconds = std::numeric_limits<int64_t>::min();
+  rows.applyToSelected([&](auto row) {
+    auto value = timestamps->valueAt<Timestamp>(row).getSeconds();
+    minSeconds = std::min(minSeconds, value);
+    maxSeconds = std::max(maxSeconds, value);
+    seconds.push_back(value);
+  });
+
+  auto table = TimeZoneOffsetTable::make(*zone, minSeconds, maxSeconds);
+  if (table.has_value()) {
+    convert(*table, seconds.data(), seconds.data(), seconds.size());
+    size_t i = 0;
+    rows.applyToSelected(
+        [&](auto row) { rawResult[row] = Timestamp(seconds[i++], timestamps->valueAt<Timestamp>(row).getNanos()); });
+    return;
+  }
+
+  // The batch spans too many transitions or is out of range, convert value by value.
+  size_t i = 0;
+  context.applyToSelectedNoThrow(rows, [&](auto row) {
+    const auto timestamp = timestamps->valueAt<Timestamp>(row);
+    const auto value = seconds[i++];
+    auto rowTable = TimeZoneOffsetTable::make(*zone, value, value);
+    VELOX_USER_CHECK(rowTable.has_value(), "Timestamp {} is out of range", timestamp.toString());
+    int64_t converted;
+    convert(*rowTable, &value, &converted, 1);
+    rawResult[row] = Timestamp(converted, timestamp.getNanos());
+  });
+}
+
+template <bool fromUtc>
+std::vector<std::shared_ptr<exec::FunctionSignature>> TimeZoneConversionFunction<fromUtc>::signatures() {
+  return {exec::FunctionSignatureBuilder()
+              .returnType("timestamp")
+              .argumentType("timestamp")
+              .argumentType("varchar")
+              .build()};
+}
+
+template class TimeZoneConversionFunction<true>;
+template class TimeZoneConversionFunction<false>;
+
+} // namespace gluten
@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "velox/expression/VectorFunction.h"
+#include "velox/type/tz/TimeZoneMap.h"
+
+namespace gluten {
+
+/// The offsets of a time zone over a range of time, precomputed from the zone's transitions so that a whole column can
+/// be converted without a time zone lookup per value.
+class TimeZoneOffsetTable {
+ public:
+  /// Returns the table covering the UTC and local seconds in [minSeconds, maxSeconds], or std::nullopt if the range is
+  /// outside of what the time zone database supports or spans more than kMaxTransitions transitions.
+  static std::optional<TimeZoneOffsetTable>
+  make(const facebook::velox::tz::TimeZone& zone, int64_t minSeconds, int64_t maxSeconds);
+
+  static constexpr size_t kMaxTransitions = 4096;
+
+  /// Converts UTC seconds to local seconds, in place or not.
+  void fromUtc(const int64_t* in, int64_t* out, size_t size) const;
+
+  /// Converts local seconds to UTC seconds, in place or not. Follows Spark, i.e. java.time: an ambiguous local time
+  /// uses the earlier offset, and a local time in a gap uses the offset before the gap.
+  void toUtc(const int64_t* in, int64_t* out, size_t size) const;
+
+  size_t numTransitions() const {
+    return utcTransitions_.size();
+  }
+
+ private:
+  TimeZoneOffsetTable() = default;
+
+  void convert(const std::vector<int64_t>& transitions, int32_t sign, const int64_t* in, int64_t* out, size_t size)
+      const;
+
+  // offsets_[i + 1] applies from UTC seconds utcTransitions_[i], or local seconds localTransitions_[i].
+  std::vector<int64_t> utcTransitions_;
+  std::vector<int64_t> localTransitions_;
+  std::vector<int64_t> offsets_;
+};
+
+/// from_utc_timestamp and to_utc_timestamp. With a constant time zone, the whole batch is converted with one offset
+/// table built for the batch's range.
+template <bool fromUtc>
+class TimeZoneConversionFunction final : public facebook::velox::exec::VectorFunction {
+ public:
+  void apply(
+      const facebook::velox::SelectivityVector& rows,
+      std::vector<facebook::velox::VectorPtr>& args,
+      const facebook::velox::TypePtr& outputType,
+      facebook::velox::exec::EvalCtx& context,
+      facebook::velox::VectorPtr& result) const override;
+
+  static std::vector<std::shared_ptr<facebook::velox::exec::FunctionSignature>> signatures();
+};
+
+} // namespace gluten
@@ -39,6 +39,110 @@ std::unique_ptr<ByteInputStream> toByteStream(uint8_t* data, int32_t size) {
   return byteStream;
 }
 
+// Presto pages carry 32-bit sizes in their header. Batches are grouped into pages no larger than this.
+constexpr int64_t kMaxSerializedPageSize = 1L << 30;
+
+// Writes into a list of fixed-size off-heap buffers. Seeking backwards is supported since the Presto serializer
+// patches the page header after writing the page body.
+class ChunkedBufferOutputStream final : public OutputStream {
+ public:
+  ChunkedBufferOutputStream(arrow::MemoryPool* pool, int64_t chunkSize, OutputStreamListener* listener = nullptr)
+      : OutputStream(listener), pool_(pool), chunkSize_(chunkSize) {
+    GLUTEN_CHECK(chunkSize_ > 0, "Chunk size must be positive, got " + std::to_string(chunkSize_));
+  }
+
+  void write(const char* s, std::streamsize count) override {
+    if (listener_) {
+      listener_->onWrite(s, count);
+    }
+    while (count > 0) {
+      auto chunkIndex = position_ / chunkSize_;
+      auto offset = position_ % chunkSize_;
+      while (chunkIndex >= static_cast<int64_t>(chunks_.size())) {
+        GLUTEN_ASSIGN_OR_THROW(auto chunk, arrow::AllocateResizableBuffer(chunkSize_, pool_));
+        chunks_.push_back(std::move(chunk));
+      }
+      auto length = std::min<int64_t>(count, chunkSize_ - offset);
+      memcpy(chunks_[chunkIndex]->mutable_data() + offset, s, length);
+      s += length;
+      count -= length;
+      position_ += length;
+      size_ = std::max(size_, position_);
+    }
+  }
+
+  std::streampos tellp() const override {
+    return position_;
+  }
+
+  void seekp(std::streampos pos) override {
+    int64_t target = pos;
+    GLUTEN_CHECK(target >= 0 && target <= size_, "Cannot seek to " + std::to_string(target) + " beyond written data");
+    position_ = target;
+  }
+
+  std::vector<std::shared_ptr<arrow::Buffer>> finish() {
+    std::vector<std::shared_ptr<arrow::Buffer>> result;
+    result.reserve(chunks_.size());
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+      auto length = std::min<int64_t>(chunkSize_, size_ - i * chunkSize_);
+      GLUTEN_THROW_NOT_OK(chunks_[i]->Resize(length, /*shrink_to_fit=*/false));
+      result.push_back(std::move(chunks_[i]));
+    }
+    chunks_.clear();
+    return result;
+  }
+
+ private:
+  arrow::MemoryPool* pool_;
+  const int64_t chunkSize_;
+  std::vector<std::unique_ptr<arrow::ResizableBuffer>> chunks_;
+  int64_t position_{0};
+  int64_t size_{0};
+};
+
+// Deserializes one Presto page per call to next() until the chunk stream is exhausted. Owns its serde and holds the
+// memory pool so that it can outlive the serializer it was created from.
+class ChunkedDeserializeIterator final : public ColumnarBatchIterator {
+ public:
+  ChunkedDeserializeIterator(
+      std::vector<std::pair<uint8_t*, int64_t>> chunks,
+      std::shared_ptr<memory::MemoryPool> veloxPool,
+      RowTypePtr rowType,
+      const serializer::presto::PrestoVectorSerde::PrestoOptions& options)
+      : veloxPool_(std::move(veloxPool)),
+        rowType_(std::move(rowType)),
+        serde_(std::make_unique<serializer::presto::PrestoVectorSerde>()),
+        options_(options) {
+    std::vector<ByteRange> byteRanges;
+    byteRanges.reserve(chunks.size());
+    for (auto& [data, size] : chunks) {
+      if (size > 0) {
+        byteRanges.push_back(ByteRange{data, static_cast<int32_t>(size), 0});
+      }
+    }
+    if (!byteRanges.empty()) {
+      byteStream_ = std::make_unique<BufferInputStream>(std::move(byteRanges));
+    }
+  }
+
+  std::shared_ptr<ColumnarBatch> next() override {
+    if (byteStream_ == nullptr || byteStream_->atEnd()) {
+      return nullptr;
+    }
+    RowVectorPtr result;
+    serde_->deserialize(byteStream_.get(), veloxPool_.get(), rowType_, &result, &options_);
+    return std::make_shared<VeloxColumnarBatch>(result);
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> veloxPool_;
+  RowTypePtr rowType_;
+  std::unique_ptr<serializer::presto::PrestoVectorSerde> serde_;
+  serializer::presto::PrestoVectorSerde::PrestoOptions options_;
+  std::unique_ptr<BufferInputStream> byteStream_;
+};
+
 } // namespace
 
 VeloxColumnarBatchSerializer::VeloxColumnarBatchSerializer(
@@ -91,4 +195,44 @@ std::shared_ptr<ColumnarBatch> VeloxColumnarBatchSerializer::deserialize(uint8_t
   return std::make_shared<VeloxColumnarBatch>(result);
 }
 
+std::vector<std::shared_ptr<arrow::Buffer>> VeloxColumnarBatchSerializer::serializeColumnarBatchesToChunks(
+    const std::vector<std::shared_ptr<ColumnarBatch>>& batches,
+    int64_t chunkSize) {
+  VELOX_DCHECK(batches.size() != 0, "Should serialize at least 1 vector");
+  serializer::presto::PrestoOutputStreamListener listener;
+  ChunkedBufferOutputStream out(arrowPool_, chunkSize, &listener);
+
+  std::unique_ptr<StreamArena> arena;
+  std::unique_ptr<IterativeVectorSerializer> serializer;
+  for (auto& batch : batches) {
+    auto rowVector = VeloxColumnarBatch::from(veloxPool_.get(), batch)->getRowVector();
+    auto numRows = rowVector->size();
+    if (serializer == nullptr) {
+      arena = std::make_unique<StreamArena>(veloxPool_.get());
+      serializer = serde_->createIterativeSerializer(asRowType(rowVector->type()), numRows, arena.get(), &options_);
+    }
+    std::vector<IndexRange> rows(numRows);
+    for (int i = 0; i < numRows; i++) {
+      rows[i] = IndexRange{i, 1};
+    }
+    serializer->append(rowVector, folly::Range(rows.data(), numRows));
+    // Keep each page within the 32-bit sizes of the Presto page header. Pages are flushed back to back into the
+    // chunks, so the chunk size itself is independent of the page size.
+    if (serializer->maxSerializedSize() >= kMaxSerializedPageSize) {
+      serializer->flush(&out);
+      serializer.reset();
+      arena.reset();
+    }
+  }
+  if (serializer != nullptr) {
+    serializer->flush(&out);
+  }
+  return out.finish();
+}
+
+std::unique_ptr<ColumnarBatchIterator> VeloxColumnarBatchSerializer::deserializeChunks(
+    std::vector<std::pair<uint8_t*, int64_t>> chunks) {
+  return std::make_unique<ChunkedDeserializeIterator>(std::move(chunks), veloxPool_, rowType_, options_);
+}
+
 } // namespace gluten
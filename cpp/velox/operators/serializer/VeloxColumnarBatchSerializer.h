@@ -37,6 +37,12 @@ class VeloxColumnarBatchSerializer final : public ColumnarBatchSerializer {
 
   std::shared_ptr<ColumnarBatch> deserialize(uint8_t* data, int32_t size) override;
 
+  std::vector<std::shared_ptr<arrow::Buffer>> serializeColumnarBatchesToChunks(
+      const std::vector<std::shared_ptr<ColumnarBatch>>& batches,
+      int64_t chunkSize) override;
+
+  std::unique_ptr<ColumnarBatchIterator> deserializeChunks(std::vector<std::pair<uint8_t*, int64_t>> chunks) override;
+
  private:
   std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool_;
   facebook::velox::RowTypePtr rowType_;
@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/ShuffleSortKeyEncoder.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+constexpr char kNullsFirst = 0x00;
+constexpr char kNotNull = 0x01;
+constexpr char kNullsLast = 0x02;
+
+template <typename T>
+void appendBigEndian(std::string& out, T value) {
+  static_assert(std::is_unsigned_v<T> || std::is_same_v<T, unsigned __int128>);
+  for (int32_t shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<char>(static_cast<uint8_t>(value >> shift)));
+  }
+}
+
+template <typename T>
+struct UnsignedOf {
+  using type = std::make_unsigned_t<T>;
+};
+
+template <>
+struct UnsignedOf<int128_t> {
+  using type = unsigned __int128;
+};
+
+template <typename T>
+void appendSigned(std::string& out, T value) {
+  using U = typename UnsignedOf<T>::type;
+  constexpr auto kSignBit = static_cast<U>(1) << (sizeof(T) * 8 - 1);
+  appendBigEndian<U>(out, static_cast<U>(value) ^ kSignBit);
+}
+
+template <typename T, typename U>
+void appendFloatingPoint(std::string& out, T value) {
+  // Spark considers -0.0 equal to 0.0, and NaN equal to NaN and greater than any other value.
+  if (std::isnan(value)) {
+    value = std::numeric_limits<T>::quiet_NaN();
+  } else if (value == 0) {
+    value = 0;
+  }
+  U bits;
+  std::memcpy(&bits, &value, sizeof(T));
+  constexpr auto kSignBit = static_cast<U>(1) << (sizeof(T) * 8 - 1);
+  appendBigEndian<U>(out, (bits & kSignBit) ? ~bits : bits | kSignBit);
+}
+
+void appendBytes(std::string& out, const StringView& value) {
+  for (auto i = 0; i < value.size(); ++i) {
+    out.push_back(value.data()[i]);
+    if (value.data()[i] == 0) {
+      out.push_back(static_cast<char>(0xff));
+    }
+  }
+  out.push_back(0);
+  out.push_back(0);
+}
+} // namespace
+
+void ShuffleSortKeyEncoder::encode(const RowVector& rv) {
+  auto numRows = rv.size();
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    VELOX_CHECK_LT(keys_[i].channel, rv.childrenSize(), "Shuffle sort key ordinal out of range.");
+    decoded_[i].decode(*rv.childAt(keys_[i].channel));
+  }
+  encoded_.clear();
+  offsets_.resize(numRows + 1);
+  offsets_[0] = 0;
+  for (auto row = 0; row < numRows; ++row) {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      encodeValue(keys_[i], decoded_[i], row);
+    }
+    offsets_[row + 1] = encoded_.size();
+  }
+}
+
+void ShuffleSortKeyEncoder::encodeValue(const ShuffleSortKey& key, const DecodedVector& decoded, vector_size_t row) {
+  if (decoded.isNullAt(row)) {
+    encoded_.push_back(key.nullsFirst ? kNullsFirst : kNullsLast);
+    return;
+  }
+  encoded_.push_back(kNotNull);
+  auto begin = encoded_.size();
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::BOOLEAN:
+      encoded_.push_back(decoded.valueAt<bool>(row) ? 1 : 0);
+      break;
+    case TypeKind::TINYINT:
+      appendSigned(encoded_, decoded.valueAt<int8_t>(row));
+      break;
+    case TypeKind::SMALLINT:
+      appendSigned(encoded_, decoded.valueAt<int16_t>(row));
+      break;
+    case TypeKind::INTEGER:
+      // Also date.
+      appendSigned(encoded_, decoded.valueAt<int32_t>(row));
+      break;
+    case TypeKind::BIGINT:
+      // Also short decimal, ordered by its unscaled value.
+      appendSigned(encoded_, decoded.valueAt<int64_t>(row));
+      break;
+    case TypeKind::HUGEINT:
+      appendSigned(encoded_, decoded.valueAt<int128_t>(row));
+      break;
+    case TypeKind::REAL:
+      appendFloatingPoint<float, uint32_t>(encoded_, decoded.valueAt<float>(row));
+      break;
+    case TypeKind::DOUBLE:
+      appendFloatingPoint<double, uint64_t>(encoded_, decoded.valueAt<double>(row));
+      break;
+    case TypeKind::TIMESTAMP:
+      appendSigned(encoded_, decoded.valueAt<Timestamp>(row).toMicros());
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      appendBytes(encoded_, decoded.valueAt<StringView>(row));
+      break;
+    default:
+      VELOX_FAIL("Unsupported shuffle sort key type: {}", decoded.base()->type()->toString());
+  }
+  if (!key.ascending) {
+    for (auto i = begin; i < encoded_.size(); ++i) {
+      encoded_[i] = ~encoded_[i];
+    }
+  }
+}
+
+} // namespace gluten
@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "shuffle/Options.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace gluten {
+
+/// Encodes the sort keys of each row of a batch into a binary-comparable string, i.e. comparing the encoded keys of
+/// two rows with memcmp orders them like Spark's SortOrder over the key columns. Supports boolean, integral, floating
+/// point, decimal, date, timestamp, string and binary keys.
+///
+/// Each key is encoded as a null indicator byte followed by the value, unless it's null. Integers are big endian with
+/// the sign bit flipped, floating point values use their IEEE bits with all bits flipped for negative values and the
+/// sign bit flipped otherwise, after normalizing -0.0 and NaN like Spark. Strings escape 0x00 as 0x00 0xff and end with
+/// 0x00 0x00. The value bytes of descending keys are inverted.
+class ShuffleSortKeyEncoder {
+ public:
+  explicit ShuffleSortKeyEncoder(std::vector<ShuffleSortKey> keys) : keys_(std::move(keys)), decoded_(keys_.size()) {}
+
+  /// Encodes the keys of all rows. The result is valid until the next call.
+  void encode(const facebook::velox::RowVector& rv);
+
+  std::string_view key(facebook::velox::vector_size_t row) const {
+    return std::string_view(encoded_.data() + offsets_[row], offsets_[row + 1] - offsets_[row]);
+  }
+
+  int64_t retainedSize() const {
+    return encoded_.capacity() + offsets_.capacity() * sizeof(size_t);
+  }
+
+ private:
+  void encodeValue(
+      const ShuffleSortKey& key,
+      const facebook::velox::DecodedVector& decoded,
+      facebook::velox::vector_size_t row);
+
+  std::vector<ShuffleSortKey> keys_;
+  std::vector<facebook::velox::DecodedVector> decoded_;
+  std::string encoded_;
+  std::vector<size_t> offsets_;
+};
+
+} // namespace gluten
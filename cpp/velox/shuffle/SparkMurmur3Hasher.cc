@@ -0,0 +1,109 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/SparkMurmur3Hasher.h"
+
+#include "utils/SparkHash.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+template <typename T, typename HashFunc>
+void hashValues(const DecodedVector& decoded, vector_size_t numRows, int32_t* hashes, HashFunc hashFunc) {
+  // Null values leave the hash unchanged.
+  if (!decoded.mayHaveNulls()) {
+    for (auto i = 0; i < numRows; ++i) {
+      hashes[i] = hashFunc(decoded.valueAt<T>(i), hashes[i]);
+    }
+  } else {
+    for (auto i = 0; i < numRows; ++i) {
+      if (!decoded.isNullAt(i)) {
+        hashes[i] = hashFunc(decoded.valueAt<T>(i), hashes[i]);
+      }
+    }
+  }
+}
+} // namespace
+
+int32_t SparkMurmur3Hasher::hashInt(int32_t input, int32_t seed) {
+  return sparkhash::murmur3::hashInt(input, seed);
+}
+
+int32_t SparkMurmur3Hasher::hashLong(int64_t input, int32_t seed) {
+  return sparkhash::murmur3::hashLong(input, seed);
+}
+
+int32_t SparkMurmur3Hasher::hashBytes(const char* data, int32_t length, int32_t seed) {
+  return sparkhash::murmur3::hashBytes(data, length, seed);
+}
+
+const int32_t* SparkMurmur3Hasher::hash(const RowVector& rv) {
+  auto numRows = rv.size();
+  hashes_.assign(numRows, kSeed);
+  for (auto key : keys_) {
+    VELOX_CHECK_LT(key, rv.childrenSize(), "Hash partition key ordinal out of range.");
+    hashColumn(*rv.childAt(key), numRows);
+  }
+  return hashes_.data();
+}
+
+void SparkMurmur3Hasher::hashColumn(const BaseVector& column, vector_size_t numRows) {
+  decoded_.decode(column);
+  auto* hashes = hashes_.data();
+  switch (column.typeKind()) {
+    case TypeKind::BOOLEAN:
+      hashValues<bool>(decoded_, numRows, hashes, [](bool v, int32_t h) { return hashInt(v ? 1 : 0, h); });
+      break;
+    case TypeKind::TINYINT:
+      hashValues<int8_t>(decoded_, numRows, hashes, [](int8_t v, int32_t h) { return hashInt(v, h); });
+      break;
+    case TypeKind::SMALLINT:
+      hashValues<int16_t>(decoded_, numRows, hashes, [](int16_t v, int32_t h) { return hashInt(v, h); });
+      break;
+    case TypeKind::INTEGER:
+      // Also date.
+      hashValues<int32_t>(decoded_, numRows, hashes, [](int32_t v, int32_t h) { return hashInt(v, h); });
+      break;
+    case TypeKind::BIGINT:
+      // Also short decimal, which Spark hashes by its unscaled long value.
+      hashValues<int64_t>(decoded_, numRows, hashes, [](int64_t v, int32_t h) { return hashLong(v, h); });
+      break;
+    case TypeKind::REAL:
+      hashValues<float>(
+          decoded_, numRows, hashes, [](float v, int32_t h) { return hashInt(sparkhash::floatToIntBits(v), h); });
+      break;
+    case TypeKind::DOUBLE:
+      hashValues<double>(
+          decoded_, numRows, hashes, [](double v, int32_t h) { return hashLong(sparkhash::doubleToLongBits(v), h); });
+      break;
+    case TypeKind::TIMESTAMP:
+      hashValues<Timestamp>(
+          decoded_, numRows, hashes, [](Timestamp v, int32_t h) { return hashLong(v.toMicros(), h); });
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      hashValues<StringView>(
+          decoded_, numRows, hashes, [](StringView v, int32_t h) { return hashBytes(v.data(), v.size(), h); });
+      break;
+    default:
+      VELOX_FAIL("Unsupported hash partition key type: {}", column.type()->toString());
+  }
+}
+
+} // namespace gluten
@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace gluten {
+
+/// Computes Spark's Murmur3Hash with seed 42 over the partition key columns of a batch, i.e. the value of
+/// `hash(keys...)` that the JVM side would otherwise project as the first column for hash partitioning. Supports the
+/// key types accepted by ExecUtil.fusedHashPartitionKeys: boolean, integral, floating point, short decimal, date,
+/// timestamp, string and binary.
+class SparkMurmur3Hasher {
+ public:
+  static constexpr int32_t kSeed = 42;
+
+  explicit SparkMurmur3Hasher(std::vector<int32_t> keys) : keys_(std::move(keys)) {}
+
+  /// Returns the hash of each row. The result is valid until the next call.
+  const int32_t* hash(const facebook::velox::RowVector& rv);
+
+  static int32_t hashInt(int32_t input, int32_t seed);
+
+  static int32_t hashLong(int64_t input, int32_t seed);
+
+  static int32_t hashBytes(const char* data, int32_t length, int32_t seed);
+
+ private:
+  void hashColumn(const facebook::velox::BaseVector& column, facebook::velox::vector_size_t numRows);
+
+  std::vector<int32_t> keys_;
+  facebook::velox::DecodedVector decoded_;
+  std::vector<int32_t> hashes_;
+};
+
+} // namespace gluten
@@ -0,0 +1,219 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/VeloxAdaptiveShuffleWriter.h"
+
+#include "memory/VeloxColumnarBatch.h"
+
+namespace gluten {
+namespace {
+
+// Above this ratio of the largest partition over the mean of the active ones, the hash writer's buffers for the hot
+// partitions stay well filled even though most partitions only get a few rows per batch.
+constexpr double kMaxSkewForSort = 16.0;
+
+} // namespace
+
+arrow::Result<std::shared_ptr<VeloxShuffleWriter>> VeloxAdaptiveShuffleWriter::create(
+    uint32_t numPartitions,
+    std::unique_ptr<PartitionWriter> partitionWriter,
+    ShuffleWriterOptions options,
+    std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool,
+    arrow::MemoryPool* arrowPool) {
+  std::shared_ptr<VeloxAdaptiveShuffleWriter> writer(new VeloxAdaptiveShuffleWriter(
+      numPartitions, std::move(partitionWriter), std::move(options), std::move(veloxPool), arrowPool));
+  return writer;
+}
+
+VeloxAdaptiveShuffleWriter::VeloxAdaptiveShuffleWriter(
+    uint32_t numPartitions,
+    std::unique_ptr<PartitionWriter> partitionWriter,
+    ShuffleWriterOptions options,
+    std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool,
+    arrow::MemoryPool* pool)
+    : VeloxShuffleWriter(numPartitions, std::move(partitionWriter), std::move(options), std::move(veloxPool), pool),
+      partitionRows_(numPartitions, 0) {}
+
+arrow::Status VeloxAdaptiveShuffleWriter::write(std::shared_ptr<ColumnarBatch> cb, int64_t memLimit) {
+  if (writer_) {
+    return writer_->write(std::move(cb), memLimit);
+  }
+  memLimit_ = memLimit;
+  RETURN_NOT_OK(sample(cb));
+  if (options_.partitioning == Partitioning::kSingle ||
+      static_cast<int32_t>(sampled_.size()) >= options_.adaptiveSampleBatches) {
+    RETURN_NOT_OK(decide());
+  }
+  return arrow::Status::OK();
+}
+
+arrow::Status VeloxAdaptiveShuffleWriter::stop() {
+  if (!writer_) {
+    RETURN_NOT_OK(decide());
+  }
+  RETURN_NOT_OK(writer_->stop());
+  auto decision = metrics_.adaptiveDecision;
+  metrics_ = writer_->metrics();
+  metrics_.adaptiveDecision = std::move(decision);
+  return arrow::Status::OK();
+}
+
+arrow::Status VeloxAdaptiveShuffleWriter::reclaimFixedSize(int64_t size, int64_t* actual) {
+  if (evictState_ == EvictState::kUnevictable) {
+    *actual = 0;
+    return arrow::Status::OK();
+  }
+  if (!writer_) {
+    // The sampled batches can't be spilled. Decide early so that the chosen writer can.
+    RETURN_NOT_OK(decide());
+  }
+  return writer_->reclaimFixedSize(size, actual);
+}
+
+int64_t VeloxAdaptiveShuffleWriter::peakBytesAllocated() const {
+  return writer_ ? writer_->peakBytesAllocated() : VeloxShuffleWriter::peakBytesAllocated();
+}
+
+int64_t VeloxAdaptiveShuffleWriter::totalSortTime() const {
+  return writer_ ? writer_->totalSortTime() : 0;
+}
+
+int64_t VeloxAdaptiveShuffleWriter::totalC2RTime() const {
+  return writer_ ? writer_->totalC2RTime() : 0;
+}
+
+void VeloxAdaptiveShuffleWriter::setPartitionBufferSize(uint32_t newSize) {
+  options_.bufferSize = newSize;
+  if (writer_) {
+    writer_->setPartitionBufferSize(newSize);
+  }
+}
+
+arrow::Status VeloxAdaptiveShuffleWriter::evictPartitionBuffers(uint32_t partitionId, bool reuseBuffers) {
+  return writer_ ? writer_->evictPartitionBuffers(partitionId, reuseBuffers) : arrow::Status::OK();
+}
+
+arrow::Status VeloxAdaptiveShuffleWriter::evictRowVector(uint32_t partitionId) {
+  return writer_ ? writer_->evictRowVector(partitionId) : arrow::Status::OK();
+}
+
+const uint64_t VeloxAdaptiveShuffleWriter::cachedPayloadSize() const {
+  return writer_ ? writer_->cachedPayloadSize() : 0;
+}
+
+arrow::Status VeloxAdaptiveShuffleWriter::sample(const std::shared_ptr<ColumnarBatch>& cb) {
+  auto veloxColumnBatch = VeloxColumnarBatch::from(veloxPool_.get(), cb);
+  VELOX_CHECK_NOT_NULL(veloxColumnBatch);
+  auto rv = veloxColumnBatch->getFlattenedRowVector();
+  auto data = rv;
+  if (partitioner_->hasPid()) {
+    RETURN_NOT_OK(partitioner_->compute(getPartitionKeyHashes(*rv), rv->size(), row2Partition_));
+    data = stripPartitionKeyHashes(rv);
+  } else {
+    RETURN_NOT_OK(partitioner_->compute(nullptr, rv->size(), row2Partition_));
+  }
+  for (auto pid : row2Partition_) {
+    partitionRows_[pid]++;
+  }
+  if (sampled_.empty()) {
+    sortAllowed_ = sortAllowed(*data);
+  }
+  sampledRows_ += rv->size();
+  sampledBytes_ += data->estimateFlatSize();
+  // Keep the converted batch so that it's not converted again when replayed.
+  sampled_.push_back(std::move(veloxColumnBatch));
+  return arrow::Status::OK();
+}
+
+bool VeloxAdaptiveShuffleWriter::sortAllowed(const facebook::velox::RowVector& rv) const {
+  if (options_.partitioning == Partitioning::kSingle) {
+    return false;
+  }
+  // A hash payload has one buffer per column buffer plus one for all complex columns, and a sort payload has a single
+  // buffer. Payloads of a schema with only complex or null columns therefore look the same.
+  for (const auto& child : rv.children()) {
+    if (child->type()->isPrimitiveType() && child->typeKind() != facebook::velox::TypeKind::UNKNOWN) {
+      return true;
+    }
+  }
+  return false;
+}
+
+AdaptiveShuffleWriterDecision VeloxAdaptiveShuffleWriter::makeDecision() const {
+  AdaptiveShuffleWriterDecision decision;
+  decision.sampledRows = sampledRows_;
+  decision.hashBufferRows = options_.bufferSize;
+  if (sampledRows_ == 0) {
+    return decision;
+  }
+
+  decision.avgRowBytes = static_cast<double>(sampledBytes_) / sampledRows_;
+  int64_t maxPartitionRows = 0;
+  for (auto rows : partitionRows_) {
+    if (rows > 0) {
+      decision.activePartitions++;
+      maxPartitionRows = std::max(maxPartitionRows, rows);
+    }
+  }
+  const double meanPartitionRows = static_cast<double>(sampledRows_) / decision.activePartitions;
+  decision.partitionSkew = maxPartitionRows / meanPartitionRows;
+
+  // Mirrors VeloxHashShuffleWriter::calculatePartitionBufferSize.
+  const auto memLimit = std::max(memLimit_, kMinMemLimit);
+  if (decision.avgRowBytes > 0) {
+    decision.hashBufferRows = std::min<int64_t>(
+        static_cast<int64_t>(memLimit / decision.avgRowBytes / numPartitions_) >> 2, options_.bufferSize);
+  }
+
+  if (!sortAllowed_) {
+    return decision;
+  }
+  const double rowsPerPartitionPerBatch = meanPartitionRows / sampled_.size();
+  // With sort keys, only the sort writer's output arrives at the reader in few sorted runs.
+  if (!options_.sortKeys.empty() || decision.hashBufferRows < options_.adaptiveMinHashBufferRows ||
+      (rowsPerPartitionPerBatch < options_.adaptiveMinRowsPerPartition && decision.partitionSkew < kMaxSkewForSort)) {
+    decision.writerType = kSortShuffle;
+  }
+  return decision;
+}
+
+arrow::Status VeloxAdaptiveShuffleWriter::decide() {
+  EvictGuard evictGuard{evictState_};
+
+  const auto decision = makeDecision();
+  metrics_.adaptiveDecision = decision;
+  LOG(INFO) << "Adaptive shuffle writer chose the " << (decision.writerType == kSortShuffle ? "sort" : "hash")
+            << " shuffle writer. sampledRows: " << decision.sampledRows << ", avgRowBytes: " << decision.avgRowBytes
+            << ", activePartitions: " << decision.activePartitions << "/" << numPartitions_
+            << ", partitionSkew: " << decision.partitionSkew << ", hashBufferRows: " << decision.hashBufferRows;
+
+  auto options = options_;
+  options.shuffleWriterType = decision.writerType;
+  ARROW_ASSIGN_OR_RAISE(
+      writer_,
+      VeloxShuffleWriter::create(
+          decision.writerType, numPartitions_, std::move(partitionWriter_), std::move(options), veloxPool_, pool_));
+
+  auto sampled = std::move(sampled_);
+  sampled_.clear();
+  for (auto& batch : sampled) {
+    RETURN_NOT_OK(writer_->write(std::move(batch), memLimit_));
+  }
+  return arrow::Status::OK();
+}
+
+} // namespace gluten
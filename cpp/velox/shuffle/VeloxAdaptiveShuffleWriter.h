@@ -0,0 +1,101 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "shuffle/VeloxShuffleWriter.h"
+
+namespace gluten {
+
+// Picks the hash or the sort shuffle writer at runtime. The first options_.adaptiveSampleBatches input batches are
+// buffered to estimate the row width and how rows spread over the partitions. The chosen writer then takes over the
+// partition writer, replays the buffered batches and receives all further input.
+//
+// The hash writer pre-allocates a buffer per partition, so it degrades to tiny payloads and excessive spilling when
+// there are many partitions or wide rows for the memory available. The sort writer keeps memory independent of the
+// number of partitions but pays for row conversion and sorting, which is wasted on few partitions.
+class VeloxAdaptiveShuffleWriter final : public VeloxShuffleWriter {
+ public:
+  static arrow::Result<std::shared_ptr<VeloxShuffleWriter>> create(
+      uint32_t numPartitions,
+      std::unique_ptr<PartitionWriter> partitionWriter,
+      ShuffleWriterOptions options,
+      std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool,
+      arrow::MemoryPool* arrowPool);
+
+  arrow::Status write(std::shared_ptr<ColumnarBatch> cb, int64_t memLimit) override;
+
+  arrow::Status stop() override;
+
+  arrow::Status reclaimFixedSize(int64_t size, int64_t* actual) override;
+
+  int64_t peakBytesAllocated() const override;
+
+  int64_t totalSortTime() const override;
+
+  int64_t totalC2RTime() const override;
+
+  void setPartitionBufferSize(uint32_t newSize) override;
+
+  arrow::Status evictPartitionBuffers(uint32_t partitionId, bool reuseBuffers) override;
+
+  arrow::Status evictRowVector(uint32_t partitionId) override;
+
+  const uint64_t cachedPayloadSize() const override;
+
+  // The chosen writer, or nullptr while the input is still sampled.
+  const std::shared_ptr<VeloxShuffleWriter>& delegate() const {
+    return writer_;
+  }
+
+ private:
+  VeloxAdaptiveShuffleWriter(
+      uint32_t numPartitions,
+      std::unique_ptr<PartitionWriter> partitionWriter,
+      ShuffleWriterOptions options,
+      std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool,
+      arrow::MemoryPool* pool);
+
+  arrow::Status sample(const std::shared_ptr<ColumnarBatch>& cb);
+
+  // The sort writer's payloads must be distinguishable from the hash writer's by the reader, see
+  // VeloxColumnarBatchDeserializerFactory::createDeserializer.
+  bool sortAllowed(const facebook::velox::RowVector& rv) const;
+
+  AdaptiveShuffleWriterDecision makeDecision() const;
+
+  // Creates the chosen writer and replays the sampled batches into it.
+  arrow::Status decide();
+
+  std::shared_ptr<VeloxShuffleWriter> writer_;
+
+  std::vector<std::shared_ptr<ColumnarBatch>> sampled_;
+
+  std::vector<uint32_t> row2Partition_;
+
+  std::vector<int64_t> partitionRows_;
+
+  int64_t sampledRows_{0};
+
+  int64_t sampledBytes_{0};
+
+  bool sortAllowed_{false};
+
+  int64_t memLimit_{kMinMemLimit};
+};
+
+} // namespace gluten
@@ -310,14 +310,14 @@ arrow::Status VeloxHashShuffleWriter::write(std::shared_ptr<ColumnarBatch> cb, i
 arrow::Status VeloxHashShuffleWriter::partitioningAndDoSplit(facebook::velox::RowVectorPtr rv, int64_t memLimit) {
   std::fill(std::begin(partition2RowCount_), std::end(partition2RowCount_), 0);
   if (partitioner_->hasPid()) {
-    auto pidArr = getFirstColumn(*rv);
     START_TIMING(cpuWallTimingList_[CpuWallTimingCompute]);
+    auto pidArr = getPartitionKeyHashes(*rv);
     RETURN_NOT_OK(partitioner_->compute(pidArr, rv->size(), row2Partition_));
     for (auto& pid : row2Partition_) {
       partition2RowCount_[pid]++;
     }
     END_TIMING();
-    auto strippedRv = getStrippedRowVector(*rv);
+    auto strippedRv = stripPartitionKeyHashes(rv);
     RETURN_NOT_OK(initFromRowVector(*strippedRv));
     RETURN_NOT_OK(doSplit(*strippedRv, memLimit));
   } else {
@@ -96,12 +96,12 @@ arrow::Status VeloxRssSortShuffleWriter::write(std::shared_ptr<ColumnarBatch> cb
     rv = veloxColumnBatch->getFlattenedRowVector();
     END_TIMING();
     if (partitioner_->hasPid()) {
-      auto pidArr = getFirstColumn(*rv);
       START_TIMING(cpuWallTimingList_[CpuWallTimingCompute]);
+      auto pidArr = getPartitionKeyHashes(*rv);
       setSortState(SortState::kSort);
       RETURN_NOT_OK(partitioner_->compute(pidArr, rv->size(), batches_.size(), rowVectorIndexMap_));
       END_TIMING();
-      auto strippedRv = getStrippedRowVector(*rv);
+      auto strippedRv = stripPartitionKeyHashes(rv);
       RETURN_NOT_OK(initFromRowVector(*strippedRv));
       RETURN_NOT_OK(doSort(strippedRv, partitionWriter_.get()->options().sortBufferMaxSize));
     } else {
@@ -44,6 +44,9 @@ namespace gluten {
 
 namespace {
 
+// Payload type, number of rows and number of buffers, see BlockPayload::serialize.
+constexpr int64_t kPayloadHeaderSize = sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint32_t);
+
 struct BufferViewReleaser {
   BufferViewReleaser() : BufferViewReleaser(nullptr) {}
   BufferViewReleaser(std::shared_ptr<arrow::Buffer> arrowBuffer) : bufferReleaser_(std::move(arrowBuffer)) {}
@@ -600,7 +603,13 @@ VeloxColumnarBatchDeserializerFactory::VeloxColumnarBatchDeserializerFactory(
 
 std::unique_ptr<ColumnarBatchIterator> VeloxColumnarBatchDeserializerFactory::createDeserializer(
     std::shared_ptr<arrow::io::InputStream> in) {
-  switch (shuffleWriterType_) {
+  return createDeserializer(shuffleWriterType_, std::move(in));
+}
+
+std::unique_ptr<ColumnarBatchIterator> VeloxColumnarBatchDeserializerFactory::createDeserializer(
+    ShuffleWriterType shuffleWriterType,
+    std::shared_ptr<arrow::io::InputStream> in) {
+  switch (shuffleWriterType) {
     case ShuffleWriterType::kHashShuffle:
       return std::make_unique<VeloxHashShuffleReaderDeserializer>(
           std::move(in),
@@ -630,8 +639,15 @@ std::unique_ptr<ColumnarBatchIterator> VeloxColumnarBatchDeserializerFactory::cr
     case ShuffleWriterType::kRssSortShuffle:
       return std::make_unique<VeloxRssSortShuffleReaderDeserializer>(
           veloxPool_, rowType_, batchSize_, veloxCompressionType_, deserializeTime_, std::move(in));
+    case ShuffleWriterType::kAdaptiveShuffle: {
+      // Only buffer the payload header, the chosen deserializer buffers the stream itself.
+      GLUTEN_ASSIGN_OR_THROW(
+          auto buffered, arrow::io::BufferedInputStream::Create(kPayloadHeaderSize, memoryPool_, std::move(in)));
+      auto type = detectShuffleWriterType(*buffered);
+      return createDeserializer(type, std::move(buffered));
+    }
     default:
-      throw gluten::GlutenException("Unsupported shuffle writer type: " + std::to_string(shuffleWriterType_));
+      throw gluten::GlutenException("Unsupported shuffle writer type: " + std::to_string(shuffleWriterType));
   }
 }
 
@@ -651,6 +667,21 @@ int64_t VeloxColumnarBatchDeserializerFactory::getDeserializeTime() {
   return deserializeTime_;
 }
 
+ShuffleWriterType VeloxColumnarBatchDeserializerFactory::detectShuffleWriterType(
+    arrow::io::BufferedInputStream& in) const {
+  // Every payload starts with its type, number of rows and number of buffers. The hash shuffle writer writes a buffer
+  // per column buffer plus one for all complex columns, the sort shuffle writer a single buffer. The adaptive shuffle
+  // writer never picks the sort shuffle writer for a schema where the two are equal.
+  const auto numHashBuffers = isValidityBuffer_.size() + (hasComplexType_ ? 1 : 0);
+  GLUTEN_ASSIGN_OR_THROW(auto header, in.Peek(kPayloadHeaderSize));
+  if (numHashBuffers == 1 || static_cast<int64_t>(header.size()) < kPayloadHeaderSize) {
+    return ShuffleWriterType::kHashShuffle;
+  }
+  uint32_t numBuffers;
+  memcpy(&numBuffers, header.data() + sizeof(uint8_t) + sizeof(uint32_t), sizeof(uint32_t));
+  return numBuffers == 1 ? ShuffleWriterType::kSortShuffle : ShuffleWriterType::kHashShuffle;
+}
+
 void VeloxColumnarBatchDeserializerFactory::initFromSchema() {
   GLUTEN_ASSIGN_OR_THROW(auto arrowColumnTypes, toShuffleTypeId(schema_->fields()));
   isValidityBuffer_.reserve(arrowColumnTypes.size());
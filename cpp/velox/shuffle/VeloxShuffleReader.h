@@ -25,6 +25,7 @@
 #include "velox/type/Type.h"
 #include "velox/vector/ComplexVector.h"
 
+#include <arrow/io/buffered.h>
 #include <velox/serializers/PrestoSerializer.h>
 
 namespace gluten {
@@ -160,6 +161,13 @@ class VeloxColumnarBatchDeserializerFactory : public DeserializerFactory {
  private:
   void initFromSchema();
 
+  std::unique_ptr<ColumnarBatchIterator> createDeserializer(
+      ShuffleWriterType shuffleWriterType,
+      std::shared_ptr<arrow::io::InputStream> in);
+
+  // Detects whether VeloxAdaptiveShuffleWriter wrote the stream with the hash or the sort shuffle writer.
+  ShuffleWriterType detectShuffleWriterType(arrow::io::BufferedInputStream& in) const;
+
   std::shared_ptr<arrow::Schema> schema_;
   std::shared_ptr<arrow::util::Codec> codec_;
   facebook::velox::common::CompressionKind veloxCompressionType_;
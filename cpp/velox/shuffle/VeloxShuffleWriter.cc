@@ -16,6 +16,7 @@
  */
 
 #include "shuffle/VeloxShuffleWriter.h"
+#include "shuffle/VeloxAdaptiveShuffleWriter.h"
 #include "shuffle/VeloxHashShuffleWriter.h"
 #include "shuffle/VeloxRssSortShuffleWriter.h"
 #include "shuffle/VeloxSortShuffleWriter.h"
@@ -40,6 +41,9 @@ arrow::Result<std::shared_ptr<VeloxShuffleWriter>> VeloxShuffleWriter::create(
     case ShuffleWriterType::kRssSortShuffle:
       return VeloxRssSortShuffleWriter::create(
           numPartitions, std::move(partitionWriter), std::move(options), veloxPool, arrowPool);
+    case ShuffleWriterType::kAdaptiveShuffle:
+      return VeloxAdaptiveShuffleWriter::create(
+          numPartitions, std::move(partitionWriter), std::move(options), veloxPool, arrowPool);
     default:
       return arrow::Status::Invalid("Unsupported shuffle writer type: ", std::to_string(type));
   }
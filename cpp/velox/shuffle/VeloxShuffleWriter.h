@@ -41,6 +41,7 @@
 #include "shuffle/PartitionWriter.h"
 #include "shuffle/Partitioner.h"
 #include "shuffle/ShuffleWriter.h"
+#include "shuffle/SparkMurmur3Hasher.h"
 #include "shuffle/Utils.h"
 
 #include "utils/Print.h"
@@ -89,6 +90,17 @@ class VeloxShuffleWriter : public ShuffleWriter {
     return firstChild->asFlatVector<int32_t>()->rawValues();
   }
 
+  // Returns the partition key hash or pid of each row. With fused hash partitioning, the hash is computed from the
+  // partition key columns, otherwise it's read from the first column.
+  const int32_t* getPartitionKeyHashes(const facebook::velox::RowVector& rv) {
+    return hasher_ ? hasher_->hash(rv) : getFirstColumn(rv);
+  }
+
+  // Returns the columns to write, i.e. all but the first column unless hash partitioning is fused.
+  facebook::velox::RowVectorPtr stripPartitionKeyHashes(const facebook::velox::RowVectorPtr& rv) {
+    return hasher_ ? rv : getStrippedRowVector(*rv);
+  }
+
   // For test only.
   virtual void setPartitionBufferSize(uint32_t newSize) {}
 
@@ -128,6 +140,9 @@ class VeloxShuffleWriter : public ShuffleWriter {
         veloxPool_(std::move(veloxPool)),
         partitionWriter_(std::move(partitionWriter)) {
     partitioner_ = Partitioner::make(options_.partitioning, numPartitions_, options_.startPartitionId);
+    if (options_.partitioning == Partitioning::kHash && !options_.hashPartitionKeys.empty()) {
+      hasher_ = std::make_unique<SparkMurmur3Hasher>(options_.hashPartitionKeys);
+    }
     arenas_.resize(numPartitions);
     serdeOptions_.useLosslessTimestamp = true;
   }
@@ -146,6 +161,9 @@ class VeloxShuffleWriter : public ShuffleWriter {
 
   std::shared_ptr<Partitioner> partitioner_;
 
+  // Set if the hash partitioning is fused into the shuffle writer.
+  std::unique_ptr<SparkMurmur3Hasher> hasher_;
+
   std::vector<std::unique_ptr<facebook::velox::StreamArena>> arenas_;
 
   facebook::velox::serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions_;
@@ -126,6 +126,11 @@ void VeloxSortShuffleWriter::initRowType(const facebook::velox::RowVectorPtr& rv
     if (fixedRowSize_) {
       *fixedRowSize_ += sizeof(RowSizeType);
     }
+    if (!options_.sortKeys.empty()) {
+      // The sort keys may have variable size.
+      fixedRowSize_ = std::nullopt;
+      sortKeyEncoder_ = std::make_unique<ShuffleSortKeyEncoder>(options_.sortKeys);
+    }
   }
 }
 
@@ -151,9 +156,9 @@ arrow::Result<facebook::velox::RowVectorPtr> VeloxSortShuffleWriter::getPeeledRo
     VELOX_CHECK_NOT_NULL(veloxColumnBatch);
     auto rv = veloxColumnBatch->getFlattenedRowVector();
     if (partitioner_->hasPid()) {
-      auto pidArr = getFirstColumn(*rv);
+      auto pidArr = getPartitionKeyHashes(*rv);
       RETURN_NOT_OK(partitioner_->compute(pidArr, rv->size(), row2Partition_));
-      return getStrippedRowVector(*rv);
+      return stripPartitionKeyHashes(rv);
     } else {
       RETURN_NOT_OK(partitioner_->compute(nullptr, rv->size(), row2Partition_));
       return rv;
@@ -167,6 +172,9 @@ arrow::Status VeloxSortShuffleWriter::insert(const facebook::velox::RowVectorPtr
   VELOX_DCHECK_GT(inputRows, 0);
 
   facebook::velox::row::CompactRow row(vector);
+  if (sortKeyEncoder_) {
+    sortKeyEncoder_->encode(*vector);
+  }
 
   if (!fixedRowSize_) {
     rowSize_.resize(inputRows);
@@ -176,6 +184,9 @@ arrow::Status VeloxSortShuffleWriter::insert(const facebook::velox::RowVectorPtr
       auto rowSize = row.rowSize(i) + sizeof(RowSizeType);
       rowSize_[i] = rowSize;
       rowSizePrefixSum_[i + 1] = rowSizePrefixSum_[i] + rowSize;
+      if (sortKeyEncoder_) {
+        rowSizePrefixSum_[i + 1] += sizeof(RowSizeType) + sortKeyEncoder_->key(i).size();
+      }
     }
   } else {
     rowSize_.resize(inputRows, *fixedRowSize_);
@@ -186,7 +197,8 @@ arrow::Status VeloxSortShuffleWriter::insert(const facebook::velox::RowVectorPtr
     auto remainingRows = inputRows - rowOffset;
     auto rows = maxRowsToInsert(rowOffset, remainingRows);
     if (rows == 0) {
-      auto minSizeRequired = fixedRowSize_ ? fixedRowSize_.value() : rowSize_[rowOffset];
+      auto minSizeRequired = fixedRowSize_ ? fixedRowSize_.value()
+                                           : rowSizePrefixSum_[rowOffset + 1] - rowSizePrefixSum_[rowOffset];
       acquireNewBuffer((uint64_t)memLimit, minSizeRequired);
       rows = maxRowsToInsert(rowOffset, remainingRows);
       ARROW_RETURN_IF(
@@ -216,6 +228,13 @@ void VeloxSortShuffleWriter::insertRows(
     memcpy(currentPage_ + pageCursor_, &rowSize_[row], sizeof(RowSizeType));
     offsets[i] = pageCursor_ + sizeof(RowSizeType);
     pageCursor_ += rowSize_[row];
+    if (sortKeyEncoder_) {
+      auto key = sortKeyEncoder_->key(row);
+      RowSizeType keySize = key.size();
+      memcpy(currentPage_ + pageCursor_, &keySize, sizeof(RowSizeType));
+      memcpy(currentPage_ + pageCursor_ + sizeof(RowSizeType), key.data(), keySize);
+      pageCursor_ += sizeof(RowSizeType) + keySize;
+    }
     VELOX_DCHECK_LE(pageCursor_, currenPageSize_);
   }
   compact.serialize(offset, size, offsets.data(), currentPage_);
@@ -238,7 +257,11 @@ arrow::Status VeloxSortShuffleWriter::evictAllPartitions() {
   int32_t begin = 0;
   {
     ScopedTimer timer(&sortTime_);
-    if (options_.useRadixSort) {
+    if (sortKeyEncoder_) {
+      std::sort(arrayPtr_, arrayPtr_ + numRecords, [this](uint64_t lhs, uint64_t rhs) {
+        return sortKeyLessThan(lhs, rhs);
+      });
+    } else if (options_.useRadixSort) {
       begin = RadixSort::sort(arrayPtr_, arraySize_, numRecords, kPartitionIdStartByteIndex, kPartitionIdEndByteIndex);
     } else {
       std::sort(arrayPtr_, arrayPtr_ + numRecords);
@@ -281,6 +304,23 @@ arrow::Status VeloxSortShuffleWriter::evictAllPartitions() {
   return arrow::Status::OK();
 }
 
+std::string_view VeloxSortShuffleWriter::sortKey(uint64_t compactRowId) const {
+  auto pageIndex = extractPageNumberAndOffset(compactRowId);
+  auto* addr = pageAddresses_[pageIndex.first] + pageIndex.second;
+  addr += *(RowSizeType*)addr;
+  return std::string_view(addr + sizeof(RowSizeType), *(RowSizeType*)addr);
+}
+
+bool VeloxSortShuffleWriter::sortKeyLessThan(uint64_t lhs, uint64_t rhs) const {
+  auto lhsPid = extractPartitionId(lhs);
+  auto rhsPid = extractPartitionId(rhs);
+  if (lhsPid != rhsPid) {
+    return lhsPid < rhsPid;
+  }
+  // std::string_view compares bytes as unsigned char.
+  return sortKey(lhs) < sortKey(rhs);
+}
+
 arrow::Status VeloxSortShuffleWriter::evictPartition(uint32_t partitionId, size_t begin, size_t end) {
   VELOX_DCHECK(begin < end);
   // Count copy row time into sortTime_.
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "shuffle/RadixSort.h"
+#include "shuffle/ShuffleSortKeyEncoder.h"
 #include "shuffle/VeloxShuffleWriter.h"
 
 #include <arrow/status.h>
@@ -78,6 +79,12 @@ class VeloxSortShuffleWriter final : public VeloxShuffleWriter {
 
   arrow::Status evictAllPartitions();
 
+  // Returns the encoded sort key stored after the row.
+  std::string_view sortKey(uint64_t compactRowId) const;
+
+  // Orders by partition id, then by sort key.
+  bool sortKeyLessThan(uint64_t lhs, uint64_t rhs) const;
+
   arrow::Status evictPartition(uint32_t partitionId, size_t begin, size_t end);
 
   arrow::Status evictPartitionInternal(uint32_t partitionId, int32_t numRows, uint8_t* buffer, int64_t rawLength);
@@ -125,8 +132,13 @@ class VeloxSortShuffleWriter final : public VeloxShuffleWriter {
   std::shared_ptr<const facebook::velox::RowType> rowType_;
   std::optional<int32_t> fixedRowSize_;
   std::vector<RowSizeType> rowSize_;
+  // Prefix sum of the bytes each row takes in a page, including its sort key.
   std::vector<uint64_t> rowSizePrefixSum_;
 
+  // Set if options_.sortKeys is not empty. The encoded sort key of a row is stored right after the row in the page as
+  // size(RowSizeType) | bytes, and is not evicted.
+  std::unique_ptr<ShuffleSortKeyEncoder> sortKeyEncoder_;
+
   int64_t c2rTime_{0};
   int64_t sortTime_{0};
   bool stopped_{false};
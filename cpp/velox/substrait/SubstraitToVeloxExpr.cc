@@ -17,6 +17,7 @@
 
 #include "SubstraitToVeloxExpr.h"
 #include "TypeUtils.h"
+#include "operators/functions/HigherOrderFunctions.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VariantToVector.h"
 
@@ -302,6 +303,15 @@ core::TypedExprPtr SubstraitVeloxExprConverter::toVeloxExpr(
     return makeFieldAccessExpr(substraitFunc.arguments(0).value().literal().string(), outputType, nullptr);
   } else if (veloxFunction == "extract") {
     return toExtractExpr(std::move(params), outputType);
+  } else if (veloxFunction == "get_struct_field") {
+    // A field of a lambda argument, e.g. x.price in transform(items, x -> x.price).
+    VELOX_CHECK_EQ(params.size(), 2);
+    auto ordinal = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(params[1]);
+    VELOX_CHECK_NOT_NULL(ordinal, "Constant ordinal is expected in get_struct_field.");
+    return std::make_shared<const core::DereferenceTypedExpr>(
+        outputType, params[0], ordinal->value().value<int32_t>());
+  } else if (auto fastPath = rewriteHigherOrderCall(veloxFunction, params, outputType)) {
+    return fastPath;
   } else {
     return std::make_shared<const core::CallTypedExpr>(outputType, std::move(params), veloxFunction);
   }
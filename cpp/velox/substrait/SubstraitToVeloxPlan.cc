@@ -18,6 +18,8 @@
 #include "SubstraitToVeloxPlan.h"
 #include "TypeUtils.h"
 #include "VariantToVectorConverter.h"
+#include "operators/functions/JsonExtraction.h"
+#include "operators/functions/SparkExprToSubfieldFilterParser.h"
 #include "operators/plannodes/RowVectorStream.h"
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/exec/TableWriter.h"
@@ -466,6 +468,8 @@ core::PlanNodePtr SubstraitToVeloxPlanConverter::toVeloxPlan(const ::substrait::
     projectNames.emplace_back(SubstraitParser::makeNodeName(planNodeId_, colIdx));
     colIdx += 1;
   }
+  // Parse the JSON documents of a column once for all the paths extracted from it.
+  expressions = rewriteJsonExtractions(expressions);
 
   if (projectRel.has_common()) {
     auto relCommon = projectRel.common();
@@ -1232,7 +1236,8 @@ core::PlanNodePtr SubstraitToVeloxPlanConverter::toVeloxPlan(const ::substrait::
     connector::hive::SubfieldFilters subfieldFilters;
     auto names = colNameList;
     auto types = veloxTypeList;
-    auto remainingFilter = exprConverter_->toVeloxExpr(readRel.filter(), ROW(std::move(names), std::move(types)));
+    auto remainingFilter = rewriteEqualityDisjunctions(
+        exprConverter_->toVeloxExpr(readRel.filter(), ROW(std::move(names), std::move(types))), pool_);
 
     tableHandle = std::make_shared<connector::hive::HiveTableHandle>(
         kHiveConnectorId, "hive_table", filterPushdownEnabled, std::move(subfieldFilters), remainingFilter);
@@ -0,0 +1,278 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/HedgedReadFile.h"
+
+#include <chrono>
+#include <thread>
+
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/file/FileSystems.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+constexpr uint64_t kFileSize = 1 << 20;
+constexpr uint64_t kTypicalLatencyUs = 10'000;
+
+char byteAt(uint64_t offset) {
+  return static_cast<char>(offset % 251);
+}
+
+// Remote storage stub, whose reads take `latency`. Counts its reads in `reads` if given.
+class DelayedReadFile : public ReadFile {
+ public:
+  explicit DelayedReadFile(std::chrono::milliseconds latency, std::atomic<uint32_t>* reads = nullptr)
+      : latency_(latency), reads_(reads) {}
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf) const override {
+    if (reads_) {
+      ++*reads_;
+    }
+    std::this_thread::sleep_for(latency_);
+    auto* out = static_cast<char*>(buf);
+    for (uint64_t i = 0; i < length; ++i) {
+      out[i] = byteAt(offset + i);
+    }
+    return {out, length};
+  }
+
+  bool shouldCoalesce() const override {
+    return false;
+  }
+
+  uint64_t size() const override {
+    return kFileSize;
+  }
+
+  uint64_t memoryUsage() const override {
+    return 0;
+  }
+
+  std::string getName() const override {
+    return "delayed";
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return 1 << 10;
+  }
+
+ private:
+  const std::chrono::milliseconds latency_;
+  std::atomic<uint32_t>* const reads_;
+};
+
+// Object storage stub for "s3a:" paths, whose files are DelayedReadFiles.
+class DelayedFileSystem : public filesystems::FileSystem {
+ public:
+  DelayedFileSystem() : FileSystem({}) {}
+
+  std::string name() const override {
+    return "delayed";
+  }
+
+  std::unique_ptr<ReadFile> openFileForRead(std::string_view, const filesystems::FileOptions&) override {
+    return std::make_unique<DelayedReadFile>(std::chrono::milliseconds(0));
+  }
+
+  std::unique_ptr<WriteFile> openFileForWrite(std::string_view, const filesystems::FileOptions&) override {
+    VELOX_UNSUPPORTED();
+  }
+
+  void remove(std::string_view) override {}
+
+  void rename(std::string_view, std::string_view, bool) override {}
+
+  bool exists(std::string_view) override {
+    return true;
+  }
+
+  std::vector<std::string> list(std::string_view) override {
+    return {};
+  }
+
+  void mkdir(std::string_view, const filesystems::DirectoryOptions& = {}) override {}
+
+  void rmdir(std::string_view) override {}
+};
+
+void expectRange(std::string_view data, uint64_t offset) {
+  for (uint64_t i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(data[i], byteAt(offset + i)) << "at " << offset + i;
+  }
+}
+} // namespace
+
+class HedgedReadFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (uint64_t i = 0; i < options_.minSamples; ++i) {
+      storage_->latencies.record(kTypicalLatencyUs);
+    }
+  }
+
+  std::unique_ptr<HedgedReadFile> open(
+      std::chrono::milliseconds primaryLatency,
+      std::chrono::milliseconds backupLatency) {
+    return std::make_unique<HedgedReadFile>(
+        std::make_shared<DelayedReadFile>(primaryLatency, &primaryReads_),
+        [this, backupLatency]() {
+          ++backupsOpened_;
+          return std::make_shared<DelayedReadFile>(backupLatency, &backupReads_);
+        },
+        storage_,
+        budget_,
+        options_,
+        &executor_);
+  }
+
+  std::shared_ptr<HedgedReadStorage> storage_ = std::make_shared<HedgedReadStorage>();
+  HedgeBudget budget_;
+  HedgedReadOptions options_;
+  std::atomic<uint32_t> primaryReads_{0};
+  std::atomic<uint32_t> backupsOpened_{0};
+  std::atomic<uint32_t> backupReads_{0};
+  // Destroyed first, so that no hedge outlives the members above.
+  folly::IOThreadPoolExecutor executor_{4};
+};
+
+TEST_F(HedgedReadFileTest, latencyPercentile) {
+  ReadLatencyHistogram histogram;
+  for (auto i = 0; i < 95; ++i) {
+    histogram.record(1'000);
+  }
+  ASSERT_FALSE(histogram.percentile(0.95, 100).has_value());
+
+  for (auto i = 0; i < 5; ++i) {
+    histogram.record(100'000);
+  }
+  auto p95 = histogram.percentile(0.95, 100);
+  ASSERT_TRUE(p95.has_value());
+  ASSERT_GE(p95.value(), 1'000);
+  ASSERT_LT(p95.value(), 1'500);
+  ASSERT_GE(histogram.percentile(0.99, 100).value(), 100'000);
+
+  // The storage slows down: after two windows, most of the counts are slow reads.
+  for (uint64_t i = 0; i < 2 * ReadLatencyHistogram::kWindow; ++i) {
+    histogram.record(100'000);
+  }
+  ASSERT_GE(histogram.percentile(0.5, 100).value(), 100'000);
+}
+
+TEST_F(HedgedReadFileTest, hedgesSlowRead) {
+  budget_.earn(1);
+  auto file = open(std::chrono::milliseconds(2'000), std::chrono::milliseconds(1));
+
+  // The read returns with the hedge, long before the primary read completes.
+  std::string buf(100'000, 0);
+  auto start = std::chrono::steady_clock::now();
+  auto out = file->pread(1'000, buf.size(), buf.data());
+  ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  ASSERT_EQ(out.size(), buf.size());
+  expectRange(out, 1'000);
+  ASSERT_EQ(primaryReads_, 1);
+  ASSERT_EQ(backupsOpened_, 1);
+  ASSERT_EQ(storage_->hedges, 1);
+  ASSERT_EQ(storage_->hedgeWins, 1);
+}
+
+TEST_F(HedgedReadFileTest, takesFasterPrimaryRead) {
+  budget_.earn(1);
+  auto file = open(std::chrono::milliseconds(30), std::chrono::milliseconds(200));
+
+  // The primary read outlasts the delay, and completes while the hedge is still reading.
+  std::string buf(1 << 20, 0);
+  expectRange(file->pread(0, buf.size(), buf.data()), 0);
+  ASSERT_EQ(primaryReads_, 1);
+  ASSERT_EQ(storage_->hedges, 1);
+  ASSERT_EQ(storage_->hedgeWins, 0);
+
+  // The primary read which outlasted the delay counts with the time it took.
+  ASSERT_GE(storage_->latencies.percentile(1.0, 1).value(), 30'000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  ASSERT_EQ(backupReads_, 1);
+}
+
+TEST_F(HedgedReadFileTest, hedgesVectoredRead) {
+  budget_.earn(1);
+  auto file = open(std::chrono::milliseconds(2'000), std::chrono::milliseconds(1));
+  ASSERT_FALSE(file->hasPreadvAsync());
+
+  // A buffer without data skips its bytes.
+  std::string first(1'000, 0);
+  std::string second(3'000, 0);
+  std::vector<folly::Range<char*>> buffers{
+      {first.data(), first.size()}, {nullptr, 500}, {second.data(), second.size()}};
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_EQ(file->preadv(100, buffers), 4'500);
+  ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  expectRange(first, 100);
+  expectRange(second, 1'600);
+  ASSERT_EQ(storage_->hedgeWins, 1);
+}
+
+TEST_F(HedgedReadFileTest, doesNotHedgeFastRead) {
+  budget_.earn(1);
+  auto file = open(std::chrono::milliseconds(1), std::chrono::milliseconds(1));
+
+  std::string buf(kFileSize, 0);
+  for (uint64_t offset = 0; offset < kFileSize; offset += kFileSize / 16) {
+    file->pread(offset, kFileSize / 16, buf.data() + offset);
+  }
+  expectRange(buf, 0);
+  ASSERT_EQ(storage_->reads, 16);
+  ASSERT_EQ(storage_->hedges, 0);
+  ASSERT_EQ(backupsOpened_, 0);
+}
+
+TEST_F(HedgedReadFileTest, respectsBudget) {
+  options_.budgetRatio = 0;
+  auto file = open(std::chrono::milliseconds(200), std::chrono::milliseconds(1));
+
+  std::string buf(1'000, 0);
+  auto start = std::chrono::steady_clock::now();
+  file->pread(0, buf.size(), buf.data());
+  ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+  expectRange(buf, 0);
+  ASSERT_EQ(storage_->hedges, 0);
+  ASSERT_EQ(backupsOpened_, 0);
+}
+
+TEST_F(HedgedReadFileTest, wrapsRemoteFileSystem) {
+  // The registration outlives the test.
+  static folly::IOThreadPoolExecutor executor(1);
+  registerHedgedReadFileSystem(options_, &executor);
+  filesystems::registerFileSystem(
+      [](std::string_view path) { return path.find("s3a://") == 0; },
+      [](std::shared_ptr<const config::ConfigBase>, std::string_view) {
+        return std::make_shared<DelayedFileSystem>();
+      });
+
+  auto fs = filesystems::getFileSystem("s3a://bucket/file", nullptr);
+  ASSERT_EQ(fs->name(), "delayed");
+  auto file = fs->openFileForRead("s3a://bucket/file");
+  ASSERT_NE(dynamic_cast<HedgedReadFile*>(file.get()), nullptr);
+
+  std::string buf(1'000, 0);
+  expectRange(file->pread(10, buf.size(), buf.data()), 10);
+}
+
+} // namespace gluten
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compute/VeloxBackend.h"
+#include "compute/WholeStageResultIterator.h"
+#include "config/VeloxConfig.h"
+#include "memory/VeloxMemoryManager.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+namespace gluten {
+
+class LiveMetricsTest : public ::testing::Test {
+ protected:
+  static constexpr int32_t kNumBatches = 10;
+  static constexpr int32_t kBatchSize = 100;
+
+  static void SetUpTestCase() {
+    VeloxBackend::create({});
+  }
+
+  void SetUp() override {
+    vmm_ = std::make_unique<VeloxMemoryManager>(kVeloxBackendKind, AllocationListener::noop());
+    spillDir_ = TempDirectoryPath::create();
+  }
+
+  std::unique_ptr<WholeStageResultIterator> makeIterator() {
+    test::VectorMaker maker(vmm_->getLeafMemoryPool().get());
+    std::vector<RowVectorPtr> batches;
+    for (int32_t i = 0; i < kNumBatches; ++i) {
+      batches.push_back(maker.rowVector({maker.flatVector<int64_t>(kBatchSize, [](auto row) { return row; })}));
+    }
+    auto plan = PlanBuilder().values(batches).project({"c0"}).planNode();
+    return std::make_unique<WholeStageResultIterator>(
+        vmm_.get(),
+        plan,
+        std::vector<core::PlanNodeId>{},
+        std::vector<std::shared_ptr<SplitInfo>>{},
+        std::vector<core::PlanNodeId>{},
+        spillDir_->getPath(),
+        std::unordered_map<std::string, std::string>{{kMetricsPublishIntervalMs, "1"}},
+        SparkTaskInfo{});
+  }
+
+  // Waits for the background publisher to publish the metrics of the iterator at least once.
+  static MetricsSnapshot* waitForPublication(WholeStageResultIterator& iter, std::vector<int64_t>& values) {
+    for (int32_t i = 0; i < 500; ++i) {
+      auto* snapshot = iter.getMetricsSnapshot();
+      if (snapshot != nullptr && snapshot->read(values) > 0) {
+        return snapshot;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return nullptr;
+  }
+
+  static int64_t maxOfType(const std::vector<int64_t>& values, unsigned int numMetrics, Metrics::TYPE type) {
+    auto begin = values.begin() + type * numMetrics;
+    return *std::max_element(begin, begin + numMetrics);
+  }
+
+  std::unique_ptr<VeloxMemoryManager> vmm_;
+  std::shared_ptr<TempDirectoryPath> spillDir_;
+};
+
+TEST_F(LiveMetricsTest, publishWhileTaskIsRunning) {
+  auto iter = makeIterator();
+  ASSERT_NE(iter->next(), nullptr);
+
+  // The task is paused after its first batch, so the published metrics reflect a running task.
+  std::vector<int64_t> values;
+  auto* snapshot = waitForPublication(*iter, values);
+  ASSERT_NE(snapshot, nullptr);
+  auto numMetrics = snapshot->numMetrics();
+  auto liveOutputRows = maxOfType(values, numMetrics, Metrics::kOutputRows);
+  ASSERT_GE(liveOutputRows, kBatchSize);
+  ASSERT_LT(liveOutputRows, kNumBatches * kBatchSize);
+
+  while (iter->next() != nullptr) {
+  }
+
+  // The final metrics are published as well, so the live values end up the same as the final ones.
+  auto* metrics = iter->getMetrics(0);
+  ASSERT_EQ(metrics->numMetrics, numMetrics);
+  snapshot->read(values);
+  for (int type = Metrics::kBegin; type < Metrics::kEnd; ++type) {
+    for (unsigned int j = 0; j < numMetrics; ++j) {
+      ASSERT_EQ(values[type * numMetrics + j], metrics->get(static_cast<Metrics::TYPE>(type))[j])
+          << "type " << type << ", metric " << j;
+    }
+  }
+  ASSERT_EQ(maxOfType(values, numMetrics, Metrics::kOutputRows), kNumBatches * kBatchSize);
+}
+
+TEST_F(LiveMetricsTest, removeWhilePublishing) {
+  // Destroying iterators while the publisher is running must neither block nor access them afterwards.
+  for (int32_t i = 0; i < 20; ++i) {
+    auto iter = makeIterator();
+    ASSERT_NE(iter->next(), nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(i * 5));
+  }
+}
+
+} // namespace gluten
@@ -0,0 +1,172 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "operators/functions/SparkExprToSubfieldFilterParser.h"
+
+#include "velox/core/Expressions.h"
+#include "velox/core/QueryCtx.h"
+#include "velox/expression/Expr.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+class SparkExprToSubfieldFilterParserTest : public ::testing::Test, public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+    exec::ExprToSubfieldFilterParser::registerParserFactory(
+        []() { return std::make_shared<SparkExprToSubfieldFilterParser>(); });
+  }
+
+  static core::TypedExprPtr field(const TypePtr& type, const std::string& name) {
+    return std::make_shared<core::FieldAccessTypedExpr>(type, name);
+  }
+
+  static core::TypedExprPtr dereference(const core::TypedExprPtr& input, uint32_t index) {
+    return std::make_shared<core::DereferenceTypedExpr>(input->type()->childAt(index), input, index);
+  }
+
+  static core::TypedExprPtr call(const std::string& name, std::vector<core::TypedExprPtr> inputs) {
+    return std::make_shared<core::CallTypedExpr>(BOOLEAN(), std::move(inputs), name);
+  }
+
+  static core::TypedExprPtr constant(const TypePtr& type, const variant& value) {
+    return std::make_shared<core::ConstantTypedExpr>(type, value);
+  }
+
+  std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(const core::TypedExprPtr& expr) {
+    return exec::toSubfieldFilter(expr, &evaluator_);
+  }
+
+  std::shared_ptr<core::QueryCtx> queryCtx_{core::QueryCtx::create()};
+  exec::SimpleExpressionEvaluator evaluator_{queryCtx_.get(), pool()};
+};
+
+TEST_F(SparkExprToSubfieldFilterParserTest, nestedField) {
+  auto userType = ROW({"id", "name"}, {BIGINT(), VARCHAR()});
+  auto eventType = ROW({"user", "ts"}, {userType, BIGINT()});
+  auto userId = dereference(dereference(field(eventType, "event"), 0), 0);
+
+  auto [subfield, filter] = toSubfieldFilter(call("equalto", {userId, constant(BIGINT(), 42L)}));
+  ASSERT_EQ(subfield.toString(), "event.user.id");
+  ASSERT_TRUE(filter->testInt64(42));
+  ASSERT_FALSE(filter->testInt64(41));
+  ASSERT_FALSE(filter->testNull());
+}
+
+TEST_F(SparkExprToSubfieldFilterParserTest, between) {
+  auto [subfield, filter] = toSubfieldFilter(
+      call("between", {field(BIGINT(), "a"), constant(BIGINT(), 10L), constant(BIGINT(), 20L)}));
+  ASSERT_EQ(subfield.toString(), "a");
+  ASSERT_EQ(filter->kind(), common::FilterKind::kBigintRange);
+  ASSERT_TRUE(filter->testInt64(10));
+  ASSERT_TRUE(filter->testInt64(20));
+  ASSERT_FALSE(filter->testInt64(21));
+}
+
+TEST_F(SparkExprToSubfieldFilterParserTest, prefix) {
+  for (const auto& expr :
+       {call("startswith", {field(VARCHAR(), "s"), constant(VARCHAR(), "abc")}),
+        call("like", {field(VARCHAR(), "s"), constant(VARCHAR(), "abc%")})}) {
+    auto [subfield, filter] = toSubfieldFilter(expr);
+    ASSERT_EQ(subfield.toString(), "s");
+    ASSERT_EQ(filter->kind(), common::FilterKind::kBytesRange);
+    ASSERT_TRUE(filter->testBytes("abc", 3));
+    ASSERT_TRUE(filter->testBytes("abcz", 4));
+    ASSERT_TRUE(filter->testBytes("abc\xff", 4));
+    ASSERT_FALSE(filter->testBytes("abd", 3));
+    ASSERT_FALSE(filter->testBytes("ab", 2));
+    ASSERT_FALSE(filter->testNull());
+    // The range allows pruning on row group min/max statistics.
+    ASSERT_FALSE(filter->testBytesRange("abd", "abz", false));
+    ASSERT_TRUE(filter->testBytesRange("aaa", "abcd", false));
+  }
+
+  // Trailing 0xFF bytes are dropped from the upper bound.
+  auto [_, filter] = toSubfieldFilter(call("startswith", {field(VARCHAR(), "s"), constant(VARCHAR(), "a\xff")}));
+  ASSERT_TRUE(filter->testBytes("a\xff\xff", 3));
+  ASSERT_FALSE(filter->testBytes("b", 1));
+}
+
+TEST_F(SparkExprToSubfieldFilterParserTest, likeNotPrefix) {
+  for (const auto& pattern : {"%abc", "a_c%", "a%c%", "abc", "a\\%%"}) {
+    auto expr = call("like", {field(VARCHAR(), "s"), constant(VARCHAR(), pattern)});
+    common::Subfield subfield;
+    auto filter = exec::ExprToSubfieldFilterParser::getInstance()->leafCallToSubfieldFilter(
+        *std::dynamic_pointer_cast<const core::CallTypedExpr>(expr), subfield, &evaluator_, false);
+    ASSERT_EQ(filter, nullptr) << pattern;
+  }
+}
+
+TEST_F(SparkExprToSubfieldFilterParserTest, orOfRanges) {
+  auto a = field(DOUBLE(), "a");
+  auto [subfield, filter] = toSubfieldFilter(call(
+      "or",
+      {call("lessthan", {a, constant(DOUBLE(), 1.0)}), call("greaterthan", {a, constant(DOUBLE(), 10.0)})}));
+  ASSERT_EQ(subfield.toString(), "a");
+  ASSERT_EQ(filter->kind(), common::FilterKind::kMultiRange);
+  ASSERT_TRUE(filter->testDouble(0.5));
+  ASSERT_TRUE(filter->testDouble(11));
+  ASSERT_FALSE(filter->testDouble(5));
+  ASSERT_FALSE(filter->testDoubleRange(2, 9, false));
+}
+
+TEST_F(SparkExprToSubfieldFilterParserTest, equalityDisjunctions) {
+  auto a = field(VARCHAR(), "a");
+  auto b = field(BIGINT(), "b");
+  auto eq = [&](const core::TypedExprPtr& column, const TypePtr& type, const variant& value) {
+    return call("equalto", {column, constant(type, value)});
+  };
+
+  auto filter = call(
+      "and",
+      {call(
+           "or",
+           {call("or", {eq(a, VARCHAR(), "x"), eq(a, VARCHAR(), "y")}), eq(a, VARCHAR(), "z")}),
+       call("or", {eq(b, BIGINT(), 1L), eq(b, BIGINT(), 100L)})});
+  auto rewritten = rewriteEqualityDisjunctions(filter, pool());
+  ASSERT_EQ(rewritten->inputs().size(), 2);
+
+  auto* in = dynamic_cast<const core::CallTypedExpr*>(rewritten->inputs()[0].get());
+  ASSERT_NE(in, nullptr);
+  ASSERT_EQ(in->name(), "in");
+  auto [subfield, bytesFilter] = toSubfieldFilter(rewritten->inputs()[0]);
+  ASSERT_EQ(subfield.toString(), "a");
+  ASSERT_EQ(bytesFilter->kind(), common::FilterKind::kBytesValues);
+  ASSERT_TRUE(bytesFilter->testBytes("y", 1));
+  ASSERT_FALSE(bytesFilter->testBytes("w", 1));
+  ASSERT_FALSE(bytesFilter->testNull());
+
+  auto [bigintSubfield, bigintFilter] = toSubfieldFilter(rewritten->inputs()[1]);
+  ASSERT_EQ(bigintSubfield.toString(), "b");
+  ASSERT_TRUE(bigintFilter->testInt64(1));
+  ASSERT_TRUE(bigintFilter->testInt64(100));
+  ASSERT_FALSE(bigintFilter->testInt64(50));
+
+  // Disjunctions over different columns, of other comparisons or with null constants are kept.
+  auto mixedColumns = call("or", {eq(a, VARCHAR(), "x"), eq(field(VARCHAR(), "c"), VARCHAR(), "y")});
+  ASSERT_EQ(rewriteEqualityDisjunctions(mixedColumns, pool()), mixedColumns);
+  auto mixedComparisons = call("or", {eq(b, BIGINT(), 1L), call("greaterthan", {b, constant(BIGINT(), 10L)})});
+  ASSERT_EQ(rewriteEqualityDisjunctions(mixedComparisons, pool()), mixedComparisons);
+  auto nullConstant = call("or", {eq(b, BIGINT(), 1L), eq(b, BIGINT(), variant::null(TypeKind::BIGINT))});
+  ASSERT_EQ(rewriteEqualityDisjunctions(nullConstant, pool()), nullConstant);
+}
+
+} // namespace gluten
@@ -15,9 +15,14 @@
  * limitations under the License.
  */
 
+#include <limits>
+#include <random>
 #include <vector>
 
+#include "operators/functions/HigherOrderFunctions.h"
+#include "operators/functions/JsonExtraction.h"
 #include "operators/functions/RegistrationAllFunctions.h"
+#include "operators/functions/TimeZoneConversion.h"
 #include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
 
 using namespace facebook::velox::functions::sparksql::test;
@@ -47,6 +52,39 @@ class SparkFunctionTest : public SparkFunctionBaseTest {
     }
   }
 
+  static core::TypedExprPtr field(const std::string& name, const TypePtr& type) {
+    return std::make_shared<core::FieldAccessTypedExpr>(type, name);
+  }
+
+  static core::TypedExprPtr
+  call(const std::string& name, const TypePtr& type, const std::vector<core::TypedExprPtr>& inputs) {
+    return std::make_shared<core::CallTypedExpr>(type, inputs, name);
+  }
+
+  template <typename T>
+  static core::TypedExprPtr constant(T value) {
+    return std::make_shared<core::ConstantTypedExpr>(CppToType<T>::create(), variant(value));
+  }
+
+  static core::TypedExprPtr lambda(const RowTypePtr& arguments, const core::TypedExprPtr& body) {
+    return std::make_shared<core::LambdaTypedExpr>(arguments, body);
+  }
+
+  // Checks that the higher-order call takes the fast path and gives the same result as evaluating the lambda.
+  void testHigherOrderFastPath(const core::TypedExprPtr& expr, const RowVectorPtr& input) {
+    auto higherOrderCall = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+    auto fastPath = gluten::rewriteHigherOrderCall(higherOrderCall->name(), higherOrderCall->inputs(), expr->type());
+    ASSERT_NE(fastPath, nullptr) << expr->toString();
+    SCOPED_TRACE(fastPath->toString());
+    assertEqualVectors(evaluate<BaseVector>(expr, input), evaluate<BaseVector>(fastPath, input));
+
+    // Also through a dictionary, which the fast path keeps on the result.
+    auto size = input->size();
+    auto indices = makeIndicesInReverse(size);
+    auto wrapped = makeRowVector({wrapInDictionary(indices, size, input->childAt(0))});
+    assertEqualVectors(evaluate<BaseVector>(expr, wrapped), evaluate<BaseVector>(fastPath, wrapped));
+  }
+
   template <typename T>
   std::vector<std::tuple<T, T>> testRoundFloatData() {
     return {
@@ -111,3 +149,297 @@ TEST_F(SparkFunctionTest, roundWithDecimal) {
   runRoundWithDecimalTest<int16_t>(testRoundWithDecIntegralData<int16_t>());
   runRoundWithDecimalTest<int8_t>(testRoundWithDecIntegralData<int8_t>());
 }
+
+TEST_F(SparkFunctionTest, fromUtcTimestamp) {
+  auto input = makeRowVector({makeNullableFlatVector<Timestamp>(
+      {Timestamp(1710064799, 0), Timestamp(1710064800, 123), std::nullopt, Timestamp(1704067200, 0)})});
+  // Before and after the daylight saving time starts.
+  assertEqualVectors(
+      makeNullableFlatVector<Timestamp>(
+          {Timestamp(1710035999, 0), Timestamp(1710039600, 123), std::nullopt, Timestamp(1704038400, 0)}),
+      evaluate("from_utc_timestamp(c0, 'America/Los_Angeles')", input));
+  assertEqualVectors(
+      makeNullableFlatVector<Timestamp>(
+          {Timestamp(1710093599, 0), Timestamp(1710093600, 123), std::nullopt, Timestamp(1704096000, 0)}),
+      evaluate("from_utc_timestamp(c0, '+08:00')", input));
+  assertEqualVectors(input->childAt(0), evaluate("from_utc_timestamp(c0, 'UTC')", input));
+
+  // Time zone per row.
+  input = makeRowVector(
+      {makeFlatVector<Timestamp>({Timestamp(1704067200, 0), Timestamp(1704067200, 0)}),
+       makeFlatVector<std::string>({"Asia/Kolkata", "Europe/Berlin"})});
+  assertEqualVectors(
+      makeFlatVector<Timestamp>({Timestamp(1704087000, 0), Timestamp(1704070800, 0)}),
+      evaluate("from_utc_timestamp(c0, c1)", input));
+}
+
+TEST_F(SparkFunctionTest, toUtcTimestamp) {
+  // A local time in the gap when the daylight saving time starts uses the offset before the gap, and an ambiguous one
+  // when it ends uses the earlier offset, as in Spark.
+  auto input = makeRowVector({makeFlatVector<Timestamp>(
+      {Timestamp(1710035999, 0), Timestamp(1710037800, 0), Timestamp(1710039600, 0), Timestamp(1730597400, 0)})});
+  assertEqualVectors(
+      makeFlatVector<Timestamp>(
+          {Timestamp(1710064799, 0), Timestamp(1710066600, 0), Timestamp(1710064800, 0), Timestamp(1730622600, 0)}),
+      evaluate("to_utc_timestamp(c0, 'America/Los_Angeles')", input));
+}
+
+TEST_F(SparkFunctionTest, timeZoneOffsetTable) {
+  // Compare with the time zone library over a century of random timestamps.
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int64_t> dist(-2208988800 /*1900-01-01*/, 4102444800 /*2100-01-01*/);
+  std::vector<int64_t> seconds(10'000);
+  for (auto& value : seconds) {
+    value = dist(rng);
+  }
+  auto [min, max] = std::minmax_element(seconds.begin(), seconds.end());
+  for (const auto* name : {"America/Los_Angeles", "Europe/Berlin", "Asia/Kolkata", "Australia/Lord_Howe", "+05:30"}) {
+    SCOPED_TRACE(name);
+    const auto* zone = tz::locateZone(name);
+    auto table = gluten::TimeZoneOffsetTable::make(*zone, *min, *max);
+    ASSERT_TRUE(table.has_value());
+    std::vector<int64_t> local(seconds.size());
+    table->fromUtc(seconds.data(), local.data(), seconds.size());
+    for (size_t i = 0; i < seconds.size(); ++i) {
+      ASSERT_EQ(local[i], zone->to_local(std::chrono::seconds(seconds[i])).count());
+    }
+  }
+}
+
+TEST_F(SparkFunctionTest, instr) {
+  auto input = makeRowVector(
+      {makeFlatVector<std::string>({"hello", "hello", "数据砖头数据", "ab数据cd", "", "abc"}),
+       makeFlatVector<std::string>({"l", "", "砖头", "cd", "a", "abcd"})});
+  assertEqualVectors(makeFlatVector<int32_t>({3, 1, 3, 5, 0, 0}), evaluate("instr(c0, c1)", input));
+}
+
+TEST_F(SparkFunctionTest, locate) {
+  auto input = makeRowVector(
+      {makeNullableFlatVector<std::string>({"数据", "数据", "l", "l", std::nullopt, "l", ""}),
+       makeNullableFlatVector<std::string>({"数据砖头数据", "数据砖头数据", "hello", "hello", "hello", "hello", "a"}),
+       makeNullableFlatVector<int32_t>({1, 2, 4, 0, 1, std::nullopt, 5})});
+  assertEqualVectors(
+      makeNullableFlatVector<int32_t>({1, 5, 4, 0, std::nullopt, 0, 1}), evaluate("locate(c0, c1, c2)", input));
+}
+
+TEST_F(SparkFunctionTest, length) {
+  // A truncated character at the end counts as one.
+  auto input = makeRowVector({makeFlatVector<std::string>({"hello", "数据砖头", "", "a\xe6\x95"})});
+  assertEqualVectors(makeFlatVector<int32_t>({5, 4, 0, 2}), evaluate("length(c0)", input));
+  auto ascii = makeRowVector({makeFlatVector<std::string>({"hello", "", "a longer ascii string"})});
+  assertEqualVectors(makeFlatVector<int32_t>({5, 0, 21}), evaluate("length(c0)", ascii));
+}
+
+TEST_F(SparkFunctionTest, substring) {
+  auto input = makeRowVector(
+      {makeFlatVector<std::string>({"Spark SQL", "Spark SQL", "数据砖头", "数据砖头", "abc", "abc"}),
+       makeFlatVector<int32_t>({1, -3, 2, -1, 0, 4}),
+       makeFlatVector<int32_t>({5, 2, 2, 1, 2, 1})});
+  assertEqualVectors(
+      makeFlatVector<std::string>({"Spark", "SQ", "据砖", "头", "ab", ""}), evaluate("substring(c0, c1, c2)", input));
+  auto ascii = makeRowVector(
+      {makeFlatVector<std::string>({"Spark SQL", "Spark SQL", "abc"}), makeFlatVector<int32_t>({7, -3, -5})});
+  assertEqualVectors(makeFlatVector<std::string>({"SQL", "SQL", "abc"}), evaluate("substring(c0, c1)", ascii));
+}
+
+TEST_F(SparkFunctionTest, caseMapping) {
+  auto input =
+      makeRowVector({makeFlatVector<std::string>({"Hello World", "ünïcödé Abc", "a long ASCII string, 16+ bytes"})});
+  assertEqualVectors(
+      makeFlatVector<std::string>({"HELLO WORLD", "ÜNÏCÖDÉ ABC", "A LONG ASCII STRING, 16+ BYTES"}),
+      evaluate("upper(c0)", input));
+  assertEqualVectors(
+      makeFlatVector<std::string>({"hello world", "ünïcödé abc", "a long ascii string, 16+ bytes"}),
+      evaluate("lower(c0)", input));
+  auto ascii = makeRowVector({makeFlatVector<std::string>({"Hello World", "", "a long ASCII string, 16+ bytes"})});
+  assertEqualVectors(
+      makeFlatVector<std::string>({"HELLO WORLD", "", "A LONG ASCII STRING, 16+ BYTES"}), evaluate("upper(c0)", ascii));
+  assertEqualVectors(
+      makeFlatVector<std::string>({"hello world", "", "a long ascii string, 16+ bytes"}), evaluate("lower(c0)", ascii));
+}
+
+TEST_F(SparkFunctionTest, arrayHigherOrderFastPath) {
+  auto input = makeRowVector({makeNullableArrayVector<int64_t>(
+      {{{1, 5, std::nullopt, 10}},
+       {{}},
+       std::nullopt,
+       {{7, 7, 3}},
+       {{std::numeric_limits<int64_t>::max(), -4}},
+       {{std::nullopt}}})});
+  auto arrayType = ARRAY(BIGINT());
+  auto x = field("x", BIGINT());
+  auto arguments = ROW({"x"}, {BIGINT()});
+  auto c0 = field("c0", arrayType);
+
+  for (const auto& comparison : {"equalto", "lessthan", "lessthanorequal", "greaterthan", "greaterthanorequal"}) {
+    auto body = call(comparison, BOOLEAN(), {x, constant<int64_t>(5)});
+    testHigherOrderFastPath(call("filter", arrayType, {c0, lambda(arguments, body)}), input);
+    testHigherOrderFastPath(call("exists", BOOLEAN(), {c0, lambda(arguments, body)}), input);
+    // The constant on the left.
+    auto swapped = call(comparison, BOOLEAN(), {constant<int64_t>(5), x});
+    testHigherOrderFastPath(call("filter", arrayType, {c0, lambda(arguments, swapped)}), input);
+  }
+  for (const auto& arithmetic : {"add", "subtract", "multiply"}) {
+    // Overflows wrap around.
+    auto body = call(arithmetic, BIGINT(), {x, constant<int64_t>(3)});
+    testHigherOrderFastPath(call("transform", arrayType, {c0, lambda(arguments, body)}), input);
+  }
+
+  auto acc = field("acc", BIGINT());
+  auto sum = lambda(ROW({"acc", "x"}, {BIGINT(), BIGINT()}), call("add", BIGINT(), {acc, x}));
+  testHigherOrderFastPath(call("aggregate", BIGINT(), {c0, constant<int64_t>(100), sum}), input);
+  testHigherOrderFastPath(
+      call("aggregate", BIGINT(), {c0, constant<int64_t>(0), sum, lambda(ROW({"acc"}, {BIGINT()}), acc)}), input);
+
+  // Lambdas with a captured column or a non-constant operand take the generic path.
+  auto captured = call("greaterthan", BOOLEAN(), {x, field("c1", BIGINT())});
+  ASSERT_EQ(gluten::rewriteHigherOrderCall("filter", {c0, lambda(arguments, captured)}, arrayType), nullptr);
+  auto nested = call("greaterthan", BOOLEAN(), {call("add", BIGINT(), {x, x}), constant<int64_t>(1)});
+  ASSERT_EQ(gluten::rewriteHigherOrderCall("filter", {c0, lambda(arguments, nested)}, arrayType), nullptr);
+}
+
+TEST_F(SparkFunctionTest, arrayHigherOrderFastPathNaN) {
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto input = makeRowVector({makeNullableArrayVector<double>(
+      {{{1.5, nan, std::nullopt, -0.0}}, {{nan}}, {{0.0, 2.5}}, std::nullopt})});
+  auto arrayType = ARRAY(DOUBLE());
+  auto x = field("x", DOUBLE());
+  auto arguments = ROW({"x"}, {DOUBLE()});
+  auto c0 = field("c0", arrayType);
+  for (auto value : {0.0, nan}) {
+    for (const auto& comparison : {"equalto", "lessthan", "greaterthanorequal"}) {
+      auto body = call(comparison, BOOLEAN(), {x, constant<double>(value)});
+      testHigherOrderFastPath(call("filter", arrayType, {c0, lambda(arguments, body)}), input);
+      testHigherOrderFastPath(call("exists", BOOLEAN(), {c0, lambda(arguments, body)}), input);
+    }
+  }
+  auto body = call("multiply", DOUBLE(), {constant<double>(2.0), x});
+  testHigherOrderFastPath(call("transform", arrayType, {c0, lambda(arguments, body)}), input);
+}
+
+TEST_F(SparkFunctionTest, arrayOfStructHigherOrderFastPath) {
+  auto structType = ROW({"id", "price"}, {INTEGER(), DOUBLE()});
+  auto elements = makeRowVector(
+      {"id", "price"},
+      {makeNullableFlatVector<int32_t>({1, 2, std::nullopt, 4, 5, 6}),
+       makeNullableFlatVector<double>({1.0, std::nullopt, 3.0, 4.0, 5.0, 6.0})},
+      [](auto row) { return row == 4; });
+  auto input = makeRowVector({makeArrayVector({0, 2, 2, 5}, elements, {2})});
+  auto arrayType = ARRAY(structType);
+  auto x = field("x", structType);
+  auto arguments = ROW({"x"}, {structType});
+  auto c0 = field("c0", arrayType);
+  auto id = std::make_shared<core::DereferenceTypedExpr>(INTEGER(), x, 0);
+  auto price = std::make_shared<core::FieldAccessTypedExpr>(DOUBLE(), x, "price");
+
+  auto idFilter = lambda(arguments, call("greaterthan", BOOLEAN(), {id, constant<int32_t>(1)}));
+  testHigherOrderFastPath(call("filter", arrayType, {c0, idFilter}), input);
+  testHigherOrderFastPath(call("exists", BOOLEAN(), {c0, idFilter}), input);
+  testHigherOrderFastPath(call("transform", ARRAY(DOUBLE()), {c0, lambda(arguments, price)}), input);
+  auto doubled = call("multiply", DOUBLE(), {price, constant<double>(2.0)});
+  testHigherOrderFastPath(call("transform", ARRAY(DOUBLE()), {c0, lambda(arguments, doubled)}), input);
+}
+
+TEST_F(SparkFunctionTest, mapHigherOrderFastPath) {
+  auto input = makeRowVector({makeNullableMapVector<int32_t, int64_t>(
+      {{{{1, 10}, {2, std::nullopt}, {3, 30}}}, {{}}, std::nullopt, {{{4, -5}, {5, 50}}}})});
+  auto mapType = MAP(INTEGER(), BIGINT());
+  auto arguments = ROW({"k", "v"}, {INTEGER(), BIGINT()});
+  auto k = field("k", INTEGER());
+  auto v = field("v", BIGINT());
+  auto c0 = field("c0", mapType);
+
+  auto byKey = lambda(arguments, call("lessthanorequal", BOOLEAN(), {k, constant<int32_t>(3)}));
+  testHigherOrderFastPath(call("map_filter", mapType, {c0, byKey}), input);
+  auto byValue = lambda(arguments, call("greaterthan", BOOLEAN(), {v, constant<int64_t>(0)}));
+  testHigherOrderFastPath(call("map_filter", mapType, {c0, byValue}), input);
+  auto plusOne = lambda(arguments, call("add", BIGINT(), {v, constant<int64_t>(1)}));
+  testHigherOrderFastPath(call("transform_values", mapType, {c0, plusOne}), input);
+}
+
+TEST_F(SparkFunctionTest, sharedJsonExtraction) {
+  auto input = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {R"({"user": {"id": 7, "name": "a\"b"}, "tags": ["x", {"k": 1}], "ok": true, "score": 1.5})",
+           R"({"user": {"id": -3}, "tags": [], "ok": false, "score": null})",
+           R"({"user": "flat", "tags": "none"})",
+           R"([{"user": {"id": 1}}])",
+           R"({"user": {"id": 18446744073709551615}, "ok": tru})",
+           "not json",
+           std::nullopt}),
+      makeFlatVector<std::string>({R"({"a": 1})", "{}", "[]", "", R"({"a": "b"})", "{", "null"}),
+  });
+  auto getJsonObject = [](const std::string& column, const std::string& path) {
+    auto pathConstant = std::make_shared<core::ConstantTypedExpr>(VARCHAR(), variant(path));
+    return call("get_json_object", VARCHAR(), {field(column, VARCHAR()), pathConstant});
+  };
+  std::vector<core::TypedExprPtr> expressions = {
+      getJsonObject("c0", "$.user.id"),
+      getJsonObject("c0", "$.user.name"),
+      call("concat", VARCHAR(), {getJsonObject("c0", "$.tags[1]"), getJsonObject("c0", "$.tags")}),
+      getJsonObject("c0", "$.ok"),
+      getJsonObject("c0", "$.score"),
+      getJsonObject("c0", "$.user.id"),
+      // Unsupported paths and the only path of a column keep get_json_object.
+      getJsonObject("c0", "$['user']"),
+      getJsonObject("c1", "$.a")};
+
+  auto rewritten = gluten::rewriteJsonExtractions(expressions);
+  ASSERT_EQ(rewritten.size(), expressions.size());
+  auto shared = std::dynamic_pointer_cast<const core::DereferenceTypedExpr>(rewritten[0]);
+  ASSERT_NE(shared, nullptr);
+  ASSERT_EQ(shared->inputs()[0], rewritten[1]->inputs()[0]);
+  ASSERT_EQ(shared->inputs()[0], rewritten[5]->inputs()[0]);
+  ASSERT_EQ(rewritten[6], expressions[6]);
+  ASSERT_EQ(rewritten[7], expressions[7]);
+
+  auto evaluateAll = [&](const std::vector<core::TypedExprPtr>& exprs) {
+    exec::ExprSet exprSet(exprs, &execCtx_);
+    exec::EvalCtx evalCtx(&execCtx_, &exprSet, input.get());
+    SelectivityVector rows(input->size());
+    std::vector<VectorPtr> results(exprs.size());
+    exprSet.eval(rows, evalCtx, results);
+    return results;
+  };
+  auto expected = evaluateAll(expressions);
+  auto actual = evaluateAll(rewritten);
+  for (size_t i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]->toString());
+    assertEqualVectors(expected[i], actual[i]);
+  }
+
+  // Nothing to share.
+  ASSERT_EQ(gluten::rewriteJsonExtractions({expressions[0], expressions[5]})[0], expressions[0]);
+}
+
+TEST_F(SparkFunctionTest, sharedJsonExtractionNumbers) {
+  auto input = makeRowVector({makeFlatVector<std::string>(
+      {R"({"pi": 3.14159265, "big": 1e20, "small": -0.00012, "plain": 1234567.0, "int": -7})",
+       R"({"pi": 0.1, "big": 12345678901234567890, "small": 1E-7, "plain": 100.0, "int": 0})",
+       R"({"pi": -0.0, "big": 1.7976931348623157E308, "small": 4.9e-324, "plain": 1e7, "int": 9007199254740993})"})});
+  auto getJsonObject = [](const std::string& path) {
+    auto pathConstant = std::make_shared<core::ConstantTypedExpr>(VARCHAR(), variant(path));
+    return call("get_json_object", VARCHAR(), {field("c0", VARCHAR()), pathConstant});
+  };
+  std::vector<core::TypedExprPtr> expressions = {
+      getJsonObject("$.pi"), getJsonObject("$.big"), getJsonObject("$.small"), getJsonObject("$.plain"),
+      getJsonObject("$.int")};
+  auto rewritten = gluten::rewriteJsonExtractions(expressions);
+  ASSERT_NE(std::dynamic_pointer_cast<const core::DereferenceTypedExpr>(rewritten[0]), nullptr);
+
+  // Each number is formatted the same way as by a single-path get_json_object.
+  auto evaluateAll = [&](const std::vector<core::TypedExprPtr>& exprs) {
+    exec::ExprSet exprSet(exprs, &execCtx_);
+    exec::EvalCtx evalCtx(&execCtx_, &exprSet, input.get());
+    SelectivityVector rows(input->size());
+    std::vector<VectorPtr> results(exprs.size());
+    exprSet.eval(rows, evalCtx, results);
+    return results;
+  };
+  auto expected = evaluateAll(expressions);
+  auto actual = evaluateAll(rewritten);
+  for (size_t i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]->toString());
+    assertEqualVectors(expected[i], actual[i]);
+  }
+}
@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "operators/functions/SparkExprToSubfieldFilterParser.h"
+
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+namespace gluten {
+
+// Checks that the subfield filters produced by SparkExprToSubfieldFilterParser prune Parquet row groups on their
+// min/max statistics, not only that the filters accept the right values.
+class SubfieldFilterPruningTest : public HiveConnectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    HiveConnectorTestBase::SetUpTestCase();
+    parquet::registerParquetReaderFactory();
+    exec::ExprToSubfieldFilterParser::registerParserFactory(
+        []() { return std::make_shared<SparkExprToSubfieldFilterParser>(); });
+  }
+
+  static void TearDownTestCase() {
+    parquet::unregisterParquetReaderFactory();
+    HiveConnectorTestBase::TearDownTestCase();
+  }
+
+  // Writes every vector as its own row group.
+  void writeParquet(const std::string& path, const std::vector<RowVectorPtr>& vectors) {
+    auto sink = std::make_unique<dwio::common::LocalFileSink>(path, dwio::common::FileSink::Options{.pool = pool()});
+    parquet::WriterOptions options;
+    auto writer = std::make_unique<parquet::Writer>(std::move(sink), options, rootPool_, asRowType(vectors[0]->type()));
+    for (const auto& vector : vectors) {
+      writer->write(vector);
+      writer->flush();
+    }
+    writer->close();
+  }
+
+  // Scans the file with the given filter pushed down and returns the number of skipped row groups.
+  int64_t scanWithFilter(
+      const std::string& path,
+      const RowTypePtr& rowType,
+      const core::TypedExprPtr& filterExpr,
+      const RowVectorPtr& expected) {
+    exec::SimpleExpressionEvaluator evaluator(queryCtx_.get(), pool());
+    auto [subfield, filter] = exec::toSubfieldFilter(filterExpr, &evaluator);
+    VELOX_CHECK_NOT_NULL(filter);
+    connector::hive::SubfieldFilters filters;
+    filters.emplace(std::move(subfield), std::move(filter));
+    auto tableHandle = std::make_shared<connector::hive::HiveTableHandle>(
+        kHiveConnectorId, "hive_table", true, std::move(filters), nullptr, rowType);
+
+    std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>> assignments;
+    for (auto i = 0; i < rowType->size(); ++i) {
+      assignments[rowType->nameOf(i)] = std::make_shared<connector::hive::HiveColumnHandle>(
+          rowType->nameOf(i),
+          connector::hive::HiveColumnHandle::ColumnType::kRegular,
+          rowType->childAt(i),
+          rowType->childAt(i));
+    }
+
+    core::PlanNodeId scanNodeId;
+    auto plan = PlanBuilder()
+                    .startTableScan()
+                    .outputType(rowType)
+                    .tableHandle(tableHandle)
+                    .assignments(assignments)
+                    .endTableScan()
+                    .capturePlanNodeId(scanNodeId)
+                    .planNode();
+    auto split = HiveConnectorSplitBuilder(path).fileFormat(dwio::common::FileFormat::PARQUET).build();
+    std::shared_ptr<exec::Task> task;
+    auto result = AssertQueryBuilder(plan).split(split).copyResults(pool(), task);
+    facebook::velox::test::assertEqualVectors(expected, result);
+
+    auto planStats = exec::toPlanStats(task->taskStats());
+    const auto& customStats = planStats.at(scanNodeId).customStats;
+    auto it = customStats.find("skippedStrides");
+    return it == customStats.end() ? 0 : it->second.sum;
+  }
+
+  static core::TypedExprPtr field(const TypePtr& type, const std::string& name) {
+    return std::make_shared<core::FieldAccessTypedExpr>(type, name);
+  }
+
+  static core::TypedExprPtr dereference(const core::TypedExprPtr& input, uint32_t index) {
+    return std::make_shared<core::DereferenceTypedExpr>(input->type()->childAt(index), input, index);
+  }
+
+  static core::TypedExprPtr call(const std::string& name, std::vector<core::TypedExprPtr> inputs) {
+    return std::make_shared<core::CallTypedExpr>(BOOLEAN(), std::move(inputs), name);
+  }
+
+  static core::TypedExprPtr constant(const TypePtr& type, const variant& value) {
+    return std::make_shared<core::ConstantTypedExpr>(type, value);
+  }
+
+  std::shared_ptr<core::QueryCtx> queryCtx_{core::QueryCtx::create()};
+};
+
+TEST_F(SubfieldFilterPruningTest, nestedFieldPrunesRowGroups) {
+  constexpr int32_t kRowsPerGroup = 100;
+  constexpr int32_t kNumGroups = 4;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t group = 0; group < kNumGroups; ++group) {
+    auto ids = makeFlatVector<int64_t>(kRowsPerGroup, [group](auto row) { return group * kRowsPerGroup + row; });
+    auto names = makeFlatVector<std::string>(
+        kRowsPerGroup, [group](auto row) { return fmt::format("user_{:04}", group * kRowsPerGroup + row); });
+    auto user = makeRowVector({"id", "name"}, {ids, names});
+    vectors.push_back(makeRowVector({"event"}, {makeRowVector({"user"}, {user})}));
+  }
+  auto rowType = asRowType(vectors[0]->type());
+  auto tempDir = TempDirectoryPath::create();
+  const auto path = tempDir->getPath() + "/nested.parquet";
+  writeParquet(path, vectors);
+
+  auto event = field(rowType->childAt(0), "event");
+  auto user = dereference(event, 0);
+
+  // event.user.id = 150 only matches the second row group.
+  auto expected = vectors[1]->slice(50, 1);
+  ASSERT_EQ(
+      scanWithFilter(path, rowType, call("equalto", {dereference(user, 0), constant(BIGINT(), 150L)}), expected),
+      kNumGroups - 1);
+
+  // A prefix match on a nested string is pruned the same way: only the last row group holds 'user_03..'.
+  expected = vectors[3];
+  ASSERT_EQ(
+      scanWithFilter(
+          path, rowType, call("startswith", {dereference(user, 1), constant(VARCHAR(), "user_03")}), expected),
+      kNumGroups - 1);
+}
+
+} // namespace gluten
@@ -0,0 +1,198 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/TieredSpillFileSystem.h"
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+constexpr uint64_t kMB = 1L << 20;
+constexpr uint64_t kCapacity = 4 * kMB;
+
+std::string makeData(uint64_t size, char seed) {
+  std::string data(size, 0);
+  for (uint64_t i = 0; i < size; ++i) {
+    data[i] = static_cast<char>(seed + i % 97);
+  }
+  return data;
+}
+} // namespace
+
+class TieredSpillFileSystemTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    filesystems::registerLocalFileSystem();
+    registerTieredSpillFileSystem(kCapacity);
+  }
+
+  void SetUp() override {
+    dir_ = "tiered:" + tempDir_->getPath();
+    fs_ = filesystems::getFileSystem(dir_, nullptr);
+  }
+
+  void TearDown() override {
+    fs_->rmdir(dir_);
+    ASSERT_EQ(tieredSpillStats().memoryUsedBytes, 0);
+  }
+
+  // Writes data in appends of at most 256KB.
+  void write(const std::string& name, const std::string& data) {
+    auto file = fs_->openFileForWrite(dir_ + "/" + name);
+    for (uint64_t offset = 0; offset < data.size(); offset += kMB / 4) {
+      file->append(std::string_view(data).substr(offset, kMB / 4));
+    }
+    ASSERT_EQ(file->size(), data.size());
+    file->close();
+  }
+
+  std::string read(const std::string& name) {
+    auto file = fs_->openFileForRead(dir_ + "/" + name);
+    std::string out(file->size(), 0);
+    file->pread(0, out.size(), out.data());
+    return out;
+  }
+
+  bool onDisk(const std::string& name) {
+    return std::filesystem::exists(tempDir_->getPath() + "/" + name);
+  }
+
+  std::shared_ptr<exec::test::TempDirectoryPath> tempDir_ = exec::test::TempDirectoryPath::create();
+  std::string dir_;
+  std::shared_ptr<filesystems::FileSystem> fs_;
+};
+
+TEST_F(TieredSpillFileSystemTest, memoryTier) {
+  auto before = tieredSpillStats();
+  auto data = makeData(kMB + kMB / 2, 'a');
+  write("run", data);
+  ASSERT_TRUE(fs_->exists(dir_ + "/run"));
+  ASSERT_FALSE(onDisk("run"));
+  ASSERT_EQ(read("run"), data);
+
+  auto file = fs_->openFileForRead(dir_ + "/run");
+  std::string part(kMB, 0);
+  file->pread(kMB / 2, kMB, part.data());
+  ASSERT_EQ(part, data.substr(kMB / 2, kMB));
+
+  auto after = tieredSpillStats();
+  ASSERT_EQ(after.memoryBytesWritten - before.memoryBytesWritten, data.size());
+  ASSERT_EQ(after.memoryBytesRead - before.memoryBytesRead, data.size() + kMB);
+  ASSERT_EQ(after.diskBytesWritten, before.diskBytesWritten);
+  ASSERT_EQ(after.memoryUsedBytes, data.size());
+
+  // The open reader keeps the blocks, so they stay accounted until it's dropped.
+  fs_->remove(dir_ + "/run");
+  ASSERT_FALSE(fs_->exists(dir_ + "/run"));
+  ASSERT_EQ(tieredSpillStats().memoryUsedBytes, data.size());
+  file.reset();
+  ASSERT_EQ(tieredSpillStats().memoryUsedBytes, 0);
+}
+
+TEST_F(TieredSpillFileSystemTest, demoteLeastRecentlyWritten) {
+  auto before = tieredSpillStats();
+  auto first = makeData(2 * kMB, 'a');
+  auto second = makeData(2 * kMB, 'b');
+  auto third = makeData(kMB, 'c');
+  write("first", first);
+  write("second", second);
+  write("third", third);
+
+  ASSERT_TRUE(onDisk("first"));
+  ASSERT_FALSE(onDisk("second"));
+  ASSERT_FALSE(onDisk("third"));
+  auto after = tieredSpillStats();
+  ASSERT_EQ(after.runsDemoted - before.runsDemoted, 1);
+  ASSERT_EQ(after.bytesDemoted - before.bytesDemoted, first.size());
+
+  ASSERT_EQ(read("first"), first);
+  ASSERT_EQ(read("second"), second);
+  ASSERT_EQ(read("third"), third);
+  ASSERT_EQ(tieredSpillStats().diskBytesRead - before.diskBytesRead, first.size());
+}
+
+TEST_F(TieredSpillFileSystemTest, runLargerThanCapacity) {
+  auto before = tieredSpillStats();
+  auto data = makeData(kCapacity + kMB, 'a');
+  write("run", data);
+  ASSERT_TRUE(onDisk("run"));
+  ASSERT_EQ(tieredSpillStats().diskBytesWritten - before.diskBytesWritten, data.size());
+  ASSERT_EQ(tieredSpillStats().memoryUsedBytes, 0);
+  ASSERT_EQ(read("run"), data);
+}
+
+TEST_F(TieredSpillFileSystemTest, listAndRename) {
+  write("disk", makeData(kCapacity + kMB, 'b'));
+  write("memory", makeData(kMB, 'a'));
+  ASSERT_TRUE(onDisk("disk"));
+  ASSERT_FALSE(onDisk("memory"));
+  auto files = fs_->list(dir_);
+  ASSERT_EQ(files.size(), 2);
+
+  auto data = read("memory");
+  fs_->rename(dir_ + "/memory", dir_ + "/renamed", false);
+  ASSERT_FALSE(fs_->exists(dir_ + "/memory"));
+  ASSERT_EQ(read("renamed"), data);
+}
+
+TEST_F(TieredSpillFileSystemTest, demotedReaderKeepsAccounting) {
+  auto first = makeData(2 * kMB, 'a');
+  write("first", first);
+  auto reader = fs_->openFileForRead(dir_ + "/first");
+
+  // Demotes 'first' while it's being read. Its blocks stay accounted until the reader is dropped, so the second run
+  // doesn't fit next to them and is written to disk.
+  write("second", makeData(3 * kMB, 'b'));
+  ASSERT_TRUE(onDisk("first"));
+  ASSERT_TRUE(onDisk("second"));
+  ASSERT_EQ(tieredSpillStats().memoryUsedBytes, first.size());
+  std::string out(first.size(), 0);
+  reader->pread(0, out.size(), out.data());
+  ASSERT_EQ(out, first);
+
+  reader.reset();
+  ASSERT_EQ(tieredSpillStats().memoryUsedBytes, 0);
+}
+
+TEST_F(TieredSpillFileSystemTest, perDirectoryStats) {
+  const auto taskDir = dir_ + "/task";
+  fs_->mkdir(taskDir);
+  fs_->mkdir(taskDir + "/sub");
+  write("task/kept", makeData(kMB, 'a'));
+  write("task/sub/demoted", makeData(2 * kMB, 'b'));
+  write("other", makeData(kMB, 'c'));
+  // Demotes 'kept' and then 'demoted'.
+  write("task/large", makeData(3 * kMB, 'd'));
+
+  // Only 'large' and 'other' are still in memory, and 'other' is not under the task directory.
+  ASSERT_EQ(tieredSpillMemoryResidentBytes(taskDir), 3 * kMB);
+  ASSERT_EQ(tieredSpillMemoryResidentBytes(taskDir + "/sub"), 0);
+  ASSERT_EQ(tieredSpillMemoryResidentBytes(dir_), 0);
+
+  fs_->rmdir(taskDir);
+  ASSERT_EQ(tieredSpillMemoryResidentBytes(taskDir), 0);
+}
+
+} // namespace gluten
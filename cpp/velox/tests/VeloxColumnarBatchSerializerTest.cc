@@ -26,6 +26,9 @@
 
 #include <arrow/buffer.h>
 
+#include <cstdlib>
+#include <limits>
+
 using namespace facebook::velox;
 
 namespace gluten {
@@ -65,4 +68,126 @@ TEST_F(VeloxColumnarBatchSerializerTest, serialize) {
   test::assertEqualVectors(vector, deserializedVector);
 }
 
+TEST_F(VeloxColumnarBatchSerializerTest, serializeToChunks) {
+  std::vector<std::shared_ptr<ColumnarBatch>> batches;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto vector = makeRowVector({
+        makeFlatVector<int64_t>(1000, [i](auto row) { return row + i; }),
+        makeFlatVector<StringView>(
+            1000, [](auto row) { return StringView::makeInline(std::to_string(row)); }, nullEvery(7)),
+    });
+    vectors.push_back(vector);
+    batches.push_back(std::make_shared<VeloxColumnarBatch>(vector));
+  }
+  auto expected = BaseVector::create<RowVector>(vectors[0]->type(), 0, pool());
+  for (auto& vector : vectors) {
+    expected->append(vector.get());
+  }
+
+  // A chunk size far smaller than a batch splits every page across many chunks.
+  const int64_t chunkSize = 1024;
+  auto serializer = std::make_shared<VeloxColumnarBatchSerializer>(arrowPool_.get(), pool_, nullptr);
+  auto chunks = serializer->serializeColumnarBatchesToChunks(batches, chunkSize);
+  ASSERT_GT(chunks.size(), 1);
+  std::vector<std::pair<uint8_t*, int64_t>> ranges;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    if (i + 1 < chunks.size()) {
+      ASSERT_EQ(chunks[i]->size(), chunkSize);
+    }
+    ranges.emplace_back(const_cast<uint8_t*>(chunks[i]->data()), chunks[i]->size());
+  }
+
+  ArrowSchema cSchema;
+  exportToArrow(vectors[0], cSchema, ArrowUtils::getBridgeOptions());
+  auto deserializer = std::make_shared<VeloxColumnarBatchSerializer>(arrowPool_.get(), pool_, &cSchema);
+  auto iter = deserializer->deserializeChunks(std::move(ranges));
+  auto actual = BaseVector::create<RowVector>(vectors[0]->type(), 0, pool());
+  while (auto batch = iter->next()) {
+    actual->append(std::dynamic_pointer_cast<VeloxColumnarBatch>(batch)->getRowVector().get());
+  }
+  test::assertEqualVectors(expected, actual);
+}
+
+// The >2GB relation case scaled down: every batch is larger than a chunk, so each one spans several chunks and the
+// relation is many times the chunk size, the same way a >2GB relation is many times the 2GB array limit.
+TEST_F(VeloxColumnarBatchSerializerTest, serializeToChunksLargerThanChunkSize) {
+  const int32_t numRows = 256;
+  const std::string value(1024, 'x');
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(numRows, [](auto row) { return row; }),
+      makeFlatVector<StringView>(numRows, [&](auto /*row*/) { return StringView(value); }),
+  });
+  // 160 batches of ~256KB each.
+  std::vector<std::shared_ptr<ColumnarBatch>> batches(160, std::make_shared<VeloxColumnarBatch>(vector));
+  const int64_t chunkSize = 32 << 10;
+
+  auto serializer = std::make_shared<VeloxColumnarBatchSerializer>(arrowPool_.get(), pool_, nullptr);
+  auto chunks = serializer->serializeColumnarBatchesToChunks(batches, chunkSize);
+  int64_t totalSize = 0;
+  std::vector<std::pair<uint8_t*, int64_t>> ranges;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    if (i + 1 < chunks.size()) {
+      ASSERT_EQ(chunks[i]->size(), chunkSize);
+    }
+    totalSize += chunks[i]->size();
+    ranges.emplace_back(const_cast<uint8_t*>(chunks[i]->data()), chunks[i]->size());
+  }
+  ASSERT_GT(totalSize, chunkSize * static_cast<int64_t>(batches.size()));
+
+  ArrowSchema cSchema;
+  exportToArrow(vector, cSchema, ArrowUtils::getBridgeOptions());
+  auto deserializer = std::make_shared<VeloxColumnarBatchSerializer>(arrowPool_.get(), pool_, &cSchema);
+  auto iter = deserializer->deserializeChunks(std::move(ranges));
+  int64_t numDeserializedRows = 0;
+  while (auto batch = iter->next()) {
+    auto rowVector = std::dynamic_pointer_cast<VeloxColumnarBatch>(batch)->getRowVector();
+    test::assertEqualVectors(vector, rowVector->slice(0, numRows));
+    numDeserializedRows += rowVector->size();
+  }
+  ASSERT_EQ(numDeserializedRows, static_cast<int64_t>(numRows) * batches.size());
+}
+
+// Serializes a relation larger than 2GB, which doesn't fit in a single Java byte array. It needs several GB of memory
+// and runs only when GLUTEN_RUN_SLOW_TESTS is set.
+TEST_F(VeloxColumnarBatchSerializerTest, serializeToChunksLargerThan2GB) {
+  if (std::getenv("GLUTEN_RUN_SLOW_TESTS") == nullptr) {
+    GTEST_SKIP() << "Slow test, set GLUTEN_RUN_SLOW_TESTS to run it";
+  }
+  const int32_t numRows = 16 * 1024;
+  const std::string value(1024, 'x');
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(numRows, [](auto row) { return row; }),
+      makeFlatVector<StringView>(numRows, [&](auto /*row*/) { return StringView(value); }),
+  });
+  // 160 batches of ~16MB each.
+  std::vector<std::shared_ptr<ColumnarBatch>> batches(160, std::make_shared<VeloxColumnarBatch>(vector));
+  const int64_t chunkSize = 8 << 20;
+
+  auto serializer = std::make_shared<VeloxColumnarBatchSerializer>(arrowPool_.get(), pool_, nullptr);
+  auto chunks = serializer->serializeColumnarBatchesToChunks(batches, chunkSize);
+  int64_t totalSize = 0;
+  std::vector<std::pair<uint8_t*, int64_t>> ranges;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    if (i + 1 < chunks.size()) {
+      ASSERT_EQ(chunks[i]->size(), chunkSize);
+    }
+    totalSize += chunks[i]->size();
+    ranges.emplace_back(const_cast<uint8_t*>(chunks[i]->data()), chunks[i]->size());
+  }
+  ASSERT_GT(totalSize, std::numeric_limits<int32_t>::max());
+
+  ArrowSchema cSchema;
+  exportToArrow(vector, cSchema, ArrowUtils::getBridgeOptions());
+  auto deserializer = std::make_shared<VeloxColumnarBatchSerializer>(arrowPool_.get(), pool_, &cSchema);
+  auto iter = deserializer->deserializeChunks(std::move(ranges));
+  int64_t numDeserializedRows = 0;
+  while (auto batch = iter->next()) {
+    auto rowVector = std::dynamic_pointer_cast<VeloxColumnarBatch>(batch)->getRowVector();
+    test::assertEqualVectors(vector, rowVector->slice(0, numRows));
+    numDeserializedRows += rowVector->size();
+  }
+  ASSERT_EQ(numDeserializedRows, static_cast<int64_t>(numRows) * batches.size());
+}
+
 } // namespace gluten
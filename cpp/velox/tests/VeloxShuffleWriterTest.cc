@@ -19,6 +19,8 @@
 #include <arrow/io/api.h>
 
 #include "shuffle/LocalPartitionWriter.h"
+#include "shuffle/ShuffleSortKeyEncoder.h"
+#include "shuffle/SparkMurmur3Hasher.h"
 #include "shuffle/VeloxHashShuffleWriter.h"
 #include "shuffle/VeloxRssSortShuffleWriter.h"
 #include "shuffle/VeloxShuffleWriter.h"
@@ -92,6 +94,18 @@ std::vector<ShuffleTestParams> createShuffleTestParams() {
       params.push_back(ShuffleTestParams{
           ShuffleWriterType::kHashShuffle, PartitionWriterType::kRss, compression, compressionThreshold});
     }
+    // Let the adaptive shuffle writer always pick the hash shuffle writer, or the sort shuffle writer if allowed.
+    params.push_back(ShuffleTestParams{
+        .shuffleWriterType = ShuffleWriterType::kAdaptiveShuffle,
+        .partitionWriterType = PartitionWriterType::kLocal,
+        .compressionType = compression,
+        .adaptiveMinHashBufferRows = 0,
+        .adaptiveMinRowsPerPartition = 0});
+    params.push_back(ShuffleTestParams{
+        .shuffleWriterType = ShuffleWriterType::kAdaptiveShuffle,
+        .partitionWriterType = PartitionWriterType::kLocal,
+        .compressionType = compression,
+        .adaptiveMinHashBufferRows = std::numeric_limits<int32_t>::max()});
   }
 
   return params;
@@ -250,6 +264,164 @@ TEST_P(HashPartitioningShuffleWriter, hashLargeVectors) {
       *shuffleWriter, {hashInputVector2_, hashInputVector1_}, 2, inputVector1_->type(), {{blockPid2}, {blockPid1}});
 }
 
+TEST_P(HashPartitioningShuffleWriter, fusedHashPartitionKeys) {
+  ASSERT_NOT_OK(initShuffleWriterOptions());
+  shuffleWriterOptions_.hashPartitionKeys = {0};
+  auto shuffleWriter = createShuffleWriter(defaultArrowMemoryPool().get());
+  // pmod(hash(key), 2) is 0 for keys 2, 4 and 5. No hash column is prepended or stripped.
+  auto vector = makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 3, 4, 5, 6, 7, 8}),
+      makeFlatVector<velox::StringView>({"a", "b", "c", "d", "e", "f", "g", "h"}),
+  });
+  auto firstBlock = takeRows({vector}, {{1, 3, 4}});
+  auto secondBlock = takeRows({vector}, {{0, 2, 5, 6, 7}});
+
+  testShuffleWriteMultiBlocks(*shuffleWriter, {vector}, 2, vector->type(), {{firstBlock}, {secondBlock}});
+}
+
+TEST_P(HashPartitioningShuffleWriter, adaptiveDecision) {
+  if (GetParam().shuffleWriterType != kAdaptiveShuffle) {
+    return;
+  }
+  const auto expectedWriterType = GetParam().adaptiveMinHashBufferRows == 0 ? kHashShuffle : kSortShuffle;
+  {
+    ASSERT_NOT_OK(initShuffleWriterOptions());
+    auto shuffleWriter = createShuffleWriter(defaultArrowMemoryPool().get());
+    auto blockPid2 =
+        takeRows({inputVector1_, inputVector2_, inputVector1_}, {{1, 2, 3, 4, 8}, {0, 1}, {1, 2, 3, 4, 8}});
+    auto blockPid1 = takeRows({inputVector1_}, {{0, 5, 6, 7, 9, 0, 5, 6, 7, 9}});
+    // The reader detects the chosen writer from the payloads.
+    testShuffleWriteMultiBlocks(
+        *shuffleWriter,
+        {hashInputVector1_, hashInputVector2_, hashInputVector1_},
+        2,
+        inputVector1_->type(),
+        {{blockPid2}, {blockPid1}});
+
+    const auto& decision = shuffleWriter->metrics().adaptiveDecision;
+    ASSERT_TRUE(decision.has_value());
+    ASSERT_EQ(decision->writerType, expectedWriterType);
+    ASSERT_EQ(decision->sampledRows, 22);
+    ASSERT_EQ(decision->activePartitions, 2);
+  }
+  // Without a primitive column the payloads of both writers have a single buffer, so the hash shuffle writer is kept.
+  {
+    ASSERT_NOT_OK(initShuffleWriterOptions());
+    auto shuffleWriter = createShuffleWriter(defaultArrowMemoryPool().get());
+    auto dataVector = makeRowVector({
+        makeArrayVector<int64_t>({{1, 2, 3}, {4}, {}, {5, 6}}),
+        makeMapVector<int32_t, velox::StringView>({{{1, "a"}}, {}, {{2, "b"}, {3, "c"}}, {{4, "d"}}}),
+    });
+    auto children = dataVector->children();
+    children.insert(children.begin(), makeFlatVector<int32_t>({1, 2, 1, 2}));
+    auto vector = makeRowVector(children);
+    auto firstBlock = takeRows({dataVector}, {{1, 3}});
+    auto secondBlock = takeRows({dataVector}, {{0, 2}});
+
+    testShuffleWriteMultiBlocks(*shuffleWriter, {vector}, 2, dataVector->type(), {{firstBlock}, {secondBlock}});
+    ASSERT_EQ(shuffleWriter->metrics().adaptiveDecision->writerType, kHashShuffle);
+  }
+}
+
+TEST_P(HashPartitioningShuffleWriter, sortKeys) {
+  if (GetParam().shuffleWriterType != kSortShuffle && GetParam().shuffleWriterType != kAdaptiveShuffle) {
+    return;
+  }
+  ASSERT_NOT_OK(initShuffleWriterOptions());
+  shuffleWriterOptions_.sortKeys = {ShuffleSortKey{.channel = 0}};
+  auto shuffleWriter = createShuffleWriter(defaultArrowMemoryPool().get());
+
+  auto vector1 = makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 1, 2, 1, 2}),
+      makeNullableFlatVector<int64_t>({5, 3, 1, 6, std::nullopt, 2}),
+      makeFlatVector<velox::StringView>({"a", "b", "c", "d", "e", "f"}),
+  });
+  auto vector2 = makeRowVector({
+      makeFlatVector<int32_t>({2, 1, 2, 1}),
+      makeFlatVector<int64_t>({4, 0, 1, 7}),
+      makeFlatVector<velox::StringView>({"g", "h", "i", "j"}),
+  });
+  // Spill in between so that each partition consists of two sorted runs.
+  ASSERT_NOT_OK(splitRowVector(*shuffleWriter, vector1));
+  int64_t evicted;
+  ASSERT_NOT_OK(shuffleWriter->reclaimFixedSize(1 << 30, &evicted));
+  ASSERT_NOT_OK(splitRowVector(*shuffleWriter, vector2));
+
+  // Each run is sorted by the key, with nulls first.
+  auto firstBlock = makeRowVector({
+      makeFlatVector<int64_t>({2, 3, 6, 1, 4}),
+      makeFlatVector<velox::StringView>({"f", "b", "d", "i", "g"}),
+  });
+  auto secondBlock = makeRowVector({
+      makeNullableFlatVector<int64_t>({std::nullopt, 1, 5, 0, 7}),
+      makeFlatVector<velox::StringView>({"e", "c", "a", "h", "j"}),
+  });
+  shuffleWriteReadMultiBlocks(*shuffleWriter, 2, firstBlock->type(), {{firstBlock}, {secondBlock}});
+}
+
+TEST_P(HashPartitioningShuffleWriter, shuffleSortKeyEncoder) {
+  const std::string withZero("a\0b", 3);
+  auto rv = makeRowVector({
+      makeNullableFlatVector<int64_t>({-5, 3, std::nullopt, 0, -1}),
+      makeFlatVector<double>(
+          {std::numeric_limits<double>::quiet_NaN(), -0.0, 1.5, 0.0, -std::numeric_limits<double>::infinity()}),
+      makeFlatVector<velox::StringView>({"a", velox::StringView(withZero), "", "ab", "b"}),
+  });
+  auto sortedRows = [&](const ShuffleSortKey& key) {
+    ShuffleSortKeyEncoder encoder({key});
+    encoder.encode(*rv);
+    std::vector<int32_t> rows{0, 1, 2, 3, 4};
+    std::stable_sort(rows.begin(), rows.end(), [&](auto lhs, auto rhs) { return encoder.key(lhs) < encoder.key(rhs); });
+    return rows;
+  };
+  ASSERT_EQ(sortedRows({.channel = 0}), std::vector<int32_t>({2, 0, 4, 3, 1}));
+  ASSERT_EQ(sortedRows({.channel = 0, .ascending = false, .nullsFirst = false}), std::vector<int32_t>({1, 3, 4, 0, 2}));
+  // -0.0 equals 0.0, and NaN is greater than any other value.
+  ASSERT_EQ(sortedRows({.channel = 1}), std::vector<int32_t>({4, 1, 3, 2, 0}));
+  ShuffleSortKeyEncoder encoder({{.channel = 1}});
+  encoder.encode(*rv);
+  ASSERT_EQ(encoder.key(1), encoder.key(3));
+  ASSERT_EQ(sortedRows({.channel = 2}), std::vector<int32_t>({2, 0, 1, 3, 4}));
+  ASSERT_EQ(sortedRows({.channel = 2, .ascending = false}), std::vector<int32_t>({4, 3, 1, 0, 2}));
+}
+
+TEST(SparkMurmur3HasherTest, sparkCompatible) {
+  // Expected values are from Spark's `hash` function.
+  constexpr auto kSeed = SparkMurmur3Hasher::kSeed;
+  ASSERT_EQ(SparkMurmur3Hasher::hashInt(1, kSeed), -559580957);
+  ASSERT_EQ(SparkMurmur3Hasher::hashLong(1, kSeed), -1712319331);
+  ASSERT_EQ(SparkMurmur3Hasher::hashBytes("abc", 3, kSeed), 1322437556);
+  ASSERT_EQ(SparkMurmur3Hasher::hashBytes("", 0, kSeed), 142593372);
+  // Trailing bytes are sign-extended.
+  ASSERT_EQ(SparkMurmur3Hasher::hashBytes("\xe4\xbd\xa0", 3, kSeed), -475662189);
+  // hash('Spark', 123, 2)
+  auto hash = SparkMurmur3Hasher::hashBytes("Spark", 5, kSeed);
+  hash = SparkMurmur3Hasher::hashInt(123, hash);
+  ASSERT_EQ(SparkMurmur3Hasher::hashInt(2, hash), -1321691492);
+}
+
+TEST_P(HashPartitioningShuffleWriter, sparkMurmur3Hasher) {
+  constexpr auto kSeed = SparkMurmur3Hasher::kSeed;
+  auto rv = makeRowVector({
+      makeNullableFlatVector<int32_t>({1, std::nullopt, 1}),
+      makeFlatVector<velox::StringView>({"a", "a", "abc"}),
+      makeFlatVector<double>({1.5, 0.0, -0.0}),
+  });
+  SparkMurmur3Hasher hasher({0, 1});
+  auto hashes = hasher.hash(*rv);
+  ASSERT_EQ(hashes[0], -936062819);
+  // Null keys leave the hash unchanged.
+  ASSERT_EQ(hashes[1], SparkMurmur3Hasher::hashBytes("a", 1, kSeed));
+  ASSERT_EQ(hashes[2], SparkMurmur3Hasher::hashBytes("abc", 3, SparkMurmur3Hasher::hashInt(1, kSeed)));
+
+  SparkMurmur3Hasher doubleHasher({2});
+  hashes = doubleHasher.hash(*rv);
+  ASSERT_EQ(hashes[0], 1290763749);
+  // -0.0 is hashed as 0.0.
+  ASSERT_EQ(hashes[1], -1670924195);
+  ASSERT_EQ(hashes[2], -1670924195);
+}
+
 TEST_P(RangePartitioningShuffleWriter, rangePartition) {
   ASSERT_NOT_OK(initShuffleWriterOptions());
   auto shuffleWriter = createShuffleWriter(defaultArrowMemoryPool().get());
@@ -0,0 +1,169 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arrow/util/io_util.h>
+#include <filesystem>
+#include <limits>
+
+#include "memory/ArrowMemoryPool.h"
+#include "utils/VeloxSortedRunMerger.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+namespace {
+class BatchList : public ColumnarBatchIterator {
+ public:
+  explicit BatchList(std::vector<RowVectorPtr> vectors) : vectors_(std::move(vectors)) {}
+
+  std::shared_ptr<ColumnarBatch> next() override {
+    if (cursor_ >= vectors_.size()) {
+      return nullptr;
+    }
+    return std::make_shared<VeloxColumnarBatch>(vectors_[cursor_++]);
+  }
+
+ private:
+  std::vector<RowVectorPtr> vectors_;
+  size_t cursor_ = 0;
+};
+} // namespace
+
+class VeloxSortedRunMergerTest : public ::testing::Test, public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    GLUTEN_ASSIGN_OR_THROW(spillDir_, arrow::internal::TemporaryDir::Make("velox-sorted-run-merger-"));
+  }
+
+  std::unique_ptr<VeloxSortedRunMerger> makeMerger(
+      std::vector<RowVectorPtr> input,
+      std::vector<ShuffleSortKey> sortKeys,
+      int32_t batchSize,
+      int64_t memoryLimit = std::numeric_limits<int64_t>::max()) {
+    return std::make_unique<VeloxSortedRunMerger>(
+        defaultArrowMemoryPool().get(),
+        rootPool_->addLeafChild("merger"),
+        std::move(sortKeys),
+        batchSize,
+        memoryLimit,
+        spillDir_->path().ToString(),
+        std::make_unique<BatchList>(std::move(input)));
+  }
+
+  std::vector<RowVectorPtr> drain(VeloxSortedRunMerger& merger) {
+    std::vector<RowVectorPtr> output;
+    while (auto batch = merger.next()) {
+      output.push_back(VeloxColumnarBatch::from(pool(), batch)->getRowVector());
+    }
+    return output;
+  }
+
+  RowVectorPtr concat(const std::vector<RowVectorPtr>& vectors) {
+    auto result = RowVector::createEmpty(vectors[0]->type(), pool());
+    for (const auto& vector : vectors) {
+      result->append(vector.get());
+    }
+    return result;
+  }
+
+  std::vector<RowVectorPtr> input() {
+    // Four runs: {1, 3, 5, 8}, {2, 4}, {0, 6, null}, {7}.
+    return {
+        makeRowVector({
+            makeFlatVector<int64_t>({1, 3, 5}),
+            makeFlatVector<StringView>({"a", "b", "c"}),
+        }),
+        makeRowVector({
+            makeFlatVector<int64_t>({8, 2, 4}),
+            makeFlatVector<StringView>({"d", "e", "f"}),
+        }),
+        makeRowVector({
+            makeNullableFlatVector<int64_t>({0, 6, std::nullopt, 7}),
+            makeFlatVector<StringView>({"g", "h", "i", "j"}),
+        }),
+    };
+  }
+
+  std::unique_ptr<arrow::internal::TemporaryDir> spillDir_;
+};
+
+TEST_F(VeloxSortedRunMergerTest, mergeRuns) {
+  auto merger = makeMerger(input(), {{.channel = 0, .ascending = true, .nullsFirst = false}}, 4);
+  auto output = drain(*merger);
+  ASSERT_EQ(output.size(), 3);
+  ASSERT_EQ(output[0]->size(), 4);
+  test::assertEqualVectors(
+      makeRowVector({
+          makeNullableFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, std::nullopt}),
+          makeFlatVector<StringView>({"g", "a", "e", "b", "f", "c", "h", "j", "d", "i"}),
+      }),
+      concat(output));
+}
+
+TEST_F(VeloxSortedRunMergerTest, spill) {
+  // Every chunk is spilled right after it is read.
+  auto merger = makeMerger(input(), {{.channel = 0, .ascending = true, .nullsFirst = false}}, 4, 0);
+  auto output = drain(*merger);
+  test::assertEqualVectors(
+      makeRowVector({
+          makeNullableFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, std::nullopt}),
+          makeFlatVector<StringView>({"g", "a", "e", "b", "f", "c", "h", "j", "d", "i"}),
+      }),
+      concat(output));
+  ASSERT_FALSE(std::filesystem::is_empty(spillDir_->path().ToString()));
+  merger.reset();
+  ASSERT_TRUE(std::filesystem::is_empty(spillDir_->path().ToString()));
+}
+
+TEST_F(VeloxSortedRunMergerTest, descendingKeysAndStableOrder) {
+  auto merger = makeMerger(
+      {
+          makeRowVector({
+              makeFlatVector<int32_t>({3, 3, 1}),
+              makeFlatVector<StringView>({"a", "b", "c"}),
+          }),
+          makeRowVector({
+              makeFlatVector<int32_t>({3, 2}),
+              makeFlatVector<StringView>({"d", "e"}),
+          }),
+      },
+      {{.channel = 0, .ascending = false}},
+      100);
+  test::assertEqualVectors(
+      makeRowVector({
+          makeFlatVector<int32_t>({3, 3, 3, 2, 1}),
+          makeFlatVector<StringView>({"a", "b", "d", "e", "c"}),
+      }),
+      concat(drain(*merger)));
+}
+
+TEST_F(VeloxSortedRunMergerTest, singleRunPassesThrough) {
+  auto first = makeRowVector({makeFlatVector<int64_t>({1, 2})});
+  auto second = makeRowVector({makeFlatVector<int64_t>({2, 5})});
+  auto merger = makeMerger({first, second}, {{.channel = 0}}, 1);
+  auto output = drain(*merger);
+  ASSERT_EQ(output.size(), 2);
+  ASSERT_EQ(output[0], first);
+  ASSERT_EQ(output[1], second);
+}
+
+} // namespace gluten
@@ -0,0 +1,394 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/HedgedReadFile.h"
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <numeric>
+#include <unordered_map>
+
+#include <folly/ScopeGuard.h>
+#include <glog/logging.h>
+
+#include "velox/common/file/FileSystems.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+uint32_t ReadLatencyHistogram::bucketOf(uint64_t micros) {
+  if (micros <= 1) {
+    return 0;
+  }
+  auto bucket = static_cast<uint32_t>(std::log2(static_cast<double>(micros)) * kBucketsPerOctave);
+  return std::min(bucket, kNumBuckets - 1);
+}
+
+uint64_t ReadLatencyHistogram::upperBoundOf(uint32_t bucket) {
+  return static_cast<uint64_t>(std::ceil(std::exp2(static_cast<double>(bucket + 1) / kBucketsPerOctave)));
+}
+
+void ReadLatencyHistogram::record(uint64_t micros) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++counts_[bucketOf(micros)];
+  ++total_;
+  ++recorded_;
+  if (++recordedSinceDecay_ < kWindow) {
+    return;
+  }
+  for (auto& count : counts_) {
+    count /= 2;
+  }
+  total_ = std::accumulate(counts_.begin(), counts_.end(), uint64_t{0});
+  recordedSinceDecay_ = 0;
+}
+
+std::optional<uint64_t> ReadLatencyHistogram::percentile(double fraction, uint64_t minSamples) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (recorded_ < minSamples || total_ == 0) {
+    return std::nullopt;
+  }
+  auto target = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total_)));
+  uint64_t seen = 0;
+  for (uint32_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+    seen += counts_[bucket];
+    if (seen >= target) {
+      return upperBoundOf(bucket);
+    }
+  }
+  return upperBoundOf(kNumBuckets - 1);
+}
+
+std::shared_ptr<HedgedReadStorage> HedgedReadStorage::get(const std::string& name) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<HedgedReadStorage>> storages;
+  std::lock_guard<std::mutex> l(mutex);
+  auto& storage = storages[name];
+  if (!storage) {
+    storage = std::make_shared<HedgedReadStorage>();
+  }
+  return storage;
+}
+
+HedgeBudget& HedgeBudget::global() {
+  static HedgeBudget budget;
+  return budget;
+}
+
+void HedgeBudget::earn(double ratio) {
+  std::lock_guard<std::mutex> l(mutex_);
+  tokens_ = std::min(kMaxTokens, tokens_ + ratio);
+}
+
+bool HedgeBudget::tryAcquire() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (tokens_ < 1) {
+    return false;
+  }
+  tokens_ -= 1;
+  return true;
+}
+
+namespace {
+
+uint64_t elapsedMicros(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// One attempt of a hedged read, into memory of its own laid out as the caller's buffers. A buffer without data, which
+// skips its bytes, is skipped by the attempt as well.
+struct ReadAttempt {
+  std::string data;
+  std::vector<folly::Range<char*>> buffers;
+  uint64_t bytes{0};
+  bool finished{false};
+  std::exception_ptr error;
+
+  void allocate(const std::vector<folly::Range<char*>>& target) {
+    uint64_t size = 0;
+    for (const auto& buffer : target) {
+      size += buffer.data() ? buffer.size() : 0;
+    }
+    data.resize(size);
+    char* next = data.data();
+    for (const auto& buffer : target) {
+      buffers.emplace_back(buffer.data() ? next : nullptr, buffer.size());
+      next += buffer.data() ? buffer.size() : 0;
+    }
+  }
+
+  void copyTo(const std::vector<folly::Range<char*>>& target) const {
+    for (size_t i = 0; i < target.size(); ++i) {
+      if (target[i].data()) {
+        std::memcpy(target[i].data(), buffers[i].data(), target[i].size());
+      }
+    }
+  }
+
+  bool succeeded() const {
+    return finished && !error;
+  }
+};
+
+// The attempts of one read of HedgedReadFile, shared with the executor, which may finish the losing one after the read
+// returned.
+struct HedgedRequest {
+  std::mutex mutex;
+  std::condition_variable changed;
+  ReadAttempt primary;
+  ReadAttempt hedge;
+  bool hedgeIssued{false};
+
+  // Runs `read` for `attempt`, and wakes up the reader.
+  void run(ReadAttempt& attempt, const std::function<uint64_t()>& read) {
+    uint64_t bytes = 0;
+    std::exception_ptr error;
+    try {
+      bytes = read();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> l(mutex);
+    attempt.bytes = bytes;
+    attempt.error = error;
+    attempt.finished = true;
+    changed.notify_all();
+  }
+
+  // The first attempt which succeeded is taken, a failed one only once the other one is over as well.
+  bool decided() const {
+    return primary.succeeded() || hedge.succeeded() || (primary.finished && (!hedgeIssued || hedge.finished));
+  }
+};
+
+} // namespace
+
+HedgedReadFile::HedgedReadFile(
+    std::shared_ptr<ReadFile> primary,
+    std::function<std::shared_ptr<ReadFile>()> openBackup,
+    std::shared_ptr<HedgedReadStorage> storage,
+    HedgeBudget& budget,
+    const HedgedReadOptions& options,
+    folly::Executor* executor)
+    : primary_(std::move(primary)),
+      backup_(std::make_shared<Backup>(std::move(openBackup))),
+      storage_(std::move(storage)),
+      budget_(budget),
+      options_(options),
+      executor_(executor) {}
+
+std::shared_ptr<ReadFile> HedgedReadFile::Backup::get() {
+  std::lock_guard<std::mutex> l(mutex);
+  if (!file) {
+    file = open();
+  }
+  return file;
+}
+
+std::string_view HedgedReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  std::string_view out{static_cast<char*>(buf), length};
+  hedgedRead(offset, {folly::Range<char*>(static_cast<char*>(buf), length)}, [&]() -> uint64_t {
+    out = primary_->pread(offset, length, buf);
+    return out.size();
+  });
+  return out;
+}
+
+uint64_t HedgedReadFile::preadv(uint64_t offset, const std::vector<folly::Range<char*>>& buffers) const {
+  return hedgedRead(offset, buffers, [&] { return primary_->preadv(offset, buffers); });
+}
+
+uint64_t HedgedReadFile::hedgedRead(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    const std::function<uint64_t()>& direct) const {
+  ++storage_->reads;
+  budget_.earn(options_.budgetRatio);
+  auto threshold = storage_->latencies.percentile(options_.percentile, options_.minSamples);
+  auto start = std::chrono::steady_clock::now();
+  if (!threshold.has_value()) {
+    auto bytes = direct();
+    storage_->latencies.record(elapsedMicros(start));
+    return bytes;
+  }
+
+  auto request = std::make_shared<HedgedRequest>();
+  request->primary.allocate(buffers);
+  try {
+    // A slow primary read which lost to its hedge still counts with the time it had taken, so that the tail stays in
+    // the histogram.
+    executor_->add([request, primary = primary_, storage = storage_, offset, start]() {
+      request->run(request->primary, [&] {
+        SCOPE_EXIT {
+          storage->latencies.record(elapsedMicros(start));
+        };
+        return primary->preadv(offset, request->primary.buffers);
+      });
+    });
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to schedule a read of " << getName() << ": " << e.what();
+    auto bytes = direct();
+    storage_->latencies.record(elapsedMicros(start));
+    return bytes;
+  }
+
+  // The hedge is issued if the primary read has not completed within the delay.
+  auto delay = std::chrono::microseconds(std::max<uint64_t>(threshold.value(), options_.minDelayMs * 1000));
+  std::unique_lock<std::mutex> l(request->mutex);
+  if (!request->changed.wait_for(l, delay, [&] { return request->primary.finished; }) && budget_.tryAcquire()) {
+    ++storage_->hedges;
+    request->hedge.allocate(buffers);
+    try {
+      executor_->add([request, backup = backup_, offset]() {
+        request->run(request->hedge, [&] {
+          try {
+            return backup->get()->preadv(offset, request->hedge.buffers);
+          } catch (const std::exception& e) {
+            LOG(WARNING) << "Hedged read failed: " << e.what();
+            throw;
+          }
+        });
+      });
+      request->hedgeIssued = true;
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to schedule a hedged read of " << getName() << ": " << e.what();
+    }
+  }
+  request->changed.wait(l, [&] { return request->decided(); });
+  const bool useHedge = !request->primary.succeeded() && request->hedge.succeeded();
+  l.unlock();
+
+  // The attempt taken is over, and no one writes into its memory any more.
+  const auto& attempt = useHedge ? request->hedge : request->primary;
+  if (attempt.error) {
+    std::rethrow_exception(attempt.error);
+  }
+  if (useHedge) {
+    ++storage_->hedgeWins;
+  }
+  attempt.copyTo(buffers);
+  return attempt.bytes;
+}
+
+namespace {
+
+constexpr std::array<std::string_view, 11> kRemoteSchemes{
+    "hdfs://", "viewfs://", "s3://", "s3a://", "s3n://", "oss://", "cos://", "cosn://", "gs://", "abfs://", "abfss://"};
+
+bool isRemote(std::string_view path) {
+  for (auto scheme : kRemoteSchemes) {
+    if (path.substr(0, scheme.size()) == scheme) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The scheme and authority of the path, e.g. "s3a://bucket".
+std::string storageName(std::string_view path) {
+  auto authority = path.find("://") + 3;
+  return std::string(path.substr(0, path.find('/', authority)));
+}
+
+// Set while the hedged read file system looks up the file system it wraps, which is the next one matching the path.
+thread_local bool resolvingDelegate = false;
+
+class HedgedReadFileSystem : public filesystems::FileSystem {
+ public:
+  HedgedReadFileSystem(
+      std::shared_ptr<FileSystem> fs,
+      std::shared_ptr<HedgedReadStorage> storage,
+      const HedgedReadOptions& options,
+      folly::Executor* executor)
+      : FileSystem({}), fs_(std::move(fs)), storage_(std::move(storage)), options_(options), executor_(executor) {}
+
+  std::string name() const override {
+    return fs_->name();
+  }
+
+  std::unique_ptr<ReadFile> openFileForRead(
+      std::string_view path,
+      const filesystems::FileOptions& options) override {
+    std::shared_ptr<ReadFile> primary = fs_->openFileForRead(path, options);
+    auto openBackup = [fs = fs_, path = std::string(path), options]() -> std::shared_ptr<ReadFile> {
+      return fs->openFileForRead(path, options);
+    };
+    return std::make_unique<HedgedReadFile>(
+        std::move(primary), std::move(openBackup), storage_, HedgeBudget::global(), options_, executor_);
+  }
+
+  std::unique_ptr<WriteFile> openFileForWrite(
+      std::string_view path,
+      const filesystems::FileOptions& options) override {
+    return fs_->openFileForWrite(path, options);
+  }
+
+  void remove(std::string_view path) override {
+    fs_->remove(path);
+  }
+
+  void rename(std::string_view oldPath, std::string_view newPath, bool overwrite) override {
+    fs_->rename(oldPath, newPath, overwrite);
+  }
+
+  bool exists(std::string_view path) override {
+    return fs_->exists(path);
+  }
+
+  std::vector<std::string> list(std::string_view path) override {
+    return fs_->list(path);
+  }
+
+  void mkdir(std::string_view path, const filesystems::DirectoryOptions& options = {}) override {
+    fs_->mkdir(path, options);
+  }
+
+  void rmdir(std::string_view path) override {
+    fs_->rmdir(path);
+  }
+
+ private:
+  const std::shared_ptr<FileSystem> fs_;
+  const std::shared_ptr<HedgedReadStorage> storage_;
+  const HedgedReadOptions options_;
+  folly::Executor* const executor_;
+};
+
+} // namespace
+
+void registerHedgedReadFileSystem(const HedgedReadOptions& options, folly::Executor* executor) {
+  auto schemeMatcher = [](std::string_view filePath) { return !resolvingDelegate && isRemote(filePath); };
+  auto fileSystemGenerator =
+      [options, executor](
+          std::shared_ptr<const config::ConfigBase> properties,
+          std::string_view filePath) -> std::shared_ptr<filesystems::FileSystem> {
+    resolvingDelegate = true;
+    SCOPE_EXIT {
+      resolvingDelegate = false;
+    };
+    auto fs = filesystems::getFileSystem(filePath, properties);
+    return std::make_shared<HedgedReadFileSystem>(
+        std::move(fs), HedgedReadStorage::get(storageName(filePath)), options, executor);
+  };
+  filesystems::registerFileSystem(schemeMatcher, fileSystemGenerator);
+}
+
+} // namespace gluten
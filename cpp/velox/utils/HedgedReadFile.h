@@ -0,0 +1,186 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <folly/Executor.h>
+#include <folly/Range.h>
+
+#include "velox/common/file/File.h"
+
+namespace gluten {
+
+/// Rolling latency histogram of the reads of one storage. Latencies fall into log-spaced buckets, four per power of two
+/// of microseconds, and all counts are halved every kWindow samples so that the percentiles follow the recent reads.
+class ReadLatencyHistogram {
+ public:
+  static constexpr uint64_t kWindow = 1024;
+
+  void record(uint64_t micros);
+
+  /// The latency in microseconds under which the given fraction of the recent reads completed, or std::nullopt while
+  /// fewer than minSamples reads have been recorded.
+  std::optional<uint64_t> percentile(double fraction, uint64_t minSamples) const;
+
+ private:
+  static constexpr uint32_t kBucketsPerOctave = 4;
+  static constexpr uint32_t kNumBuckets = 40 * kBucketsPerOctave;
+
+  static uint32_t bucketOf(uint64_t micros);
+  static uint64_t upperBoundOf(uint32_t bucket);
+
+  mutable std::mutex mutex_;
+  std::array<uint64_t, kNumBuckets> counts_{};
+  uint64_t total_{0};
+  uint64_t recordedSinceDecay_{0};
+  uint64_t recorded_{0};
+};
+
+/// Latencies and hedging counters of one storage, e.g. an HDFS name service or an S3 bucket.
+struct HedgedReadStorage {
+  ReadLatencyHistogram latencies;
+  std::atomic<uint64_t> reads{0};
+  std::atomic<uint64_t> hedges{0};
+  std::atomic<uint64_t> hedgeWins{0};
+
+  static std::shared_ptr<HedgedReadStorage> get(const std::string& name);
+};
+
+/// Budget of duplicate requests shared by all storages. Every read earns `ratio` of a hedge, and at most kMaxTokens
+/// hedges are saved up, so a storage which becomes slow all at once does not see its load doubled.
+class HedgeBudget {
+ public:
+  static constexpr double kMaxTokens = 16;
+
+  static HedgeBudget& global();
+
+  void earn(double ratio);
+  bool tryAcquire();
+
+ private:
+  std::mutex mutex_;
+  double tokens_{0};
+};
+
+struct HedgedReadOptions {
+  // A read slower than this percentile of the recent reads of its storage is hedged.
+  double percentile{0.95};
+  // Lower bound of the hedging delay, so that fast storages are not hedged on noise.
+  uint64_t minDelayMs{5};
+  // Reads of a storage observed before its percentile is trusted.
+  uint64_t minSamples{100};
+  // At most this fraction of the reads of the process is hedged.
+  double budgetRatio{0.05};
+};
+
+/// Reads a remote file. A read which has not completed within the rolling latency percentile of its storage issues the
+/// same read through a second file, opened from the same path, so that HDFS may serve it from another replica. The
+/// first response is taken.
+///
+/// Until the percentile of the storage is known, a read goes straight to the primary file. Afterwards the primary read
+/// is issued as a single request on the executor, into memory of its own, and the calling thread waits for it. If it
+/// has not completed within the delay, the hedge is issued on the executor as well. The memory of the first attempt
+/// which completes is copied to the caller's buffers, and the other attempt runs to its end in the background, since
+/// Velox files can't be interrupted.
+class HedgedReadFile : public facebook::velox::ReadFile {
+ public:
+  HedgedReadFile(
+      std::shared_ptr<facebook::velox::ReadFile> primary,
+      std::function<std::shared_ptr<facebook::velox::ReadFile>()> openBackup,
+      std::shared_ptr<HedgedReadStorage> storage,
+      HedgeBudget& budget,
+      const HedgedReadOptions& options,
+      folly::Executor* executor);
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf) const override;
+
+  using facebook::velox::ReadFile::preadv;
+
+  uint64_t preadv(uint64_t offset, const std::vector<folly::Range<char*>>& buffers) const override;
+
+  folly::SemiFuture<uint64_t> preadvAsync(uint64_t offset, const std::vector<folly::Range<char*>>& buffers)
+      const override {
+    return primary_->preadvAsync(offset, buffers);
+  }
+
+  bool hasPreadvAsync() const override {
+    return primary_->hasPreadvAsync();
+  }
+
+  bool shouldCoalesce() const override {
+    return primary_->shouldCoalesce();
+  }
+
+  uint64_t size() const override {
+    return primary_->size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return primary_->memoryUsage();
+  }
+
+  std::string getName() const override {
+    return primary_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return primary_->getNaturalReadSize();
+  }
+
+ private:
+  // Reads `buffers` from `offset`, hedging the read once the percentile of the storage is known. `direct` reads them
+  // from the primary file in the calling thread, and returns what pread or preadv of the primary file returns.
+  uint64_t hedgedRead(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      const std::function<uint64_t()>& direct) const;
+
+  // The second file, opened on the first hedge. It is shared with the hedges, which may outlive this file.
+  struct Backup {
+    explicit Backup(std::function<std::shared_ptr<facebook::velox::ReadFile>()> openFile) : open(std::move(openFile)) {}
+
+    std::shared_ptr<facebook::velox::ReadFile> get();
+
+    const std::function<std::shared_ptr<facebook::velox::ReadFile>()> open;
+    std::mutex mutex;
+    std::shared_ptr<facebook::velox::ReadFile> file;
+  };
+
+  const std::shared_ptr<facebook::velox::ReadFile> primary_;
+  const std::shared_ptr<Backup> backup_;
+
+  const std::shared_ptr<HedgedReadStorage> storage_;
+  HedgeBudget& budget_;
+  const HedgedReadOptions options_;
+  folly::Executor* const executor_;
+};
+
+/// Registers a file system in front of the HDFS and object storage file systems, whose files are HedgedReadFiles. Must
+/// be called before those file systems are registered, since Velox picks the first file system matching a path.
+void registerHedgedReadFileSystem(const HedgedReadOptions& options, folly::Executor* executor);
+
+} // namespace gluten
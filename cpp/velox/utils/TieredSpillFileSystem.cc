@@ -0,0 +1,640 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/TieredSpillFileSystem.h"
+
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include "utils/Exception.h"
+#include "velox/common/file/File.h"
+#include "velox/common/file/FileSystems.h"
+
+namespace gluten {
+namespace {
+
+namespace filesystems = facebook::velox::filesystems;
+
+constexpr std::string_view kTieredFsScheme("tiered:");
+
+// Granularity of memory tier allocations. Every block but the last one of a run is full.
+constexpr uint64_t kBlockSize = 1L << 20;
+
+std::string removeScheme(std::string_view path) {
+  if (path.find(kTieredFsScheme) == 0) {
+    path.remove_prefix(kTieredFsScheme.size());
+  }
+  return std::string(path);
+}
+
+std::shared_ptr<filesystems::FileSystem> localFileSystem(const std::string& path) {
+  return filesystems::getFileSystem(path, nullptr);
+}
+
+// Per-directory counters, so that a task can report the spill of its own spill directory.
+struct DirectoryStats {
+  std::atomic<uint64_t> memoryBytesWritten{0};
+  // Bytes of runs that were demoted or moved to disk after being written to memory.
+  std::atomic<uint64_t> memoryBytesMovedToDisk{0};
+};
+
+struct MemoryRun {
+  // Gives the reservation back to the tier.
+  ~MemoryRun();
+
+  std::vector<std::string> blocks;
+  uint64_t size{0};
+  // Stats of the tracked directory the run was created in, if any.
+  std::shared_ptr<DirectoryStats> dirStats;
+  // Guarded by the tier mutex.
+  std::string path;
+  // Only released when the last reference to the run is dropped, i.e. when no reader can access the blocks anymore.
+  uint64_t reservedBytes{0};
+  bool closed{false};
+  bool demoting{false};
+  std::list<std::string>::iterator lruPos;
+
+  void read(uint64_t offset, uint64_t length, char* out) const {
+    auto blockIndex = offset / kBlockSize;
+    auto blockOffset = offset % kBlockSize;
+    while (length > 0) {
+      const auto& block = blocks[blockIndex];
+      auto n = std::min<uint64_t>(length, block.size() - blockOffset);
+      std::memcpy(out, block.data() + blockOffset, n);
+      out += n;
+      length -= n;
+      ++blockIndex;
+      blockOffset = 0;
+    }
+  }
+};
+
+struct Counters {
+  std::atomic<uint64_t> memoryBytesWritten{0};
+  std::atomic<uint64_t> memoryBytesRead{0};
+  std::atomic<uint64_t> runsDemoted{0};
+  std::atomic<uint64_t> bytesDemoted{0};
+  std::atomic<uint64_t> diskBytesWritten{0};
+  std::atomic<uint64_t> diskBytesRead{0};
+};
+
+// Process-wide memory tier. Closed runs are kept in write completion order so the least-recently-written ones are
+// demoted first. Runs being written are never demoted: their writers fall back to disk when the tier is full.
+class MemoryTier {
+ public:
+  static MemoryTier& instance() {
+    static MemoryTier tier;
+    return tier;
+  }
+
+  void setCapacity(uint64_t capacity) {
+    std::lock_guard<std::mutex> l(mutex_);
+    capacity_ = capacity;
+  }
+
+  Counters& counters() {
+    return counters_;
+  }
+
+  std::shared_ptr<MemoryRun> create(const std::string& path) {
+    auto run = std::make_shared<MemoryRun>();
+    run->path = path;
+    std::lock_guard<std::mutex> l(mutex_);
+    run->dirStats = dirStatsLocked(path);
+    eraseLocked(path);
+    runs_.emplace(path, run);
+    return run;
+  }
+
+  std::shared_ptr<MemoryRun> find(const std::string& path) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = runs_.find(path);
+    if (it == runs_.end() || !it->second->closed) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  // Reserves bytes for the run, demoting the least-recently-written runs to disk if needed. Returns false if the
+  // bytes can't fit even after all closed runs are demoted.
+  bool tryReserve(const std::shared_ptr<MemoryRun>& run, uint64_t bytes) {
+    while (true) {
+      std::string victimPath;
+      std::shared_ptr<MemoryRun> victim;
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (usedBytes_ + bytes <= capacity_) {
+          peakBytes_ = std::max(peakBytes_, usedBytes_ += bytes);
+          run->reservedBytes += bytes;
+          return true;
+        }
+        if (lru_.empty()) {
+          return false;
+        }
+        victimPath = std::move(lru_.front());
+        lru_.pop_front();
+        victim = runs_.at(victimPath);
+        victim->demoting = true;
+      }
+      demote(victimPath, victim);
+    }
+  }
+
+  // Marks the run readable and releases the unused tail of its last block.
+  void close(const std::string& path, const std::shared_ptr<MemoryRun>& run) {
+    uint64_t unused = 0;
+    if (!run->blocks.empty()) {
+      auto& last = run->blocks.back();
+      unused = kBlockSize - last.size();
+      last.shrink_to_fit();
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = runs_.find(path);
+    if (it == runs_.end() || it->second != run) {
+      return;
+    }
+    run->reservedBytes -= unused;
+    usedBytes_ -= unused;
+    run->closed = true;
+    run->lruPos = lru_.insert(lru_.end(), path);
+  }
+
+  bool erase(const std::string& path) {
+    std::lock_guard<std::mutex> l(mutex_);
+    return eraseLocked(path);
+  }
+
+  void eraseUnder(const std::string& dir) {
+    auto prefix = dir.back() == '/' ? dir : dir + "/";
+    std::lock_guard<std::mutex> l(mutex_);
+    std::vector<std::string> paths;
+    for (const auto& [path, run] : runs_) {
+      if (path.find(prefix) == 0) {
+        paths.push_back(path);
+      }
+    }
+    for (const auto& path : paths) {
+      eraseLocked(path);
+    }
+  }
+
+  // A run being demoted is renamed as well: the demotion moves it to disk under its path at the time it completes.
+  bool rename(const std::string& oldPath, const std::string& newPath, bool overwrite) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = runs_.find(oldPath);
+    if (it == runs_.end() || !it->second->closed) {
+      return false;
+    }
+    GLUTEN_CHECK(overwrite || runs_.find(newPath) == runs_.end(), "Spill file already exists: " + newPath);
+    auto run = it->second;
+    runs_.erase(it);
+    eraseLocked(newPath);
+    if (!run->demoting) {
+      *run->lruPos = newPath;
+    }
+    run->path = newPath;
+    runs_.emplace(newPath, run);
+    return true;
+  }
+
+  void trackDirectory(const std::string& dir) {
+    auto key = trimTrailingSlash(dir);
+    std::lock_guard<std::mutex> l(mutex_);
+    if (dirStatsLocked(key + "/") == nullptr) {
+      dirStats_.emplace(std::move(key), std::make_shared<DirectoryStats>());
+    }
+  }
+
+  void untrackDirectory(const std::string& dir) {
+    std::lock_guard<std::mutex> l(mutex_);
+    dirStats_.erase(trimTrailingSlash(dir));
+  }
+
+  uint64_t memoryResidentBytes(const std::string& dir) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = dirStats_.find(trimTrailingSlash(dir));
+    if (it == dirStats_.end()) {
+      return 0;
+    }
+    return it->second->memoryBytesWritten - it->second->memoryBytesMovedToDisk;
+  }
+
+  void release(uint64_t bytes) {
+    usedBytes_ -= bytes;
+  }
+
+  std::vector<std::string> list(const std::string& dir) {
+    auto prefix = dir.back() == '/' ? dir : dir + "/";
+    std::vector<std::string> out;
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& [path, run] : runs_) {
+      if (path.find(prefix) == 0 && path.find('/', prefix.size()) == std::string::npos) {
+        out.push_back(path);
+      }
+    }
+    return out;
+  }
+
+  TieredSpillStats stats() {
+    TieredSpillStats stats;
+    stats.memoryBytesWritten = counters_.memoryBytesWritten;
+    stats.memoryBytesRead = counters_.memoryBytesRead;
+    stats.runsDemoted = counters_.runsDemoted;
+    stats.bytesDemoted = counters_.bytesDemoted;
+    stats.diskBytesWritten = counters_.diskBytesWritten;
+    stats.diskBytesRead = counters_.diskBytesRead;
+    std::lock_guard<std::mutex> l(mutex_);
+    stats.memoryUsedBytes = usedBytes_;
+    stats.memoryPeakBytes = peakBytes_;
+    return stats;
+  }
+
+ private:
+  MemoryTier() = default;
+
+  // Whoever removes a run from runs_ gives its reservation back.
+  bool eraseLocked(const std::string& path) {
+    auto it = runs_.find(path);
+    if (it == runs_.end()) {
+      return false;
+    }
+    auto& run = it->second;
+    if (run->closed && !run->demoting) {
+      lru_.erase(run->lruPos);
+    }
+    runs_.erase(it);
+    return true;
+  }
+
+  static std::string trimTrailingSlash(std::string dir) {
+    while (dir.size() > 1 && dir.back() == '/') {
+      dir.pop_back();
+    }
+    return dir;
+  }
+
+  // Returns the stats of the outermost tracked directory containing the path.
+  std::shared_ptr<DirectoryStats> dirStatsLocked(const std::string& path) {
+    for (auto pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+      auto it = dirStats_.find(path.substr(0, pos));
+      if (it != dirStats_.end()) {
+        return it->second;
+      }
+    }
+    return nullptr;
+  }
+
+  // Writes the run to a temporary file outside of the lock. Then, under the lock, moves the file to the current path
+  // of the run and drops the run from the tier, so concurrent opens and renames see either the run in memory or the
+  // complete file on disk. Readers that opened the run before keep reading it from memory.
+  void demote(const std::string& path, const std::shared_ptr<MemoryRun>& run) {
+    auto fs = localFileSystem(path);
+    const auto tmpPath = path + ".demoting";
+    try {
+      auto file = fs->openFileForWrite(tmpPath);
+      for (const auto& block : run->blocks) {
+        file->append(block);
+      }
+      file->close();
+    } catch (const std::exception& e) {
+      if (fs->exists(tmpPath)) {
+        fs->remove(tmpPath);
+      }
+      std::lock_guard<std::mutex> l(mutex_);
+      auto it = runs_.find(run->path);
+      if (it != runs_.end() && it->second == run) {
+        run->demoting = false;
+        run->lruPos = lru_.insert(lru_.begin(), run->path);
+      }
+      throw;
+    }
+
+    bool removed;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      auto it = runs_.find(run->path);
+      removed = it == runs_.end() || it->second != run;
+      if (!removed) {
+        fs->rename(tmpPath, run->path, true);
+        runs_.erase(it);
+      }
+    }
+    if (removed) {
+      // The run was removed while being demoted.
+      if (fs->exists(tmpPath)) {
+        fs->remove(tmpPath);
+      }
+      return;
+    }
+
+    counters_.runsDemoted++;
+    counters_.bytesDemoted += run->size;
+    counters_.diskBytesWritten += run->size;
+    if (run->dirStats != nullptr) {
+      run->dirStats->memoryBytesMovedToDisk += run->size;
+    }
+    VLOG(1) << "Demoted spill run " << path << " of " << run->size << " bytes to disk.";
+  }
+
+  std::mutex mutex_;
+  uint64_t capacity_{0};
+  // Released without the lock by the last reference to a run.
+  std::atomic<uint64_t> usedBytes_{0};
+  uint64_t peakBytes_{0};
+  std::unordered_map<std::string, std::shared_ptr<MemoryRun>> runs_;
+  std::list<std::string> lru_;
+  std::unordered_map<std::string, std::shared_ptr<DirectoryStats>> dirStats_;
+  Counters counters_;
+};
+
+MemoryRun::~MemoryRun() {
+  MemoryTier::instance().release(reservedBytes);
+}
+
+class MemoryReadFile : public facebook::velox::ReadFile {
+ public:
+  MemoryReadFile(std::string path, std::shared_ptr<MemoryRun> run) : path_(std::move(path)), run_(std::move(run)) {}
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf) const override {
+    GLUTEN_CHECK(
+        offset + length <= run_->size,
+        fmt::format("Read past end of spill run {}: {} + {} > {}", path_, offset, length, run_->size));
+    run_->read(offset, length, static_cast<char*>(buf));
+    MemoryTier::instance().counters().memoryBytesRead += length;
+    return {static_cast<char*>(buf), length};
+  }
+
+  bool shouldCoalesce() const override {
+    return false;
+  }
+
+  uint64_t size() const override {
+    return run_->size;
+  }
+
+  uint64_t memoryUsage() const override {
+    return sizeof(*this);
+  }
+
+  std::string getName() const override {
+    return path_;
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return kBlockSize;
+  }
+
+ private:
+  const std::string path_;
+  const std::shared_ptr<MemoryRun> run_;
+};
+
+// Counts bytes read from the disk tier.
+class DiskReadFile : public facebook::velox::ReadFile {
+ public:
+  explicit DiskReadFile(std::unique_ptr<facebook::velox::ReadFile> file) : file_(std::move(file)) {}
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf) const override {
+    auto out = file_->pread(offset, length, buf);
+    MemoryTier::instance().counters().diskBytesRead += out.size();
+    return out;
+  }
+
+  bool shouldCoalesce() const override {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const override {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return file_->memoryUsage();
+  }
+
+  std::string getName() const override {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return file_->getNaturalReadSize();
+  }
+
+ private:
+  std::unique_ptr<facebook::velox::ReadFile> file_;
+};
+
+// Writes into the memory tier until it runs out of space, then moves what was written so far to disk and continues
+// there.
+class TieredWriteFile : public facebook::velox::WriteFile {
+ public:
+  TieredWriteFile(std::string path, const filesystems::FileOptions& options)
+      : path_(std::move(path)), options_(options), run_(MemoryTier::instance().create(path_)) {}
+
+  void append(std::string_view data) override {
+    if (diskFile_ == nullptr && !appendToMemory(data)) {
+      moveToDisk();
+    }
+    if (diskFile_ != nullptr) {
+      diskFile_->append(data);
+      MemoryTier::instance().counters().diskBytesWritten += data.size();
+    }
+    size_ += data.size();
+  }
+
+  void flush() override {
+    if (diskFile_ != nullptr) {
+      diskFile_->flush();
+    }
+  }
+
+  void close() override {
+    if (diskFile_ != nullptr) {
+      diskFile_->close();
+    } else {
+      MemoryTier::instance().close(path_, run_);
+    }
+  }
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+ private:
+  bool appendToMemory(std::string_view data) {
+    auto& tier = MemoryTier::instance();
+    uint64_t available = run_->blocks.empty() ? 0 : kBlockSize - run_->blocks.back().size();
+    if (data.size() > available) {
+      auto numBlocks = (data.size() - available + kBlockSize - 1) / kBlockSize;
+      if (!tier.tryReserve(run_, numBlocks * kBlockSize)) {
+        return false;
+      }
+    }
+
+    tier.counters().memoryBytesWritten += data.size();
+    if (run_->dirStats != nullptr) {
+      run_->dirStats->memoryBytesWritten += data.size();
+    }
+    run_->size += data.size();
+    while (!data.empty()) {
+      if (run_->blocks.empty() || run_->blocks.back().size() == kBlockSize) {
+        run_->blocks.emplace_back().reserve(kBlockSize);
+      }
+      auto& block = run_->blocks.back();
+      auto n = std::min<uint64_t>(data.size(), kBlockSize - block.size());
+      block.append(data.data(), n);
+      data.remove_prefix(n);
+    }
+    return true;
+  }
+
+  void moveToDisk() {
+    diskFile_ = localFileSystem(path_)->openFileForWrite(path_, options_);
+    for (const auto& block : run_->blocks) {
+      diskFile_->append(block);
+    }
+    MemoryTier::instance().counters().diskBytesWritten += run_->size;
+    if (run_->dirStats != nullptr) {
+      run_->dirStats->memoryBytesMovedToDisk += run_->size;
+    }
+    MemoryTier::instance().erase(path_);
+    run_.reset();
+  }
+
+  const std::string path_;
+  const filesystems::FileOptions options_;
+  std::shared_ptr<MemoryRun> run_;
+  std::unique_ptr<facebook::velox::WriteFile> diskFile_;
+  uint64_t size_{0};
+};
+
+class TieredSpillFileSystem : public filesystems::FileSystem {
+ public:
+  explicit TieredSpillFileSystem(std::shared_ptr<const facebook::velox::config::ConfigBase> config)
+      : FileSystem(std::move(config)) {}
+
+  std::string name() const override {
+    return "Tiered spill FS";
+  }
+
+  std::unique_ptr<facebook::velox::ReadFile> openFileForRead(
+      std::string_view path,
+      const filesystems::FileOptions& options) override {
+    auto localPath = removeScheme(path);
+    if (auto run = MemoryTier::instance().find(localPath)) {
+      return std::make_unique<MemoryReadFile>(localPath, std::move(run));
+    }
+    return std::make_unique<DiskReadFile>(localFileSystem(localPath)->openFileForRead(localPath, options));
+  }
+
+  std::unique_ptr<facebook::velox::WriteFile> openFileForWrite(
+      std::string_view path,
+      const filesystems::FileOptions& options) override {
+    return std::make_unique<TieredWriteFile>(removeScheme(path), options);
+  }
+
+  void remove(std::string_view path) override {
+    auto localPath = removeScheme(path);
+    MemoryTier::instance().erase(localPath);
+    auto fs = localFileSystem(localPath);
+    if (fs->exists(localPath)) {
+      fs->remove(localPath);
+    }
+  }
+
+  void rename(std::string_view oldPath, std::string_view newPath, bool overwrite) override {
+    auto oldLocalPath = removeScheme(oldPath);
+    auto newLocalPath = removeScheme(newPath);
+    if (!MemoryTier::instance().rename(oldLocalPath, newLocalPath, overwrite)) {
+      localFileSystem(oldLocalPath)->rename(oldLocalPath, newLocalPath, overwrite);
+    }
+  }
+
+  bool exists(std::string_view path) override {
+    auto localPath = removeScheme(path);
+    return MemoryTier::instance().find(localPath) != nullptr || localFileSystem(localPath)->exists(localPath);
+  }
+
+  std::vector<std::string> list(std::string_view path) override {
+    auto localPath = removeScheme(path);
+    auto out = MemoryTier::instance().list(localPath);
+    auto fs = localFileSystem(localPath);
+    if (fs->exists(localPath)) {
+      auto onDisk = fs->list(localPath);
+      out.insert(out.end(), onDisk.begin(), onDisk.end());
+    }
+    return out;
+  }
+
+  void mkdir(std::string_view path, const filesystems::DirectoryOptions& options = {}) override {
+    auto localPath = removeScheme(path);
+    localFileSystem(localPath)->mkdir(localPath, options);
+    MemoryTier::instance().trackDirectory(localPath);
+  }
+
+  void rmdir(std::string_view path) override {
+    auto localPath = removeScheme(path);
+    MemoryTier::instance().eraseUnder(localPath);
+    MemoryTier::instance().untrackDirectory(localPath);
+    localFileSystem(localPath)->rmdir(localPath);
+  }
+};
+} // namespace
+
+std::string TieredSpillStats::toString() const {
+  return fmt::format(
+      "TieredSpillStats[memoryBytesWritten={}, memoryBytesRead={}, memoryUsedBytes={}, memoryPeakBytes={}, "
+      "runsDemoted={}, bytesDemoted={}, diskBytesWritten={}, diskBytesRead={}]",
+      memoryBytesWritten,
+      memoryBytesRead,
+      memoryUsedBytes,
+      memoryPeakBytes,
+      runsDemoted,
+      bytesDemoted,
+      diskBytesWritten,
+      diskBytesRead);
+}
+
+void registerTieredSpillFileSystem(uint64_t memoryCapacity) {
+  MemoryTier::instance().setCapacity(memoryCapacity);
+
+  auto schemeMatcher = [](std::string_view filePath) { return filePath.find(kTieredFsScheme) == 0; };
+  auto fileSystemGenerator =
+      [](std::shared_ptr<const facebook::velox::config::ConfigBase> properties,
+         std::string_view filePath) -> std::shared_ptr<filesystems::FileSystem> {
+    static auto fs = std::make_shared<TieredSpillFileSystem>(properties);
+    return fs;
+  };
+  filesystems::registerFileSystem(schemeMatcher, fileSystemGenerator);
+}
+
+TieredSpillStats tieredSpillStats() {
+  return MemoryTier::instance().stats();
+}
+
+uint64_t tieredSpillMemoryResidentBytes(const std::string& spillDir) {
+  return MemoryTier::instance().memoryResidentBytes(removeScheme(spillDir));
+}
+
+} // namespace gluten
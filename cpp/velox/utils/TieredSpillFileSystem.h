@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace gluten {
+
+/// Process-level counters of the tiered spill file system, per tier.
+struct TieredSpillStats {
+  // Memory tier.
+  uint64_t memoryBytesWritten{0};
+  uint64_t memoryBytesRead{0};
+  uint64_t memoryUsedBytes{0};
+  uint64_t memoryPeakBytes{0};
+  uint64_t runsDemoted{0};
+  uint64_t bytesDemoted{0};
+  // Disk tier, including runs demoted from memory and runs that didn't fit in memory.
+  uint64_t diskBytesWritten{0};
+  uint64_t diskBytesRead{0};
+
+  std::string toString() const;
+};
+
+/// Registers the "tiered:" file system. Spill runs written through it are kept in a process-wide memory tier of at most
+/// memoryCapacity bytes, which lives outside of the Spark task memory budget. When the tier is full, the
+/// least-recently-written runs are demoted to the local file system under the same path with the scheme removed. Runs
+/// are read from whichever tier holds them.
+///
+/// Velox writes spill runs with the codec configured by spillCompressionCodec (lz4 by default), so the tier keeps them
+/// in their compressed form without compressing them again.
+void registerTieredSpillFileSystem(uint64_t memoryCapacity);
+
+TieredSpillStats tieredSpillStats();
+
+/// Bytes of the spill runs written under spillDir that stayed in the memory tier, i.e. that were neither demoted nor
+/// moved to disk. Only directories created through the tiered file system are tracked, 0 is returned for others.
+uint64_t tieredSpillMemoryResidentBytes(const std::string& spillDir);
+
+} // namespace gluten
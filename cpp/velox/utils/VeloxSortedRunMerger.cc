@@ -0,0 +1,245 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VeloxSortedRunMerger.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <tuple>
+
+#include "shuffle/Utils.h"
+#include "utils/Exception.h"
+#include "utils/VeloxArrowUtils.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+VeloxSortedRunMerger::VeloxSortedRunMerger(
+    arrow::MemoryPool* arrowPool,
+    std::shared_ptr<memory::MemoryPool> veloxPool,
+    std::vector<ShuffleSortKey> sortKeys,
+    int32_t batchSize,
+    int64_t memoryLimit,
+    std::string spillDir,
+    std::unique_ptr<ColumnarBatchIterator> in)
+    : arrowPool_(arrowPool),
+      veloxPool_(std::move(veloxPool)),
+      sortKeys_(std::move(sortKeys)),
+      batchSize_(batchSize),
+      memoryLimit_(memoryLimit),
+      spillDir_(std::move(spillDir)),
+      in_(std::move(in)) {
+  GLUTEN_CHECK(!sortKeys_.empty(), "VeloxSortedRunMerger requires sort keys");
+  GLUTEN_CHECK(batchSize_ > 0, "VeloxSortedRunMerger requires a positive batch size");
+}
+
+VeloxSortedRunMerger::~VeloxSortedRunMerger() {
+  if (spillOut_ != nullptr) {
+    (void)spillOut_->Close();
+  }
+  if (spillIn_ != nullptr) {
+    (void)spillIn_->Close();
+  }
+  if (!spillFile_.empty()) {
+    std::error_code ec;
+    std::filesystem::remove(spillFile_, ec);
+  }
+}
+
+std::shared_ptr<ColumnarBatch> VeloxSortedRunMerger::next() {
+  if (!loaded_) {
+    loadRuns();
+    loaded_ = true;
+  }
+  if (heap_.empty()) {
+    return nullptr;
+  }
+
+  auto cmp = [this](const Cursor& lhs, const Cursor& rhs) { return greater(lhs, rhs); };
+
+  // A chunk that only holds rows of the last run is returned as is.
+  if (heap_.size() == 1 && heap_[0].row == 0 && heap_[0].numRemaining >= chunks_[heap_[0].chunk].numRows) {
+    auto& cursor = heap_[0];
+    auto& chunk = chunks_[cursor.chunk];
+    auto rows = std::move(chunk.rows);
+    chunk.keys.reset();
+    chunk.numPending = 0;
+    cursor.numRemaining -= chunk.numRows;
+    numRemaining_ -= chunk.numRows;
+    if (cursor.numRemaining == 0) {
+      heap_.clear();
+    } else {
+      ensureLoaded(++cursor.chunk);
+    }
+    return std::make_shared<VeloxColumnarBatch>(std::move(rows));
+  }
+
+  auto numRows = static_cast<vector_size_t>(std::min<int64_t>(batchSize_, numRemaining_));
+  // Consecutive rows of a chunk are copied as one range.
+  std::map<size_t, std::vector<BaseVector::CopyRange>> ranges;
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    std::pop_heap(heap_.begin(), heap_.end(), cmp);
+    auto& cursor = heap_.back();
+    auto& chunkRanges = ranges[cursor.chunk];
+    if (!chunkRanges.empty() && chunkRanges.back().sourceIndex + chunkRanges.back().count == cursor.row &&
+        chunkRanges.back().targetIndex + chunkRanges.back().count == i) {
+      ++chunkRanges.back().count;
+    } else {
+      chunkRanges.push_back({cursor.row, i, 1});
+    }
+    --chunks_[cursor.chunk].numPending;
+    if (--cursor.numRemaining == 0) {
+      heap_.pop_back();
+      continue;
+    }
+    if (++cursor.row == chunks_[cursor.chunk].numRows) {
+      cursor.row = 0;
+      ensureLoaded(++cursor.chunk);
+    }
+    std::push_heap(heap_.begin(), heap_.end(), cmp);
+  }
+  numRemaining_ -= numRows;
+
+  auto result = std::static_pointer_cast<RowVector>(BaseVector::create(rowType_, numRows, veloxPool_.get()));
+  for (const auto& [chunkIndex, chunkRanges] : ranges) {
+    auto& chunk = chunks_[chunkIndex];
+    result->copyRanges(chunk.rows.get(), chunkRanges);
+    if (chunk.numPending == 0) {
+      chunk.rows.reset();
+      chunk.keys.reset();
+    }
+  }
+  return std::make_shared<VeloxColumnarBatch>(std::move(result));
+}
+
+int64_t VeloxSortedRunMerger::spillFixedSize(int64_t size) {
+  // Once merging, every buffered chunk is either the current chunk of a run or needed later.
+  if (loaded_) {
+    return 0;
+  }
+  return spill();
+}
+
+void VeloxSortedRunMerger::loadRuns() {
+  std::optional<Cursor> run;
+  while (auto batch = in_->next()) {
+    auto rows = VeloxColumnarBatch::from(veloxPool_.get(), batch)->getRowVector();
+    if (rows->size() == 0) {
+      continue;
+    }
+    if (rowType_ == nullptr) {
+      rowType_ = asRowType(rows->type());
+    }
+    auto keys = std::make_unique<ShuffleSortKeyEncoder>(sortKeys_);
+    keys->encode(*rows);
+
+    const auto chunk = chunks_.size();
+    const auto numRows = rows->size();
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      auto current = keys->key(row);
+      auto previous = row == 0 ? std::string_view(lastKey_) : keys->key(row - 1);
+      if (!run || current < previous) {
+        if (run) {
+          heap_.push_back(*run);
+        }
+        run = Cursor{chunk, row, 0};
+      }
+      ++run->numRemaining;
+    }
+    numRemaining_ += numRows;
+    lastKey_ = keys->key(numRows - 1);
+
+    bufferedBytes_ += rows->retainedSize() + keys->retainedSize();
+    chunks_.push_back(Chunk{std::move(rows), std::move(keys), numRows, numRows});
+    if (bufferedBytes_ > memoryLimit_) {
+      spill();
+    }
+  }
+  if (run) {
+    heap_.push_back(*run);
+  }
+
+  if (spillOut_ != nullptr) {
+    GLUTEN_THROW_NOT_OK(spillOut_->Close());
+    spillOut_.reset();
+    GLUTEN_ASSIGN_OR_THROW(spillIn_, arrow::io::ReadableFile::Open(spillFile_, arrowPool_));
+  }
+  for (const auto& cursor : heap_) {
+    ensureLoaded(cursor.chunk);
+  }
+  std::make_heap(
+      heap_.begin(), heap_.end(), [this](const Cursor& lhs, const Cursor& rhs) { return greater(lhs, rhs); });
+}
+
+int64_t VeloxSortedRunMerger::spill() {
+  if (bufferedBytes_ == 0) {
+    return 0;
+  }
+  if (serializer_ == nullptr) {
+    ArrowSchema cSchema;
+    toArrowSchema(rowType_, veloxPool_.get(), &cSchema);
+    serializer_ = std::make_unique<VeloxColumnarBatchSerializer>(arrowPool_, veloxPool_, &cSchema);
+  }
+  if (spillOut_ == nullptr) {
+    GLUTEN_ASSIGN_OR_THROW(spillFile_, createTempShuffleFile(spillDir_));
+    GLUTEN_ASSIGN_OR_THROW(spillOut_, arrow::io::FileOutputStream::Open(spillFile_));
+  }
+
+  for (auto& chunk : chunks_) {
+    if (chunk.rows == nullptr) {
+      continue;
+    }
+    auto buffer = serializer_->serializeColumnarBatches({std::make_shared<VeloxColumnarBatch>(chunk.rows)});
+    GLUTEN_THROW_NOT_OK(spillOut_->Write(buffer));
+    chunk.spillOffset = spillFileSize_;
+    chunk.spillSize = buffer->size();
+    spillFileSize_ += buffer->size();
+    chunk.rows.reset();
+    chunk.keys.reset();
+  }
+  auto released = bufferedBytes_;
+  bufferedBytes_ = 0;
+  return released;
+}
+
+void VeloxSortedRunMerger::ensureLoaded(size_t chunkIndex) {
+  auto& chunk = chunks_[chunkIndex];
+  if (chunk.rows != nullptr) {
+    return;
+  }
+  GLUTEN_CHECK(chunk.spillOffset >= 0 && chunk.numPending > 0, "Chunk to merge was released");
+  GLUTEN_ASSIGN_OR_THROW(auto buffer, spillIn_->ReadAt(chunk.spillOffset, chunk.spillSize));
+  auto batch = serializer_->deserialize(const_cast<uint8_t*>(buffer->data()), buffer->size());
+  chunk.rows = VeloxColumnarBatch::from(veloxPool_.get(), batch)->getRowVector();
+  chunk.keys = std::make_unique<ShuffleSortKeyEncoder>(sortKeys_);
+  chunk.keys->encode(*chunk.rows);
+}
+
+bool VeloxSortedRunMerger::greater(const Cursor& lhs, const Cursor& rhs) const {
+  auto lhsKey = key(lhs);
+  auto rhsKey = key(rhs);
+  if (lhsKey != rhsKey) {
+    return lhsKey > rhsKey;
+  }
+  // Keep the input order for equal keys.
+  return std::tie(lhs.chunk, lhs.row) > std::tie(rhs.chunk, rhs.row);
+}
+
+} // namespace gluten
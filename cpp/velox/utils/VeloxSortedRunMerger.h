@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arrow/io/file.h>
+
+#include "memory/ColumnarBatchIterator.h"
+#include "memory/VeloxColumnarBatch.h"
+#include "operators/serializer/VeloxColumnarBatchSerializer.h"
+#include "shuffle/ShuffleSortKeyEncoder.h"
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace gluten {
+
+/// Merges the sorted runs of its input into batches ordered by the sort keys. A run ends where the key of a row is
+/// less than the key of the previous row, so the output is sorted for any input. The merge is cheap if the input
+/// consists of few long runs, e.g. the shuffle input of a reducer whose map tasks ordered each partition by the same
+/// keys, see ShuffleWriterOptions::sortKeys.
+///
+/// The whole input is read before the first batch is returned. Once the buffered batches take more than memoryLimit
+/// bytes, or on spill requests, they are written to a file under spillDir. The merge then reads back one batch per run
+/// at a time.
+class VeloxSortedRunMerger final : public ColumnarBatchIterator {
+ public:
+  VeloxSortedRunMerger(
+      arrow::MemoryPool* arrowPool,
+      std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool,
+      std::vector<ShuffleSortKey> sortKeys,
+      int32_t batchSize,
+      int64_t memoryLimit,
+      std::string spillDir,
+      std::unique_ptr<ColumnarBatchIterator> in);
+
+  ~VeloxSortedRunMerger() override;
+
+  std::shared_ptr<ColumnarBatch> next() override;
+
+  int64_t spillFixedSize(int64_t size) override;
+
+ private:
+  struct Chunk {
+    // Null while the chunk is spilled and not loaded, and once all its rows are merged.
+    facebook::velox::RowVectorPtr rows;
+    std::unique_ptr<ShuffleSortKeyEncoder> keys;
+    facebook::velox::vector_size_t numRows;
+    // Rows not merged yet.
+    facebook::velox::vector_size_t numPending;
+    // Location in the spill file, if spilled.
+    int64_t spillOffset{-1};
+    int64_t spillSize{0};
+  };
+
+  // The next row of a run.
+  struct Cursor {
+    size_t chunk;
+    facebook::velox::vector_size_t row;
+    // Rows left in the run, including this one.
+    int64_t numRemaining;
+  };
+
+  void loadRuns();
+
+  // Writes all buffered chunks to the spill file and releases them. Returns the released bytes.
+  int64_t spill();
+
+  // Reads a spilled chunk back before its rows are merged.
+  void ensureLoaded(size_t chunk);
+
+  std::string_view key(const Cursor& cursor) const {
+    return chunks_[cursor.chunk].keys->key(cursor.row);
+  }
+
+  // Orders the heap by the key of the next row of each run, so that the run with the smallest key is on top.
+  bool greater(const Cursor& lhs, const Cursor& rhs) const;
+
+  arrow::MemoryPool* arrowPool_;
+  std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool_;
+  std::vector<ShuffleSortKey> sortKeys_;
+  const int32_t batchSize_;
+  const int64_t memoryLimit_;
+  const std::string spillDir_;
+  std::unique_ptr<ColumnarBatchIterator> in_;
+
+  facebook::velox::RowTypePtr rowType_;
+  std::unique_ptr<VeloxColumnarBatchSerializer> serializer_;
+
+  bool loaded_{false};
+  std::vector<Chunk> chunks_;
+  // Bytes of the chunks buffered while loading.
+  int64_t bufferedBytes_{0};
+  // The key of the last row read, to find where a run ends across chunks.
+  std::string lastKey_;
+
+  std::string spillFile_;
+  std::shared_ptr<arrow::io::FileOutputStream> spillOut_;
+  std::shared_ptr<arrow::io::ReadableFile> spillIn_;
+  int64_t spillFileSize_{0};
+
+  std::vector<Cursor> heap_;
+  int64_t numRemaining_{0};
+};
+
+} // namespace gluten
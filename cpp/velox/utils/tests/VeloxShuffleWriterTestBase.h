@@ -70,13 +70,17 @@ struct ShuffleTestParams {
   int32_t mergeBufferSize{0};
   int32_t compressionBufferSize{0};
   bool useRadixSort{false};
+  int32_t adaptiveMinHashBufferRows{kDefaultAdaptiveMinHashBufferRows};
+  int32_t adaptiveMinRowsPerPartition{kDefaultAdaptiveMinRowsPerPartition};
 
   std::string toString() const {
     std::ostringstream out;
     out << "shuffleWriterType = " << shuffleWriterType << ", partitionWriterType = " << partitionWriterType
         << ", compressionType = " << compressionType << ", compressionThreshold = " << compressionThreshold
         << ", mergeBufferSize = " << mergeBufferSize << ", compressionBufferSize = " << compressionBufferSize
-        << ", useRadixSort = " << (useRadixSort ? "true" : "false");
+        << ", useRadixSort = " << (useRadixSort ? "true" : "false")
+        << ", adaptiveMinHashBufferRows = " << adaptiveMinHashBufferRows
+        << ", adaptiveMinRowsPerPartition = " << adaptiveMinRowsPerPartition;
     return out.str();
   }
 };
@@ -262,6 +266,8 @@ class VeloxShuffleWriterTest : public ::testing::TestWithParam<ShuffleTestParams
     ShuffleTestParams params = GetParam();
     shuffleWriterOptions_.useRadixSort = params.useRadixSort;
     shuffleWriterOptions_.sortEvictBufferSize = params.compressionBufferSize;
+    shuffleWriterOptions_.adaptiveMinHashBufferRows = params.adaptiveMinHashBufferRows;
+    shuffleWriterOptions_.adaptiveMinRowsPerPartition = params.adaptiveMinRowsPerPartition;
     partitionWriterOptions_.compressionType = params.compressionType;
     switch (partitionWriterOptions_.compressionType) {
       case arrow::Compression::UNCOMPRESSED:
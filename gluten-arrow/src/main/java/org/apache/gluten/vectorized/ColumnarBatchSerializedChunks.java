@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package org.apache.gluten.vectorized;
+
+import java.io.Externalizable;
+import java.io.IOException;
+import java.io.ObjectInput;
+import java.io.ObjectOutput;
+import java.nio.ByteBuffer;
+
+/**
+ * Serialized columnar batches held as a list of direct (off-heap) byte buffers. Unlike {@link
+ * ColumnarBatchSerializeResult}, the total size is not limited by the 2GB size of a byte array and
+ * the payload never lives on the Java heap. Java serialization streams the chunks through a small
+ * copy buffer.
+ */
+public class ColumnarBatchSerializedChunks implements Externalizable {
+  public static final ColumnarBatchSerializedChunks EMPTY =
+      new ColumnarBatchSerializedChunks(0, new ByteBuffer[0]);
+
+  private static final int COPY_BUFFER_SIZE = 64 * 1024;
+
+  private long numRows;
+
+  private ByteBuffer[] chunks;
+
+  /** Used by Java serialization only. */
+  public ColumnarBatchSerializedChunks() {}
+
+  public ColumnarBatchSerializedChunks(long numRows, ByteBuffer[] chunks) {
+    this.numRows = numRows;
+    this.chunks = chunks;
+  }
+
+  public long getNumRows() {
+    return numRows;
+  }
+
+  public ByteBuffer[] getChunks() {
+    return chunks;
+  }
+
+  public long getSerializedSize() {
+    long size = 0L;
+    for (ByteBuffer chunk : chunks) {
+      size += chunk.capacity();
+    }
+    return size;
+  }
+
+  @Override
+  public void writeExternal(ObjectOutput out) throws IOException {
+    out.writeLong(numRows);
+    out.writeInt(chunks.length);
+    byte[] copyBuffer = new byte[COPY_BUFFER_SIZE];
+    for (ByteBuffer chunk : chunks) {
+      ByteBuffer view = chunk.duplicate();
+      view.clear();
+      out.writeInt(view.remaining());
+      while (view.hasRemaining()) {
+        int length = Math.min(copyBuffer.length, view.remaining());
+        view.get(copyBuffer, 0, length);
+        out.write(copyBuffer, 0, length);
+      }
+    }
+  }
+
+  @Override
+  public void readExternal(ObjectInput in) throws IOException {
+    numRows = in.readLong();
+    chunks = new ByteBuffer[in.readInt()];
+    byte[] copyBuffer = new byte[COPY_BUFFER_SIZE];
+    for (int i = 0; i < chunks.length; i++) {
+      ByteBuffer chunk = ByteBuffer.allocateDirect(in.readInt());
+      while (chunk.hasRemaining()) {
+        int length = Math.min(copyBuffer.length, chunk.remaining());
+        in.readFully(copyBuffer, 0, length);
+        chunk.put(copyBuffer, 0, length);
+      }
+      chunk.clear();
+      chunks[i] = chunk;
+    }
+  }
+}
@@ -19,6 +19,8 @@ package org.apache.gluten.vectorized;
 import org.apache.gluten.runtime.Runtime;
 import org.apache.gluten.runtime.RuntimeAware;
 
+import java.nio.ByteBuffer;
+
 public class ColumnarBatchSerializerJniWrapper implements RuntimeAware {
   private final Runtime runtime;
 
@@ -37,10 +39,18 @@ public class ColumnarBatchSerializerJniWrapper implements RuntimeAware {
 
   public native ColumnarBatchSerializeResult serialize(long[] handles);
 
+  // Serialize into off-heap chunks of at most chunkSize bytes each, without the 2GB limit of a
+  // single byte array.
+  public native ColumnarBatchSerializedChunks serializeToChunks(long[] handles, int chunkSize);
+
   // Return the native ColumnarBatchSerializer handle
   public native long init(long cSchema);
 
   public native long deserialize(long serializerHandle, byte[] data);
 
+  // Return the native ResultIterator handle which deserializes the direct buffer chunks lazily.
+  // The chunks must be kept reachable until the iterator is closed.
+  public native long deserializeChunks(long serializerHandle, ByteBuffer[] chunks);
+
   public native void close(long serializerHandle);
 }
@@ -29,6 +29,14 @@ public class GlutenSplitResult {
   private final long peakBytes;
   private final long sortTime;
   private final long c2rTime;
+  // The writer the adaptive shuffle writer picked and the sampled inputs of that choice.
+  // The type is null for the other writers.
+  private final String adaptiveWriterType;
+  private final long adaptiveSampledRows;
+  private final double adaptiveAvgRowBytes;
+  private final int adaptiveActivePartitions;
+  private final double adaptivePartitionSkew;
+  private final long adaptiveHashBufferRows;
 
   public GlutenSplitResult(
       long totalComputePidTime,
@@ -42,7 +50,13 @@ public class GlutenSplitResult {
       long totalBytesToEvict, // In-memory bytes(uncompressed) before spill.
       long peakBytes,
       long[] partitionLengths,
-      long[] rawPartitionLengths) {
+      long[] rawPartitionLengths,
+      String adaptiveWriterType,
+      long adaptiveSampledRows,
+      double adaptiveAvgRowBytes,
+      int adaptiveActivePartitions,
+      double adaptivePartitionSkew,
+      long adaptiveHashBufferRows) {
     this.totalComputePidTime = totalComputePidTime;
     this.totalWriteTime = totalWriteTime;
     this.totalEvictTime = totalEvictTime;
@@ -55,6 +69,12 @@ public class GlutenSplitResult {
     this.peakBytes = peakBytes;
     this.sortTime = totalSortTime;
     this.c2rTime = totalC2RTime;
+    this.adaptiveWriterType = adaptiveWriterType;
+    this.adaptiveSampledRows = adaptiveSampledRows;
+    this.adaptiveAvgRowBytes = adaptiveAvgRowBytes;
+    this.adaptiveActivePartitions = adaptiveActivePartitions;
+    this.adaptivePartitionSkew = adaptivePartitionSkew;
+    this.adaptiveHashBufferRows = adaptiveHashBufferRows;
   }
 
   public long getTotalComputePidTime() {
@@ -108,4 +128,28 @@ public class GlutenSplitResult {
   public long getC2RTime() {
     return c2rTime;
   }
+
+  public String getAdaptiveWriterType() {
+    return adaptiveWriterType;
+  }
+
+  public long getAdaptiveSampledRows() {
+    return adaptiveSampledRows;
+  }
+
+  public double getAdaptiveAvgRowBytes() {
+    return adaptiveAvgRowBytes;
+  }
+
+  public int getAdaptiveActivePartitions() {
+    return adaptiveActivePartitions;
+  }
+
+  public double getAdaptivePartitionSkew() {
+    return adaptivePartitionSkew;
+  }
+
+  public long getAdaptiveHashBufferRows() {
+    return adaptiveHashBufferRows;
+  }
 }
@@ -40,6 +40,12 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
   /**
    * Construct native shuffle writer for shuffled RecordBatch over
    *
+   * @param hashPartitionKeys comma-separated ordinals of the hash partitioning keys if the native
+   *     writer computes the partition ids from them, or an empty string if the input batches carry
+   *     the partition key hash as the first column
+   * @param sortKeys comma-separated keys the native sort shuffle writer also orders the rows of
+   *     each partition by, each as {@code <ordinal>:<asc|desc>:<nulls_first|nulls_last>}, or an
+   *     empty string to only order by partition
    * @param bufferSize size of native buffers held by each partition writer
    * @param mergeBufferSize maximum size of the merged buffer
    * @param mergeThreshold threshold to control whether native partition buffer need to be merged
@@ -53,6 +59,8 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
   public long make(
       String shortName,
       int numPartitions,
+      String hashPartitionKeys,
+      String sortKeys,
       int bufferSize,
       int mergeBufferSize,
       double mergeThreshold,
@@ -75,6 +83,8 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
     return nativeMake(
         shortName,
         numPartitions,
+        hashPartitionKeys,
+        sortKeys,
         bufferSize,
         mergeBufferSize,
         mergeThreshold,
@@ -103,6 +113,7 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
   /**
    * Construct RSS native shuffle writer for shuffled RecordBatch over
    *
+   * @param hashPartitionKeys see {@link #make}
    * @param bufferSize size of native buffers hold by partition writer
    * @param codec compression codec
    * @return native shuffle writer instance handle if created successfully.
@@ -110,6 +121,7 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
   public long makeForRSS(
       String shortName,
       int numPartitions,
+      String hashPartitionKeys,
       int bufferSize,
       String codec,
       int compressionLevel,
@@ -130,6 +142,8 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
     return nativeMake(
         shortName,
         numPartitions,
+        hashPartitionKeys,
+        null,
         bufferSize,
         0,
         0,
@@ -158,6 +172,8 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
   public native long nativeMake(
       String shortName,
       int numPartitions,
+      String hashPartitionKeys,
+      String sortKeys,
       int bufferSize,
       int mergeBufferSize,
       double mergeThreshold,
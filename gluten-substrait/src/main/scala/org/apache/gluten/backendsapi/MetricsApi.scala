@@ -48,6 +48,18 @@ trait MetricsApi extends Serializable {
       joinParamsMap: JMap[JLong, JoinParams],
       aggParamsMap: JMap[JLong, AggregationParams]): IMetrics => Unit
 
+  /**
+   * Same as the above, and also updates the stage-level metrics created by
+   * genWholeStageTransformerMetrics.
+   */
+  def metricsUpdatingFunction(
+      child: SparkPlan,
+      relMap: JMap[JLong, JList[JLong]],
+      joinParamsMap: JMap[JLong, JoinParams],
+      aggParamsMap: JMap[JLong, AggregationParams],
+      wholeStageMetrics: Map[String, SQLMetric]): IMetrics => Unit =
+    metricsUpdatingFunction(child, relMap, joinParamsMap, aggParamsMap)
+
   def genBatchScanTransformerMetrics(sparkContext: SparkContext): Map[String, SQLMetric]
 
   def genBatchScanTransformerMetricsUpdater(metrics: Map[String, SQLMetric]): MetricsUpdater
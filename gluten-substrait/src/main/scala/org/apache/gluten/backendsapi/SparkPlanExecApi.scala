@@ -317,7 +317,8 @@ trait SparkPlanExecApi {
    * Generate ShuffleDependency for ColumnarShuffleExchangeExec.
    *
    * childOutputAttributes may be different from outputAttributes, for example, the
-   * childOutputAttributes include additional shuffle key columns
+   * childOutputAttributes include additional shuffle key columns. If sortOrder is not empty, the
+   * shuffle writer also orders the rows of each partition by it.
    * @return
    */
   // scalastyle:off argcount
@@ -329,7 +330,8 @@ trait SparkPlanExecApi {
       serializer: Serializer,
       writeMetrics: Map[String, SQLMetric],
       metrics: Map[String, SQLMetric],
-      isSort: Boolean): ShuffleDependency[Int, ColumnarBatch, ColumnarBatch]
+      isSort: Boolean,
+      sortOrder: Seq[SortOrder]): ShuffleDependency[Int, ColumnarBatch, ColumnarBatch]
 
   /** Determine whether to use sort-based shuffle based on shuffle partitioning and output. */
   def useSortBasedShuffle(partitioning: Partitioning, output: Seq[Attribute]): Boolean
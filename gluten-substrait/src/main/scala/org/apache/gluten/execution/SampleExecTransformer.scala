@@ -26,10 +26,12 @@ import org.apache.gluten.substrait.extensions.ExtensionBuilder
 import org.apache.gluten.substrait.rel.{RelBuilder, RelNode}
 
 import org.apache.spark.internal.Logging
-import org.apache.spark.sql.catalyst.expressions.{Attribute, Expression, LessThan, Literal, Rand}
+import org.apache.spark.sql.catalyst.expressions._
 import org.apache.spark.sql.execution.SparkPlan
 import org.apache.spark.sql.types.DoubleType
 
+import com.google.protobuf.StringValue
+
 import scala.collection.JavaConverters._
 
 /**
@@ -41,9 +43,9 @@ import scala.collection.JavaConverters._
  * the range [lowerBound, upperBound), the row is included; otherwise, it is skipped.
  *
  * This transformer converts sampleExec to a Substrait Filter relation, achieving a similar sampling
- * effect through the filter op with rand sampling expression. Specifically, the `upperBound -
- * lowerBound` value is used as the fraction, and the node be translated to `filter(rand(seed +
- * partitionId) < fraction)` for random sampling.
+ * effect through the filter op with rand sampling expression. Specifically, the node is translated
+ * to `filter(lowerBound <= rand(seed + partitionId) < upperBound)`, so that the samples of
+ * `Dataset.randomSplit`, which share the seed and have adjacent ranges, are disjoint.
  */
 case class SampleExecTransformer(
     lowerBound: Double,
@@ -57,8 +59,18 @@ case class SampleExecTransformer(
 
   def condition: Expression = {
     val randExpr: Expression = Rand(seed)
-    val sampleRateExpr: Expression = Literal(fraction, DoubleType)
-    LessThan(randExpr, sampleRateExpr)
+    if (lowerBound <= 0.0) {
+      LessThan(randExpr, Literal(upperBound, DoubleType))
+    } else if (upperBound >= 1.0) {
+      GreaterThanOrEqual(randExpr, Literal(lowerBound, DoubleType))
+    } else {
+      // rand is evaluated once per row: the conjuncts of an And would each draw their own number,
+      // and the second one only for the rows passing the first. Clamping the number to
+      // [nextDown(lowerBound), upperBound] maps exactly the rows out of the range to the ends.
+      val below = Literal(Math.nextDown(lowerBound), DoubleType)
+      val upper = Literal(upperBound, DoubleType)
+      Not(In(Least(Seq(Greatest(Seq(randExpr, below)), upper)), Seq(below, upper)))
+    }
   }
 
   override def output: Seq[Attribute] = child.output
@@ -84,7 +96,12 @@ case class SampleExecTransformer(
       .doTransform(args)
 
     if (!validation) {
-      RelBuilder.makeFilterRel(input, condExprNode, context, operatorId)
+      // Tell the backend that the filter samples, so that it may sample in a coarser way than by row.
+      val extensionNode = ExtensionBuilder.makeAdvancedExtension(
+        BackendsApiManager.getTransformerApiInstance.packPBMessage(
+          StringValue.newBuilder().setValue("isSample=1\n").build()),
+        null)
+      RelBuilder.makeFilterRel(input, condExprNode, extensionNode, context, operatorId)
     } else {
       // Use a extension node to send the input types through Substrait plan for validation.
       val inputTypeNodeList = originalInputAttributes
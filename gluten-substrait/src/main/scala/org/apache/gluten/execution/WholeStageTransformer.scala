@@ -407,7 +407,8 @@ case class WholeStageTransformer(child: SparkPlan, materializeInput: Boolean = f
           child,
           wsCtx.substraitContext.registeredRelMap,
           wsCtx.substraitContext.registeredJoinParams,
-          wsCtx.substraitContext.registeredAggregationParams
+          wsCtx.substraitContext.registeredAggregationParams,
+          metrics
         )
       )
       (0 until allScanPartitions.head.size).foreach(
@@ -442,7 +443,8 @@ case class WholeStageTransformer(child: SparkPlan, materializeInput: Boolean = f
           child,
           wsCtx.substraitContext.registeredRelMap,
           wsCtx.substraitContext.registeredJoinParams,
-          wsCtx.substraitContext.registeredAggregationParams
+          wsCtx.substraitContext.registeredAggregationParams,
+          metrics
         ),
         materializeInput
       )
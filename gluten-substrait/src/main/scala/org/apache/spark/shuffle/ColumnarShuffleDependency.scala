@@ -48,6 +48,11 @@ import scala.reflect.ClassTag
  *   hold partitioning parameters needed by native shuffle writer
  * @param metrics
  *   the metrics for the columnar shuffle
+ * @param isSort
+ *   whether the sort shuffle writer is used
+ * @param sortKeys
+ *   keys the sort shuffle writer also orders the rows of each partition by, in the format of
+ *   `ShuffleWriterJniWrapper#make`, or an empty string
  */
 class ColumnarShuffleDependency[K: ClassTag, V: ClassTag, C: ClassTag](
     @transient private val _rdd: RDD[_ <: Product2[K, V]],
@@ -59,7 +64,8 @@ class ColumnarShuffleDependency[K: ClassTag, V: ClassTag, C: ClassTag](
     override val shuffleWriterProcessor: ShuffleWriteProcessor = new ShuffleWriteProcessor,
     val nativePartitioning: NativePartitioning,
     val metrics: Map[String, SQLMetric],
-    val isSort: Boolean = false)
+    val isSort: Boolean = false,
+    val sortKeys: String = "")
   extends ShuffleDependency[K, V, C](
     _rdd,
     partitioner,
@@ -43,6 +43,18 @@ object GlutenShuffleUtils {
     }
   }
 
+  /**
+   * Comma-separated ordinals of the hash partitioning keys for a native shuffle writer that
+   * computes the partition ids itself, or an empty string if the ids come from the first column.
+   */
+  def getHashPartitionKeys(partition: NativePartitioning): String = {
+    partition.getShortName match {
+      case HashPartitioningShortName if partition.getExprList != null =>
+        new String(partition.getExprList)
+      case _ => ""
+    }
+  }
+
   def getCompressionCodec(conf: SparkConf): String = {
     def checkCodecValues(codecConf: String, codec: String, validValues: Set[String]): Unit = {
       if (!validValues.contains(codec)) {
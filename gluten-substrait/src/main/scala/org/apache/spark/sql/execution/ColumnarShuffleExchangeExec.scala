@@ -28,9 +28,10 @@ import org.apache.spark.internal.Logging
 import org.apache.spark.rdd.RDD
 import org.apache.spark.serializer.Serializer
 import org.apache.spark.sql.catalyst.InternalRow
-import org.apache.spark.sql.catalyst.expressions.Attribute
+import org.apache.spark.sql.catalyst.expressions.{Attribute, SortOrder}
 import org.apache.spark.sql.catalyst.plans.logical.Statistics
 import org.apache.spark.sql.catalyst.plans.physical._
+import org.apache.spark.sql.catalyst.trees.TreeNodeTag
 import org.apache.spark.sql.execution.CoalesceExec.EmptyPartition
 import org.apache.spark.sql.execution.exchange._
 import org.apache.spark.sql.execution.metric.SQLShuffleWriteMetricsReporter
@@ -44,7 +45,8 @@ case class ColumnarShuffleExchangeExec(
     child: SparkPlan,
     shuffleOrigin: ShuffleOrigin = ENSURE_REQUIREMENTS,
     projectOutputAttributes: Seq[Attribute],
-    advisoryPartitionSize: Option[Long] = None)
+    advisoryPartitionSize: Option[Long] = None,
+    sortOrder: Seq[SortOrder] = Nil)
   extends ShuffleExchangeLike
   with ValidatablePlan {
   private[sql] lazy val writeMetrics =
@@ -53,7 +55,7 @@ case class ColumnarShuffleExchangeExec(
   private[sql] lazy val readMetrics =
     SQLColumnarShuffleReadMetricsReporter.createShuffleReadMetrics(sparkContext)
 
-  val useSortBasedShuffle: Boolean =
+  val useSortBasedShuffle: Boolean = sortOrder.nonEmpty ||
     BackendsApiManager.getSparkPlanExecApiInstance.useSortBasedShuffle(outputPartitioning, output)
 
   // Note: "metrics" is made transient to avoid sending driver-side metrics to tasks.
@@ -89,7 +91,8 @@ case class ColumnarShuffleExchangeExec(
       serializer,
       writeMetrics,
       metrics,
-      useSortBasedShuffle)
+      useSortBasedShuffle,
+      sortOrder)
   }
 
   // super.stringArgs ++ Iterator(output.map(o => s"${o}#${o.dataType.simpleString}"))
@@ -168,6 +171,13 @@ case class ColumnarShuffleExchangeExec(
 
 object ColumnarShuffleExchangeExec extends Logging {
 
+  /**
+   * Set on a [[ShuffleExchangeExec]] whose reducers sort each partition by this order, so that the
+   * map side can write each partition in this order and the reducers only merge the sorted runs.
+   */
+  val SORT_ORDER_TAG: TreeNodeTag[Seq[SortOrder]] =
+    TreeNodeTag[Seq[SortOrder]]("org.apache.gluten.shuffle.sortOrder")
+
   def apply(
       plan: ShuffleExchangeExec,
       child: SparkPlan,
@@ -177,7 +187,8 @@ object ColumnarShuffleExchangeExec extends Logging {
       child,
       plan.shuffleOrigin,
       shuffleOutputAttributes,
-      advisoryPartitionSize = SparkShimLoader.getSparkShims.getShuffleAdvisoryPartitionSize(plan)
+      advisoryPartitionSize = SparkShimLoader.getSparkShims.getShuffleAdvisoryPartitionSize(plan),
+      sortOrder = plan.getTagValue(SORT_ORDER_TAG).getOrElse(Nil)
     )
   }
 
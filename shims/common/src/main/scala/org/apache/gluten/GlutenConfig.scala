@@ -94,6 +94,8 @@ class GlutenConfig(conf: SQLConf) extends Logging {
 
   def enableColumnarBroadcastJoin: Boolean = conf.getConf(COLUMNAR_BROADCAST_JOIN_ENABLED)
 
+  def columnarBroadcastChunkSize: Int = conf.getConf(COLUMNAR_BROADCAST_CHUNK_SIZE).toInt
+
   def enableColumnarSample: Boolean = conf.getConf(COLUMNAR_SAMPLE_ENABLED)
 
   def enableColumnarArrowUDF: Boolean = conf.getConf(COLUMNAR_ARROW_UDF_ENABLED)
@@ -185,6 +187,17 @@ class GlutenConfig(conf: SQLConf) extends Logging {
   def columnarShuffleSortColumnsThreshold: Int =
     conf.getConf(COLUMNAR_SHUFFLE_SORT_COLUMNS_THRESHOLD)
 
+  def columnarShuffleAdaptiveWriterEnabled: Boolean =
+    conf.getConf(COLUMNAR_SHUFFLE_ADAPTIVE_WRITER_ENABLED)
+
+  def columnarShuffleFuseHashPartitioning: Boolean =
+    conf.getConf(COLUMNAR_SHUFFLE_FUSE_HASH_PARTITIONING)
+
+  def columnarShuffleSortByKeys: Boolean = conf.getConf(COLUMNAR_SHUFFLE_SORT_BY_KEYS)
+
+  def columnarShuffleSortedRunsMergeMemory: Long =
+    conf.getConf(COLUMNAR_SHUFFLE_SORTED_RUNS_MERGE_MEMORY)
+
   def columnarShuffleReallocThreshold: Double = conf.getConf(COLUMNAR_SHUFFLE_REALLOC_THRESHOLD)
 
   def columnarShuffleMergeThreshold: Double = conf.getConf(SHUFFLE_WRITER_MERGE_THRESHOLD)
@@ -328,6 +341,8 @@ class GlutenConfig(conf: SQLConf) extends Logging {
 
   def veloxMaxSpillBytes: Long = conf.getConf(COLUMNAR_VELOX_MAX_SPILL_BYTES)
 
+  def veloxMetricsPublishIntervalMs: Int = conf.getConf(COLUMNAR_VELOX_METRICS_PUBLISH_INTERVAL_MS)
+
   def veloxBloomFilterExpectedNumItems: Long =
     conf.getConf(COLUMNAR_VELOX_BLOOM_FILTER_EXPECTED_NUM_ITEMS)
 
@@ -626,6 +641,7 @@ object GlutenConfig {
   val GLUTEN_HASH_SHUFFLE_WRITER = "hash"
   val GLUTEN_SORT_SHUFFLE_WRITER = "sort"
   val GLUTEN_RSS_SORT_SHUFFLE_WRITER = "rss_sort"
+  val GLUTEN_ADAPTIVE_SHUFFLE_WRITER = "adaptive"
 
   // Shuffle Writer buffer size.
   val GLUTEN_SHUFFLE_WRITER_BUFFER_SIZE = "spark.gluten.shuffleWriter.bufferSize"
@@ -844,6 +860,15 @@ object GlutenConfig {
       .filter(_._1.startsWith(confPrefix))
       .foreach(entry => nativeConfMap.put(entry._1, entry._2))
 
+    // The native side reads it as a number of bytes, so sizes like "1g" are converted here.
+    conf
+      .get(COLUMNAR_VELOX_SPILL_MEMORY_TIER_CAPACITY.key)
+      .foreach(
+        v =>
+          nativeConfMap.put(
+            COLUMNAR_VELOX_SPILL_MEMORY_TIER_CAPACITY.key,
+            JavaUtils.byteStringAsBytes(v).toString))
+
     // put in all S3 configs
     conf
       .filter(_._1.startsWith(HADOOP_PREFIX + S3A_PREFIX))
@@ -1069,6 +1094,16 @@ object GlutenConfig {
       .booleanConf
       .createWithDefault(true)
 
+  val COLUMNAR_BROADCAST_CHUNK_SIZE =
+    buildConf("spark.gluten.sql.columnar.broadcastChunkSize")
+      .internal()
+      .doc("Size of each off-heap chunk a serialized broadcast relation is split into.")
+      .bytesConf(ByteUnit.BYTE)
+      .checkValue(
+        v => v > 0 && v <= Int.MaxValue,
+        "spark.gluten.sql.columnar.broadcastChunkSize must be positive and less than 2GB.")
+      .createWithDefaultString("8MB")
+
   val COLUMNAR_ARROW_UDF_ENABLED =
     buildConf("spark.gluten.sql.columnar.arrowUdf")
       .internal()
@@ -1106,6 +1141,44 @@ object GlutenConfig {
       .intConf
       .createWithDefault(100000)
 
+  val COLUMNAR_SHUFFLE_ADAPTIVE_WRITER_ENABLED =
+    buildConf("spark.gluten.sql.columnar.shuffle.adaptiveWriter.enabled")
+      .internal()
+      .doc("If true, a columnar shuffle that doesn't exceed the sort partitions or columns " +
+        "threshold picks the hash or the sort shuffle writer per task, based on the row width " +
+        "and the partition distribution of its first batches and on the available memory.")
+      .booleanConf
+      .createWithDefault(false)
+
+  val COLUMNAR_SHUFFLE_FUSE_HASH_PARTITIONING =
+    buildConf("spark.gluten.sql.columnar.shuffle.fuseHashPartitioning")
+      .internal()
+      .doc("If true, the native shuffle writer computes the Spark murmur3 hash of the partition " +
+        "keys itself instead of reading it from a projected column, which saves materializing " +
+        "the hash column in a separate project. Only applies when all partition keys are " +
+        "columns of primitive, string, binary or short decimal types.")
+      .booleanConf
+      .createWithDefault(false)
+
+  val COLUMNAR_SHUFFLE_SORT_BY_KEYS =
+    buildConf("spark.gluten.sql.columnar.shuffle.sortByKeys")
+      .internal()
+      .doc("If true and a hash shuffle feeds a local sort, e.g. of a sort merge join, the sort " +
+        "shuffle writer also orders the rows of each partition by the sort keys, and the reducer " +
+        "merges the sorted runs it reads instead of sorting them. Only applies with the columnar " +
+        "shuffle manager and when all sort keys are columns of primitive, decimal, string or " +
+        "binary types.")
+      .booleanConf
+      .createWithDefault(false)
+
+  val COLUMNAR_SHUFFLE_SORTED_RUNS_MERGE_MEMORY =
+    buildConf("spark.gluten.sql.columnar.shuffle.sortByKeys.mergeMemory")
+      .internal()
+      .doc("Memory the reducer may buffer the sorted runs of its input in before merging them. " +
+        "Runs beyond it are spilled to local disk and read back one batch at a time.")
+      .bytesConf(ByteUnit.BYTE)
+      .createWithDefaultString("128MB")
+
   val COLUMNAR_PREFER_ENABLED =
     buildConf("spark.gluten.sql.columnar.preferColumnar")
       .internal()
@@ -1604,11 +1677,64 @@ object GlutenConfig {
       .doc(
         "The filesystem used to store spill data. local: The local file system. " +
           "heap-over-local: Write file to JVM heap if having extra heap space. " +
-          "Otherwise write to local file system.")
+          "Otherwise write to local file system. " +
+          "memory-over-local: Keep spill runs in a process-wide off-task memory tier, demoting the " +
+          "least-recently-written runs to local file system when the tier is full.")
       .stringConf
-      .checkValues(Set("local", "heap-over-local"))
+      .checkValues(Set("local", "heap-over-local", "memory-over-local"))
       .createWithDefaultString("local")
 
+  val COLUMNAR_VELOX_SPILL_MEMORY_TIER_CAPACITY =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.spillMemoryTierCapacity")
+      .internal()
+      .doc(
+        "The capacity of the process-wide memory tier used by the memory-over-local spill " +
+          "file system. The memory is not part of the Spark task memory budget.")
+      .bytesConf(ByteUnit.BYTE)
+      .createWithDefaultString("1GB")
+
+  val COLUMNAR_VELOX_HEDGED_READ_ENABLED =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.hedgedRead.enabled")
+      .internal()
+      .doc(
+        "Whether a read of HDFS or an object storage which is slower than the rolling latency " +
+          "percentile of its storage issues a duplicate request, taking the first response.")
+      .booleanConf
+      .createWithDefault(false)
+
+  val COLUMNAR_VELOX_HEDGED_READ_PERCENTILE =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.hedgedRead.percentile")
+      .internal()
+      .doc("The percentile of the recent read latencies of a storage after which a read is hedged.")
+      .doubleConf
+      .checkValue(v => v > 0 && v <= 1, "must be in (0, 1]")
+      .createWithDefault(0.95)
+
+  val COLUMNAR_VELOX_HEDGED_READ_MIN_DELAY_MS =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.hedgedRead.minDelayMs")
+      .internal()
+      .doc("The minimal time in milliseconds a read waits before it is hedged.")
+      .longConf
+      .createWithDefault(5)
+
+  val COLUMNAR_VELOX_HEDGED_READ_BUDGET_RATIO =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.hedgedRead.budgetRatio")
+      .internal()
+      .doc("The maximal fraction of the reads of an executor which are hedged.")
+      .doubleConf
+      .checkValue(v => v >= 0 && v <= 1, "must be in [0, 1]")
+      .createWithDefault(0.05)
+
+  val COLUMNAR_VELOX_HEDGED_READ_THREADS =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.hedgedRead.threads")
+      .internal()
+      .doc(
+        "The number of threads running the reads of a storage once they may be hedged, and " +
+          "their hedges. It bounds the reads of such storages in flight.")
+      .intConf
+      .checkValue(_ > 0, "must be a positive number")
+      .createWithDefault(64)
+
   val COLUMNAR_VELOX_MAX_SPILL_RUN_ROWS =
     buildConf("spark.gluten.sql.columnar.backend.velox.maxSpillRunRows")
       .internal()
@@ -1863,6 +1989,17 @@ object GlutenConfig {
       .booleanConf
       .createWithDefault(false)
 
+  val COLUMNAR_VELOX_METRICS_PUBLISH_INTERVAL_MS =
+    buildConf("spark.gluten.sql.columnar.backend.velox.metricsPublishIntervalMs")
+      .internal()
+      .doc(
+        "If positive, the native operator metrics of a running task are published with this " +
+          "interval and applied to the SQL metrics as the task goes, instead of only when it " +
+          "finishes. 0 to disable.")
+      .intConf
+      .checkValue(_ >= 0, "must be non-negative")
+      .createWithDefault(0)
+
   val COLUMNAR_VELOX_MEMORY_USE_HUGE_PAGES =
     buildConf("spark.gluten.sql.columnar.backend.velox.memoryUseHugePages")
       .internal()
@@ -239,6 +239,7 @@ object ExpressionNames {
   // Hash functions
   final val MURMUR3HASH = "murmur3hash"
   final val XXHASH64 = "xxhash64"
+  final val HIVE_HASH = "hive_hash"
   final val MD5 = "md5"
   final val SHA1 = "sha1"
   final val SHA2 = "sha2"